@@ -18,6 +18,36 @@
 #include <cstring>
 #include <limits>
 #include <algorithm>
+#include <atomic>
+
+// Vector kernels for the swap_XX_array routines.  SSE2 is part of the
+// x86-64 baseline and NEON of AArch64, so those are picked at compile
+// time; AVX2 is compiled separately and only used if the processor
+// reports it.  Define ACE_LACKS_CDR_SIMD_SWAP to keep the scalar code
+// only.
+#if !defined (ACE_LACKS_CDR_SIMD_SWAP)
+# if defined (__x86_64__) || defined (_M_X64) || defined (__SSE2__) \
+     || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ACE_CDR_SWAP_SSE2
+#   include <emmintrin.h>
+#   if (defined (__GNUC__) && !defined (__INTEL_COMPILER)) || defined (_MSC_VER)
+#     define ACE_CDR_SWAP_AVX2
+#     include <immintrin.h>
+#     if defined (_MSC_VER)
+#       include <intrin.h>
+#     endif /* _MSC_VER */
+#   endif /* __GNUC__ || _MSC_VER */
+# elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#   define ACE_CDR_SWAP_NEON
+#   include <arm_neon.h>
+# endif /* __x86_64__ || _M_X64 || __SSE2__ */
+#endif /* !ACE_LACKS_CDR_SIMD_SWAP */
+
+#if defined (ACE_CDR_SWAP_AVX2) && defined (__GNUC__)
+# define ACE_CDR_TARGET_AVX2 __attribute__ ((target ("avx2")))
+#else
+# define ACE_CDR_TARGET_AVX2
+#endif /* ACE_CDR_SWAP_AVX2 && __GNUC__ */
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -26,12 +56,323 @@ static constexpr ACE_INT16 max_eleven_bit = 0x3ff;
 static constexpr ACE_INT16 max_fifteen_bit = 0x3fff;
 #endif /* NONNATIVE_LONGDOUBLE */
 
+// Each vector kernel swaps the longest prefix of an array of @a n
+// elements that fills whole vectors, and returns the number of
+// elements swapped.  Vectors are loaded and stored unaligned, and
+// the whole vector is loaded before being stored, so @a orig and
+// @a target may be the same buffer.
+typedef size_t (*ACE_CDR_Swap_Array_Kernel) (char const *orig,
+                                             char *target,
+                                             size_t n);
+
+// Arrays shorter than this (in bytes) are left to the scalar code.
+static constexpr size_t ace_cdr_simd_swap_min = 32;
+
+#if defined (ACE_CDR_SWAP_SSE2)
+// SSE2 has no byte shuffle: the bytes of each 16 bit lane are swapped
+// with shifts, after reordering the 16 bit lanes for the wider types.
+static inline __m128i
+ace_cdr_sse2_swap_lanes (__m128i v)
+{
+  return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+}
+
+static size_t
+ace_cdr_sse2_swap_2 (char const *orig, char *target, size_t n)
+{
+  size_t const blocks = n / 8;
+  for (size_t i = 0; i < blocks; ++i, orig += 16, target += 16)
+    {
+      __m128i v = _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig));
+      v = ace_cdr_sse2_swap_lanes (v);
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target), v);
+    }
+  return blocks * 8;
+}
+
+static size_t
+ace_cdr_sse2_swap_4 (char const *orig, char *target, size_t n)
+{
+  size_t const blocks = n / 4;
+  for (size_t i = 0; i < blocks; ++i, orig += 16, target += 16)
+    {
+      __m128i v = _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig));
+      v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+      v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+      v = ace_cdr_sse2_swap_lanes (v);
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target), v);
+    }
+  return blocks * 4;
+}
+
+static size_t
+ace_cdr_sse2_swap_8 (char const *orig, char *target, size_t n)
+{
+  size_t const blocks = n / 2;
+  for (size_t i = 0; i < blocks; ++i, orig += 16, target += 16)
+    {
+      __m128i v = _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig));
+      v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      v = ace_cdr_sse2_swap_lanes (v);
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target), v);
+    }
+  return blocks * 2;
+}
+
+static size_t
+ace_cdr_sse2_swap_16 (char const *orig, char *target, size_t n)
+{
+  for (size_t i = 0; i < n; ++i, orig += 16, target += 16)
+    {
+      __m128i v = _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig));
+      v = _mm_shuffle_epi32 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+      v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+      v = ace_cdr_sse2_swap_lanes (v);
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target), v);
+    }
+  return n;
+}
+#endif /* ACE_CDR_SWAP_SSE2 */
+
+#if defined (ACE_CDR_SWAP_AVX2)
+// AVX2 reverses the bytes of each element with a single byte shuffle
+// per 32 bytes.  The shuffle works within each 128 bit half, which is
+// fine since no element crosses the middle of the vector.
+ACE_CDR_TARGET_AVX2 static size_t
+ace_cdr_avx2_swap (char const *orig, char *target, size_t bytes,
+                   __m256i const mask)
+{
+  size_t const blocks = bytes / 32;
+  for (size_t i = 0; i < blocks; ++i, orig += 32, target += 32)
+    {
+      __m256i v = _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig));
+      v = _mm256_shuffle_epi8 (v, mask);
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target), v);
+    }
+  return blocks * 32;
+}
+
+ACE_CDR_TARGET_AVX2 static size_t
+ace_cdr_avx2_swap_2 (char const *orig, char *target, size_t n)
+{
+  __m256i const mask =
+    _mm256_setr_epi8 (1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                      1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  return ace_cdr_avx2_swap (orig, target, 2 * n, mask) / 2;
+}
+
+ACE_CDR_TARGET_AVX2 static size_t
+ace_cdr_avx2_swap_4 (char const *orig, char *target, size_t n)
+{
+  __m256i const mask =
+    _mm256_setr_epi8 (3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  return ace_cdr_avx2_swap (orig, target, 4 * n, mask) / 4;
+}
+
+ACE_CDR_TARGET_AVX2 static size_t
+ace_cdr_avx2_swap_8 (char const *orig, char *target, size_t n)
+{
+  __m256i const mask =
+    _mm256_setr_epi8 (7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  return ace_cdr_avx2_swap (orig, target, 8 * n, mask) / 8;
+}
+
+ACE_CDR_TARGET_AVX2 static size_t
+ace_cdr_avx2_swap_16 (char const *orig, char *target, size_t n)
+{
+  __m256i const mask =
+    _mm256_setr_epi8 (15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return ace_cdr_avx2_swap (orig, target, 16 * n, mask) / 16;
+}
+
+static bool
+ace_cdr_cpu_has_avx2 ()
+{
+# if defined (_MSC_VER)
+  int info[4];
+  __cpuid (info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid (info, 1);
+  // The OS must save the AVX state (OSXSAVE, and XMM/YMM in XCR0).
+  if ((info[2] & (1 << 27)) == 0 || (_xgetbv (0) & 6) != 6)
+    return false;
+  __cpuidex (info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+# else
+  return __builtin_cpu_supports ("avx2");
+# endif /* _MSC_VER */
+}
+#endif /* ACE_CDR_SWAP_AVX2 */
+
+#if defined (ACE_CDR_SWAP_NEON)
+static size_t
+ace_cdr_neon_swap_2 (char const *orig, char *target, size_t n)
+{
+  size_t const blocks = n / 8;
+  for (size_t i = 0; i < blocks; ++i, orig += 16, target += 16)
+    vst1q_u8 (reinterpret_cast<uint8_t *> (target),
+              vrev16q_u8 (vld1q_u8 (reinterpret_cast<uint8_t const *> (orig))));
+  return blocks * 8;
+}
+
+static size_t
+ace_cdr_neon_swap_4 (char const *orig, char *target, size_t n)
+{
+  size_t const blocks = n / 4;
+  for (size_t i = 0; i < blocks; ++i, orig += 16, target += 16)
+    vst1q_u8 (reinterpret_cast<uint8_t *> (target),
+              vrev32q_u8 (vld1q_u8 (reinterpret_cast<uint8_t const *> (orig))));
+  return blocks * 4;
+}
+
+static size_t
+ace_cdr_neon_swap_8 (char const *orig, char *target, size_t n)
+{
+  size_t const blocks = n / 2;
+  for (size_t i = 0; i < blocks; ++i, orig += 16, target += 16)
+    vst1q_u8 (reinterpret_cast<uint8_t *> (target),
+              vrev64q_u8 (vld1q_u8 (reinterpret_cast<uint8_t const *> (orig))));
+  return blocks * 2;
+}
+
+static size_t
+ace_cdr_neon_swap_16 (char const *orig, char *target, size_t n)
+{
+  for (size_t i = 0; i < n; ++i, orig += 16, target += 16)
+    {
+      uint8x16_t const v =
+        vrev64q_u8 (vld1q_u8 (reinterpret_cast<uint8_t const *> (orig)));
+      vst1q_u8 (reinterpret_cast<uint8_t *> (target),
+                vcombine_u8 (vget_high_u8 (v), vget_low_u8 (v)));
+    }
+  return n;
+}
+#endif /* ACE_CDR_SWAP_NEON */
+
+// Kernels indexed by ACE_CDR::Swap_Kernel, then by log2 (size) - 1.
+static ACE_CDR_Swap_Array_Kernel const ace_cdr_swap_kernels[4][4] =
+  {
+    { nullptr, nullptr, nullptr, nullptr },
+#if defined (ACE_CDR_SWAP_SSE2)
+    { ace_cdr_sse2_swap_2, ace_cdr_sse2_swap_4,
+      ace_cdr_sse2_swap_8, ace_cdr_sse2_swap_16 },
+#else
+    { nullptr, nullptr, nullptr, nullptr },
+#endif /* ACE_CDR_SWAP_SSE2 */
+#if defined (ACE_CDR_SWAP_AVX2)
+    { ace_cdr_avx2_swap_2, ace_cdr_avx2_swap_4,
+      ace_cdr_avx2_swap_8, ace_cdr_avx2_swap_16 },
+#else
+    { nullptr, nullptr, nullptr, nullptr },
+#endif /* ACE_CDR_SWAP_AVX2 */
+#if defined (ACE_CDR_SWAP_NEON)
+    { ace_cdr_neon_swap_2, ace_cdr_neon_swap_4,
+      ace_cdr_neon_swap_8, ace_cdr_neon_swap_16 }
+#else
+    { nullptr, nullptr, nullptr, nullptr }
+#endif /* ACE_CDR_SWAP_NEON */
+  };
+
+// Selected kernel, -1 until the first use.
+static std::atomic<int> ace_cdr_swap_kernel (-1);
+
+static bool
+ace_cdr_swap_kernel_supported (ACE_CDR::Swap_Kernel kernel)
+{
+  switch (kernel)
+    {
+    case ACE_CDR::SWAP_KERNEL_SCALAR:
+      return true;
+#if defined (ACE_CDR_SWAP_AVX2)
+    case ACE_CDR::SWAP_KERNEL_AVX2:
+      return ace_cdr_cpu_has_avx2 ();
+#endif /* ACE_CDR_SWAP_AVX2 */
+    default:
+      return ace_cdr_swap_kernels[kernel][0] != nullptr;
+    }
+}
+
+static int
+ace_cdr_current_swap_kernel ()
+{
+  int kernel = ace_cdr_swap_kernel.load (std::memory_order_relaxed);
+  if (kernel == -1)
+    {
+      ACE_CDR::Swap_Kernel const best[] =
+        {
+          ACE_CDR::SWAP_KERNEL_AVX2,
+          ACE_CDR::SWAP_KERNEL_SSE2,
+          ACE_CDR::SWAP_KERNEL_NEON
+        };
+      kernel = ACE_CDR::SWAP_KERNEL_SCALAR;
+      for (ACE_CDR::Swap_Kernel const k : best)
+        if (ace_cdr_swap_kernel_supported (k))
+          {
+            kernel = k;
+            break;
+          }
+      // Racing threads all compute the same value.
+      ace_cdr_swap_kernel.store (kernel, std::memory_order_relaxed);
+    }
+  return kernel;
+}
+
+// Swap as much of the array as the selected vector kernel handles,
+// advancing the arguments past it.  Returns true if nothing is left.
+static inline bool
+ace_cdr_swap_array_simd (int size_index,
+                         size_t size,
+                         char const *&orig,
+                         char *&target,
+                         size_t &n)
+{
+  if (n * size < ace_cdr_simd_swap_min)
+    return false;
+
+  ACE_CDR_Swap_Array_Kernel const kernel =
+    ace_cdr_swap_kernels[ace_cdr_current_swap_kernel ()][size_index];
+  if (kernel == nullptr)
+    return false;
+
+  size_t const done = kernel (orig, target, n);
+  orig += done * size;
+  target += done * size;
+  n -= done;
+  return n == 0;
+}
+
+ACE_CDR::Swap_Kernel
+ACE_CDR::swap_kernel ()
+{
+  return static_cast<Swap_Kernel> (ace_cdr_current_swap_kernel ());
+}
+
+int
+ACE_CDR::swap_kernel (Swap_Kernel kernel)
+{
+  if (kernel < SWAP_KERNEL_SCALAR || kernel > SWAP_KERNEL_NEON
+      || !ace_cdr_swap_kernel_supported (kernel))
+    return -1;
+
+  ace_cdr_swap_kernel.store (kernel, std::memory_order_relaxed);
+  return 0;
+}
+
 // See comments in CDR_Base.inl about optimization cases for swap_XX_array.
 void
 ACE_CDR::swap_2_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+  if (ace_cdr_swap_array_simd (0, 2, orig, target, n))
+    return;
+
   // We pretend that AMD64/GNU G++ systems have a Pentium CPU to
   // take advantage of the inline assembly implementation.
 
@@ -255,6 +596,9 @@ ACE_CDR::swap_4_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT (n > 0); The caller checks that n > 0
 
+  if (ace_cdr_swap_array_simd (1, 4, orig, target, n))
+    return;
+
 #if ACE_SIZEOF_LONG == 8
   // Later, we read from *orig in 64 bit chunks,
   // so make sure we don't generate unaligned readings.
@@ -453,6 +797,9 @@ ACE_CDR::swap_8_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+  if (ace_cdr_swap_array_simd (2, 8, orig, target, n))
+    return;
+
   char const * const end = orig + 8*n;
   while (orig < end)
     {
@@ -467,6 +814,9 @@ ACE_CDR::swap_16_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+  if (ace_cdr_swap_array_simd (3, 16, orig, target, n))
+    return;
+
   char const * const end = orig + 16*n;
   while (orig < end)
     {
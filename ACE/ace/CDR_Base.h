@@ -148,6 +148,31 @@ public:
                              char *target,
                              size_t length);
 
+  /**
+   * @enum Swap_Kernel
+   *
+   * Instruction set used by the swap_XX_array routines for the bulk
+   * of the arrays.  SWAP_KERNEL_SCALAR is the portable unrolled
+   * implementation, always available; it also handles the elements
+   * left over by the vector kernels.
+   */
+  enum Swap_Kernel
+  {
+    SWAP_KERNEL_SCALAR,
+    SWAP_KERNEL_SSE2,
+    SWAP_KERNEL_AVX2,
+    SWAP_KERNEL_NEON
+  };
+
+  /// Kernel used by the swap_XX_array routines.  Unless set through
+  /// swap_kernel(Swap_Kernel), the best kernel supported both by the
+  /// build and by the processor running it is selected on first use.
+  static Swap_Kernel swap_kernel ();
+
+  /// Use @a kernel in the swap_XX_array routines.  Returns -1, and
+  /// leaves the kernel unchanged, if @a kernel is not supported.
+  static int swap_kernel (Swap_Kernel kernel);
+
   /// Align the message block to ACE_CDR::MAX_ALIGNMENT,
   /// set by the CORBA spec at 8 bytes.
   static void mb_align (ACE_Message_Block *mb);
@@ -39,6 +39,7 @@ ACE_OutputCDR::ACE_OutputCDR (size_t size,
      do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
      good_bit_ (true),
      memcpy_tradeoff_ (memcpy_tradeoff),
+     reference_threshold_ (0),
      major_version_ (major_version),
      minor_version_ (minor_version),
      char_translator_ (0),
@@ -82,6 +83,7 @@ ACE_OutputCDR::ACE_OutputCDR (char *data,
      do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
      good_bit_ (true),
      memcpy_tradeoff_ (memcpy_tradeoff),
+     reference_threshold_ (0),
      major_version_ (major_version),
      minor_version_ (minor_version),
      char_translator_ (0),
@@ -114,6 +116,7 @@ ACE_OutputCDR::ACE_OutputCDR (ACE_Data_Block *data_block,
      do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
      good_bit_ (true),
      memcpy_tradeoff_ (memcpy_tradeoff),
+     reference_threshold_ (0),
      major_version_ (major_version),
      minor_version_ (minor_version),
      char_translator_ (0),
@@ -143,6 +146,7 @@ ACE_OutputCDR::ACE_OutputCDR (ACE_Message_Block *data,
      do_byte_swap_ (byte_order != ACE_CDR_BYTE_ORDER),
      good_bit_ (true),
      memcpy_tradeoff_ (memcpy_tradeoff),
+     reference_threshold_ (0),
      major_version_ (major_version),
      minor_version_ (minor_version),
      char_translator_ (0),
@@ -182,7 +186,12 @@ ACE_OutputCDR::grow_and_adjust (size_t size,
     {
       // Calculate the new buffer's length; if growing for encode, we
       // don't grow in "small" chunks because of the cost.
-      size_t cursize = this->current_->size ();
+      // A block chained from the caller memory says nothing about the
+      // amount of data we write ourselves, start over from the first
+      // block size instead.
+      size_t cursize = this->current_is_writable_
+        ? this->current_->size ()
+        : this->start_.size ();
       if (this->current_->cont () != 0)
         cursize = this->current_->cont ()->size ();
       size_t minsize = size;
@@ -625,6 +634,15 @@ ACE_OutputCDR::write_array (const void *x,
 {
   if (length == 0)
     return true;
+
+  if (this->reference_threshold_ != 0
+      && size * length >= this->reference_threshold_
+#if defined (ACE_ENABLE_SWAP_ON_WRITE)
+      && (!this->do_byte_swap_ || size == 1)
+#endif /* ACE_ENABLE_SWAP_ON_WRITE */
+      )
+    return this->write_array_reference (x, size * length, align);
+
   char *buf = 0;
   if (this->adjust (size * length, align, buf) == 0)
     {
@@ -667,6 +685,67 @@ ACE_OutputCDR::write_array (const void *x,
 }
 
 
+ACE_CDR::Boolean
+ACE_OutputCDR::write_array_reference (const void *x,
+                                      size_t size,
+                                      size_t align)
+{
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  // Pad the current block up to the alignment of the array, the
+  // array itself cannot be moved.
+  if (ACE_align_binary (this->current_alignment_, align)
+        != this->current_alignment_
+      && this->align_write_ptr (align) != 0)
+    return (this->good_bit_ = false);
+#else
+  ACE_UNUSED_ARG (align);
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  // Use the allocators of the current block for the new one, the
+  // data itself is not owned by the block.
+  ACE_Allocator *allocator_strategy = 0;
+  ACE_Allocator *data_block_allocator = 0;
+  ACE_Allocator *message_block_allocator = 0;
+  this->current_->access_allocators (allocator_strategy,
+                                     data_block_allocator,
+                                     message_block_allocator);
+
+  ACE_Message_Block* cont = 0;
+  this->good_bit_ = false;
+  ACE_NEW_RETURN (cont,
+                  ACE_Message_Block (size,
+                                     ACE_Message_Block::MB_DATA,
+                                     0,
+                                     static_cast<const char *> (x),
+                                     allocator_strategy,
+                                     0,
+                                     ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                                     ACE_Time_Value::zero,
+                                     ACE_Time_Value::max_time,
+                                     data_block_allocator,
+                                     message_block_allocator),
+                  false);
+  this->good_bit_ = true;
+  cont->wr_ptr (size);
+
+  if (this->current_->cont () != 0)
+    ACE_Message_Block::release (this->current_->cont ());
+
+  this->current_->cont (cont);
+  this->current_ = cont;
+  this->current_is_writable_ = false;
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  this->current_alignment_ =
+    (this->current_alignment_ + size) % ACE_CDR::MAX_ALIGNMENT;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+#if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
+  this->monitor_->receive (this->total_length ());
+#endif /* ACE_HAS_MONITOR_POINTS==1 */
+
+  return true;
+}
+
 ACE_CDR::Boolean
 ACE_OutputCDR::write_boolean_array (const ACE_CDR::Boolean* x,
                                     ACE_CDR::ULong length)
@@ -983,6 +1062,14 @@ ACE_OutputCDR::replace (ACE_CDR::Double x, char* loc)
   return true;
 }
 
+ACE_Data_Block *
+ACE_OutputCDR::replace_data_block (ACE_Data_Block *data_block)
+{
+  ACE_Data_Block * const old = this->start_.replace_data_block (data_block);
+  this->reset ();
+  return old;
+}
+
 int
 ACE_OutputCDR::consolidate ()
 {
@@ -424,6 +424,16 @@ public:
   /// Reuse the CDR stream to write on the old buffer.
   void reset ();
 
+  /// Reset the CDR stream to write on @a data_block instead of the
+  /// buffer of its first message block.
+  /**
+   * The stream takes ownership of @a data_block and the caller gets
+   * the ownership of the data block the stream used before, which is
+   * returned.  Growing the stream allocates new blocks with the
+   * allocators of @a data_block.
+   */
+  ACE_Data_Block *replace_data_block (ACE_Data_Block *data_block);
+
   /// Add the length of each message block in the chain.
   size_t total_length () const;
 
@@ -533,6 +543,18 @@ public:
   /// Set the underlying GIOP version..
   void get_version (ACE_CDR::Octet &major, ACE_CDR::Octet &minor);
 
+  /**
+   * Arrays of at least @a threshold bytes that can be written without
+   * byte swapping are not copied into the stream: a message block
+   * referring to the memory of the caller is chained instead, so the
+   * array is later sent straight from that memory by a gather write.
+   * The caller must keep the array alive and unchanged until the
+   * contents of the stream have been sent or copied.  Zero, the
+   * default, always copies.
+   */
+  void reference_threshold (size_t threshold);
+  size_t reference_threshold () const;
+
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
   /// Register and unregister our buffer size monitor.
   void register_monitor (const char* id);
@@ -572,6 +594,12 @@ private:
                                 size_t align,
                                 ACE_CDR::ULong length);
 
+  /// Chain a message block referring to the @a size bytes at @a x,
+  /// aligned at a multiple of @a align, instead of copying them.
+  ACE_CDR::Boolean write_array_reference (const void *x,
+                                          size_t size,
+                                          size_t align);
+
 
   ACE_CDR::Boolean write_wchar_array_i (const ACE_CDR::WChar* x,
                                         ACE_CDR::ULong length);
@@ -632,6 +660,10 @@ private:
   /// Break-even point for copying.
   size_t const memcpy_tradeoff_;
 
+  /// Arrays of at least this many bytes are referenced instead of
+  /// copied, zero disables it.
+  size_t reference_threshold_;
+
 #if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
   ACE::Monitor_Control::Size_Monitor *monitor_;
 #endif /* ACE_HAS_MONITOR_POINTS==1 */
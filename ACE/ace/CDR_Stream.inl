@@ -603,6 +603,18 @@ ACE_OutputCDR::get_version (ACE_CDR::Octet &major, ACE_CDR::Octet &minor)
   minor = this->minor_version_;
 }
 
+ACE_INLINE void
+ACE_OutputCDR::reference_threshold (size_t threshold)
+{
+  this->reference_threshold_ = threshold;
+}
+
+ACE_INLINE size_t
+ACE_OutputCDR::reference_threshold () const
+{
+  return this->reference_threshold_;
+}
+
 
 ACE_INLINE const ACE_Message_Block*
 ACE_OutputCDR::begin () const
@@ -324,6 +324,21 @@
 #   define ACE_DEFAULT_TIMER_WHEEL_RESOLUTION 100
 # endif /* ACE_DEFAULT_TIMER_WHEEL_RESOLUTION */
 
+// Defaults for ACE Timer Hierarchical Wheel, 4 levels of 256 slots of
+// 1 millisecond cover about 49 days.
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_LEVELS)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_LEVELS 4
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_LEVELS */
+
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLOT_BITS)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLOT_BITS 8
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLOT_BITS */
+
+// In microseconds.
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION 1000
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION */
+
 // Default size for ACE Timer Hash table
 # if !defined (ACE_DEFAULT_TIMER_HASH_TABLE_SIZE)
 #   define ACE_DEFAULT_TIMER_HASH_TABLE_SIZE 1024
@@ -382,6 +397,21 @@
 #   define ACE_MAXLOGMSGLEN 4 * 1024
 # endif /* ACE_MAXLOGMSGLEN */
 
+// Size in bytes of the ring buffer of ACE_Log_Msg_Async.
+# if !defined (ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE)
+#   define ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE (256 * 1024)
+# endif /* ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE */
+
+// Largest block cached by ACE_TLS_Slab_Allocator, and bytes carved at
+// once to refill the free list of a thread.
+# if !defined (ACE_DEFAULT_TLS_SLAB_MAX_BLOCK_SIZE)
+#   define ACE_DEFAULT_TLS_SLAB_MAX_BLOCK_SIZE (64 * 1024)
+# endif /* ACE_DEFAULT_TLS_SLAB_MAX_BLOCK_SIZE */
+
+# if !defined (ACE_DEFAULT_TLS_SLAB_SIZE)
+#   define ACE_DEFAULT_TLS_SLAB_SIZE (64 * 1024)
+# endif /* ACE_DEFAULT_TLS_SLAB_SIZE */
+
 // Max size of an ACE Token.
 # define ACE_MAXTOKENNAMELEN 40
 
@@ -0,0 +1,285 @@
+#include "ace/Dev_Poll_Reactor_Group.h"
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Reactor.h"
+#include "ace/ACE.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_Reactor_Shard_Policy::~ACE_Reactor_Shard_Policy ()
+{
+}
+
+size_t
+ACE_Local_Shard_Policy::select_shard (ACE_HANDLE,
+                                      size_t accepting_shard,
+                                      size_t shard_count)
+{
+  return accepting_shard % shard_count;
+}
+
+ACE_Round_Robin_Shard_Policy::ACE_Round_Robin_Shard_Policy ()
+  : next_ (0)
+{
+}
+
+size_t
+ACE_Round_Robin_Shard_Policy::select_shard (ACE_HANDLE,
+                                            size_t,
+                                            size_t shard_count)
+{
+  return static_cast<size_t> ((this->next_++) % shard_count);
+}
+
+size_t
+ACE_Handle_Hash_Shard_Policy::select_shard (ACE_HANDLE handle,
+                                            size_t accepting_shard,
+                                            size_t shard_count)
+{
+  if (handle == ACE_INVALID_HANDLE)
+    return accepting_shard % shard_count;
+
+  return static_cast<size_t> (handle) % shard_count;
+}
+
+// *********************************************************************
+
+ACE_Dev_Poll_Reactor_Group::ACE_Dev_Poll_Reactor_Group ()
+  : reactors_ (0),
+    size_ (0),
+    reactor_size_ (0),
+    policy_ (0),
+    delete_policy_ (false),
+    bind_cpu_ (false),
+    next_shard_ (0)
+{
+}
+
+ACE_Dev_Poll_Reactor_Group::~ACE_Dev_Poll_Reactor_Group ()
+{
+  this->close_shards ();
+}
+
+int
+ACE_Dev_Poll_Reactor_Group::open_shards (size_t shards,
+                                         size_t size,
+                                         ACE_Reactor_Shard_Policy *policy,
+                                         bool delete_policy)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Group::open_shards");
+
+  if (this->reactors_ != 0)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  if (shards == 0)
+    {
+      long const cpus = ACE_OS::num_processors_online ();
+      shards = cpus > 0 ? static_cast<size_t> (cpus) : 1;
+    }
+
+  this->reactor_size_ = size;
+
+  if (policy == 0)
+    {
+      ACE_NEW_RETURN (policy, ACE_Local_Shard_Policy, -1);
+      delete_policy = true;
+    }
+  this->policy_ = policy;
+  this->delete_policy_ = delete_policy;
+
+  ACE_NEW_RETURN (this->reactors_, ACE_Reactor *[shards], -1);
+  ACE_OS::memset (this->reactors_, 0, shards * sizeof (ACE_Reactor *));
+  this->size_ = shards;
+
+  for (size_t i = 0; i < shards; ++i)
+    {
+      ACE_Reactor_Impl *impl = this->make_reactor_impl (i);
+      if (impl != 0)
+        ACE_NEW_NORETURN (this->reactors_[i], ACE_Reactor (impl, 1));
+
+      if (this->reactors_[i] == 0
+          || this->reactors_[i]->initialized () == 0)
+        {
+          if (this->reactors_[i] == 0)
+            delete impl;
+
+          ACELIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("ACE_Dev_Poll_Reactor_Group::open_shards: ")
+                         ACE_TEXT ("unable to create the reactor of shard %B\n"),
+                         i));
+          this->close_shards ();
+          return -1;
+        }
+    }
+
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor_Group::close_shards ()
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Group::close_shards");
+
+  if (this->reactors_ == 0)
+    return 0;
+
+  if (this->thr_count () > 0)
+    {
+      this->end_event_loops ();
+      this->wait ();
+    }
+
+  for (size_t i = 0; i < this->size_; ++i)
+    if (this->reactors_[i] != 0)
+      this->reclaim_reactor (this->reactors_[i]);
+
+  delete [] this->reactors_;
+  this->reactors_ = 0;
+  this->size_ = 0;
+
+  if (this->delete_policy_)
+    delete this->policy_;
+  this->policy_ = 0;
+  this->delete_policy_ = false;
+
+  return 0;
+}
+
+int
+ACE_Dev_Poll_Reactor_Group::activate_shards (bool bind_cpu, long flags)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor_Group::activate_shards");
+
+  if (this->reactors_ == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  this->bind_cpu_ = bind_cpu;
+  this->next_shard_ = 0;
+
+  return this->activate (flags, static_cast<int> (this->size_));
+}
+
+int
+ACE_Dev_Poll_Reactor_Group::end_event_loops ()
+{
+  int result = 0;
+  for (size_t i = 0; i < this->size_; ++i)
+    if (this->reactors_[i]->end_reactor_event_loop () == -1)
+      result = -1;
+  return result;
+}
+
+size_t
+ACE_Dev_Poll_Reactor_Group::size () const
+{
+  return this->size_;
+}
+
+ACE_Reactor *
+ACE_Dev_Poll_Reactor_Group::reactor (size_t shard) const
+{
+  return shard < this->size_ ? this->reactors_[shard] : 0;
+}
+
+int
+ACE_Dev_Poll_Reactor_Group::shard_of (const ACE_Reactor *reactor) const
+{
+  for (size_t i = 0; i < this->size_; ++i)
+    if (this->reactors_[i] == reactor)
+      return static_cast<int> (i);
+  return -1;
+}
+
+size_t
+ACE_Dev_Poll_Reactor_Group::select_shard (ACE_HANDLE handle,
+                                          size_t accepting_shard)
+{
+  if (this->size_ == 0)
+    return 0;
+
+  return this->policy_->select_shard (handle,
+                                      accepting_shard,
+                                      this->size_) % this->size_;
+}
+
+ACE_Reactor_Shard_Policy *
+ACE_Dev_Poll_Reactor_Group::policy () const
+{
+  return this->policy_;
+}
+
+int
+ACE_Dev_Poll_Reactor_Group::svc ()
+{
+  size_t const shard = static_cast<size_t> (this->next_shard_++);
+  if (shard >= this->size_)
+    return 0;
+
+#if defined (ACE_HAS_PTHREAD_SETAFFINITY_NP) || defined (ACE_HAS_SCHED_SETAFFINITY)
+  if (this->bind_cpu_)
+    {
+      long const cpus = ACE_OS::num_processors_online ();
+      if (cpus > 0)
+        {
+          cpu_set_t mask;
+          CPU_ZERO (&mask);
+          CPU_SET (static_cast<int> (shard % cpus), &mask);
+
+#  if defined (ACE_HAS_PTHREAD_SETAFFINITY_NP)
+          ACE_hthread_t self;
+          ACE_OS::thr_self (self);
+#  else
+          // sched_setaffinity() binds the calling thread when given 0.
+          ACE_hthread_t self = 0;
+#  endif /* ACE_HAS_PTHREAD_SETAFFINITY_NP */
+          if (ACE_OS::thr_set_affinity (self, sizeof mask, &mask) == -1)
+            ACELIB_DEBUG ((LM_DEBUG,
+                           ACE_TEXT ("(%t) ACE_Dev_Poll_Reactor_Group: ")
+                           ACE_TEXT ("shard %B not bound to a CPU: %m\n"),
+                           shard));
+        }
+    }
+#endif /* ACE_HAS_PTHREAD_SETAFFINITY_NP || ACE_HAS_SCHED_SETAFFINITY */
+
+  ACE_Reactor *reactor = this->reactors_[shard];
+  reactor->owner (ACE_Thread::self ());
+  return reactor->run_reactor_event_loop ();
+}
+
+ACE_Reactor_Impl *
+ACE_Dev_Poll_Reactor_Group::make_reactor_impl (size_t)
+{
+  size_t const size =
+    this->reactor_size_ != 0
+      ? this->reactor_size_
+      : static_cast<size_t> (ACE::max_handles ());
+
+  ACE_Reactor_Impl *impl = 0;
+  ACE_NEW_RETURN (impl,
+                  ACE_Dev_Poll_Reactor (size),
+                  0);
+  return impl;
+}
+
+void
+ACE_Dev_Poll_Reactor_Group::reclaim_reactor (ACE_Reactor *reactor)
+{
+  delete reactor;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
@@ -0,0 +1,218 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Dev_Poll_Reactor_Group.h
+ *
+ *  Group of ACE_Dev_Poll_Reactor instances, each run by its own
+ *  thread, and the policies used to spread connections over them.
+ */
+//=============================================================================
+
+#ifndef ACE_DEV_POLL_REACTOR_GROUP_H
+#define ACE_DEV_POLL_REACTOR_GROUP_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Reactor;
+class ACE_Reactor_Impl;
+
+/**
+ * @class ACE_Reactor_Shard_Policy
+ *
+ * @brief Strategy deciding which reactor of an
+ * ACE_Dev_Poll_Reactor_Group services a new connection.
+ */
+class ACE_Export ACE_Reactor_Shard_Policy
+{
+public:
+  virtual ~ACE_Reactor_Shard_Policy ();
+
+  /**
+   * Return the index, in [0, @a shard_count), of the shard that
+   * should service @a handle.  @a accepting_shard is the shard whose
+   * acceptor accepted the connection.
+   */
+  virtual size_t select_shard (ACE_HANDLE handle,
+                               size_t accepting_shard,
+                               size_t shard_count) = 0;
+};
+
+/**
+ * @class ACE_Local_Shard_Policy
+ *
+ * @brief Keep each connection on the shard that accepted it.
+ *
+ * With one SO_REUSEPORT acceptor per shard the kernel already spreads
+ * the incoming connections, so this is the cheapest policy: no
+ * handler ever migrates to another reactor.
+ */
+class ACE_Export ACE_Local_Shard_Policy : public ACE_Reactor_Shard_Policy
+{
+public:
+  virtual size_t select_shard (ACE_HANDLE handle,
+                               size_t accepting_shard,
+                               size_t shard_count);
+};
+
+/**
+ * @class ACE_Round_Robin_Shard_Policy
+ *
+ * @brief Hand the connections to the shards in turn, whichever shard
+ * accepted them.
+ */
+class ACE_Export ACE_Round_Robin_Shard_Policy : public ACE_Reactor_Shard_Policy
+{
+public:
+  ACE_Round_Robin_Shard_Policy ();
+
+  virtual size_t select_shard (ACE_HANDLE handle,
+                               size_t accepting_shard,
+                               size_t shard_count);
+
+private:
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> next_;
+};
+
+/**
+ * @class ACE_Handle_Hash_Shard_Policy
+ *
+ * @brief Pick the shard from the value of the connection handle.
+ */
+class ACE_Export ACE_Handle_Hash_Shard_Policy : public ACE_Reactor_Shard_Policy
+{
+public:
+  virtual size_t select_shard (ACE_HANDLE handle,
+                               size_t accepting_shard,
+                               size_t shard_count);
+};
+
+/**
+ * @class ACE_Dev_Poll_Reactor_Group
+ *
+ * @brief A set of independent ACE_Dev_Poll_Reactor instances.
+ *
+ * A single reactor puts every handle behind one event set and one
+ * token, which becomes the main point of contention once many
+ * threads service many connections.  The group instead gives each
+ * shard its own reactor, and activate_shards() runs each reactor's
+ * event loop in a dedicated thread, optionally bound to one CPU.
+ * Handlers registered with a shard reactor are only ever dispatched
+ * by that shard's thread.
+ *
+ * Connections are distributed over the shards by ACE_Sharded_Acceptor,
+ * which opens one SO_REUSEPORT acceptor per shard and asks the
+ * group's ACE_Reactor_Shard_Policy where each new connection goes.
+ */
+class ACE_Export ACE_Dev_Poll_Reactor_Group : public ACE_Task_Base
+{
+public:
+  ACE_Dev_Poll_Reactor_Group ();
+
+  /// Closes the group.
+  virtual ~ACE_Dev_Poll_Reactor_Group ();
+
+  /**
+   * Create @a shards reactors.  A @a shards of 0 creates one reactor
+   * per online processor.  @a size is the size of each reactor, 0
+   * meaning ACE::max_handles().  @a policy assigns the connections to
+   * the shards; ACE_Local_Shard_Policy is used if it is 0.  The group
+   * deletes @a policy on close_shards() if @a delete_policy is true.
+   */
+  int open_shards (size_t shards = 0,
+                   size_t size = 0,
+                   ACE_Reactor_Shard_Policy *policy = 0,
+                   bool delete_policy = false);
+
+  /// Stop the event loops, wait for their threads and release the
+  /// reactors.
+  int close_shards ();
+
+  /**
+   * Spawn one thread per shard through the ACE_Thread_Manager of
+   * this task, each running the event loop of its reactor.  When
+   * @a bind_cpu is true the thread of shard @c i is bound to CPU
+   * @c i modulo the number of online processors, on platforms
+   * supporting thread affinity.
+   */
+  int activate_shards (bool bind_cpu = true,
+                       long flags = THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED);
+
+  /// End the event loop of every shard.  Does not wait for the
+  /// threads; use wait() for that.
+  int end_event_loops ();
+
+  /// Number of shards.
+  size_t size () const;
+
+  /// Reactor of shard @a shard, 0 if out of range.
+  ACE_Reactor *reactor (size_t shard) const;
+
+  /// Index of the shard running @a reactor, -1 if @a reactor is not
+  /// part of this group.
+  int shard_of (const ACE_Reactor *reactor) const;
+
+  /// Apply the policy of the group to a connection accepted by
+  /// @a accepting_shard.
+  size_t select_shard (ACE_HANDLE handle, size_t accepting_shard);
+
+  /// The shard policy.
+  ACE_Reactor_Shard_Policy *policy () const;
+
+  /// Run the event loop of the next unclaimed shard.
+  virtual int svc ();
+
+protected:
+  /// Create the reactor implementation of shard @a shard.  The default
+  /// creates an ACE_Dev_Poll_Reactor of the size given to
+  /// open_shards().
+  virtual ACE_Reactor_Impl *make_reactor_impl (size_t shard);
+
+  /// Release @a reactor, created through make_reactor_impl().
+  /// Subclasses overriding this method must call close_shards() from
+  /// their own destructor.
+  virtual void reclaim_reactor (ACE_Reactor *reactor);
+
+private:
+  /// Reactors of the shards.
+  ACE_Reactor **reactors_;
+
+  /// Number of shards.
+  size_t size_;
+
+  /// Size of each reactor.
+  size_t reactor_size_;
+
+  ACE_Reactor_Shard_Policy *policy_;
+  bool delete_policy_;
+
+  /// Bind the shard threads to a CPU.
+  bool bind_cpu_;
+
+  /// Next shard to be claimed by a thread entering svc().
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, unsigned long> next_shard_;
+
+  ACE_Dev_Poll_Reactor_Group (const ACE_Dev_Poll_Reactor_Group &) = delete;
+  ACE_Dev_Poll_Reactor_Group &operator= (const ACE_Dev_Poll_Reactor_Group &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_DEV_POLL_REACTOR_GROUP_H */
@@ -0,0 +1,424 @@
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Msg.h"
+#include "ace/ACE.h"
+#include "ace/Thread.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_Memory.h"
+#include "ace/Time_Value.h"
+
+// FUZZ: disable check_for_streams_include
+#include "ace/streams.h"
+
+#if defined (ACE_HAS_THREADS)
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Log_Msg_Async)
+
+// Design notes.
+//
+// ACE_Log_Msg calls log() with its lock held, so there is a single
+// producer at a time and the ring only has to be safe between that
+// producer and the drain thread.  Records are stored as an Entry
+// header followed by the NUL terminated message, rounded up to a
+// multiple of 8 bytes, and never straddle the end of the
+// ring: when a record doesn't fit in the bytes left before the end,
+// an Entry with a zero size marks them as unused.  tail_ and head_
+// count bytes since open() and are only ever increased, the producer
+// publishes a record by moving tail_, the drain thread frees it by
+// moving head_.
+//
+// The drain thread sets sleeping_ before waiting on wakeup_, and log()
+// only takes lock_ to signal it when sleeping_ is set, so a busy
+// logger doesn't touch the lock at all.
+//
+// The drain thread doesn't take the lock of ACE_Log_Msg, which the
+// threads that log hold around log(), it would make them wait for the
+// output.  Only the replacement of the ostream is serialized with the
+// output, by output_lock_.
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async (size_t buffer_size)
+  : buffer_size_ (0),
+    buffer_ (0),
+    tail_ (0),
+    head_ (0),
+    dropped_ (0),
+    reported_ (0),
+    flags_ (ACE_Log_Msg::STDERR),
+    ostream_ (0),
+    local_host_ (0),
+    wakeup_ (lock_),
+    sleeping_ (false),
+    stop_ (false),
+    running_ (false),
+    thr_handle_ (0),
+    verbose_msg_ (0)
+{
+  // Room for at least a few records of the maximum size.
+  size_t const min_size =
+    4 * (sizeof (Entry) + ACE_Log_Record::MAXLOGMSGLEN * sizeof (ACE_TCHAR));
+
+  this->buffer_size_ = 1;
+  while (this->buffer_size_ < buffer_size || this->buffer_size_ < min_size)
+    this->buffer_size_ <<= 1;
+}
+
+ACE_Log_Msg_Async::~ACE_Log_Msg_Async ()
+{
+  this->close ();
+  delete [] this->buffer_;
+  delete [] this->verbose_msg_;
+  delete [] this->local_host_;
+}
+
+int
+ACE_Log_Msg_Async::open (const ACE_TCHAR *)
+{
+  if (this->running_)
+    return 0;
+
+  if (this->buffer_ == 0)
+    {
+      ACE_NEW_RETURN (this->buffer_, char[this->buffer_size_], -1);
+      ACE_NEW_RETURN (this->verbose_msg_,
+                      ACE_TCHAR[ACE_Log_Record::MAXVERBOSELOGMSGLEN],
+                      -1);
+    }
+
+  ACE_Log_Msg *const log_msg = ACE_Log_Msg::instance ();
+
+  if (this->ostream_ == 0)
+    this->ostream_ = log_msg->msg_ostream ();
+
+  delete [] this->local_host_;
+  this->local_host_ = 0;
+  if (log_msg->local_host () != 0)
+    this->local_host_ = ACE::strnew (log_msg->local_host ());
+
+  this->stop_.store (false);
+
+  if (ACE_Thread::spawn (&ACE_Log_Msg_Async::drain_thread,
+                         this,
+                         THR_NEW_LWP | THR_JOINABLE,
+                         0,
+                         &this->thr_handle_) == -1)
+    return -1;
+
+  this->running_ = true;
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::reset ()
+{
+  // ACE_Log_Msg calls this with its lock held, the callers of log()
+  // must not wait for the drain thread.
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::close ()
+{
+  if (!this->running_)
+    return 0;
+
+  this->stop_.store (true);
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1);
+    this->wakeup_.signal ();
+  }
+
+  ACE_Thread::join (this->thr_handle_);
+  this->running_ = false;
+  return 0;
+}
+
+ssize_t
+ACE_Log_Msg_Async::log (ACE_Log_Record &log_record)
+{
+  if (this->buffer_ == 0)
+    return -1;
+
+  size_t const len = ACE_OS::strlen (log_record.msg_data ()) + 1;
+  size_t const align = sizeof (ACE_INT64) - 1;
+  size_t const need =
+    (sizeof (Entry) + len * sizeof (ACE_TCHAR) + align) & ~align;
+
+  size_t tail = this->tail_.load (std::memory_order_relaxed);
+  size_t const head = this->head_.load (std::memory_order_acquire);
+  size_t const offset = tail & (this->buffer_size_ - 1);
+  size_t const skip =
+    offset + need > this->buffer_size_ ? this->buffer_size_ - offset : 0;
+
+  if (need + skip > this->buffer_size_ - (tail - head))
+    {
+      this->dropped_.fetch_add (1, std::memory_order_relaxed);
+      return -1;
+    }
+
+  if (skip != 0)
+    {
+      reinterpret_cast<Entry *> (this->buffer_ + offset)->size_ = 0;
+      tail += skip;
+    }
+
+  Entry *entry =
+    reinterpret_cast<Entry *> (this->buffer_ + (tail & (this->buffer_size_ - 1)));
+  ACE_Time_Value const time_stamp = log_record.time_stamp ();
+  entry->size_ = static_cast<ACE_UINT32> (need);
+  entry->type_ = log_record.type ();
+  entry->pid_ = static_cast<ACE_UINT32> (log_record.pid ());
+  entry->secs_ = time_stamp.sec ();
+  entry->usecs_ = static_cast<ACE_UINT32> (time_stamp.usec ());
+  ACE_OS::memcpy (entry + 1, log_record.msg_data (), len * sizeof (ACE_TCHAR));
+
+  this->tail_.store (tail + need, std::memory_order_release);
+
+  this->wake_up ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::wake_up ()
+{
+  // Pairs with the fence of drain(): either the drain thread sees the
+  // new tail_ or we see that it is sleeping.
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  if (this->sleeping_.load (std::memory_order_relaxed))
+    {
+      ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+      this->wakeup_.signal ();
+    }
+}
+
+int
+ACE_Log_Msg_Async::flush ()
+{
+  if (!this->running_)
+    return 0;
+
+  size_t const tail = this->tail_.load (std::memory_order_acquire);
+  ACE_Time_Value const pause (0, 1000);
+
+  while (this->head_.load (std::memory_order_acquire) < tail)
+    {
+      {
+        ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1);
+        this->wakeup_.signal ();
+      }
+      ACE_OS::sleep (pause);
+    }
+
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::flags (u_long flags)
+{
+  this->flags_ = flags;
+}
+
+u_long
+ACE_Log_Msg_Async::flags () const
+{
+  return this->flags_;
+}
+
+void
+ACE_Log_Msg_Async::msg_ostream (ACE_OSTREAM_TYPE *m)
+{
+  ACE_GUARD (ACE_Recursive_Thread_Mutex, ace_mon, this->output_lock_);
+  this->ostream_ = m;
+}
+
+ACE_OSTREAM_TYPE *
+ACE_Log_Msg_Async::msg_ostream () const
+{
+  return this->ostream_;
+}
+
+ACE_Recursive_Thread_Mutex &
+ACE_Log_Msg_Async::output_lock ()
+{
+  return this->output_lock_;
+}
+
+size_t
+ACE_Log_Msg_Async::dropped () const
+{
+  return this->dropped_.load (std::memory_order_relaxed);
+}
+
+size_t
+ACE_Log_Msg_Async::buffer_size () const
+{
+  return this->buffer_size_;
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Async::drain_thread (void *arg)
+{
+  static_cast<ACE_Log_Msg_Async *> (arg)->drain ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::drain ()
+{
+  for (;;)
+    {
+      if (this->drain_once ())
+        continue;
+
+      // The last records are written before we leave.
+      if (this->stop_.load ())
+        return;
+
+      ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+      this->sleeping_.store (true, std::memory_order_relaxed);
+      std::atomic_thread_fence (std::memory_order_seq_cst);
+
+      if (this->tail_.load (std::memory_order_relaxed)
+            == this->head_.load (std::memory_order_relaxed)
+          && !this->stop_.load ())
+        this->wakeup_.wait ();
+
+      this->sleeping_.store (false, std::memory_order_relaxed);
+    }
+}
+
+/// Write all the records in the ring, return false if there was none.
+bool
+ACE_Log_Msg_Async::drain_once ()
+{
+  size_t head = this->head_.load (std::memory_order_relaxed);
+  size_t tail = this->tail_.load (std::memory_order_acquire);
+
+  if (head == tail)
+    return false;
+
+  // Only serialize with the replacement of the ostream, the records
+  // are taken from the ring once the lock is held so that a thread
+  // holding it, e.g. to rotate the log file, doesn't lose them.
+  bool const to_ostream = ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::OSTREAM);
+
+  if (to_ostream)
+    this->output_lock_.acquire ();
+
+  while (head != tail)
+    {
+      Entry const *entry =
+        reinterpret_cast<Entry *> (this->buffer_ + (head & (this->buffer_size_ - 1)));
+
+      if (entry->size_ == 0)
+        {
+          head += this->buffer_size_ - (head & (this->buffer_size_ - 1));
+          continue;
+        }
+
+      this->record_.type (entry->type_);
+      this->record_.pid (entry->pid_);
+      this->record_.time_stamp (ACE_Time_Value (static_cast<time_t> (entry->secs_),
+                                                entry->usecs_));
+      this->record_.msg_data (reinterpret_cast<const ACE_TCHAR *> (entry + 1));
+
+      // The message is copied, release the room before the output.
+      head += entry->size_;
+      this->head_.store (head, std::memory_order_release);
+
+      this->write (this->record_);
+
+      if (head == tail)
+        tail = this->tail_.load (std::memory_order_acquire);
+    }
+
+  this->head_.store (head, std::memory_order_release);
+
+  size_t const dropped = this->dropped_.load (std::memory_order_relaxed);
+  if (dropped != this->reported_)
+    {
+      ACE_TCHAR msg[128];
+      ACE_OS::snprintf (msg, sizeof msg / sizeof (ACE_TCHAR),
+                        ACE_TEXT ("ACE_Log_Msg_Async: %lu log records ")
+                        ACE_TEXT ("dropped, the buffer was full\n"),
+                        static_cast<unsigned long> (dropped - this->reported_));
+      this->reported_ = dropped;
+
+      this->record_.type (LM_WARNING);
+      this->record_.time_stamp (ACE_OS::gettimeofday ());
+      this->record_.msg_data (msg);
+      this->write (this->record_);
+    }
+
+  if (to_ostream)
+    {
+      if (this->ostream_ != 0)
+        {
+#if defined (ACE_LACKS_IOSTREAM_TOTALLY)
+          ACE_OS::fflush (this->ostream_);
+#else
+          this->ostream_->flush ();
+#endif /* ACE_LACKS_IOSTREAM_TOTALLY */
+        }
+
+      this->output_lock_.release ();
+    }
+
+#if !defined (ACE_LACKS_STDERR)
+  if (ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::STDERR))
+    ACE_OS::fflush (stderr);
+#endif /* !ACE_LACKS_STDERR */
+
+  return true;
+}
+
+/// Format @a record like ACE_Log_Record::print() does and write it to
+/// the outputs selected by <flags_>.  The output is only flushed once
+/// the ring is empty.
+void
+ACE_Log_Msg_Async::write (ACE_Log_Record &record)
+{
+  if (record.format_msg (this->local_host_,
+                         this->flags_,
+                         this->verbose_msg_,
+                         ACE_Log_Record::MAXVERBOSELOGMSGLEN) != 0)
+    return;
+
+#if !defined (ACE_LACKS_STDERR)
+  if (ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::STDERR))
+    {
+# if !defined (ACE_WIN32) && defined (ACE_USES_WCHAR)
+      ACE_OS::fprintf (stderr, ACE_TEXT ("%ls"), this->verbose_msg_);
+# else
+      ACE_OS::fprintf (stderr, ACE_TEXT ("%s"), this->verbose_msg_);
+# endif
+    }
+#endif /* !ACE_LACKS_STDERR */
+
+  if (ACE_BIT_ENABLED (this->flags_, ACE_Log_Msg::OSTREAM)
+      && this->ostream_ != 0)
+    {
+#if defined (ACE_LACKS_IOSTREAM_TOTALLY)
+# if !defined (ACE_WIN32) && defined (ACE_USES_WCHAR)
+      ACE_OS::fprintf (this->ostream_,
+                       ACE_TEXT ("%ls"),
+                       this->verbose_msg_);
+# else
+      ACE_OS::fprintf (this->ostream_,
+                       ACE_TEXT ("%s"),
+                       this->verbose_msg_);
+# endif
+#else
+      // Since ostream expects only chars, we cannot pass wchar_t's
+      *this->ostream_ << ACE_TEXT_ALWAYS_CHAR (this->verbose_msg_);
+#endif /* ACE_LACKS_IOSTREAM_TOTALLY */
+    }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
@@ -0,0 +1,183 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async.h
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_ASYNC_H
+#define ACE_LOG_MSG_ASYNC_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Log_Msg_Backend.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Default_Constants.h"
+#include "ace/iosfwd.h"
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Thread_Mutex.h"
+#include "ace/Recursive_Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Log_Record.h"
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Log_Msg_Async
+ *
+ * @brief ACE_Log_Msg backend that hands the log records over to a
+ * separate thread.
+ *
+ * log() only copies the record into a bounded ring buffer, without
+ * taking any other lock than the one ACE_Log_Msg already holds around
+ * the call.  A drain thread started by open() formats the records,
+ * with the verbose prefix selected by flags(), and writes them to
+ * stderr and/or an ostream.  The drain thread never takes the lock of
+ * ACE_Log_Msg, so a thread that logs never waits for the output.
+ *
+ * When the ring is full the record is dropped and counted, logging
+ * never blocks.  The drain thread reports the number of records lost
+ * in the output once the ring has room again.
+ *
+ * Install it with ACE_Log_Msg::msg_backend() and the
+ * ACE_Log_Msg::CUSTOM flag, clearing ACE_Log_Msg::STDERR and
+ * ACE_Log_Msg::OSTREAM so that ACE_Log_Msg doesn't write the records
+ * too, or with the -a option of ACE_Logging_Strategy.
+ *
+ * @note log() must not be called concurrently, which ACE_Log_Msg
+ * guarantees.  open(), reset() and log() never wait for the drain
+ * thread; close(), flush() and msg_ostream() do, so they must not be
+ * called with output_lock() held by another thread.
+ */
+class ACE_Export ACE_Log_Msg_Async : public ACE_Log_Msg_Backend
+{
+public:
+  /// Constructor, @a buffer_size is the size of the ring in bytes.
+  ACE_Log_Msg_Async (size_t buffer_size = ACE_DEFAULT_LOG_MSG_ASYNC_BUFFER_SIZE);
+
+  /// Destructor, closes the backend.
+  virtual ~ACE_Log_Msg_Async ();
+
+  /// Allocate the ring and start the drain thread.  @a logger_key is
+  /// ignored.  The local host name of ACE_Log_Msg, used by the
+  /// ACE_Log_Msg::VERBOSE prefix, is read here.
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Does nothing, the records queued keep being written.
+  virtual int reset ();
+
+  /// Write the records queued and stop the drain thread.
+  virtual int close ();
+
+  /// Queue @a log_record for the drain thread.  Returns -1 and counts
+  /// the record as dropped when the ring is full.
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Wait until the drain thread has written all the records queued
+  /// before the call.
+  int flush ();
+
+  /// Select the output of the drain thread: any of ACE_Log_Msg::STDERR
+  /// and ACE_Log_Msg::OSTREAM, with ACE_Log_Msg::VERBOSE or
+  /// ACE_Log_Msg::VERBOSE_LITE.  Defaults to ACE_Log_Msg::STDERR.
+  void flags (u_long flags);
+  u_long flags () const;
+
+  /// Set the ostream written for ACE_Log_Msg::OSTREAM, defaults to
+  /// the ostream of the ACE_Log_Msg of the thread that calls open().
+  /// Returns once the drain thread no longer writes to the previous
+  /// ostream, which can then be closed or deleted.
+  void msg_ostream (ACE_OSTREAM_TYPE *m);
+  ACE_OSTREAM_TYPE *msg_ostream () const;
+
+  /// Lock held by the drain thread while it writes to and flushes the
+  /// ostream.  Hold it to close and reopen the ostream in place, e.g.
+  /// to rotate log files.  The threads that log never take it.
+  ACE_Recursive_Thread_Mutex &output_lock ();
+
+  /// Number of records dropped because the ring was full.
+  size_t dropped () const;
+
+  /// Size of the ring, in bytes.
+  size_t buffer_size () const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  enum
+  {
+    /// Assumed size of a cache line.
+    CACHE_LINE = 64
+  };
+
+  /// Header of each record in the ring, followed by its message.  A
+  /// header with a zero size only marks the end of the ring.
+  struct Entry
+  {
+    ACE_UINT32 size_;
+    ACE_UINT32 type_;
+    ACE_UINT32 pid_;
+    ACE_UINT32 usecs_;
+    ACE_INT64 secs_;
+  };
+
+  static ACE_THR_FUNC_RETURN drain_thread (void *arg);
+  void drain ();
+  bool drain_once ();
+  void write (ACE_Log_Record &record);
+  void wake_up ();
+
+  /// Size of the ring, a power of 2.
+  size_t buffer_size_;
+  char *buffer_;
+
+  /// Bytes written by log() and read by the drain thread since open().
+  /// Each is on a cache line of its own, the producer and the drain
+  /// thread only read the other one.
+  char pad0_[CACHE_LINE];
+  std::atomic<size_t> tail_;
+  char pad1_[CACHE_LINE - sizeof (std::atomic<size_t>)];
+  std::atomic<size_t> head_;
+  char pad2_[CACHE_LINE - sizeof (std::atomic<size_t>)];
+
+  std::atomic<size_t> dropped_;
+
+  /// Dropped records the drain thread reported already.
+  size_t reported_;
+
+  u_long flags_;
+
+  /// Serializes the output to <ostream_> with its replacement.
+  ACE_Recursive_Thread_Mutex output_lock_;
+  ACE_OSTREAM_TYPE *ostream_;
+
+  /// Copy of the local host name of ACE_Log_Msg, or 0.
+  ACE_TCHAR *local_host_;
+
+  /// The drain thread sleeps on <wakeup_> when the ring is empty.
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex wakeup_;
+  std::atomic<bool> sleeping_;
+  std::atomic<bool> stop_;
+  bool running_;
+  ACE_hthread_t thr_handle_;
+
+  /// Record and text buffer only used by the drain thread.
+  ACE_Log_Record record_;
+  ACE_TCHAR *verbose_msg_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_ASYNC_H */
@@ -9,6 +9,7 @@
 
 #include "ace/Lib_Find.h"
 #include "ace/Log_Category.h"
+#include "ace/Log_Msg_Async.h"
 #include "ace/Reactor.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_stdio.h"
@@ -147,14 +148,21 @@ ACE_Logging_Strategy::parse_args (int argc, ACE_TCHAR *argv[])
   this->max_file_number_ = 1;
   this->interval_ = ACE_DEFAULT_LOGFILE_POLL_INTERVAL;
   this->max_size_ = 0;
+  this->async_buffer_size_ = 0;
 
   ACE_Get_Opt get_opt (argc, argv,
-                       ACE_TEXT ("f:i:k:m:n:N:op:s:t:w"), 0);
+                       ACE_TEXT ("a:f:i:k:m:n:N:op:s:t:w"), 0);
 
   for (int c; (c = get_opt ()) != -1; )
     {
       switch (c)
         {
+        case 'a':
+          // Size of the buffer of the asynchronous backend (in KB).
+          this->async_buffer_size_ =
+            ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+          this->async_buffer_size_ <<= 10;  // convert from KB to bytes.
+          break;
         case 'f':
           temp = get_opt.opt_arg ();
           // Now tokenize the string to get all the flags
@@ -248,7 +256,10 @@ ACE_Logging_Strategy::ACE_Logging_Strategy ()
     max_file_number_ (1), // 2 files by default (max file number + 1)
     interval_ (ACE_DEFAULT_LOGFILE_POLL_INTERVAL),
     max_size_ (0),
-    log_msg_ (ACE_Log_Msg::instance ())
+    log_msg_ (ACE_Log_Msg::instance ()),
+    async_buffer_size_ (0),
+    async_backend_ (0),
+    previous_backend_ (0)
 {
 #if defined (ACE_DEFAULT_LOGFILE)
   this->filename_ = ACE::strnew (ACE_DEFAULT_LOGFILE);
@@ -311,9 +322,57 @@ ACE_Logging_Strategy::fini ()
       && this->interval_ > 0 && this->max_size_ > 0)
     this->reactor ()->cancel_timer (this);
 
+  this->close_async_backend ();
+
   return 0;
 }
 
+void
+ACE_Logging_Strategy::acquire_async_output ()
+{
+#if defined (ACE_HAS_THREADS)
+  // The drain thread of the asynchronous backend doesn't take the lock
+  // of ACE_Log_Msg, only its own around the output.
+  if (this->async_backend_ != 0)
+    this->async_backend_->output_lock ().acquire ();
+#endif /* ACE_HAS_THREADS */
+}
+
+void
+ACE_Logging_Strategy::release_async_output ()
+{
+#if defined (ACE_HAS_THREADS)
+  if (this->async_backend_ != 0)
+    {
+      // The log file may have been reopened as another stream.
+      this->async_backend_->msg_ostream (this->log_msg_->msg_ostream ());
+      this->async_backend_->output_lock ().release ();
+    }
+#endif /* ACE_HAS_THREADS */
+}
+
+void
+ACE_Logging_Strategy::close_async_backend ()
+{
+#if defined (ACE_HAS_THREADS)
+  if (this->async_backend_ == 0)
+    return;
+
+  // Give the output back to ACE_Log_Msg, then write the records still
+  // queued.
+  this->log_msg_->msg_backend (this->previous_backend_);
+  if (this->previous_backend_ == 0)
+    this->log_msg_->clr_flags (ACE_Log_Msg::CUSTOM);
+  this->log_msg_->set_flags (this->async_backend_->flags ()
+                             & (ACE_Log_Msg::STDERR | ACE_Log_Msg::OSTREAM));
+
+  this->async_backend_->close ();
+  delete this->async_backend_;
+  this->async_backend_ = 0;
+  this->previous_backend_ = 0;
+#endif /* ACE_HAS_THREADS */
+}
+
 int
 ACE_Logging_Strategy::init (int argc, ACE_TCHAR *argv[])
 {
@@ -330,6 +389,10 @@ ACE_Logging_Strategy::init (int argc, ACE_TCHAR *argv[])
   // Use the options hook to parse the command line arguments.
   this->parse_args (argc, argv);
 
+  // On reconfiguration, go back to synchronous logging before the new
+  // options are applied.
+  this->close_async_backend ();
+
   // Setup priorities (to original if not specified on command line)
 
   this->log_msg_->priority_mask (thread_priority_mask_,
@@ -417,8 +480,32 @@ ACE_Logging_Strategy::init (int argc, ACE_TCHAR *argv[])
       this->log_msg_->set_flags (this->flags_);
     }
 
+  u_long flags = this->log_msg_->flags ();
+
+#if defined (ACE_HAS_THREADS)
+  if (this->async_buffer_size_ > 0)
+    {
+      ACE_NEW_RETURN (this->async_backend_,
+                      ACE_Log_Msg_Async (this->async_buffer_size_),
+                      -1);
+      this->async_backend_->msg_ostream (this->log_msg_->msg_ostream ());
+      this->async_backend_->flags (flags
+                                   & (ACE_Log_Msg::STDERR
+                                      | ACE_Log_Msg::OSTREAM
+                                      | ACE_Log_Msg::VERBOSE
+                                      | ACE_Log_Msg::VERBOSE_LITE));
+      this->previous_backend_ =
+        this->log_msg_->msg_backend (this->async_backend_);
+
+      // The backend writes to stderr and the ostream from now on.
+      this->log_msg_->clr_flags (ACE_Log_Msg::STDERR | ACE_Log_Msg::OSTREAM);
+      ACE_CLR_BITS (flags, ACE_Log_Msg::STDERR | ACE_Log_Msg::OSTREAM);
+      ACE_SET_BITS (flags, ACE_Log_Msg::CUSTOM);
+    }
+#endif /* ACE_HAS_THREADS */
+
   return this->log_msg_->open (this->program_name_,
-                               this->log_msg_->flags (),
+                               flags,
                                this->logger_key_);
 }
 
@@ -438,6 +525,8 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                            ACE_TEXT ("Cannot acquire lock!\n")),
                           -1);
 
+      this->acquire_async_output ();
+
       // Close the current ostream.
 #if defined (ACE_LACKS_IOSTREAM_TOTALLY)
       FILE *output_file = (FILE *) this->log_msg_->msg_ostream ();
@@ -463,7 +552,10 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                                            ACE_TEXT ("wt"));
 
               if (output_file == 0)
-                return -1;
+                {
+                  this->release_async_output ();
+                  return -1;
+                }
 
               this->log_msg_->msg_ostream (output_file);
 #else
@@ -471,7 +563,8 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                                  ios::out);
 #endif /* ACE_LACKS_IOSTREAM_TOTALLY */
 
-              // Release the lock previously acquired.
+              // Release the locks previously acquired.
+              this->release_async_output ();
               this->log_msg_->release ();
               return 0;
             }
@@ -556,7 +649,10 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
       output_file = ACE_OS::fopen (this->filename_, ACE_TEXT ("wt"));
 
       if (output_file == 0)
-        return -1;
+        {
+          this->release_async_output ();
+          return -1;
+        }
 
       this->log_msg_->msg_ostream (output_file);
 #else
@@ -564,7 +660,8 @@ ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                          ios::out);
 #endif /* ACE_LACKS_IOSTREAM_TOTALLY */
 
-      // Release the lock previously acquired.
+      // Release the locks previously acquired.
+      this->release_async_output ();
       this->log_msg_->release ();
     }
 
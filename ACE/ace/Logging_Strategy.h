@@ -25,6 +25,8 @@
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class ACE_Log_Msg_Async;
+
 /**
  * @class ACE_Logging_Strategy
  *
@@ -74,6 +76,11 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
  * dynamically linking the @c ACE_Logging_Strategy then you can use
  * the @c ACE_Dynamic_Service template to get a pointer to the
  * @c ACE_Logging_Strategy.
+ *
+ * With the -a option the records written to stderr and to the log
+ * file are handed over to an @c ACE_Log_Msg_Async backend, whose
+ * thread formats and writes them, so the threads that log don't wait
+ * for the output.
  */
 class ACE_Export ACE_Logging_Strategy : public ACE_Service_Object
 {
@@ -116,6 +123,10 @@ public:
 
   /**
    * Parse arguments provided in svc.conf file.
+   * @arg '-a' Size in Kbytes of the buffer of an ACE_Log_Msg_Async backend
+   *           that writes to stderr and the logfile asynchronously
+   *           (default is 0, i.e., write synchronously).  Records are
+   *           dropped and counted when the buffer is full.
    * @arg '-f' Pass in the flags (such as OSTREAM, STDERR, LOGGER, VERBOSE,
    *           SILENT, VERBOSE_LITE) used to control logging.
    * @arg '-i' The interval (in seconds) at which the logfile size is sampled
@@ -147,6 +158,14 @@ protected:
   /// Tokenize to set all the flags
   void tokenize (ACE_TCHAR *flag_string);
 
+  /// Stop writing asynchronously, if we did.
+  void close_async_backend ();
+
+  /// Serialize the rotation of the log file with the output of the
+  /// asynchronous backend, if any.
+  void acquire_async_output ();
+  void release_async_output ();
+
   /// Tokenize to set priorities (either process or thread one).
   void priorities (ACE_TCHAR *priority_string,
                    ACE_Log_Msg::MASK_TYPE mask);
@@ -201,6 +220,16 @@ protected:
 
   /// ACE_Log_Msg instance to work with
   ACE_Log_Msg *log_msg_;
+
+  /// Size of the buffer of <async_backend_> (in bytes), 0 to log
+  /// synchronously.  Default value is 0.
+  size_t async_buffer_size_;
+
+  /// Backend writing the records asynchronously, if any.
+  ACE_Log_Msg_Async *async_backend_;
+
+  /// Custom backend that <async_backend_> replaced.
+  ACE_Log_Msg_Backend *previous_backend_;
 };
 
 ACE_STATIC_SVC_DECLARE_EXPORT(ACE, ACE_Logging_Strategy)
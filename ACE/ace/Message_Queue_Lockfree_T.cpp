@@ -0,0 +1,732 @@
+#ifndef ACE_MESSAGE_QUEUE_LOCKFREE_T_CPP
+#define ACE_MESSAGE_QUEUE_LOCKFREE_T_CPP
+
+#include "ace/Message_Queue_Lockfree_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Log_Category.h"
+#include "ace/Notification_Strategy.h"
+#include "ace/Truncate.h"
+#include "ace/OS_NS_Thread.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tyc(ACE_Message_Queue_Lockfree)
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::ACE_Message_Queue_Lockfree (size_t hwm,
+                                                                                    size_t lwm,
+                                                                                    ACE_Notification_Strategy *ns,
+                                                                                    size_t capacity)
+  : inherited (hwm, lwm, ns),
+    cells_ (0),
+    mask_ (0),
+    enqueue_pos_ (0),
+    dequeue_pos_ (0),
+    bytes_ (0),
+    length_ (0),
+    hwm_ (hwm),
+    lwm_ (lwm),
+    queue_state_ (ACE_Message_Queue_Base::ACTIVATED),
+    waiting_consumers_ (0),
+    waiting_producers_ (0),
+    ring_waiters_ (0)
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::ACE_Message_Queue_Lockfree");
+
+  size_t size = 2;
+  while (size < capacity)
+    size <<= 1;
+
+  ACE_NEW_NORETURN (this->cells_, Cell[size]);
+  if (this->cells_ == 0)
+    {
+      ACELIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("ACE_Message_Queue_Lockfree: ")
+                     ACE_TEXT ("cannot allocate %B slots\n"),
+                     size));
+      // Every operation fails with ESHUTDOWN from now on.
+      this->queue_state_ = ACE_Message_Queue_Base::DEACTIVATED;
+      this->state_ = ACE_Message_Queue_Base::DEACTIVATED;
+      return;
+    }
+
+  this->mask_ = size - 1;
+  for (size_t i = 0; i < size; ++i)
+    {
+      this->cells_[i].sequence_.store (i, std::memory_order_relaxed);
+      this->cells_[i].item_.store (0, std::memory_order_relaxed);
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Message_Queue_Lockfree ()
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Message_Queue_Lockfree");
+
+  if (this->cells_ != 0 && this->close () == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("close")));
+
+  delete [] this->cells_;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::open (size_t hwm,
+                                                              size_t lwm,
+                                                              ACE_Notification_Strategy *ns)
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::open");
+
+  if (this->cells_ == 0)
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  this->hwm_ = hwm;
+  this->lwm_ = lwm;
+  this->high_water_mark_ = hwm;
+  this->low_water_mark_ = lwm;
+  this->notification_strategy_ = ns;
+  this->queue_state_ = ACE_Message_Queue_Base::ACTIVATED;
+  this->state_ = ACE_Message_Queue_Base::ACTIVATED;
+  return 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::close ()
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::close");
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  this->deactivate_i ();
+
+  return this->flush_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::flush ()
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::flush");
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  return this->flush_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::flush_i ()
+{
+  int number_flushed = 0;
+
+  // The lock does not keep producers and consumers away, take the
+  // messages out as a consumer would.
+  ACE_Message_Block *item = 0;
+  while (this->pop (item))
+    {
+      ++number_flushed;
+
+      size_t mb_bytes = 0;
+      size_t mb_length = 0;
+      item->total_size_and_length (mb_bytes, mb_length);
+      this->bytes_ -= mb_bytes;
+      this->length_ -= mb_length;
+
+      item->release ();
+    }
+
+  return number_flushed;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::peek_dequeue_head (ACE_Message_Block *&first_item,
+                                                                           ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::peek_dequeue_head");
+
+  if (this->queue_state_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  for (;;)
+    {
+      size_t const pos = this->dequeue_pos_.load (std::memory_order_acquire);
+      Cell &cell = this->cells_[pos & this->mask_];
+
+      if (cell.sequence_.load (std::memory_order_acquire) == pos + 1)
+        {
+          ACE_Message_Block *item =
+            cell.item_.load (std::memory_order_relaxed);
+
+          // Only trust the item if no consumer took the slot meanwhile.
+          if (cell.sequence_.load (std::memory_order_acquire) == pos + 1)
+            {
+              first_item = item;
+              return this->queue_count ();
+            }
+          continue;
+        }
+
+      if (this->wait_not_empty_cond (timeout) == -1)
+        return -1;
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail (ACE_Message_Block *new_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail");
+
+  if (new_item == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  int result = 0;
+  ACE_Message_Block *next = 0;
+  for (ACE_Message_Block *mb = new_item; mb != 0; mb = next)
+    {
+      next = mb->next ();
+      mb->next (0);
+      mb->prev (0);
+
+      result = this->enqueue_one (mb, timeout);
+      if (result == -1)
+        {
+          // Give the rest of the list back to the caller as it was.
+          mb->next (next);
+          return -1;
+        }
+    }
+
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue_prio (ACE_Message_Block *new_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline (ACE_Message_Block *new_item,
+                                                                          ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue (ACE_Message_Block *new_item,
+                                                                 ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue_head (ACE_Message_Block *new_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_UNUSED_ARG (new_item);
+  ACE_UNUSED_ARG (timeout);
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::enqueue_one (ACE_Message_Block *new_item,
+                                                                     ACE_Time_Value *timeout)
+{
+  if (this->queue_state_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  size_t mb_bytes = 0;
+  size_t mb_length = 0;
+  new_item->total_size_and_length (mb_bytes, mb_length);
+
+  for (;;)
+    {
+      if (this->bytes_.load () < this->hwm_.load ())
+        {
+          // Count the message before it becomes visible, a consumer
+          // may take it out right away.
+          this->bytes_ += mb_bytes;
+          this->length_ += mb_length;
+
+          if (this->push (new_item))
+            break;
+
+          this->bytes_ -= mb_bytes;
+          this->length_ -= mb_length;
+        }
+
+      if (this->wait_not_full_cond (timeout) == -1)
+        return -1;
+    }
+
+  this->signal_consumers ();
+
+  ACE_Notification_Strategy * const notifier = this->notification_strategy_;
+  if (notifier != 0)
+    notifier->notify ();
+
+  return this->queue_count ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head (ACE_Message_Block *&first_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head");
+
+  if (this->queue_state_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  // A producer is often about to publish, give it a few chances to do
+  // so before paying for the lock and a sleep.
+  for (int spin = 0; !this->pop (first_item); ++spin)
+    if (spin < SPIN_LIMIT)
+      ACE_OS::thr_yield ();
+    else if (this->wait_not_empty_cond (timeout) == -1)
+      return -1;
+
+  size_t mb_bytes = 0;
+  size_t mb_length = 0;
+  first_item->total_size_and_length (mb_bytes, mb_length);
+  this->bytes_ -= mb_bytes;
+  this->length_ -= mb_length;
+
+  this->signal_producers ();
+
+  return this->queue_count ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio (ACE_Message_Block *&dequeued,
+                                                                      ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (dequeued, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline (ACE_Message_Block *&dequeued,
+                                                                          ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (dequeued, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dequeue (ACE_Message_Block *&first_item,
+                                                                 ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (first_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dequeue_tail (ACE_Message_Block *&dequeued,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_UNUSED_ARG (dequeued);
+  ACE_UNUSED_ARG (timeout);
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::push (ACE_Message_Block *item)
+{
+  size_t pos = this->enqueue_pos_.load (std::memory_order_relaxed);
+  Cell *cell = 0;
+
+  for (;;)
+    {
+      cell = &this->cells_[pos & this->mask_];
+      size_t const seq = cell->sequence_.load (std::memory_order_acquire);
+      ptrdiff_t const diff =
+        static_cast<ptrdiff_t> (seq) - static_cast<ptrdiff_t> (pos);
+
+      if (diff == 0)
+        {
+          if (this->enqueue_pos_.compare_exchange_weak (pos,
+                                                        pos + 1,
+                                                        std::memory_order_relaxed))
+            break;
+        }
+      else if (diff < 0)
+        return false;
+      else
+        pos = this->enqueue_pos_.load (std::memory_order_relaxed);
+    }
+
+  cell->item_.store (item, std::memory_order_relaxed);
+  cell->sequence_.store (pos + 1, std::memory_order_release);
+  return true;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::pop (ACE_Message_Block *&item)
+{
+  size_t pos = this->dequeue_pos_.load (std::memory_order_relaxed);
+  Cell *cell = 0;
+
+  for (;;)
+    {
+      cell = &this->cells_[pos & this->mask_];
+      size_t const seq = cell->sequence_.load (std::memory_order_acquire);
+      ptrdiff_t const diff =
+        static_cast<ptrdiff_t> (seq) - static_cast<ptrdiff_t> (pos + 1);
+
+      if (diff == 0)
+        {
+          if (this->dequeue_pos_.compare_exchange_weak (pos,
+                                                        pos + 1,
+                                                        std::memory_order_relaxed))
+            break;
+        }
+      else if (diff < 0)
+        return false;
+      else
+        pos = this->dequeue_pos_.load (std::memory_order_relaxed);
+    }
+
+  item = cell->item_.load (std::memory_order_relaxed);
+  cell->sequence_.store (pos + this->mask_ + 1, std::memory_order_release);
+  return true;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::ring_full () const
+{
+  size_t const pos = this->enqueue_pos_.load ();
+  size_t const seq =
+    this->cells_[pos & this->mask_].sequence_.load ();
+  return static_cast<ptrdiff_t> (seq) - static_cast<ptrdiff_t> (pos) < 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::ring_empty () const
+{
+  size_t const pos = this->dequeue_pos_.load ();
+  size_t const seq =
+    this->cells_[pos & this->mask_].sequence_.load ();
+  return static_cast<ptrdiff_t> (seq) - static_cast<ptrdiff_t> (pos + 1) < 0;
+}
+
+// A parked thread registers itself and checks the ring again, with the
+// queue lock held, before it sleeps.  The thread changing the ring
+// makes its change and then looks for parked threads.  The sequentially
+// consistent fences on both sides guarantee that either the parked
+// thread sees the change or the other thread sees it registered, and
+// then it takes the lock, which can only happen once the parked thread
+// is waiting on the condition.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::signal_consumers ()
+{
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  if (this->waiting_consumers_.load (std::memory_order_relaxed) > 0)
+    {
+      ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+      this->not_empty_cond_.signal ();
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::signal_producers ()
+{
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  if (this->waiting_producers_.load (std::memory_order_relaxed) == 0)
+    return;
+
+  // Producers stopped by the ring need any free slot, the others wait
+  // for the low water mark as with ACE_Message_Queue.
+  if (this->ring_waiters_.load (std::memory_order_relaxed) > 0)
+    {
+      ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+      this->not_full_cond_.broadcast ();
+    }
+  else if (this->bytes_.load (std::memory_order_relaxed)
+             <= this->lwm_.load (std::memory_order_relaxed))
+    {
+      ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+      this->not_full_cond_.signal ();
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::wait_not_full_cond (ACE_Time_Value *timeout)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  if (this->queue_state_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  ++this->waiting_producers_;
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  int result = 0;
+  for (;;)
+    {
+      bool on_ring = false;
+      if (this->bytes_.load () < this->hwm_.load ())
+        {
+          if (!this->ring_full ())
+            break;
+
+          on_ring = true;
+          ++this->ring_waiters_;
+          std::atomic_thread_fence (std::memory_order_seq_cst);
+          if (!this->ring_full ())
+            {
+              --this->ring_waiters_;
+              break;
+            }
+        }
+
+      int const wait_result = this->not_full_cond_.wait (timeout);
+
+      if (on_ring)
+        --this->ring_waiters_;
+
+      if (wait_result == -1)
+        {
+          if (errno == ETIME)
+            errno = EWOULDBLOCK;
+          result = -1;
+          break;
+        }
+      if (this->queue_state_.load () != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          errno = ESHUTDOWN;
+          result = -1;
+          break;
+        }
+    }
+
+  --this->waiting_producers_;
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::wait_not_empty_cond (ACE_Time_Value *timeout)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  if (this->queue_state_.load () == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  ++this->waiting_consumers_;
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  int result = 0;
+  while (this->ring_empty ())
+    {
+      if (this->not_empty_cond_.wait (timeout) == -1)
+        {
+          if (errno == ETIME)
+            errno = EWOULDBLOCK;
+          result = -1;
+          break;
+        }
+      if (this->queue_state_.load () != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          errno = ESHUTDOWN;
+          result = -1;
+          break;
+        }
+    }
+
+  --this->waiting_consumers_;
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::deactivate_i (int pulse)
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::deactivate_i");
+  int const previous_state = this->queue_state_.load ();
+
+  if (previous_state != ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      int const new_state = pulse
+        ? ACE_Message_Queue_Base::PULSED
+        : ACE_Message_Queue_Base::DEACTIVATED;
+      this->queue_state_ = new_state;
+      this->state_ = new_state;
+
+      // Wakeup all waiters.
+      this->not_empty_cond_.broadcast ();
+      this->not_full_cond_.broadcast ();
+    }
+
+  return previous_state;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::activate_i ()
+{
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::activate_i");
+
+  if (this->cells_ == 0)
+    return ACE_Message_Queue_Base::DEACTIVATED;
+
+  this->state_ = ACE_Message_Queue_Base::ACTIVATED;
+  return this->queue_state_.exchange (ACE_Message_Queue_Base::ACTIVATED);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::is_full_i ()
+{
+  return this->bytes_.load () >= this->hwm_.load () || this->ring_full ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::is_empty_i ()
+{
+  return this->ring_empty ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::is_full ()
+{
+  return this->is_full_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::is_empty ()
+{
+  return this->is_empty_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::queue_count () const
+{
+  // Read the head first, the tail can only be further ahead.
+  size_t const head = this->dequeue_pos_.load ();
+  size_t const tail = this->enqueue_pos_.load ();
+  return ACE_Utils::truncate_cast<int> (tail - head);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::message_bytes ()
+{
+  return this->bytes_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::message_length ()
+{
+  return this->length_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::message_count ()
+{
+  size_t const head = this->dequeue_pos_.load ();
+  size_t const tail = this->enqueue_pos_.load ();
+  return tail - head;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (size_t new_value)
+{
+  this->bytes_ = new_value;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::message_length (size_t new_value)
+{
+  this->length_ = new_value;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::high_water_mark ()
+{
+  return this->hwm_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::high_water_mark (size_t hwm)
+{
+  this->hwm_ = hwm;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::low_water_mark ()
+{
+  return this->lwm_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::low_water_mark (size_t lwm)
+{
+  this->lwm_ = lwm;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::state ()
+{
+  return this->queue_state_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::deactivated ()
+{
+  return this->queue_state_.load () == ACE_Message_Queue_Base::DEACTIVATED;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::capacity () const
+{
+  return this->mask_ + 1;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Message_Queue_Lockfree<ACE_SYNCH_USE, TIME_POLICY>::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("state = %d\n")
+                 ACE_TEXT ("low_water_mark = %B\n")
+                 ACE_TEXT ("high_water_mark = %B\n")
+                 ACE_TEXT ("cur_bytes = %B\n")
+                 ACE_TEXT ("cur_length = %B\n")
+                 ACE_TEXT ("capacity = %B\n")
+                 ACE_TEXT ("enqueue_pos = %B\n")
+                 ACE_TEXT ("dequeue_pos = %B\n"),
+                 this->queue_state_.load (),
+                 this->lwm_.load (),
+                 this->hwm_.load (),
+                 this->bytes_.load (),
+                 this->length_.load (),
+                 this->mask_ + 1,
+                 this->enqueue_pos_.load (),
+                 this->dequeue_pos_.load ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_MESSAGE_QUEUE_LOCKFREE_T_CPP */
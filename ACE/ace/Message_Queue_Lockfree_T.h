@@ -0,0 +1,241 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+ *  @file    Message_Queue_Lockfree_T.h
+ */
+//=============================================================================
+
+#ifndef ACE_MESSAGE_QUEUE_LOCKFREE_T_H
+#define ACE_MESSAGE_QUEUE_LOCKFREE_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Message_Queue.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Message_Queue_Lockfree
+ *
+ * @brief A FIFO ACE_Message_Queue whose enqueue and dequeue operations
+ * do not take a lock unless they have to wait.
+ *
+ * The messages are kept in a bounded ring of ACE_Message_Block
+ * pointers that any number of producers and consumers claim slots of
+ * with a compare-and-swap on their own position counter.  The queue
+ * lock and conditions inherited from ACE_Message_Queue are only used
+ * to park threads: a consumer blocks when the ring is empty, a
+ * producer when the high water mark is reached or the ring is full,
+ * and the other side only takes the lock to wake them when it knows
+ * somebody is waiting.  The water marks, the timeouts, deactivate(),
+ * pulse() and the notification strategy behave as in
+ * ACE_Message_Queue, so the queue can be given to an ACE_Task.
+ *
+ * The differences with ACE_Message_Queue are:
+ *   - Messages are always delivered in FIFO order: enqueue_prio(),
+ *     enqueue_deadline(), dequeue_prio() and dequeue_deadline() do
+ *     the same as enqueue_tail() and dequeue_head().
+ *   - enqueue_head() and dequeue_tail() fail with @c ENOTSUP.
+ *   - Messages chained with ACE_Message_Block::next() are queued one
+ *     by one, not atomically.
+ *   - The high water mark is checked before the message is added, so
+ *     concurrent producers may overshoot it by a few messages.
+ *   - ACE_Message_Queue_Iterator and ACE_Message_Queue_Reverse_Iterator
+ *     cannot walk the ring and see the queue as empty.
+ */
+template <ACE_SYNCH_DECL, class TIME_POLICY = ACE_System_Time_Policy>
+class ACE_Message_Queue_Lockfree
+  : public ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>
+{
+public:
+  typedef ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> inherited;
+
+  enum
+  {
+    /// Default number of slots in the ring.
+    DEFAULT_CAPACITY = 1024
+  };
+
+  /**
+   * Create a queue holding up to @a capacity messages, rounded up to
+   * a power of two.  @a hwm, @a lwm and @a ns are the same as for
+   * ACE_Message_Queue.
+   */
+  ACE_Message_Queue_Lockfree (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                              size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                              ACE_Notification_Strategy *ns = 0,
+                              size_t capacity = DEFAULT_CAPACITY);
+
+  /// Release the messages left on the queue.
+  virtual ~ACE_Message_Queue_Lockfree ();
+
+  virtual int open (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                    size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                    ACE_Notification_Strategy *ns = 0);
+  virtual int close ();
+  virtual int flush ();
+  virtual int flush_i ();
+
+  /**
+   * Return the message at the head of the queue without removing it.
+   * As with ACE_Message_Queue, another thread may dequeue it at any
+   * time.
+   */
+  virtual int peek_dequeue_head (ACE_Message_Block *&first_item,
+                                 ACE_Time_Value *timeout = 0);
+
+  // = Enqueue methods, all of them add at the tail of the queue.
+  virtual int enqueue_tail (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int enqueue_prio (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int enqueue_deadline (ACE_Message_Block *new_item,
+                                ACE_Time_Value *timeout = 0);
+  virtual int enqueue (ACE_Message_Block *new_item,
+                       ACE_Time_Value *timeout = 0);
+
+  /// Not supported, returns -1 with @c errno set to @c ENOTSUP.
+  virtual int enqueue_head (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  // = Dequeue methods, all of them remove from the head of the queue.
+  virtual int dequeue_head (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_prio (ACE_Message_Block *&dequeued,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_deadline (ACE_Message_Block *&dequeued,
+                                ACE_Time_Value *timeout = 0);
+  virtual int dequeue (ACE_Message_Block *&first_item,
+                       ACE_Time_Value *timeout = 0);
+
+  /// Not supported, returns -1 with @c errno set to @c ENOTSUP.
+  virtual int dequeue_tail (ACE_Message_Block *&dequeued,
+                            ACE_Time_Value *timeout = 0);
+
+  virtual bool is_full ();
+  virtual bool is_empty ();
+
+  virtual size_t message_bytes ();
+  virtual size_t message_length ();
+  virtual size_t message_count ();
+  virtual void message_bytes (size_t new_size);
+  virtual void message_length (size_t new_length);
+
+  virtual size_t high_water_mark ();
+  virtual void high_water_mark (size_t hwm);
+  virtual size_t low_water_mark ();
+  virtual void low_water_mark (size_t lwm);
+
+  virtual int state ();
+  virtual int deactivated ();
+
+  /// Number of slots in the ring.
+  size_t capacity () const;
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  virtual bool is_full_i ();
+  virtual bool is_empty_i ();
+  virtual int deactivate_i (int pulse = 0);
+  virtual int activate_i ();
+  virtual int wait_not_full_cond (ACE_Time_Value *timeout);
+  virtual int wait_not_empty_cond (ACE_Time_Value *timeout);
+
+  /// Add one message to the ring, waiting until @a timeout if needed.
+  int enqueue_one (ACE_Message_Block *new_item, ACE_Time_Value *timeout);
+
+  /// Claim a slot and store @a item in it, false if the ring is full.
+  bool push (ACE_Message_Block *item);
+
+  /// Take the oldest message of the ring, false if the ring is empty.
+  bool pop (ACE_Message_Block *&item);
+
+  /// True if the slot at the tail of the ring is still in use.
+  bool ring_full () const;
+
+  /// True if the slot at the head of the ring holds no message.
+  bool ring_empty () const;
+
+  /// Wake a consumer if one is parked.
+  void signal_consumers ();
+
+  /// Wake a producer if one is parked and the queue drained enough.
+  void signal_producers ();
+
+  /// Return the number of messages as the public methods do.
+  int queue_count () const;
+
+private:
+  /// A slot of the ring.  @c sequence_ tells who may use it next: a
+  /// producer at position @c sequence_ or a consumer at position
+  /// @c sequence_ - 1.
+  struct Cell
+  {
+    std::atomic<size_t> sequence_;
+    std::atomic<ACE_Message_Block *> item_;
+  };
+
+  enum
+  {
+    /// Padding to keep the positions of the producers and consumers
+    /// apart.
+    CACHE_LINE = 64,
+
+    /// Times an empty ring is retried, yielding the processor in
+    /// between, before a consumer parks.
+    SPIN_LIMIT = 16
+  };
+
+  Cell *cells_;
+  size_t mask_;
+
+  char pad0_[CACHE_LINE];
+  std::atomic<size_t> enqueue_pos_;
+  char pad1_[CACHE_LINE - sizeof (std::atomic<size_t>)];
+  std::atomic<size_t> dequeue_pos_;
+  char pad2_[CACHE_LINE - sizeof (std::atomic<size_t>)];
+
+  /// Queue statistics, kept apart from the ring positions.
+  std::atomic<size_t> bytes_;
+  std::atomic<size_t> length_;
+  std::atomic<size_t> hwm_;
+  std::atomic<size_t> lwm_;
+  std::atomic<int> queue_state_;
+
+  /// Threads parked in wait_not_empty_cond() and wait_not_full_cond().
+  std::atomic<int> waiting_consumers_;
+  std::atomic<int> waiting_producers_;
+
+  /// Producers parked because the ring itself, not the high water
+  /// mark, is full.
+  std::atomic<int> ring_waiters_;
+
+  ACE_Message_Queue_Lockfree (const ACE_Message_Queue_Lockfree &) = delete;
+  ACE_Message_Queue_Lockfree &operator= (const ACE_Message_Queue_Lockfree &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Message_Queue_Lockfree_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Message_Queue_Lockfree_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_MESSAGE_QUEUE_LOCKFREE_T_H */
@@ -591,6 +591,7 @@ class ACE_Export ACE_POSIX_Asynch_Accept_Result : public virtual ACE_Asynch_Acce
 {
   /// Factory classes will have special permissions.
   friend class ACE_POSIX_Asynch_Accept;
+  friend class ACE_Uring_Asynch_Accept;
 
   /// The Proactor constructs the Result class for faking results.
   friend class ACE_POSIX_Proactor;
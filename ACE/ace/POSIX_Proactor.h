@@ -68,7 +68,10 @@ public:
     PROACTOR_SUN    = 3,
 
     /// Callback notifications
-    PROACTOR_CB     = 4
+    PROACTOR_CB     = 4,
+
+    /// Linux io_uring
+    PROACTOR_URING  = 5
   };
 
 
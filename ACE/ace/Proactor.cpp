@@ -20,6 +20,7 @@
 #if defined (ACE_HAS_AIO_CALLS)
 #   include "ace/POSIX_Proactor.h"
 #   include "ace/POSIX_CB_Proactor.h"
+#   include "ace/Uring_Proactor.h"
 #else /* !ACE_HAS_AIO_CALLS */
 #   include "ace/WIN32_Proactor.h"
 #endif /* ACE_HAS_AIO_CALLS */
@@ -321,7 +322,9 @@ ACE_Proactor::ACE_Proactor (ACE_Proactor_Impl *implementation,
     {
 #if defined (ACE_HAS_AIO_CALLS)
       // POSIX Proactor.
-#  if defined (ACE_POSIX_AIOCB_PROACTOR)
+#  if defined (ACE_URING_PROACTOR) && defined (ACE_HAS_IO_URING)
+      ACE_NEW (implementation, ACE_Uring_Proactor);
+#  elif defined (ACE_POSIX_AIOCB_PROACTOR)
       ACE_NEW (implementation, ACE_POSIX_AIOCB_Proactor);
 #  elif defined (ACE_POSIX_SIG_PROACTOR)
       ACE_NEW (implementation, ACE_POSIX_SIG_Proactor);
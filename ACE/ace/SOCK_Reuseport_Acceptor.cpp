@@ -0,0 +1,99 @@
+#include "ace/SOCK_Reuseport_Acceptor.h"
+
+#include "ace/ACE.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_Errno.h"
+#if defined (ACE_HAS_ALLOC_HOOKS)
+# include "ace/Malloc_Base.h"
+#endif /* ACE_HAS_ALLOC_HOOKS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_SOCK_Reuseport_Acceptor)
+
+ACE_SOCK_Reuseport_Acceptor::ACE_SOCK_Reuseport_Acceptor ()
+  : reuse_port_ (true)
+{
+  ACE_TRACE ("ACE_SOCK_Reuseport_Acceptor::ACE_SOCK_Reuseport_Acceptor");
+}
+
+ACE_SOCK_Reuseport_Acceptor::ACE_SOCK_Reuseport_Acceptor (const ACE_Addr &local_sap,
+                                                          int reuse_addr,
+                                                          int protocol_family,
+                                                          int backlog,
+                                                          int protocol,
+                                                          int ipv6_only)
+  : reuse_port_ (true)
+{
+  ACE_TRACE ("ACE_SOCK_Reuseport_Acceptor::ACE_SOCK_Reuseport_Acceptor");
+  if (this->open (local_sap,
+                  reuse_addr,
+                  protocol_family,
+                  backlog,
+                  protocol,
+                  ipv6_only) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_SOCK_Reuseport_Acceptor")));
+}
+
+int
+ACE_SOCK_Reuseport_Acceptor::open (const ACE_Addr &local_sap,
+                                   int reuse_addr,
+                                   int protocol_family,
+                                   int backlog,
+                                   int protocol,
+                                   int ipv6_only)
+{
+  ACE_TRACE ("ACE_SOCK_Reuseport_Acceptor::open");
+
+  if (local_sap != ACE_Addr::sap_any)
+    protocol_family = local_sap.get_type ();
+  else if (protocol_family == PF_UNSPEC)
+    {
+#if defined (ACE_HAS_IPV6)
+      protocol_family = ACE::ipv6_enabled () ? PF_INET6 : PF_INET;
+#else
+      protocol_family = PF_INET;
+#endif /* ACE_HAS_IPV6 */
+    }
+
+  if (ACE_SOCK::open (SOCK_STREAM,
+                      protocol_family,
+                      protocol,
+                      reuse_addr) == -1)
+    return -1;
+
+#if defined (SO_REUSEPORT)
+  int one = 1;
+  if (this->reuse_port_
+      && this->set_option (SOL_SOCKET,
+                           SO_REUSEPORT,
+                           &one,
+                           sizeof one) == -1)
+    {
+      ACE_Errno_Guard g (errno);
+      this->close ();
+      return -1;
+    }
+#endif /* SO_REUSEPORT */
+
+  return this->shared_open (local_sap,
+                            protocol_family,
+                            backlog,
+                            ipv6_only);
+}
+
+void
+ACE_SOCK_Reuseport_Acceptor::reuse_port (bool reuse_port)
+{
+  this->reuse_port_ = reuse_port;
+}
+
+bool
+ACE_SOCK_Reuseport_Acceptor::reuse_port () const
+{
+  return this->reuse_port_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,82 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    SOCK_Reuseport_Acceptor.h
+ */
+//=============================================================================
+
+#ifndef ACE_SOCK_REUSEPORT_ACCEPTOR_H
+#define ACE_SOCK_REUSEPORT_ACCEPTOR_H
+#include /**/ "ace/pre.h"
+
+#include "ace/SOCK_Acceptor.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_SOCK_Reuseport_Acceptor
+ *
+ * @brief An ACE_SOCK_Acceptor whose socket is bound with the
+ * @c SO_REUSEPORT option.
+ *
+ * Several such acceptors, typically one per thread or per reactor,
+ * may listen on the same address; the kernel then spreads the
+ * incoming connections over them.  On platforms without
+ * @c SO_REUSEPORT, or once reuse_port() has been turned off, it
+ * behaves exactly as ACE_SOCK_Acceptor.
+ */
+class ACE_Export ACE_SOCK_Reuseport_Acceptor : public ACE_SOCK_Acceptor
+{
+public:
+  /// Default constructor.
+  ACE_SOCK_Reuseport_Acceptor ();
+
+  /// Initialize a passive-mode acceptor socket, see open().
+  ACE_SOCK_Reuseport_Acceptor (const ACE_Addr &local_sap,
+                               int reuse_addr = 0,
+                               int protocol_family = PF_UNSPEC,
+                               int backlog = ACE_DEFAULT_BACKLOG,
+                               int protocol = 0,
+                               int ipv6_only = 0);
+
+  /**
+   * Initialize a passive-mode BSD-style acceptor socket (no QoS)
+   * with @c SO_REUSEPORT enabled if reuse_port() is set.  The
+   * arguments are those of ACE_SOCK_Acceptor::open().  Returns 0 on
+   * success and -1 on failure.
+   */
+  int open (const ACE_Addr &local_sap,
+            int reuse_addr = 0,
+            int protocol_family = PF_UNSPEC,
+            int backlog = ACE_DEFAULT_BACKLOG,
+            int protocol = 0,
+            int ipv6_only = 0);
+
+  /// Set whether open() enables @c SO_REUSEPORT, which it does by
+  /// default.
+  void reuse_port (bool reuse_port);
+
+  /// Whether open() enables @c SO_REUSEPORT.
+  bool reuse_port () const;
+
+  // = Meta-type info
+  typedef ACE_INET_Addr PEER_ADDR;
+  typedef ACE_SOCK_Stream PEER_STREAM;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// Enable @c SO_REUSEPORT in open().
+  bool reuse_port_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_SOCK_REUSEPORT_ACCEPTOR_H */
@@ -0,0 +1,172 @@
+#ifndef ACE_SHARDED_ACCEPTOR_T_CPP
+#define ACE_SHARDED_ACCEPTOR_T_CPP
+
+#include "ace/Sharded_Acceptor_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::ACE_Shard_Acceptor
+  (ACE_Dev_Poll_Reactor_Group &group, size_t shard)
+  : group_ (group),
+    shard_ (shard),
+    accepted_ (0)
+{
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> size_t
+ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::shard () const
+{
+  return this->shard_;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> unsigned long
+ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::accepted () const
+{
+  return this->accepted_;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::activate_svc_handler
+  (SVC_HANDLER *svc_handler)
+{
+  ACE_TRACE ("ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::activate_svc_handler");
+
+  ++this->accepted_;
+
+  size_t const target =
+    this->group_.select_shard (svc_handler->get_handle (), this->shard_);
+  ACE_Reactor *reactor = this->group_.reactor (target);
+  if (reactor != 0)
+    svc_handler->reactor (reactor);
+
+  return base_type::activate_svc_handler (svc_handler);
+}
+
+// *********************************************************************
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::ACE_Sharded_Acceptor ()
+  : acceptors_ (0),
+    size_ (0)
+{
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::~ACE_Sharded_Acceptor ()
+{
+  this->close ();
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::open
+  (const addr_type &local_addr,
+   ACE_Dev_Poll_Reactor_Group &group,
+   int flags,
+   int use_select,
+   int reuse_addr)
+{
+  ACE_TRACE ("ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::open");
+
+  if (this->acceptors_ != 0 || group.size () == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  size_t const shards = group.size ();
+  ACE_NEW_RETURN (this->acceptors_, shard_acceptor_type *[shards], -1);
+  ACE_OS::memset (this->acceptors_, 0, shards * sizeof (shard_acceptor_type *));
+  this->size_ = shards;
+
+  addr_type addr (local_addr);
+  for (size_t i = 0; i < shards; ++i)
+    {
+      ACE_NEW_NORETURN (this->acceptors_[i],
+                        shard_acceptor_type (group, i));
+      if (this->acceptors_[i] == 0
+          || this->acceptors_[i]->open (addr,
+                                        group.reactor (i),
+                                        flags,
+                                        use_select,
+                                        reuse_addr) == -1)
+        {
+          ACE_Errno_Guard g (errno);
+          this->close ();
+          return -1;
+        }
+
+      // The other shards must listen on the port picked for the first.
+      if (i == 0
+          && this->acceptors_[0]->acceptor ().get_local_addr (addr) == -1)
+        {
+          ACE_Errno_Guard g (errno);
+          this->close ();
+          return -1;
+        }
+    }
+
+  return 0;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::close ()
+{
+  ACE_TRACE ("ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::close");
+
+  if (this->acceptors_ == 0)
+    return 0;
+
+  for (size_t i = 0; i < this->size_; ++i)
+    if (this->acceptors_[i] != 0)
+      {
+        this->acceptors_[i]->close ();
+        delete this->acceptors_[i];
+      }
+
+  delete [] this->acceptors_;
+  this->acceptors_ = 0;
+  this->size_ = 0;
+  return 0;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> size_t
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::size () const
+{
+  return this->size_;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+typename ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::shard_acceptor_type *
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::acceptor (size_t shard) const
+{
+  return shard < this->size_ ? this->acceptors_[shard] : 0;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::get_local_addr
+  (addr_type &addr) const
+{
+  if (this->size_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  return this->acceptors_[0]->acceptor ().get_local_addr (addr);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#endif /* ACE_SHARDED_ACCEPTOR_T_CPP */
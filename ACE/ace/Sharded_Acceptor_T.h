@@ -0,0 +1,133 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Sharded_Acceptor_T.h
+ */
+//=============================================================================
+
+#ifndef ACE_SHARDED_ACCEPTOR_T_H
+#define ACE_SHARDED_ACCEPTOR_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Acceptor.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Dev_Poll_Reactor_Group.h"
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Shard_Acceptor
+ *
+ * @brief The acceptor of one shard of an ACE_Dev_Poll_Reactor_Group.
+ *
+ * Registered with the reactor of its shard, it asks the policy of the
+ * group which shard services each new connection and activates the
+ * SVC_HANDLER with that shard's reactor.
+ */
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+class ACE_Shard_Acceptor : public ACE_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>
+{
+public:
+  typedef ACE_Acceptor<SVC_HANDLER, PEER_ACCEPTOR> base_type;
+
+  ACE_Shard_Acceptor (ACE_Dev_Poll_Reactor_Group &group, size_t shard);
+
+  /// Shard whose reactor dispatches this acceptor.
+  size_t shard () const;
+
+  /// Number of connections accepted by this acceptor.
+  unsigned long accepted () const;
+
+protected:
+  /// Move @a svc_handler to the reactor of the shard chosen by the
+  /// group policy, then activate it.
+  virtual int activate_svc_handler (SVC_HANDLER *svc_handler);
+
+private:
+  ACE_Dev_Poll_Reactor_Group &group_;
+  size_t const shard_;
+
+  /// Only touched by the thread of the shard.
+  unsigned long accepted_;
+};
+
+/**
+ * @class ACE_Sharded_Acceptor
+ *
+ * @brief Listen on one address with one acceptor per shard of an
+ * ACE_Dev_Poll_Reactor_Group.
+ *
+ * PEER_ACCEPTOR must allow several acceptors to bind the same address
+ * for groups of more than one shard, e.g. ACE_SOCK_Reuseport_Acceptor.
+ * Each acceptor is registered with the reactor of its shard, so
+ * connections are accepted by the shard threads in parallel and the
+ * kernel balances them over the listening sockets.
+ */
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+class ACE_Sharded_Acceptor
+{
+public:
+  typedef ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR> shard_acceptor_type;
+  typedef typename PEER_ACCEPTOR::PEER_ADDR addr_type;
+
+  ACE_Sharded_Acceptor ();
+
+  /// Closes the acceptors.
+  ~ACE_Sharded_Acceptor ();
+
+  /**
+   * Open one acceptor per shard of @a group on @a local_addr.  If the
+   * port of @a local_addr is 0 the port picked for the first shard is
+   * used for the others.  @a flags, @a use_select and @a reuse_addr
+   * are passed to ACE_Acceptor::open().
+   */
+  int open (const addr_type &local_addr,
+            ACE_Dev_Poll_Reactor_Group &group,
+            int flags = 0,
+            int use_select = ACE_DEFAULT_ACCEPTOR_USE_SELECT,
+            int reuse_addr = 1);
+
+  /// Close and release the acceptors.  Must not be called while the
+  /// event loops of the group are running.
+  int close ();
+
+  /// Number of acceptors.
+  size_t size () const;
+
+  /// Acceptor of shard @a shard, 0 if out of range.
+  shard_acceptor_type *acceptor (size_t shard) const;
+
+  /// Address the acceptors listen on.
+  int get_local_addr (addr_type &addr) const;
+
+private:
+  shard_acceptor_type **acceptors_;
+  size_t size_;
+
+  ACE_Sharded_Acceptor (const ACE_Sharded_Acceptor &) = delete;
+  ACE_Sharded_Acceptor &operator= (const ACE_Sharded_Acceptor &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Sharded_Acceptor_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Sharded_Acceptor_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_SHARDED_ACCEPTOR_T_H */
@@ -0,0 +1,481 @@
+#include "ace/TLS_Slab_Allocator.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_TLS_Slab_Allocator)
+
+/**
+ * Free lists of a thread.  Only the owner thread touches them, the
+ * other threads push the blocks they free on <remote_>.
+ */
+class ACE_TLS_Slab_Allocator::Thread_Cache
+{
+public:
+  explicit Thread_Cache (ACE_TLS_Slab_Allocator *allocator);
+
+  /// Release the slabs.
+  ~Thread_Cache ();
+
+  /// Block of class @a size_class, or 0 when out of memory.
+  void *malloc (size_t size_class);
+
+  /// Free @a block, called by the owner thread.
+  void free (Block *block);
+
+  /// Free @a block, called by any other thread.
+  void remote_free (Block *block);
+
+  ACE_TLS_Slab_Allocator *allocator_;
+
+  /// Next cache of the allocator.
+  Thread_Cache *next_;
+
+  /// False while no thread owns the cache, protected by the lock of
+  /// the allocator.
+  bool in_use_;
+
+private:
+  enum
+  {
+    /// Assumed size of a cache line.
+    CACHE_LINE = 64
+  };
+
+  /// Refill the free list of @a size_class, from <remote_> or from a
+  /// new slab.
+  bool refill (size_t size_class);
+
+  /// The free blocks are linked through their first bytes.
+  static Block *&next (Block *block);
+
+  Block *free_[MAX_CLASSES];
+
+  /// Slabs obtained by the cache, linked through their first bytes.
+  char *slabs_;
+
+  /// Blocks freed by the other threads, which only push.  The owner
+  /// takes the whole list at once, so there is no ABA problem.
+  char pad_[CACHE_LINE];
+  std::atomic<Block *> remote_;
+};
+
+ACE_TLS_Slab_Allocator::Thread_Cache::Thread_Cache (
+  ACE_TLS_Slab_Allocator *allocator)
+  : allocator_ (allocator),
+    next_ (0),
+    in_use_ (true),
+    slabs_ (0),
+    remote_ (0)
+{
+  for (size_t i = 0; i < MAX_CLASSES; ++i)
+    this->free_[i] = 0;
+}
+
+ACE_TLS_Slab_Allocator::Thread_Cache::~Thread_Cache ()
+{
+  while (this->slabs_ != 0)
+    {
+      char *const slab = this->slabs_;
+      this->slabs_ = *reinterpret_cast<char **> (slab);
+      ACE_OS::free (slab);
+    }
+}
+
+ACE_TLS_Slab_Allocator::Block *&
+ACE_TLS_Slab_Allocator::Thread_Cache::next (Block *block)
+{
+  return *reinterpret_cast<Block **> (reinterpret_cast<char *> (block)
+                                      + HEADER_SIZE);
+}
+
+void *
+ACE_TLS_Slab_Allocator::Thread_Cache::malloc (size_t size_class)
+{
+  Block *block = this->free_[size_class];
+
+  if (block == 0)
+    {
+      if (!this->refill (size_class))
+        return 0;
+      block = this->free_[size_class];
+    }
+
+  this->free_[size_class] = next (block);
+  return reinterpret_cast<char *> (block) + HEADER_SIZE;
+}
+
+void
+ACE_TLS_Slab_Allocator::Thread_Cache::free (Block *block)
+{
+  next (block) = this->free_[block->size_class_];
+  this->free_[block->size_class_] = block;
+}
+
+void
+ACE_TLS_Slab_Allocator::Thread_Cache::remote_free (Block *block)
+{
+  Block *head = this->remote_.load (std::memory_order_relaxed);
+  do
+    next (block) = head;
+  while (!this->remote_.compare_exchange_weak (head,
+                                               block,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+}
+
+bool
+ACE_TLS_Slab_Allocator::Thread_Cache::refill (size_t size_class)
+{
+  // Take back the blocks freed by the other threads first.
+  Block *block = this->remote_.exchange (0, std::memory_order_acquire);
+  while (block != 0)
+    {
+      Block *const following = next (block);
+      this->free (block);
+      block = following;
+    }
+
+  if (this->free_[size_class] != 0)
+    return true;
+
+  // Carve a new slab, which starts with the link to the previous one.
+  size_t const stride =
+    HEADER_SIZE + (static_cast<size_t> (1) << (MIN_SHIFT + size_class));
+  size_t count = (this->allocator_->slab_size_ - HEADER_SIZE) / stride;
+  if (count == 0)
+    count = 1;
+
+  char *const slab =
+    static_cast<char *> (ACE_OS::malloc (HEADER_SIZE + count * stride));
+  if (slab == 0)
+    {
+      errno = ENOMEM;
+      return false;
+    }
+
+  *reinterpret_cast<char **> (slab) = this->slabs_;
+  this->slabs_ = slab;
+  ++this->allocator_->slab_count_;
+
+  // Link the blocks so that they are handed out in address order.
+  for (size_t i = count; i-- > 0; )
+    {
+      block = reinterpret_cast<Block *> (slab + HEADER_SIZE + i * stride);
+      block->owner_ = this;
+      block->size_class_ = size_class;
+      this->free (block);
+    }
+
+  return true;
+}
+
+/******************************************************************************/
+
+#if defined (ACE_HAS_THREADS)
+extern "C" void
+ACE_TLS_Slab_Allocator_cleanup (void *cache)
+{
+  ACE_TLS_Slab_Allocator::Thread_Cache *const thread_cache =
+    static_cast<ACE_TLS_Slab_Allocator::Thread_Cache *> (cache);
+  thread_cache->allocator_->orphan (thread_cache);
+}
+#endif /* ACE_HAS_THREADS */
+
+ACE_TLS_Slab_Allocator::ACE_TLS_Slab_Allocator (size_t max_block_size,
+                                                size_t slab_size)
+  :
+#if defined (ACE_HAS_THREADS)
+    key_ (ACE_OS::NULL_key),
+    key_created_ (false),
+#endif /* ACE_HAS_THREADS */
+    caches_ (0),
+    classes_ (1),
+    slab_size_ (slab_size),
+    slab_count_ (0),
+    cache_count_ (0)
+{
+  ACE_TRACE ("ACE_TLS_Slab_Allocator::ACE_TLS_Slab_Allocator");
+
+  while (this->classes_ < MAX_CLASSES
+         && (static_cast<size_t> (1) << (MIN_SHIFT + this->classes_ - 1))
+              < max_block_size)
+    ++this->classes_;
+
+#if defined (ACE_HAS_THREADS)
+  if (ACE_OS::thr_keycreate (&this->key_,
+                             &ACE_TLS_Slab_Allocator_cleanup) == 0)
+    this->key_created_ = true;
+  else
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("(%P|%t) ACE_TLS_Slab_Allocator: %p, ")
+                   ACE_TEXT ("blocks won't be cached\n"),
+                   ACE_TEXT ("thr_keycreate")));
+#endif /* ACE_HAS_THREADS */
+}
+
+ACE_TLS_Slab_Allocator::~ACE_TLS_Slab_Allocator ()
+{
+  ACE_TRACE ("ACE_TLS_Slab_Allocator::~ACE_TLS_Slab_Allocator");
+
+#if defined (ACE_HAS_THREADS)
+  if (this->key_created_)
+    {
+      ACE_OS::thr_setspecific (this->key_, 0);
+      ACE_OS::thr_keyfree (this->key_);
+    }
+#endif /* ACE_HAS_THREADS */
+
+  while (this->caches_ != 0)
+    {
+      Thread_Cache *const cache = this->caches_;
+      this->caches_ = cache->next_;
+      delete cache;
+    }
+}
+
+ACE_TLS_Slab_Allocator::Thread_Cache *
+ACE_TLS_Slab_Allocator::current_cache () const
+{
+#if defined (ACE_HAS_THREADS)
+  void *cache = 0;
+  if (!this->key_created_
+      || ACE_OS::thr_getspecific (this->key_, &cache) == -1)
+    return 0;
+  return static_cast<Thread_Cache *> (cache);
+#else
+  return this->caches_;
+#endif /* ACE_HAS_THREADS */
+}
+
+ACE_TLS_Slab_Allocator::Thread_Cache *
+ACE_TLS_Slab_Allocator::cache ()
+{
+  Thread_Cache *cache = this->current_cache ();
+  if (cache != 0)
+    return cache;
+
+#if defined (ACE_HAS_THREADS)
+  if (!this->key_created_)
+    return 0;
+#endif /* ACE_HAS_THREADS */
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+
+  // Adopt the cache of a thread that exited, if any.
+  for (cache = this->caches_; cache != 0; cache = cache->next_)
+    if (!cache->in_use_)
+      break;
+
+  if (cache == 0)
+    {
+      ACE_NEW_NORETURN (cache, Thread_Cache (this));
+      if (cache == 0)
+        return 0;
+      cache->next_ = this->caches_;
+      this->caches_ = cache;
+      ++this->cache_count_;
+    }
+
+#if defined (ACE_HAS_THREADS)
+  if (ACE_OS::thr_setspecific (this->key_, cache) != 0)
+    {
+      cache->in_use_ = false;
+      return 0;
+    }
+#endif /* ACE_HAS_THREADS */
+
+  cache->in_use_ = true;
+  return cache;
+}
+
+void
+ACE_TLS_Slab_Allocator::orphan (Thread_Cache *cache)
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->lock_);
+  cache->in_use_ = false;
+}
+
+void *
+ACE_TLS_Slab_Allocator::malloc (size_t nbytes)
+{
+  if (nbytes <= this->max_block_size ())
+    {
+      size_t size_class = 0;
+      for (size_t s = nbytes > 0 ? (nbytes - 1) >> MIN_SHIFT : 0;
+           s != 0;
+           s >>= 1)
+        ++size_class;
+
+      Thread_Cache *const cache = this->cache ();
+      if (cache != 0)
+        return cache->malloc (size_class);
+    }
+
+  // Too large, or no cache for this thread.
+  Block *const block =
+    static_cast<Block *> (ACE_OS::malloc (HEADER_SIZE + nbytes));
+  if (block == 0)
+    {
+      errno = ENOMEM;
+      return 0;
+    }
+
+  block->owner_ = 0;
+  block->size_class_ = 0;
+  return reinterpret_cast<char *> (block) + HEADER_SIZE;
+}
+
+void *
+ACE_TLS_Slab_Allocator::calloc (size_t nbytes, char initial_value)
+{
+  void *const ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, nbytes);
+  return ptr;
+}
+
+void *
+ACE_TLS_Slab_Allocator::calloc (size_t n_elem,
+                                size_t elem_size,
+                                char initial_value)
+{
+  return this->calloc (n_elem * elem_size, initial_value);
+}
+
+void
+ACE_TLS_Slab_Allocator::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  Block *const block =
+    reinterpret_cast<Block *> (static_cast<char *> (ptr) - HEADER_SIZE);
+  Thread_Cache *const owner = block->owner_;
+
+  if (owner == 0)
+    ACE_OS::free (block);
+  else if (owner == this->current_cache ())
+    owner->free (block);
+  else
+    owner->remote_free (block);
+}
+
+size_t
+ACE_TLS_Slab_Allocator::max_block_size () const
+{
+  return static_cast<size_t> (1) << (MIN_SHIFT + this->classes_ - 1);
+}
+
+size_t
+ACE_TLS_Slab_Allocator::slab_count () const
+{
+  return this->slab_count_.load ();
+}
+
+size_t
+ACE_TLS_Slab_Allocator::cache_count () const
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+  return this->cache_count_;
+}
+
+int
+ACE_TLS_Slab_Allocator::remove ()
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::bind (const char *, void *, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::trybind (const char *, void *&)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::find (const char *, void *&)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::find (const char *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::unbind (const char *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::unbind (const char *, void *&)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::sync (ssize_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::sync (void *, size_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::protect (ssize_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_TLS_Slab_Allocator::protect (void *, size_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+#if defined (ACE_HAS_MALLOC_STATS)
+void
+ACE_TLS_Slab_Allocator::print_stats () const
+{
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("(%P|%t) %B slabs, %B thread caches\n"),
+                 this->slab_count (),
+                 this->cache_count ()));
+}
+#endif /* ACE_HAS_MALLOC_STATS */
+
+void
+ACE_TLS_Slab_Allocator::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_TLS_Slab_Allocator::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("max_block_size_ = %B\nslab_size_ = %B\n")
+                 ACE_TEXT ("slab_count_ = %B\n"),
+                 this->max_block_size (),
+                 this->slab_size_,
+                 this->slab_count ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,165 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    TLS_Slab_Allocator.h
+ */
+//=============================================================================
+
+#ifndef ACE_TLS_SLAB_ALLOCATOR_H
+#define ACE_TLS_SLAB_ALLOCATOR_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Malloc_Base.h"
+#include "ace/Default_Constants.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/OS_NS_Thread.h"
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_HAS_THREADS)
+/// Gives the cache of an exiting thread back to its allocator.
+extern "C" void ACE_TLS_Slab_Allocator_cleanup (void *cache);
+#endif /* ACE_HAS_THREADS */
+
+/**
+ * @class ACE_TLS_Slab_Allocator
+ *
+ * @brief Allocator that keeps a cache of free blocks for each thread.
+ *
+ * The requests are rounded up to a power of 2 between 32 bytes and
+ * the maximum block size given to the constructor, and each thread
+ * takes the blocks of a size class from its own free list, without
+ * any lock.  The free lists are refilled by carving slabs obtained
+ * from ACE_OS::malloc().  Larger requests go to ACE_OS::malloc()
+ * directly.
+ *
+ * A block freed by a thread other than the one that allocated it is
+ * pushed on a lock-free list of the owner's cache, which the owner
+ * takes back when its own free list of that size runs out.  The
+ * cache of a thread that exits is handed to the next thread that
+ * starts allocating, so the blocks it still owns keep being reused.
+ *
+ * The slabs are only given back to the system by the destructor,
+ * which must not run before all the blocks have been freed and the
+ * threads that used the allocator stopped using it.
+ *
+ * Only malloc(), calloc() and free() are supported, all the other
+ * methods are no-ops that return -1 and set @c errno to @c ENOTSUP,
+ * as in ACE_New_Allocator.
+ */
+class ACE_Export ACE_TLS_Slab_Allocator : public ACE_Allocator
+{
+public:
+  /// Blocks larger than @a max_block_size, rounded up to a power of
+  /// 2, are not cached.  The free lists of a thread are refilled
+  /// @a slab_size bytes at a time.
+  ACE_TLS_Slab_Allocator (
+    size_t max_block_size = ACE_DEFAULT_TLS_SLAB_MAX_BLOCK_SIZE,
+    size_t slab_size = ACE_DEFAULT_TLS_SLAB_SIZE);
+
+  /// Destructor, releases the slabs.
+  virtual ~ACE_TLS_Slab_Allocator ();
+
+  /// These methods are defined.
+  virtual void *malloc (size_t nbytes);
+  virtual void *calloc (size_t nbytes, char initial_value = '\0');
+  virtual void *calloc (size_t n_elem, size_t elem_size, char initial_value = '\0');
+  virtual void free (void *ptr);
+
+  /// These methods are no-ops.
+  virtual int remove ();
+  virtual int bind (const char *name, void *pointer, int duplicates = 0);
+  virtual int trybind (const char *name, void *&pointer);
+  virtual int find (const char *name, void *&pointer);
+  virtual int find (const char *name);
+  virtual int unbind (const char *name);
+  virtual int unbind (const char *name, void *&pointer);
+  virtual int sync (ssize_t len = -1, int flags = MS_SYNC);
+  virtual int sync (void *addr, size_t len, int flags = MS_SYNC);
+  virtual int protect (ssize_t len = -1, int prot = PROT_RDWR);
+  virtual int protect (void *addr, size_t len, int prot = PROT_RDWR);
+#if defined (ACE_HAS_MALLOC_STATS)
+  virtual void print_stats () const;
+#endif /* ACE_HAS_MALLOC_STATS */
+  virtual void dump () const;
+
+  /// Largest block size served from the caches.
+  size_t max_block_size () const;
+
+  /// Number of slabs obtained from ACE_OS::malloc() so far.
+  size_t slab_count () const;
+
+  /// Number of thread caches created so far.
+  size_t cache_count () const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  class Thread_Cache;
+
+  enum
+  {
+    /// Smallest size class, as a power of 2.
+    MIN_SHIFT = 5,
+
+    /// Number of size classes at most, the largest one is 1 MB.
+    MAX_CLASSES = 16,
+
+    /// Bytes before each block, holding its owner and size class.
+    /// Keeps the blocks aligned for any type.
+    HEADER_SIZE = 16
+  };
+
+  /// Header of a block.  The owner is 0 for the blocks that aren't
+  /// cached.
+  struct Block
+  {
+    Thread_Cache *owner_;
+    size_t size_class_;
+  };
+
+  /// Cache of the calling thread, created or adopted on first use.
+  Thread_Cache *cache ();
+
+  /// Cache of the calling thread, or 0 if it has none.
+  Thread_Cache *current_cache () const;
+
+  /// Hand the cache of an exiting thread over to the next one.
+  void orphan (Thread_Cache *cache);
+
+#if defined (ACE_HAS_THREADS)
+  friend void ACE_TLS_Slab_Allocator_cleanup (void *cache);
+
+  ACE_thread_key_t key_;
+  bool key_created_;
+#endif /* ACE_HAS_THREADS */
+
+  /// All the caches, used or orphaned, protected by <lock_>.
+  Thread_Cache *caches_;
+  mutable ACE_SYNCH_MUTEX lock_;
+
+  /// Number of size classes.
+  size_t classes_;
+  size_t slab_size_;
+
+  std::atomic<size_t> slab_count_;
+  size_t cache_count_;
+
+  ACE_TLS_Slab_Allocator (const ACE_TLS_Slab_Allocator &) = delete;
+  ACE_TLS_Slab_Allocator &operator= (const ACE_TLS_Slab_Allocator &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TLS_SLAB_ALLOCATOR_H */
@@ -0,0 +1,999 @@
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Timer_Hierarchical_Wheel_T.h"
+#include "ace/Guard_T.h"
+#include "ace/Reverse_Lock_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tccct(ACE_Timer_Hierarchical_Wheel_Iterator_T)
+ACE_ALLOC_HOOK_DEFINE_Tccct(ACE_Timer_Hierarchical_Wheel_T)
+
+// Design/implementation notes for ACE_Timer_Hierarchical_Wheel_T.
+//
+// A time value is turned into a tick, its number of microseconds
+// divided by the resolution.  The tick is read as a number of
+// slot_bits_ wide digits, one per level.  A timer is kept at the
+// level of the highest digit in which its tick differs from
+// current_tick_, in the slot given by its own digit at that level.
+// So a timer at level k shares all the digits above k with
+// current_tick_ and has a larger digit k: every timer of level k
+// expires before every timer of level k + 1, and the slot of
+// current_tick_ at each level is always empty.  Timers whose tick
+// differs above the top level go to the overflow list, and timers
+// whose tick is not after current_tick_ to the due list.
+//
+// Moving current_tick_ forward only requires work when it enters an
+// occupied slot.  Entering a slot of level k > 0 "cascades" it: its
+// timers are placed again, which moves them to a lower level.
+// Entering a slot of level 0 moves its timers to the due list.
+// current_tick_ jumps straight to the next occupied slot, found with
+// one bit per slot, so empty stretches of time are skipped.
+//
+// Timer ids index a table of nodes, so cancel() does not search the
+// wheel and is O(1) like scheduling.
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+  (FUNCTOR *upcall_functor,
+   FreeList *freelist,
+   TIME_POLICY const & time_policy)
+  : Base_Timer_Queue (upcall_functor, freelist, time_policy),
+    levels_ (0),
+    slot_bits_ (0),
+    slot_count_ (0),
+    resolution_ (0),
+    lists_ (0),
+    overflow_ (0),
+    due_ (0),
+    batch_ (0),
+    occupied_ (0),
+    words_per_level_ (0),
+    current_tick_ (0),
+    earliest_ (0),
+    timer_count_ (0),
+    ids_ (0),
+    free_ids_ (0),
+    ids_size_ (0),
+    ids_used_ (0),
+    free_head_ (0),
+    free_count_ (0),
+    iterator_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (0,
+                ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_LEVELS,
+                ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLOT_BITS,
+                ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+  (u_int levels,
+   u_int slot_bits,
+   u_int resolution,
+   size_t prealloc,
+   FUNCTOR *upcall_functor,
+   FreeList *freelist,
+   TIME_POLICY const & time_policy)
+  : Base_Timer_Queue (upcall_functor, freelist, time_policy),
+    levels_ (0),
+    slot_bits_ (0),
+    slot_count_ (0),
+    resolution_ (0),
+    lists_ (0),
+    overflow_ (0),
+    due_ (0),
+    batch_ (0),
+    occupied_ (0),
+    words_per_level_ (0),
+    current_tick_ (0),
+    earliest_ (0),
+    timer_count_ (0),
+    ids_ (0),
+    free_ids_ (0),
+    ids_size_ (0),
+    ids_used_ (0),
+    free_head_ (0),
+    free_count_ (0),
+    iterator_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (prealloc, levels, slot_bits, resolution);
+}
+
+/**
+ * Initialize the queue: bring the shape of the wheel within limits,
+ * create the dummy root node of every list and start the wheel at the
+ * current time.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::open_i
+  (size_t prealloc, u_int levels, u_int slot_bits, u_int resolution)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::open_i");
+
+  // At least one 64 bit word of occupied_ per level, and the ticks of
+  // all the levels fit in an ACE_UINT64 with room to spare.
+  const u_int MIN_SLOT_BITS = 6;
+  const u_int MAX_SLOT_BITS = 12;
+  const u_int MAX_LEVELS = 8;
+  const u_int MAX_TICK_BITS = 60;
+
+  this->slot_bits_ = slot_bits < MIN_SLOT_BITS ? MIN_SLOT_BITS
+    : (slot_bits > MAX_SLOT_BITS ? MAX_SLOT_BITS : slot_bits);
+  this->levels_ = levels < 1 ? 1 : (levels > MAX_LEVELS ? MAX_LEVELS : levels);
+  while (this->levels_ * this->slot_bits_ > MAX_TICK_BITS)
+    --this->levels_;
+  this->resolution_ = resolution == 0 ? 1 : resolution;
+
+  this->slot_count_ = 1u << this->slot_bits_;
+  this->words_per_level_ = this->slot_count_ / 64;
+
+  if (prealloc > 0)
+    this->free_list_->resize (prealloc);
+
+  size_t const slots = static_cast<size_t> (this->levels_) * this->slot_count_;
+
+  ACE_NEW (this->lists_, Node[slots + 3]);
+  for (size_t i = 0; i < slots + 3; ++i)
+    {
+      this->lists_[i].set_prev (&this->lists_[i]);
+      this->lists_[i].set_next (&this->lists_[i]);
+    }
+  this->overflow_ = this->lists_ + slots;
+  this->due_ = this->overflow_ + 1;
+  this->batch_ = this->overflow_ + 2;
+
+  size_t const words =
+    static_cast<size_t> (this->levels_) * this->words_per_level_;
+  ACE_NEW (this->occupied_, ACE_UINT64[words]);
+  ACE_OS::memset (this->occupied_, 0, words * sizeof (ACE_UINT64));
+
+  this->current_tick_ = this->tick (this->gettimeofday_static ());
+
+  ACE_NEW (this->iterator_, Iterator (*this));
+}
+
+/// Destructor just cleans up its memory
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_T ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::~ACE_Timer_Hierarchical_Wheel_T");
+
+  delete this->iterator_;
+
+  this->close ();
+
+  delete [] this->lists_;
+  delete [] this->occupied_;
+  delete [] this->ids_;
+  delete [] this->free_ids_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::close ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::close");
+
+  for (size_t i = 0; i < this->ids_used_; ++i)
+    {
+      Node *n = this->find_node (static_cast<long> (i));
+      if (n == 0)
+        continue;
+
+      // Grab the event_handler and act, then delete the node before
+      // calling back to the handler, so that the handler can't cancel
+      // the node from under us.
+      TYPE eh = n->get_type ();
+      const void *act = n->get_act ();
+      this->remove (n);
+      this->free_node (n);
+      this->upcall_functor ().deletion (*this, eh, act);
+    }
+
+  // Leave rest for destructor
+  return 0;
+}
+
+/// Return the tick that @a time falls in.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_UINT64
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::tick (const ACE_Time_Value &time) const
+{
+  if (time <= ACE_Time_Value::zero)
+    return 0;
+
+  ACE_UINT64 usec = 0;
+  time.to_usec (usec);
+  return usec / this->resolution_;
+}
+
+/// Return the dummy root node of slot @a index of level @a level.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::slot (u_int level, u_int index) const
+{
+  return this->lists_ + static_cast<size_t> (level) * this->slot_count_ + index;
+}
+
+/// Return the digit of @a tick for level @a level, i.e. its slot there.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> u_int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::digit (ACE_UINT64 tick, u_int level) const
+{
+  return static_cast<u_int> (tick >> (level * this->slot_bits_))
+    & (this->slot_count_ - 1);
+}
+
+/**
+ * Return the first occupied slot of @a level at or after @a from, or
+ * <slot_count_> if there is none.  Clears the bits of the slots that
+ * turn out to be empty on the way.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> u_int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next_slot (u_int level, u_int from) const
+{
+  ACE_UINT64 *words = this->occupied_ + level * this->words_per_level_;
+
+  for (u_int w = from / 64; w < this->words_per_level_; ++w)
+    {
+      ACE_UINT64 bits = words[w];
+      if (w == from / 64)
+        bits &= ~ACE_UINT64 (0) << (from % 64);
+
+      while (bits != 0)
+        {
+          u_int b = 0;
+          while ((bits & (ACE_UINT64 (1) << b)) == 0)
+            ++b;
+
+          u_int const index = w * 64 + b;
+          Node *root = this->slot (level, index);
+          if (root->get_next () != root)
+            return index;
+
+          words[w] &= ~(ACE_UINT64 (1) << b);
+          bits &= ~(ACE_UINT64 (1) << b);
+        }
+    }
+
+  return this->slot_count_;
+}
+
+/**
+ * Find the first tick after <current_tick_> where the wheel has work
+ * to do: the start of the first occupied slot of the lowest occupied
+ * level, or the end of the range of the top level when only the
+ * overflow list holds timers.  Returns false if the wheel is empty.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next_tick (ACE_UINT64 &next) const
+{
+  for (u_int level = 0; level < this->levels_; ++level)
+    {
+      u_int const index =
+        this->next_slot (level, this->digit (this->current_tick_, level) + 1);
+
+      if (index < this->slot_count_)
+        {
+          u_int const shift = level * this->slot_bits_;
+          u_int const above = shift + this->slot_bits_;
+          next = ((this->current_tick_ >> above) << above)
+            + (static_cast<ACE_UINT64> (index) << shift);
+          return true;
+        }
+    }
+
+  if (this->overflow_->get_next () != this->overflow_)
+    {
+      u_int const range = this->levels_ * this->slot_bits_;
+      next = ((this->current_tick_ >> range) + 1) << range;
+      return true;
+    }
+
+  return false;
+}
+
+/**
+ * Move <current_tick_> forward to @a target, cascading the slots it
+ * enters on the way and moving the timers of the ticks it passes to
+ * <due_>.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::advance (ACE_UINT64 target)
+{
+  ACE_UINT64 next = 0;
+
+  while (this->current_tick_ < target)
+    {
+      if (!this->next_tick (next) || next > target)
+        {
+          // Nothing in between, the placement of every timer is still
+          // right for the new tick.
+          this->current_tick_ = target;
+          return;
+        }
+
+      this->current_tick_ = next;
+
+      // Cascade the slots we just entered, from the top so that a
+      // timer moves down as far as it has to in one go.
+      u_int const range = this->levels_ * this->slot_bits_;
+      if ((this->current_tick_ & ((ACE_UINT64 (1) << range) - 1)) == 0)
+        this->cascade (this->overflow_);
+
+      for (u_int level = this->levels_ - 1; level > 0; --level)
+        {
+          ACE_UINT64 const below =
+            (ACE_UINT64 (1) << (level * this->slot_bits_)) - 1;
+          if ((this->current_tick_ & below) == 0)
+            this->cascade (this->slot (level,
+                                       this->digit (this->current_tick_, level)));
+        }
+
+      // The slot of level 0 holds the timers of exactly this tick,
+      // they are all due.
+      Node *root = this->slot (0, this->digit (this->current_tick_, 0));
+      if (root->get_next () != root)
+        {
+          Node *first = root->get_next ();
+          Node *last = root->get_prev ();
+          Node *tail = this->due_->get_prev ();
+
+          tail->set_next (first);
+          first->set_prev (tail);
+          last->set_next (this->due_);
+          this->due_->set_prev (last);
+
+          root->set_next (root);
+          root->set_prev (root);
+        }
+    }
+}
+
+/// Place all the timers of @a list again.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cascade (Node *list)
+{
+  if (list->get_next () == list)
+    return;
+
+  // Timers still beyond the top level go back to the overflow list,
+  // so work on a list of our own.
+  Node pending;
+  pending.set_next (list->get_next ());
+  pending.set_prev (list->get_prev ());
+  pending.get_next ()->set_prev (&pending);
+  pending.get_prev ()->set_next (&pending);
+  list->set_next (list);
+  list->set_prev (list);
+
+  for (Node *n = pending.get_next (); n != &pending; n = pending.get_next ())
+    {
+      this->unlink (n);
+      this->place (n);
+    }
+}
+
+/// Put @a n on the list where it belongs relative to <current_tick_>.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::place (Node *n)
+{
+  ACE_UINT64 const t = this->tick (n->get_timer_value ());
+
+  if (t <= this->current_tick_)
+    {
+      this->link (this->due_, n);
+      return;
+    }
+
+  ACE_UINT64 const diff = t ^ this->current_tick_;
+
+  for (u_int level = 0; level < this->levels_; ++level)
+    if ((diff >> ((level + 1) * this->slot_bits_)) == 0)
+      {
+        u_int const index = this->digit (t, level);
+        this->link (this->slot (level, index), n);
+        this->occupied_[level * this->words_per_level_ + index / 64] |=
+          ACE_UINT64 (1) << (index % 64);
+        return;
+      }
+
+  this->link (this->overflow_, n);
+}
+
+/// Insert @a n before @a list; with a dummy root node, at the end of its list.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::link (Node *list, Node *n)
+{
+  Node *tail = list->get_prev ();
+  n->set_prev (tail);
+  n->set_next (list);
+  tail->set_next (n);
+  list->set_prev (n);
+}
+
+/// Take @a n out of whichever list it is on.  A node that is on no
+/// list has null pointers.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::unlink (Node *n)
+{
+  n->get_prev ()->set_next (n->get_next ());
+  n->get_next ()->set_prev (n->get_prev ());
+  n->set_prev (0);
+  n->set_next (0);
+}
+
+/// Add the timer @a n to the queue.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::insert (Node *n)
+{
+  this->place (n);
+  ++this->timer_count_;
+
+  if (this->earliest_ != 0
+      && n->get_timer_value () < this->earliest_->get_timer_value ())
+    this->earliest_ = n;
+}
+
+/// Remove the timer @a n from the queue, it keeps its timer id.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::remove (Node *n)
+{
+  this->unlink (n);
+  --this->timer_count_;
+
+  if (this->earliest_ == n)
+    this->earliest_ = 0;
+}
+
+/// Return the scheduled timer with @a timer_id, or 0.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_node (long timer_id) const
+{
+  if (timer_id < 0 || static_cast<size_t> (timer_id) >= this->ids_used_)
+    return 0;
+
+  Node *n = this->ids_[timer_id];
+
+  // Nodes returned by remove_first() keep their id but are not on any
+  // list until they are rescheduled.
+  if (n == 0 || n->get_next () == 0)
+    return 0;
+
+  return n;
+}
+
+/**
+ * Return the earliest timer, searching for it if the cached one was
+ * removed.  Thanks to the placement rules only the lists of expired
+ * timers and the first occupied slot of the lowest occupied level
+ * have to be looked at.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_earliest () const
+{
+  if (this->earliest_ != 0 || this->timer_count_ == 0)
+    return this->earliest_;
+
+  Node *best = this->earliest_in (this->batch_, 0);
+  best = this->earliest_in (this->due_, best);
+
+  for (u_int level = 0; best == 0 && level < this->levels_; ++level)
+    {
+      u_int const index =
+        this->next_slot (level, this->digit (this->current_tick_, level) + 1);
+      if (index < this->slot_count_)
+        best = this->earliest_in (this->slot (level, index), 0);
+    }
+
+  if (best == 0)
+    best = this->earliest_in (this->overflow_, 0);
+
+  this->earliest_ = best;
+  return best;
+}
+
+/// Return the earliest of @a best and of the timers on @a list.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::earliest_in (Node *list, Node *best) const
+{
+  for (Node *n = list->get_next (); n != list; n = n->get_next ())
+    if (best == 0 || n->get_timer_value () < best->get_timer_value ())
+      best = n;
+
+  return best;
+}
+
+/// Give a timer id to @a n, -1 if the id table can't grow.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::acquire_id (Node *n)
+{
+  long timer_id = -1;
+
+  if (this->free_count_ > 0)
+    {
+      timer_id = this->free_ids_[this->free_head_];
+      this->free_head_ = (this->free_head_ + 1) % this->ids_size_;
+      --this->free_count_;
+    }
+  else
+    {
+      if (this->ids_used_ == this->ids_size_ && this->grow_ids () == -1)
+        return -1;
+      timer_id = static_cast<long> (this->ids_used_++);
+    }
+
+  this->ids_[timer_id] = n;
+  return timer_id;
+}
+
+/// Double the size of the timer id table.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::grow_ids ()
+{
+  size_t const new_size = this->ids_size_ == 0
+    ? static_cast<size_t> (ACE_DEFAULT_TIMERS)
+    : this->ids_size_ * 2;
+
+  Node **new_ids = 0;
+  ACE_NEW_RETURN (new_ids, Node *[new_size], -1);
+
+  long *new_free_ids = 0;
+  ACE_NEW_NORETURN (new_free_ids, long[new_size]);
+  if (new_free_ids == 0)
+    {
+      delete [] new_ids;
+      errno = ENOMEM;
+      return -1;
+    }
+
+  if (this->ids_size_ > 0)
+    ACE_OS::memcpy (new_ids, this->ids_, this->ids_size_ * sizeof (Node *));
+
+  // Unroll the FIFO of free ids at the start of the new one.
+  for (size_t i = 0; i < this->free_count_; ++i)
+    new_free_ids[i] =
+      this->free_ids_[(this->free_head_ + i) % this->ids_size_];
+  this->free_head_ = 0;
+
+  delete [] this->ids_;
+  delete [] this->free_ids_;
+  this->ids_ = new_ids;
+  this->free_ids_ = new_free_ids;
+  this->ids_size_ = new_size;
+  return 0;
+}
+
+/**
+* Check to see if the wheel is empty
+*
+* @return True if empty
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::is_empty () const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::is_empty");
+  return this->timer_count_ == 0;
+}
+
+/**
+* @return First (earliest) node in the wheel
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> const ACE_Time_Value &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::earliest_time () const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::earliest_time");
+  Node *n = this->find_earliest ();
+  if (n != 0)
+    return n->get_timer_value ();
+  return ACE_Time_Value::zero;
+}
+
+/**
+ * Creates a ACE_Timer_Node_T based on the input parameters and puts it
+ * on the list given by its tick.
+ *
+ * @return Unique identifier (can be used to cancel the timer).
+ *         -1 on failure.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::schedule_i (const TYPE &type,
+                                                                                  const void *act,
+                                                                                  const ACE_Time_Value &future_time,
+                                                                                  const ACE_Time_Value &interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::schedule_i");
+
+  // An empty wheel can restart from the current time, which keeps it
+  // useful if the clock jumped back since it was last advanced.
+  if (this->timer_count_ == 0)
+    this->current_tick_ = this->tick (this->gettimeofday_static ());
+
+  Node *n = 0;
+  ACE_ALLOCATOR_RETURN (n, this->alloc_node (), -1);
+
+  long const timer_id = this->acquire_id (n);
+  if (timer_id == -1)
+    {
+      Base_Timer_Queue::free_node (n);
+      return -1;
+    }
+
+  n->set (type, act, future_time, interval, 0, 0, timer_id);
+  this->insert (n);
+  return timer_id;
+}
+
+/**
+* Goes through the wheel and cancels all timers whose type is @a type.
+*
+* @return Number of timers canceled
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (const TYPE &type,
+                                                                              int dont_call)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  int number_of_cancellations = 0;
+
+  for (size_t i = 0; i < this->ids_used_; ++i)
+    {
+      Node *n = this->find_node (static_cast<long> (i));
+      if (n != 0 && n->get_type () == type)
+        {
+          this->remove (n);
+          this->free_node (n);
+          ++number_of_cancellations;
+        }
+    }
+
+  // Call the close hooks.
+  int cookie = 0;
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       type,
+                                       dont_call,
+                                       cookie);
+
+  for (int i = 0; i < number_of_cancellations; ++i)
+    {
+      // cancel_timer() called once per <timer>.
+      this->upcall_functor ().cancel_timer (*this,
+                                            type,
+                                            dont_call,
+                                            cookie);
+    }
+
+  return number_of_cancellations;
+}
+
+/**
+* Cancels the single timer with @a timer_id, found in O(1).
+*
+* @return 1 for success and 0 if the timer_id wasn't found (or was
+*         found to be invalid)
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (long timer_id,
+                                                                              const void **act,
+                                                                              int dont_call)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  Node *n = this->find_node (timer_id);
+  if (n == 0)
+    return 0;
+
+  this->remove (n);
+
+  // Call the close hooks.
+  int cookie = 0;
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       n->get_type (),
+                                       dont_call,
+                                       cookie);
+
+  // cancel_timer() called once per <timer>.
+  this->upcall_functor ().cancel_timer (*this,
+                                        n->get_type (),
+                                        dont_call,
+                                        cookie);
+
+  if (act != 0)
+    *act = n->get_act ();
+
+  this->free_node (n);
+  return 1;
+}
+
+/**
+* Changes the interval of a timer (and can make it periodic or non
+* periodic by setting it to ACE_Time_Value::zero or not).
+*
+* @return 0 on success, -1 if the timer_id wasn't found
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reset_interval (long timer_id,
+                                                                                      const ACE_Time_Value &interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reset_interval");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  Node *n = this->find_node (timer_id);
+  if (n == 0)
+    return -1;
+
+  n->set_interval (interval);
+  return 0;
+}
+
+/// Put an interval timer back on the wheel, it still has its id.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reschedule (ACE_Timer_Node_T<TYPE> *n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reschedule");
+  this->insert (n);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::free_node (ACE_Timer_Node_T<TYPE> *n)
+{
+  long const timer_id = n->get_timer_id ();
+
+  if (timer_id >= 0
+      && static_cast<size_t> (timer_id) < this->ids_used_
+      && this->ids_[timer_id] == n)
+    {
+      this->ids_[timer_id] = 0;
+      this->free_ids_[(this->free_head_ + this->free_count_) % this->ids_size_] =
+        timer_id;
+      ++this->free_count_;
+    }
+
+  Base_Timer_Queue::free_node (n);
+}
+
+/**
+* Dumps out the shape of the wheel and the timers it holds.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nlevels_ = %u"), this->levels_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nslot_count_ = %u"), this->slot_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nresolution_ = %Q"), this->resolution_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ncurrent_tick_ = %Q"), this->current_tick_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntimer_count_ = %B"), this->timer_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntimers_ =\n")));
+
+  for (size_t i = 0; i < this->ids_used_; ++i)
+    {
+      Node *n = this->find_node (static_cast<long> (i));
+      if (n != 0)
+        n->dump ();
+    }
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+/**
+* Removes the earliest node, see the header for what the caller has
+* to do with it.
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::remove_first ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::remove_first");
+
+  Node *n = this->find_earliest ();
+  if (n != 0)
+    this->remove (n);
+  return n;
+}
+
+/**
+* Returns the earliest node without removing it
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::get_first");
+  return this->find_earliest ();
+}
+
+/**
+* @return The iterator
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Queue_Iterator_T<TYPE> &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::iter ()
+{
+  this->iterator_->first ();
+  return *this->iterator_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::expire ()
+{
+  return Base_Timer_Queue::expire ();
+}
+
+/**
+* Advances the wheel to @a cur_time once, takes all the timers that
+* are due off the wheel as a batch and dispatches them.  The lock is
+* released during each upcall, as in ACE_Timer_Queue_T::expire(); a
+* timer of the batch that is cancelled meanwhile is not dispatched.
+*
+* @param cur_time The time to expire timers up to.
+*
+* @return Number of timers expired
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::expire (const ACE_Time_Value &cur_time)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::expire");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  if (this->is_empty ())
+    return 0;
+
+  // Most calls come from an event loop woken up for other reasons,
+  // leave the wheel alone while the earliest timer is later.  The
+  // earliest timer is cached, so this is only searched once for every
+  // timer that expires or is cancelled first.
+  if (cur_time < this->find_earliest ()->get_timer_value ())
+    return 0;
+
+  this->advance (this->tick (cur_time));
+
+  // The timers of the current tick may be later than cur_time, they
+  // stay on the due list.  The due list is in tick order but not
+  // sorted within a tick, sort the batch from its tail, which is
+  // cheap on a list that is nearly sorted already.
+  for (Node *n = this->due_->get_next (); n != this->due_; )
+    {
+      Node *next = n->get_next ();
+      if (n->get_timer_value () <= cur_time)
+        {
+          this->unlink (n);
+
+          Node *after = this->batch_->get_prev ();
+          while (after != this->batch_
+                 && n->get_timer_value () < after->get_timer_value ())
+            after = after->get_prev ();
+
+          this->link (after->get_next (), n);
+        }
+      n = next;
+    }
+
+  int number_of_timers_expired = 0;
+
+  ACE_Timer_Node_Dispatch_Info_T<TYPE> info;
+
+  while (this->batch_->get_next () != this->batch_)
+    {
+      Node *n = this->batch_->get_next ();
+      this->remove (n);
+
+      // Get the dispatch info
+      n->get_dispatch_info (info);
+
+      if (n->get_interval () > ACE_Time_Value::zero)
+        {
+          // Make sure that we skip past values that have already
+          // "expired".
+          this->recompute_next_abs_interval_time (n, cur_time);
+
+          this->reschedule (n);
+        }
+      else
+        {
+          this->free_node (n);
+        }
+
+      ACE_MT (ACE_Reverse_Lock<ACE_LOCK> rev_lk (this->mutex_));
+      ACE_MT (ACE_GUARD_RETURN (ACE_Reverse_Lock<ACE_LOCK>, rmon, rev_lk, -1));
+
+      const void *upcall_act = 0;
+
+      this->preinvoke (info, cur_time, upcall_act);
+
+      this->upcall (info, cur_time);
+
+      this->postinvoke (info, cur_time, upcall_act);
+
+      ++number_of_timers_expired;
+    }
+
+  return number_of_timers_expired;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// ACE_Timer_Hierarchical_Wheel_Iterator_T
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_Iterator_T
+  (Wheel &wheel)
+  : timer_wheel_ (wheel),
+    position_ (0)
+{
+  this->first ();
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::first ()
+{
+  this->goto_next (0);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next ()
+{
+  if (!this->isdone ())
+    this->goto_next (this->position_ + 1);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::goto_next (size_t position)
+{
+  while (position < this->timer_wheel_.ids_used_
+         && this->timer_wheel_.find_node (static_cast<long> (position)) == 0)
+    ++position;
+
+  this->position_ = position;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::isdone () const
+{
+  return this->position_ >= this->timer_wheel_.ids_used_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::item ()
+{
+  if (this->isdone ())
+    return 0;
+
+  return this->timer_wheel_.ids_[this->position_];
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP */
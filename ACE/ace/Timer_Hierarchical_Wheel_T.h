@@ -0,0 +1,314 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Timer_Hierarchical_Wheel_T.h
+ */
+//=============================================================================
+
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Timer_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward declaration
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+class ACE_Timer_Hierarchical_Wheel_T;
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_Iterator_T
+ *
+ * @brief Iterates over an ACE_Timer_Hierarchical_Wheel_T.
+ *
+ * This is a generic iterator that can be used to visit every
+ * node of a timer queue.  Be aware that it doesn't traverse
+ * in the order of timeout values.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_Iterator_T
+  : public ACE_Timer_Queue_Iterator_T<TYPE>
+{
+public:
+  typedef ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Wheel;
+
+  /// Constructor.
+  ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel &);
+
+  /// Destructor.
+  ~ACE_Timer_Hierarchical_Wheel_Iterator_T () override = default;
+
+  /// Positions the iterator at the first node in the Timer Queue
+  void first () override;
+
+  /// Positions the iterator at the next node in the Timer Queue
+  void next () override;
+
+  /// Returns true when there are no more nodes in the sequence
+  bool isdone () const override;
+
+  /// Returns the node at the current position in the sequence
+  ACE_Timer_Node_T<TYPE> *item () override;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Skip the free timer ids, starting at @a position.
+  void goto_next (size_t position);
+
+  /// The wheel we are iterating over.
+  Wheel &timer_wheel_;
+
+  /// Current position in the timer id table of the wheel.
+  size_t position_;
+};
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_T
+ *
+ * @brief Provides a hierarchical timing wheel version of
+ * ACE_Timer_Queue, suited to very large numbers of timers.
+ *
+ * Time is divided in ticks of a fixed resolution.  The wheel has
+ * several levels of @c 2^slot_bits slots each: a slot of level 0
+ * covers one tick, a slot of level 1 covers a whole turn of level 0,
+ * and so on, as in Varghese and Lauck's "Hashed and Hierarchical
+ * Timing Wheels".  Each slot is an unsorted, doubly-linked list of
+ * ACE_Timer_Node_T, so scheduling and cancelling a timer is O(1)
+ * whatever the number of timers and however far in the future they
+ * expire.  Timers beyond the range of the top level wait in an
+ * overflow list.
+ *
+ * The timers of a higher level slot are only moved down ("cascaded")
+ * when the wheel reaches that slot, which most timers that are
+ * cancelled before they expire never see.  The wheel advances
+ * directly from one occupied slot to the next, so an idle period
+ * costs nothing.  expire() advances the wheel once and dispatches all
+ * the timers that are due as a batch.
+ *
+ * The resolution only determines how timers are grouped: timers
+ * within one tick still expire in order of their exact time, and
+ * never before it.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_T
+  : public ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>
+{
+public:
+  /// Type of iterator
+  typedef ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Iterator;
+  /// Iterator is a friend
+  friend class ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+  /// Type inherited from
+  typedef ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Base_Timer_Queue;
+  typedef ACE_Free_List<Node> FreeList;
+
+  /// Default constructor, uses ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_LEVELS,
+  /// ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_SLOT_BITS and
+  /// ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION.
+  ACE_Timer_Hierarchical_Wheel_T (FUNCTOR *upcall_functor = 0,
+                                  FreeList *freelist = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /**
+   * Constructor with opportunities to set the shape of the wheel.
+   *
+   * @param levels     Number of levels, between 1 and 8.
+   * @param slot_bits  Each level has 2^@a slot_bits slots, @a slot_bits
+   *                   is between 6 and 12.
+   * @param resolution Length of a tick, in microseconds.
+   * @param prealloc   Number of timer nodes to preallocate.
+   *
+   * The levels cover at most 60 bits of ticks; @a levels is lowered
+   * if needed.
+   */
+  ACE_Timer_Hierarchical_Wheel_T (u_int levels,
+                                  u_int slot_bits,
+                                  u_int resolution,
+                                  size_t prealloc = 0,
+                                  FUNCTOR *upcall_functor = 0,
+                                  FreeList *freelist = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_T ();
+
+  /// True if queue is empty, else false.
+  virtual bool is_empty () const;
+
+  /// Returns the time of the earliest node in the wheel.
+  /// Must be called on a non-empty queue.
+  virtual const ACE_Time_Value &earliest_time () const;
+
+  /// Changes the interval of a timer (and can make it periodic or non
+  /// periodic by setting it to ACE_Time_Value::zero or not).
+  virtual int reset_interval (long timer_id,
+                              const ACE_Time_Value &interval);
+
+  /// Cancel all timer associated with @a type.  If
+  /// @a dont_call_handle_close is 0 then the <functor> will be invoked.
+  /// Returns number of timers cancelled.
+  virtual int cancel (const TYPE &type,
+                      int dont_call_handle_close = 1);
+
+  /// Cancel a timer, storing the magic cookie in act (if nonzero).
+  /// Calls the functor if dont_call_handle_close is 0 and returns 1
+  /// on success
+  virtual int cancel (long timer_id,
+                      const void **act = 0,
+                      int dont_call_handle_close = 1);
+
+  /// Destroy timer queue. Cancels all timers.
+  virtual int close ();
+
+  /// Run the <functor> for all timers whose values are <=
+  /// <ACE_OS::gettimeofday>.  Also accounts for <timer_skew>.  Returns
+  /// the number of timers expired.
+  virtual int expire ();
+
+  /// Run the <functor> for all timers whose values are <= @a current_time.
+  /// This does not account for <timer_skew>.  Returns the number of
+  /// timers expired.
+  virtual int expire (const ACE_Time_Value &current_time);
+
+  /// Returns a pointer to this ACE_Timer_Queue_T's iterator.
+  virtual ACE_Timer_Queue_Iterator_T<TYPE> &iter ();
+
+  /**
+   * Removes the earliest node from the queue and returns it.  The
+   * node keeps its timer id, the caller is responsible for calling
+   * either @c reschedule() or @c free_node() after this function
+   * returns.
+   */
+  virtual ACE_Timer_Node_T<TYPE> *remove_first ();
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  /// Reads the earliest node from the queue and returns it.
+  virtual ACE_Timer_Node_T<TYPE> *get_first ();
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Schedules a timer.
+  virtual long schedule_i (const TYPE &type,
+                           const void *act,
+                           const ACE_Time_Value &future_time,
+                           const ACE_Time_Value &interval);
+
+  /// Reschedule an "interval" ACE_Timer_Node_T.
+  virtual void reschedule (ACE_Timer_Node_T<TYPE> *);
+
+  /// Return the timer id of the node to the free ids before freeing
+  /// the node itself.
+  virtual void free_node (ACE_Timer_Node_T<TYPE> *);
+
+private:
+  // The following are documented in the .cpp file.
+  void open_i (size_t prealloc, u_int levels, u_int slot_bits, u_int resolution);
+  ACE_UINT64 tick (const ACE_Time_Value &time) const;
+  Node *slot (u_int level, u_int index) const;
+  u_int digit (ACE_UINT64 tick, u_int level) const;
+  u_int next_slot (u_int level, u_int from) const;
+  bool next_tick (ACE_UINT64 &next) const;
+  void advance (ACE_UINT64 target);
+  void cascade (Node *list);
+  void place (Node *n);
+  void link (Node *list, Node *n);
+  void unlink (Node *n);
+  void insert (Node *n);
+  void remove (Node *n);
+  Node *find_node (long timer_id) const;
+  Node *find_earliest () const;
+  Node *earliest_in (Node *list, Node *best) const;
+  long acquire_id (Node *n);
+  int grow_ids ();
+
+  /// Number of levels in the wheel.
+  u_int levels_;
+
+  /// Each level has 2^slot_bits_ slots.
+  u_int slot_bits_;
+
+  /// Number of slots in a level.
+  u_int slot_count_;
+
+  /// Length of a tick, in microseconds.
+  ACE_UINT64 resolution_;
+
+  /**
+   * Dummy root nodes of all the lists of the wheel: the slots of each
+   * level, followed by the lists of timers beyond the top level,
+   * of timers whose tick has been reached and of timers being
+   * dispatched by expire().  Each list is circular, so a node can be
+   * removed without knowing which list it is on.
+   */
+  Node *lists_;
+
+  /// Timers beyond the range of the top level.
+  Node *overflow_;
+
+  /// Timers whose tick has been reached but that did not expire yet.
+  Node *due_;
+
+  /// Expired timers that expire() still has to dispatch.
+  Node *batch_;
+
+  /// One bit per slot, set when the slot may hold timers.  Bits are
+  /// only cleared when a search finds their slot empty.
+  ACE_UINT64 *occupied_;
+
+  /// Number of 64 bit words of <occupied_> for each level.
+  u_int words_per_level_;
+
+  /// All the timers at or before this tick are in <due_> or <batch_>.
+  ACE_UINT64 current_tick_;
+
+  /// Cached earliest node, 0 when it has to be searched again.
+  mutable Node *earliest_;
+
+  /// The total number of timers currently scheduled.
+  size_t timer_count_;
+
+  /// Node of each timer id, 0 for free ids.  This makes cancel() O(1).
+  Node **ids_;
+
+  /// Free timer ids, as a FIFO to delay reuse as long as possible.
+  long *free_ids_;
+
+  /// Capacity of <ids_> and <free_ids_>.
+  size_t ids_size_;
+
+  /// Number of ids handed out at least once.
+  size_t ids_used_;
+
+  /// First entry and number of entries of <free_ids_>.
+  size_t free_head_;
+  size_t free_count_;
+
+  /// Iterator used by iter().
+  Iterator *iterator_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Timer_Hierarchical_Wheel_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Timer_Hierarchical_Wheel_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_H */
@@ -0,0 +1,1032 @@
+#include "ace/Uring_Proactor.h"
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/ACE.h"
+#include "ace/Addr.h"
+#include "ace/Countdown_Time.h"
+#include "ace/Flag_Manip.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/os_include/os_poll.h"
+
+#include /**/ <linux/io_uring.h>
+#include /**/ <sys/syscall.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  int
+  uring_setup (unsigned int entries, io_uring_params *params)
+  {
+    return static_cast<int> (::syscall (__NR_io_uring_setup,
+                                        entries,
+                                        params));
+  }
+
+  int
+  uring_enter (ACE_HANDLE fd,
+               unsigned int to_submit,
+               unsigned int min_complete,
+               unsigned int flags,
+               const void *arg,
+               size_t arg_size)
+  {
+    return static_cast<int> (::syscall (__NR_io_uring_enter,
+                                        fd,
+                                        to_submit,
+                                        min_complete,
+                                        flags,
+                                        arg,
+                                        arg_size));
+  }
+
+  // The ring indices are shared with the kernel, accesses need
+  // acquire/release semantics.
+  inline unsigned int
+  load_acquire (const unsigned int *p)
+  {
+    return __atomic_load_n (p, __ATOMIC_ACQUIRE);
+  }
+
+  inline void
+  store_release (unsigned int *p, unsigned int value)
+  {
+    __atomic_store_n (p, value, __ATOMIC_RELEASE);
+  }
+
+  // Largest transfer a single read or write request may ask for.
+  const size_t max_transfer = 0x7ffff000;
+}
+
+/**
+ * @class ACE_Uring_Asynch_Connect_Result
+ *
+ * Connect result which keeps the remote address alive until the
+ * ring has completed the connect request.
+ */
+class ACE_Uring_Asynch_Connect_Result : public ACE_POSIX_Asynch_Connect_Result
+{
+public:
+  ACE_Uring_Asynch_Connect_Result (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                                   ACE_HANDLE connect_handle,
+                                   const void *act,
+                                   ACE_HANDLE event,
+                                   int priority,
+                                   int signal_number)
+    : ACE_POSIX_Asynch_Connect_Result (handler_proxy,
+                                       connect_handle,
+                                       act,
+                                       event,
+                                       priority,
+                                       signal_number)
+  {
+  }
+
+  /// Remote address, referenced through aio_buf/aio_nbytes.
+  sockaddr_storage remote_addr_;
+};
+
+// *********************************************************************
+
+ACE_Uring_Proactor::ACE_Uring_Proactor (size_t entries)
+  : ring_fd_ (ACE_INVALID_HANDLE),
+    sq_ring_ (0),
+    sq_ring_size_ (0),
+    cq_ring_ (0),
+    cq_ring_size_ (0),
+    sqes_ (0),
+    sqes_size_ (0),
+    sq_head_ (0),
+    sq_tail_ (0),
+    sq_mask_ (0),
+    sq_entries_ (0),
+    sq_array_ (0),
+    cq_head_ (0),
+    cq_tail_ (0),
+    cq_mask_ (0),
+    cqes_ (0),
+    features_ (0),
+    sq_local_tail_ (0),
+    to_submit_ (0),
+    dispatching_ (0),
+    outstanding_ (0)
+{
+  if (this->open_ring (static_cast<unsigned int> (entries)) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                   ACE_TEXT ("ACE_Uring_Proactor: io_uring setup failed")));
+}
+
+ACE_Uring_Proactor::~ACE_Uring_Proactor ()
+{
+  this->close ();
+}
+
+ACE_POSIX_Proactor::Proactor_Type
+ACE_Uring_Proactor::get_impl_type ()
+{
+  return PROACTOR_URING;
+}
+
+ACE_HANDLE
+ACE_Uring_Proactor::get_handle () const
+{
+  return this->ring_fd_;
+}
+
+int
+ACE_Uring_Proactor::open_ring (unsigned int entries)
+{
+  io_uring_params params;
+  ACE_OS::memset (&params, 0, sizeof params);
+
+  int const fd = uring_setup (entries, &params);
+  if (fd < 0)
+    return -1;
+
+  this->ring_fd_ = fd;
+  this->features_ = params.features;
+
+  this->sq_ring_size_ =
+    params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+  this->cq_ring_size_ =
+    params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+
+  bool const single_mmap =
+    ACE_BIT_ENABLED (params.features, IORING_FEAT_SINGLE_MMAP);
+  if (single_mmap)
+    {
+      if (this->cq_ring_size_ > this->sq_ring_size_)
+        this->sq_ring_size_ = this->cq_ring_size_;
+      this->cq_ring_size_ = this->sq_ring_size_;
+    }
+
+  void *area = ACE_OS::mmap (0,
+                             this->sq_ring_size_,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             this->ring_fd_,
+                             IORING_OFF_SQ_RING);
+  if (area == MAP_FAILED)
+    {
+      this->close_ring ();
+      return -1;
+    }
+  this->sq_ring_ = area;
+
+  if (single_mmap)
+    this->cq_ring_ = this->sq_ring_;
+  else
+    {
+      area = ACE_OS::mmap (0,
+                           this->cq_ring_size_,
+                           PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE,
+                           this->ring_fd_,
+                           IORING_OFF_CQ_RING);
+      if (area == MAP_FAILED)
+        {
+          this->close_ring ();
+          return -1;
+        }
+      this->cq_ring_ = area;
+    }
+
+  this->sqes_size_ = params.sq_entries * sizeof (io_uring_sqe);
+  area = ACE_OS::mmap (0,
+                       this->sqes_size_,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE,
+                       this->ring_fd_,
+                       IORING_OFF_SQES);
+  if (area == MAP_FAILED)
+    {
+      this->close_ring ();
+      return -1;
+    }
+  this->sqes_ = static_cast<io_uring_sqe *> (area);
+
+  char *sq = static_cast<char *> (this->sq_ring_);
+  this->sq_head_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.head);
+  this->sq_tail_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.tail);
+  this->sq_mask_ =
+    reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_mask);
+  this->sq_entries_ =
+    reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_entries);
+  this->sq_array_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.array);
+
+  char *cq = static_cast<char *> (this->cq_ring_);
+  this->cq_head_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.head);
+  this->cq_tail_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.tail);
+  this->cq_mask_ =
+    reinterpret_cast<unsigned int *> (cq + params.cq_off.ring_mask);
+  this->cqes_ = reinterpret_cast<io_uring_cqe *> (cq + params.cq_off.cqes);
+
+  this->sq_local_tail_ = *this->sq_tail_;
+  return 0;
+}
+
+void
+ACE_Uring_Proactor::close_ring ()
+{
+  if (this->sqes_ != 0)
+    ACE_OS::munmap (this->sqes_, this->sqes_size_);
+  if (this->cq_ring_ != 0 && this->cq_ring_ != this->sq_ring_)
+    ACE_OS::munmap (this->cq_ring_, this->cq_ring_size_);
+  if (this->sq_ring_ != 0)
+    ACE_OS::munmap (this->sq_ring_, this->sq_ring_size_);
+  if (this->ring_fd_ != ACE_INVALID_HANDLE)
+    ACE_OS::close (this->ring_fd_);
+
+  this->sqes_ = 0;
+  this->cq_ring_ = 0;
+  this->sq_ring_ = 0;
+  this->cq_head_ = 0;
+  this->ring_fd_ = ACE_INVALID_HANDLE;
+}
+
+int
+ACE_Uring_Proactor::close ()
+{
+  if (this->ring_fd_ == ACE_INVALID_HANDLE)
+    return 0;
+
+  // Cancel whatever is still in flight and discard the results
+  // without calling back into the handlers, as the other POSIX
+  // proactors do when their aiocb lists are deleted.
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+#if defined (IORING_ASYNC_CANCEL_ANY)
+    if (this->outstanding_ > 0)
+      {
+        io_uring_sqe *sqe = this->get_sqe_i (1);
+        if (sqe != 0)
+          {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+            sqe->user_data = URING_INTERNAL;
+          }
+      }
+#endif /* IORING_ASYNC_CANCEL_ANY */
+    this->flush_i ();
+  }
+
+  Completion batch[ACE_URING_REAP_BATCH];
+  ACE_Time_Value const drain_timeout (0, 100000);
+  for (int attempt = 0; attempt < 10 && this->outstanding_ > 0; )
+    {
+      size_t n = 0;
+      {
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+        n = this->reap_i (batch, ACE_URING_REAP_BATCH);
+      }
+
+      for (size_t i = 0; i < n; ++i)
+        delete reinterpret_cast<ACE_POSIX_Asynch_Result *>
+          (batch[i].user_data_ & ~static_cast<ACE_UINT64> (URING_KIND_MASK));
+
+      if (n == 0 && this->wait_i (&drain_timeout) <= 0)
+        ++attempt;
+    }
+
+  if (this->outstanding_ > 0)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P|%t)::ACE_Uring_Proactor::close: ")
+                   ACE_TEXT ("%B operations did not complete\n"),
+                   this->outstanding_));
+
+  this->close_ring ();
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::handle_events (ACE_Time_Value &wait_time)
+{
+  // Decrement <wait_time> with the amount of time spent in the method
+  ACE_Countdown_Time countdown (&wait_time);
+  return this->handle_events_i (&wait_time);
+}
+
+int
+ACE_Uring_Proactor::handle_events ()
+{
+  return this->handle_events_i (0);
+}
+
+int
+ACE_Uring_Proactor::handle_events_i (const ACE_Time_Value *timeout)
+{
+  if (this->ring_fd_ == ACE_INVALID_HANDLE)
+    {
+      errno = EBADF;
+      return -1;
+    }
+
+  Completion batch[ACE_URING_REAP_BATCH];
+  size_t n = 0;
+
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+    this->flush_i ();
+    n = this->reap_i (batch, ACE_URING_REAP_BATCH);
+    if (n > 0)
+      ++this->dispatching_;
+  }
+
+  if (n == 0)
+    {
+      int const result = this->wait_i (timeout);
+      if (result <= 0)
+        return result;
+
+      ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+      n = this->reap_i (batch, ACE_URING_REAP_BATCH);
+      if (n == 0)
+        return 0;  // Another thread got there first.
+      ++this->dispatching_;
+    }
+
+  // Operations started by the handlers are queued on the ring and
+  // handed to the kernel in one go once the whole batch is done.
+  for (size_t i = 0; i < n; ++i)
+    this->dispatch_i (batch[i]);
+
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, 1));
+    --this->dispatching_;
+    this->flush_i ();
+  }
+
+  return 1;
+}
+
+int
+ACE_Uring_Proactor::wait_i (const ACE_Time_Value *timeout)
+{
+  int result = 0;
+
+  if (timeout == 0)
+    {
+      result = uring_enter (this->ring_fd_,
+                            0,
+                            1,
+                            IORING_ENTER_GETEVENTS,
+                            0,
+                            0);
+    }
+#if defined (IORING_FEAT_EXT_ARG)
+  else if (ACE_BIT_ENABLED (this->features_, IORING_FEAT_EXT_ARG))
+    {
+      __kernel_timespec ts;
+      ts.tv_sec = timeout->sec ();
+      ts.tv_nsec = timeout->usec () * 1000;
+
+      io_uring_getevents_arg arg;
+      ACE_OS::memset (&arg, 0, sizeof arg);
+      arg.ts = reinterpret_cast<ACE_UINT64> (&ts);
+
+      result = uring_enter (this->ring_fd_,
+                            0,
+                            1,
+                            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                            &arg,
+                            sizeof arg);
+    }
+#endif /* IORING_FEAT_EXT_ARG */
+  else
+    {
+      // Older kernels: the ring descriptor polls readable as long as
+      // completions are pending.
+      result = ACE::handle_read_ready (this->ring_fd_, timeout);
+      if (result == 0)
+        return 0;
+    }
+
+  if (result < 0)
+    {
+      if (errno == ETIME || errno == ETIMEDOUT || errno == EINTR)
+        return 0;
+
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                            ACE_TEXT ("ACE_Uring_Proactor::handle_events: ")
+                            ACE_TEXT ("io_uring_enter failed")),
+                           -1);
+    }
+
+  return 1;
+}
+
+size_t
+ACE_Uring_Proactor::reap_i (Completion batch[], size_t max)
+{
+  if (this->cq_head_ == 0)
+    return 0;
+
+  unsigned int head = *this->cq_head_;
+  unsigned int const tail = load_acquire (this->cq_tail_);
+  unsigned int const mask = *this->cq_mask_;
+  size_t n = 0;
+
+  for (; head != tail && n < max; ++head)
+    {
+      const io_uring_cqe &cqe = this->cqes_[head & mask];
+      if (cqe.user_data == URING_INTERNAL)
+        continue;
+
+      batch[n].user_data_ = cqe.user_data;
+      batch[n].res_ = cqe.res;
+
+      ACE_POSIX_Asynch_Result *result =
+        reinterpret_cast<ACE_POSIX_Asynch_Result *>
+          (cqe.user_data & ~static_cast<ACE_UINT64> (URING_KIND_MASK));
+      this->untrack_i
+        (request_handle (result,
+                         static_cast<Request_Kind> (cqe.user_data & URING_KIND_MASK)));
+      --this->outstanding_;
+      ++n;
+    }
+
+  store_release (this->cq_head_, head);
+  return n;
+}
+
+void
+ACE_Uring_Proactor::dispatch_i (const Completion &c)
+{
+  ACE_POSIX_Asynch_Result *result =
+    reinterpret_cast<ACE_POSIX_Asynch_Result *>
+      (c.user_data_ & ~static_cast<ACE_UINT64> (URING_KIND_MASK));
+  Request_Kind const kind =
+    static_cast<Request_Kind> (c.user_data_ & URING_KIND_MASK);
+
+  size_t bytes_transferred = 0;
+  u_long error = 0;
+
+  switch (kind)
+    {
+    case URING_POSTED:
+      bytes_transferred = result->bytes_transferred ();
+      error = result->error ();
+      break;
+
+    case URING_IO:
+      if (c.res_ == -EAGAIN)
+        {
+          // Non-blocking handle: retry once it becomes ready.
+          short const events =
+            result->aio_lio_opcode == LIO_READ ? POLLIN : POLLOUT;
+          if (this->requeue_after_poll (result, kind, events) == 0)
+            return;
+          error = EAGAIN;
+        }
+      else if (c.res_ < 0)
+        error = (c.res_ == -EINTR) ? ECANCELED : -c.res_;
+      else
+        bytes_transferred = static_cast<size_t> (c.res_);
+      break;
+
+    case URING_ACCEPT:
+      if (c.res_ == -EAGAIN)
+        {
+          if (this->requeue_after_poll (result, kind, POLLIN) == 0)
+            return;
+          error = EAGAIN;
+        }
+      else if (c.res_ < 0)
+        error = (c.res_ == -EINTR) ? ECANCELED : -c.res_;
+
+      // Store the new handle.
+      result->aio_fildes = c.res_ < 0 ? ACE_INVALID_HANDLE : c.res_;
+      break;
+
+    case URING_CONNECT:
+      if (c.res_ == -EINPROGRESS || c.res_ == -EALREADY || c.res_ == -EAGAIN)
+        {
+          // The handle was put back into non-blocking mode behind
+          // our back, wait for the connect to finish.
+          if (this->start_request (result, URING_CONNECT_WAIT) == 0)
+            return;
+          error = errno;
+        }
+      else if (c.res_ < 0)
+        error = (c.res_ == -EINTR) ? ECANCELED : -c.res_;
+      break;
+
+    case URING_CONNECT_WAIT:
+      if (c.res_ < 0)
+        error = (c.res_ == -EINTR) ? ECANCELED : -c.res_;
+      else
+        {
+          int sockerror = 0;
+          int lsockerror = sizeof sockerror;
+          ACE_OS::getsockopt (result->aio_fildes,
+                              SOL_SOCKET,
+                              SO_ERROR,
+                              reinterpret_cast<char *> (&sockerror),
+                              &lsockerror);
+          error = sockerror;
+        }
+      break;
+
+    default:
+      return;
+    }
+
+  this->application_specific_code (result,
+                                   bytes_transferred,
+                                   0,  // No completion key.
+                                   error);
+}
+
+io_uring_sqe *
+ACE_Uring_Proactor::get_sqe_i (unsigned int count)
+{
+  if (this->sqes_ == 0)
+    {
+      errno = EBADF;
+      return 0;
+    }
+
+  unsigned int const entries = *this->sq_entries_;
+  if (this->sq_local_tail_ - load_acquire (this->sq_head_) + count > entries)
+    {
+      this->flush_i ();
+      if (this->sq_local_tail_ - load_acquire (this->sq_head_) + count > entries)
+        {
+          errno = EAGAIN;
+          return 0;
+        }
+    }
+
+  unsigned int const index = this->sq_local_tail_ & *this->sq_mask_;
+  io_uring_sqe *sqe = &this->sqes_[index];
+  ACE_OS::memset (sqe, 0, sizeof *sqe);
+  this->sq_array_[index] = index;
+  ++this->sq_local_tail_;
+  ++this->to_submit_;
+  return sqe;
+}
+
+ACE_HANDLE
+ACE_Uring_Proactor::request_handle (ACE_POSIX_Asynch_Result *result,
+                                    Request_Kind kind)
+{
+  switch (kind)
+    {
+    case URING_IO:
+    case URING_CONNECT:
+    case URING_CONNECT_WAIT:
+      return result->aio_fildes;
+    case URING_ACCEPT:
+      return static_cast<ACE_POSIX_Asynch_Accept_Result *> (result)->listen_handle ();
+    default:
+      return ACE_INVALID_HANDLE;
+    }
+}
+
+void
+ACE_Uring_Proactor::prepare_i (io_uring_sqe *sqe,
+                               ACE_POSIX_Asynch_Result *result,
+                               Request_Kind kind)
+{
+  switch (kind)
+    {
+    case URING_IO:
+      sqe->opcode =
+        result->aio_lio_opcode == LIO_READ ? IORING_OP_READ : IORING_OP_WRITE;
+      sqe->fd = result->aio_fildes;
+      sqe->addr =
+        reinterpret_cast<ACE_UINT64> (const_cast<void *> (result->aio_buf));
+      sqe->len = static_cast<ACE_UINT32> (result->aio_nbytes > max_transfer
+                                          ? max_transfer
+                                          : result->aio_nbytes);
+      sqe->off = static_cast<ACE_UINT64> (result->aio_offset);
+      break;
+
+    case URING_ACCEPT:
+      sqe->opcode = IORING_OP_ACCEPT;
+      sqe->fd = request_handle (result, kind);
+      break;
+
+    case URING_CONNECT:
+      sqe->opcode = IORING_OP_CONNECT;
+      sqe->fd = result->aio_fildes;
+      sqe->addr =
+        reinterpret_cast<ACE_UINT64> (const_cast<void *> (result->aio_buf));
+      sqe->off = result->aio_nbytes;
+      break;
+
+    case URING_CONNECT_WAIT:
+      sqe->opcode = IORING_OP_POLL_ADD;
+      sqe->fd = result->aio_fildes;
+      sqe->poll32_events = POLLOUT;
+      break;
+
+    default: // URING_POSTED
+      sqe->opcode = IORING_OP_NOP;
+      break;
+    }
+
+  sqe->user_data = reinterpret_cast<ACE_UINT64> (result) | kind;
+}
+
+int
+ACE_Uring_Proactor::queue_i (ACE_POSIX_Asynch_Result *result,
+                             Request_Kind kind)
+{
+  io_uring_sqe *sqe = this->get_sqe_i (1);
+  if (sqe == 0)
+    return -1;
+
+  this->prepare_i (sqe, result, kind);
+  this->track_i (request_handle (result, kind));
+  ++this->outstanding_;
+
+  // Threads dispatching completions flush the ring when their batch
+  // is done, everybody else submits right away.
+  if (this->dispatching_ == 0 || this->to_submit_ >= ACE_URING_SUBMIT_BATCH)
+    this->flush_i ();
+
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::start_request (ACE_POSIX_Asynch_Result *result,
+                                   Request_Kind kind)
+{
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+  return this->queue_i (result, kind);
+}
+
+int
+ACE_Uring_Proactor::requeue_after_poll (ACE_POSIX_Asynch_Result *result,
+                                        Request_Kind kind,
+                                        short events)
+{
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+  // Both entries have to go into the same submission for the link to
+  // hold.
+  io_uring_sqe *poll_sqe = this->get_sqe_i (2);
+  if (poll_sqe == 0)
+    return -1;
+
+  poll_sqe->opcode = IORING_OP_POLL_ADD;
+  poll_sqe->fd = request_handle (result, kind);
+  poll_sqe->poll32_events = static_cast<ACE_UINT32> (events);
+  poll_sqe->flags = IOSQE_IO_LINK;
+  poll_sqe->user_data = URING_INTERNAL;
+
+  return this->queue_i (result, kind);
+}
+
+int
+ACE_Uring_Proactor::flush_i ()
+{
+  if (this->to_submit_ == 0)
+    return 0;
+
+  store_release (this->sq_tail_, this->sq_local_tail_);
+
+  int result = 0;
+  do
+    result = uring_enter (this->ring_fd_, this->to_submit_, 0, 0, 0, 0);
+  while (result < 0 && errno == EINTR);
+
+  if (result < 0)
+    {
+      // EAGAIN/EBUSY: the kernel is short of resources or the
+      // completion ring overflowed, the entries stay queued and are
+      // retried on the next flush.
+      if (errno != EAGAIN && errno != EBUSY)
+        ACELIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("%N:%l:(%P|%t)::%p\n"),
+                       ACE_TEXT ("ACE_Uring_Proactor::flush_i: ")
+                       ACE_TEXT ("io_uring_enter failed")));
+      return -1;
+    }
+
+  this->to_submit_ -= static_cast<unsigned int> (result);
+  return 0;
+}
+
+void
+ACE_Uring_Proactor::track_i (ACE_HANDLE h)
+{
+  if (h == ACE_INVALID_HANDLE)
+    return;
+
+  size_t const index = static_cast<size_t> (h);
+  size_t const old_size = this->outstanding_per_handle_.size ();
+  if (index >= old_size)
+    {
+      size_t new_size = old_size == 0 ? 64 : old_size * 2;
+      if (new_size <= index)
+        new_size = index + 1;
+
+      if (this->outstanding_per_handle_.size (new_size) == -1)
+        return;
+
+      for (size_t i = old_size; i < new_size; ++i)
+        this->outstanding_per_handle_[i] = 0;
+    }
+
+  ++this->outstanding_per_handle_[index];
+}
+
+void
+ACE_Uring_Proactor::untrack_i (ACE_HANDLE h)
+{
+  if (h == ACE_INVALID_HANDLE)
+    return;
+
+  size_t const index = static_cast<size_t> (h);
+  if (index < this->outstanding_per_handle_.size ()
+      && this->outstanding_per_handle_[index] > 0)
+    --this->outstanding_per_handle_[index];
+}
+
+int
+ACE_Uring_Proactor::post_completion (ACE_POSIX_Asynch_Result *result)
+{
+  if (result == 0)
+    return -1;
+
+  return this->start_request (result, URING_POSTED);
+}
+
+int
+ACE_Uring_Proactor::start_aio (ACE_POSIX_Asynch_Result *result,
+                               ACE_POSIX_Proactor::Opcode op)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_aio");
+
+  // There is no fixed limit on outstanding operations.
+  if (result == 0)
+    return 0;
+
+  switch (op)
+    {
+    case ACE_POSIX_Proactor::ACE_OPCODE_READ:
+      result->aio_lio_opcode = LIO_READ;
+      break;
+
+    case ACE_POSIX_Proactor::ACE_OPCODE_WRITE:
+      result->aio_lio_opcode = LIO_WRITE;
+      break;
+
+    default:
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:(%P|%t)::")
+                            ACE_TEXT ("start_aio: Invalid op code %d\n"),
+                            op),
+                           -1);
+    }
+
+  return this->start_request (result, URING_IO);
+}
+
+int
+ACE_Uring_Proactor::cancel_aio (ACE_HANDLE handle)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::cancel_aio");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+  size_t const index = static_cast<size_t> (handle);
+  if (handle == ACE_INVALID_HANDLE
+      || index >= this->outstanding_per_handle_.size ()
+      || this->outstanding_per_handle_[index] == 0)
+    return 1;  // ALLDONE
+
+#if defined (IORING_ASYNC_CANCEL_FD)
+  io_uring_sqe *sqe = this->get_sqe_i (1);
+  if (sqe == 0)
+    return -1;
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = handle;
+  sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  sqe->user_data = URING_INTERNAL;
+
+  // The cancelled operations complete with ECANCELED later on.
+  this->flush_i ();
+  return 0;  // CANCELLED
+#else
+  return 2;  // NOT CANCELLED
+#endif /* IORING_ASYNC_CANCEL_FD */
+}
+
+ACE_Asynch_Accept_Impl *
+ACE_Uring_Proactor::create_asynch_accept ()
+{
+  ACE_Asynch_Accept_Impl *implementation = 0;
+  ACE_NEW_RETURN (implementation,
+                  ACE_Uring_Asynch_Accept (this),
+                  0);
+
+  return implementation;
+}
+
+ACE_Asynch_Connect_Impl *
+ACE_Uring_Proactor::create_asynch_connect ()
+{
+  ACE_Asynch_Connect_Impl *implementation = 0;
+  ACE_NEW_RETURN (implementation,
+                  ACE_Uring_Asynch_Connect (this),
+                  0);
+
+  return implementation;
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Accept::ACE_Uring_Asynch_Accept (ACE_Uring_Proactor *uring_proactor)
+  : ACE_POSIX_Asynch_Operation (uring_proactor)
+{
+}
+
+ACE_Uring_Asynch_Accept::~ACE_Uring_Asynch_Accept ()
+{
+}
+
+int
+ACE_Uring_Asynch_Accept::accept (ACE_Message_Block &message_block,
+                                 size_t bytes_to_read,
+                                 ACE_HANDLE accept_handle,
+                                 const void *act,
+                                 int priority,
+                                 int signal_number,
+                                 int addr_family)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::accept");
+
+  // Sanity check: make sure that enough space has been allocated by
+  // the caller.
+  size_t address_size = sizeof (sockaddr_in);
+#if defined (ACE_HAS_IPV6)
+  if (addr_family == AF_INET6)
+    address_size = sizeof (sockaddr_in6);
+#else
+  ACE_UNUSED_ARG (addr_family);
+#endif
+  if (message_block.space () < bytes_to_read + 2 * address_size)
+    {
+      ACE_OS::last_error (ENOBUFS);
+      return -1;
+    }
+
+  ACE_POSIX_Asynch_Accept_Result *result = 0;
+  ACE_NEW_RETURN (result,
+                  ACE_POSIX_Asynch_Accept_Result (this->handler_proxy_,
+                                                  this->handle_,
+                                                  accept_handle,
+                                                  message_block,
+                                                  bytes_to_read,
+                                                  act,
+                                                  this->posix_proactor ()->get_handle (),
+                                                  priority,
+                                                  signal_number),
+                  -1);
+
+  ACE_Uring_Proactor *proactor =
+    static_cast<ACE_Uring_Proactor *> (this->posix_proactor ());
+  int const return_val =
+    proactor->start_request (result, ACE_Uring_Proactor::URING_ACCEPT);
+  if (return_val == -1)
+    delete result;
+
+  return return_val;
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Connect::ACE_Uring_Asynch_Connect (ACE_Uring_Proactor *uring_proactor)
+  : ACE_POSIX_Asynch_Operation (uring_proactor)
+{
+}
+
+ACE_Uring_Asynch_Connect::~ACE_Uring_Asynch_Connect ()
+{
+}
+
+int
+ACE_Uring_Asynch_Connect::open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                                ACE_HANDLE handle,
+                                const void *completion_key,
+                                ACE_Proactor *proactor)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::open");
+
+  // Ignore the result as ACE_INVALID_HANDLE is usually passed.
+  ACE_POSIX_Asynch_Operation::open (handler_proxy,
+                                    handle,
+                                    completion_key,
+                                    proactor);
+  return 0;
+}
+
+int
+ACE_Uring_Asynch_Connect::connect (ACE_HANDLE connect_handle,
+                                   const ACE_Addr &remote_sap,
+                                   const ACE_Addr &local_sap,
+                                   int reuse_addr,
+                                   const void *act,
+                                   int priority,
+                                   int signal_number)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::connect");
+
+  ACE_Uring_Proactor *proactor =
+    static_cast<ACE_Uring_Proactor *> (this->posix_proactor ());
+
+  ACE_Uring_Asynch_Connect_Result *result = 0;
+  ACE_NEW_RETURN (result,
+                  ACE_Uring_Asynch_Connect_Result (this->handler_proxy_,
+                                                   connect_handle,
+                                                   act,
+                                                   proactor->get_handle (),
+                                                   priority,
+                                                   signal_number),
+                  -1);
+
+  int error = 0;
+  bool created = false;
+  ACE_HANDLE handle = connect_handle;
+
+  if (handle == ACE_INVALID_HANDLE)
+    {
+      int const protocol_family = remote_sap.get_type ();
+      handle = ACE_OS::socket (protocol_family, SOCK_STREAM, 0);
+      if (handle == ACE_INVALID_HANDLE)
+        error = errno;
+      else
+        {
+          created = true;
+          result->aio_fildes = handle;
+
+          int one = 1;
+          if (protocol_family != PF_UNIX
+              && reuse_addr != 0
+              && ACE_OS::setsockopt (handle,
+                                     SOL_SOCKET,
+                                     SO_REUSEADDR,
+                                     reinterpret_cast<const char *> (&one),
+                                     sizeof one) == -1)
+            error = errno;
+        }
+    }
+
+  if (error == 0 && local_sap != ACE_Addr::sap_any)
+    {
+      sockaddr *laddr = reinterpret_cast<sockaddr *> (local_sap.get_addr ());
+      if (ACE_OS::bind (handle, laddr, local_sap.get_size ()) == -1)
+        error = errno;
+    }
+
+  // The ring performs the connect asynchronously on a blocking handle.
+  if (error == 0 && ACE::clr_flags (handle, ACE_NONBLOCK) == -1)
+    error = errno;
+
+  size_t const addr_size = static_cast<size_t> (remote_sap.get_size ());
+  if (error == 0 && addr_size > sizeof result->remote_addr_)
+    error = EINVAL;
+
+  if (error == 0)
+    {
+      ACE_OS::memcpy (&result->remote_addr_, remote_sap.get_addr (), addr_size);
+      result->aio_buf = &result->remote_addr_;
+      result->aio_nbytes = addr_size;
+
+      if (proactor->start_request (result,
+                                   ACE_Uring_Proactor::URING_CONNECT) == 0)
+        return 0;
+
+      error = errno;
+    }
+
+  // Report the failure through the proactor, as the other POSIX
+  // implementations do.
+  result->set_bytes_transferred (0);
+  result->set_error (error);
+  if (proactor->post_completion (result) == 0)
+    return 0;
+
+  if (created)
+    ACE_OS::closesocket (handle);
+  delete result;
+  return -1;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
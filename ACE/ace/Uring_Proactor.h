@@ -0,0 +1,350 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Proactor.h
+ *
+ *  Proactor implementation on top of the Linux io_uring interface.
+ */
+//=============================================================================
+
+#ifndef ACE_URING_PROACTOR_H
+#define ACE_URING_PROACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/POSIX_Proactor.h"
+#include "ace/Array_Base.h"
+
+#if !defined (ACE_URING_DEFAULT_ENTRIES)
+/// Default number of submission queue entries of the ring.
+#  define ACE_URING_DEFAULT_ENTRIES 1024
+#endif /* ACE_URING_DEFAULT_ENTRIES */
+
+#if !defined (ACE_URING_REAP_BATCH)
+/// Maximum number of completions reaped from the ring under a single
+/// acquisition of the proactor lock.
+#  define ACE_URING_REAP_BATCH 64
+#endif /* ACE_URING_REAP_BATCH */
+
+#if !defined (ACE_URING_SUBMIT_BATCH)
+/// Number of deferred submissions after which the ring is flushed
+/// even while completions are still being dispatched.
+#  define ACE_URING_SUBMIT_BATCH 32
+#endif /* ACE_URING_SUBMIT_BATCH */
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Proactor
+ *
+ * @brief Proactor implementation based on the Linux io_uring
+ * interface.
+ *
+ * Unlike ACE_POSIX_AIOCB_Proactor, which relies on the thread
+ * emulated <aio_> calls of glibc, all operations are handed to the
+ * kernel through a single submission ring and their completions are
+ * harvested from the matching completion ring.  No thread is
+ * consumed per outstanding operation, so a single proactor can serve
+ * tens of thousands of connections.
+ *
+ * The existing POSIX result and operation classes are reused for the
+ * read/write stream, read/write file, datagram and transmit file
+ * operations.  Accept and connect are issued natively on the ring
+ * (see ACE_Uring_Asynch_Accept and ACE_Uring_Asynch_Connect) instead
+ * of going through the ACE_Asynch_Pseudo_Task select loop.
+ *
+ * Submissions are batched: operations started from within a
+ * completion handler are queued on the submission ring and handed to
+ * the kernel with a single system call once the current batch of
+ * completions has been dispatched.  Completions are reaped in batches
+ * of up to ACE_URING_REAP_BATCH entries per lock acquisition.
+ *
+ * This implementation is enabled by defining ACE_HAS_IO_URING and
+ * requires a Linux 5.6 kernel (5.19 for cancellation by handle).  It
+ * becomes the default implementation of ACE_Proactor when
+ * ACE_URING_PROACTOR is defined.
+ */
+class ACE_Export ACE_Uring_Proactor : public ACE_POSIX_Proactor
+{
+  friend class ACE_Uring_Asynch_Accept;
+  friend class ACE_Uring_Asynch_Connect;
+
+public:
+  /// Constructor.  @a entries is the size of the submission ring; it
+  /// bounds the number of operations that may be queued between two
+  /// submissions, not the number of outstanding operations.
+  ACE_Uring_Proactor (size_t entries = ACE_URING_DEFAULT_ENTRIES);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Proactor ();
+
+  virtual Proactor_Type get_impl_type ();
+
+  /// Close down the Proactor.
+  virtual int close ();
+
+  /**
+   * Dispatch a single set of events.  If @a wait_time elapses before
+   * any events occur, return 0.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (ACE_Time_Value &wait_time);
+
+  /**
+   * Block indefinitely until at least one event is dispatched.
+   * Dispatch a single set of events.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events ();
+
+  /// Post a result to the completion ring of the Proactor.
+  virtual int post_completion (ACE_POSIX_Asynch_Result *result);
+
+  /// Queue a read or write operation described by the aiocb part of
+  /// @a result on the submission ring.
+  virtual int start_aio (ACE_POSIX_Asynch_Result *result,
+                         ACE_POSIX_Proactor::Opcode op);
+
+  /**
+   * Cancel all outstanding operations issued on handle @a h.  The
+   * cancelled operations complete with ECANCELED.  Returns 1 if
+   * there was no outstanding operation (ALLDONE), 0 if a cancellation
+   * request was issued (CANCELLED) and 2 if the running kernel cannot
+   * cancel by handle (NOT CANCELLED).
+   */
+  virtual int cancel_aio (ACE_HANDLE h);
+
+  /// Returns the file descriptor of the ring, which becomes readable
+  /// whenever completions are pending.
+  virtual ACE_HANDLE get_handle () const;
+
+  /// Native accept and connect operations.
+  virtual ACE_Asynch_Accept_Impl *create_asynch_accept ();
+  virtual ACE_Asynch_Connect_Impl *create_asynch_connect ();
+
+protected:
+  /// Kinds of requests, encoded in the low bits of the user data of
+  /// each submission queue entry.
+  enum Request_Kind
+  {
+    /// Internal request (poll, cancel); its completion is ignored.
+    URING_INTERNAL = 0,
+    /// Read or write of an aiocb based result.
+    URING_IO = 1,
+    /// Result posted through post_completion().
+    URING_POSTED = 2,
+    /// Native accept.
+    URING_ACCEPT = 3,
+    /// Native connect.
+    URING_CONNECT = 4,
+    /// Wait for a non-blocking connect to finish.
+    URING_CONNECT_WAIT = 5,
+
+    URING_KIND_MASK = 7
+  };
+
+  /// Reaped completion: the user data and the result of a CQE.
+  struct Completion
+  {
+    ACE_UINT64 user_data_;
+    int res_;
+  };
+
+  /// Create the ring and map its shared memory.
+  int open_ring (unsigned int entries);
+
+  /// Unmap the ring and close its file descriptor.
+  void close_ring ();
+
+  /// Dispatch a single set of events, waiting up to @a timeout (0
+  /// means indefinitely).
+  int handle_events_i (const ACE_Time_Value *timeout);
+
+  /// Block until at least one completion is available or @a timeout
+  /// elapses.  Returns 1, 0 on timeout, -1 on errors.
+  int wait_i (const ACE_Time_Value *timeout);
+
+  /// Copy up to @a max completions to @a batch and release their
+  /// ring slots.  Must be called with <mutex_> held.
+  size_t reap_i (Completion batch[], size_t max);
+
+  /// Dispatch one reaped completion to its result.
+  void dispatch_i (const Completion &c);
+
+  /// Get the next free submission queue entry, making sure that at
+  /// least @a count entries are available and flushing the ring if
+  /// needed.  Must be called with <mutex_> held.  Returns 0 and sets
+  /// errno to EAGAIN if no entry can be obtained.
+  io_uring_sqe *get_sqe_i (unsigned int count);
+
+  /// Fill @a sqe with the request of the given @a kind for @a result.
+  void prepare_i (io_uring_sqe *sqe,
+                  ACE_POSIX_Asynch_Result *result,
+                  Request_Kind kind);
+
+  /// Queue the request for @a result of the given @a kind on the
+  /// ring, submitting it immediately unless a dispatching thread
+  /// will flush it.  Must be called with <mutex_> held.
+  int queue_i (ACE_POSIX_Asynch_Result *result, Request_Kind kind);
+
+  /// Lock the proactor and queue the request.
+  int start_request (ACE_POSIX_Asynch_Result *result, Request_Kind kind);
+
+  /// Handle on which the request for @a result operates.
+  static ACE_HANDLE request_handle (ACE_POSIX_Asynch_Result *result,
+                                    Request_Kind kind);
+
+  /// Queue a read/write/accept/connect of @a result behind a poll on
+  /// its handle; used when the handle is in non-blocking mode and the
+  /// first attempt reported EAGAIN.
+  int requeue_after_poll (ACE_POSIX_Asynch_Result *result,
+                          Request_Kind kind,
+                          short events);
+
+  /// Hand all queued submission entries to the kernel.  Must be
+  /// called with <mutex_> held.
+  int flush_i ();
+
+  /// Bookkeeping of the outstanding operations per handle.
+  void track_i (ACE_HANDLE h);
+  void untrack_i (ACE_HANDLE h);
+
+  /// File descriptor of the ring.
+  ACE_HANDLE ring_fd_;
+
+  /// Mapped areas of the submission ring, completion ring and
+  /// submission queue entries.
+  void *sq_ring_;
+  size_t sq_ring_size_;
+  void *cq_ring_;
+  size_t cq_ring_size_;
+  io_uring_sqe *sqes_;
+  size_t sqes_size_;
+
+  /// Pointers into the submission ring.
+  unsigned int *sq_head_;
+  unsigned int *sq_tail_;
+  unsigned int *sq_mask_;
+  unsigned int *sq_entries_;
+  unsigned int *sq_array_;
+
+  /// Pointers into the completion ring.
+  unsigned int *cq_head_;
+  unsigned int *cq_tail_;
+  unsigned int *cq_mask_;
+  io_uring_cqe *cqes_;
+
+  /// Features reported by the kernel when the ring was created.
+  unsigned int features_;
+
+  /// Local copy of the submission tail and number of entries not yet
+  /// handed to the kernel.
+  unsigned int sq_local_tail_;
+  unsigned int to_submit_;
+
+  /// Number of threads currently dispatching a batch of completions.
+  /// While non-zero, submissions are deferred to the end of the batch.
+  size_t dispatching_;
+
+  /// Total number of operations submitted but not yet completed.
+  size_t outstanding_;
+
+  /// Number of outstanding operations indexed by handle.
+  ACE_Array_Base<size_t> outstanding_per_handle_;
+
+  /// Protects both rings and the bookkeeping above.
+  ACE_SYNCH_MUTEX mutex_;
+};
+
+/**
+ * @class ACE_Uring_Asynch_Accept
+ *
+ * @brief Asynchronous accept issued as an io_uring accept request.
+ */
+class ACE_Export ACE_Uring_Asynch_Accept :
+  public virtual ACE_Asynch_Accept_Impl,
+  public ACE_POSIX_Asynch_Operation
+{
+public:
+  /// Constructor.
+  ACE_Uring_Asynch_Accept (ACE_Uring_Proactor *uring_proactor);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Asynch_Accept ();
+
+  /**
+   * Start an asynchronous accept on the listen handle.  The
+   * @a accept_handle argument is ignored; the kernel creates the
+   * handle of the new connection.  As with the other POSIX
+   * implementations no initial data is read.
+   */
+  int accept (ACE_Message_Block &message_block,
+              size_t bytes_to_read,
+              ACE_HANDLE accept_handle,
+              const void *act,
+              int priority,
+              int signal_number = 0,
+              int addr_family = AF_INET);
+};
+
+/**
+ * @class ACE_Uring_Asynch_Connect
+ *
+ * @brief Asynchronous connect issued as an io_uring connect request.
+ */
+class ACE_Export ACE_Uring_Asynch_Connect :
+  public virtual ACE_Asynch_Connect_Impl,
+  public ACE_POSIX_Asynch_Operation
+{
+public:
+  /// Constructor.
+  ACE_Uring_Asynch_Connect (ACE_Uring_Proactor *uring_proactor);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Asynch_Connect ();
+
+  /**
+   * This belongs to ACE_POSIX_Asynch_Operation.  The handle passed
+   * here is not used; connect handles are given per operation.
+   */
+  int open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+            ACE_HANDLE handle,
+            const void *completion_key,
+            ACE_Proactor *proactor = 0);
+
+  /**
+   * Start an asynchronous connect.  If @a connect_handle is
+   * ACE_INVALID_HANDLE a new stream socket is created.  The handle
+   * is switched to blocking mode so that the ring can complete the
+   * connect and the following stream operations without polling.
+   */
+  int connect (ACE_HANDLE connect_handle,
+               const ACE_Addr &remote_sap,
+               const ACE_Addr &local_sap,
+               int reuse_addr,
+               const void *act,
+               int priority,
+               int signal_number = 0);
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_URING_PROACTOR_H */
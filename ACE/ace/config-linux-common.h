@@ -247,4 +247,11 @@
 #  define ACE_HAS_GETTID // See ACE_OS::thr_gettid()
 #endif
 
+// eventfd(2) with the EFD_NONBLOCK and EFD_CLOEXEC flags.
+#if !defined (ACE_HAS_EVENTFD)
+#  if (LINUX_VERSION_CODE >= KERNEL_VERSION (2,6,27))
+#    define ACE_HAS_EVENTFD
+#  endif
+#endif
+
 #endif /* ACE_CONFIG_LINUX_COMMON_H */
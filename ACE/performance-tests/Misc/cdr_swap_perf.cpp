@@ -0,0 +1,159 @@
+// This program measures the throughput of the ACE_CDR::swap_XX_array
+// routines, used by ACE_InputCDR to demarshal arrays sent by a peer of
+// the other byte order, with each byte swapping kernel available on
+// this machine.
+
+#include "ace/CDR_Base.h"
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+static const size_t DEFAULT_BYTES = 64 * 1024;
+static const int DEFAULT_ITERATIONS = 20000;
+
+typedef void (*swap_func) (char const *, char *, size_t);
+
+static const struct
+{
+  size_t size;
+  swap_func swap;
+} widths[] =
+  {
+    { 2, ACE_CDR::swap_2_array },
+    { 4, ACE_CDR::swap_4_array },
+    { 8, ACE_CDR::swap_8_array },
+    { 16, ACE_CDR::swap_16_array }
+  };
+
+static const struct
+{
+  ACE_CDR::Swap_Kernel kernel;
+  const ACE_TCHAR *name;
+} kernels[] =
+  {
+    { ACE_CDR::SWAP_KERNEL_SCALAR, ACE_TEXT ("scalar") },
+    { ACE_CDR::SWAP_KERNEL_SSE2, ACE_TEXT ("SSE2") },
+    { ACE_CDR::SWAP_KERNEL_AVX2, ACE_TEXT ("AVX2") },
+    { ACE_CDR::SWAP_KERNEL_NEON, ACE_TEXT ("NEON") }
+  };
+
+static void
+print_usage (const ACE_TCHAR *name)
+{
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("usage: %s [-b bytes] [-i iterations] [-o offset]\n")
+              ACE_TEXT ("  -b: size of the swapped array in bytes [%B]\n")
+              ACE_TEXT ("  -i: number of times each array is swapped [%d]\n")
+              ACE_TEXT ("  -o: misalign the source and target buffers")
+              ACE_TEXT (" by this many bytes [0]\n"),
+              name,
+              DEFAULT_BYTES,
+              DEFAULT_ITERATIONS));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  size_t bytes = DEFAULT_BYTES;
+  int iterations = DEFAULT_ITERATIONS;
+  size_t offset = 0;
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("b:i:o:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'b':
+        bytes = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'i':
+        iterations = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'o':
+        offset = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10) % 16;
+        break;
+      default:
+        print_usage (argv[0]);
+        return 1;
+      }
+
+  // Keep whole 16 byte elements.
+  bytes = (bytes + 15) & ~static_cast<size_t> (15);
+  if (bytes == 0 || iterations <= 0)
+    {
+      print_usage (argv[0]);
+      return 1;
+    }
+
+  char *source = 0;
+  char *target = 0;
+  ACE_NEW_RETURN (source, char[bytes + ACE_CDR::MAX_ALIGNMENT + 16], 1);
+  ACE_NEW_RETURN (target, char[bytes + ACE_CDR::MAX_ALIGNMENT + 16], 1);
+
+  char *src = ACE_ptr_align_binary (source, ACE_CDR::MAX_ALIGNMENT) + offset;
+  char *dst = ACE_ptr_align_binary (target, ACE_CDR::MAX_ALIGNMENT) + offset;
+  for (size_t i = 0; i < bytes; ++i)
+    src[i] = static_cast<char> (i);
+  ACE_OS::memset (dst, 0, bytes);
+
+  ACE_CDR::Swap_Kernel const default_kernel = ACE_CDR::swap_kernel ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Swapping %B bytes %d times, offset %B\n")
+              ACE_TEXT ("%-8s %12s %12s %12s %12s\n"),
+              bytes,
+              iterations,
+              offset,
+              ACE_TEXT ("kernel"),
+              ACE_TEXT ("2 (GB/s)"),
+              ACE_TEXT ("4 (GB/s)"),
+              ACE_TEXT ("8 (GB/s)"),
+              ACE_TEXT ("16 (GB/s)")));
+
+  for (size_t k = 0; k < sizeof (kernels) / sizeof (kernels[0]); ++k)
+    {
+      if (ACE_CDR::swap_kernel (kernels[k].kernel) == -1)
+        continue;
+
+      double rate[sizeof (widths) / sizeof (widths[0])];
+
+      for (size_t w = 0; w < sizeof (widths) / sizeof (widths[0]); ++w)
+        {
+          size_t const n = bytes / widths[w].size;
+
+          // Warm up the caches and the branch predictors.
+          widths[w].swap (src, dst, n);
+
+          ACE_High_Res_Timer timer;
+          timer.start ();
+          for (int i = 0; i < iterations; ++i)
+            widths[w].swap (src, dst, n);
+          timer.stop ();
+
+          ACE_hrtime_t usecs;
+          timer.elapsed_microseconds (usecs);
+          rate[w] = usecs == 0
+            ? 0.0
+            : static_cast<double> (bytes) * iterations
+                / static_cast<double> (usecs) / 1000.0;
+        }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%-8s %12.2f %12.2f %12.2f %12.2f\n"),
+                  kernels[k].name,
+                  rate[0],
+                  rate[1],
+                  rate[2],
+                  rate[3]));
+    }
+
+  ACE_CDR::swap_kernel (default_kernel);
+
+  delete [] source;
+  delete [] target;
+  return 0;
+}
@@ -0,0 +1,229 @@
+// This program measures what an ACELIB_DEBUG call costs the thread
+// that makes it, when ACE_Log_Msg writes the records to a file itself
+// and when an ACE_Log_Msg_Async backend writes them from its own
+// thread.  Several threads log at once, as the threads of an ORB
+// running with a high debug level do.
+//
+// The time a caller spends in ACELIB_DEBUG includes the time other
+// threads, the drain thread included, run while it is preempted, so
+// when threads outnumber the CPUs the CPU time of the callers is
+// reported too.
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Category.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Lib_Find.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_time.h"
+
+// FUZZ: disable check_for_streams_include
+#include "ace/streams.h"
+
+#include <atomic>
+
+#if defined (ACE_HAS_THREADS) && !defined (ACE_LACKS_IOSTREAM_TOTALLY)
+
+static const int DEFAULT_MESSAGES = 100000;
+static const int DEFAULT_THREADS = 4;
+static const size_t DEFAULT_BUFFER_KB = 4096;
+
+static int messages = DEFAULT_MESSAGES;
+
+/// Nanoseconds spent in ACELIB_DEBUG by all the threads of a run,
+/// and CPU time they used.
+static std::atomic<ACE_UINT64> caller_nsecs;
+static std::atomic<ACE_UINT64> caller_cpu_nsecs;
+
+/// CPU time used by the calling thread, in nanoseconds, or 0 if the
+/// platform can't tell.
+static ACE_UINT64
+thread_cpu_time ()
+{
+#if defined (ACE_HAS_CLOCK_GETTIME) && defined (CLOCK_THREAD_CPUTIME_ID)
+  timespec ts;
+  if (ACE_OS::clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    return static_cast<ACE_UINT64> (ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif /* ACE_HAS_CLOCK_GETTIME && CLOCK_THREAD_CPUTIME_ID */
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+logger (void *)
+{
+  ACE_High_Res_Timer timer;
+  ACE_UINT64 const cpu_start = thread_cpu_time ();
+
+  timer.start ();
+  for (int i = 0; i < messages; ++i)
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%t) request %d of %d handled in %s\n"),
+                   i,
+                   messages,
+                   ACE_TEXT ("log_msg_perf")));
+  timer.stop ();
+
+  caller_cpu_nsecs += thread_cpu_time () - cpu_start;
+
+  ACE_hrtime_t nsecs;
+  timer.elapsed_time (nsecs);
+  caller_nsecs += nsecs;
+  return 0;
+}
+
+/// Run @a threads loggers and report the cost of a call for them and
+/// the time until every record is written.
+static void
+measure (const ACE_TCHAR *name, int threads, ACE_Log_Msg_Async *async)
+{
+  caller_nsecs = 0;
+  caller_cpu_nsecs = 0;
+
+  ACE_High_Res_Timer total;
+  total.start ();
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (threads, logger) == -1)
+    return;
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (async != 0)
+    async->flush ();
+
+  total.stop ();
+
+  ACE_hrtime_t total_nsecs;
+  total.elapsed_time (total_nsecs);
+
+  double const calls = static_cast<double> (threads) * messages;
+  double const per_call = static_cast<double> (caller_nsecs.load ()) / calls;
+  double const cpu_per_call =
+    static_cast<double> (caller_cpu_nsecs.load ()) / calls;
+  double const per_record = static_cast<double> (total_nsecs) / calls;
+  size_t const dropped = async != 0 ? async->dropped () : 0;
+
+  // Results go to stderr, the records to the file.
+  ACE_OS::fprintf (stderr,
+                   "%-8s %14.1f %14.1f %16.1f %10lu\n",
+                   ACE_TEXT_ALWAYS_CHAR (name),
+                   per_call,
+                   cpu_per_call,
+                   per_record,
+                   static_cast<unsigned long> (dropped));
+}
+
+static void
+print_usage (const ACE_TCHAR *name)
+{
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("usage: %s [-n messages] [-t threads] [-b KB] ")
+              ACE_TEXT ("[-f file]\n")
+              ACE_TEXT ("  -n: records logged by each thread [%d]\n")
+              ACE_TEXT ("  -t: number of threads logging [%d]\n")
+              ACE_TEXT ("  -b: buffer of the asynchronous backend, in KB [%B]\n")
+              ACE_TEXT ("  -f: file the records are written to ")
+              ACE_TEXT ("[log_msg_perf.log in the temporary directory]\n"),
+              name,
+              DEFAULT_MESSAGES,
+              DEFAULT_THREADS,
+              DEFAULT_BUFFER_KB));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int threads = DEFAULT_THREADS;
+  size_t buffer_kb = DEFAULT_BUFFER_KB;
+  ACE_TCHAR filename[MAXPATHLEN + 1];
+
+  if (ACE::get_temp_dir (filename, MAXPATHLEN - 16) == -1)
+    filename[0] = 0;
+  ACE_OS::strcat (filename, ACE_TEXT ("log_msg_perf.log"));
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:t:b:f:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        messages = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 't':
+        threads = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'b':
+        buffer_kb = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'f':
+        ACE_OS::strncpy (filename, get_opt.opt_arg (), MAXPATHLEN);
+        filename[MAXPATHLEN] = 0;
+        break;
+      default:
+        print_usage (argv[0]);
+        return 1;
+      }
+
+  if (messages <= 0 || threads <= 0 || buffer_kb == 0)
+    {
+      print_usage (argv[0]);
+      return 1;
+    }
+
+  ofstream file (ACE_TEXT_ALWAYS_CHAR (filename), ios::out | ios::trunc);
+  if (file.rdstate () != ios::goodbit)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("cannot open %s\n"),
+                       filename),
+                      1);
+
+  ACE_OS::fprintf (stderr,
+                   "%d threads logging %d records each to %s\n"
+                   "%-8s %14s %14s %16s %10s\n",
+                   threads,
+                   messages,
+                   ACE_TEXT_ALWAYS_CHAR (filename),
+                   "backend",
+                   "ns per call",
+                   "CPU ns/call",
+                   "ns per record",
+                   "dropped");
+
+  // ACE_Log_Msg formats and writes the records in the calling thread.
+  ACE_LOG_MSG->msg_ostream (&file, false);
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::STDERR);
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::OSTREAM | ACE_Log_Msg::VERBOSE_LITE);
+  measure (ACE_TEXT ("sync"), threads, 0);
+
+  // The callers only queue the records.
+  ACE_Log_Msg_Async async (buffer_kb * 1024);
+  async.msg_ostream (&file);
+  async.flags (ACE_Log_Msg::OSTREAM | ACE_Log_Msg::VERBOSE_LITE);
+  ACE_Log_Msg_Backend *old_backend = ACE_Log_Msg::msg_backend (&async);
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::OSTREAM);
+  ACE_LOG_MSG->open (argv[0], ACE_Log_Msg::CUSTOM | ACE_Log_Msg::VERBOSE_LITE);
+  measure (ACE_TEXT ("async"), threads, &async);
+
+  ACE_Log_Msg::msg_backend (old_backend);
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::STDERR);
+  async.close ();
+  ACE_LOG_MSG->msg_ostream (0, false);
+
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     ACE_TEXT ("threads and iostreams are required\n")),
+                    1);
+}
+
+#endif /* ACE_HAS_THREADS && !ACE_LACKS_IOSTREAM_TOTALLY */
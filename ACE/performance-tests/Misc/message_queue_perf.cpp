@@ -0,0 +1,213 @@
+// This program measures the throughput of ACE_Message_Queue<ACE_MT_SYNCH>
+// and ACE_Message_Queue_Lockfree<ACE_MT_SYNCH> with the same number of
+// producer and consumer threads, doubling that number from 1 up to the
+// maximum given with -t.
+
+#include "ace/Message_Queue.h"
+#include "ace/Message_Queue_Lockfree_T.h"
+#include "ace/Message_Block.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <atomic>
+
+#if defined (ACE_HAS_THREADS)
+
+static const int DEFAULT_MESSAGES = 1000000;
+static const int DEFAULT_MAX_THREADS = 64;
+static const size_t DEFAULT_CAPACITY = 4096;
+
+typedef ACE_Message_Queue<ACE_MT_SYNCH> LOCKED_QUEUE;
+typedef ACE_Message_Queue_Lockfree<ACE_MT_SYNCH> LOCKFREE_QUEUE;
+
+/// What the producers and consumers of one run share.
+struct Run
+{
+  ACE_Message_Queue<ACE_MT_SYNCH> *queue_;
+  ACE_Message_Block *blocks_;
+  int messages_per_producer_;
+  std::atomic<int> next_producer_;
+  std::atomic<long> consumed_;
+};
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  Run *run = static_cast<Run *> (arg);
+  int const id = run->next_producer_++;
+  ACE_Message_Block *blocks =
+    run->blocks_ + static_cast<size_t> (id) * run->messages_per_producer_;
+
+  // The blocks are preallocated so that only the queue is measured.
+  for (int i = 0; i < run->messages_per_producer_; ++i)
+    if (run->queue_->enqueue_tail (&blocks[i]) == -1)
+      break;
+
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+consumer (void *arg)
+{
+  Run *run = static_cast<Run *> (arg);
+  ACE_Message_Block *mb = 0;
+
+  while (run->queue_->dequeue_head (mb) != -1)
+    ++run->consumed_;
+
+  return 0;
+}
+
+/// Return the messages per second moved through @a queue by @a threads
+/// producers and as many consumers.
+static double
+measure (ACE_Message_Queue<ACE_MT_SYNCH> &queue,
+         ACE_Message_Block *blocks,
+         int threads,
+         int messages)
+{
+  Run run;
+  run.queue_ = &queue;
+  run.blocks_ = blocks;
+  run.messages_per_producer_ = messages / threads;
+  run.next_producer_ = 0;
+  run.consumed_ = 0;
+
+  long const total =
+    static_cast<long> (run.messages_per_producer_) * threads;
+
+  ACE_Thread_Manager tm;
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  if (tm.spawn_n (threads, consumer, &run) == -1
+      || tm.spawn_n (threads, producer, &run) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")));
+      queue.deactivate ();
+      tm.wait ();
+      return 0.0;
+    }
+
+  while (run.consumed_.load () < total)
+    ACE_OS::thr_yield ();
+
+  timer.stop ();
+
+  // Release the consumers waiting for more.
+  queue.deactivate ();
+  tm.wait ();
+  queue.activate ();
+
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  return usecs == 0
+    ? 0.0
+    : static_cast<double> (total) * 1000000.0 / static_cast<double> (usecs);
+}
+
+static void
+print_usage (const ACE_TCHAR *name)
+{
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("usage: %s [-n messages] [-t max threads] ")
+              ACE_TEXT ("[-c capacity]\n")
+              ACE_TEXT ("  -n: messages per run [%d]\n")
+              ACE_TEXT ("  -t: largest number of producers, and of ")
+              ACE_TEXT ("consumers [%d]\n")
+              ACE_TEXT ("  -c: ring capacity of the lock-free queue [%B]\n"),
+              name,
+              DEFAULT_MESSAGES,
+              DEFAULT_MAX_THREADS,
+              DEFAULT_CAPACITY));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int messages = DEFAULT_MESSAGES;
+  int max_threads = DEFAULT_MAX_THREADS;
+  size_t capacity = DEFAULT_CAPACITY;
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:t:c:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        messages = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 't':
+        max_threads = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'c':
+        capacity = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      default:
+        print_usage (argv[0]);
+        return 1;
+      }
+
+  if (messages <= 0 || max_threads <= 0 || capacity == 0)
+    {
+      print_usage (argv[0]);
+      return 1;
+    }
+
+  ACE_Message_Block *blocks = 0;
+  ACE_NEW_RETURN (blocks, ACE_Message_Block[messages], 1);
+
+  // Empty blocks never reach the high water mark, both queues only
+  // block when empty or, for the lock-free one, when the ring is full.
+  LOCKED_QUEUE locked;
+  LOCKFREE_QUEUE lockfree (ACE_Message_Queue_Base::DEFAULT_HWM,
+                           ACE_Message_Queue_Base::DEFAULT_LWM,
+                           0,
+                           capacity);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d messages per run, ring of %B slots\n")
+              ACE_TEXT ("%8s %16s %16s %8s\n"),
+              messages,
+              lockfree.capacity (),
+              ACE_TEXT ("threads"),
+              ACE_TEXT ("locked (msg/s)"),
+              ACE_TEXT ("lock-free (msg/s)"),
+              ACE_TEXT ("speedup")));
+
+  for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+      double const locked_rate = measure (locked, blocks, threads, messages);
+      double const lockfree_rate =
+        measure (lockfree, blocks, threads, messages);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%8d %16.0f %16.0f %8.2f\n"),
+                  threads,
+                  locked_rate,
+                  lockfree_rate,
+                  locked_rate > 0.0 ? lockfree_rate / locked_rate : 0.0));
+    }
+
+  // Every run drains the queues, they hold no block now.
+  delete [] blocks;
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     ACE_TEXT ("threads not supported on this platform\n")),
+                    1);
+}
+
+#endif /* ACE_HAS_THREADS */
@@ -0,0 +1,246 @@
+// This program measures ACE_Timer_Heap, ACE_Timer_Wheel and
+// ACE_Timer_Hierarchical_Wheel with the workload of
+// tests/Timer_Queue_Test.cpp scaled to millions of timers spread over
+// a long horizon: schedule them all, cancel most of them in random
+// order, as idle and retry timers are, then expire the others while
+// the time moves forward in small steps.
+
+#include "ace/Timer_Heap_T.h"
+#include "ace/Timer_Wheel_T.h"
+#include "ace/Timer_Hierarchical_Wheel_T.h"
+#include "ace/Event_Handler_Handle_Timeout_Upcall.h"
+#include "ace/Event_Handler.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+static const int DEFAULT_TIMERS = 1000000;
+static const int DEFAULT_HORIZON = 3600;
+static const int DEFAULT_CANCEL_PERCENT = 90;
+static const int DEFAULT_STEP = 10;
+
+// No locking, only the data structures are measured.
+typedef ACE_Timer_Heap_T<ACE_Event_Handler *,
+                         ACE_Event_Handler_Handle_Timeout_Upcall,
+                         ACE_Null_Mutex> HEAP;
+typedef ACE_Timer_Wheel_T<ACE_Event_Handler *,
+                          ACE_Event_Handler_Handle_Timeout_Upcall,
+                          ACE_Null_Mutex> WHEEL;
+typedef ACE_Timer_Hierarchical_Wheel_T<ACE_Event_Handler *,
+                                       ACE_Event_Handler_Handle_Timeout_Upcall,
+                                       ACE_Null_Mutex> HIERARCHICAL_WHEEL;
+typedef ACE_Timer_Queue_T<ACE_Event_Handler *,
+                          ACE_Event_Handler_Handle_Timeout_Upcall,
+                          ACE_Null_Mutex> QUEUE;
+
+class Counting_Handler : public ACE_Event_Handler
+{
+public:
+  Counting_Handler () : count_ (0) {}
+
+  int handle_timeout (const ACE_Time_Value &, const void *) override
+  {
+    ++this->count_;
+    return 0;
+  }
+
+  long count_;
+};
+
+/// Return the nanoseconds per operation measured by @a timer.
+static double
+per_op (ACE_High_Res_Timer &timer, long ops)
+{
+  ACE_hrtime_t nsecs;
+  timer.elapsed_time (nsecs);
+  return ops == 0 ? 0.0 : static_cast<double> (nsecs) / ops;
+}
+
+static void
+measure (QUEUE &queue,
+         const ACE_TCHAR *name,
+         const ACE_Time_Value *times,
+         const int *order,
+         long *ids,
+         int timers,
+         int cancel_percent,
+         const ACE_Time_Value &step)
+{
+  Counting_Handler handler;
+  ACE_High_Res_Timer timer;
+
+  timer.start ();
+  for (int i = 0; i < timers; ++i)
+    ids[i] = queue.schedule (&handler, 0, times[i]);
+  timer.stop ();
+  double const schedule_ns = per_op (timer, timers);
+
+  int const cancels =
+    static_cast<int> (static_cast<long long> (timers) * cancel_percent / 100);
+
+  timer.start ();
+  for (int i = 0; i < cancels; ++i)
+    queue.cancel (ids[order[i]]);
+  timer.stop ();
+  double const cancel_ns = per_op (timer, cancels);
+
+  // Move the time forward until every timer left has expired.
+  ACE_Time_Value now = times[0];
+  for (int i = 1; i < timers; ++i)
+    if (times[i] < now)
+      now = times[i];
+
+  long expire_calls = 0;
+  timer.start ();
+  while (!queue.is_empty ())
+    {
+      now += step;
+      queue.expire (now);
+      ++expire_calls;
+    }
+  timer.stop ();
+  long const expired = handler.count_;
+  double const expire_ns = per_op (timer, expired);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-20s %12.1f %12.1f %12.1f %10d %10d\n"),
+              name,
+              schedule_ns,
+              cancel_ns,
+              expire_ns,
+              expired,
+              expire_calls));
+}
+
+static void
+print_usage (const ACE_TCHAR *name)
+{
+  ACE_ERROR ((LM_ERROR,
+              ACE_TEXT ("usage: %s [-n timers] [-h horizon] [-c percent] ")
+              ACE_TEXT ("[-s step] [-q queues]\n")
+              ACE_TEXT ("  -n: number of timers [%d]\n")
+              ACE_TEXT ("  -h: timers are spread over this many seconds [%d]\n")
+              ACE_TEXT ("  -c: percentage of the timers cancelled [%d]\n")
+              ACE_TEXT ("  -s: milliseconds between two expire() calls [%d]\n")
+              ACE_TEXT ("  -q: queues to measure, any of h (heap), w (wheel) ")
+              ACE_TEXT ("and x (hierarchical wheel) [hwx]\n"),
+              name,
+              DEFAULT_TIMERS,
+              DEFAULT_HORIZON,
+              DEFAULT_CANCEL_PERCENT,
+              DEFAULT_STEP));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int timers = DEFAULT_TIMERS;
+  int horizon = DEFAULT_HORIZON;
+  int cancel_percent = DEFAULT_CANCEL_PERCENT;
+  int step = DEFAULT_STEP;
+  const ACE_TCHAR *queues = ACE_TEXT ("hwx");
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:h:c:s:q:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        timers = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'h':
+        horizon = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'c':
+        cancel_percent = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 's':
+        step = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'q':
+        queues = get_opt.opt_arg ();
+        break;
+      default:
+        print_usage (argv[0]);
+        return 1;
+      }
+
+  if (timers <= 0 || horizon <= 0 || step <= 0
+      || cancel_percent < 0 || cancel_percent > 100)
+    {
+      print_usage (argv[0]);
+      return 1;
+    }
+
+  ACE_Time_Value *times = 0;
+  int *order = 0;
+  long *ids = 0;
+  ACE_NEW_RETURN (times, ACE_Time_Value[timers], 1);
+  ACE_NEW_RETURN (order, int[timers], 1);
+  ACE_NEW_RETURN (ids, long[timers], 1);
+
+  // The same random expiration times and cancellation order for every
+  // queue.
+  ACE_Time_Value const start = ACE_OS::gettimeofday ();
+  for (int i = 0; i < timers; ++i)
+    {
+      long long const usecs =
+        static_cast<long long> (ACE_OS::rand ()) * ACE_OS::rand ()
+        % (static_cast<long long> (horizon) * 1000000);
+      ACE_Time_Value offset;
+      offset.set_msec (usecs / 1000);
+      times[i] = start + offset + ACE_Time_Value (0, usecs % 1000);
+      order[i] = i;
+    }
+  for (int i = timers - 1; i > 0; --i)
+    {
+      int const j = ACE_OS::rand () % (i + 1);
+      int const tmp = order[i];
+      order[i] = order[j];
+      order[j] = tmp;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d timers over %d s, %d%% cancelled, ")
+              ACE_TEXT ("expire() every %d ms\n")
+              ACE_TEXT ("%-20s %12s %12s %12s %10s %10s\n"),
+              timers, horizon, cancel_percent, step,
+              ACE_TEXT ("queue"),
+              ACE_TEXT ("schedule ns"),
+              ACE_TEXT ("cancel ns"),
+              ACE_TEXT ("expire ns"),
+              ACE_TEXT ("expired"),
+              ACE_TEXT ("calls")));
+
+  ACE_Time_Value const step_time (0, step * 1000);
+
+  if (ACE_OS::strchr (queues, ACE_TEXT ('h')) != 0)
+    {
+      HEAP heap;
+      measure (heap, ACE_TEXT ("ACE_Timer_Heap"),
+               times, order, ids, timers, cancel_percent, step_time);
+    }
+
+  if (ACE_OS::strchr (queues, ACE_TEXT ('w')) != 0)
+    {
+      WHEEL wheel;
+      measure (wheel, ACE_TEXT ("ACE_Timer_Wheel"),
+               times, order, ids, timers, cancel_percent, step_time);
+    }
+
+  if (ACE_OS::strchr (queues, ACE_TEXT ('x')) != 0)
+    {
+      HIERARCHICAL_WHEEL hierarchical_wheel;
+      measure (hierarchical_wheel, ACE_TEXT ("ACE_Timer_Hier_Wheel"),
+               times, order, ids, timers, cancel_percent, step_time);
+    }
+
+  delete [] times;
+  delete [] order;
+  delete [] ids;
+  return 0;
+}
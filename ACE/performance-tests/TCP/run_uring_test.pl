@@ -0,0 +1,37 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+foreach $type ("d", "u") {
+    print "\n*** tcp_uring_test -r $type\n";
+
+    $SV = new PerlACE::Process ("tcp_uring_test", "-s -r $type -n 1000 -t 4");
+    $CL = new PerlACE::Process ("tcp_uring_test", "-c -n 1000 -i 1000 localhost");
+
+    $SV->Spawn ();
+
+    sleep 5;
+
+    $client = $CL->SpawnWaitKill (120);
+
+    $server = $SV->WaitKill (10);
+
+    if ($server != 0) {
+        print "ERROR: server returned $server\n";
+        $status = 1;
+    }
+
+    if ($client != 0) {
+        print "ERROR: client returned $client\n";
+        $status = 1;
+    }
+}
+
+exit $status;
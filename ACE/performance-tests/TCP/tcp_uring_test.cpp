@@ -0,0 +1,689 @@
+
+//=============================================================================
+/**
+ *  @file   tcp_uring_test.cpp
+ *
+ * Measures TCP round-trip performance of an echo server handling many
+ * concurrent connections, either through an ACE_Dev_Poll_Reactor or
+ * through an ACE_Uring_Proactor.
+ *
+ * The client opens the requested number of connections and, for each
+ * iteration, sends one message on every connection before collecting
+ * all the echoes.  The server stops once every connection it accepted
+ * has been closed by the client.
+ */
+//=============================================================================
+
+
+#include "ace/Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Proactor.h"
+#include "ace/Uring_Proactor.h"
+#include "ace/Asynch_IO.h"
+#include "ace/Asynch_Acceptor.h"
+#include "ace/Message_Block.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/INET_Addr.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Stats.h"
+#include "ace/Throughput_Stats.h"
+#include "ace/Sample_History.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/os_include/netinet/os_tcp.h"
+
+// Global variables (evil).
+static const u_short DEFPORT = 5050;
+static const int MAXPKTSZ = 65536;
+static const int DEFPKTSZ = 64;
+static const int DEFITERATIONS = 1000;
+static const int DEFCONNECTIONS = 100;
+static const int DEFBACKLOG = 1024;
+
+static int bufsz = DEFPKTSZ;
+static int VERBOSE = 0;
+static int dump_history = 0;
+static int svr_thrno = 1;
+static int server = 0;
+static int client = 0;
+static int nsamples = DEFITERATIONS;
+static int nconnections = DEFCONNECTIONS;
+static int backlog = DEFBACKLOG;
+static int server_type = 0;
+
+enum {
+  DEV_POLL = 1,
+  URING
+};
+
+/// Number of connections closed so far by the server.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> closed_connections (0);
+
+static void
+usage ()
+{
+  ACE_ERROR ((LM_ERROR,
+              "tcp_uring_test\n"
+              "  [-v]          (Verbose)\n"
+              "  [-h] (dump all the samples)\n"
+              "  [-m message size]\n"
+              "  [-i iterations]\n"
+              "  [-n number of connections]\n"
+              "  [-l listen backlog]\n"
+              "  [-p port]\n"
+              "  [-s]\n"
+              "  [-c]\n"
+              "  [-t number of server threads]\n"
+              "  [-r d to use the ACE Dev_Poll reactor (default)]\n"
+              "  [-r u to use the ACE Uring proactor]\n"
+              "  targethost\n"));
+}
+
+static void
+set_nodelay (ACE_SOCK &sock)
+{
+  int nodelay = 1;
+  sock.set_option (ACE_IPPROTO_TCP,
+                   TCP_NODELAY,
+                   &nodelay,
+                   sizeof nodelay);
+}
+
+// ****************************************************************
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+/// Echoes everything received on one connection.
+class Echo_Handler : public ACE_Event_Handler
+{
+public:
+  Echo_Handler (ACE_Reactor *reactor);
+
+  ACE_SOCK_Stream &peer ();
+
+  // = Override <ACE_Event_Handler> methods.
+  virtual ACE_HANDLE get_handle () const;
+  virtual int handle_input (ACE_HANDLE);
+  virtual int handle_close (ACE_HANDLE handle,
+                            ACE_Reactor_Mask close_mask);
+
+private:
+  ACE_SOCK_Stream endpoint_;
+
+  char buf_[MAXPKTSZ];
+};
+
+Echo_Handler::Echo_Handler (ACE_Reactor *reactor)
+  : ACE_Event_Handler (reactor)
+{
+}
+
+ACE_SOCK_Stream &
+Echo_Handler::peer ()
+{
+  return this->endpoint_;
+}
+
+ACE_HANDLE
+Echo_Handler::get_handle () const
+{
+  return this->endpoint_.get_handle ();
+}
+
+int
+Echo_Handler::handle_input (ACE_HANDLE)
+{
+  ssize_t const n = this->endpoint_.recv (this->buf_, sizeof this->buf_);
+  if (n <= 0)
+    return -1;
+
+  if (this->endpoint_.send_n (this->buf_, n) != n)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "%p\n",
+                       "Echo_Handler::handle_input: send"),
+                      -1);
+  return 0;
+}
+
+int
+Echo_Handler::handle_close (ACE_HANDLE,
+                            ACE_Reactor_Mask)
+{
+  ACE_Reactor *reactor = this->reactor ();
+
+  this->endpoint_.close ();
+  delete this;
+
+  if (++closed_connections == nconnections)
+    reactor->end_reactor_event_loop ();
+
+  return 0;
+}
+
+/// Accepts the connections and registers an Echo_Handler for each.
+class Accept_Handler : public ACE_Event_Handler
+{
+public:
+  Accept_Handler (ACE_Reactor *reactor);
+
+  int open (const ACE_INET_Addr &addr);
+
+  // = Override <ACE_Event_Handler> methods.
+  virtual ACE_HANDLE get_handle () const;
+  virtual int handle_input (ACE_HANDLE);
+
+private:
+  ACE_SOCK_Acceptor acceptor_;
+};
+
+Accept_Handler::Accept_Handler (ACE_Reactor *reactor)
+  : ACE_Event_Handler (reactor)
+{
+}
+
+int
+Accept_Handler::open (const ACE_INET_Addr &addr)
+{
+  if (this->acceptor_.open (addr, 1, PF_INET, backlog) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "open"), -1);
+
+  return this->reactor ()->register_handler (this,
+                                             ACE_Event_Handler::ACCEPT_MASK);
+}
+
+ACE_HANDLE
+Accept_Handler::get_handle () const
+{
+  return this->acceptor_.get_handle ();
+}
+
+int
+Accept_Handler::handle_input (ACE_HANDLE)
+{
+  Echo_Handler *handler = 0;
+  ACE_NEW_RETURN (handler, Echo_Handler (this->reactor ()), -1);
+
+  if (this->acceptor_.accept (handler->peer ()) == -1)
+    {
+      delete handler;
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "Accept_Handler::handle_input %p\n",
+                         "accept failed"),
+                        0);
+    }
+
+  set_nodelay (handler->peer ());
+
+  if (this->reactor ()->register_handler
+      (handler, ACE_Event_Handler::READ_MASK) == -1)
+    {
+      handler->peer ().close ();
+      delete handler;
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ACE_Reactor::register_handler: Echo_Handler\n"),
+                        0);
+    }
+
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+reactor_worker (void *arg)
+{
+  ACE_Reactor *reactor = static_cast<ACE_Reactor *> (arg);
+  reactor->run_reactor_event_loop ();
+  return 0;
+}
+
+static int
+run_dev_poll_server (const ACE_INET_Addr &addr)
+{
+  ACE_Dev_Poll_Reactor *dp = 0;
+  ACE_NEW_RETURN (dp,
+                  ACE_Dev_Poll_Reactor (nconnections + 64),
+                  -1);
+  ACE_Reactor reactor (dp, 1);
+
+  Accept_Handler acceptor (&reactor);
+  if (acceptor.open (addr) == -1)
+    return -1;
+
+  ACE_DEBUG ((LM_DEBUG, "Dev_Poll reactor listening on port %d\n",
+              addr.get_port_number ()));
+
+  ACE_Thread_Manager::instance ()->spawn_n (svr_thrno,
+                                            reactor_worker,
+                                            &reactor);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  reactor.remove_handler (&acceptor,
+                          ACE_Event_Handler::ACCEPT_MASK
+                          | ACE_Event_Handler::DONT_CALL);
+  return 0;
+}
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+// ****************************************************************
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+/// Echoes everything received on one connection, alternating
+/// asynchronous reads and writes.
+class Echo_Service : public ACE_Service_Handler
+{
+public:
+  Echo_Service ();
+
+  virtual ~Echo_Service ();
+
+  // = Override <ACE_Service_Handler> methods.
+  virtual void open (ACE_HANDLE new_handle,
+                     ACE_Message_Block &message_block);
+  virtual void handle_read_stream (const ACE_Asynch_Read_Stream::Result &result);
+  virtual void handle_write_stream (const ACE_Asynch_Write_Stream::Result &result);
+
+private:
+  /// Start reading the next message, or close down on errors.
+  void initiate_read ();
+
+  /// Release the connection.
+  void close ();
+
+  ACE_Asynch_Read_Stream rs_;
+  ACE_Asynch_Write_Stream ws_;
+
+  ACE_Message_Block mb_;
+};
+
+Echo_Service::Echo_Service ()
+  : mb_ (MAXPKTSZ)
+{
+}
+
+Echo_Service::~Echo_Service ()
+{
+  if (this->handle () != ACE_INVALID_HANDLE)
+    ACE_OS::closesocket (this->handle ());
+}
+
+void
+Echo_Service::open (ACE_HANDLE new_handle, ACE_Message_Block &)
+{
+  this->handle (new_handle);
+
+  int nodelay = 1;
+  ACE_OS::setsockopt (new_handle,
+                      ACE_IPPROTO_TCP,
+                      TCP_NODELAY,
+                      reinterpret_cast<const char *> (&nodelay),
+                      sizeof nodelay);
+
+  if (this->rs_.open (*this, new_handle) == -1
+      || this->ws_.open (*this, new_handle) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, "%p\n", "Echo_Service::open"));
+      this->close ();
+      return;
+    }
+
+  this->initiate_read ();
+}
+
+void
+Echo_Service::initiate_read ()
+{
+  this->mb_.reset ();
+  if (this->rs_.read (this->mb_, this->mb_.space ()) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, "%p\n", "Echo_Service::initiate_read"));
+      this->close ();
+    }
+}
+
+void
+Echo_Service::handle_read_stream (const ACE_Asynch_Read_Stream::Result &result)
+{
+  if (!result.success () || result.bytes_transferred () == 0)
+    {
+      this->close ();
+      return;
+    }
+
+  if (this->ws_.write (this->mb_, this->mb_.length ()) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, "%p\n", "Echo_Service::handle_read_stream"));
+      this->close ();
+    }
+}
+
+void
+Echo_Service::handle_write_stream (const ACE_Asynch_Write_Stream::Result &result)
+{
+  if (!result.success ())
+    {
+      this->close ();
+      return;
+    }
+
+  // Finish a partial write before reading again.
+  if (this->mb_.length () > 0)
+    {
+      if (this->ws_.write (this->mb_, this->mb_.length ()) == -1)
+        this->close ();
+      return;
+    }
+
+  this->initiate_read ();
+}
+
+void
+Echo_Service::close ()
+{
+  ACE_Proactor *proactor = this->proactor ();
+
+  delete this;
+
+  if (++closed_connections == nconnections)
+    proactor->proactor_end_event_loop ();
+}
+
+static ACE_THR_FUNC_RETURN
+proactor_worker (void *arg)
+{
+  ACE_Proactor *proactor = static_cast<ACE_Proactor *> (arg);
+  proactor->proactor_run_event_loop ();
+  return 0;
+}
+
+static int
+run_uring_server (const ACE_INET_Addr &addr)
+{
+  ACE_Uring_Proactor *up = 0;
+  ACE_NEW_RETURN (up,
+                  ACE_Uring_Proactor,
+                  -1);
+  ACE_Proactor proactor (up, 1);
+
+  ACE_Asynch_Acceptor<Echo_Service> acceptor;
+  if (acceptor.open (addr,
+                     0,         // bytes_to_read
+                     false,     // pass_addresses
+                     backlog,
+                     1,         // reuse_addr
+                     &proactor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "open"), -1);
+
+  ACE_DEBUG ((LM_DEBUG, "Uring proactor listening on port %d\n",
+              addr.get_port_number ()));
+
+  ACE_Thread_Manager::instance ()->spawn_n (svr_thrno,
+                                            proactor_worker,
+                                            &proactor);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  acceptor.cancel ();
+  return 0;
+}
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+
+// ****************************************************************
+
+static int
+run_server (const ACE_INET_Addr &addr)
+{
+  switch (server_type)
+    {
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+    case DEV_POLL:
+      return run_dev_poll_server (addr);
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+    case URING:
+      return run_uring_server (addr);
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+    default:
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "Selected server type is not supported\n"),
+                        -1);
+    }
+}
+
+static int
+run_client (const ACE_INET_Addr &remote_addr)
+{
+  ACE_SOCK_Stream *endpoints = 0;
+  ACE_NEW_RETURN (endpoints,
+                  ACE_SOCK_Stream[nconnections],
+                  -1);
+
+  int result = 0;
+  ACE_SOCK_Connector connector;
+  int i = 0;
+  for (i = 0; i != nconnections; ++i)
+    {
+      if (connector.connect (endpoints[i], remote_addr) == -1)
+        {
+          ACE_ERROR ((LM_ERROR, "Client - %p\n", "connect failed"));
+          result = -1;
+          break;
+        }
+      set_nodelay (endpoints[i]);
+    }
+
+  char *sbuf = 0;
+  char *rbuf = 0;
+  ACE_NEW_NORETURN (sbuf, char[bufsz]);
+  ACE_NEW_NORETURN (rbuf, char[bufsz]);
+  if (sbuf == 0 || rbuf == 0)
+    result = -1;
+  else
+    {
+      ACE_OS::memset (sbuf, 0, bufsz);
+      ACE_OS::memset (rbuf, 0, bufsz);
+    }
+
+  ACE_Sample_History history (nsamples);
+
+  ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+  for (int j = 0; result == 0 && j != nsamples; ++j)
+    {
+      ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+      for (i = 0; i != nconnections; ++i)
+        if (endpoints[i].send_n (sbuf, bufsz) != bufsz)
+          {
+            ACE_ERROR ((LM_ERROR, "(%P) %p\n", "send"));
+            result = -1;
+            break;
+          }
+
+      for (i = 0; result == 0 && i != nconnections; ++i)
+        if (endpoints[i].recv_n (rbuf, bufsz) != bufsz)
+          {
+            ACE_ERROR ((LM_ERROR, "(%P) %p\n", "get_response"));
+            result = -1;
+          }
+
+      ACE_hrtime_t end = ACE_OS::gethrtime ();
+
+      history.sample (end - start);
+
+      if (VERBOSE && j % 500 == 0)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "Send %d / %d rounds\n", j, nsamples));
+        }
+    }
+  ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+  for (i = 0; i != nconnections; ++i)
+    endpoints[i].close ();
+
+  delete [] endpoints;
+  delete [] sbuf;
+  delete [] rbuf;
+
+  if (result != 0)
+    return result;
+
+  ACE_High_Res_Timer::global_scale_factor_type gsf =
+    ACE_High_Res_Timer::global_scale_factor ();
+
+  if (dump_history)
+    {
+      history.dump_samples (ACE_TEXT("HISTORY"), gsf);
+    }
+
+  // Each sample is a full round over all the connections.
+  ACE_Basic_Stats latency;
+  history.collect_basic_stats (latency);
+  latency.dump_results (ACE_TEXT("Round"), gsf);
+  ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Messages"),
+                                         gsf,
+                                         test_end - test_start,
+                                         latency.samples_count ()
+                                         * nconnections);
+
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int c, dstport = DEFPORT;
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT("hvp:sci:m:n:l:t:r:"));
+
+  while ((c = get_opt ()) != -1)
+    {
+      switch ((char) c)
+        {
+        case 'v':
+          VERBOSE = 1;
+          break;
+
+        case 'h':
+          dump_history = 1;
+          break;
+
+        case 'm':
+          bufsz = ACE_OS::atoi (get_opt.opt_arg ());
+
+          if (bufsz <= 0 || bufsz > MAXPKTSZ)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nMessage size must be in [1, %d]!\n\n",
+                               MAXPKTSZ),
+                              1);
+          break;
+
+        case 'i':
+          nsamples = ACE_OS::atoi (get_opt.opt_arg ());
+          if (nsamples <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nIterations must be greater than 0!\n\n"),
+                              1);
+          break;
+
+        case 'n':
+          nconnections = ACE_OS::atoi (get_opt.opt_arg ());
+          if (nconnections <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nConnections must be greater than 0!\n\n"),
+                              1);
+          break;
+
+        case 'l':
+          backlog = ACE_OS::atoi (get_opt.opt_arg ());
+          if (backlog <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nInvalid listen backlog!\n\n"),
+                              1);
+          break;
+
+        case 'r':
+          switch (*get_opt.opt_arg ())
+            {
+            case 'd':
+              server_type = DEV_POLL;
+              break;
+            case 'u':
+              server_type = URING;
+              break;
+            default:
+              usage ();
+              return 1;
+            }
+          break;
+
+        case 'p':
+          dstport = ACE_OS::atoi (get_opt.opt_arg ());
+          if (dstport <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nInvalid port number!\n\n"),
+                              1);
+          break;
+
+        case 't':
+          svr_thrno = ACE_OS::atoi (get_opt.opt_arg ());
+
+          if (svr_thrno <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nInvalid server thread number!\n\n"),
+                              1);
+          break;
+
+        case 'c':
+          server = 0;
+          client = 1;
+          break;
+        case 's':
+          client = 0;
+          server = 1;
+          break;
+        default:
+          usage ();
+          return 1;
+        }
+    }
+
+  if ((get_opt.opt_ind () >= argc && client != 0) || argc == 1)
+    {
+      usage ();
+      return 1;
+    }
+
+  if (server)
+    {
+      if (server_type == 0)
+        server_type = DEV_POLL;
+
+      ACE_INET_Addr addr (dstport);
+      return run_server (addr) == 0 ? 0 : 1;
+    }
+
+  ACE_INET_Addr remote_addr;
+  if (remote_addr.set (dstport, argv[get_opt.opt_ind ()]) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "invalid IP address: %s\n",
+                       argv[get_opt.opt_ind ()]),
+                      1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              "\nSending %d byte packets on %d connections to %s:%d\n\n",
+              bufsz,
+              nconnections,
+              remote_addr.get_host_name (),
+              dstport));
+
+  return run_client (remote_addr) == 0 ? 0 : 1;
+}
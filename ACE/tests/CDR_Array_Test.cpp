@@ -965,35 +965,64 @@ run_main (int argc, ACE_TCHAR *argv[])
       dtotal = ftotal = qtotal = wtotal = htotal = ctotal = total;
     }
 
-  int use_array;
-  for (use_array = 0; use_array < 2; use_array++)
+  // Check the array routines with every byte swapping kernel
+  // available here, the element-wise path only once.
+  static const ACE_CDR::Swap_Kernel kernels[] = {
+    ACE_CDR::SWAP_KERNEL_SCALAR,
+    ACE_CDR::SWAP_KERNEL_SSE2,
+    ACE_CDR::SWAP_KERNEL_AVX2,
+    ACE_CDR::SWAP_KERNEL_NEON
+  };
+  static const ACE_TCHAR *kernel_names[] = {
+    ACE_TEXT ("scalar"),
+    ACE_TEXT ("SSE2"),
+    ACE_TEXT ("AVX2"),
+    ACE_TEXT ("NEON")
+  };
+
+  ACE_CDR::Swap_Kernel const default_kernel = ACE_CDR::swap_kernel ();
+
+  for (size_t k = 0; k < sizeof (kernels) / sizeof (kernels[0]); ++k)
     {
-      {
-        CDR_Test<ACE_CDR::LongLong, LongLongHelper>
-          test (qtotal, niter, use_array);
-      }
-      {
-        CDR_Test<ACE_CDR::Long, LongHelper>
-          test (wtotal, niter, use_array);
-      }
-      {
-        CDR_Test<ACE_CDR::Short, ShortHelper>
-          test (htotal, niter, use_array);
-      }
-      {
-        CDR_Test<ACE_CDR::Char, CharHelper>
-          test (ctotal, niter, use_array);
-      }
-      {
-        CDR_Test<ACE_CDR::Double, DoubleHelper>
-          test (dtotal, niter, use_array);
-      }
-      {
-        CDR_Test<ACE_CDR::Float, FloatHelper>
-          test (ftotal, niter, use_array);
-      }
+      if (ACE_CDR::swap_kernel (kernels[k]) == -1)
+        continue;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("Byte swapping kernel: %s\n"),
+                  kernel_names[k]));
+
+      // The element-wise path does not depend on the kernel.
+      for (int use_array = k == 0 ? 0 : 1; use_array < 2; use_array++)
+        {
+          {
+            CDR_Test<ACE_CDR::LongLong, LongLongHelper>
+              test (qtotal, niter, use_array);
+          }
+          {
+            CDR_Test<ACE_CDR::Long, LongHelper>
+              test (wtotal, niter, use_array);
+          }
+          {
+            CDR_Test<ACE_CDR::Short, ShortHelper>
+              test (htotal, niter, use_array);
+          }
+          {
+            CDR_Test<ACE_CDR::Char, CharHelper>
+              test (ctotal, niter, use_array);
+          }
+          {
+            CDR_Test<ACE_CDR::Double, DoubleHelper>
+              test (dtotal, niter, use_array);
+          }
+          {
+            CDR_Test<ACE_CDR::Float, FloatHelper>
+              test (ftotal, niter, use_array);
+          }
+        }
     }
 
+  ACE_CDR::swap_kernel (default_kernel);
+
   ACE_END_TEST;
   return 0;
 }
@@ -842,6 +842,82 @@ CDR_Test_Types::test_get_placeholder (ACE_InputCDR &cdr) const
   return 0;
 }
 
+// Large arrays must be chained by reference when a reference threshold
+// is set, and read back the same as if they had been copied.
+static int
+reference_stream ()
+{
+  static const ACE_CDR::ULong LONGS = 200;
+  static const ACE_CDR::ULong OCTETS = 1001;
+
+  ACE_CDR::Long longs[LONGS];
+  ACE_CDR::Octet octets[OCTETS];
+  for (ACE_CDR::ULong i = 0; i < LONGS; ++i)
+    longs[i] = static_cast<ACE_CDR::Long> (i * 3);
+  for (ACE_CDR::ULong i = 0; i < OCTETS; ++i)
+    octets[i] = static_cast<ACE_CDR::Octet> (i);
+
+  ACE_CDR::Short small[4] = { 1, 2, 3, 4 };
+
+  ACE_OutputCDR output (64);
+  output.reference_threshold (256);
+
+  output.write_octet (7);
+  output.write_long_array (longs, LONGS);
+  output.write_ulonglong (42);
+  output.write_short_array (small, 4);
+  output.write_octet_array (octets, OCTETS);
+  output.write_short (-5);
+
+  if (!output.good_bit ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("writing the referenced stream failed\n")),
+                      1);
+
+  bool longs_referenced = false;
+  bool octets_referenced = false;
+  for (const ACE_Message_Block *i = output.begin (); i != 0; i = i->cont ())
+    {
+      if (i->rd_ptr () == reinterpret_cast<char *> (longs))
+        longs_referenced = true;
+      if (i->rd_ptr () == reinterpret_cast<char *> (octets))
+        octets_referenced = true;
+    }
+
+  if (!longs_referenced || !octets_referenced)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("large arrays were copied into the stream\n")),
+                      1);
+
+  ACE_InputCDR input (output.begin ());
+
+  ACE_CDR::Octet o = 0;
+  ACE_CDR::Long rlongs[LONGS];
+  ACE_CDR::ULongLong ull = 0;
+  ACE_CDR::Short rsmall[4];
+  ACE_CDR::Octet roctets[OCTETS];
+  ACE_CDR::Short s = 0;
+
+  if (!input.read_octet (o)
+      || !input.read_long_array (rlongs, LONGS)
+      || !input.read_ulonglong (ull)
+      || !input.read_short_array (rsmall, 4)
+      || !input.read_octet_array (roctets, OCTETS)
+      || !input.read_short (s))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("reading the referenced stream failed\n")),
+                      1);
+
+  if (o != 7 || ull != 42 || s != -5
+      || ACE_OS::memcmp (rlongs, longs, sizeof longs) != 0
+      || ACE_OS::memcmp (rsmall, small, sizeof small) != 0
+      || ACE_OS::memcmp (roctets, octets, sizeof octets) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("referenced stream read back wrong\n")),
+                      1);
+
+  return 0;
+}
 
 int
 run_main (int argc, ACE_TCHAR *argv[])
@@ -1027,7 +1103,14 @@ run_main (int argc, ACE_TCHAR *argv[])
     return 1;
 
   ACE_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("Placeholder/Replace - no errors\n\n")));
+              ACE_TEXT ("Placeholder/Replace - no errors\n\n")
+              ACE_TEXT ("Testing reference threshold\n\n")));
+
+  if (reference_stream () != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Reference threshold - no errors\n\n")));
 
   ACE_END_TEST;
   return 0;
@@ -0,0 +1,296 @@
+//=============================================================================
+/**
+ *  @file    Dev_Poll_Reactor_Group_Test.cpp
+ *
+ *  This test verifies that an ACE_Dev_Poll_Reactor_Group spreads the
+ *  connections accepted by an ACE_Sharded_Acceptor over its shards
+ *  according to the shard policy, and that every handler is only
+ *  dispatched by the thread of its shard.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#if defined (ACE_HAS_DEV_POLL) || defined (ACE_HAS_EVENT_POLL)
+
+#include "ace/Dev_Poll_Reactor_Group.h"
+#include "ace/Sharded_Acceptor_T.h"
+#include "ace/SOCK_Reuseport_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/Svc_Handler.h"
+#include "ace/Reactor.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+static const size_t SHARDS = 4;
+static const size_t CONNECTIONS_PER_SHARD = 8;
+
+static ACE_Dev_Poll_Reactor_Group *group = 0;
+
+/// Connections served by each shard.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> served[SHARDS];
+
+/// Connections closed so far.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> closed (0);
+
+/// Upcalls dispatched by a thread other than the one of the shard.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> wrong_thread (0);
+
+/// Thread running the event loop of each shard, as seen by the first
+/// upcall dispatched by that shard.
+static ACE_thread_t shard_thread[SHARDS];
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> shard_thread_set[SHARDS];
+
+class Echo_Handler : public ACE_Svc_Handler<ACE_SOCK_Stream, ACE_NULL_SYNCH>
+{
+public:
+  //FUZZ: disable check_for_lack_ACE_OS
+  int open (void * = 0) override;
+  //FUZZ: enable check_for_lack_ACE_OS
+
+  int handle_input (ACE_HANDLE) override;
+
+  int handle_close (ACE_HANDLE handle,
+                    ACE_Reactor_Mask mask) override;
+
+private:
+  /// Check that the upcall runs in the thread of the shard.
+  void check_thread ();
+};
+
+int
+Echo_Handler::open (void *)
+{
+  int const shard = group->shard_of (this->reactor ());
+  if (shard == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) handler not bound to a shard reactor\n")),
+                      -1);
+
+  ++served[shard];
+
+  return this->reactor ()->register_handler (this,
+                                             ACE_Event_Handler::READ_MASK);
+}
+
+void
+Echo_Handler::check_thread ()
+{
+  int const shard = group->shard_of (this->reactor ());
+  if (shard == -1)
+    {
+      ++wrong_thread;
+      return;
+    }
+
+  if (shard_thread_set[shard]++ == 0)
+    shard_thread[shard] = ACE_Thread::self ();
+  else if (!ACE_OS::thr_equal (shard_thread[shard], ACE_Thread::self ()))
+    ++wrong_thread;
+}
+
+int
+Echo_Handler::handle_input (ACE_HANDLE)
+{
+  this->check_thread ();
+
+  char buf[BUFSIZ];
+  ssize_t const n = this->peer ().recv (buf, sizeof buf);
+  if (n <= 0)
+    return -1;
+
+  return this->peer ().send_n (buf, n) == n ? 0 : -1;
+}
+
+int
+Echo_Handler::handle_close (ACE_HANDLE handle,
+                            ACE_Reactor_Mask mask)
+{
+  ++closed;
+  return ACE_Svc_Handler<ACE_SOCK_Stream, ACE_NULL_SYNCH>::handle_close (handle,
+                                                                          mask);
+}
+
+typedef ACE_Sharded_Acceptor<Echo_Handler, ACE_SOCK_Reuseport_Acceptor>
+  ECHO_ACCEPTOR;
+
+static int
+run_clients (const ACE_INET_Addr &server_addr, size_t count)
+{
+  int status = 0;
+  ACE_SOCK_Connector connector;
+
+  for (size_t i = 0; i < count; ++i)
+    {
+      ACE_SOCK_Stream stream;
+      if (connector.connect (stream, server_addr) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("(%t) %p\n"),
+                           ACE_TEXT ("connect")),
+                          -1);
+
+      const char msg[] = "ping";
+      char reply[sizeof msg];
+      if (stream.send_n (msg, sizeof msg) != sizeof msg
+          || stream.recv_n (reply, sizeof reply) != sizeof reply
+          || ACE_OS::memcmp (msg, reply, sizeof msg) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) echo %B failed\n"),
+                      i));
+          status = -1;
+        }
+
+      stream.close ();
+    }
+
+  return status;
+}
+
+static int
+run_group (ACE_Reactor_Shard_Policy &policy, bool check_balance)
+{
+  int status = 0;
+
+  for (size_t i = 0; i < SHARDS; ++i)
+    {
+      served[i] = 0;
+      shard_thread_set[i] = 0;
+    }
+  closed = 0;
+  wrong_thread = 0;
+
+  ACE_Dev_Poll_Reactor_Group reactors;
+  if (reactors.open_shards (SHARDS, 0, &policy) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("open_shards")),
+                      -1);
+  group = &reactors;
+
+  ECHO_ACCEPTOR acceptor;
+  ACE_INET_Addr listen_addr (static_cast<u_short> (0),
+                             ACE_LOCALHOST,
+                             AF_INET);
+  if (acceptor.open (listen_addr, reactors) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("sharded acceptor open")),
+                      -1);
+
+  ACE_INET_Addr server_addr;
+  acceptor.get_local_addr (server_addr);
+  server_addr.set (server_addr.get_port_number (), ACE_LOCALHOST);
+
+  if (reactors.activate_shards () == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("activate_shards")),
+                      -1);
+
+  size_t const connections = SHARDS * CONNECTIONS_PER_SHARD;
+  if (run_clients (server_addr, connections) == -1)
+    status = -1;
+
+  // Wait for the server side of every connection to go away.
+  for (int i = 0;
+       i < 100 && closed.value () < static_cast<long> (connections);
+       ++i)
+    ACE_OS::sleep (ACE_Time_Value (0, 50000));
+
+  reactors.end_event_loops ();
+  reactors.wait ();
+  acceptor.close ();
+
+  long total = 0;
+  for (size_t i = 0; i < SHARDS; ++i)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("Shard %B: served %d connections\n"),
+                  i,
+                  served[i].value ()));
+      total += served[i].value ();
+      if (check_balance
+          && served[i].value () != static_cast<long> (CONNECTIONS_PER_SHARD))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Shard %B served %d connections, ")
+                      ACE_TEXT ("expected %B\n"),
+                      i,
+                      served[i].value (),
+                      CONNECTIONS_PER_SHARD));
+          status = -1;
+        }
+    }
+
+  if (total != static_cast<long> (connections))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Served %d connections, expected %B\n"),
+                  total,
+                  connections));
+      status = -1;
+    }
+
+  if (closed.value () != static_cast<long> (connections))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Closed %d connections, expected %B\n"),
+                  closed.value (),
+                  connections));
+      status = -1;
+    }
+
+  if (wrong_thread.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d upcalls dispatched outside their shard ")
+                  ACE_TEXT ("thread\n"),
+                  wrong_thread.value ()));
+      status = -1;
+    }
+
+  group = 0;
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Group_Test"));
+
+  int status = 0;
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Round robin shard policy\n")));
+  ACE_Round_Robin_Shard_Policy round_robin;
+  if (run_group (round_robin, true) != 0)
+    status = 1;
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Local shard policy\n")));
+  ACE_Local_Shard_Policy local;
+  if (run_group (local, false) != 0)
+    status = 1;
+
+  ACE_END_TEST;
+
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Group_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("Dev Poll and Event Poll are not supported ")
+              ACE_TEXT ("on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif  /* ACE_HAS_DEV_POLL || ACE_HAS_EVENT_POLL */
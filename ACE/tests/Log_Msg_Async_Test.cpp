@@ -0,0 +1,163 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async_Test.cpp
+ *
+ *   This program tests ACE_Log_Msg_Async: the records logged by several
+ *   threads must all be written by its drain thread, the threads must
+ *   not wait while the output is stuck, and the records logged while
+ *   the ring is full must be dropped, counted and reported.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+
+#if !defined (ACE_LACKS_IOSTREAM_TOTALLY) && defined (ACE_HAS_THREADS)
+
+#include <sstream>
+
+static const int THREADS = 4;
+static const int MESSAGES = 1000;
+
+// Enough records to overflow the default ring.
+static const int OVERFLOW_MESSAGES = 2000;
+
+static ACE_THR_FUNC_RETURN
+worker (void *)
+{
+  for (int i = 0; i < MESSAGES; ++i)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("async message %d\n"), i));
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+overflow_worker (void *)
+{
+  for (int i = 0; i < OVERFLOW_MESSAGES; ++i)
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("overflow message %d, padded to fill the ")
+                ACE_TEXT ("buffer faster ...............................\n"),
+                i));
+  return 0;
+}
+
+/// Number of times @a what appears in @a text.
+static int
+count (const std::string &text, const char *what)
+{
+  int n = 0;
+  for (size_t pos = text.find (what);
+       pos != std::string::npos;
+       pos = text.find (what, pos + 1))
+    ++n;
+  return n;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  int status = 0;
+
+  // The drain thread writes to <output>, the test log keeps getting
+  // the records synchronously.
+  std::ostringstream output;
+
+  ACE_Log_Msg_Async async;
+  async.msg_ostream (&output);
+  async.flags (ACE_Log_Msg::OSTREAM);
+
+  ACE_Log_Msg_Backend *old_backend = ACE_Log_Msg::msg_backend (&async);
+  if (ACE_LOG_MSG->open (ACE_TEXT ("Log_Msg_Async_Test"),
+                         ACE_LOG_MSG->flags () | ACE_Log_Msg::CUSTOM) == -1)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")));
+
+  // Log from several threads at once.
+  if (ACE_Thread_Manager::instance ()->spawn_n (THREADS, worker) == -1)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")));
+  ACE_Thread_Manager::instance ()->wait ();
+  async.flush ();
+
+  int written = count (output.str (), "async message");
+  if (written != THREADS * MESSAGES || async.dropped () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d of %d records written, %B dropped\n"),
+                  written, THREADS * MESSAGES, async.dropped ()));
+      ++status;
+    }
+  else
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%d records written by the drain thread\n"),
+                written));
+
+  // Holding the output lock stops the drain thread like a stuck
+  // ostream would.  The threads that log must neither wait for it nor
+  // for the lock of ACE_Log_Msg, they fill the ring and drop records.
+  output.str ("");
+  async.output_lock ().acquire ();
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (THREADS,
+                                                overflow_worker) == -1)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")));
+
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (60);
+  if (ACE_Thread_Manager::instance ()->wait (&deadline) == -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("the threads that log waited for the ")
+                  ACE_TEXT ("stuck output\n")));
+      ++status;
+    }
+
+  async.output_lock ().release ();
+  ACE_Thread_Manager::instance ()->wait ();
+  async.flush ();
+
+  size_t const dropped = async.dropped ();
+  written = count (output.str (), "overflow message");
+  if (dropped == 0
+      || written + dropped != static_cast<size_t> (THREADS * OVERFLOW_MESSAGES)
+      || count (output.str (), "log records dropped") != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d records written and %B dropped out of %d, ")
+                  ACE_TEXT ("or the drops were not reported\n"),
+                  written, dropped, THREADS * OVERFLOW_MESSAGES));
+      ++status;
+    }
+  else
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%d records written and %B dropped with a ")
+                ACE_TEXT ("ring of %B bytes\n"),
+                written, dropped, async.buffer_size ()));
+
+  // Back to synchronous logging before <async> goes away.
+  ACE_Log_Msg::msg_backend (old_backend);
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  async.close ();
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_Log_Msg_Async needs threads and iostreams\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* !ACE_LACKS_IOSTREAM_TOTALLY && ACE_HAS_THREADS */
@@ -312,7 +312,7 @@ parse_args (int argc, ACE_TCHAR *argv[])
 {
   ACE_DEBUG ((LM_DEBUG,
               ACE_TEXT ("Specifications:\n")));
-  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("s:i:m:f:N:ow"));
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("s:i:m:f:N:owa:"));
   int c;
 
   while ((c = get_opt ()) != EOF)
@@ -360,19 +360,26 @@ parse_args (int argc, ACE_TCHAR *argv[])
                       ACE_TEXT ("Wipeout logfile activated\n")));
           wipeout_logfile = true;
           break;
+        case 'a':
+          ACE_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("Asynchronous buffer (KB): %s\n"),
+                      get_opt.opt_arg ()));
+          break;
         default:
           ACE_ERROR_RETURN
             ((LM_ERROR,
               ACE_TEXT ("usage: [-s]<file_name>")
               ACE_TEXT ("[-i]<sample_interval> ")
               ACE_TEXT ("[-m]<max_size> [-f]<msg_flags> ")
-              ACE_TEXT ("[-n]<num_files> [-o]\n")
+              ACE_TEXT ("[-n]<num_files> [-o] [-a]<buffer_size>\n")
               ACE_TEXT ("\t-s: Specify the name of the log files.\n")
               ACE_TEXT ("\t-i: Define the sample interval in secs.\n")
               ACE_TEXT ("\t-m: Define the max size for the log_files in KB.\n")
               ACE_TEXT ("\t-f: Indicates the Log_Msg flags.\n")
               ACE_TEXT ("\t-N: Define the maximum number of log_files.\n")
-              ACE_TEXT ("\t-o: If activated puts the log_files ordered.\n"),
+              ACE_TEXT ("\t-o: If activated puts the log_files ordered.\n")
+              ACE_TEXT ("\t-a: Write the log_files asynchronously with a ")
+              ACE_TEXT ("buffer of this size in KB.\n"),
               ACE_TEXT ("\t-w: If activated cause the logfile to be wiped out,")
               ACE_TEXT (" both on startup and on reconfigure.\n")),
              -1);
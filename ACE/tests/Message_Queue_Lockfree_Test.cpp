@@ -0,0 +1,419 @@
+//=============================================================================
+/**
+ *  @file    Message_Queue_Lockfree_Test.cpp
+ *
+ *  This test checks ACE_Message_Queue_Lockfree: FIFO order and
+ *  statistics, its use by an ACE_Task, timeouts on an empty queue, a
+ *  queue above its high water mark and a full ring, deactivate() and
+ *  pulse() waking parked threads, and several producers and consumers
+ *  running against a small ring so that both sides park.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Message_Queue_Lockfree_T.h"
+#include "ace/Message_Block.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Task.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_THREADS)
+
+typedef ACE_Message_Queue_Lockfree<ACE_MT_SYNCH> QUEUE;
+
+static const int PRODUCERS = 4;
+static const int CONSUMERS = 4;
+static const int MESSAGES_PER_PRODUCER = 20000;
+
+static ACE_Time_Value
+deadline (long msec)
+{
+  return ACE_OS::gettimeofday () + ACE_Time_Value (0, msec * 1000);
+}
+
+static int
+fifo_test ()
+{
+  int status = 0;
+  QUEUE queue;
+
+  for (int i = 0; i < 100; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_RETURN (mb, ACE_Message_Block (16), -1);
+      mb->msg_priority (static_cast<unsigned long> (100 - i));
+      *reinterpret_cast<int *> (mb->wr_ptr ()) = i;
+      mb->wr_ptr (sizeof (int));
+      if (queue.enqueue_prio (mb) != i + 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("enqueue %d returned a wrong count\n"),
+                      i));
+          status = -1;
+        }
+    }
+
+  if (queue.message_count () != 100
+      || queue.message_bytes () != 100 * 16
+      || queue.message_length () != 100 * sizeof (int))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("wrong statistics: %B messages, %B bytes, ")
+                  ACE_TEXT ("%B length\n"),
+                  queue.message_count (),
+                  queue.message_bytes (),
+                  queue.message_length ()));
+      status = -1;
+    }
+
+  ACE_Message_Block *head = 0;
+  if (queue.peek_dequeue_head (head) != 100
+      || *reinterpret_cast<int *> (head->rd_ptr ()) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("peek_dequeue_head failed\n")));
+      status = -1;
+    }
+
+  // Priorities are ignored, the messages come out in FIFO order.
+  for (int i = 0; i < 100; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      if (queue.dequeue_prio (mb) != 99 - i)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("dequeue %d returned a wrong count\n"),
+                      i));
+          status = -1;
+        }
+      if (*reinterpret_cast<int *> (mb->rd_ptr ()) != i)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("got message %d instead of %d\n"),
+                      *reinterpret_cast<int *> (mb->rd_ptr ()),
+                      i));
+          status = -1;
+        }
+      mb->release ();
+    }
+
+  if (!queue.is_empty () || queue.message_bytes () != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("queue not empty at the end\n")));
+      status = -1;
+    }
+
+  ACE_Message_Block mb;
+  if (queue.enqueue_head (&mb) != -1 || errno != ENOTSUP)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("enqueue_head did not fail\n")));
+      status = -1;
+    }
+
+  // A task works with the queue through the ACE_Message_Queue
+  // interface.
+  ACE_Task<ACE_MT_SYNCH> task (0, &queue);
+  ACE_Message_Block *in = 0;
+  ACE_NEW_RETURN (in, ACE_Message_Block (8), -1);
+  ACE_Message_Block *out = 0;
+  if (task.putq (in) != 1 || task.getq (out) != 0 || out != in)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("putq/getq through a task failed\n")));
+      status = -1;
+    }
+  in->release ();
+
+  return status;
+}
+
+static int
+timeout_test ()
+{
+  int status = 0;
+
+  // Empty queue.
+  QUEUE queue (64, 32, 0, 4);
+  ACE_Message_Block *mb = 0;
+  ACE_Time_Value tv = deadline (20);
+  if (queue.dequeue_head (mb, &tv) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("dequeue on an empty queue did not time out\n")));
+      status = -1;
+    }
+
+  // High water mark: two 32 byte messages reach 64 bytes.
+  ACE_Message_Block mb1 (32);
+  ACE_Message_Block mb2 (32);
+  ACE_Message_Block mb3 (32);
+  if (queue.enqueue_tail (&mb1) == -1 || queue.enqueue_tail (&mb2) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("enqueue below the high water mark\n")));
+      status = -1;
+    }
+  tv = deadline (20);
+  if (!queue.is_full ()
+      || queue.enqueue_tail (&mb3, &tv) != -1
+      || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue above the high water mark ")
+                  ACE_TEXT ("did not time out\n")));
+      status = -1;
+    }
+  while (queue.message_count () > 0)
+    queue.dequeue_head (mb);
+
+  // Full ring: four empty messages do not reach the high water mark.
+  ACE_Message_Block empty[5];
+  for (int i = 0; i < 4; ++i)
+    if (queue.enqueue_tail (&empty[i]) == -1)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("enqueue in a free slot failed\n")));
+        status = -1;
+      }
+  tv = deadline (20);
+  if (queue.enqueue_tail (&empty[4], &tv) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue in a full ring did not time out\n")));
+      status = -1;
+    }
+  while (queue.message_count () > 0)
+    queue.dequeue_head (mb);
+
+  return status;
+}
+
+/// Consumers woken up by something else than the queue shutdown.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> wrong_wakeups (0);
+
+static ACE_THR_FUNC_RETURN
+blocked_consumer (void *arg)
+{
+  QUEUE *queue = static_cast<QUEUE *> (arg);
+  ACE_Message_Block *mb = 0;
+  if (queue->dequeue_head (mb) != -1 || errno != ESHUTDOWN)
+    ++wrong_wakeups;
+  return 0;
+}
+
+static int
+deactivate_test ()
+{
+  int status = 0;
+  QUEUE queue;
+  ACE_Thread_Manager tm;
+
+  for (int pulse = 0; pulse < 2; ++pulse)
+    {
+      if (tm.spawn_n (2, blocked_consumer, &queue) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("spawn_n")),
+                          -1);
+
+      // Let the consumers park.
+      ACE_OS::sleep (ACE_Time_Value (0, 100000));
+
+      int const previous = pulse ? queue.pulse () : queue.deactivate ();
+      if (previous != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("queue was not active\n")));
+          status = -1;
+        }
+
+      tm.wait ();
+      if (wrong_wakeups.value () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%d consumers not shut down\n"),
+                      wrong_wakeups.value ()));
+          status = -1;
+        }
+
+      int const expected = pulse
+        ? ACE_Message_Queue_Base::PULSED
+        : ACE_Message_Queue_Base::DEACTIVATED;
+      if (queue.state () != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("state %d, expected %d\n"),
+                      queue.state (),
+                      expected));
+          status = -1;
+        }
+
+      ACE_Message_Block mb;
+      if (!pulse && (queue.enqueue_tail (&mb) != -1 || errno != ESHUTDOWN))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("enqueue on a deactivated queue\n")));
+          status = -1;
+        }
+
+      queue.activate ();
+    }
+
+  return status;
+}
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> consumed (0);
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> out_of_order (0);
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  QUEUE *queue = static_cast<QUEUE *> (arg);
+
+  static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_id (0);
+  int const id = static_cast<int> (next_id++);
+
+  for (int i = 0; i < MESSAGES_PER_PRODUCER; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_RETURN (mb,
+                      ACE_Message_Block (2 * sizeof (int)),
+                      reinterpret_cast<ACE_THR_FUNC_RETURN> (-1));
+      int *data = reinterpret_cast<int *> (mb->wr_ptr ());
+      data[0] = id;
+      data[1] = i;
+      mb->wr_ptr (2 * sizeof (int));
+
+      if (queue->enqueue_tail (mb) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("enqueue_tail")));
+          mb->release ();
+          return reinterpret_cast<ACE_THR_FUNC_RETURN> (-1);
+        }
+    }
+
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+consumer (void *arg)
+{
+  QUEUE *queue = static_cast<QUEUE *> (arg);
+  int last[PRODUCERS];
+  for (int i = 0; i < PRODUCERS; ++i)
+    last[i] = -1;
+
+  for (;;)
+    {
+      ACE_Message_Block *mb = 0;
+      if (queue->dequeue_head (mb) == -1)
+        break;
+
+      int const *data = reinterpret_cast<int *> (mb->rd_ptr ());
+      // Each producer's messages must come out in the order it put them.
+      if (data[0] < 0 || data[0] >= PRODUCERS || data[1] <= last[data[0]])
+        ++out_of_order;
+      else
+        last[data[0]] = data[1];
+
+      mb->release ();
+      ++consumed;
+    }
+
+  return 0;
+}
+
+static int
+mpmc_test ()
+{
+  int status = 0;
+
+  // A small ring and a low high water mark make both producers and
+  // consumers park now and then.
+  QUEUE queue (64 * 2 * sizeof (int), 16 * 2 * sizeof (int), 0, 32);
+  ACE_Thread_Manager tm;
+
+  if (tm.spawn_n (CONSUMERS, consumer, &queue) == -1
+      || tm.spawn_n (PRODUCERS, producer, &queue) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("spawn_n")),
+                      -1);
+
+  long const total = PRODUCERS * MESSAGES_PER_PRODUCER;
+  for (int i = 0; i < 600 && consumed.value () < total; ++i)
+    ACE_OS::sleep (ACE_Time_Value (0, 100000));
+
+  // Wake up the consumers waiting for more.
+  queue.deactivate ();
+  tm.wait ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d producers, %d consumers: consumed %d of %d ")
+              ACE_TEXT ("messages\n"),
+              PRODUCERS,
+              CONSUMERS,
+              consumed.value (),
+              total));
+
+  if (consumed.value () != total)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("messages were lost\n")));
+      status = -1;
+    }
+  if (out_of_order.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d messages out of order\n"),
+                  out_of_order.value ()));
+      status = -1;
+    }
+  if (queue.message_count () != 0 || queue.message_bytes () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B messages, %B bytes left\n"),
+                  queue.message_count (),
+                  queue.message_bytes ()));
+      status = -1;
+    }
+
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Message_Queue_Lockfree_Test"));
+
+  int status = 0;
+
+  if (fifo_test () != 0)
+    status = 1;
+
+  if (timeout_test () != 0)
+    status = 1;
+
+  if (deactivate_test () != 0)
+    status = 1;
+
+  if (mpmc_test () != 0)
+    status = 1;
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Message_Queue_Lockfree_Test"));
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
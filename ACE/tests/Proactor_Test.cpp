@@ -51,6 +51,7 @@
 #  include "ace/POSIX_Proactor.h"
 #  include "ace/POSIX_CB_Proactor.h"
 #  include "ace/SUN_Proactor.h"
+#  include "ace/Uring_Proactor.h"
 
 #endif /* ACE_WIN32 */
 
@@ -58,7 +59,7 @@
 
 
 // Proactor Type (UNIX only, Win32 ignored)
-using ProactorType = enum { DEFAULT = 0, AIOCB, SIG, SUN, CB };
+using ProactorType = enum { DEFAULT = 0, AIOCB, SIG, SUN, CB, URING };
 static ProactorType proactor_type = DEFAULT;
 
 // POSIX : > 0 max number aio operations  proactor,
@@ -261,6 +262,16 @@ MyTask::create_proactor (ProactorType type_proactor, size_t max_op)
       break;
 #  endif /* !ACE_HAS_BROKEN_SIGEVENT_STRUCT */
 
+#  if defined (ACE_HAS_IO_URING)
+    case URING:
+      ACE_NEW_RETURN (proactor_impl,
+                      ACE_Uring_Proactor (max_op),
+                      -1);
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("(%t) Create Proactor Type = URING\n")));
+      break;
+#  endif /* ACE_HAS_IO_URING */
+
     default:
       ACE_DEBUG ((LM_DEBUG,
                   ACE_TEXT ("(%t) Create Proactor Type = DEFAULT\n")));
@@ -1726,6 +1737,7 @@ print_usage (int /* argc */, ACE_TCHAR *argv[])
       ACE_TEXT ("\n    i SIG")
       ACE_TEXT ("\n    c CB")
       ACE_TEXT ("\n    s SUN")
+      ACE_TEXT ("\n    u URING")
       ACE_TEXT ("\n    d default")
       ACE_TEXT ("\n-d <duplex mode 1-on/0-off>")
       ACE_TEXT ("\n-h <host> for Client mode")
@@ -1774,6 +1786,11 @@ set_proactor_type (const ACE_TCHAR *ptype)
        proactor_type = CB;
        return 1;
 #endif /* !ACE_HAS_BROKEN_SIGEVENT_STRUCT */
+#if defined (ACE_HAS_IO_URING)
+    case 'U':
+      proactor_type = URING;
+      return 1;
+#endif /* ACE_HAS_IO_URING */
     default:
       break;
     }
@@ -0,0 +1,276 @@
+//=============================================================================
+/**
+ *  @file    TLS_Slab_Allocator_Test.cpp
+ *
+ *   This program tests ACE_TLS_Slab_Allocator: the blocks of every
+ *   size must be usable, the blocks freed by another thread must go
+ *   back to the thread that allocated them instead of making the
+ *   allocator grow, the cache of a thread that exits must be reused,
+ *   and message blocks allocated by several threads must be released
+ *   by another one.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#include "ace/TLS_Slab_Allocator.h"
+#include "ace/Message_Block.h"
+#include "ace/Message_Queue.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_string.h"
+
+static const size_t BLOCKS = 2000;
+static const int ROUNDS = 10;
+
+/// Allocate blocks of every size up to twice the largest cached one,
+/// fill them and check that they don't overlap.
+static int
+test_sizes (ACE_TLS_Slab_Allocator &allocator)
+{
+  int status = 0;
+  size_t const max = allocator.max_block_size ();
+  void *blocks[64];
+  size_t sizes[64];
+  size_t n = 0;
+
+  for (size_t size = 1; size <= 2 * max && n < 64; size = size * 2 + 3)
+    {
+      sizes[n] = size;
+      blocks[n] = allocator.malloc (size);
+      if (blocks[n] == 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("malloc of %B bytes failed\n"),
+                      size));
+          return 1;
+        }
+      ACE_OS::memset (blocks[n], static_cast<int> (n), size);
+      ++n;
+    }
+
+  for (size_t i = 0; i < n; ++i)
+    {
+      const unsigned char *const p =
+        static_cast<const unsigned char *> (blocks[i]);
+      for (size_t j = 0; j < sizes[i]; ++j)
+        if (p[j] != static_cast<unsigned char> (i))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("block of %B bytes overwritten\n"),
+                        sizes[i]));
+            ++status;
+            break;
+          }
+      allocator.free (blocks[i]);
+    }
+
+  char *const zeroed = static_cast<char *> (allocator.calloc (100));
+  if (zeroed == 0)
+    ++status;
+  else
+    {
+      for (int i = 0; i < 100; ++i)
+        if (zeroed[i] != 0)
+          {
+            ACE_ERROR ((LM_ERROR, ACE_TEXT ("calloc didn't clear\n")));
+            ++status;
+            break;
+          }
+      allocator.free (zeroed);
+    }
+
+  // The last block freed of a size is the next one handed out.
+  void *const first = allocator.malloc (100);
+  allocator.free (first);
+  void *const second = allocator.malloc (120);
+  allocator.free (second);
+  if (first != second)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("freed block not reused\n")));
+      ++status;
+    }
+
+  return status;
+}
+
+#if defined (ACE_HAS_THREADS)
+
+static ACE_TLS_Slab_Allocator *allocator = 0;
+static void *blocks[BLOCKS];
+
+static ACE_THR_FUNC_RETURN
+free_blocks (void *)
+{
+  for (size_t i = 0; i < BLOCKS; ++i)
+    allocator->free (blocks[i]);
+  return 0;
+}
+
+/// The main thread allocates and another thread frees, the slabs
+/// needed by the first round must be enough for all of them.
+static int
+test_remote_free ()
+{
+  size_t slabs = 0;
+
+  for (int round = 0; round < ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < BLOCKS; ++i)
+        {
+          blocks[i] = allocator->malloc (100);
+          if (blocks[i] == 0)
+            ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("malloc failed\n")), 1);
+        }
+
+      if (round == 0)
+        slabs = allocator->slab_count ();
+
+      if (ACE_Thread_Manager::instance ()->spawn (free_blocks) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")),
+                          1);
+      ACE_Thread_Manager::instance ()->wait ();
+    }
+
+  if (allocator->slab_count () != slabs)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B slabs after %d rounds, %B after ")
+                       ACE_TEXT ("the first one\n"),
+                       allocator->slab_count (),
+                       ROUNDS,
+                       slabs),
+                      1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d rounds of %B blocks freed remotely in %B slabs\n"),
+              ROUNDS, BLOCKS, slabs));
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+use_allocator (void *)
+{
+  void *const ptr = allocator->malloc (64);
+  allocator->free (ptr);
+  return 0;
+}
+
+/// Threads started one after the other share a single cache.
+static int
+test_adoption ()
+{
+  size_t const caches = allocator->cache_count ();
+
+  for (int i = 0; i < ROUNDS; ++i)
+    {
+      if (ACE_Thread_Manager::instance ()->spawn (use_allocator) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")),
+                          1);
+      ACE_Thread_Manager::instance ()->wait ();
+    }
+
+  // The free_blocks threads never allocated, so they had no cache.
+  if (allocator->cache_count () != caches + 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B thread caches instead of %B\n"),
+                       allocator->cache_count (),
+                       caches + 1),
+                      1);
+  return 0;
+}
+
+static const int PRODUCERS = 4;
+static const int MESSAGES = 1000;
+static const char PAYLOAD[] = "TLS slab allocated message block";
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  ACE_Message_Queue<ACE_MT_SYNCH> *const queue =
+    static_cast<ACE_Message_Queue<ACE_MT_SYNCH> *> (arg);
+
+  for (int i = 0; i < MESSAGES; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_MALLOC_RETURN (
+        mb,
+        static_cast<ACE_Message_Block *> (
+          allocator->malloc (sizeof (ACE_Message_Block))),
+        ACE_Message_Block (sizeof PAYLOAD + i % 512,
+                           ACE_Message_Block::MB_DATA,
+                           0,
+                           0,
+                           allocator,
+                           0,
+                           ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                           ACE_Time_Value::zero,
+                           ACE_Time_Value::max_time,
+                           allocator,
+                           allocator),
+        0);
+      mb->copy (PAYLOAD, sizeof PAYLOAD);
+      queue->enqueue_tail (mb);
+    }
+  return 0;
+}
+
+/// Message blocks, data blocks and their data allocated by several
+/// threads and released by the main one.
+static int
+test_message_blocks ()
+{
+  ACE_Message_Queue<ACE_MT_SYNCH> queue;
+  int status = 0;
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (PRODUCERS,
+                                                producer,
+                                                &queue) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")),
+                      1);
+
+  for (int i = 0; i < PRODUCERS * MESSAGES; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      if (queue.dequeue_head (mb) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("dequeue_head")),
+                          1);
+      if (ACE_OS::strcmp (mb->rd_ptr (), PAYLOAD) != 0)
+        ++status;
+      mb->release ();
+    }
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (status != 0)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("%d message blocks corrupted\n"),
+                status));
+  return status;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("TLS_Slab_Allocator_Test"));
+
+  int status = 0;
+
+  {
+    ACE_TLS_Slab_Allocator sizes_allocator (4096, 16 * 1024);
+    status += test_sizes (sizes_allocator);
+  }
+
+#if defined (ACE_HAS_THREADS)
+  ACE_NEW_RETURN (allocator, ACE_TLS_Slab_Allocator, 1);
+  status += test_remote_free ();
+  status += test_adoption ();
+  status += test_message_blocks ();
+  delete allocator;
+  allocator = 0;
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
@@ -3,9 +3,10 @@
 /**
  *  @file    Timer_Queue_Test.cpp
  *
- *    This is a simple test of <ACE_Timer_Queue> and four of its
+ *    This is a simple test of <ACE_Timer_Queue> and five of its
  *    subclasses (<ACE_Timer_List>, <ACE_Timer_Heap>,
- *    <ACE_Timer_Wheel>, and <ACE_Timer_Hash>).  The test sets up a
+ *    <ACE_Timer_Wheel>, <ACE_Timer_Hierarchical_Wheel> and
+ *    <ACE_Timer_Hash>).  The test sets up a
  *    bunch of timers and then adds them to a timer queue. The
  *    functionality of the timer queue is then tested. No command
  *    line arguments are needed to run the test.
@@ -24,6 +25,7 @@
 #include "ace/Timer_Heap.h"
 #include "ace/Timer_Wheel.h"
 #include "ace/Timer_Hash.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
 #include "ace/Timer_Queue.h"
 #include "ace/Time_Policy.h"
 #include "ace/Recursive_Thread_Mutex.h"
@@ -576,6 +578,84 @@ test_unique_timer_heap_ids ()
   return;
 }
 
+struct Order_Handler : public ACE_Event_Handler
+{
+  Order_Handler (const ACE_Time_Value *times)
+    : times_ (times), fired_ (0), errors_ (0) { }
+
+  int handle_timeout (const ACE_Time_Value &cur_time,
+                      const void *arg) override
+  {
+    const ACE_Time_Value &expected = this->times_[(size_t) arg];
+
+    // Never early, never later than one expire() call, and in order.
+    if (expected > cur_time
+        || expected <= this->previous_expire_
+        || expected < this->last_)
+      ++this->errors_;
+
+    this->last_ = expected;
+    ++this->fired_;
+    return 0;
+  }
+
+  const ACE_Time_Value *times_;
+  ACE_Time_Value previous_expire_;
+  ACE_Time_Value last_;
+  int fired_;
+  int errors_;
+};
+
+// Checks that the cascading of ACE_Timer_Hierarchical_Wheel keeps
+// timers in order, using a small wheel so that timers go through every
+// level and the overflow list.
+static void
+test_hierarchical_wheel_order ()
+{
+  // 2 levels of 64 slots of 1 msec only cover 4 seconds.
+  ACE_Timer_Hierarchical_Wheel wheel (2, 6, 1000);
+
+  const int timers = 2000;
+  ACE_Time_Value times[timers];
+  long ids[timers];
+  Order_Handler handler (times);
+
+  ACE_Time_Value const start = wheel.gettimeofday ();
+  int scheduled = 0;
+
+  for (int i = 0; i < timers; ++i)
+    {
+      // Up to 20 seconds ahead, with some timers sharing a tick.
+      times[i] = start + ACE_Time_Value (0, (ACE_OS::rand () % 20000) * 1000
+                                            + (i % 3) * 100);
+      ids[i] = wheel.schedule (&handler, (const void *) (size_t) i, times[i]);
+      ACE_TEST_ASSERT (ids[i] != -1);
+      ++scheduled;
+    }
+
+  for (int i = 0; i < timers; i += 3)
+    {
+      ACE_TEST_ASSERT (wheel.cancel (ids[i]) == 1);
+      --scheduled;
+    }
+
+  ACE_Time_Value now = start;
+  while (!wheel.is_empty ())
+    {
+      ACE_TEST_ASSERT (wheel.earliest_time () > now);
+      now += ACE_Time_Value (0, (1 + ACE_OS::rand () % 50) * 1000);
+      wheel.expire (now);
+      handler.previous_expire_ = now;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("hierarchical wheel fired %d of %d timers, ")
+              ACE_TEXT ("%d out of order\n"),
+              handler.fired_, scheduled, handler.errors_));
+  ACE_TEST_ASSERT (handler.fired_ == scheduled);
+  ACE_TEST_ASSERT (handler.errors_ == 0);
+}
+
 /**
  * @class Timer_Queue_Stack
  *
@@ -656,6 +736,24 @@ run_main (int argc, ACE_TCHAR *argv[])
                                      ACE_TEXT ("ACE_Timer_Wheel (preallocated)"),
                                      tq_stack),
                   -1);
+  // Timer_Hierarchical_Wheel
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel,
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel"),
+                                     tq_stack),
+                  -1);
+
+  // Timer_Hierarchical_Wheel small enough for the performance test
+  // to cascade timers through all its levels.
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel (2,
+                                                                       6,
+                                                                       1000,
+                                                                       max_iterations),
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (2 levels, preallocated)"),
+                                     tq_stack),
+                  -1);
+
   // Timer_Heap without preallocated memory.
   ACE_NEW_RETURN (tq_stack,
                   Timer_Queue_Stack (new ACE_Timer_Heap,
@@ -720,6 +818,11 @@ run_main (int argc, ACE_TCHAR *argv[])
       ACE_TEXT ("**** starting unique IDs test for ACE_Timer_Heap\n")));
   test_unique_timer_heap_ids ();
 
+  ACE_DEBUG
+    ((LM_DEBUG,
+      ACE_TEXT ("**** starting ordering test for ACE_Timer_Hierarchical_Wheel\n")));
+  test_hierarchical_wheel_order ();
+
   ACE_END_TEST;
   return 0;
 }
@@ -2837,6 +2837,13 @@ TAO_CodeGen::gen_skel_src_includes ()
             "tao/PortableServer/Operation_Table_Perfect_Hash.h");
         }
         break;
+      case BE_GlobalData::TAO_OPERATION_HASH:
+        {
+          this->gen_standard_include (
+            this->server_skeletons_,
+            "tao/PortableServer/Operation_Table_Operation_Hash.h");
+        }
+        break;
     }
 
   if (be_global->gen_direct_collocation ())
@@ -2902,7 +2902,8 @@ BE_GlobalData::parse_args (long &i, char **av)
           }
         break;
         // Operation lookup strategy.
-        // <perfect_hash>, <dynamic_hash> or <binary_search>
+        // <perfect_hash>, <dynamic_hash>, <binary_search>,
+        // <linear_search> or <operation_hash>
         // Default is perfect.
       case 'H':
         idl_global->append_idl_flag (av[i + 1]);
@@ -2929,6 +2930,10 @@ BE_GlobalData::parse_args (long &i, char **av)
           {
             be_global->lookup_strategy (BE_GlobalData::TAO_LINEAR_SEARCH);
           }
+        else if (ACE_OS::strcmp (av[i + 1], "operation_hash") == 0)
+          {
+            be_global->lookup_strategy (BE_GlobalData::TAO_OPERATION_HASH);
+          }
         else
           {
             ACE_ERROR ((LM_ERROR,
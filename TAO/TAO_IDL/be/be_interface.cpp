@@ -44,6 +44,11 @@
 #include "ace/OS_NS_time.h"
 #include "ace/OS_NS_unistd.h"
 #include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+
+#include "tao/Operation_Hash.h"
+
+#include <algorithm>
 
 const char *be_interface::suffix_table_[] =
 {
@@ -938,8 +943,10 @@ be_interface::gen_operation_table (const char *flat_name,
   switch (be_global->lookup_strategy ())
   {
     case BE_GlobalData::TAO_DYNAMIC_HASH:
+    case BE_GlobalData::TAO_OPERATION_HASH:
       {
         this->skel_count_ = 0;
+        this->optable_names_.clear ();
         // Init the outstream appropriately.
         TAO_OutStream *os = tao_cg->server_skeletons ();
 
@@ -988,7 +995,7 @@ be_interface::gen_operation_table (const char *flat_name,
             *os << "{\"_is_a\", std::addressof(TAO_ServantBase::_is_a_skel), nullptr}," << be_nl;
           }
 
-        ++this->skel_count_;
+        this->add_optable_entry ("_is_a");
 
         if (!be_global->gen_minimum_corba ())
           {
@@ -1008,7 +1015,7 @@ be_interface::gen_operation_table (const char *flat_name,
                     << "::_non_existent_skel), nullptr}," << be_nl;
               }
 
-            ++this->skel_count_;
+            this->add_optable_entry ("_non_existent");
           }
 
         if (!be_global->gen_corba_e () && !be_global->gen_minimum_corba ())
@@ -1029,7 +1036,7 @@ be_interface::gen_operation_table (const char *flat_name,
                     << "::_component_skel), nullptr}," << be_nl;
               }
 
-            ++this->skel_count_;
+            this->add_optable_entry ("_component");
           }
 
         if (!be_global->gen_corba_e () && !be_global->gen_minimum_corba ())
@@ -1045,7 +1052,7 @@ be_interface::gen_operation_table (const char *flat_name,
                     << "::_interface_skel), nullptr}," << be_nl;
               }
 
-            ++this->skel_count_;
+            this->add_optable_entry ("_interface");
           }
 
         if (!be_global->gen_minimum_corba ())
@@ -1066,10 +1073,17 @@ be_interface::gen_operation_table (const char *flat_name,
                     << "::_repository_id_skel), nullptr}" << be_uidt_nl;
               }
 
-            ++this->skel_count_;
+            this->add_optable_entry ("_repository_id");
           }
 
         *os << "};" << be_nl_2;
+
+        if (be_global->lookup_strategy () == BE_GlobalData::TAO_OPERATION_HASH)
+          {
+            this->gen_operation_hash_instance (flat_name);
+            break;
+          }
+
         *os << "static const ::CORBA::Long _tao_" << flat_name
             << "_optable_size = sizeof (ACE_Hash_Map_Entry<const char *,"
             << " TAO::Operation_Skeletons>) * (" << (3 * this->skel_count_)
@@ -1371,7 +1385,8 @@ be_interface::gen_optable_entries (be_interface *derived_interface,
   int const lookup_strategy =
     be_global->lookup_strategy ();
 
-  if (lookup_strategy == BE_GlobalData::TAO_DYNAMIC_HASH)
+  if (lookup_strategy == BE_GlobalData::TAO_DYNAMIC_HASH
+      || lookup_strategy == BE_GlobalData::TAO_OPERATION_HASH)
     {
       for (UTL_ScopeActiveIterator si (this, UTL_Scope::IK_decls);
            !si.is_done ();
@@ -1408,7 +1423,8 @@ be_interface::gen_optable_entries (be_interface *derived_interface,
 
               *os << "}," << be_nl;
 
-              ++derived_interface->skel_count_;
+              derived_interface->add_optable_entry (
+                d->original_local_name ()->get_string ());
             }
           else if (d->node_type () == AST_Decl::NT_attr)
             {
@@ -1437,7 +1453,9 @@ be_interface::gen_optable_entries (be_interface *derived_interface,
 
               *os << "}," << be_nl;
 
-              ++derived_interface->skel_count_;
+              derived_interface->add_optable_entry (
+                ACE_CString ("_get_")
+                + d->original_local_name ()->get_string ());
 
               if (!attr->readonly ())
                 {
@@ -1459,7 +1477,9 @@ be_interface::gen_optable_entries (be_interface *derived_interface,
 
                   *os << "}," << be_nl;
 
-                  ++derived_interface->skel_count_;
+                  derived_interface->add_optable_entry (
+                    ACE_CString ("_set_")
+                    + d->original_local_name ()->get_string ());
                 }
             }
         }
@@ -2298,6 +2318,79 @@ be_interface::gen_linear_search_instance (const char *flat_name)
       << "tao_" << flat_name << "_optable;";
 }
 
+void
+be_interface::add_optable_entry (const ACE_CString &opname)
+{
+  this->optable_names_.push_back (opname);
+  ++this->skel_count_;
+}
+
+void
+be_interface::gen_operation_hash_instance (const char *flat_name)
+{
+  // Outstream.
+  TAO_OutStream *os = tao_cg->server_skeletons ();
+
+  typedef std::pair<ACE_UINT64, size_t> hash_entry;
+  std::vector<hash_entry> hashes;
+
+  for (size_t i = 0; i < this->optable_names_.size (); ++i)
+    {
+      ACE_CString const &opname = this->optable_names_[i];
+      hashes.push_back (
+        hash_entry (TAO::operation_hash (opname.c_str (), opname.length ()),
+                    i));
+    }
+
+  std::sort (hashes.begin (), hashes.end ());
+
+  // The skeletons still compare the names so a collision only costs
+  // an extra string compare, but let the user know.
+  for (size_t i = 1; i < hashes.size (); ++i)
+    {
+      if (hashes[i].first == hashes[i - 1].first)
+        {
+          ACE_ERROR ((LM_WARNING,
+                      ACE_TEXT ("TAO_IDL: warning, operations <%C> and ")
+                      ACE_TEXT ("<%C> of <%C> have the same hash\n"),
+                      this->optable_names_[hashes[i - 1].second].c_str (),
+                      this->optable_names_[hashes[i].second].c_str (),
+                      this->full_name ()));
+        }
+    }
+
+  *os << "static const TAO_operation_hash_entry " << flat_name
+      << "_operation_hashes [] = {" << be_idt_nl;
+
+  for (size_t i = 0; i < hashes.size (); ++i)
+    {
+      char buf[32];
+      ACE_OS::snprintf (buf,
+                        sizeof buf,
+                        "0x%016llx",
+                        static_cast<unsigned long long> (hashes[i].first));
+
+      *os << "{ACE_UINT64_LITERAL (" << buf << "), "
+          << static_cast<unsigned long> (hashes[i].second) << "}"
+          << (i + 1 < hashes.size () ? "," : "");
+
+      if (i + 1 < hashes.size ())
+        {
+          *os << be_nl;
+        }
+    }
+
+  *os << be_uidt_nl
+      << "};" << be_nl_2;
+
+  *os << "static TAO_Operation_Hash_OpTable tao_"
+      << flat_name << "_optable " << "(" << be_idt << be_idt_nl
+      << flat_name << "_operations," << be_nl
+      << flat_name << "_operation_hashes," << be_nl
+      << this->skel_count_ << be_uidt_nl
+      << ");" << be_uidt_nl;
+}
+
 int
 be_interface::is_a_helper (be_interface * /*derived*/,
                            be_interface *bi,
@@ -779,6 +779,11 @@ be_util::usage ()
       ACE_TEXT (" -H binary_search\tTo force binary search operation")
       ACE_TEXT (" lookup strategy\n")
     ));
+  ACE_DEBUG ((
+      LM_DEBUG,
+      ACE_TEXT (" -H operation_hash\tTo force operation lookup on")
+      ACE_TEXT (" precomputed hashes of the operation names\n")
+    ));
   ACE_DEBUG ((
       LM_DEBUG,
       ACE_TEXT (" -in \t\t\tTo generate <>s for standard #include'd")
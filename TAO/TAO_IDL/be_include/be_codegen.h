@@ -161,7 +161,8 @@ public:
       TAO_LINEAR_SEARCH,
       TAO_DYNAMIC_HASH,
       TAO_PERFECT_HASH,
-      TAO_BINARY_SEARCH
+      TAO_BINARY_SEARCH,
+      TAO_OPERATION_HASH
     };
 
   enum CG_SUB_STATE
@@ -41,7 +41,8 @@ public:
     TAO_LINEAR_SEARCH,
     TAO_DYNAMIC_HASH,
     TAO_PERFECT_HASH,
-    TAO_BINARY_SEARCH
+    TAO_BINARY_SEARCH,
+    TAO_OPERATION_HASH
   };
 
   /// To help with DDD portability in DDS4CCM
@@ -21,6 +21,10 @@
 #include "be_codegen.h"
 #include "ast_interface.h"
 
+#include "ace/SString.h"
+
+#include <vector>
+
 class TAO_OutStream;
 class TAO_IDL_Inheritance_Hierarchy_Worker;
 class be_visitor;
@@ -347,6 +351,14 @@ private:
   /// Create an instance of the linear search optable.
   void gen_linear_search_instance (const char *flat_name);
 
+  /// Count an entry of the operation table and remember its name, the
+  /// operation hash strategy needs the names in table order.
+  void add_optable_entry (const ACE_CString &opname);
+
+  /// Output the sorted hashes of the operation table entries and an
+  /// instance of the operation hash optable.
+  void gen_operation_hash_instance (const char *flat_name);
+
   /**
    * Called from traverse_inheritance_graph(), since base
    * components and base homes are inserted before the actual
@@ -365,6 +377,9 @@ protected:
   /// Number of static skeletons in the operation table.
   int skel_count_;
 
+  /// Names of the operation table entries, in table order.
+  std::vector<ACE_CString> optable_names_;
+
   /// Am I directly or indirectly involved in a multiple inheritance. If the
   /// value is -1 => not computed yet.
   int in_mult_inheritance_;
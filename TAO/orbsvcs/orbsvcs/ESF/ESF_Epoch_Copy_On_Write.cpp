@@ -0,0 +1,350 @@
+#ifndef TAO_ESF_EPOCH_COPY_ON_WRITE_CPP
+#define TAO_ESF_EPOCH_COPY_ON_WRITE_CPP
+
+#include "orbsvcs/ESF/ESF_Epoch_Copy_On_Write.h"
+#include "orbsvcs/ESF/ESF_Worker.h"
+#include "orbsvcs/Log_Macros.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_Memory.h"
+
+#if ! defined (__ACE_INLINE__)
+#include "orbsvcs/ESF/ESF_Epoch_Copy_On_Write.inl"
+#endif /* __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template<class ACE_LOCK>
+TAO_ESF_Epoch_Domain<ACE_LOCK>::Reader::Reader (char *block)
+  :  epoch_ (0),
+     depth_ (0),
+     in_use_ (false),
+     next_ (0),
+     block_ (block)
+{
+}
+
+// ****************************************************************
+
+template<class ACE_LOCK>
+TAO_ESF_Epoch_Domain<ACE_LOCK>::TAO_ESF_Epoch_Domain ()
+  :
+#if defined (ACE_HAS_THREADS)
+     key_created_ (false),
+#endif /* ACE_HAS_THREADS */
+     readers_ (0),
+     epoch_ (1),
+     slotless_ (0)
+{
+#if defined (ACE_HAS_THREADS)
+  if (ACE_OS::thr_keycreate (&this->key_,
+                             &TAO_ESF_Epoch_Domain::cleanup) == 0)
+    {
+      this->key_created_ = true;
+    }
+  else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+                      ACE_TEXT ("TAO_ESF_Epoch_Domain - ")
+                      ACE_TEXT ("cannot create the thread key, ")
+                      ACE_TEXT ("the copies are kept until destruction\n")));
+    }
+#endif /* ACE_HAS_THREADS */
+}
+
+template<class ACE_LOCK>
+TAO_ESF_Epoch_Domain<ACE_LOCK>::~TAO_ESF_Epoch_Domain ()
+{
+#if defined (ACE_HAS_THREADS)
+  if (this->key_created_)
+    {
+      ACE_OS::thr_setspecific (this->key_, 0);
+      ACE_OS::thr_keyfree (this->key_);
+    }
+#endif /* ACE_HAS_THREADS */
+
+  Reader *reader = this->readers_.load (std::memory_order_relaxed);
+  while (reader != 0)
+    {
+      Reader *next = reader->next_;
+      char *block = reader->block_;
+      reader->~Reader ();
+      delete [] block;
+      reader = next;
+    }
+}
+
+template<class ACE_LOCK> TAO_ESF_Epoch_Domain<ACE_LOCK> *
+TAO_ESF_Epoch_Domain<ACE_LOCK>::instance ()
+{
+  return ACE_Singleton<TAO_ESF_Epoch_Domain<ACE_LOCK>, ACE_LOCK>::instance ();
+}
+
+template<class ACE_LOCK> ACE_UINT64
+TAO_ESF_Epoch_Domain<ACE_LOCK>::oldest () const
+{
+  if (this->slotless_.load (std::memory_order_acquire) != 0)
+    return 0;
+
+  // A copy retired in epoch e may be in use by the threads that started
+  // iterating in epoch e or before.
+  ACE_UINT64 oldest = this->epoch_.load (std::memory_order_relaxed);
+  for (Reader *reader = this->readers_.load (std::memory_order_acquire);
+       reader != 0;
+       reader = reader->next_)
+    {
+      ACE_UINT64 const epoch = reader->epoch_.load (std::memory_order_acquire);
+      if (epoch != 0 && epoch < oldest)
+        oldest = epoch;
+    }
+  return oldest;
+}
+
+template<class ACE_LOCK> typename TAO_ESF_Epoch_Domain<ACE_LOCK>::Reader *
+TAO_ESF_Epoch_Domain<ACE_LOCK>::reader ()
+{
+#if defined (ACE_HAS_THREADS)
+  if (!this->key_created_)
+    return 0;
+
+  void *slot = 0;
+  if (ACE_OS::thr_getspecific (this->key_, &slot) == 0 && slot != 0)
+    return static_cast<Reader *> (slot);
+
+  Reader *reader = 0;
+  {
+    ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+
+    // Take over the slot of a thread that exited, if any.
+    for (reader = this->readers_.load (std::memory_order_relaxed);
+         reader != 0;
+         reader = reader->next_)
+      {
+        if (!reader->in_use_.load (std::memory_order_acquire))
+          break;
+      }
+
+    if (reader == 0)
+      {
+        reader = TAO_ESF_Epoch_Domain::make_reader ();
+        if (reader == 0)
+          return 0;
+        reader->next_ = this->readers_.load (std::memory_order_relaxed);
+        this->readers_.store (reader, std::memory_order_release);
+      }
+    reader->depth_ = 0;
+    reader->in_use_.store (true, std::memory_order_relaxed);
+  }
+
+  if (ACE_OS::thr_setspecific (this->key_, reader) != 0)
+    {
+      reader->in_use_.store (false, std::memory_order_release);
+      return 0;
+    }
+  return reader;
+#else
+  Reader *reader = this->readers_.load (std::memory_order_relaxed);
+  if (reader == 0)
+    {
+      reader = TAO_ESF_Epoch_Domain::make_reader ();
+      if (reader == 0)
+        return 0;
+      reader->in_use_.store (true, std::memory_order_relaxed);
+      this->readers_.store (reader, std::memory_order_release);
+    }
+  return reader;
+#endif /* ACE_HAS_THREADS */
+}
+
+template<class ACE_LOCK> typename TAO_ESF_Epoch_Domain<ACE_LOCK>::Reader *
+TAO_ESF_Epoch_Domain<ACE_LOCK>::make_reader ()
+{
+  // operator new is not required to honor the alignment of Reader.
+  char *block = 0;
+  ACE_NEW_RETURN (block, char[sizeof (Reader) + CACHE_LINE], 0);
+  return new (ACE_ptr_align_binary (block, CACHE_LINE)) Reader (block);
+}
+
+template<class ACE_LOCK> void
+TAO_ESF_Epoch_Domain<ACE_LOCK>::cleanup (void *reader)
+{
+  static_cast<Reader *> (reader)->in_use_.store (false,
+                                                 std::memory_order_release);
+}
+
+// ****************************************************************
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL>
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    TAO_ESF_Epoch_Copy_On_Write ()
+      :  domain_ (Domain::instance ()),
+         collection_ (0)
+{
+  Collection *collection = 0;
+  ACE_NEW (collection, Collection);
+  this->collection_.store (collection, std::memory_order_relaxed);
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL>
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    ~TAO_ESF_Epoch_Copy_On_Write ()
+{
+  Retired retired;
+  while (this->retired_.dequeue_head (retired) == 0)
+    retired.collection_->_decr_refcnt ();
+
+  Collection *collection = this->collection_.load (std::memory_order_relaxed);
+  if (collection != 0)
+    collection->_decr_refcnt ();
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    for_each (TAO_ESF_Worker<PROXY> *worker)
+{
+  Read_Guard ace_mon (*this);
+
+  worker->set_size(ace_mon.collection->collection.size());
+  ITERATOR end = ace_mon.collection->collection.end ();
+  for (ITERATOR i = ace_mon.collection->collection.begin (); i != end; ++i)
+    {
+      worker->work (*i);
+    }
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    connected (PROXY *proxy)
+{
+  ACE_Unbounded_Queue<Collection *> garbage;
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->mutex_);
+
+    Collection *copy = this->copy_i ();
+    if (copy == 0)
+      return;
+
+    proxy->_incr_refcnt ();
+    copy->collection.connected (proxy);
+    this->publish_i (copy, garbage);
+  }
+  TAO_ESF_Epoch_Copy_On_Write::release (garbage);
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    reconnected (PROXY *proxy)
+{
+  ACE_Unbounded_Queue<Collection *> garbage;
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->mutex_);
+
+    Collection *copy = this->copy_i ();
+    if (copy == 0)
+      return;
+
+    proxy->_incr_refcnt ();
+    copy->collection.reconnected (proxy);
+    this->publish_i (copy, garbage);
+  }
+  TAO_ESF_Epoch_Copy_On_Write::release (garbage);
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    disconnected (PROXY *proxy)
+{
+  ACE_Unbounded_Queue<Collection *> garbage;
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->mutex_);
+
+    Collection *copy = this->copy_i ();
+    if (copy == 0)
+      return;
+
+    copy->collection.disconnected (proxy);
+    this->publish_i (copy, garbage);
+  }
+  TAO_ESF_Epoch_Copy_On_Write::release (garbage);
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    shutdown ()
+{
+  ACE_Unbounded_Queue<Collection *> garbage;
+  {
+    ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->mutex_);
+
+    Collection *copy = this->copy_i ();
+    if (copy == 0)
+      return;
+
+    copy->collection.shutdown ();
+    this->publish_i (copy, garbage);
+  }
+  TAO_ESF_Epoch_Copy_On_Write::release (garbage);
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL>
+typename TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::Collection *
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    copy_i ()
+{
+  Collection *copy = 0;
+  ACE_NEW_RETURN (copy, Collection, 0);
+
+  copy->collection =
+    this->collection_.load (std::memory_order_relaxed)->collection;
+
+  ITERATOR end = copy->collection.end ();
+  for (ITERATOR i = copy->collection.begin (); i != end; ++i)
+    {
+      (*i)->_incr_refcnt ();
+    }
+  return copy;
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    publish_i (Collection *copy,
+               ACE_Unbounded_Queue<Collection *> &garbage)
+{
+  Retired retired;
+  retired.collection_ = this->collection_.load (std::memory_order_relaxed);
+  retired.epoch_ = 0;
+
+  this->collection_.store (copy, std::memory_order_release);
+
+  if (this->domain_ == 0)
+    {
+      // Without a domain the readers are not tracked, keep the copy
+      // until the destructor.
+      this->retired_.enqueue_tail (retired);
+      return;
+    }
+
+  retired.epoch_ = this->domain_->advance ();
+  this->retired_.enqueue_tail (retired);
+
+  ACE_UINT64 const oldest = this->domain_->oldest ();
+
+  Retired *head = 0;
+  while (this->retired_.get (head) == 0 && head->epoch_ < oldest)
+    {
+      garbage.enqueue_tail (head->collection_);
+      this->retired_.dequeue_head (retired);
+    }
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> void
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::
+    release (ACE_Unbounded_Queue<Collection *> &garbage)
+{
+  Collection *collection = 0;
+  while (garbage.dequeue_head (collection) == 0)
+    collection->_decr_refcnt ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_ESF_EPOCH_COPY_ON_WRITE_CPP */
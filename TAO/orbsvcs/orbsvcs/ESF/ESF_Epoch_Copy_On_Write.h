@@ -0,0 +1,244 @@
+// -*- C++ -*-
+
+/**
+ *  @file   ESF_Epoch_Copy_On_Write.h
+ *
+ *  A copy on write proxy collection whose readers do not write any
+ *  shared memory.
+ */
+
+#ifndef TAO_ESF_EPOCH_COPY_ON_WRITE_H
+#define TAO_ESF_EPOCH_COPY_ON_WRITE_H
+
+#include "orbsvcs/ESF/ESF_Proxy_Collection.h"
+#include "orbsvcs/ESF/ESF_Copy_On_Write.h"
+
+#include "tao/orbconf.h"
+
+#include "ace/Unbounded_Queue.h"
+#include "ace/Singleton.h"
+#include "ace/OS_NS_Thread.h"
+
+#include <atomic>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_ESF_Epoch_Domain
+ *
+ * @brief The epoch and the reader slots shared by all the
+ * TAO_ESF_Epoch_Copy_On_Write collections.
+ *
+ * Each thread has a single slot, found through a single thread
+ * specific key, whatever the number of collections, so the number of
+ * collections is not bounded by the number of keys.  A thread
+ * iterating over several collections at once keeps the epoch of its
+ * first iteration, which only delays the reclamation.
+ */
+template<class ACE_LOCK>
+class TAO_ESF_Epoch_Domain
+{
+public:
+  enum
+  {
+    CACHE_LINE = 64
+  };
+
+  /// The slot of a thread.  Only its thread writes <epoch_> and
+  /// <depth_>, the writers read <epoch_>.  Each slot has a cache line
+  /// of its own.
+  struct alignas (CACHE_LINE) Reader
+  {
+    Reader (char *block);
+
+    /// The epoch the current iteration started in, 0 if the thread
+    /// is not iterating.
+    std::atomic<ACE_UINT64> epoch_;
+
+    /// The number of nested iterations.
+    unsigned long depth_;
+
+    /// False once the thread exited, the slot is then given to the
+    /// next thread that iterates.
+    std::atomic<bool> in_use_;
+
+    Reader *next_;
+
+    /// The memory the slot was aligned in.
+    char *block_;
+  };
+
+  /// Constructor
+  TAO_ESF_Epoch_Domain ();
+
+  /// Destructor
+  ~TAO_ESF_Epoch_Domain ();
+
+  /// The domain of the process.
+  static TAO_ESF_Epoch_Domain<ACE_LOCK> *instance ();
+
+  /// Start an iteration in the calling thread.  Returns its slot, or
+  /// 0 if no slot could be created, the iteration then holds back all
+  /// the reclamation until leave() is called.
+  Reader *enter ();
+
+  /// End an iteration started by enter().
+  void leave (Reader *reader);
+
+  /// Called by a writer after it published a new copy.  Returns the
+  /// epoch of the copy it replaced.
+  ACE_UINT64 advance ();
+
+  /// The copies retired in an epoch older than the returned one are
+  /// no longer used by any thread.  Called after advance().
+  ACE_UINT64 oldest () const;
+
+private:
+  TAO_ESF_Epoch_Domain (const TAO_ESF_Epoch_Domain &) = delete;
+  TAO_ESF_Epoch_Domain &operator= (const TAO_ESF_Epoch_Domain &) = delete;
+
+  /// The slot of the calling thread, created if necessary.
+  Reader *reader ();
+
+  /// Allocate a slot on its own cache line.
+  static Reader *make_reader ();
+
+  /// Called when a thread with a slot exits.
+  static void cleanup (void *reader);
+
+  /// Serialize the creation of the slots.
+  ACE_LOCK lock_;
+
+#if defined (ACE_HAS_THREADS)
+  /// The key of the slot of each thread.
+  ACE_thread_key_t key_;
+
+  bool key_created_;
+#endif /* ACE_HAS_THREADS */
+
+  /// All the slots, only ever pushed at the head.
+  std::atomic<Reader *> readers_;
+
+  /// Advanced by each change of any collection.
+  std::atomic<ACE_UINT64> epoch_;
+
+  /// The number of threads iterating without a slot.
+  std::atomic<unsigned long> slotless_;
+};
+
+/**
+ * @class TAO_ESF_Epoch_Copy_On_Write
+ *
+ * @brief Implement the Copy_On_Write protocol with epoch based
+ * reclamation.
+ *
+ * The changes are made on a copy of the collection, as in
+ * TAO_ESF_Copy_On_Write, and published with a single store.  A
+ * thread iterating over the collection does not take the mutex nor
+ * increment a reference count, it only stores the current epoch in
+ * its slot of the TAO_ESF_Epoch_Domain and clears it when it is done.
+ * So the threads pushing events never write the same cache lines.
+ *
+ * Each change advances the epoch and retires the copy it replaced.
+ * The retired copies are deleted, by a later change or by the
+ * destructor, once no thread that may still be iterating over them
+ * has a slot with an epoch as old as theirs.
+ *
+ * An iteration may call for_each () again on the same collection and
+ * change it, the nested iterations keep the epoch of the outer one.
+ */
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL>
+class TAO_ESF_Epoch_Copy_On_Write : public TAO_ESF_Proxy_Collection<PROXY>
+{
+public:
+  /// Constructor
+  TAO_ESF_Epoch_Copy_On_Write ();
+
+  /// Destructor
+  ~TAO_ESF_Epoch_Copy_On_Write ();
+
+  // = The TAO_ESF_Proxy methods
+  virtual void for_each (TAO_ESF_Worker<PROXY> *worker);
+  virtual void connected (PROXY *proxy);
+  virtual void reconnected (PROXY *proxy);
+  virtual void disconnected (PROXY *proxy);
+  virtual void shutdown ();
+
+private:
+  typedef TAO_ESF_Copy_On_Write_Collection<COLLECTION,ITERATOR> Collection;
+  typedef TAO_ESF_Epoch_Domain<TAO_SYNCH_MUTEX> Domain;
+
+  /// A copy replaced in <epoch_>.
+  struct Retired
+  {
+    Collection *collection_;
+    ACE_UINT64 epoch_;
+  };
+
+  /// Publishes the epoch of an iteration in the slot of the thread.
+  class Read_Guard
+  {
+  public:
+    Read_Guard (TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE> &cow);
+    ~Read_Guard ();
+
+    Collection *collection;
+
+  private:
+    Domain *domain_;
+    typename Domain::Reader *reader_;
+  };
+
+  friend class Read_Guard;
+
+  TAO_ESF_Epoch_Copy_On_Write (const TAO_ESF_Epoch_Copy_On_Write &) = delete;
+  TAO_ESF_Epoch_Copy_On_Write &operator= (const TAO_ESF_Epoch_Copy_On_Write &) = delete;
+
+  /// A copy of the current collection, with the references of its
+  /// proxies.  Called with the mutex held.
+  Collection *copy_i ();
+
+  /// Publish @a copy, retire the current collection and move the
+  /// retired copies no thread can be using to @a garbage.  Called
+  /// with the mutex held.
+  void publish_i (Collection *copy,
+                  ACE_Unbounded_Queue<Collection *> &garbage);
+
+  /// Release the references of the copies in @a garbage.
+  static void release (ACE_Unbounded_Queue<Collection *> &garbage);
+
+  /// Serialize the changes.
+  ACE_SYNCH_MUTEX_T mutex_;
+
+  /// The domain of the process, kept so the readers and the writers
+  /// use the same one even if the singleton is instantiated in
+  /// several libraries.
+  Domain *domain_;
+
+  /// The current collection.
+  std::atomic<Collection *> collection_;
+
+  /// The copies replaced while some thread was iterating, the oldest
+  /// first.
+  ACE_Unbounded_Queue<Retired> retired_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "orbsvcs/ESF/ESF_Epoch_Copy_On_Write.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "orbsvcs/ESF/ESF_Epoch_Copy_On_Write.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("ESF_Epoch_Copy_On_Write.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* TAO_ESF_EPOCH_COPY_ON_WRITE_H */
@@ -0,0 +1,68 @@
+// -*- C++ -*-
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template<class ACE_LOCK> ACE_INLINE
+typename TAO_ESF_Epoch_Domain<ACE_LOCK>::Reader *
+TAO_ESF_Epoch_Domain<ACE_LOCK>::enter ()
+{
+  Reader *reader = this->reader ();
+  if (reader == 0)
+    {
+      this->slotless_.fetch_add (1);
+      std::atomic_thread_fence (std::memory_order_seq_cst);
+    }
+  else if (reader->depth_++ == 0)
+    {
+      reader->epoch_.store (this->epoch_.load (std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+      // The writers must see the slot, or we must see their copy.
+      std::atomic_thread_fence (std::memory_order_seq_cst);
+    }
+  return reader;
+}
+
+template<class ACE_LOCK> ACE_INLINE void
+TAO_ESF_Epoch_Domain<ACE_LOCK>::leave (Reader *reader)
+{
+  if (reader == 0)
+    {
+      this->slotless_.fetch_sub (1, std::memory_order_release);
+    }
+  else if (--reader->depth_ == 0)
+    {
+      reader->epoch_.store (0, std::memory_order_release);
+    }
+}
+
+template<class ACE_LOCK> ACE_INLINE ACE_UINT64
+TAO_ESF_Epoch_Domain<ACE_LOCK>::advance ()
+{
+  // Pairs with the fence of enter(): a thread that did not see the
+  // new copy has its slot seen by oldest().
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+  return this->epoch_.fetch_add (1);
+}
+
+// ****************************************************************
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> ACE_INLINE
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::Read_Guard::
+    Read_Guard (TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE> &cow)
+      :  collection (0),
+         domain_ (cow.domain_),
+         reader_ (0)
+{
+  if (this->domain_ != 0)
+    this->reader_ = this->domain_->enter ();
+  this->collection = cow.collection_.load (std::memory_order_acquire);
+}
+
+template<class PROXY, class COLLECTION, class ITERATOR, ACE_SYNCH_DECL> ACE_INLINE
+TAO_ESF_Epoch_Copy_On_Write<PROXY,COLLECTION,ITERATOR,ACE_SYNCH_USE>::Read_Guard::
+    ~Read_Guard ()
+{
+  if (this->domain_ != 0)
+    this->domain_->leave (this->reader_);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
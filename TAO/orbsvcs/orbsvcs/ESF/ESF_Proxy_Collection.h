@@ -98,6 +98,12 @@ template<class Target> class TAO_ESF_Worker;
  *   during the iteration.  This is a very expensive approach, but
  *   useful in many cases.
  *   The kind of lock is also strategized in this case.
+ * + Epoch_Copy_On_Write: the changes are made on a copy of the
+ *   collection like in Copy_On_Write, but the threads iterating only
+ *   publish the epoch they started in, in a slot of their own,
+ *   instead of incrementing a shared reference count under a mutex.
+ *   The replaced copies are deleted by a later change once no thread
+ *   started before they were replaced is still iterating.
  * + Delayed_Changes: before starting the iteration a counter is
  *   incremented, this counter is used to keep track of the number
  *   of threads concurrently using the collection.
@@ -10,6 +10,7 @@
 #include "orbsvcs/Event/EC_Default_ProxySupplier.h"
 #include "orbsvcs/Event/EC_Trivial_Supplier_Filter.h"
 #include "orbsvcs/Event/EC_Per_Supplier_Filter.h"
+#include "orbsvcs/Event/EC_Indexed_Supplier_Filter.h"
 #include "orbsvcs/Event/EC_ObserverStrategy.h"
 #include "orbsvcs/Event/EC_Null_Scheduling.h"
 #include "orbsvcs/Event/EC_Group_Scheduling.h"
@@ -24,6 +25,7 @@
 #include "orbsvcs/ESF/ESF_Immediate_Changes.h"
 #include "orbsvcs/ESF/ESF_Copy_On_Read.h"
 #include "orbsvcs/ESF/ESF_Copy_On_Write.h"
+#include "orbsvcs/ESF/ESF_Epoch_Copy_On_Write.h"
 #include "orbsvcs/ESF/ESF_Delayed_Changes.h"
 #include "orbsvcs/ESF/ESF_Delayed_Command.h"
 
@@ -173,6 +175,8 @@ TAO_EC_Default_Factory::init (int argc, ACE_TCHAR* argv[])
                 this->supplier_filtering_ = 0;
               else if (ACE_OS::strcasecmp (opt, ACE_TEXT("per-supplier")) == 0)
                 this->supplier_filtering_ = 1;
+              else if (ACE_OS::strcasecmp (opt, ACE_TEXT("indexed")) == 0)
+                this->supplier_filtering_ = 2;
               else
                   this->unsupported_option_value (ACE_TEXT("-ECSupplierFilter"), opt);
               arg_shifter.consume_arg ();
@@ -263,6 +267,8 @@ TAO_EC_Default_Factory::init (int argc, ACE_TCHAR* argv[])
                     iteration_type = 2;
                   else if (ACE_OS::strcasecmp (arg, ACE_TEXT("delayed")) == 0)
                     iteration_type = 3;
+                  else if (ACE_OS::strcasecmp (arg, ACE_TEXT("epoch")) == 0)
+                    iteration_type = 4;
                   else
                     ORBSVCS_ERROR ((LM_ERROR,
                                 "EC_Default_Factory - "
@@ -308,6 +314,8 @@ TAO_EC_Default_Factory::init (int argc, ACE_TCHAR* argv[])
                     iteration_type = 2;
                   else if (ACE_OS::strcasecmp (arg, ACE_TEXT("delayed")) == 0)
                     iteration_type = 3;
+                  else if (ACE_OS::strcasecmp (arg, ACE_TEXT("epoch")) == 0)
+                    iteration_type = 4;
                   else
                     ORBSVCS_ERROR ((LM_ERROR,
                                 "EC_Default_Factory - "
@@ -584,6 +592,14 @@ TAO_EC_Default_Factory::create_supplier_filter_builder (TAO_EC_Event_Channel_Bas
     return new TAO_EC_Trivial_Supplier_Filter_Builder (ec);
   else if (this->supplier_filtering_ == 1)
     return new TAO_EC_Per_Supplier_Filter_Builder (ec);
+  else if (this->supplier_filtering_ == 2)
+    {
+      // The consumers of the null filter builder accept any event,
+      // whatever their subscriptions.
+      if (this->filtering_ == 0)
+        return new TAO_EC_Trivial_Supplier_Filter_Builder (ec);
+      return new TAO_EC_Indexed_Supplier_Filter_Builder (ec);
+    }
   return nullptr;
 }
 
@@ -750,6 +766,11 @@ TAO_EC_Default_Factory::create_proxy_push_consumer_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_List<TAO_EC_ProxyPushConsumer>,
       TAO_EC_Consumer_List_Iterator,
       ACE_SYNCH> ();
+  else if (this->consumer_collection_ == 0x004)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushConsumer,
+      TAO_ESF_Proxy_List<TAO_EC_ProxyPushConsumer>,
+      TAO_EC_Consumer_List_Iterator,
+      ACE_SYNCH> ();
   else if (this->consumer_collection_ == 0x010)
     return new TAO_ESF_Immediate_Changes<TAO_EC_ProxyPushConsumer,
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushConsumer>,
@@ -770,6 +791,11 @@ TAO_EC_Default_Factory::create_proxy_push_consumer_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushConsumer>,
       TAO_EC_Consumer_RB_Tree_Iterator,
       ACE_SYNCH> ();
+  else if (this->consumer_collection_ == 0x014)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushConsumer,
+      TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushConsumer>,
+      TAO_EC_Consumer_RB_Tree_Iterator,
+      ACE_SYNCH> ();
   else if (this->consumer_collection_ == 0x100)
     return new TAO_ESF_Immediate_Changes<TAO_EC_ProxyPushConsumer,
       TAO_ESF_Proxy_List<TAO_EC_ProxyPushConsumer>,
@@ -790,6 +816,11 @@ TAO_EC_Default_Factory::create_proxy_push_consumer_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_List<TAO_EC_ProxyPushConsumer>,
       TAO_EC_Consumer_List_Iterator,
       ACE_NULL_SYNCH> ();
+  else if (this->consumer_collection_ == 0x104)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushConsumer,
+      TAO_ESF_Proxy_List<TAO_EC_ProxyPushConsumer>,
+      TAO_EC_Consumer_List_Iterator,
+      ACE_NULL_SYNCH> ();
   else if (this->consumer_collection_ == 0x110)
     return new TAO_ESF_Immediate_Changes<TAO_EC_ProxyPushConsumer,
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushConsumer>,
@@ -810,6 +841,11 @@ TAO_EC_Default_Factory::create_proxy_push_consumer_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushConsumer>,
       TAO_EC_Consumer_RB_Tree_Iterator,
       ACE_NULL_SYNCH> ();
+  else if (this->consumer_collection_ == 0x114)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushConsumer,
+      TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushConsumer>,
+      TAO_EC_Consumer_RB_Tree_Iterator,
+      ACE_NULL_SYNCH> ();
 
   return nullptr;
 }
@@ -843,6 +879,11 @@ TAO_EC_Default_Factory::create_proxy_push_supplier_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_List<TAO_EC_ProxyPushSupplier>,
       TAO_EC_Supplier_List_Iterator,
       ACE_SYNCH> ();
+  else if (this->supplier_collection_ == 0x004)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushSupplier,
+      TAO_ESF_Proxy_List<TAO_EC_ProxyPushSupplier>,
+      TAO_EC_Supplier_List_Iterator,
+      ACE_SYNCH> ();
   else if (this->supplier_collection_ == 0x010)
     return new TAO_ESF_Immediate_Changes<TAO_EC_ProxyPushSupplier,
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushSupplier>,
@@ -863,6 +904,11 @@ TAO_EC_Default_Factory::create_proxy_push_supplier_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushSupplier>,
       TAO_EC_Supplier_RB_Tree_Iterator,
       ACE_SYNCH> ();
+  else if (this->supplier_collection_ == 0x014)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushSupplier,
+      TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushSupplier>,
+      TAO_EC_Supplier_RB_Tree_Iterator,
+      ACE_SYNCH> ();
   else if (this->supplier_collection_ == 0x100)
     return new TAO_ESF_Immediate_Changes<TAO_EC_ProxyPushSupplier,
       TAO_ESF_Proxy_List<TAO_EC_ProxyPushSupplier>,
@@ -883,6 +929,11 @@ TAO_EC_Default_Factory::create_proxy_push_supplier_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_List<TAO_EC_ProxyPushSupplier>,
       TAO_EC_Supplier_List_Iterator,
       ACE_NULL_SYNCH> ();
+  else if (this->supplier_collection_ == 0x104)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushSupplier,
+      TAO_ESF_Proxy_List<TAO_EC_ProxyPushSupplier>,
+      TAO_EC_Supplier_List_Iterator,
+      ACE_NULL_SYNCH> ();
   else if (this->supplier_collection_ == 0x110)
     return new TAO_ESF_Immediate_Changes<TAO_EC_ProxyPushSupplier,
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushSupplier>,
@@ -903,6 +954,11 @@ TAO_EC_Default_Factory::create_proxy_push_supplier_collection (TAO_EC_Event_Chan
       TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushSupplier>,
       TAO_EC_Supplier_RB_Tree_Iterator,
       ACE_NULL_SYNCH> ();
+  else if (this->supplier_collection_ == 0x114)
+    return new TAO_ESF_Epoch_Copy_On_Write<TAO_EC_ProxyPushSupplier,
+      TAO_ESF_Proxy_RB_Tree<TAO_EC_ProxyPushSupplier>,
+      TAO_EC_Supplier_RB_Tree_Iterator,
+      ACE_NULL_SYNCH> ();
 
   return nullptr;
 }
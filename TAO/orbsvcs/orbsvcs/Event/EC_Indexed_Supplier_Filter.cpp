@@ -0,0 +1,460 @@
+#include "orbsvcs/Event/EC_Indexed_Supplier_Filter.h"
+#include "orbsvcs/Event/EC_Event_Channel_Base.h"
+#include "orbsvcs/Event/EC_ProxySupplier.h"
+#include "orbsvcs/Event/EC_ProxyConsumer.h"
+#include "orbsvcs/Event/EC_QOS_Info.h"
+#include "orbsvcs/Event/EC_Scheduling_Strategy.h"
+#include "orbsvcs/ESF/ESF_Proxy_Collection.h"
+#include "orbsvcs/Event_Service_Constants.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_EC_Indexed_Supplier_Filter::Key::Key (CORBA::Long source,
+                                          CORBA::Long type)
+  :  source_ (source),
+     type_ (type)
+{
+}
+
+bool
+TAO_EC_Indexed_Supplier_Filter::Key::operator== (const Key &rhs) const
+{
+  return this->source_ == rhs.source_ && this->type_ == rhs.type_;
+}
+
+u_long
+TAO_EC_Indexed_Supplier_Filter::Key::hash () const
+{
+  return static_cast<u_long> (this->source_) * 31
+    + static_cast<u_long> (this->type_);
+}
+
+// ****************************************************************
+
+TAO_EC_Indexed_Supplier_Filter::Entry::Entry (const Key &key,
+                                              Collection *collection)
+  :  key_ (key),
+     collection_ (collection),
+     consumers_ (0),
+     refcount_ (1)
+{
+}
+
+// ****************************************************************
+
+TAO_EC_Indexed_Supplier_Filter::
+    TAO_EC_Indexed_Supplier_Filter (TAO_EC_Event_Channel_Base* ec)
+  :  event_channel_ (ec),
+     any_ (nullptr),
+     suppliers_ (0)
+{
+  Collection *collection = nullptr;
+  this->event_channel_->create_proxy_collection (collection);
+  ACE_NEW (this->any_, Entry (Key (), collection));
+}
+
+TAO_EC_Indexed_Supplier_Filter::~TAO_EC_Indexed_Supplier_Filter ()
+{
+  this->shutdown ();
+
+  Entry_Set garbage;
+  Index::iterator end = this->index_.end ();
+  for (Index::iterator i = this->index_.begin (); i != end; ++i)
+    garbage.insert ((*i).int_id_);
+  this->index_.unbind_all ();
+  this->release (garbage);
+
+  this->release (this->any_);
+  this->any_ = nullptr;
+}
+
+bool
+TAO_EC_Indexed_Supplier_Filter::index_keys (
+    const RtecEventChannelAdmin::ConsumerQOS &qos,
+    Key_Set &keys)
+{
+  CORBA::ULong const length = qos.dependencies.length ();
+  if (length == 0)
+    return false;
+
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      const RtecEventComm::EventHeader &header =
+        qos.dependencies[i].event.header;
+
+      switch (header.type)
+        {
+        case ACE_ES_CONJUNCTION_DESIGNATOR:
+        case ACE_ES_DISJUNCTION_DESIGNATOR:
+        case ACE_ES_LOGICAL_AND_DESIGNATOR:
+          // Only group the entries that follow.
+          break;
+
+        case ACE_ES_EVENT_TIMEOUT:
+        case ACE_ES_EVENT_INTERVAL_TIMEOUT:
+        case ACE_ES_EVENT_DEADLINE_TIMEOUT:
+          // Timeouts are pushed to the consumer by the timeout
+          // generator, not through the supplier filter.
+          break;
+
+        case ACE_ES_NEGATION_DESIGNATOR:
+        case ACE_ES_BITMASK_DESIGNATOR:
+        case ACE_ES_MASKED_TYPE_DESIGNATOR:
+        case ACE_ES_NULL_DESIGNATOR:
+          return false;
+
+        default:
+          if (header.source == ACE_ES_EVENT_SOURCE_ANY
+              && header.type == ACE_ES_EVENT_ANY)
+            return false;
+          keys.insert (Key (header.source, header.type));
+          break;
+        }
+    }
+
+  // An event matching both a wildcard source and a wildcard type
+  // pair would be pushed twice to the consumer.
+  bool any_source = false;
+  bool any_type = false;
+
+  Key_Set::iterator end = keys.end ();
+  for (Key_Set::iterator i = keys.begin (); i != end; ++i)
+    {
+      if ((*i).source_ == ACE_ES_EVENT_SOURCE_ANY)
+        any_source = true;
+      else if ((*i).type_ == ACE_ES_EVENT_ANY)
+        any_type = true;
+    }
+
+  return !(any_source && any_type);
+}
+
+TAO_EC_Indexed_Supplier_Filter::Entry *
+TAO_EC_Indexed_Supplier_Filter::entry (const Key &key)
+{
+  Entry *entry = nullptr;
+  if (this->index_.find (key, entry) == 0)
+    return entry;
+
+  Collection *collection = nullptr;
+  this->event_channel_->create_proxy_collection (collection);
+  if (collection == nullptr)
+    return nullptr;
+
+  ACE_NEW_NORETURN (entry, Entry (key, collection));
+  if (entry == nullptr || this->index_.bind (key, entry) != 0)
+    {
+      delete entry;
+      this->event_channel_->destroy_proxy_collection (collection);
+      return nullptr;
+    }
+  return entry;
+}
+
+TAO_EC_Indexed_Supplier_Filter::Entry *
+TAO_EC_Indexed_Supplier_Filter::find_i (const Key &key)
+{
+  Entry *entry = nullptr;
+  if (this->index_.find (key, entry) != 0)
+    return nullptr;
+  ++entry->refcount_;
+  return entry;
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::release (Entry *entry)
+{
+  if (--entry->refcount_ != 0)
+    return;
+
+  this->event_channel_->destroy_proxy_collection (entry->collection_);
+  delete entry;
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::release (Entry_Set &garbage)
+{
+  Entry_Set::iterator end = garbage.end ();
+  for (Entry_Set::iterator i = garbage.begin (); i != end; ++i)
+    this->release (*i);
+  garbage.reset ();
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::connected_i (TAO_EC_ProxyPushSupplier* supplier)
+{
+  Entry_Set *entries = nullptr;
+  if (this->consumers_.find (supplier, entries) == 0)
+    return;
+
+  ACE_NEW (entries, Entry_Set);
+
+  Key_Set keys;
+  if (TAO_EC_Indexed_Supplier_Filter::index_keys (supplier->subscriptions (),
+                                                  keys))
+    {
+      Key_Set::iterator end = keys.end ();
+      for (Key_Set::iterator i = keys.begin (); i != end; ++i)
+        {
+          // The exact pairs covered by a wildcard pair of the same
+          // consumer would duplicate its events.
+          const Key &key = *i;
+          if (key.source_ != ACE_ES_EVENT_SOURCE_ANY
+              && key.type_ != ACE_ES_EVENT_ANY
+              && (keys.find (Key (key.source_, ACE_ES_EVENT_ANY)) == 0
+                  || keys.find (Key (ACE_ES_EVENT_SOURCE_ANY, key.type_)) == 0))
+            continue;
+
+          Entry *entry = this->entry (key);
+          if (entry == nullptr)
+            {
+              this->discard_empty_i (*entries);
+              entries->insert (this->any_);
+              break;
+            }
+          entries->insert (entry);
+        }
+    }
+  else
+    {
+      entries->insert (this->any_);
+    }
+
+  if (this->consumers_.bind (supplier, entries) != 0)
+    {
+      this->discard_empty_i (*entries);
+      delete entries;
+      return;
+    }
+
+  Entry_Set::iterator end = entries->end ();
+  for (Entry_Set::iterator i = entries->begin (); i != end; ++i)
+    {
+      ++(*i)->consumers_;
+      (*i)->collection_->connected (supplier);
+    }
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::discard_empty_i (Entry_Set &entries)
+{
+  Entry_Set::iterator end = entries.end ();
+  for (Entry_Set::iterator i = entries.begin (); i != end; ++i)
+    {
+      Entry *entry = *i;
+      if (entry->consumers_ == 0 && entry != this->any_)
+        {
+          this->index_.unbind (entry->key_);
+          this->release (entry);
+        }
+    }
+  entries.reset ();
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::disconnected_i (TAO_EC_ProxyPushSupplier* supplier,
+                                                Entry_Set &garbage)
+{
+  Entry_Set *entries = nullptr;
+  if (this->consumers_.unbind (supplier, entries) != 0)
+    return;
+
+  Entry_Set::iterator end = entries->end ();
+  for (Entry_Set::iterator i = entries->begin (); i != end; ++i)
+    {
+      Entry *entry = *i;
+      entry->collection_->disconnected (supplier);
+      if (--entry->consumers_ == 0 && entry != this->any_)
+        {
+          this->index_.unbind (entry->key_);
+          garbage.insert (entry);
+        }
+    }
+
+  delete entries;
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::clear_i (Entry_Set &garbage)
+{
+  while (this->consumers_.current_size () != 0)
+    {
+      TAO_EC_ProxyPushSupplier *supplier =
+        (*this->consumers_.begin ()).ext_id_;
+      this->disconnected_i (supplier, garbage);
+    }
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::bind (TAO_EC_ProxyPushConsumer*)
+{
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+  ++this->suppliers_;
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::unbind (TAO_EC_ProxyPushConsumer*)
+{
+  Entry_Set garbage;
+  {
+    ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+    if (this->suppliers_ == 0 || --this->suppliers_ != 0)
+      return;
+
+    // No supplier is left to report the consumers that disconnect.
+    this->clear_i (garbage);
+  }
+  this->release (garbage);
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::connected (TAO_EC_ProxyPushSupplier* supplier)
+{
+  // Each supplier reports the consumers, only the first report
+  // changes the index.
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+  this->connected_i (supplier);
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::reconnected (TAO_EC_ProxyPushSupplier* supplier)
+{
+  Entry_Set garbage;
+  {
+    ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+    this->disconnected_i (supplier, garbage);
+    this->connected_i (supplier);
+  }
+  this->release (garbage);
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::disconnected (TAO_EC_ProxyPushSupplier* supplier)
+{
+  Entry_Set garbage;
+  {
+    ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+    this->disconnected_i (supplier, garbage);
+  }
+  this->release (garbage);
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::shutdown ()
+{
+  ACE_WRITE_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+
+  Consumer_Map::iterator consumers_end = this->consumers_.end ();
+  for (Consumer_Map::iterator i = this->consumers_.begin ();
+       i != consumers_end;
+       ++i)
+    delete (*i).int_id_;
+  this->consumers_.unbind_all ();
+
+  Index::iterator end = this->index_.end ();
+  for (Index::iterator i = this->index_.begin (); i != end; ++i)
+    {
+      (*i).int_id_->consumers_ = 0;
+      (*i).int_id_->collection_->shutdown ();
+    }
+
+  this->any_->consumers_ = 0;
+  this->any_->collection_->shutdown ();
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::push (const RtecEventComm::EventSet& event,
+                                      TAO_EC_ProxyPushConsumer *consumer)
+{
+  TAO_EC_Scheduling_Strategy* scheduling_strategy =
+    this->event_channel_->scheduling_strategy ();
+  scheduling_strategy->schedule_event (event,
+                                       consumer,
+                                       this);
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter::push_scheduled_event (RtecEventComm::EventSet &event,
+                                                      const TAO_EC_QOS_Info &event_info)
+{
+  TAO_EC_Filter_Worker worker (event, event_info);
+
+  if (event.length () != 1
+      || event[0].header.source == ACE_ES_EVENT_SOURCE_ANY
+      || event[0].header.type == ACE_ES_EVENT_ANY)
+    {
+      this->event_channel_->for_each_consumer (&worker);
+      return;
+    }
+
+  CORBA::Long const source = event[0].header.source;
+  CORBA::Long const type = event[0].header.type;
+
+  Entry *entries[3];
+  {
+    ACE_READ_GUARD (TAO_SYNCH_RW_MUTEX, ace_mon, this->lock_);
+    entries[0] = this->find_i (Key (source, type));
+    entries[1] = this->find_i (Key (source, ACE_ES_EVENT_ANY));
+    entries[2] = this->find_i (Key (ACE_ES_EVENT_SOURCE_ANY, type));
+  }
+
+  try
+    {
+      for (Entry *entry : entries)
+        {
+          if (entry != nullptr)
+            entry->collection_->for_each (&worker);
+        }
+      this->any_->collection_->for_each (&worker);
+    }
+  catch (...)
+    {
+      for (Entry *entry : entries)
+        {
+          if (entry != nullptr)
+            this->release (entry);
+        }
+      throw;
+    }
+
+  for (Entry *entry : entries)
+    {
+      if (entry != nullptr)
+        this->release (entry);
+    }
+}
+
+CORBA::ULong
+TAO_EC_Indexed_Supplier_Filter::_incr_refcnt ()
+{
+  return 1;
+}
+
+CORBA::ULong
+TAO_EC_Indexed_Supplier_Filter::_decr_refcnt ()
+{
+  return 1;
+}
+
+// ****************************************************************
+
+TAO_EC_Indexed_Supplier_Filter_Builder::
+  TAO_EC_Indexed_Supplier_Filter_Builder (TAO_EC_Event_Channel_Base *ec)
+  :  filter_ (ec)
+{
+}
+
+TAO_EC_Supplier_Filter*
+TAO_EC_Indexed_Supplier_Filter_Builder::create (
+    RtecEventChannelAdmin::SupplierQOS&)
+{
+  return &this->filter_;
+}
+
+void
+TAO_EC_Indexed_Supplier_Filter_Builder::destroy (
+    TAO_EC_Supplier_Filter*)
+{
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
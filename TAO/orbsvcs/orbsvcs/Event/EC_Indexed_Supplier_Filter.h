@@ -0,0 +1,235 @@
+// -*- C++ -*-
+
+/**
+ *  @file   EC_Indexed_Supplier_Filter.h
+ *
+ *  Supplier filter that routes events through an index of the
+ *  consumer subscriptions, keyed on the event source and type.
+ */
+
+#ifndef TAO_EC_INDEXED_SUPPLIER_FILTER_H
+#define TAO_EC_INDEXED_SUPPLIER_FILTER_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Event/EC_Supplier_Filter.h"
+#include "orbsvcs/Event/EC_Supplier_Filter_Builder.h"
+
+#include /**/ "orbsvcs/Event/event_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Unbounded_Set.h"
+#include "ace/Functor_T.h"
+#include "ace/Null_Mutex.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template<class PROXY> class TAO_ESF_Proxy_Collection;
+class TAO_EC_Event_Channel_Base;
+
+// ****************************************************************
+
+/**
+ * @class TAO_EC_Indexed_Supplier_Filter
+ *
+ * @brief Route the events to the consumers through an index of
+ * their subscriptions.
+ *
+ * A single index is shared by all the suppliers of the event
+ * channel.  It maps each (source, type) pair, where either may be
+ * a wildcard, to the collection of the consumers that subscribed
+ * to it, so an event only visits the consumers of the exact pair
+ * and of the two wildcard pairs that match it, instead of every
+ * consumer connected to the event channel.  The index is updated
+ * when consumers connect, reconnect with a new QoS or disconnect.
+ *
+ * The pairs are taken from the type and source of the event
+ * headers in the consumer subscriptions.  Consumers whose
+ * subscriptions use negation, bitmasks or masked types, or that
+ * subscribe to any event, are kept in a collection visited for
+ * every event.  A consumer is stored in the index so that no event
+ * reaches it through two collections, consumers that subscribe to
+ * a wildcard source as well as to a wildcard type also go to that
+ * collection.
+ *
+ * Events with a wildcard source or type, and sets of more than one
+ * event, are sent to all the consumers like with the trivial
+ * supplier filter.  As with that filter the publications of the
+ * suppliers are not used.
+ */
+class TAO_RTEvent_Serv_Export TAO_EC_Indexed_Supplier_Filter : public TAO_EC_Supplier_Filter
+{
+public:
+  /// Constructor
+  TAO_EC_Indexed_Supplier_Filter (TAO_EC_Event_Channel_Base* ec);
+
+  /// Destructor
+  virtual ~TAO_EC_Indexed_Supplier_Filter ();
+
+  // = The TAO_EC_Supplier_Filter methods.
+  virtual void bind (TAO_EC_ProxyPushConsumer* consumer);
+  virtual void unbind (TAO_EC_ProxyPushConsumer* consumer);
+  virtual void connected (TAO_EC_ProxyPushSupplier* supplier);
+  virtual void reconnected (TAO_EC_ProxyPushSupplier* supplier);
+  virtual void disconnected (TAO_EC_ProxyPushSupplier* supplier);
+  virtual void shutdown ();
+  virtual void push (const RtecEventComm::EventSet& event,
+                     TAO_EC_ProxyPushConsumer *consumer);
+  virtual void push_scheduled_event (RtecEventComm::EventSet &event,
+                                     const TAO_EC_QOS_Info &event_info);
+  virtual CORBA::ULong _decr_refcnt ();
+  virtual CORBA::ULong _incr_refcnt ();
+
+private:
+  typedef TAO_ESF_Proxy_Collection<TAO_EC_ProxyPushSupplier> Collection;
+
+  /// A (source, type) pair, zero is the wildcard for both.
+  struct Key
+  {
+    Key (CORBA::Long source = 0, CORBA::Long type = 0);
+
+    bool operator== (const Key &rhs) const;
+
+    u_long hash () const;
+
+    CORBA::Long source_;
+    CORBA::Long type_;
+  };
+
+  typedef ACE_Unbounded_Set<Key> Key_Set;
+
+  /// A collection of consumers and the pair it is indexed by.
+  struct Entry
+  {
+    Entry (const Key &key, Collection *collection);
+
+    Key key_;
+    Collection *collection_;
+
+    /// The consumers stored in the collection, changed with the write
+    /// lock held.
+    CORBA::ULong consumers_;
+
+    /// One for the index, plus one for each event being pushed
+    /// through the collection.
+    std::atomic<CORBA::ULong> refcount_;
+  };
+
+  /// The entries a consumer is stored in.
+  typedef ACE_Unbounded_Set<Entry *> Entry_Set;
+
+  typedef ACE_Hash_Map_Manager_Ex<Key,
+                                  Entry *,
+                                  ACE_Hash<Key>,
+                                  ACE_Equal_To<Key>,
+                                  ACE_Null_Mutex> Index;
+
+  typedef ACE_Hash_Map_Manager_Ex<TAO_EC_ProxyPushSupplier *,
+                                  Entry_Set *,
+                                  ACE_Pointer_Hash<TAO_EC_ProxyPushSupplier *>,
+                                  ACE_Equal_To<TAO_EC_ProxyPushSupplier *>,
+                                  ACE_Null_Mutex> Consumer_Map;
+
+  /// Find the pairs @a qos subscribes to.  Return false if the
+  /// consumer must see every event.
+  static bool index_keys (const RtecEventChannelAdmin::ConsumerQOS &qos,
+                          Key_Set &keys);
+
+  /// Add @a supplier to the collections of its subscriptions, unless
+  /// it is already in the index.  The write lock must be held.
+  void connected_i (TAO_EC_ProxyPushSupplier *supplier);
+
+  /// Remove from the index the entries of @a entries that have no
+  /// consumer, and empty the set.  The write lock must be held.
+  void discard_empty_i (Entry_Set &entries);
+
+  /// Remove @a supplier from the index.  The write lock must be held.
+  /// The entries left without consumers are removed from the index
+  /// and added to @a garbage.
+  void disconnected_i (TAO_EC_ProxyPushSupplier *supplier,
+                       Entry_Set &garbage);
+
+  /// Remove every consumer from the index.  The write lock must be
+  /// held.
+  void clear_i (Entry_Set &garbage);
+
+  /// Return the entry of @a key, creating it if needed.  The write
+  /// lock must be held.
+  Entry *entry (const Key &key);
+
+  /// Find the entry of @a key and add a reference to it.  The read
+  /// lock must be held.
+  Entry *find_i (const Key &key);
+
+  /// Drop a reference to @a entry, destroying it with the last one.
+  void release (Entry *entry);
+
+  /// Drop the reference of the index to the entries in @a garbage.
+  void release (Entry_Set &garbage);
+
+  /// The event channel, used to create the collections and to locate
+  /// all the consumers.
+  TAO_EC_Event_Channel_Base *event_channel_;
+
+  /// The collections of consumers, indexed by their pairs.  An entry
+  /// is removed once its last consumer disconnects, the events being
+  /// pushed through it keep it alive.
+  Index index_;
+
+  /// The consumers that must see every event, never removed from the
+  /// index.
+  Entry *any_;
+
+  /// The entries each consumer in the index is stored in.
+  Consumer_Map consumers_;
+
+  /// The suppliers bound to the filter.  The consumers only report
+  /// their disconnection through the suppliers, so the index is
+  /// cleared when the last supplier goes away, and rebuilt by the
+  /// next one.
+  CORBA::ULong suppliers_;
+
+  /// Protects the index and the consumer map, events only take the
+  /// read lock.
+  TAO_SYNCH_RW_MUTEX lock_;
+};
+
+// ****************************************************************
+
+/**
+ * @class TAO_EC_Indexed_Supplier_Filter_Builder
+ *
+ * @brief Create a single Indexed_Supplier_Filter.
+ *
+ * This Factory creates a single Indexed_Supplier_Filter that is
+ * used by all the suppliers (i.e. ProxyConsumers) of an event
+ * channel.
+ */
+class TAO_RTEvent_Serv_Export TAO_EC_Indexed_Supplier_Filter_Builder : public TAO_EC_Supplier_Filter_Builder
+{
+public:
+  /// constructor....
+  TAO_EC_Indexed_Supplier_Filter_Builder (TAO_EC_Event_Channel_Base* ec);
+
+  // = The TAO_EC_Supplier_Filter_Builder methods...
+  virtual TAO_EC_Supplier_Filter*
+      create (RtecEventChannelAdmin::SupplierQOS& qos);
+  virtual void
+      destroy (TAO_EC_Supplier_Filter *filter);
+
+private:
+  /// The filter....
+  TAO_EC_Indexed_Supplier_Filter filter_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_EC_INDEXED_SUPPLIER_FILTER_H */
@@ -21,6 +21,12 @@ TAO_FT_Invocation_Endpoint_Selector::~TAO_FT_Invocation_Endpoint_Selector ()
 {
 }
 
+bool
+TAO_FT_Invocation_Endpoint_Selector::transport_affinity () const
+{
+  return false;
+}
+
 void
 TAO_FT_Invocation_Endpoint_Selector::select_endpoint (
     TAO::Profile_Transport_Resolver *r,
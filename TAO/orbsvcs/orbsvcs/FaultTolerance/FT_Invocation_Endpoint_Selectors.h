@@ -58,6 +58,9 @@ public:
   virtual void select_endpoint (TAO::Profile_Transport_Resolver *r,
                                 ACE_Time_Value *val);
 
+  /// The primary may move to another profile, always select it.
+  virtual bool transport_affinity () const;
+
 protected:
   /// Select the primary and try connecting to it.
   bool select_primary (TAO::Profile_Transport_Resolver *r,
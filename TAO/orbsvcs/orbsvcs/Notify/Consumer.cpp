@@ -19,6 +19,9 @@
 
 #include "ace/Bound_Ptr.h"
 #include "ace/Unbounded_Queue.h"
+#include "ace/Truncate.h"
+
+#include <utility>
 
 #ifndef DEBUG_LEVEL
 # define DEBUG_LEVEL TAO_debug_level
@@ -36,6 +39,13 @@ TAO_Notify_Consumer::TAO_Notify_Consumer (TAO_Notify_ProxySupplier* proxy)
 , max_batch_size_ (CosNotification::MaximumBatchSize, 0)
 , timer_id_ (-1)
 , timer_ (0)
+, concurrency_ (0)
+, async_batches_ (false)
+, in_flight_ (0)
+, draining_ (false)
+, order_policy_ (CosNotification::AnyOrder)
+, round_trip_usec_ (0)
+, arrival_usec_ (0)
 {
   Request_Queue* pending_events = 0;
   ACE_NEW (pending_events, TAO_Notify_Consumer::Request_Queue ());
@@ -79,6 +89,10 @@ void
 TAO_Notify_Consumer::qos_changed (const TAO_Notify_QoSProperties& qos_properties)
 {
   this->max_batch_size_ = qos_properties.maximum_batch_size ();
+
+  const TAO_Notify_Property_Short& order = qos_properties.order_policy ();
+  this->order_policy_ =
+    order.is_valid () ? order.value () : CosNotification::AnyOrder;
 }
 
 void
@@ -108,13 +122,72 @@ TAO_Notify_Consumer::enqueue_request (
     request
     ));
   ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock ());
-  this->pending_events().enqueue_tail (queue_entry);
+  if (this->concurrency_ != 0)
+    {
+      this->event_arrived ();
+      this->enqueue_pending (queue_entry);
+    }
+  else
+    this->pending_events().enqueue_tail (queue_entry);
+}
+
+void
+TAO_Notify_Consumer::enqueue_pending (
+  TAO_Notify_Method_Request_Event_Queueable * request)
+{
+  Request_Queue& queue = this->pending_events ();
+  queue.enqueue_tail (request);
+  if (this->order_policy_ != CosNotification::PriorityOrder &&
+      this->order_policy_ != CosNotification::DeadlineOrder)
+    return;
+
+  // Same order as ACE_Message_Queue::enqueue_prio and enqueue_deadline,
+  // which the admin's queue uses: the new request goes after the ones
+  // it does not precede, and the rest move down one place.
+  bool const by_deadline =
+    this->order_policy_ == CosNotification::DeadlineOrder;
+  TAO_Notify_Method_Request_Event_Queueable* carry = 0;
+  TAO_Notify_Method_Request_Event_Queueable** entry = 0;
+  for (ACE_Unbounded_Queue_Iterator<TAO_Notify_Method_Request_Event_Queueable*>
+         iter (queue);
+       iter.next (entry) != 0;
+       iter.advance ())
+    {
+      if (carry == 0)
+        {
+          if (*entry == request)
+            break;
+          bool const precedes = by_deadline
+            ? request->msg_deadline_time () < (*entry)->msg_deadline_time ()
+            : request->msg_priority () > (*entry)->msg_priority ();
+          if (!precedes)
+            continue;
+          carry = request;
+        }
+      std::swap (carry, *entry);
+    }
 }
 
 bool
 TAO_Notify_Consumer::enqueue_if_necessary (TAO_Notify_Method_Request_Event * request)
 {
   ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock (), false);
+  if (this->concurrency_ != 0)
+    {
+      // Pushing asynchronously: every event goes through the queue.
+      TAO_Notify_Event::Ptr event (
+        request->event ()->queueable_copy ());
+      TAO_Notify_Method_Request_Event_Queueable * queue_entry;
+      ACE_NEW_THROW_EX (queue_entry,
+                        TAO_Notify_Method_Request_Event_Queueable (*request,
+                                                                   event),
+                        CORBA::NO_MEMORY ());
+      this->event_arrived ();
+      this->enqueue_pending (queue_entry);
+      if (! this->is_suspended_ && this->timer_id_ == -1)
+        this->dispatch_pending_i (ace_mon);
+      return true;
+    }
   if (! this->pending_events().is_empty ())
     {
       if (DEBUG_LEVEL > 3)
@@ -480,8 +553,14 @@ TAO_Notify_Consumer::dispatch_pending ()
   // lock ourselves in memory for the duration
   TAO_Notify_Consumer::Ptr self_grd (this);
 
-  // dispatch events until: 1) the queue is empty; 2) the proxy shuts down, or 3) the dispatch fails
   ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock ());
+  if (this->concurrency_ != 0)
+    {
+      this->dispatch_pending_i (ace_mon);
+      return;
+    }
+
+  // dispatch events until: 1) the queue is empty; 2) the proxy shuts down, or 3) the dispatch fails
   bool ok = true;
   while (ok
          && !this->proxy_supplier ()->has_shutdown ()
@@ -495,6 +574,256 @@ TAO_Notify_Consumer::dispatch_pending ()
     }
 }
 
+// FUZZ: disable check_for_ACE_Guard
+void
+TAO_Notify_Consumer::dispatch_pending_i (ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
+{
+// FUZZ: enable check_for_ACE_Guard
+  // The thread already sending will find the new events.
+  if (this->draining_)
+    return;
+  this->draining_ = true;
+
+  // send events until: 1) the queue is empty; 2) the proxy shuts down,
+  // 3) a push could not be sent and the timer will retry it, or
+  // 4) concurrency_ pushes are in progress.  Like the synchronous
+  // dispatch_pending (), a pacing timer does not hold the events back.
+  while (!this->proxy_supplier ()->has_shutdown ()
+         && !this->pending_events().is_empty ()
+         && this->in_flight_ < this->concurrency_)
+    {
+      size_t const batch_size = this->async_batch_size ();
+      Request_Queue * requests = 0;
+      ACE_NEW_NORETURN (requests, Request_Queue);
+      if (requests == 0)
+        {
+          this->schedule_timer (true);
+          break;
+        }
+      TAO_Notify_Method_Request_Event_Queueable * request = 0;
+      while (requests->size () < batch_size
+             && this->pending_events().dequeue_head (request) == 0)
+        {
+          requests->enqueue_tail (request);
+        }
+
+      ++this->in_flight_;
+      ace_mon.release ();
+      bool sent = true;
+      DispatchStatus status = DISPATCH_SUCCESS;
+      try
+        {
+          this->push_async (requests);
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          sent = false;
+          status = this->push_exception_status (ex);
+        }
+      ace_mon.acquire ();
+      if (! sent)
+        {
+          this->push_completed_i (requests, status, ace_mon);
+          if (this->timer_id_ != -1)
+            break;
+        }
+    }
+
+  this->draining_ = false;
+}
+
+void
+TAO_Notify_Consumer::push_completed (Request_Queue * requests,
+                                     DispatchStatus status,
+                                     const ACE_Time_Value & sent)
+{
+  TAO_Notify_Consumer::Ptr self_grd (this);
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock ());
+  if (status == DISPATCH_SUCCESS)
+    {
+      ACE_UINT64 usec = 0;
+      (ACE_OS::gettimeofday () - sent).to_usec (usec);
+      this->round_trip_usec_ = this->round_trip_usec_ == 0
+        ? usec
+        : (7 * this->round_trip_usec_ + usec) / 8;
+    }
+
+  this->push_completed_i (requests, status, ace_mon);
+
+  if (! this->is_suspended_ && this->timer_id_ == -1)
+    this->dispatch_pending_i (ace_mon);
+}
+
+// FUZZ: disable check_for_ACE_Guard
+void
+TAO_Notify_Consumer::push_completed_i (Request_Queue * requests,
+                                       DispatchStatus status,
+                                       ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
+{
+// FUZZ: enable check_for_ACE_Guard
+  --this->in_flight_;
+
+  // The events to retry go back to the head of the queue in their
+  // original order, ahead of the events that were not sent yet.  Pushes
+  // still in progress may deliver later events first.
+  Request_Queue retry;
+  TAO_Notify_Method_Request_Event_Queueable * request = 0;
+  while (requests->dequeue_head (request) == 0)
+    {
+      if (status != DISPATCH_SUCCESS
+          && request->should_retry ()
+          && this->pending_events_.get () != 0)
+        {
+          if (DEBUG_LEVEL > 0)
+            ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                        static_cast<int> (this->proxy ()->id ()),
+                        request->sequence ()));
+          retry.enqueue_head (request);
+        }
+      else
+        {
+          if (status != DISPATCH_SUCCESS && DEBUG_LEVEL > 0)
+            ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                        static_cast<int> (this->proxy ()->id ()),
+                        request->sequence ()));
+          request->complete ();
+          request->release ();
+        }
+    }
+  delete requests;
+
+  bool const retrying = ! retry.is_empty ();
+  while (retry.dequeue_head (request) == 0)
+    this->pending_events().enqueue_head (request);
+
+  if (status == DISPATCH_FAIL || status == DISPATCH_FAIL_TIMEOUT)
+    {
+      ace_mon.release ();
+      try
+        {
+          this->proxy_supplier ()->destroy (status == DISPATCH_FAIL_TIMEOUT);
+        }
+      catch (const CORBA::Exception&)
+        {
+          // todo is there something meaningful we can do here?
+        }
+      ace_mon.acquire ();
+    }
+  else if (retrying)
+    {
+      this->schedule_timer (true);
+    }
+}
+
+TAO_Notify_Consumer::DispatchStatus
+TAO_Notify_Consumer::push_exception_status (const CORBA::Exception & ex)
+{
+  if (DEBUG_LEVEL > 0)
+    ORBSVCS_DEBUG ((LM_ERROR,
+                ACE_TEXT ("(%P|%t) TAO_Notify_Consumer %d::push_async() %s\n"),
+                static_cast<int> (this->proxy ()->id ()),
+                ex._info ().c_str ()
+                ));
+
+  if (CORBA::OBJECT_NOT_EXIST::_downcast (&ex) != 0
+      || CORBA::COMM_FAILURE::_downcast (&ex) != 0)
+    return DISPATCH_FAIL;
+
+  if (CORBA::TIMEOUT::_downcast (&ex) != 0)
+    return DISPATCH_FAIL_TIMEOUT;
+
+  const CORBA::TRANSIENT * transient = CORBA::TRANSIENT::_downcast (&ex);
+  if (transient != 0)
+    {
+      const CORBA::ULong BITS_5_THRU_12_MASK = 0x00000f80u;
+      switch (transient->minor () & 0xfffff000u)
+        {
+        case CORBA::OMGVMCID:
+          switch (transient->minor () & 0x00000fffu)
+            {
+            case 2: // No usable profile
+            case 3: // Request cancelled
+            case 4: // POA destroyed
+              return DISPATCH_FAIL;
+            default:
+              return DISPATCH_DISCARD;
+            }
+
+        case TAO::VMCID:
+        default:
+          switch (transient->minor () & BITS_5_THRU_12_MASK)
+            {
+            case TAO_INVOCATION_SEND_REQUEST_MINOR_CODE:
+              return DISPATCH_FAIL;
+            case TAO_POA_DISCARDING:
+            case TAO_POA_HOLDING:
+            default:
+              return DISPATCH_RETRY;
+            }
+        }
+    }
+
+  return DISPATCH_DISCARD;
+}
+
+size_t
+TAO_Notify_Consumer::async_batch_size ()
+{
+  if (! this->async_batches_)
+    return 1;
+
+  // Share the queued events among the idle pushes, but give each push at
+  // least the events that arrive during a round trip divided by the
+  // number of pushes, so the consumer keeps up without many small pushes.
+  size_t const queued = this->pending_events().size ();
+  size_t const idle = this->concurrency_ - this->in_flight_;
+  size_t batch_size = (queued + idle - 1) / idle;
+  if (this->arrival_usec_ != 0)
+    {
+      size_t const keep_up = static_cast<size_t> (
+        this->round_trip_usec_ / (this->arrival_usec_ * this->concurrency_)) + 1;
+      if (batch_size < keep_up)
+        batch_size = keep_up;
+    }
+  if (batch_size > queued)
+    batch_size = queued;
+
+  return this->queue_batch_size (batch_size);
+}
+
+void
+TAO_Notify_Consumer::event_arrived ()
+{
+  ACE_Time_Value const now = ACE_OS::gettimeofday ();
+  if (this->last_arrival_ != ACE_Time_Value::zero)
+    {
+      ACE_UINT64 usec = 0;
+      (now - this->last_arrival_).to_usec (usec);
+      this->arrival_usec_ = this->arrival_usec_ == 0
+        ? usec
+        : (7 * this->arrival_usec_ + usec) / 8;
+    }
+  this->last_arrival_ = now;
+}
+
+void
+TAO_Notify_Consumer::push_async (Request_Queue *)
+{
+  throw CORBA::NO_IMPLEMENT ();
+}
+
+CORBA::ULong
+TAO_Notify_Consumer::queue_batch_size (size_t queue_size) const
+{
+  size_t batch_size = queue_size;
+  if (this->max_batch_size_.is_valid ()
+      && this->max_batch_size_.value () > 0
+      && batch_size > static_cast<size_t> (this->max_batch_size_.value ()))
+    batch_size = this->max_batch_size_.value ();
+
+  return ACE_Utils::truncate_cast<CORBA::ULong> (batch_size);
+}
+
 
 // virtual: this is the default, overridden for SequencePushConsumer
 // FUZZ: disable check_for_ACE_Guard
@@ -588,6 +917,159 @@ TAO_Notify_Consumer::dispatch_from_queue (
   return result;
 }
 
+// FUZZ: disable check_for_ACE_Guard
+bool
+TAO_Notify_Consumer::dispatch_batch_from_queue (
+  Request_Queue & requests,
+  ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon,
+  CORBA::Long batch_size)
+{
+// FUZZ: enable check_for_ACE_Guard
+  bool result = true;
+  if (batch_size > 0)
+  {
+    CosNotification::EventBatch batch (batch_size);
+    batch.length (batch_size);
+
+    Request_Queue completed;
+
+    CORBA::Long pos = 0;
+    TAO_Notify_Method_Request_Event_Queueable * request = 0;
+    while (pos < batch_size && requests.dequeue_head (request) == 0)
+    {
+      if (DEBUG_LEVEL > 0)
+      {
+        ORBSVCS_DEBUG ( (LM_DEBUG,
+          ACE_TEXT ("(%P|%t) Batch Dispatch Method_Request_Dispatch @%@\n"),
+          request));
+      }
+
+      const TAO_Notify_Event * ev = request->event ();
+      ev->convert (batch [pos]);
+      ++pos;
+
+      // note enqueue at head, use queue as stack.
+      completed.enqueue_head (request);
+    }
+    batch.length (pos);
+    ACE_ASSERT (pos > 0);
+
+    ace_mon.release ();
+    bool from_timeout = false;
+    TAO_Notify_Consumer::DispatchStatus status =
+      this->dispatch_batch (batch);
+    ace_mon.acquire ();
+    switch (status)
+    {
+    case DISPATCH_SUCCESS:
+      {
+        TAO_Notify_Method_Request_Event_Queueable * request = 0;
+        while (completed.dequeue_head (request) == 0)
+        {
+          request->complete ();
+          request->release ();
+        }
+        result = true;
+        break;
+      }
+    case DISPATCH_FAIL_TIMEOUT:
+      from_timeout = true;
+      // Fall through
+    case DISPATCH_FAIL:
+      {
+        TAO_Notify_Method_Request_Event_Queueable * request = 0;
+        while (completed.dequeue_head (request) == 0)
+        {
+          if (request->should_retry ())
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                          static_cast <int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            requests.enqueue_head (request);
+            result = false;
+          }
+          else
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            request->complete ();
+            request->release ();
+          }
+        }
+        while (requests.dequeue_head (request) == 0)
+        {
+          if (request->should_retry ())
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            requests.enqueue_head (request);
+            result = false;
+          }
+          else
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            request->complete ();
+            request->release ();
+          }
+        }
+        ace_mon.release();
+        try
+        {
+          this->proxy_supplier ()->destroy (from_timeout);
+        }
+        catch (const CORBA::Exception&)
+        {
+          // todo is there something meaningful we can do here?
+          ;
+        }
+        ace_mon.acquire();
+        break;
+      }
+    case DISPATCH_RETRY:
+    case DISPATCH_DISCARD:
+      {
+        TAO_Notify_Method_Request_Event_Queueable *  request = 0;
+        while (completed.dequeue_head (request) == 0)
+        {
+          if (request->should_retry ())
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            requests.enqueue_head (request);
+            result = false;
+          }
+          else
+          {
+            if (DEBUG_LEVEL > 0)
+              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
+                          static_cast<int> (this->proxy ()->id ()),
+                          request->sequence ()));
+            request->complete ();
+            request->release ();
+          }
+        }
+        break;
+      }
+    default:
+      {
+        result = false;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 /// @todo: rather than is_error, use pacing interval so it will be configurable
 /// @todo: find some way to use batch buffering strategy for sequence consumers.
 void
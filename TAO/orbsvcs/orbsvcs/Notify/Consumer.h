@@ -122,14 +122,24 @@ typedef TAO_Notify_Refcountable_Guard_T< TAO_Notify_Consumer > Ptr;
   /// have not been passed to this consumer for delivery yet.
   size_t pending_count (void);
 
+  typedef ACE_Unbounded_Queue<TAO_Notify_Method_Request_Event_Queueable *> Request_Queue;
+
+  /// Called by the reply handler when the asynchronous push of
+  /// @a requests, sent at @a sent, completes with @a status.
+  /// Takes ownership of @a requests.
+  void push_completed (Request_Queue * requests,
+                       DispatchStatus status,
+                       const ACE_Time_Value & sent);
+
+  /// The DispatchStatus for an exception raised by a push.
+  DispatchStatus push_exception_status (const CORBA::Exception & ex);
+
 protected:
 
   /// This method is called by the is_alive() method.  It should provide
   /// the connected consumer or nil if there is none.
   virtual CORBA::Object_ptr get_consumer (void) = 0;
 
-  typedef ACE_Unbounded_Queue<TAO_Notify_Method_Request_Event_Queueable *> Request_Queue;
-
   DispatchStatus dispatch_request (TAO_Notify_Method_Request_Event * request);
 
 // FUZZ: disable check_for_ACE_Guard
@@ -140,14 +150,38 @@ protected:
    * If delivery fails, events are left in the queue (or discarded depending
    * on QoS parameters.)
    * Undelivered, undiscarded requests are left at the front of the queue.
-   * Overridden in sequence consumer to dispatch as an EventBatch.
+   * Overridden in the sequence and structured consumers to dispatch as
+   * an EventBatch.
    * \return false if delivery failed and the request(s) cannot be discarded.
    */
   virtual bool dispatch_from_queue (
     Request_Queue & requests,
     ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+
+  /**
+   * \brief Dispatch up to @a batch_size events from a queue as one
+   * EventBatch.
+   *
+   * Used by the dispatch_from_queue overrides of the consumers that
+   * accept sequences of events.
+   * \return false if delivery failed and the request(s) cannot be discarded.
+   */
+  bool dispatch_batch_from_queue (
+    Request_Queue & requests,
+    ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon,
+    CORBA::Long batch_size);
 // FUZZ: enable check_for_ACE_Guard
 
+  /// The number of queued events to push in one batch: all of them,
+  /// up to the MaximumBatchSize QoS.
+  CORBA::ULong queue_batch_size (size_t queue_size) const;
+
+  /// Send the events in @a requests to the consumer with AMI.  Takes
+  /// ownership of @a requests, which come back through push_completed(),
+  /// unless an exception is raised.  Overridden by the consumers that
+  /// set concurrency_.
+  virtual void push_async (Request_Queue * requests);
+
   void enqueue_request(TAO_Notify_Method_Request_Event * request);
 
   /// Add request to a queue if necessary.
@@ -204,7 +238,55 @@ protected:
   /// via _non_exist call.
   ACE_Atomic_Op<TAO_SYNCH_MUTEX, ACE_Time_Value> last_ping_;
 
+  /// The number of asynchronous pushes that may be in progress at
+  /// once.  0 pushes the events synchronously.  Set by the consumers
+  /// that implement push_async().
+  CORBA::ULong concurrency_;
+
+  /// True if push_async() accepts more than one event.
+  bool async_batches_;
+
 private:
+// FUZZ: disable check_for_ACE_Guard
+  /// Send the pending events with push_async() while fewer than
+  /// concurrency_ pushes are in progress.  The proxy lock must be held
+  /// and is released while sending.  Returns at once if another thread
+  /// is sending them, so the events go out in order.
+  void dispatch_pending_i (ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+
+  /// Complete, requeue or discard the events of a push that ended.
+  void push_completed_i (Request_Queue * requests,
+                         DispatchStatus status,
+                         ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+// FUZZ: enable check_for_ACE_Guard
+
+  /// Queue @a request for an asynchronous push, ahead of the queued
+  /// events it precedes in the OrderPolicy.  The proxy lock must be held.
+  void enqueue_pending (TAO_Notify_Method_Request_Event_Queueable * request);
+
+  /// The number of events for the next asynchronous push.
+  size_t async_batch_size (void);
+
+  /// Update the mean time between events.  The proxy lock must be held.
+  void event_arrived (void);
+
+  /// The number of asynchronous pushes in progress.
+  CORBA::ULong in_flight_;
+
+  /// True while a thread is sending the pending events.
+  bool draining_;
+
+  /// The OrderPolicy QoS.  The events the dispatching threads hand over
+  /// without waiting for the pushes are sorted here instead of in the
+  /// admin's queue.
+  CORBA::Short order_policy_;
+
+  /// Smoothed push round trip time and time between events, in
+  /// microseconds, measured while pushing asynchronously.
+  ACE_UINT64 round_trip_usec_;
+  ACE_UINT64 arrival_usec_;
+  ACE_Time_Value last_arrival_;
+
   /// Events pending to be delivered.
   ACE_Auto_Ptr<Request_Queue> pending_events_;
 
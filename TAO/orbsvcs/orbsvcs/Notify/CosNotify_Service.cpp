@@ -219,6 +219,25 @@ TAO_CosNotify_Service::init (int argc, ACE_TCHAR *argv[])
         if (current_arg != 0)
           arg_shifter.consume_arg ();
       }
+      else if (arg_shifter.cur_arg_strncasecmp (ACE_TEXT("-ConsumerConcurrency")) == 0)
+      {
+        current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-ConsumerConcurrency"));
+        if (current_arg != 0 && ACE_OS::atoi (current_arg) >= 0)
+        {
+          properties->consumer_concurrency (
+            static_cast<CORBA::ULong> (ACE_OS::atoi (current_arg)));
+        }
+        else
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+            ACE_TEXT ("(%P|%t) WARNING: Unrecognized ")
+            ACE_TEXT ("argument (%s).  Ignoring invalid ")
+            ACE_TEXT ("-ConsumerConcurrency usage.\n"),
+            (current_arg == 0 ? ACE_TEXT ("''") : current_arg)));
+        }
+        if (current_arg != 0)
+          arg_shifter.consume_arg ();
+      }
       else
       {
         ORBSVCS_ERROR ((LM_ERROR,
@@ -79,6 +79,7 @@ TAO_Notify_Constraint_Expr::load_child (
     this->constr_expr.event_types[len].type_name = CORBA::string_dup (type);
 
     this->interpreter.build_tree (this->constr_expr);
+    this->program.reset ();
   }
 
   return result;
@@ -98,6 +99,7 @@ TAO_Notify_ETCL_Filter::TAO_Notify_ETCL_Filter (PortableServer::POA_ptr poa,
                                                 const char *constraint_grammar,
                                                 const TAO_Notify_Object::ID& id)
   :constraint_expr_ids_ (0),
+   pending_compile_ (false),
    poa_ (PortableServer::POA::_duplicate (poa)),
    id_ (id),
    grammar_ (constraint_grammar)
@@ -179,6 +181,8 @@ TAO_Notify_ETCL_Filter::add_constraint_i
 
   notify_constr_expr->interpreter.build_tree (expr);
 
+  this->compile_i (notify_constr_expr);
+
   notify_constr_expr->constr_expr = expr;
 
   if (cnstr_id == 0)
@@ -428,6 +432,19 @@ TAO_Notify_ETCL_Filter::remove_all_constraints_i ()
     }
 
   this->constraint_expr_list_.unbind_all ();
+  this->slots_.unbind_all ();
+}
+
+void
+TAO_Notify_ETCL_Filter::compile_i (TAO_Notify_Constraint_Expr *expr)
+{
+  expr->interpreter.compile (expr->program, this->slots_);
+
+  size_t const slot_count = this->slots_.current_size ();
+
+  if (this->slot_values_.size () < slot_count
+      && this->slot_values_.size (slot_count) != 0)
+    throw CORBA::NO_MEMORY ();
 }
 
 void
@@ -463,6 +480,73 @@ TAO_Notify_ETCL_Filter::match_structured (
   CONSTRAINT_EXPR_LIST::ITERATOR iter (this->constraint_expr_list_);
   CONSTRAINT_EXPR_LIST::ENTRY *entry;
 
+  if (this->pending_compile_)
+    {
+      for (; iter.done () == 0; iter.advance ())
+        {
+          if (iter.next (entry) != 0
+              && entry->int_id_->program.state ()
+                   == TAO_Notify_Constraint_Program::PENDING)
+            {
+              this->compile_i (entry->int_id_);
+            }
+        }
+
+      this->pending_compile_ = false;
+      iter = CONSTRAINT_EXPR_LIST::ITERATOR (this->constraint_expr_list_);
+    }
+
+  // Find the properties read by the compiled constraints once for all
+  // of them.
+  TAO_Notify_Constraint_Program::Event_Fields fields;
+
+  if (!TAO_Notify_Constraint_Program::bind_event (
+         filterable_data,
+         this->slots_,
+         this->slot_values_.size () != 0 ? &this->slot_values_[0] : 0,
+         fields))
+    {
+      return 0;
+    }
+
+  bool interpret = false;
+
+  // Set if a program could not read the event in place, the
+  // interpreter then evaluates all the constraints.
+  bool interpret_all = false;
+
+  for (; iter.done () == 0; iter.advance ())
+    {
+      if (iter.next (entry) != 0)
+        {
+          if (entry->int_id_->program.state ()
+                != TAO_Notify_Constraint_Program::COMPILED)
+            {
+              interpret = true;
+            }
+          else
+            {
+              int const result = entry->int_id_->program.evaluate (fields);
+
+              if (result == 1)
+                {
+                  return 1;
+                }
+              else if (result == -1)
+                {
+                  interpret = interpret_all = true;
+                }
+            }
+        }
+    }
+
+  if (!interpret)
+    {
+      return 0;
+    }
+
+  // Only the constraints that could not be compiled, or evaluated,
+  // need the interpreter, and its copy of the event.
   TAO_Notify_Constraint_Visitor visitor;
 
   if (visitor.bind_structured_event (filterable_data) != 0)
@@ -471,9 +555,14 @@ TAO_Notify_ETCL_Filter::match_structured (
       return 0;
     }
 
-  for (; iter.done () == 0; iter.advance ())
+  for (iter = CONSTRAINT_EXPR_LIST::ITERATOR (this->constraint_expr_list_);
+       iter.done () == 0;
+       iter.advance ())
     {
-      if (iter.next (entry) != 0)
+      if (iter.next (entry) != 0
+          && (interpret_all
+              || entry->int_id_->program.state ()
+                   != TAO_Notify_Constraint_Program::COMPILED))
         {
           if (entry->int_id_->interpreter.evaluate (visitor) == 1)
             {
@@ -593,6 +682,10 @@ TAO_Notify_ETCL_Filter::load_child (const ACE_CString &type,
         = this->add_constraint_i (id);
       expr->load_attrs (attrs);
 
+      // The tree is built as the event types are loaded, it is
+      // compiled when the filter is first used.
+      this->pending_compile_ = true;
+
       return expr;
     }
   }
@@ -66,6 +66,10 @@ private:
 
   TAO_Notify_Constraint_Interpreter interpreter;
   // Constraint Interpreter.
+
+  TAO_Notify_Constraint_Program program;
+  // The compiled constraint, used instead of the interpreter when
+  // it is COMPILED.
 };
 
 /**
@@ -133,6 +137,10 @@ private:
 
   void remove_all_constraints_i (void);
 
+  /// Compile the tree of @a expr, the interpreter is used if it
+  /// cannot be compiled.
+  void compile_i (TAO_Notify_Constraint_Expr *expr);
+
   /// Lock to serialize access to data members.
   TAO_SYNCH_MUTEX lock_;
 
@@ -147,6 +155,16 @@ private:
 
   CONSTRAINT_EXPR_LIST constraint_expr_list_;
 
+  /// The slots of the filterable_data properties read by the compiled
+  /// constraints.
+  TAO_Notify_Constraint_Program::Slot_Map slots_;
+
+  /// The value of each slot in the event being matched.
+  ACE_Array<const CORBA::Any *> slot_values_;
+
+  /// Set when reloaded constraints have not been compiled yet.
+  bool pending_compile_;
+
   PortableServer::POA_var poa_;
 
   TAO_Notify_Object::ID id_;
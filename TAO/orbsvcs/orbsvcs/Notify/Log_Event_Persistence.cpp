@@ -0,0 +1,1181 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Notify/Log_Event_Persistence.h"
+#include "tao/debug.h"
+#include "ace/ACE.h"
+#include "ace/Dirent.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_unistd.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  // The layout of a segment file is a header followed by records, each
+  // aligned on 8 bytes:
+  //   segment header: magic, version, index, reserved (4 bytes each)
+  //   record header:  type, crc, id (8 bytes), event length,
+  //                   routing slip length
+  //   payload:        the event then the routing slip
+  // All the integers are big endian.  The crc covers the record but for
+  // the crc itself, so a torn record ends the segment like the zero
+  // filled space after the last record.
+  const ACE_UINT32 segment_magic = 0x544E4C47; // "TNLG"
+  const ACE_UINT32 segment_version = 1;
+  const size_t segment_header_size = 16;
+  const size_t record_header_size = 24;
+  const size_t record_alignment = 8;
+
+  /// The most bytes of events a flush copies out of the oldest segment.
+  const size_t compaction_step = 64 * 1024;
+
+  const ACE_TCHAR segment_prefix[] = ACE_TEXT ("segment.");
+  const size_t segment_prefix_length =
+    sizeof (segment_prefix) / sizeof (segment_prefix[0]) - 1;
+
+  void
+  put_uint32 (char * buffer, ACE_UINT32 value)
+  {
+    buffer[0] = static_cast<char> (value >> 24);
+    buffer[1] = static_cast<char> (value >> 16);
+    buffer[2] = static_cast<char> (value >> 8);
+    buffer[3] = static_cast<char> (value);
+  }
+
+  ACE_UINT32
+  get_uint32 (const char * buffer)
+  {
+    const unsigned char * b = reinterpret_cast<const unsigned char *> (buffer);
+    return (static_cast<ACE_UINT32> (b[0]) << 24)
+      | (static_cast<ACE_UINT32> (b[1]) << 16)
+      | (static_cast<ACE_UINT32> (b[2]) << 8)
+      | static_cast<ACE_UINT32> (b[3]);
+  }
+
+  void
+  put_uint64 (char * buffer, ACE_UINT64 value)
+  {
+    put_uint32 (buffer, static_cast<ACE_UINT32> (value >> 32));
+    put_uint32 (buffer + 4, static_cast<ACE_UINT32> (value));
+  }
+
+  ACE_UINT64
+  get_uint64 (const char * buffer)
+  {
+    return (static_cast<ACE_UINT64> (get_uint32 (buffer)) << 32)
+      | get_uint32 (buffer + 4);
+  }
+
+  size_t
+  record_size (size_t payload_length)
+  {
+    return (record_header_size + payload_length + record_alignment - 1)
+      & ~(record_alignment - 1);
+  }
+
+  ACE_UINT32
+  record_crc (const char * record, size_t payload_length)
+  {
+    ACE_UINT32 const crc = ACE::crc32 (record, 4);
+    return ACE::crc32 (record + 8, record_header_size - 8 + payload_length, crc);
+  }
+
+  /// Copy a chain of message blocks, returns the number of bytes.
+  size_t
+  copy_chain (char * buffer, const ACE_Message_Block * mb)
+  {
+    size_t length = 0;
+    for (; mb != 0; mb = mb->cont ())
+      {
+        ACE_OS::memcpy (buffer + length, mb->rd_ptr (), mb->length ());
+        length += mb->length ();
+      }
+    return length;
+  }
+
+  /// Allocate the blocks of a new segment file, so that a full disk
+  /// fails the creation of the segment instead of a write through the
+  /// map.  Returns 0 or an errno value.
+  int
+  preallocate (ACE_HANDLE handle, size_t size)
+  {
+#if defined (ACE_LINUX)
+    return ::posix_fallocate (handle, 0, static_cast<off_t> (size));
+#else
+    char zeros[8 * 1024];
+    ACE_OS::memset (zeros, 0, sizeof (zeros));
+    for (size_t offset = 0; offset < size; offset += sizeof (zeros))
+      {
+        size_t const length =
+          size - offset < sizeof (zeros) ? size - offset : sizeof (zeros);
+        if (ACE_OS::pwrite (handle, zeros, length,
+                            static_cast<ACE_OFF_T> (offset))
+            != static_cast<ssize_t> (length))
+          {
+            return errno;
+          }
+      }
+    return 0;
+#endif /* ACE_LINUX */
+  }
+}
+
+namespace TAO_Notify
+{
+
+Log_Event_Persistence::Log_Event_Persistence ()
+  : dir_path_ (ACE_TEXT ("__PERSISTENT_EVENT_LOG__"))
+  , segment_size_ (4 * 1024 * 1024)
+  , factory_ (0)
+{
+}
+
+Log_Event_Persistence::~Log_Event_Persistence ()
+{
+}
+
+// get the current factory, creating it if necessary
+Event_Persistence_Factory *
+Log_Event_Persistence::get_factory ()
+{
+  if (this->factory_ == 0)
+  {
+    ACE_NEW_NORETURN (
+      this->factory_,
+      Log_Event_Persistence_Factory ());
+
+    if (this->factory_ != 0)
+    {
+      if (!this->factory_->open (this->dir_path_.c_str (), this->segment_size_))
+      {
+        delete this->factory_;
+        this->factory_ = 0;
+      }
+    }
+  }
+  return this->factory_;
+}
+
+// release the current factory so a new one can be created
+void
+Log_Event_Persistence::reset ()
+{
+  delete this->factory_;
+  this->factory_ = 0;
+}
+
+int
+Log_Event_Persistence::init (int argc, ACE_TCHAR *argv[])
+{
+  int result = 0;
+  bool verbose = false;
+  for (int narg = 0; narg < argc; ++narg)
+  {
+    ACE_TCHAR * av = argv[narg];
+    if (ACE_OS::strcasecmp (av, ACE_TEXT ("-v")) == 0)
+    {
+      verbose = true;
+      ORBSVCS_DEBUG ((LM_DEBUG,
+        ACE_TEXT ("(%P|%t) Log_Event_Persistence: -verbose\n")
+        ));
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-dir_path")) == 0 && narg + 1 < argc)
+    {
+      this->dir_path_ = argv[narg + 1];
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) Log_Event_Persistence: Setting -dir_path: %s\n"),
+          this->dir_path_.c_str ()
+        ));
+      }
+      narg += 1;
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-segment_size")) == 0 && narg + 1 < argc)
+    {
+      this->segment_size_ = ACE_OS::strtoul (argv[narg + 1], 0, 10);
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) Log_Event_Persistence: Setting -segment_size: %B\n"),
+          this->segment_size_
+        ));
+      }
+      narg += 1;
+    }
+    else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) Unknown parameter to Log Event Persistence: %s\n"),
+        argv[narg]
+        ));
+      result = -1;
+    }
+  }
+  return result;
+}
+
+int
+Log_Event_Persistence::fini ()
+{
+  delete this->factory_;
+  this->factory_ = 0;
+  return 0;
+}
+
+Log_Routing_Slip_Persistence_Manager::Log_Routing_Slip_Persistence_Manager (
+  Log_Event_Persistence_Factory * factory)
+  : factory_ (factory)
+  , callback_ (0)
+  , id_ (0)
+  , orphan_ (false)
+  , bound_ (false)
+  , event_ ()
+  , routing_slip_ ()
+{
+}
+
+Log_Routing_Slip_Persistence_Manager::~Log_Routing_Slip_Persistence_Manager ()
+{
+  if (this->factory_ != 0 && this->bound_)
+  {
+    this->factory_->detach (*this);
+  }
+}
+
+void
+Log_Routing_Slip_Persistence_Manager::set_callback (Persistent_Callback* callback)
+{
+  this->callback_ = callback;
+}
+
+bool
+Log_Routing_Slip_Persistence_Manager::store (const ACE_Message_Block& event,
+  const ACE_Message_Block& routing_slip)
+{
+  if (this->factory_ == 0)
+  {
+    return this->fail ();
+  }
+  return this->factory_->append (*this,
+                                 Log_Event_Persistence_Factory::RECORD_STORE,
+                                 &event,
+                                 &routing_slip);
+}
+
+bool
+Log_Routing_Slip_Persistence_Manager::update (const ACE_Message_Block& routing_slip)
+{
+  if (this->factory_ == 0)
+  {
+    return this->fail ();
+  }
+  return this->factory_->append (*this,
+                                 Log_Event_Persistence_Factory::RECORD_UPDATE,
+                                 0,
+                                 &routing_slip);
+}
+
+bool
+Log_Routing_Slip_Persistence_Manager::remove ()
+{
+  if (this->factory_ == 0)
+  {
+    return this->fail ();
+  }
+  return this->factory_->append (*this,
+                                 Log_Event_Persistence_Factory::RECORD_REMOVE,
+                                 0,
+                                 0);
+}
+
+bool
+Log_Routing_Slip_Persistence_Manager::reload (ACE_Message_Block*& event,
+  ACE_Message_Block*& routing_slip)
+{
+  event = 0;
+  routing_slip = 0;
+  return this->factory_ != 0
+    && this->factory_->reload (*this, event, routing_slip);
+}
+
+bool
+Log_Routing_Slip_Persistence_Manager::fail ()
+{
+  ORBSVCS_ERROR ((LM_ERROR,
+    ACE_TEXT ("(%P|%t) Log_Routing_Slip_Persistence_Manager: ")
+    ACE_TEXT ("the log of event %Q is closed\n"),
+    this->id_));
+  // Like the standard strategy, the routing slip is called back even
+  // if the record could not be written.
+  if (this->callback_ != 0)
+  {
+    this->callback_->persist_complete ();
+  }
+  return false;
+}
+
+Routing_Slip_Persistence_Manager *
+Log_Routing_Slip_Persistence_Manager::load_next ()
+{
+  Routing_Slip_Persistence_Manager * result = 0;
+  if (this->factory_ != 0)
+  {
+    result = this->factory_->next_reload_manager ();
+  }
+  return result;
+}
+
+Log_Event_Persistence_Factory::Log_Event_Persistence_Factory ()
+  : wake_up_thread_ (lock_)
+  , thread_active_ (false)
+  , terminate_thread_ (false)
+  , segment_size_ (0)
+  , active_ (0)
+  , next_segment_ (1)
+  , new_segment_ (false)
+  , compacting_ (0)
+  , next_id_ (1)
+{
+}
+
+Log_Event_Persistence_Factory::~Log_Event_Persistence_Factory ()
+{
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory::~Log_Event_Persistence_Factory\n")
+    ));
+  }
+  this->shutdown_thread ();
+
+  // The managers belong to their routing slips, they only have to
+  // forget about us.  The orphans and the managers not reloaded are
+  // ours.
+  for (Manager_Map::iterator i = this->managers_.begin ();
+       i != this->managers_.end ();
+       ++i)
+  {
+    Log_Routing_Slip_Persistence_Manager * rspm = (*i).item ();
+    rspm->factory_ = 0;
+    if (rspm->orphan_)
+    {
+      delete rspm;
+    }
+  }
+  this->managers_.close ();
+
+  Log_Routing_Slip_Persistence_Manager * rspm = 0;
+  while (this->reload_queue_.dequeue_head (rspm) == 0)
+  {
+    rspm->factory_ = 0;
+    delete rspm;
+  }
+
+  for (Segment_Map::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+  {
+    this->release_segment ((*i).item (), false);
+  }
+  this->segments_.close ();
+}
+
+bool
+Log_Event_Persistence_Factory::open (const ACE_TCHAR* dir_path,
+                                     size_t segment_size)
+{
+  this->dir_path_ = dir_path;
+  this->segment_size_ = segment_size;
+  if (!this->recover ())
+  {
+    return false;
+  }
+  this->thread_active_ = true;
+  if (this->thread_manager_.spawn (this->thr_func, this) == -1)
+  {
+    this->thread_active_ = false;
+    return false;
+  }
+  return true;
+}
+
+Routing_Slip_Persistence_Manager*
+Log_Event_Persistence_Factory::create_routing_slip_persistence_manager (
+  Persistent_Callback* callback)
+{
+  Routing_Slip_Persistence_Manager* rspm = 0;
+  ACE_NEW_RETURN (rspm, Log_Routing_Slip_Persistence_Manager (this), rspm);
+  rspm->set_callback (callback);
+  return rspm;
+}
+
+Routing_Slip_Persistence_Manager *
+Log_Event_Persistence_Factory::first_reload_manager ()
+{
+  return this->next_reload_manager ();
+}
+
+Routing_Slip_Persistence_Manager *
+Log_Event_Persistence_Factory::next_reload_manager ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+  Log_Routing_Slip_Persistence_Manager * rspm = 0;
+  this->reload_queue_.dequeue_head (rspm);
+  return rspm;
+}
+
+bool
+Log_Event_Persistence_Factory::append (
+  Log_Routing_Slip_Persistence_Manager & rspm,
+  Record_Type type,
+  const ACE_Message_Block * event,
+  const ACE_Message_Block * routing_slip)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, false);
+  if (!this->thread_active_)
+  {
+    // Without the flusher thread nobody would ever call back.
+    ace_mon.release ();
+    return rspm.fail ();
+  }
+  if (rspm.id_ == 0)
+  {
+    rspm.id_ = this->next_id_++;
+  }
+
+  Log_Routing_Slip_Persistence_Manager::Location event_location;
+  Log_Routing_Slip_Persistence_Manager::Location routing_slip_location;
+  bool const result = this->append_i (type,
+                                      rspm.id_,
+                                      event,
+                                      routing_slip,
+                                      event_location,
+                                      routing_slip_location);
+  if (result)
+  {
+    switch (type)
+    {
+    case RECORD_STORE:
+      this->release_location (rspm.event_);
+      this->release_location (rspm.routing_slip_);
+      rspm.event_ = event_location;
+      rspm.routing_slip_ = routing_slip_location;
+      this->managers_.bind (rspm.id_, &rspm);
+      rspm.bound_ = true;
+      break;
+    case RECORD_UPDATE:
+      this->release_location (rspm.routing_slip_);
+      rspm.routing_slip_ = routing_slip_location;
+      break;
+    default:
+      this->release_location (rspm.event_);
+      this->release_location (rspm.routing_slip_);
+      this->managers_.unbind (rspm.id_);
+      rspm.bound_ = false;
+      break;
+    }
+  }
+  else
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+      ACE_TEXT ("cannot append record %d of event %Q\n"),
+      static_cast<int> (type),
+      rspm.id_));
+  }
+
+  // Like the standard strategy, the routing slip is called back even
+  // if the record could not be written.
+  if (rspm.callback_ != 0)
+  {
+    this->pending_callbacks_.enqueue_tail (rspm.callback_);
+    this->wake_up_thread_.signal ();
+  }
+  return result;
+}
+
+bool
+Log_Event_Persistence_Factory::append_i (
+  Record_Type type,
+  ACE_UINT64 id,
+  const ACE_Message_Block * event,
+  const ACE_Message_Block * routing_slip,
+  Log_Routing_Slip_Persistence_Manager::Location & event_location,
+  Log_Routing_Slip_Persistence_Manager::Location & routing_slip_location)
+{
+  size_t const event_length = event == 0 ? 0 : event->total_length ();
+  size_t const routing_slip_length =
+    routing_slip == 0 ? 0 : routing_slip->total_length ();
+  size_t const size = record_size (event_length + routing_slip_length);
+
+  if (this->active_ == 0 || this->active_->end_ + size > this->active_->map_.size ())
+  {
+    if (!this->roll (size))
+    {
+      return false;
+    }
+  }
+
+  Segment & segment = *this->active_;
+  char * record = static_cast<char *> (segment.map_.addr ()) + segment.end_;
+  char * payload = record + record_header_size;
+  copy_chain (payload, event);
+  copy_chain (payload + event_length, routing_slip);
+
+  put_uint32 (record, static_cast<ACE_UINT32> (type));
+  put_uint64 (record + 8, id);
+  put_uint32 (record + 16, static_cast<ACE_UINT32> (event_length));
+  put_uint32 (record + 20, static_cast<ACE_UINT32> (routing_slip_length));
+  put_uint32 (record + 4, record_crc (record, event_length + routing_slip_length));
+
+  event_location.segment_ = event == 0 ? 0 : segment.index_;
+  event_location.offset_ = segment.end_ + record_header_size;
+  event_location.length_ = event_length;
+  routing_slip_location.segment_ = routing_slip == 0 ? 0 : segment.index_;
+  routing_slip_location.offset_ = event_location.offset_ + event_length;
+  routing_slip_location.length_ = routing_slip_length;
+
+  segment.live_ += event_length + routing_slip_length;
+  segment.end_ += size;
+  return true;
+}
+
+bool
+Log_Event_Persistence_Factory::roll (size_t record_size)
+{
+  size_t size = this->segment_size_;
+  if (size < segment_header_size + record_size)
+  {
+    size = segment_header_size + record_size;
+  }
+  Segment * segment = this->map_segment (this->next_segment_, size, true);
+  if (segment == 0)
+  {
+    return false;
+  }
+  ++this->next_segment_;
+  this->active_ = segment;
+  this->new_segment_ = true;
+  return true;
+}
+
+void
+Log_Event_Persistence_Factory::release_location (
+  Log_Routing_Slip_Persistence_Manager::Location & location)
+{
+  Segment * segment = 0;
+  if (location.segment_ != 0
+      && this->segments_.find (location.segment_, segment) == 0)
+  {
+    segment->live_ -= location.length_;
+  }
+  location.segment_ = 0;
+}
+
+const char *
+Log_Event_Persistence_Factory::address (
+  const Log_Routing_Slip_Persistence_Manager::Location & location) const
+{
+  Segment * segment = 0;
+  if (location.segment_ == 0
+      || const_cast<Segment_Map &> (this->segments_).find (location.segment_, segment) != 0)
+  {
+    return 0;
+  }
+  return static_cast<const char *> (segment->map_.addr ()) + location.offset_;
+}
+
+bool
+Log_Event_Persistence_Factory::reload (
+  Log_Routing_Slip_Persistence_Manager & rspm,
+  ACE_Message_Block*& event,
+  ACE_Message_Block*& routing_slip)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, false);
+  const char * event_data = this->address (rspm.event_);
+  const char * routing_slip_data = this->address (rspm.routing_slip_);
+  if (event_data == 0 || routing_slip_data == 0)
+  {
+    return false;
+  }
+
+  ACE_NEW_RETURN (event, ACE_Message_Block (rspm.event_.length_), false);
+  ACE_NEW_NORETURN (routing_slip,
+                    ACE_Message_Block (rspm.routing_slip_.length_));
+  if (routing_slip == 0)
+  {
+    delete event;
+    event = 0;
+    return false;
+  }
+  event->copy (event_data, rspm.event_.length_);
+  routing_slip->copy (routing_slip_data, rspm.routing_slip_.length_);
+  return true;
+}
+
+void
+Log_Event_Persistence_Factory::detach (Log_Routing_Slip_Persistence_Manager & rspm)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  Log_Routing_Slip_Persistence_Manager * bound = 0;
+  if (rspm.id_ == 0
+      || this->managers_.find (rspm.id_, bound) != 0
+      || bound != &rspm)
+  {
+    return;
+  }
+
+  // The event was not removed, so it stays in the log for the next
+  // reload until its segment is compacted.
+  Log_Routing_Slip_Persistence_Manager * orphan = 0;
+  ACE_NEW (orphan, Log_Routing_Slip_Persistence_Manager (this));
+  orphan->id_ = rspm.id_;
+  orphan->orphan_ = true;
+  orphan->bound_ = true;
+  orphan->event_ = rspm.event_;
+  orphan->routing_slip_ = rspm.routing_slip_;
+  this->managers_.rebind (rspm.id_, orphan);
+  rspm.bound_ = false;
+}
+
+ACE_TString
+Log_Event_Persistence_Factory::segment_path (ACE_UINT32 index) const
+{
+  ACE_TCHAR name[32];
+  ACE_OS::snprintf (name, sizeof (name) / sizeof (name[0]),
+                    ACE_TEXT ("%s%08u"), segment_prefix, index);
+  ACE_TString path (this->dir_path_);
+  path += ACE_DIRECTORY_SEPARATOR_STR;
+  path += name;
+  return path;
+}
+
+Log_Event_Persistence_Factory::Segment *
+Log_Event_Persistence_Factory::map_segment (ACE_UINT32 index,
+                                            size_t size,
+                                            bool create)
+{
+  ACE_TString const path = this->segment_path (index);
+  Segment * segment = 0;
+  ACE_NEW_RETURN (segment, Segment, 0);
+  segment->index_ = index;
+  segment->end_ = segment_header_size;
+  segment->synced_ = create ? 0 : segment_header_size;
+  segment->live_ = 0;
+
+  if (segment->map_.map (path.c_str (),
+                         create ? size : static_cast<size_t> (-1),
+                         create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR,
+                         ACE_DEFAULT_FILE_PERMS,
+                         PROT_RDWR,
+                         ACE_MAP_SHARED) == -1)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: cannot map %s: %p\n"),
+      path.c_str (), ACE_TEXT ("map")));
+    delete segment;
+    return 0;
+  }
+
+  if (create)
+  {
+    int const error = preallocate (segment->map_.handle (), size);
+    if (error != 0)
+    {
+      errno = error;
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+        ACE_TEXT ("cannot allocate %B bytes for %s: %p\n"),
+        size, path.c_str (), ACE_TEXT ("preallocate")));
+      segment->map_.remove ();
+      delete segment;
+      return 0;
+    }
+  }
+
+  char * base = static_cast<char *> (segment->map_.addr ());
+  if (create)
+  {
+    put_uint32 (base, segment_magic);
+    put_uint32 (base + 4, segment_version);
+    put_uint32 (base + 8, index);
+  }
+  else if (segment->map_.size () < segment_header_size
+           || get_uint32 (base) != segment_magic
+           || get_uint32 (base + 4) != segment_version
+           || get_uint32 (base + 8) != index)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+      ACE_TEXT ("%s is not a segment of the log\n"),
+      path.c_str ()));
+    segment->map_.close ();
+    delete segment;
+    return 0;
+  }
+
+  this->segments_.bind (index, segment);
+  return segment;
+}
+
+void
+Log_Event_Persistence_Factory::release_segment (Segment * segment, bool unlink)
+{
+  if (unlink)
+  {
+    segment->map_.remove ();
+  }
+  else
+  {
+    segment->map_.close ();
+  }
+  delete segment;
+}
+
+bool
+Log_Event_Persistence_Factory::recover ()
+{
+  ACE_UINT32 first = 0;
+  ACE_UINT32 last = 0;
+  {
+    ACE_Dirent dir;
+    if (dir.open (this->dir_path_.c_str ()) == -1)
+    {
+      if (ACE_OS::mkdir (this->dir_path_.c_str ()) == -1)
+      {
+        ORBSVCS_ERROR ((LM_ERROR,
+          ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+          ACE_TEXT ("cannot create %s: %p\n"),
+          this->dir_path_.c_str (), ACE_TEXT ("mkdir")));
+        return false;
+      }
+    }
+    else
+    {
+      for (ACE_DIRENT * entry = dir.read (); entry != 0; entry = dir.read ())
+      {
+        if (ACE_OS::strncmp (entry->d_name, segment_prefix, segment_prefix_length) != 0)
+        {
+          continue;
+        }
+        ACE_TCHAR * end = 0;
+        unsigned long const index =
+          ACE_OS::strtoul (entry->d_name + segment_prefix_length, &end, 10);
+        if (index == 0 || *end != 0)
+        {
+          continue;
+        }
+        ACE_UINT32 const segment_index = static_cast<ACE_UINT32> (index);
+        if (first == 0 || segment_index < first)
+        {
+          first = segment_index;
+        }
+        if (segment_index > last)
+        {
+          last = segment_index;
+        }
+      }
+    }
+  }
+
+  // Replay the segments in the order they were written.  Missing
+  // segments were compacted away.
+  for (ACE_UINT32 index = first; index != 0 && index <= last; ++index)
+  {
+    if (ACE_OS::access (this->segment_path (index).c_str (), F_OK) != 0)
+    {
+      continue;
+    }
+    Segment * segment = this->map_segment (index, 0, false);
+    if (segment != 0)
+    {
+      this->scan (*segment);
+    }
+  }
+  if (last != 0)
+  {
+    this->next_segment_ = last + 1;
+  }
+
+  for (Manager_Map::iterator i = this->managers_.begin ();
+       i != this->managers_.end ();
+       ++i)
+  {
+    this->reload_queue_.enqueue_tail ((*i).item ());
+  }
+
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+      ACE_TEXT ("recovered %B events from %B segments\n"),
+      this->reload_queue_.size (),
+      this->segments_.current_size ()));
+  }
+  return true;
+}
+
+void
+Log_Event_Persistence_Factory::scan (Segment & segment)
+{
+  const char * base = static_cast<const char *> (segment.map_.addr ());
+  size_t const size = segment.map_.size ();
+  size_t offset = segment_header_size;
+
+  while (offset + record_header_size <= size)
+  {
+    const char * record = base + offset;
+    ACE_UINT32 const type = get_uint32 (record);
+    if (type == RECORD_END)
+    {
+      break;
+    }
+    ACE_UINT64 const id = get_uint64 (record + 8);
+    size_t const event_length = get_uint32 (record + 16);
+    size_t const routing_slip_length = get_uint32 (record + 20);
+    size_t const payload_length = event_length + routing_slip_length;
+    if (type > RECORD_REMOVE
+        || payload_length > size - offset - record_header_size
+        || get_uint32 (record + 4) != record_crc (record, payload_length))
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+        ACE_TEXT ("segment %u ends with a torn record at %B\n"),
+        segment.index_, offset));
+      break;
+    }
+
+    if (id >= this->next_id_)
+    {
+      this->next_id_ = id + 1;
+    }
+
+    Log_Routing_Slip_Persistence_Manager * rspm = 0;
+    bool const known = this->managers_.find (id, rspm) == 0;
+    Log_Routing_Slip_Persistence_Manager::Location event_location;
+    event_location.segment_ = segment.index_;
+    event_location.offset_ = offset + record_header_size;
+    event_location.length_ = event_length;
+    Log_Routing_Slip_Persistence_Manager::Location routing_slip_location;
+    routing_slip_location.segment_ = segment.index_;
+    routing_slip_location.offset_ = event_location.offset_ + event_length;
+    routing_slip_location.length_ = routing_slip_length;
+
+    switch (type)
+    {
+    case RECORD_STORE:
+      if (!known)
+      {
+        ACE_NEW (rspm, Log_Routing_Slip_Persistence_Manager (this));
+        rspm->id_ = id;
+        this->managers_.bind (id, rspm);
+        rspm->bound_ = true;
+      }
+      this->release_location (rspm->event_);
+      this->release_location (rspm->routing_slip_);
+      rspm->event_ = event_location;
+      rspm->routing_slip_ = routing_slip_location;
+      segment.live_ += payload_length;
+      break;
+    case RECORD_UPDATE:
+      // An update of an event that was compacted away is followed by
+      // the copy of the event.
+      if (known)
+      {
+        this->release_location (rspm->routing_slip_);
+        rspm->routing_slip_ = routing_slip_location;
+        segment.live_ += routing_slip_length;
+      }
+      break;
+    default:
+      if (known)
+      {
+        this->release_location (rspm->event_);
+        this->release_location (rspm->routing_slip_);
+        this->managers_.unbind (id);
+        rspm->factory_ = 0;
+        delete rspm;
+      }
+      break;
+    }
+    offset += record_size (payload_length);
+  }
+  segment.end_ = offset;
+  segment.synced_ = offset;
+}
+
+Log_Event_Persistence_Factory::Segment *
+Log_Event_Persistence_Factory::compact_i ()
+{
+  if (this->compacting_ == 0)
+  {
+    Segment_Map::iterator first = this->segments_.begin ();
+    if (first == this->segments_.end ())
+    {
+      return 0;
+    }
+    Segment * oldest = (*first).item ();
+    if (oldest == this->active_)
+    {
+      return 0;
+    }
+
+    // Copying an event costs as much as appending it again, so the
+    // oldest segment is only compacted if at most a quarter of it is
+    // live, or if the log as a whole is at least half garbage: only the
+    // oldest segment is ever removed, so the live events in it must not
+    // hold back the garbage behind it.
+    size_t live = 0;
+    size_t used = 0;
+    for (Segment_Map::iterator i = this->segments_.begin ();
+         i != this->segments_.end ();
+         ++i)
+    {
+      live += (*i).item ()->live_;
+      used += (*i).item ()->end_ - segment_header_size;
+    }
+    if (oldest->live_ * 4 > oldest->end_ - segment_header_size
+        && live * 2 > used)
+    {
+      return 0;
+    }
+    this->compacting_ = oldest;
+  }
+
+  Segment * const oldest = this->compacting_;
+  ACE_Unbounded_Queue<Log_Routing_Slip_Persistence_Manager *> orphans;
+  size_t copied = 0;
+  bool done = true;
+  bool failed = false;
+  for (Manager_Map::iterator i = this->managers_.begin ();
+       i != this->managers_.end ();
+       ++i)
+  {
+    Log_Routing_Slip_Persistence_Manager * rspm = (*i).item ();
+    if (rspm->event_.segment_ != oldest->index_
+        && rspm->routing_slip_.segment_ != oldest->index_)
+    {
+      continue;
+    }
+
+    // Nobody is left to remove the event of an orphan, it goes with
+    // the segment.
+    if (rspm->orphan_)
+    {
+      orphans.enqueue_tail (rspm);
+      continue;
+    }
+
+    // The lock is held while copying, so the rest is left for the next
+    // flush once a step was copied.
+    if (copied >= compaction_step)
+    {
+      done = false;
+      break;
+    }
+
+    // Copy the event and its latest routing slip to the end of the log.
+    const char * event_data = this->address (rspm->event_);
+    const char * routing_slip_data = this->address (rspm->routing_slip_);
+    if (event_data == 0 || routing_slip_data == 0)
+    {
+      continue;
+    }
+    ACE_Message_Block event (event_data, rspm->event_.length_);
+    event.wr_ptr (rspm->event_.length_);
+    ACE_Message_Block routing_slip (routing_slip_data, rspm->routing_slip_.length_);
+    routing_slip.wr_ptr (rspm->routing_slip_.length_);
+
+    Log_Routing_Slip_Persistence_Manager::Location event_location;
+    Log_Routing_Slip_Persistence_Manager::Location routing_slip_location;
+    if (!this->append_i (RECORD_STORE,
+                         rspm->id_,
+                         &event,
+                         &routing_slip,
+                         event_location,
+                         routing_slip_location))
+    {
+      failed = true;
+      break;
+    }
+    this->release_location (rspm->event_);
+    this->release_location (rspm->routing_slip_);
+    rspm->event_ = event_location;
+    rspm->routing_slip_ = routing_slip_location;
+    copied += event_location.length_ + routing_slip_location.length_;
+  }
+
+  Log_Routing_Slip_Persistence_Manager * orphan = 0;
+  while (orphans.dequeue_head (orphan) == 0)
+  {
+    this->release_location (orphan->event_);
+    this->release_location (orphan->routing_slip_);
+    this->managers_.unbind (orphan->id_);
+    orphan->factory_ = 0;
+    delete orphan;
+  }
+
+  if (failed)
+  {
+    // Try again from the start at a later flush.
+    this->compacting_ = 0;
+    return 0;
+  }
+  if (!done)
+  {
+    return 0;
+  }
+
+  // The segment is removed once the copies are on disk.
+  this->compacting_ = 0;
+  this->segments_.unbind (oldest->index_);
+  return oldest;
+}
+
+void
+Log_Event_Persistence_Factory::dirty_ranges (ACE_Unbounded_Queue<Dirty_Range> & ranges)
+{
+  for (Segment_Map::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+  {
+    Segment * segment = (*i).item ();
+    if (segment->end_ > segment->synced_)
+    {
+      Dirty_Range range;
+      range.segment_ = segment;
+      range.begin_ = segment->synced_;
+      range.end_ = segment->end_;
+      ranges.enqueue_tail (range);
+      segment->synced_ = segment->end_;
+    }
+  }
+}
+
+void
+Log_Event_Persistence_Factory::sync (const Dirty_Range & range)
+{
+  size_t const page_size = ACE_OS::getpagesize ();
+  size_t const begin = range.begin_ - range.begin_ % page_size;
+  char * base = static_cast<char *> (range.segment_->map_.addr ());
+  if (range.segment_->map_.sync (base + begin, range.end_ - begin) == -1)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) Log_Event_Persistence_Factory: ")
+      ACE_TEXT ("cannot sync segment %u: %p\n"),
+      range.segment_->index_, ACE_TEXT ("msync")));
+  }
+}
+
+void
+Log_Event_Persistence_Factory::sync_directory ()
+{
+#if !defined (ACE_WIN32)
+  // Make the names of the new segments durable too.
+  ACE_HANDLE const handle = ACE_OS::open (this->dir_path_.c_str (), O_RDONLY);
+  if (handle != ACE_INVALID_HANDLE)
+  {
+    ACE_OS::fsync (handle);
+    ACE_OS::close (handle);
+  }
+#endif /* ACE_WIN32 */
+}
+
+ACE_THR_FUNC_RETURN
+Log_Event_Persistence_Factory::thr_func (void * arg)
+{
+  Log_Event_Persistence_Factory * factory =
+    static_cast<Log_Event_Persistence_Factory *> (arg);
+  factory->run ();
+  return 0;
+}
+
+void
+Log_Event_Persistence_Factory::shutdown_thread ()
+{
+  if (this->thread_active_)
+  {
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+      this->terminate_thread_ = true;
+      this->wake_up_thread_.signal ();
+    }
+    this->thread_manager_.close ();
+    ACE_ASSERT (!this->thread_active_);
+  }
+}
+
+void
+Log_Event_Persistence_Factory::run ()
+{
+  // Each pass syncs everything appended since the previous one, so the
+  // writers that queued their callbacks meanwhile share a single sync.
+  bool do_more_work = true;
+  while (do_more_work)
+  {
+    ACE_Unbounded_Queue<Persistent_Callback *> callbacks;
+    ACE_Unbounded_Queue<Dirty_Range> ranges;
+    Segment * retired = 0;
+    bool new_segment = false;
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+      while (this->pending_callbacks_.is_empty ()
+             && this->compacting_ == 0
+             && !this->terminate_thread_)
+      {
+        this->wake_up_thread_.wait ();
+      }
+      // A compaction left half done carries on without waiting for more
+      // records.
+      do_more_work = !this->pending_callbacks_.is_empty ()
+        || (this->compacting_ != 0 && !this->terminate_thread_);
+      if (do_more_work)
+      {
+        retired = this->compact_i ();
+      }
+      Persistent_Callback * callback = 0;
+      while (this->pending_callbacks_.dequeue_head (callback) == 0)
+      {
+        callbacks.enqueue_tail (callback);
+      }
+      this->dirty_ranges (ranges);
+      new_segment = this->new_segment_;
+      this->new_segment_ = false;
+    }
+
+    Dirty_Range range;
+    while (ranges.dequeue_head (range) == 0)
+    {
+      this->sync (range);
+    }
+    if (new_segment)
+    {
+      this->sync_directory ();
+    }
+    if (retired != 0)
+    {
+      this->release_segment (retired, true);
+    }
+
+    Persistent_Callback * callback = 0;
+    while (callbacks.dequeue_head (callback) == 0)
+    {
+      callback->persist_complete ();
+    }
+  }
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->terminate_thread_ = false;
+  this->thread_active_ = false;
+}
+
+} /* namespace TAO_Notify */
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_NAMESPACE_DEFINE (TAO_Notify_Serv, TAO_Notify_Log_Event_Persistence, TAO_Notify::Log_Event_Persistence)
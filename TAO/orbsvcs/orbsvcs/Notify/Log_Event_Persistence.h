@@ -0,0 +1,320 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  \file    Log_Event_Persistence.h
+ *
+ *  An Event_Persistence_Strategy that appends the events and their
+ *  routing slips to a log of memory mapped segment files.
+ */
+//=============================================================================
+
+#ifndef LOG_EVENT_PERSISTENCE_H
+#define LOG_EVENT_PERSISTENCE_H
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Notify/Event_Persistence_Strategy.h"
+#include "orbsvcs/Notify/Event_Persistence_Factory.h"
+#include "orbsvcs/Notify/Persistent_File_Allocator.h"
+#include "orbsvcs/Notify/Routing_Slip_Persistence_Manager.h"
+#include "tao/orbconf.h"
+#include "ace/Mem_Map.h"
+#include "ace/RB_Tree.h"
+#include "ace/Functor_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Unbounded_Queue.h"
+#include <ace/SString.h>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_Notify
+{
+  class Log_Event_Persistence_Factory;
+
+  /// \brief The Routing_Slip_Persistence_Manager of Log_Event_Persistence.
+  ///
+  /// Each store, update and remove appends a record to the log of the
+  /// factory; the manager only remembers where the latest copy of its
+  /// event and routing slip are.
+  class TAO_Notify_Serv_Export Log_Routing_Slip_Persistence_Manager
+    : public Routing_Slip_Persistence_Manager
+  {
+  public:
+    /// The constructor.
+    Log_Routing_Slip_Persistence_Manager (Log_Event_Persistence_Factory * factory);
+
+    /// The destructor.
+    virtual ~Log_Routing_Slip_Persistence_Manager ();
+
+    virtual void set_callback (Persistent_Callback* callback);
+
+    virtual bool store (const ACE_Message_Block& event,
+      const ACE_Message_Block& routing_slip);
+
+    virtual bool update (const ACE_Message_Block& routing_slip);
+
+    virtual bool remove ();
+
+    virtual bool reload (ACE_Message_Block*& event,
+      ACE_Message_Block*& routing_slip);
+
+    virtual Routing_Slip_Persistence_Manager * load_next ();
+
+  private:
+    friend class Log_Event_Persistence_Factory;
+
+    /// Call back for a request made once the factory is gone, returns
+    /// false.
+    bool fail ();
+
+    /// Where a copy of the event or routing slip is in the log.
+    struct Location
+    {
+      /// The index of the segment, 0 if there is no copy.
+      ACE_UINT32 segment_;
+      size_t offset_;
+      size_t length_;
+    };
+
+    /// The factory.  Only the managers with an event in the log are
+    /// told when it is destroyed.
+    Log_Event_Persistence_Factory * factory_;
+    Persistent_Callback * callback_;
+
+    /// The identifier of the records of the event, 0 until it is first
+    /// written.
+    ACE_UINT64 id_;
+
+    /// True for a stand-in of a manager destroyed before its event was
+    /// removed.
+    bool orphan_;
+
+    /// True while the manager has an event in the log.
+    bool bound_;
+
+    Location event_;
+    Location routing_slip_;
+  };
+
+  /**
+   * \brief The Event_Persistence_Factory of Log_Event_Persistence.
+   *
+   * The records are appended to the active segment under a single lock
+   * and a flusher thread syncs all the records appended since its last
+   * pass with one msync per segment before calling back their routing
+   * slips, so concurrent writers share the cost of reaching the disk.
+   *
+   * Segments are never rewritten.  When the oldest segment holds little
+   * live data the events still in it are copied to the end of the log,
+   * a bounded number of bytes per flush so the writers are not held
+   * back, and the segment file is removed.
+   */
+  class TAO_Notify_Serv_Export Log_Event_Persistence_Factory :
+    public Event_Persistence_Factory
+  {
+  public:
+    /// Constructor
+    Log_Event_Persistence_Factory ();
+    /// Destructor
+    virtual ~Log_Event_Persistence_Factory ();
+
+    /// Recover the log in a directory and start the flusher thread.
+    /// \param dir_path the directory containing the segment files,
+    ///        created if necessary.
+    /// \param segment_size the size of a new segment file.
+    bool open (const ACE_TCHAR* dir_path, size_t segment_size);
+
+    //////////////////////////////////////////////////////
+    // Implement Event_Persistence_Factory virtual methods.
+    virtual Routing_Slip_Persistence_Manager*
+      create_routing_slip_persistence_manager (Persistent_Callback* callback);
+
+    virtual Routing_Slip_Persistence_Manager * first_reload_manager ();
+
+    /////////////////////////////////////////////
+    // Intended for use only by the managers.
+
+    /// The type of a record in the log.
+    enum Record_Type
+    {
+      /// Zero filled space at the end of a segment.
+      RECORD_END = 0,
+      RECORD_STORE = 1,
+      RECORD_UPDATE = 2,
+      RECORD_REMOVE = 3
+    };
+
+    /// Append a record for @a rspm and queue its callback for the next
+    /// flush, or make it at once if the flusher thread is gone.
+    bool append (Log_Routing_Slip_Persistence_Manager & rspm,
+      Record_Type type,
+      const ACE_Message_Block * event,
+      const ACE_Message_Block * routing_slip);
+
+    /// Copy the event and routing slip of @a rspm out of the log.
+    bool reload (Log_Routing_Slip_Persistence_Manager & rspm,
+      ACE_Message_Block*& event,
+      ACE_Message_Block*& routing_slip);
+
+    /// The next manager recovered by open.
+    Routing_Slip_Persistence_Manager * next_reload_manager ();
+
+    /// Forget a manager that is being destroyed.
+    void detach (Log_Routing_Slip_Persistence_Manager & rspm);
+
+  private:
+    /// A segment file mapped in memory.
+    struct Segment
+    {
+      ACE_UINT32 index_;
+      ACE_Mem_Map map_;
+      /// The end of the records.
+      size_t end_;
+      /// The end of the records known to be on disk.
+      size_t synced_;
+      /// The payload bytes of the records still in use.
+      size_t live_;
+    };
+
+    /// A range of a segment to sync.
+    struct Dirty_Range
+    {
+      Segment * segment_;
+      size_t begin_;
+      size_t end_;
+    };
+
+    typedef ACE_RB_Tree<ACE_UINT64,
+                        Log_Routing_Slip_Persistence_Manager *,
+                        ACE_Less_Than<ACE_UINT64>,
+                        ACE_Null_Mutex> Manager_Map;
+
+    typedef ACE_RB_Tree<ACE_UINT32,
+                        Segment *,
+                        ACE_Less_Than<ACE_UINT32>,
+                        ACE_Null_Mutex> Segment_Map;
+
+    /// Map segment @a index, creating it with @a size bytes if
+    /// @a create, otherwise with the size of the existing file.
+    Segment * map_segment (ACE_UINT32 index, size_t size, bool create);
+
+    /// Unmap a segment, and remove its file if @a unlink.
+    void release_segment (Segment * segment, bool unlink);
+
+    /// The path of the file of segment @a index.
+    ACE_TString segment_path (ACE_UINT32 index) const;
+
+    /// Read back the segments left in the directory.
+    bool recover ();
+
+    /// Apply the records of a segment to the recovered managers.
+    void scan (Segment & segment);
+
+    /// Append a record to the active segment, starting a new segment
+    /// if it is full.  The locations of the payloads are returned in
+    /// @a event_location and @a routing_slip_location.
+    bool append_i (Record_Type type,
+      ACE_UINT64 id,
+      const ACE_Message_Block * event,
+      const ACE_Message_Block * routing_slip,
+      Log_Routing_Slip_Persistence_Manager::Location & event_location,
+      Log_Routing_Slip_Persistence_Manager::Location & routing_slip_location);
+
+    /// Start a new active segment big enough for @a record_size bytes.
+    bool roll (size_t record_size);
+
+    /// Release the space of an old copy of an event or routing slip.
+    void release_location (Log_Routing_Slip_Persistence_Manager::Location & location);
+
+    /// The address of a location in its segment.
+    const char * address (const Log_Routing_Slip_Persistence_Manager::Location & location) const;
+
+    /// Copy some of the live events out of the oldest segment if it is
+    /// mostly garbage.  Returns the segment to remove once the copies
+    /// are synced, when none is left in it.
+    Segment * compact_i ();
+
+    /// Collect the ranges appended since the last flush.
+    void dirty_ranges (ACE_Unbounded_Queue<Dirty_Range> & ranges);
+
+    /// Sync a range of a segment, and the directory if segments were
+    /// created since the last flush.
+    void sync (const Dirty_Range & range);
+    void sync_directory ();
+
+    static ACE_THR_FUNC_RETURN thr_func (void * arg);
+    void run ();
+    void shutdown_thread ();
+
+    TAO_SYNCH_MUTEX lock_;
+    ACE_SYNCH_CONDITION wake_up_thread_;
+    ACE_Thread_Manager thread_manager_;
+    bool thread_active_;
+    bool terminate_thread_;
+
+    ACE_TString dir_path_;
+    size_t segment_size_;
+
+    /// All the segments, the oldest first.
+    Segment_Map segments_;
+    Segment * active_;
+    ACE_UINT32 next_segment_;
+    /// True if a segment file was created since the last flush.
+    bool new_segment_;
+    /// The oldest segment while its live events are being copied out.
+    Segment * compacting_;
+
+    /// The managers with an event in the log, in the order of the
+    /// events.
+    Manager_Map managers_;
+    ACE_UINT64 next_id_;
+
+    /// The managers recovered by open, not yet reloaded.
+    ACE_Unbounded_Queue<Log_Routing_Slip_Persistence_Manager *> reload_queue_;
+
+    /// The callbacks waiting for the next flush.
+    ACE_Unbounded_Queue<Persistent_Callback *> pending_callbacks_;
+  };
+
+  /// \brief An Event_Persistence_Strategy appending to a log of memory
+  /// mapped files.
+  class TAO_Notify_Serv_Export Log_Event_Persistence :
+    public Event_Persistence_Strategy
+  {
+  public :
+    /// Constructor.
+    Log_Event_Persistence ();
+    /// Destructor.
+    virtual ~Log_Event_Persistence ();
+    /////////////////////////////////////////////
+    // Override Event_Persistent_Strategy methods
+    // Parse arguments and initialize.
+    virtual int init (int argc, ACE_TCHAR *argv[]);
+    // Prepare for shutdown
+    virtual int fini ();
+
+    // get the current factory, creating it if necessary
+    virtual Event_Persistence_Factory * get_factory ();
+
+  private:
+    // release the current factory so a new one can be created
+    virtual void reset ();
+
+    ACE_TString dir_path_;  // set via -dir_path
+    size_t segment_size_;   // set via -segment_size
+    Log_Event_Persistence_Factory * factory_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_DECLARE (TAO_Notify_Serv, TAO_Notify_Log_Event_Persistence)
+
+#include /**/ "ace/post.h"
+#endif /* LOG_EVENT_PERSISTENCE_H */
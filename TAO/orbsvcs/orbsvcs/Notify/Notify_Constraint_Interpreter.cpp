@@ -113,4 +113,12 @@ TAO_Notify_Constraint_Interpreter::evaluate (TAO_Notify_Constraint_Visitor &eval
   return evaluator.evaluate_constraint (this->root_);
 }
 
+bool
+TAO_Notify_Constraint_Interpreter::compile (
+    TAO_Notify_Constraint_Program &program,
+    TAO_Notify_Constraint_Program::Slot_Map &slots)
+{
+  return program.compile (this->root_, slots);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -22,6 +22,7 @@
 #include "tao/ETCL/TAO_ETCL_Constraint.h"
 
 #include "orbsvcs/CosNotifyFilterC.h"
+#include "orbsvcs/Notify/Notify_Constraint_Program.h"
 #include "orbsvcs/Notify/notify_serv_export.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -54,6 +55,12 @@ public:
   /// the evaluator.
   CORBA::Boolean evaluate (TAO_Notify_Constraint_Visitor &evaluator);
 
+  /// Compile the tree into @a program, giving the properties it reads
+  /// a slot in @a slots.  Returns false if the tree must be
+  /// evaluated by the interpreter.
+  bool compile (TAO_Notify_Constraint_Program &program,
+                TAO_Notify_Constraint_Program::Slot_Map &slots);
+
 private:
   void build_tree (const char* constraints);
 };
@@ -0,0 +1,1257 @@
+#include "orbsvcs/Notify/Notify_Constraint_Program.h"
+
+#include "ace/ETCL/ETCL_Constraint.h"
+#include "ace/ETCL/ETCL_Constraint_Visitor.h"
+#include "ace/ETCL/ETCL_y.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_string.h"
+
+#include "tao/ETCL/TAO_ETCL_Constraint.h"
+
+#include "tao/AnyTypeCode/Any.h"
+#include "tao/AnyTypeCode/Any_Unknown_IDL_Type.h"
+#include "tao/AnyTypeCode/TypeCode.h"
+#include "tao/AnyTypeCode/TypeCode_Constants.h"
+#include "tao/CDR.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+typedef TAO_Notify_Constraint_Program::Value Value;
+
+namespace
+{
+  /// Maps the literal types of the ETCL nodes to the program types.
+  class Literal_Types : public ETCL_Constraint
+  {
+  public:
+    static TAO_Notify_Constraint_Program::Type type (Literal_Type type)
+    {
+      switch (type)
+        {
+        case ACE_ETCL_STRING:
+          return TAO_Notify_Constraint_Program::STRING;
+        case ACE_ETCL_DOUBLE:
+          return TAO_Notify_Constraint_Program::DOUBLE;
+        case ACE_ETCL_UNSIGNED:
+          return TAO_Notify_Constraint_Program::UNSIGNED;
+        case ACE_ETCL_SIGNED:
+          return TAO_Notify_Constraint_Program::SIGNED;
+        case ACE_ETCL_INTEGER:
+          return TAO_Notify_Constraint_Program::INTEGER;
+        case ACE_ETCL_BOOLEAN:
+          return TAO_Notify_Constraint_Program::BOOLEAN;
+        case ACE_ETCL_COMPONENT:
+          return TAO_Notify_Constraint_Program::COMPONENT;
+        default:
+          return TAO_Notify_Constraint_Program::UNKNOWN;
+        }
+    }
+  };
+
+  // The conversions and operators below follow the ones of
+  // ETCL_Literal_Constraint and TAO_ETCL_Literal_Constraint, so the
+  // programs and the interpreter agree.
+
+  Value
+  make_boolean (CORBA::Boolean boolean)
+  {
+    Value value;
+    value.type_ = TAO_Notify_Constraint_Program::BOOLEAN;
+    value.op_.bool_ = boolean;
+    return value;
+  }
+
+  Value
+  make_long (CORBA::Long integer)
+  {
+    Value value;
+    value.type_ = TAO_Notify_Constraint_Program::SIGNED;
+    value.op_.integer_ = integer;
+    return value;
+  }
+
+  Value
+  make_ulong (CORBA::ULong uinteger)
+  {
+    Value value;
+    value.type_ = TAO_Notify_Constraint_Program::UNSIGNED;
+    value.op_.uinteger_ = uinteger;
+    return value;
+  }
+
+  Value
+  make_double (CORBA::Double doub)
+  {
+    Value value;
+    value.type_ = TAO_Notify_Constraint_Program::DOUBLE;
+    value.op_.double_ = doub;
+    return value;
+  }
+
+  Value
+  make_string (const char *str)
+  {
+    Value value;
+    value.type_ = TAO_Notify_Constraint_Program::STRING;
+    value.op_.str_ = str;
+    return value;
+  }
+
+  CORBA::Boolean
+  to_boolean (const Value &value)
+  {
+    return value.type_ == TAO_Notify_Constraint_Program::BOOLEAN
+      ? value.op_.bool_ : false;
+  }
+
+  CORBA::ULong
+  to_ulong (const Value &value)
+  {
+    switch (value.type_)
+      {
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return value.op_.uinteger_;
+      case TAO_Notify_Constraint_Program::SIGNED:
+      case TAO_Notify_Constraint_Program::INTEGER:
+        return value.op_.integer_ > 0
+          ? static_cast<CORBA::ULong> (value.op_.integer_) : 0;
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return value.op_.double_ > 0
+          ? (value.op_.double_ > ACE_UINT32_MAX
+             ? ACE_UINT32_MAX
+             : static_cast<CORBA::ULong> (value.op_.double_))
+          : 0;
+      default:
+        return 0;
+      }
+  }
+
+  CORBA::Long
+  to_long (const Value &value)
+  {
+    switch (value.type_)
+      {
+      case TAO_Notify_Constraint_Program::SIGNED:
+      case TAO_Notify_Constraint_Program::INTEGER:
+        return value.op_.integer_;
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return value.op_.uinteger_ > static_cast<CORBA::ULong> (ACE_INT32_MAX)
+          ? ACE_INT32_MAX : static_cast<CORBA::Long> (value.op_.uinteger_);
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return value.op_.double_ > 0
+          ? (value.op_.double_ > ACE_INT32_MAX
+             ? ACE_INT32_MAX
+             : static_cast<CORBA::Long> (value.op_.double_))
+          : (value.op_.double_ < ACE_INT32_MIN
+             ? ACE_INT32_MIN
+             : static_cast<CORBA::Long> (value.op_.double_));
+      default:
+        return 0;
+      }
+  }
+
+  CORBA::Double
+  to_double (const Value &value)
+  {
+    switch (value.type_)
+      {
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return value.op_.double_;
+      case TAO_Notify_Constraint_Program::SIGNED:
+      case TAO_Notify_Constraint_Program::INTEGER:
+        return static_cast<CORBA::Double> (value.op_.integer_);
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return static_cast<CORBA::Double> (value.op_.uinteger_);
+      default:
+        return 0.0;
+      }
+  }
+
+  TAO_Notify_Constraint_Program::Type
+  widest_type (const Value &lhs, const Value &rhs)
+  {
+    return lhs.type_ > rhs.type_ ? lhs.type_ : rhs.type_;
+  }
+
+  bool
+  equal (const Value &lhs, const Value &rhs)
+  {
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_Notify_Constraint_Program::STRING:
+        return ACE_OS::strcmp (lhs.op_.str_, rhs.op_.str_) == 0;
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return ACE::is_equal (to_double (lhs), to_double (rhs));
+      case TAO_Notify_Constraint_Program::INTEGER:
+      case TAO_Notify_Constraint_Program::SIGNED:
+        return to_long (lhs) == to_long (rhs);
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return to_ulong (lhs) == to_ulong (rhs);
+      case TAO_Notify_Constraint_Program::BOOLEAN:
+        return to_boolean (lhs) == to_boolean (rhs);
+      default:
+        return false;
+      }
+  }
+
+  bool
+  less (const Value &lhs, const Value &rhs)
+  {
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_Notify_Constraint_Program::STRING:
+        return ACE_OS::strcmp (lhs.op_.str_, rhs.op_.str_) < 0;
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return to_double (lhs) < to_double (rhs);
+      case TAO_Notify_Constraint_Program::INTEGER:
+      case TAO_Notify_Constraint_Program::SIGNED:
+        return to_long (lhs) < to_long (rhs);
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return to_ulong (lhs) < to_ulong (rhs);
+      case TAO_Notify_Constraint_Program::BOOLEAN:
+        return to_boolean (lhs) < to_boolean (rhs);
+      default:
+        return false;
+      }
+  }
+
+  bool
+  greater (const Value &lhs, const Value &rhs)
+  {
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_Notify_Constraint_Program::STRING:
+        return ACE_OS::strcmp (lhs.op_.str_, rhs.op_.str_) > 0;
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return to_double (lhs) > to_double (rhs);
+      case TAO_Notify_Constraint_Program::INTEGER:
+      case TAO_Notify_Constraint_Program::SIGNED:
+        return to_long (lhs) > to_long (rhs);
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return to_ulong (lhs) > to_ulong (rhs);
+      default:
+        return false;
+      }
+  }
+
+  Value
+  negate (const Value &value)
+  {
+    switch (value.type_)
+      {
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        return make_double (- value.op_.double_);
+      case TAO_Notify_Constraint_Program::INTEGER:
+      case TAO_Notify_Constraint_Program::SIGNED:
+        return make_long (- value.op_.integer_);
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        return make_long (- static_cast<CORBA::Long> (value.op_.uinteger_));
+      default:
+        return make_long (0);
+      }
+  }
+
+  /// Is a name given twice in @a properties?  The sequences are
+  /// short, they are not worth a hash table.
+  bool
+  has_duplicate_names (const CosNotification::PropertySeq &properties)
+  {
+    CORBA::ULong const length = properties.length ();
+
+    for (CORBA::ULong i = 1; i < length; ++i)
+      {
+        for (CORBA::ULong j = 0; j != i; ++j)
+          {
+            if (ACE_OS::strcmp (properties[i].name.in (),
+                                properties[j].name.in ()) == 0)
+              return true;
+          }
+      }
+
+    return false;
+  }
+
+  /// How read_value read a value.
+  enum Read_Result
+    {
+      /// The value was read.
+      READ,
+      /// The value cannot be read, the constraint is false as in the
+      /// interpreter.
+      NOT_READ,
+      /// The value cannot be read in place, the constraint must be
+      /// interpreted.
+      NOT_IN_PLACE
+    };
+
+  /**
+   * Read the value at the start of the CDR stream of an encoded Any
+   * in place.
+   *
+   * Extracting from an encoded Any replaces its implementation, but
+   * the Anys of an event are shared by the filters of all the proxies
+   * it is matched against, on several threads.  So the stream is
+   * neither copied nor moved, its buffer is read the way ACE_InputCDR
+   * would read it.
+   */
+  class Encoded_Value
+  {
+  public:
+    explicit Encoded_Value (TAO::Unknown_IDL_Type &unk)
+    {
+      TAO_InputCDR &cdr = unk._tao_get_cdr ();
+      this->start_ = cdr.rd_ptr ();
+      this->end_ = this->start_ + cdr.length ();
+      this->swap_ = cdr.do_byte_swap ();
+      this->translated_ = cdr.char_translator () != 0;
+    }
+
+    /// Read a primitive of @a size bytes.
+    bool read (void *x, size_t size) const
+    {
+      const char *buf = this->align (size);
+
+      if (buf + size > this->end_)
+        return false;
+
+      if (!this->swap_ || size == 1)
+        {
+          ACE_OS::memcpy (x, buf, size);
+          return true;
+        }
+
+      switch (size)
+        {
+        case 2:
+          ACE_CDR::swap_2 (buf, static_cast<char *> (x));
+          return true;
+        case 4:
+          ACE_CDR::swap_4 (buf, static_cast<char *> (x));
+          return true;
+        case 8:
+          ACE_CDR::swap_8 (buf, static_cast<char *> (x));
+          return true;
+        default:
+          return false;
+        }
+    }
+
+    /// Point @a str to a string, if its characters need no
+    /// translation.
+    Read_Result read_string (const char *&str) const
+    {
+      if (this->translated_)
+        return NOT_IN_PLACE;
+
+      ACE_CDR::ULong length = 0;
+
+      if (!this->read (&length, ACE_CDR::LONG_SIZE))
+        return NOT_READ;
+
+      if (length == 0)
+        {
+          // Like ACE_InputCDR, a null string is an empty one.
+          str = "";
+          return READ;
+        }
+
+      const char *const chars = this->align (ACE_CDR::LONG_SIZE)
+                                + ACE_CDR::LONG_SIZE;
+
+      if (length > static_cast<size_t> (this->end_ - chars))
+        return NOT_READ;
+
+      // A string that is not terminated cannot be pointed to.
+      if (chars[length - 1] != '\0')
+        return NOT_IN_PLACE;
+
+      str = chars;
+      return READ;
+    }
+
+  private:
+    const char *align (size_t size) const
+    {
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+      return ACE_ptr_align_binary (this->start_, size);
+#else
+      ACE_UNUSED_ARG (size);
+      return this->start_;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+    }
+
+    const char *start_;
+    const char *end_;
+    bool swap_;
+    bool translated_;
+  };
+
+  /// Read a filterable_data property or the remainder_of_body, like
+  /// the TAO_ETCL_Literal_Constraint constructor does, but without
+  /// extracting from an encoded Any.
+  Read_Result
+  read_value (const CORBA::Any &any, Value &value)
+  {
+    CORBA::TypeCode_ptr const type = any._tao_get_typecode ();
+    if (CORBA::is_nil (type))
+      return NOT_READ;
+
+    CORBA::TCKind const corba_type = type->kind ();
+
+    value.type_ =
+      Literal_Types::type (TAO_ETCL_Literal_Constraint::comparable_type (type));
+
+    TAO::Any_Impl *const impl = any.impl ();
+    TAO::Unknown_IDL_Type *unk = 0;
+
+    if (impl->encoded ())
+      {
+        unk = dynamic_cast<TAO::Unknown_IDL_Type *> (impl);
+
+        if (unk == 0)
+          return NOT_READ;
+      }
+
+    // The extraction operators only read a value of an equivalent
+    // type, the others are left at 0.
+    switch (value.type_)
+      {
+      case TAO_Notify_Constraint_Program::SIGNED:
+        value.op_.integer_ = 0;
+
+        if (corba_type == CORBA::tk_short)
+          {
+            CORBA::Short sh = 0;
+
+            if (unk != 0)
+              Encoded_Value (*unk).read (&sh, ACE_CDR::SHORT_SIZE);
+            else
+              any >>= sh;
+
+            value.op_.integer_ = sh;
+          }
+        else if (unk == 0)
+          {
+            any >>= value.op_.integer_;
+          }
+        else if (type->equivalent (CORBA::_tc_long))
+          {
+            Encoded_Value (*unk).read (&value.op_.integer_,
+                                       ACE_CDR::LONG_SIZE);
+          }
+        break;
+      case TAO_Notify_Constraint_Program::UNSIGNED:
+        value.op_.uinteger_ = 0;
+
+        if (corba_type == CORBA::tk_ushort)
+          {
+            CORBA::UShort sh = 0;
+
+            if (unk != 0)
+              Encoded_Value (*unk).read (&sh, ACE_CDR::SHORT_SIZE);
+            else
+              any >>= sh;
+
+            value.op_.uinteger_ = sh;
+          }
+        else if (corba_type == CORBA::tk_enum)
+          {
+            if (unk != 0)
+              {
+                Encoded_Value (*unk).read (&value.op_.uinteger_,
+                                           ACE_CDR::LONG_SIZE);
+              }
+            else
+              {
+                // Marshal the enum into a buffer on the stack and read
+                // it back in place, it is in the native byte order.
+                char buf[ACE_CDR::LONG_SIZE + ACE_CDR::MAX_ALIGNMENT];
+                TAO_OutputCDR out (buf, sizeof buf);
+
+                if (!impl->marshal_value (out)
+                    || out.total_length () != ACE_CDR::LONG_SIZE)
+                  return NOT_READ;
+
+                ACE_OS::memcpy (&value.op_.uinteger_,
+                                out.buffer (),
+                                ACE_CDR::LONG_SIZE);
+              }
+          }
+        else if (unk == 0)
+          {
+            any >>= value.op_.uinteger_;
+          }
+        else if (type->equivalent (CORBA::_tc_ulong))
+          {
+            Encoded_Value (*unk).read (&value.op_.uinteger_,
+                                       ACE_CDR::LONG_SIZE);
+          }
+        break;
+      case TAO_Notify_Constraint_Program::DOUBLE:
+        value.op_.double_ = 0.0;
+
+        if (corba_type == CORBA::tk_float)
+          {
+            CORBA::Float fl = 0.0f;
+
+            if (unk != 0)
+              Encoded_Value (*unk).read (&fl, ACE_CDR::LONG_SIZE);
+            else
+              any >>= fl;
+
+            value.op_.double_ = fl;
+          }
+        else if (unk == 0)
+          {
+            any >>= value.op_.double_;
+          }
+        else if (type->equivalent (CORBA::_tc_double))
+          {
+            Encoded_Value (*unk).read (&value.op_.double_,
+                                       ACE_CDR::LONGLONG_SIZE);
+          }
+        break;
+      case TAO_Notify_Constraint_Program::BOOLEAN:
+        value.op_.bool_ = false;
+
+        if (unk == 0)
+          {
+            CORBA::Any::to_boolean tmp (value.op_.bool_);
+            any >>= tmp;
+          }
+        else
+          {
+            ACE_CDR::Octet octet = 0;
+
+            if (type->equivalent (CORBA::_tc_boolean)
+                && Encoded_Value (*unk).read (&octet, ACE_CDR::OCTET_SIZE))
+              value.op_.bool_ = (octet != 0);
+          }
+        break;
+      case TAO_Notify_Constraint_Program::STRING:
+        {
+          const char *str = 0;
+
+          if (unk == 0)
+            {
+              if (!(any >>= str) || str == 0)
+                return NOT_READ;
+            }
+          else if (!type->equivalent (CORBA::_tc_string))
+            {
+              return NOT_READ;
+            }
+          else
+            {
+              Read_Result const result = Encoded_Value (*unk).read_string (str);
+
+              if (result != READ)
+                return result;
+            }
+
+          value.op_.str_ = str;
+        }
+        break;
+      default:
+        // Structs, sequences and the like can only be compared by
+        // the interpreter, and always compare false there.
+        break;
+      }
+
+    return READ;
+  }
+}
+
+// ****************************************************************
+
+/**
+ * @class TAO_Notify_Constraint_Compiler
+ *
+ * @brief Emit the program of an expression tree.
+ *
+ * Each visit method emits the code that leaves the value of the node
+ * on the stack, or returns -1 if the node cannot be compiled.
+ */
+class TAO_Notify_Constraint_Compiler : public ETCL_Constraint_Visitor
+{
+public:
+  TAO_Notify_Constraint_Compiler (
+      TAO_Notify_Constraint_Program &program,
+      TAO_Notify_Constraint_Program::Slot_Map &slots);
+
+  int visit_literal (ETCL_Literal_Constraint *) override;
+  int visit_identifier (ETCL_Identifier *) override;
+  int visit_union_value (ETCL_Union_Value *) override;
+  int visit_union_pos (ETCL_Union_Pos *) override;
+  int visit_component_pos (ETCL_Component_Pos *) override;
+  int visit_component_assoc (ETCL_Component_Assoc *) override;
+  int visit_component_array (ETCL_Component_Array *) override;
+  int visit_special (ETCL_Special *) override;
+  int visit_component (ETCL_Component *) override;
+  int visit_dot (ETCL_Dot *) override;
+  int visit_eval (ETCL_Eval *) override;
+  int visit_default (ETCL_Default *) override;
+  int visit_exist (ETCL_Exist *) override;
+  int visit_unary_expr (ETCL_Unary_Expr *) override;
+  int visit_binary_expr (ETCL_Binary_Expr *) override;
+  int visit_preference (ETCL_Preference *) override;
+
+private:
+  /// Append an instruction, returning its address.
+  size_t emit (TAO_Notify_Constraint_Program::Opcode op,
+               CORBA::ULong arg = 0);
+
+  /// Track the depth of the stack after an instruction.
+  int push (void);
+  void pop (void);
+
+  /// Emit the read of the filterable_data property @a name.
+  int emit_property (const char *name);
+
+  int visit_logical (ETCL_Binary_Expr *binary,
+                     TAO_Notify_Constraint_Program::Opcode jump);
+
+  TAO_Notify_Constraint_Program &program_;
+  TAO_Notify_Constraint_Program::Slot_Map &slots_;
+
+  size_t depth_;
+};
+
+TAO_Notify_Constraint_Compiler::TAO_Notify_Constraint_Compiler (
+    TAO_Notify_Constraint_Program &program,
+    TAO_Notify_Constraint_Program::Slot_Map &slots)
+  : program_ (program),
+    slots_ (slots),
+    depth_ (0)
+{
+}
+
+size_t
+TAO_Notify_Constraint_Compiler::emit (TAO_Notify_Constraint_Program::Opcode op,
+                                      CORBA::ULong arg)
+{
+  TAO_Notify_Constraint_Program::Instruction instruction;
+  instruction.op_ = op;
+  instruction.arg_ = arg;
+  this->program_.code_.push_back (instruction);
+  return this->program_.code_.size () - 1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::push ()
+{
+  if (this->depth_ == TAO_Notify_Constraint_Program::max_depth_)
+    return -1;
+
+  ++this->depth_;
+  return 0;
+}
+
+void
+TAO_Notify_Constraint_Compiler::pop ()
+{
+  --this->depth_;
+}
+
+int
+TAO_Notify_Constraint_Compiler::emit_property (const char *name)
+{
+  CORBA::ULong slot = 0;
+  ACE_CString key (name);
+
+  if (this->slots_.find (key, slot) != 0)
+    {
+      slot = static_cast<CORBA::ULong> (this->slots_.current_size ());
+      if (this->slots_.bind (key, slot) != 0)
+        return -1;
+    }
+
+  this->emit (TAO_Notify_Constraint_Program::PUSH_PROPERTY, slot);
+  return this->push ();
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_literal (ETCL_Literal_Constraint *literal)
+{
+  Value value;
+  value.type_ = Literal_Types::type (literal->expr_type ());
+
+  switch (value.type_)
+    {
+    case TAO_Notify_Constraint_Program::STRING:
+      value.op_.str_ = ACE::strnew ((const char *) *literal);
+      break;
+    case TAO_Notify_Constraint_Program::DOUBLE:
+      value.op_.double_ = (CORBA::Double) *literal;
+      break;
+    case TAO_Notify_Constraint_Program::UNSIGNED:
+      value.op_.uinteger_ = (CORBA::ULong) *literal;
+      break;
+    case TAO_Notify_Constraint_Program::SIGNED:
+    case TAO_Notify_Constraint_Program::INTEGER:
+      value.op_.integer_ = (CORBA::Long) *literal;
+      break;
+    case TAO_Notify_Constraint_Program::BOOLEAN:
+      value.op_.bool_ = (CORBA::Boolean) *literal;
+      break;
+    default:
+      return -1;
+    }
+
+  this->program_.literals_.push_back (value);
+  this->emit (TAO_Notify_Constraint_Program::PUSH_LITERAL,
+              static_cast<CORBA::ULong> (this->program_.literals_.size () - 1));
+  return this->push ();
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_identifier (ETCL_Identifier *ident)
+{
+  // A bare name is a filterable_data property.
+  return this->emit_property (ident->value ());
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_union_value (ETCL_Union_Value *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_union_pos (ETCL_Union_Pos *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_component_pos (ETCL_Component_Pos *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_component_assoc (ETCL_Component_Assoc *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_component_array (ETCL_Component_Array *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_special (ETCL_Special *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_component (ETCL_Component *)
+{
+  // Components are only compiled as the path of a "$".
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_dot (ETCL_Dot *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_eval (ETCL_Eval *eval)
+{
+  // Resolve the path once.  Like the interpreter the names of the
+  // StructuredEvent fields are skipped, and the last name is a
+  // field of the fixed header, the remainder_of_body or a
+  // filterable_data property.
+  ETCL_Constraint *node = eval->component ();
+
+  while (node != 0)
+    {
+      ETCL_Dot *dot = dynamic_cast<ETCL_Dot *> (node);
+      if (dot != 0)
+        {
+          node = dot->component ();
+          continue;
+        }
+
+      ETCL_Component *component = dynamic_cast<ETCL_Component *> (node);
+      if (component == 0)
+        return -1;
+
+      const char *name = component->identifier ()->value ();
+      ETCL_Constraint *nested = component->component ();
+
+      bool const implicit =
+        ACE_OS::strcmp (name, "filterable_data") == 0
+        || ACE_OS::strcmp (name, "header") == 0
+        || ACE_OS::strcmp (name, "fixed_header") == 0
+        || ACE_OS::strcmp (name, "variable_header") == 0
+        || ACE_OS::strcmp (name, "event_type") == 0
+        || ACE_OS::strcmp (name, "remainder_of_body") == 0
+        || ACE_OS::strcmp (name, "domain_name") == 0
+        || ACE_OS::strcmp (name, "type_name") == 0
+        || ACE_OS::strcmp (name, "event_name") == 0;
+
+      if (nested != 0)
+        {
+          // The interpreter looks into the value of other names.
+          if (!implicit)
+            return -1;
+
+          node = nested;
+          continue;
+        }
+
+      if (!implicit)
+        return this->emit_property (name);
+
+      if (ACE_OS::strcmp (name, "domain_name") == 0)
+        this->emit (TAO_Notify_Constraint_Program::PUSH_DOMAIN_NAME);
+      else if (ACE_OS::strcmp (name, "type_name") == 0)
+        this->emit (TAO_Notify_Constraint_Program::PUSH_TYPE_NAME);
+      else if (ACE_OS::strcmp (name, "event_name") == 0)
+        this->emit (TAO_Notify_Constraint_Program::PUSH_EVENT_NAME);
+      else if (ACE_OS::strcmp (name, "remainder_of_body") == 0)
+        this->emit (TAO_Notify_Constraint_Program::PUSH_REMAINDER_OF_BODY);
+      else
+        return -1;
+
+      return this->push ();
+    }
+
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_default (ETCL_Default *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_exist (ETCL_Exist *)
+{
+  return -1;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_unary_expr (ETCL_Unary_Expr *unary_expr)
+{
+  if (unary_expr->subexpr ()->accept (this) != 0)
+    return -1;
+
+  switch (unary_expr->type ())
+    {
+    case ETCL_NOT:
+      this->emit (TAO_Notify_Constraint_Program::NOT);
+      return 0;
+    case ETCL_MINUS:
+      this->emit (TAO_Notify_Constraint_Program::NEGATE);
+      return 0;
+    case ETCL_PLUS:
+      return 0;
+    default:
+      return -1;
+    }
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_logical (
+    ETCL_Binary_Expr *binary,
+    TAO_Notify_Constraint_Program::Opcode jump)
+{
+  if (binary->lhs ()->accept (this) != 0)
+    return -1;
+
+  size_t const address = this->emit (jump);
+  this->pop ();
+
+  if (binary->rhs ()->accept (this) != 0)
+    return -1;
+
+  this->emit (TAO_Notify_Constraint_Program::TO_BOOLEAN);
+
+  this->program_.code_[address].arg_ =
+    static_cast<CORBA::ULong> (this->program_.code_.size ());
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_binary_expr (ETCL_Binary_Expr *binary_expr)
+{
+  TAO_Notify_Constraint_Program::Opcode op;
+
+  switch (binary_expr->type ())
+    {
+    case ETCL_OR:
+      return this->visit_logical (binary_expr,
+                                  TAO_Notify_Constraint_Program::JUMP_IF_TRUE);
+    case ETCL_AND:
+      return this->visit_logical (binary_expr,
+                                  TAO_Notify_Constraint_Program::JUMP_IF_FALSE);
+    case ETCL_LT:
+      op = TAO_Notify_Constraint_Program::LT;
+      break;
+    case ETCL_LE:
+      op = TAO_Notify_Constraint_Program::LE;
+      break;
+    case ETCL_GT:
+      op = TAO_Notify_Constraint_Program::GT;
+      break;
+    case ETCL_GE:
+      op = TAO_Notify_Constraint_Program::GE;
+      break;
+    case ETCL_EQ:
+      op = TAO_Notify_Constraint_Program::EQ;
+      break;
+    case ETCL_NE:
+      op = TAO_Notify_Constraint_Program::NE;
+      break;
+    case ETCL_PLUS:
+      op = TAO_Notify_Constraint_Program::ADD;
+      break;
+    case ETCL_MINUS:
+      op = TAO_Notify_Constraint_Program::SUBTRACT;
+      break;
+    case ETCL_MULT:
+      op = TAO_Notify_Constraint_Program::MULTIPLY;
+      break;
+    case ETCL_DIV:
+      op = TAO_Notify_Constraint_Program::DIVIDE;
+      break;
+    case ETCL_TWIDDLE:
+      op = TAO_Notify_Constraint_Program::TWIDDLE;
+      break;
+    default:
+      // "in" looks into sequences and structs.
+      return -1;
+    }
+
+  if (binary_expr->lhs ()->accept (this) != 0
+      || binary_expr->rhs ()->accept (this) != 0)
+    return -1;
+
+  this->emit (op);
+  this->pop ();
+  return 0;
+}
+
+int
+TAO_Notify_Constraint_Compiler::visit_preference (ETCL_Preference *)
+{
+  // The Notification Service does not use the preferences.
+  return -1;
+}
+
+// ****************************************************************
+
+TAO_Notify_Constraint_Program::TAO_Notify_Constraint_Program ()
+  : state_ (PENDING)
+{
+}
+
+TAO_Notify_Constraint_Program::~TAO_Notify_Constraint_Program ()
+{
+  this->reset ();
+}
+
+void
+TAO_Notify_Constraint_Program::reset ()
+{
+  for (size_t i = 0; i != this->literals_.size (); ++i)
+    {
+      if (this->literals_[i].type_ == STRING)
+        ACE::strdelete (const_cast<char *> (this->literals_[i].op_.str_));
+    }
+
+  this->literals_.clear ();
+  this->code_.clear ();
+  this->state_ = PENDING;
+}
+
+TAO_Notify_Constraint_Program::State
+TAO_Notify_Constraint_Program::state () const
+{
+  return this->state_;
+}
+
+bool
+TAO_Notify_Constraint_Program::compile (ETCL_Constraint *root,
+                                        Slot_Map &slots)
+{
+  this->reset ();
+
+  TAO_Notify_Constraint_Compiler compiler (*this, slots);
+
+  // Without a tree the interpreter never matches.
+  if (root == 0 || root->accept (&compiler) != 0)
+    {
+      this->reset ();
+      this->state_ = INTERPRETED;
+      return false;
+    }
+
+  this->state_ = COMPILED;
+  return true;
+}
+
+bool
+TAO_Notify_Constraint_Program::bind_event (
+  const CosNotification::StructuredEvent &event,
+  const Slot_Map &slots,
+  const CORBA::Any **slot_values,
+  Event_Fields &fields)
+{
+  // TAO_Notify_Constraint_Visitor::bind_structured_event fails on the
+  // same names.
+  if (has_duplicate_names (event.filterable_data)
+      || has_duplicate_names (event.header.variable_header))
+    return false;
+
+  size_t const slot_count = slots.current_size ();
+
+  for (size_t slot = 0; slot != slot_count; ++slot)
+    {
+      slot_values[slot] = 0;
+    }
+
+  if (slot_count != 0)
+    {
+      const CosNotification::PropertySeq &properties =
+        event.filterable_data;
+
+      for (CORBA::ULong index = 0; index < properties.length (); ++index)
+        {
+          CORBA::ULong slot = 0;
+          ACE_CString name (properties[index].name.in (), 0, false);
+
+          if (slots.find (name, slot) == 0)
+            {
+              slot_values[slot] = &properties[index].value;
+            }
+        }
+    }
+
+  fields.domain_name_ =
+    event.header.fixed_header.event_type.domain_name.in ();
+  fields.type_name_ = event.header.fixed_header.event_type.type_name.in ();
+  fields.event_name_ = event.header.fixed_header.event_name.in ();
+  fields.remainder_of_body_ = &event.remainder_of_body;
+  fields.slots_ = slot_count != 0 ? slot_values : 0;
+
+  return true;
+}
+
+int
+TAO_Notify_Constraint_Program::evaluate (const Event_Fields &fields) const
+{
+  Value stack[max_depth_];
+  size_t top = 0;
+
+  size_t const length = this->code_.size ();
+  size_t pc = 0;
+
+  // Any error makes the whole constraint false, as in the
+  // interpreter.  A value that cannot be read in place leaves the
+  // constraint to the interpreter.
+  while (pc < length)
+    {
+      const Instruction &instruction = this->code_[pc];
+      ++pc;
+
+      switch (instruction.op_)
+        {
+        case PUSH_LITERAL:
+          stack[top++] = this->literals_[instruction.arg_];
+          break;
+        case PUSH_DOMAIN_NAME:
+          stack[top++] = make_string (fields.domain_name_);
+          break;
+        case PUSH_TYPE_NAME:
+          stack[top++] = make_string (fields.type_name_);
+          break;
+        case PUSH_EVENT_NAME:
+          stack[top++] = make_string (fields.event_name_);
+          break;
+        case PUSH_REMAINDER_OF_BODY:
+          {
+            if (fields.remainder_of_body_->impl () == 0)
+              return 0;
+
+            Read_Result const result =
+              read_value (*fields.remainder_of_body_, stack[top++]);
+
+            if (result != READ)
+              return result == NOT_IN_PLACE ? -1 : 0;
+          }
+          break;
+        case PUSH_PROPERTY:
+          {
+            const CORBA::Any *any = fields.slots_[instruction.arg_];
+
+            if (any == 0 || any->impl () == 0)
+              return 0;
+
+            Read_Result const result = read_value (*any, stack[top++]);
+
+            if (result != READ)
+              return result == NOT_IN_PLACE ? -1 : 0;
+          }
+          break;
+        case NOT:
+          stack[top - 1] = make_boolean (!to_boolean (stack[top - 1]));
+          break;
+        case NEGATE:
+          stack[top - 1] = negate (stack[top - 1]);
+          break;
+        case JUMP_IF_FALSE:
+          if (!to_boolean (stack[top - 1]))
+            {
+              stack[top - 1] = make_boolean (false);
+              pc = instruction.arg_;
+            }
+          else
+            {
+              --top;
+            }
+          break;
+        case JUMP_IF_TRUE:
+          if (to_boolean (stack[top - 1]))
+            {
+              stack[top - 1] = make_boolean (true);
+              pc = instruction.arg_;
+            }
+          else
+            {
+              --top;
+            }
+          break;
+        case TO_BOOLEAN:
+          stack[top - 1] = make_boolean (to_boolean (stack[top - 1]));
+          break;
+        default:
+          {
+            // The binary operators.
+            const Value &rhs = stack[--top];
+            Value &lhs = stack[top - 1];
+
+            switch (instruction.op_)
+              {
+              case LT:
+                lhs = make_boolean (less (lhs, rhs));
+                break;
+              case LE:
+                lhs = make_boolean (!greater (lhs, rhs));
+                break;
+              case GT:
+                lhs = make_boolean (greater (lhs, rhs));
+                break;
+              case GE:
+                lhs = make_boolean (!less (lhs, rhs));
+                break;
+              case EQ:
+                lhs = make_boolean (equal (lhs, rhs));
+                break;
+              case NE:
+                lhs = make_boolean (!equal (lhs, rhs));
+                break;
+              case TWIDDLE:
+                // Is the left operand a substring of the right one?
+                if (lhs.type_ != STRING || rhs.type_ != STRING)
+                  return 0;
+                lhs = make_boolean (
+                  ACE_OS::strstr (rhs.op_.str_, lhs.op_.str_) != 0);
+                break;
+              case ADD:
+              case SUBTRACT:
+              case MULTIPLY:
+              case DIVIDE:
+                {
+                  Type const type = widest_type (lhs, rhs);
+
+                  if (type == DOUBLE)
+                    {
+                      CORBA::Double const l = to_double (lhs);
+                      CORBA::Double const r = to_double (rhs);
+
+                      switch (instruction.op_)
+                        {
+                        case ADD:
+                          lhs = make_double (l + r);
+                          break;
+                        case SUBTRACT:
+                          lhs = make_double (l - r);
+                          break;
+                        case MULTIPLY:
+                          lhs = make_double (l * r);
+                          break;
+                        default:
+                          lhs = make_double (ACE::is_equal (r, 0.0)
+                                             ? 0.0 : l / r);
+                          break;
+                        }
+                    }
+                  else if (type == SIGNED || type == INTEGER)
+                    {
+                      CORBA::Long const l = to_long (lhs);
+                      CORBA::Long const r = to_long (rhs);
+
+                      switch (instruction.op_)
+                        {
+                        case ADD:
+                          lhs = make_long (l + r);
+                          break;
+                        case SUBTRACT:
+                          lhs = make_long (l - r);
+                          break;
+                        case MULTIPLY:
+                          lhs = make_long (l * r);
+                          break;
+                        default:
+                          lhs = make_long (r == 0 ? 0 : l / r);
+                          break;
+                        }
+                    }
+                  else if (type == UNSIGNED)
+                    {
+                      CORBA::ULong const l = to_ulong (lhs);
+                      CORBA::ULong const r = to_ulong (rhs);
+
+                      switch (instruction.op_)
+                        {
+                        case ADD:
+                          lhs = make_ulong (l + r);
+                          break;
+                        case SUBTRACT:
+                          lhs = make_ulong (l - r);
+                          break;
+                        case MULTIPLY:
+                          lhs = make_ulong (l * r);
+                          break;
+                        default:
+                          lhs = make_ulong (r == 0 ? 0 : l / r);
+                          break;
+                        }
+                    }
+                  else
+                    {
+                      lhs = make_long (0);
+                    }
+                }
+                break;
+              default:
+                return 0;
+              }
+          }
+          break;
+        }
+    }
+
+  return top == 1 && to_boolean (stack[0]) ? 1 : 0;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,214 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Notify_Constraint_Program.h
+ *
+ *  Constraints compiled into flat programs, so matching a structured
+ *  event does not walk the expression tree of each constraint.
+ */
+//=============================================================================
+
+#ifndef TAO_NOTIFY_CONSTRAINT_PROGRAM_H
+#define TAO_NOTIFY_CONSTRAINT_PROGRAM_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Hash_Map_Manager.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Vector_T.h"
+#include "ace/SString.h"
+
+#include "orbsvcs/CosNotificationC.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ETCL_Constraint;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Notify_Constraint_Compiler;
+
+/**
+ * @class TAO_Notify_Constraint_Program
+ *
+ * @brief A constraint compiled into a program for a small stack
+ * machine.
+ *
+ * The program is compiled once from the expression tree built by
+ * TAO_Notify_Constraint_Interpreter and gives the same results as
+ * TAO_Notify_Constraint_Visitor.  The names of the filterable_data
+ * properties are replaced by slots shared by the programs of a
+ * filter, so each event is only searched once for all of them, and
+ * the evaluation does not allocate any memory.  The Anys of the event
+ * are read in place and never extracted from, they may be shared by
+ * the filters evaluated on other threads.
+ *
+ * Only the literals, the event type and event name, the
+ * remainder_of_body, the filterable_data properties and the
+ * arithmetic, comparison, substring and boolean operators are
+ * compiled.  Constraints using anything else, such as "exist",
+ * "default", "in" or the components of a property, fail to compile
+ * and must be interpreted.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Constraint_Program
+{
+public:
+  /// The slot of each filterable_data property used by the programs
+  /// of a filter.
+  typedef ACE_Hash_Map_Manager <ACE_CString, CORBA::ULong, ACE_Null_Mutex>
+    Slot_Map;
+
+  /// The fields of an event read by the programs.
+  struct Event_Fields
+  {
+    const char *domain_name_;
+    const char *type_name_;
+    const char *event_name_;
+    const CORBA::Any *remainder_of_body_;
+
+    /// The value of the property in each slot, or 0 if the event does
+    /// not have it.
+    const CORBA::Any * const *slots_;
+  };
+
+  /**
+   * Fill @a fields with the fields of @a event, pointing each entry of
+   * @a slot_values, one per slot of @a slots, to the first property
+   * of @a event in that slot or to 0.  Returns false if @a event gives
+   * a property twice: the interpreter never matches such an event, so
+   * the programs must not be evaluated on it.
+   */
+  static bool bind_event (const CosNotification::StructuredEvent &event,
+                          const Slot_Map &slots,
+                          const CORBA::Any **slot_values,
+                          Event_Fields &fields);
+
+  enum State
+    {
+      /// compile() was not called since the tree was built.
+      PENDING,
+      /// The constraint must be evaluated with the program.
+      COMPILED,
+      /// The constraint must be evaluated with the interpreter.
+      INTERPRETED
+    };
+
+  TAO_Notify_Constraint_Program (void);
+  ~TAO_Notify_Constraint_Program (void);
+
+  /**
+   * Compile the expression tree rooted at @a root, adding the
+   * properties it reads to @a slots.  Return false, and leave the
+   * program in the INTERPRETED state, if the tree cannot be
+   * compiled.
+   */
+  bool compile (ETCL_Constraint *root, Slot_Map &slots);
+
+  /// Discard the program, for instance when the tree is rebuilt.
+  void reset (void);
+
+  State state (void) const;
+
+  /**
+   * Returns 1 if the event described by @a fields satisfies the
+   * constraint and 0 if it does not.  Returns -1 if a value of the
+   * event, such as a string whose characters must be translated,
+   * cannot be read in place, the constraint must then be evaluated by
+   * the interpreter.  The program must be COMPILED.
+   */
+  int evaluate (const Event_Fields &fields) const;
+
+  /// The types of the values, in the order of the ETCL literal types,
+  /// the widest of two types is the larger one.
+  enum Type
+    {
+      STRING,
+      DOUBLE,
+      UNSIGNED,
+      SIGNED,
+      INTEGER,
+      BOOLEAN,
+      COMPONENT,
+      UNKNOWN
+    };
+
+  /// A literal, or a value read from the event.  The strings are not
+  /// owned.
+  struct Value
+  {
+    Type type_;
+    union
+    {
+      const char *str_;
+      CORBA::ULong uinteger_;
+      CORBA::Long integer_;
+      CORBA::Boolean bool_;
+      CORBA::Double double_;
+    } op_;
+  };
+
+private:
+  friend class TAO_Notify_Constraint_Compiler;
+
+  enum Opcode
+    {
+      PUSH_LITERAL,
+      PUSH_DOMAIN_NAME,
+      PUSH_TYPE_NAME,
+      PUSH_EVENT_NAME,
+      PUSH_REMAINDER_OF_BODY,
+      PUSH_PROPERTY,
+      NOT,
+      NEGATE,
+      ADD,
+      SUBTRACT,
+      MULTIPLY,
+      DIVIDE,
+      LT,
+      LE,
+      GT,
+      GE,
+      EQ,
+      NE,
+      TWIDDLE,
+      /// Jump to the argument, leaving false on the stack, if the top
+      /// of the stack is false, otherwise pop it.
+      JUMP_IF_FALSE,
+      /// Jump to the argument, leaving true on the stack, if the top
+      /// of the stack is true, otherwise pop it.
+      JUMP_IF_TRUE,
+      /// Replace the top of the stack with its boolean value.
+      TO_BOOLEAN
+    };
+
+  struct Instruction
+  {
+    Opcode op_;
+    CORBA::ULong arg_;
+  };
+
+  /// The deepest stack a program may use.
+  static const size_t max_depth_ = 32;
+
+  TAO_Notify_Constraint_Program (const TAO_Notify_Constraint_Program &) = delete;
+  TAO_Notify_Constraint_Program &operator= (const TAO_Notify_Constraint_Program &) = delete;
+
+  State state_;
+
+  ACE_Vector<Instruction> code_;
+
+  /// The literals of the program, their strings are owned.
+  ACE_Vector<Value> literals_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_NOTIFY_CONSTRAINT_PROGRAM_H */
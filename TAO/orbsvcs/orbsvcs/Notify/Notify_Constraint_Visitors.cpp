@@ -206,6 +206,44 @@ TAO_Notify_Constraint_Visitor::visit_union_pos (
 {
   try
   {
+    if (union_pos->union_value () == 0)
+      {
+        // $.() is the default member, which is only there when the
+        // discriminator selects it.
+        TAO_DynUnion_i dyn_union;
+        dyn_union.init (this->current_value_.in ());
+
+        CORBA::TypeCode_var tc = this->current_value_->type ();
+        CORBA::Long const default_index = tc->default_index ();
+
+        if (default_index < 0 || dyn_union.has_no_active_member ())
+          {
+            return -1;
+          }
+
+        CORBA::String_var active = dyn_union.member_name ();
+
+        if (ACE_OS::strcmp (active.in (),
+                            tc->member_name (default_index)) != 0)
+          {
+            return -1;
+          }
+
+        DynamicAny::DynAny_var u_member = dyn_union.member ();
+        this->current_value_ = u_member->to_any ();
+
+        ETCL_Constraint *nested = union_pos->component ();
+
+        if (nested == 0)
+          {
+            TAO_ETCL_Literal_Constraint lit (this->current_value_.ptr ());
+            this->queue_.enqueue_head (lit);
+            return 0;
+          }
+
+        return nested->accept (this);
+      }
+
     if (union_pos->union_value ()->accept (this) == 0)
       {
         TAO_ETCL_Literal_Constraint disc_val;
@@ -719,6 +757,10 @@ TAO_Notify_Constraint_Visitor::visit_component (
         }
       case REMAINDER_OF_BODY:
         {
+          // An event without a body has nothing to compare.
+          if (this->remainder_of_body_.impl () == 0)
+            return -1;
+
           TAO_ETCL_Literal_Constraint rob (&this->remainder_of_body_);
           this->queue_.enqueue_head (rob);
           return 0;
@@ -1100,11 +1142,18 @@ TAO_Notify_Constraint_Visitor::visit_twiddle (ETCL_Binary_Expr *binary)
         {
           TAO_ETCL_Literal_Constraint right;
           this->queue_.dequeue_head (right);
-          CORBA::Boolean result =
-            (ACE_OS::strstr ((const char *) right,
-                             (const char *) left) != 0);
-          this->queue_.enqueue_head (TAO_ETCL_Literal_Constraint (result));
-          return_value = 0;
+          const char *right_str = (const char *) right;
+          const char *left_str = (const char *) left;
+
+          // Only strings can be substrings of each other.
+          if (right_str != 0 && left_str != 0)
+            {
+              CORBA::Boolean result =
+                (ACE_OS::strstr (right_str, left_str) != 0);
+              this->queue_.enqueue_head (
+                TAO_ETCL_Literal_Constraint (result));
+              return_value = 0;
+            }
         }
     }
 
@@ -82,6 +82,11 @@ public:
   bool separate_dispatching_orb (void);
   void separate_dispatching_orb (bool b);
 
+  /// The number of pushes each consumer may have in progress at
+  /// once, 0 for no limit.
+  CORBA::ULong consumer_concurrency (void);
+  void consumer_concurrency (CORBA::ULong concurrency);
+
   // The QoS Property that must be applied to each newly created Event Channel
   const CosNotification::QoSProperties& default_event_channel_qos_properties (void);
 
@@ -146,6 +151,9 @@ protected:
   /// True is separate dispatching orb
   bool separate_dispatching_orb_;
 
+  /// The number of pushes each consumer may have in progress at once.
+  CORBA::ULong consumer_concurrency_;
+
   /// True if updates are enabled (default).
   CORBA::Boolean updates_;
 
@@ -134,6 +134,18 @@ TAO_Notify_Properties::separate_dispatching_orb (bool b)
   this->separate_dispatching_orb_ = b;
 }
 
+ACE_INLINE CORBA::ULong
+TAO_Notify_Properties::consumer_concurrency (void)
+{
+  return this->consumer_concurrency_;
+}
+
+ACE_INLINE void
+TAO_Notify_Properties::consumer_concurrency (CORBA::ULong concurrency)
+{
+  this->consumer_concurrency_ = concurrency;
+}
+
 ACE_INLINE CORBA::Boolean
 TAO_Notify_Properties::updates (void)
 {
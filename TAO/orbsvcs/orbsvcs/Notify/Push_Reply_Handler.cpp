@@ -0,0 +1,251 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Notify/Push_Reply_Handler.h"
+#include "orbsvcs/Notify/Method_Request_Event.h"
+#include "orbsvcs/Notify/Properties.h"
+
+#include "tao/debug.h"
+
+#include "ace/Truncate.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Notify_Push_Reply_Handler::TAO_Notify_Push_Reply_Handler (
+  TAO_Notify_Consumer* consumer)
+  : proxy_guard_ (consumer->proxy ())
+  , consumer_ (consumer)
+  , requests_ (0)
+  , poa_ (TAO_Notify_PROPERTIES::instance ()->default_poa ())
+{
+}
+
+TAO_Notify_Push_Reply_Handler::~TAO_Notify_Push_Reply_Handler ()
+{
+  // The POA was destroyed with the push in progress.  Leave the events
+  // incomplete, so the persistent ones are delivered again.
+  if (this->requests_ != 0)
+    {
+      TAO_Notify_Method_Request_Event_Queueable* request = 0;
+      while (this->requests_->dequeue_head (request) == 0)
+        request->release ();
+      delete this->requests_;
+    }
+}
+
+CORBA::Object_ptr
+TAO_Notify_Push_Reply_Handler::activate (PortableServer::Servant servant)
+{
+  this->id_ = this->poa_->activate_object (servant);
+  return this->poa_->id_to_reference (this->id_.in ());
+}
+
+void
+TAO_Notify_Push_Reply_Handler::deactivate ()
+{
+  try
+    {
+      this->poa_->deactivate_object (this->id_.in ());
+    }
+  catch (const CORBA::Exception&)
+    {
+      // The POA is being destroyed.
+    }
+}
+
+void
+TAO_Notify_Push_Reply_Handler::sending (
+  TAO_Notify_Consumer::Request_Queue* requests)
+{
+  this->requests_ = requests;
+  this->sent_ = ACE_OS::gettimeofday ();
+}
+
+void
+TAO_Notify_Push_Reply_Handler::not_sent ()
+{
+  this->requests_ = 0;
+  this->deactivate ();
+}
+
+void
+TAO_Notify_Push_Reply_Handler::completed (
+  TAO_Notify_Consumer::DispatchStatus status)
+{
+  TAO_Notify_Consumer::Request_Queue* requests = this->requests_;
+  this->requests_ = 0;
+  if (requests != 0)
+    this->consumer_->push_completed (requests, status, this->sent_);
+
+  this->deactivate ();
+}
+
+void
+TAO_Notify_Push_Reply_Handler::failed (
+  ::Messaging::ExceptionHolder* excep_holder)
+{
+  TAO_Notify_Consumer::DispatchStatus status =
+    TAO_Notify_Consumer::DISPATCH_DISCARD;
+  try
+    {
+      excep_holder->raise_exception ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      status = this->consumer_->push_exception_status (ex);
+    }
+
+  this->completed (status);
+}
+
+TAO_Notify_Structured_Reply_Handler::TAO_Notify_Structured_Reply_Handler (
+  TAO_Notify_Consumer* consumer)
+  : TAO_Notify_Push_Reply_Handler (consumer)
+{
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::push (
+  CosNotifyComm::StructuredPushConsumer_ptr consumer,
+  TAO_Notify_Consumer::Request_Queue* requests)
+{
+  TAO_Notify_Method_Request_Event_Queueable** request = 0;
+  requests->get (request);
+  CosNotification::StructuredEvent event;
+  (*request)->event ()->convert (event);
+
+  CORBA::Object_var object = this->activate (this);
+  CosNotifyComm::AMI_StructuredPushConsumerHandler_var handler =
+    CosNotifyComm::AMI_StructuredPushConsumerHandler::_unchecked_narrow (
+      object.in ());
+
+  this->sending (requests);
+  try
+    {
+      consumer->sendc_push_structured_event (handler.in (), event);
+    }
+  catch (const CORBA::Exception&)
+    {
+      this->not_sent ();
+      throw;
+    }
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::push_structured_event ()
+{
+  this->completed (TAO_Notify_Consumer::DISPATCH_SUCCESS);
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::push_structured_event_excep (
+  ::Messaging::ExceptionHolder* excep_holder)
+{
+  this->failed (excep_holder);
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::offer_change ()
+{
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::offer_change_excep (
+  ::Messaging::ExceptionHolder*)
+{
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::disconnect_structured_push_consumer ()
+{
+}
+
+void
+TAO_Notify_Structured_Reply_Handler::disconnect_structured_push_consumer_excep (
+  ::Messaging::ExceptionHolder*)
+{
+}
+
+TAO_Notify_Sequence_Reply_Handler::TAO_Notify_Sequence_Reply_Handler (
+  TAO_Notify_Consumer* consumer)
+  : TAO_Notify_Push_Reply_Handler (consumer)
+{
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::push (
+  CosNotifyComm::SequencePushConsumer_ptr consumer,
+  TAO_Notify_Consumer::Request_Queue* requests)
+{
+  CORBA::ULong const batch_size =
+    ACE_Utils::truncate_cast<CORBA::ULong> (requests->size ());
+  CosNotification::EventBatch batch (batch_size);
+  batch.length (batch_size);
+
+  CORBA::ULong pos = 0;
+  TAO_Notify_Method_Request_Event_Queueable** request = 0;
+  for (ACE_Unbounded_Queue_Iterator<TAO_Notify_Method_Request_Event_Queueable*>
+         iter (*requests);
+       iter.next (request) != 0;
+       iter.advance ())
+    {
+      (*request)->event ()->convert (batch[pos]);
+      ++pos;
+    }
+
+  CORBA::Object_var object = this->activate (this);
+  CosNotifyComm::AMI_SequencePushConsumerHandler_var handler =
+    CosNotifyComm::AMI_SequencePushConsumerHandler::_unchecked_narrow (
+      object.in ());
+
+  if (TAO_debug_level > 5)
+    ORBSVCS_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("(%P|%t) Sending a batch of %d events.\n"),
+                    batch_size));
+
+  this->sending (requests);
+  try
+    {
+      consumer->sendc_push_structured_events (handler.in (), batch);
+    }
+  catch (const CORBA::Exception&)
+    {
+      this->not_sent ();
+      throw;
+    }
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::push_structured_events ()
+{
+  this->completed (TAO_Notify_Consumer::DISPATCH_SUCCESS);
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::push_structured_events_excep (
+  ::Messaging::ExceptionHolder* excep_holder)
+{
+  this->failed (excep_holder);
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::offer_change ()
+{
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::offer_change_excep (
+  ::Messaging::ExceptionHolder*)
+{
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::disconnect_sequence_push_consumer ()
+{
+}
+
+void
+TAO_Notify_Sequence_Reply_Handler::disconnect_sequence_push_consumer_excep (
+  ::Messaging::ExceptionHolder*)
+{
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
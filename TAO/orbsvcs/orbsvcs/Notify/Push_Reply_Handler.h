@@ -0,0 +1,151 @@
+/* -*- C++ -*- */
+/**
+ *  @file Push_Reply_Handler.h
+ *
+ *  Reply handlers for the asynchronous pushes made when
+ *  -ConsumerConcurrency is set.
+ */
+
+#ifndef TAO_Notify_PUSH_REPLY_HANDLER_H
+#define TAO_Notify_PUSH_REPLY_HANDLER_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/CosNotifyCommS.h"
+
+#include "orbsvcs/Notify/Consumer.h"
+#include "orbsvcs/Notify/Proxy.h"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Notify_Push_Reply_Handler
+ *
+ * @brief The part common to the reply handlers of the asynchronous
+ * pushes.
+ *
+ * A handler is activated for each push.  It holds the events the push
+ * carries until the reply arrives, hands them back to the consumer
+ * with the outcome and deactivates itself.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Push_Reply_Handler
+{
+public:
+  /// Constructor
+  TAO_Notify_Push_Reply_Handler (TAO_Notify_Consumer* consumer);
+
+  /// Destructor.  Releases the events of a push that never completed.
+  virtual ~TAO_Notify_Push_Reply_Handler ();
+
+protected:
+  /// Activate @a servant in the Notify POA.
+  CORBA::Object_ptr activate (PortableServer::Servant servant);
+
+  /// Take @a requests just before the push is sent.
+  void sending (TAO_Notify_Consumer::Request_Queue* requests);
+
+  /// Give the requests back to the caller of push() if the push could
+  /// not be sent, and deactivate.
+  void not_sent (void);
+
+  /// The push completed with @a status.
+  void completed (TAO_Notify_Consumer::DispatchStatus status);
+
+  /// The push raised the exception held by @a excep_holder.
+  void failed (::Messaging::ExceptionHolder* excep_holder);
+
+private:
+  void deactivate (void);
+
+  /// Keep the consumer and its proxy while the push is in progress.
+  TAO_Notify_Proxy::Ptr proxy_guard_;
+  TAO_Notify_Consumer::Ptr consumer_;
+
+  /// The events of the push in progress.
+  TAO_Notify_Consumer::Request_Queue* requests_;
+
+  /// When the push was sent.
+  ACE_Time_Value sent_;
+
+  PortableServer::POA_var poa_;
+  PortableServer::ObjectId_var id_;
+};
+
+/**
+ * @class TAO_Notify_Structured_Reply_Handler
+ *
+ * @brief Receives the reply to a sendc_push_structured_event.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Structured_Reply_Handler
+  : public virtual POA_CosNotifyComm::AMI_StructuredPushConsumerHandler
+  , public TAO_Notify_Push_Reply_Handler
+{
+public:
+  /// Constructor
+  TAO_Notify_Structured_Reply_Handler (TAO_Notify_Consumer* consumer);
+
+  /// Push the single event in @a requests to @a consumer.  Takes
+  /// ownership of @a requests unless an exception is raised.
+  void push (CosNotifyComm::StructuredPushConsumer_ptr consumer,
+             TAO_Notify_Consumer::Request_Queue* requests);
+
+  virtual void push_structured_event (void);
+  virtual void push_structured_event_excep (
+    ::Messaging::ExceptionHolder* excep_holder);
+
+  virtual void offer_change (void);
+  virtual void offer_change_excep (::Messaging::ExceptionHolder*);
+  virtual void disconnect_structured_push_consumer (void);
+  virtual void disconnect_structured_push_consumer_excep (
+    ::Messaging::ExceptionHolder*);
+};
+
+/**
+ * @class TAO_Notify_Sequence_Reply_Handler
+ *
+ * @brief Receives the reply to a sendc_push_structured_events.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Sequence_Reply_Handler
+  : public virtual POA_CosNotifyComm::AMI_SequencePushConsumerHandler
+  , public TAO_Notify_Push_Reply_Handler
+{
+public:
+  /// Constructor
+  TAO_Notify_Sequence_Reply_Handler (TAO_Notify_Consumer* consumer);
+
+  /// Push the events in @a requests to @a consumer as one batch.  Takes
+  /// ownership of @a requests unless an exception is raised.
+  void push (CosNotifyComm::SequencePushConsumer_ptr consumer,
+             TAO_Notify_Consumer::Request_Queue* requests);
+
+  virtual void push_structured_events (void);
+  virtual void push_structured_events_excep (
+    ::Messaging::ExceptionHolder* excep_holder);
+
+  virtual void offer_change (void);
+  virtual void offer_change_excep (::Messaging::ExceptionHolder*);
+  virtual void disconnect_sequence_push_consumer (void);
+  virtual void disconnect_sequence_push_consumer_excep (
+    ::Messaging::ExceptionHolder*);
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_Notify_PUSH_REPLY_HANDLER_H */
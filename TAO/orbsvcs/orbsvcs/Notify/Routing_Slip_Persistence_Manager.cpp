@@ -9,7 +9,11 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace TAO_Notify
 {
 
-Routing_Slip_Persistence_Manager::Routing_Slip_Persistence_Manager(
+Routing_Slip_Persistence_Manager::~Routing_Slip_Persistence_Manager ()
+{
+}
+
+Standard_Routing_Slip_Persistence_Manager::Standard_Routing_Slip_Persistence_Manager(
   Standard_Event_Persistence_Factory* factory)
   : removed_(false)
   , serial_number_(0)
@@ -25,7 +29,7 @@ Routing_Slip_Persistence_Manager::Routing_Slip_Persistence_Manager(
   this->next_manager_ = this;
 }
 
-Routing_Slip_Persistence_Manager::~Routing_Slip_Persistence_Manager()
+Standard_Routing_Slip_Persistence_Manager::~Standard_Routing_Slip_Persistence_Manager()
 {
   ACE_ASSERT(this->prev_manager_ == this);
   ACE_ASSERT(this->next_manager_ == this);
@@ -40,14 +44,14 @@ Routing_Slip_Persistence_Manager::~Routing_Slip_Persistence_Manager()
 }
 
 void
-Routing_Slip_Persistence_Manager::set_callback(Persistent_Callback* callback)
+Standard_Routing_Slip_Persistence_Manager::set_callback(Persistent_Callback* callback)
 {
   ACE_GUARD(TAO_SYNCH_MUTEX, ace_mon, this->lock_);
   this->callback_ = callback;
 }
 
 bool
-Routing_Slip_Persistence_Manager::store_root()
+Standard_Routing_Slip_Persistence_Manager::store_root()
 {
   bool result = false;
 
@@ -85,7 +89,7 @@ Routing_Slip_Persistence_Manager::store_root()
 }
 
 bool
-Routing_Slip_Persistence_Manager::reload(
+Standard_Routing_Slip_Persistence_Manager::reload(
   ACE_Message_Block*& event,
   ACE_Message_Block*& routing_slip)
 {
@@ -107,7 +111,7 @@ Routing_Slip_Persistence_Manager::reload(
 }
 
 bool
-Routing_Slip_Persistence_Manager::load(
+Standard_Routing_Slip_Persistence_Manager::load(
   Block_Number block_number,
   Block_Serial_Number expected_serial_number)
 {
@@ -172,10 +176,10 @@ Routing_Slip_Persistence_Manager::load(
 }
 
 Routing_Slip_Persistence_Manager *
-Routing_Slip_Persistence_Manager::load_next ()
+Standard_Routing_Slip_Persistence_Manager::load_next ()
 {
-  Routing_Slip_Persistence_Manager * result;
-  ACE_NEW_RETURN(result, Routing_Slip_Persistence_Manager (this->factory_), 0);
+  Standard_Routing_Slip_Persistence_Manager * result;
+  ACE_NEW_RETURN(result, Standard_Routing_Slip_Persistence_Manager (this->factory_), 0);
 
   if (result->load(this->routing_slip_header_.next_routing_slip_block,
     this->routing_slip_header_.next_serial_number))
@@ -199,7 +203,7 @@ Routing_Slip_Persistence_Manager::load_next ()
 }
 
 bool
-Routing_Slip_Persistence_Manager::store(const ACE_Message_Block& event,
+Standard_Routing_Slip_Persistence_Manager::store(const ACE_Message_Block& event,
   const ACE_Message_Block& routing_slip)
 {
   bool result = false;
@@ -212,7 +216,7 @@ Routing_Slip_Persistence_Manager::store(const ACE_Message_Block& event,
 }
 
 bool
-Routing_Slip_Persistence_Manager::update(const ACE_Message_Block& routing_slip)
+Standard_Routing_Slip_Persistence_Manager::update(const ACE_Message_Block& routing_slip)
 {
   bool result = false;
   ACE_GUARD_RETURN(TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
@@ -228,14 +232,14 @@ Routing_Slip_Persistence_Manager::update(const ACE_Message_Block& routing_slip)
 }
 
 bool
-Routing_Slip_Persistence_Manager::remove()
+Standard_Routing_Slip_Persistence_Manager::remove()
 {
   bool result = false;
   ACE_GUARD_RETURN(TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
   // Assert that this is in the dllist
   ACE_ASSERT(this->prev_manager_ != this);
   ACE_ASSERT(this->persisted());
-  Routing_Slip_Persistence_Manager* prev = this->prev_manager_;
+  Standard_Routing_Slip_Persistence_Manager* prev = this->prev_manager_;
   // Once our previous manager removes us, we can deallocate in any order
   this->factory_->lock.acquire();
   this->remove_from_dllist();
@@ -270,19 +274,19 @@ Routing_Slip_Persistence_Manager::remove()
   return result;
 }
 
-Routing_Slip_Persistence_Manager::Block_Header::Block_Header(Header_Type type)
+Standard_Routing_Slip_Persistence_Manager::Block_Header::Block_Header(Header_Type type)
   : serial_number (0)
   , next_overflow(0)
   , header_type (static_cast<Block_Type> (type))
   , data_size(0)
 {
 }
-Routing_Slip_Persistence_Manager::Block_Header::~Block_Header ()
+Standard_Routing_Slip_Persistence_Manager::Block_Header::~Block_Header ()
 {
 }
 
 size_t
-Routing_Slip_Persistence_Manager::Block_Header::extract_header(
+Standard_Routing_Slip_Persistence_Manager::Block_Header::extract_header(
   Persistent_Storage_Block& psb, size_t offset)
 {
   size_t pos = offset;
@@ -311,7 +315,7 @@ Routing_Slip_Persistence_Manager::Block_Header::extract_header(
 }
 
 size_t
-Routing_Slip_Persistence_Manager::Block_Header::put_header(
+Standard_Routing_Slip_Persistence_Manager::Block_Header::put_header(
   Persistent_Storage_Block& psb, size_t offset)
 {
   // Assume that our psb can hold our small amount of data...
@@ -341,7 +345,7 @@ Routing_Slip_Persistence_Manager::Block_Header::put_header(
   return pos;
 }
 
-Routing_Slip_Persistence_Manager::Routing_Slip_Header::Routing_Slip_Header()
+Standard_Routing_Slip_Persistence_Manager::Routing_Slip_Header::Routing_Slip_Header()
   : Block_Header (BT_Event)
   , next_routing_slip_block(0)
   , next_serial_number(0)
@@ -350,7 +354,7 @@ Routing_Slip_Persistence_Manager::Routing_Slip_Header::Routing_Slip_Header()
 }
 
 size_t
-Routing_Slip_Persistence_Manager::Routing_Slip_Header::extract_header(
+Standard_Routing_Slip_Persistence_Manager::Routing_Slip_Header::extract_header(
   Persistent_Storage_Block& psb, size_t offset)
 {
   size_t pos = offset;
@@ -376,7 +380,7 @@ Routing_Slip_Persistence_Manager::Routing_Slip_Header::extract_header(
 }
 
 size_t
-Routing_Slip_Persistence_Manager::Routing_Slip_Header::put_header(
+Standard_Routing_Slip_Persistence_Manager::Routing_Slip_Header::put_header(
   Persistent_Storage_Block& psb, size_t offset)
 {
   // Assume that our psb can hold our small amount of data...
@@ -407,18 +411,18 @@ Routing_Slip_Persistence_Manager::Routing_Slip_Header::put_header(
   return pos;
 }
 
-Routing_Slip_Persistence_Manager::Overflow_Header::Overflow_Header ()
+Standard_Routing_Slip_Persistence_Manager::Overflow_Header::Overflow_Header ()
   : Block_Header (BT_Overflow)
 {
 }
 
-Routing_Slip_Persistence_Manager::Event_Header::Event_Header ()
+Standard_Routing_Slip_Persistence_Manager::Event_Header::Event_Header ()
   : Block_Header (BT_Routing_Slip)
 {
 }
 
 bool
-Routing_Slip_Persistence_Manager::store_i(const ACE_Message_Block& event,
+Standard_Routing_Slip_Persistence_Manager::store_i(const ACE_Message_Block& event,
   const ACE_Message_Block& routing_slip)
 {
   bool result = false;
@@ -474,7 +478,7 @@ Routing_Slip_Persistence_Manager::store_i(const ACE_Message_Block& event,
 }
 
 bool
-Routing_Slip_Persistence_Manager::update_i(
+Standard_Routing_Slip_Persistence_Manager::update_i(
   const ACE_Message_Block& routing_slip)
 {
   bool result = true;
@@ -495,7 +499,7 @@ Routing_Slip_Persistence_Manager::update_i(
 }
 
 bool
-Routing_Slip_Persistence_Manager::store_event(
+Standard_Routing_Slip_Persistence_Manager::store_event(
   const ACE_Message_Block& event)
 {
   bool result = true;
@@ -518,7 +522,7 @@ Routing_Slip_Persistence_Manager::store_event(
 }
 
 size_t
-Routing_Slip_Persistence_Manager::fill_block(Persistent_Storage_Block& psb,
+Standard_Routing_Slip_Persistence_Manager::fill_block(Persistent_Storage_Block& psb,
   size_t offset_into_block, const ACE_Message_Block* data,
   size_t offset_into_msg)
 {
@@ -528,7 +532,7 @@ Routing_Slip_Persistence_Manager::fill_block(Persistent_Storage_Block& psb,
 }
 
 size_t
-Routing_Slip_Persistence_Manager::fill_block(Persistent_Storage_Block& psb,
+Standard_Routing_Slip_Persistence_Manager::fill_block(Persistent_Storage_Block& psb,
   size_t offset_into_block, unsigned char* data, size_t data_size)
 {
   size_t result = 0;
@@ -551,7 +555,7 @@ Routing_Slip_Persistence_Manager::fill_block(Persistent_Storage_Block& psb,
 }
 
 bool
-Routing_Slip_Persistence_Manager::build_chain(
+Standard_Routing_Slip_Persistence_Manager::build_chain(
     Persistent_Storage_Block* first_block, Block_Header& first_header,
     ACE_Unbounded_Stack<size_t>& allocated_blocks,
     const ACE_Message_Block& data)
@@ -580,7 +584,7 @@ Routing_Slip_Persistence_Manager::build_chain(
     remainder = this->fill_block(*first_block, pos, mblk, 0);
   }
   first_header.data_size =
-    static_cast<TAO_Notify::Routing_Slip_Persistence_Manager::Block_Size> (data_size - remainder);
+    static_cast<TAO_Notify::Standard_Routing_Slip_Persistence_Manager::Block_Size> (data_size - remainder);
   first_header.next_overflow = 0;
 
   Block_Header* prevhdr = &first_header;
@@ -598,7 +602,7 @@ Routing_Slip_Persistence_Manager::build_chain(
     prevhdr->put_header(*prevblk);
     pos = hdr->put_header(*curblk);
     hdr->data_size =
-      static_cast<TAO_Notify::Routing_Slip_Persistence_Manager::Block_Size> (remainder);
+      static_cast<TAO_Notify::Standard_Routing_Slip_Persistence_Manager::Block_Size> (remainder);
 
     size_t offset_into_msg = mblk->length() - remainder;
     remainder = this->fill_block(*curblk, pos, mblk, offset_into_msg);
@@ -610,7 +614,7 @@ Routing_Slip_Persistence_Manager::build_chain(
     }
 
     hdr->data_size = hdr->data_size -
-      static_cast<TAO_Notify::Routing_Slip_Persistence_Manager::Block_Size> (remainder);
+      static_cast<TAO_Notify::Standard_Routing_Slip_Persistence_Manager::Block_Size> (remainder);
     if (prevblk != first_block)
     {
       // allocator obtains ownership, so write out and delete the header
@@ -643,7 +647,7 @@ Routing_Slip_Persistence_Manager::build_chain(
 }
 
 bool
-Routing_Slip_Persistence_Manager::reload_chain(
+Standard_Routing_Slip_Persistence_Manager::reload_chain(
   Persistent_Storage_Block* first_block, Block_Header& first_header,
   ACE_Unbounded_Stack<size_t>& allocated_blocks,
   ACE_Message_Block* amb,
@@ -697,8 +701,8 @@ Routing_Slip_Persistence_Manager::reload_chain(
 }
 
 bool
-Routing_Slip_Persistence_Manager::update_next_manager(
-  Routing_Slip_Persistence_Manager* next)
+Standard_Routing_Slip_Persistence_Manager::update_next_manager(
+  Standard_Routing_Slip_Persistence_Manager* next)
 {
   bool result = false;
   ACE_GUARD_RETURN(TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
@@ -732,24 +736,24 @@ Routing_Slip_Persistence_Manager::update_next_manager(
 }
 
 bool
-Routing_Slip_Persistence_Manager::persisted()
+Standard_Routing_Slip_Persistence_Manager::persisted()
 {
   return (0 != this->first_routing_slip_block_);
 }
 
 bool
-Routing_Slip_Persistence_Manager::is_root () const
+Standard_Routing_Slip_Persistence_Manager::is_root () const
 {
   return this->serial_number_ == ROUTING_SLIP_ROOT_SERIAL_NUMBER;
 }
 
 void
-Routing_Slip_Persistence_Manager::release_all ()
+Standard_Routing_Slip_Persistence_Manager::release_all ()
 {
   ACE_ASSERT(is_root());
   while (this->next_manager_ != this)
   {
-    Routing_Slip_Persistence_Manager * next = this->next_manager_;
+    Standard_Routing_Slip_Persistence_Manager * next = this->next_manager_;
     next->remove_from_dllist();
     ACE_ASSERT(next != this->next_manager_);
     delete next;
@@ -757,7 +761,7 @@ Routing_Slip_Persistence_Manager::release_all ()
 }
 
 size_t
-Routing_Slip_Persistence_Manager::write_first_routing_slip_block(
+Standard_Routing_Slip_Persistence_Manager::write_first_routing_slip_block(
   bool prepare_only)
 {
   size_t pos = this->routing_slip_header_.put_header(
@@ -770,13 +774,13 @@ Routing_Slip_Persistence_Manager::write_first_routing_slip_block(
 }
 
 void
-Routing_Slip_Persistence_Manager::dllist_push_back()
+Standard_Routing_Slip_Persistence_Manager::dllist_push_back()
 {
   insert_before (&this->factory_->root());
 }
 
 void
-Routing_Slip_Persistence_Manager::insert_before (Routing_Slip_Persistence_Manager * node)
+Standard_Routing_Slip_Persistence_Manager::insert_before (Standard_Routing_Slip_Persistence_Manager * node)
 {
   // Since this is a private function, the caller should have done locking
   // on the factory before calling here.  The same is true for removals.
@@ -790,7 +794,7 @@ Routing_Slip_Persistence_Manager::insert_before (Routing_Slip_Persistence_Manage
 }
 
 void
-Routing_Slip_Persistence_Manager::remove_from_dllist()
+Standard_Routing_Slip_Persistence_Manager::remove_from_dllist()
 {
   // Since this is a private function, the caller should have done locking
   // on the factory before calling here.  The same is true for insertions.
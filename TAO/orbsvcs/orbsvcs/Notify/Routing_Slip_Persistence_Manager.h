@@ -40,12 +40,59 @@ class Persistent_Callback;
 /**
  * \brief Manage interaction between Routing_Slip and persistent storage.
  *
- * todo: to complete the strategization of event persistent storage this
- * should become an interface that is implemented differently by different
- * strategies.  For now it interacts with Standard_Event_Persistence.
+ * Each Event_Persistence_Strategy implements this interface to persist
+ * an event and its routing slip.  The Persistent_Callback is called,
+ * from another thread, once each store, update or remove is on disk.
  */
 class TAO_Notify_Serv_Export Routing_Slip_Persistence_Manager
 {
+public:
+  /// The destructor.
+  virtual ~Routing_Slip_Persistence_Manager ();
+
+  /// Set up callbacks
+  virtual void set_callback(Persistent_Callback* callback) = 0;
+
+  /// Store an event + routing slip.
+  virtual bool store(const ACE_Message_Block& event,
+    const ACE_Message_Block& routing_slip) = 0;
+
+  /// \brief Update the routing slip.
+  virtual bool update(const ACE_Message_Block& routing_slip) = 0;
+
+  /// \brief Remove our associated event and routing slip from the
+  /// persistent storage.
+  virtual bool remove() = 0;
+
+  /////////////////////////////////////////
+  // Methods to be used during reload only.
+
+  /// \brief Call this method to recover data during event reload.
+  ///
+  /// It should not fail under normal circumstances.
+  /// Caller owns the resulting message blocks and is responsible
+  /// for deleting them.
+  virtual bool reload(ACE_Message_Block*& event,
+    ACE_Message_Block*& routing_slip) = 0;
+
+  /// \brief Get next RSPM during reload.
+  ///
+  /// After using the data from the reload method, call this
+  /// method to get the next RSPM.  It returns a null pointer
+  /// when all persistent events have been reloaded.
+  virtual Routing_Slip_Persistence_Manager * load_next () = 0;
+};
+
+/**
+ * \brief The Routing_Slip_Persistence_Manager of
+ * Standard_Event_Persistence.
+ *
+ * It stores the event and the routing slip in chains of blocks
+ * allocated by a Persistent_File_Allocator.
+ */
+class TAO_Notify_Serv_Export Standard_Routing_Slip_Persistence_Manager
+  : public Routing_Slip_Persistence_Manager
+{
 public:
   /// A unique identifier for logical blocks in persistent storage.
   typedef ACE_UINT64 Block_Serial_Number;
@@ -57,16 +104,16 @@ public:
   typedef ACE_UINT16 Block_Type;
 
   /// The constructor.
-  Routing_Slip_Persistence_Manager(Standard_Event_Persistence_Factory* factory);
+  Standard_Routing_Slip_Persistence_Manager(Standard_Event_Persistence_Factory* factory);
 
   /// The destructor.
-  ~Routing_Slip_Persistence_Manager();
+  virtual ~Standard_Routing_Slip_Persistence_Manager();
 
   /// Set up callbacks
-  void set_callback(Persistent_Callback* callback);
+  virtual void set_callback(Persistent_Callback* callback);
 
   /// Store an event + routing slip.
-  bool store(const ACE_Message_Block& event,
+  virtual bool store(const ACE_Message_Block& event,
     const ACE_Message_Block& routing_slip);
 
   /// \brief Update the routing slip.
@@ -74,29 +121,16 @@ public:
   /// We must always overwrite the first block
   /// last, and it may not chance.  Other blocks should be freed and
   /// reallocated.
-  bool update(const ACE_Message_Block& routing_slip);
+  virtual bool update(const ACE_Message_Block& routing_slip);
 
   /// \brief Remove our associated event and routing slip from the
   /// Persistent_File_Allocator.
-  bool remove();
-
-  /////////////////////////////////////////
-  // Methods to be used during reload only.
+  virtual bool remove();
 
-  /// \brief Call this method to recover data during event reload.
-  ///
-  /// It should not fail under normal circumstances.
-  /// Caller owns the resulting message blocks and is responsible
-  /// for deleting them.
   /// Reload the event and routing_slip from the Persistent_File_Allocator.
-  bool reload(ACE_Message_Block*& event, ACE_Message_Block*&routing_slip);
+  virtual bool reload(ACE_Message_Block*& event, ACE_Message_Block*&routing_slip);
 
-  /// \brief Get next RSPM during reload.
-  ///
-  /// After using the data from the reload method, call this
-  /// method to get the next RSPM.  It returns a null pointer
-  /// when all persistent events have been reloaded.
-  Routing_Slip_Persistence_Manager * load_next ();
+  virtual Routing_Slip_Persistence_Manager * load_next ();
 
   /////////////////////////
   // Implementation methods.
@@ -218,7 +252,7 @@ private:
     ACE_UINT64 expected_serial_number);
 
   /// Locked method to do the work of setting the next_manager_.
-  bool update_next_manager(Routing_Slip_Persistence_Manager* next);
+  bool update_next_manager(Standard_Routing_Slip_Persistence_Manager* next);
 
   /// Have we been persisted yet?
   bool persisted();
@@ -229,7 +263,7 @@ private:
   /// Insert ourselves into a linked list of Routing_Slip_Persistnce_Managers
   void dllist_push_back();
 
-  void insert_before (Routing_Slip_Persistence_Manager * node);
+  void insert_before (Standard_Routing_Slip_Persistence_Manager * node);
 
   /// Remove ourselves from a linked list of Routing_Slip_Persistence_Managers
   void remove_from_dllist();
@@ -245,8 +279,8 @@ private:
   Persistent_Storage_Block* first_event_block_;
   Persistent_Storage_Block* first_routing_slip_block_;
   /// We are part of a doubly-linked list
-  Routing_Slip_Persistence_Manager* prev_manager_;
-  Routing_Slip_Persistence_Manager* next_manager_;
+  Standard_Routing_Slip_Persistence_Manager* prev_manager_;
+  Standard_Routing_Slip_Persistence_Manager* next_manager_;
   ACE_Unbounded_Stack<size_t> allocated_event_blocks_;
   ACE_Unbounded_Stack<size_t> allocated_routing_slip_blocks_;
   Persistent_Callback* callback_;
@@ -14,6 +14,7 @@
 #include "orbsvcs/Notify/Timer.h"
 #include "orbsvcs/Notify/Proxy.h"
 #include "orbsvcs/Notify/Properties.h"
+#include "orbsvcs/Notify/Push_Reply_Handler.h"
 //#define DEBUG_LEVEL 10
 #ifndef DEBUG_LEVEL
 # define DEBUG_LEVEL TAO_debug_level
@@ -45,6 +46,12 @@ TAO_Notify_SequencePushConsumer::init (CosNotifyComm::SequencePushConsumer_ptr p
     {
       this->push_consumer_ = CosNotifyComm::SequencePushConsumer::_duplicate (push_consumer);
       this->publish_ = CosNotifyComm::NotifyPublish::_duplicate (push_consumer);
+
+      // The replies to asynchronous pushes need the ORB event loop, which
+      // the separate dispatching ORB does not run.
+      this->concurrency_ =
+        TAO_Notify_PROPERTIES::instance()->consumer_concurrency ();
+      this->async_batches_ = true;
     }
   else
     {
@@ -97,7 +104,6 @@ bool
 TAO_Notify_SequencePushConsumer::dispatch_from_queue (Request_Queue& requests, ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
 // FUZZ: enable check_for_ACE_Guard
 {
-  bool result = true;
   if (DEBUG_LEVEL > 0)
   {
     ORBSVCS_DEBUG ( (LM_DEBUG,
@@ -105,159 +111,9 @@ TAO_Notify_SequencePushConsumer::dispatch_from_queue (Request_Queue& requests, A
       requests.size ()));
   }
 
-  CORBA::ULong queue_size = ACE_Utils::truncate_cast<CORBA::ULong> (requests.size ());
-  CORBA::Long max_batch_size = queue_size;
-  if (this->max_batch_size_.is_valid () )
-  {
-    max_batch_size = this->max_batch_size_.value ();
-  }
-  CORBA::Long batch_size = queue_size;
-  if (batch_size > max_batch_size)
-  {
-    batch_size = max_batch_size;
-  }
-  if (batch_size > 0)
-  {
-    CosNotification::EventBatch batch (batch_size);
-    batch.length (batch_size);
-
-    Request_Queue completed;
-
-    CORBA::Long pos = 0;
-    TAO_Notify_Method_Request_Event_Queueable * request = 0;
-    while (pos < batch_size && requests.dequeue_head (request) == 0)
-    {
-      if (DEBUG_LEVEL > 0)
-      {
-        ORBSVCS_DEBUG ( (LM_DEBUG,
-          ACE_TEXT ("(%P|%t) Sequence Dispatch Method_Request_Dispatch @%@\n"),
-          request));
-      }
-
-      const TAO_Notify_Event * ev = request->event ();
-      ev->convert (batch [pos]);
-      ++pos;
-
-      // note enqueue at head, use queue as stack.
-      completed.enqueue_head (request);
-    }
-    batch.length (pos);
-    ACE_ASSERT (pos > 0);
-
-    ace_mon.release ();
-    bool from_timeout = false;
-    TAO_Notify_Consumer::DispatchStatus status =
-      this->dispatch_batch (batch);
-    ace_mon.acquire ();
-    switch (status)
-    {
-    case DISPATCH_SUCCESS:
-      {
-        TAO_Notify_Method_Request_Event_Queueable * request = 0;
-        while (completed.dequeue_head (request) == 0)
-        {
-          request->complete ();
-          request->release ();
-        }
-        result = true;
-        break;
-      }
-    case DISPATCH_FAIL_TIMEOUT:
-      from_timeout = true;
-      // Fall through
-    case DISPATCH_FAIL:
-      {
-        TAO_Notify_Method_Request_Event_Queueable * request = 0;
-        while (completed.dequeue_head (request) == 0)
-        {
-          if (request->should_retry ())
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
-                          static_cast <int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            requests.enqueue_head (request);
-            result = false;
-          }
-          else
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            request->complete ();
-            request->release ();
-          }
-        }
-        while (requests.dequeue_head (request) == 0)
-        {
-          if (request->should_retry ())
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            requests.enqueue_head (request);
-            result = false;
-          }
-          else
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            request->complete ();
-            request->release ();
-          }
-        }
-        ace_mon.release();
-        try
-        {
-          this->proxy_supplier ()->destroy (from_timeout);
-        }
-        catch (const CORBA::Exception&)
-        {
-          // todo is there something meaningful we can do here?
-          ;
-        }
-        ace_mon.acquire();
-        break;
-      }
-    case DISPATCH_RETRY:
-    case DISPATCH_DISCARD:
-      {
-        TAO_Notify_Method_Request_Event_Queueable *  request = 0;
-        while (completed.dequeue_head (request) == 0)
-        {
-          if (request->should_retry ())
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            requests.enqueue_head (request);
-            result = false;
-          }
-          else
-          {
-            if (DEBUG_LEVEL > 0)
-              ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) Consumer %d: Discarding %d\n"),
-                          static_cast<int> (this->proxy ()->id ()),
-                          request->sequence ()));
-            request->complete ();
-            request->release ();
-          }
-        }
-        break;
-      }
-    default:
-      {
-        result = false;
-        break;
-      }
-    }
-  }
-  return result;
+  CORBA::Long const batch_size =
+    static_cast<CORBA::Long> (this->queue_batch_size (requests.size ()));
+  return this->dispatch_batch_from_queue (requests, ace_mon, batch_size);
 }
 
 bool
@@ -308,6 +164,19 @@ TAO_Notify_SequencePushConsumer::push (const CosNotification::EventBatch& event_
   this->push_consumer_->push_structured_events (event_batch);
 }
 
+void
+TAO_Notify_SequencePushConsumer::push_async (Request_Queue * requests)
+{
+  last_ping_ = ACE_OS::gettimeofday ();
+
+  TAO_Notify_Sequence_Reply_Handler* handler = 0;
+  ACE_NEW_THROW_EX (handler,
+                    TAO_Notify_Sequence_Reply_Handler (this),
+                    CORBA::NO_MEMORY ());
+  PortableServer::ServantBase_var owner (handler);
+  handler->push (this->push_consumer_.in (), requests);
+}
+
 ACE_CString
 TAO_Notify_SequencePushConsumer::get_ior () const
 {
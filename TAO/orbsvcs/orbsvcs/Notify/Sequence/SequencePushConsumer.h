@@ -74,6 +74,9 @@ protected:
 
   virtual CORBA::Object_ptr get_consumer (void);
 
+  /// Send the events as one batch with sendc_push_structured_events.
+  virtual void push_async (Request_Queue * requests);
+
   /// The Consumer
   CosNotifyComm::SequencePushConsumer_var push_consumer_;
 
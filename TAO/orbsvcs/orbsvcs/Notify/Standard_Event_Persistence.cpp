@@ -158,7 +158,7 @@ Standard_Event_Persistence_Factory::create_routing_slip_persistence_manager(
   Persistent_Callback* callback)
 {
   Routing_Slip_Persistence_Manager* rspm = 0;
-  ACE_NEW_RETURN(rspm, Routing_Slip_Persistence_Manager(this), rspm);
+  ACE_NEW_RETURN(rspm, Standard_Routing_Slip_Persistence_Manager(this), rspm);
   rspm->set_callback(callback);
   return rspm;
 }
@@ -219,7 +219,7 @@ Standard_Event_Persistence_Factory::allocator()
   return &this->allocator_;
 }
 
-Routing_Slip_Persistence_Manager &
+Standard_Routing_Slip_Persistence_Manager &
 Standard_Event_Persistence_Factory::root()
 {
   return this->root_;
@@ -81,14 +81,14 @@ namespace TAO_Notify
 
     /// Access root record.
     /// Intended for use only by the Routing Slip Persistence Manager
-    Routing_Slip_Persistence_Manager & root();
+    Standard_Routing_Slip_Persistence_Manager & root();
 
   public:
     TAO_SYNCH_MUTEX lock;
 
   private:
     Persistent_File_Allocator allocator_;
-    Routing_Slip_Persistence_Manager root_;
+    Standard_Routing_Slip_Persistence_Manager root_;
     Persistent_Storage_Block* psb_;
     ACE_UINT64 serial_number_;
     bool is_reloading_;
@@ -5,6 +5,7 @@
 #include "tao/ORB_Core.h"
 #include "orbsvcs/Notify/Properties.h"
 #include "orbsvcs/Notify/Event.h"
+#include "orbsvcs/Notify/Push_Reply_Handler.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -32,6 +33,25 @@ TAO_Notify_StructuredPushConsumer::init (CosNotifyComm::StructuredPushConsumer_p
     {
       this->push_consumer_ = CosNotifyComm::StructuredPushConsumer::_duplicate (push_consumer);
       this->publish_ = CosNotifyComm::NotifyPublish::_duplicate (push_consumer);
+
+      // The replies to asynchronous pushes need the ORB event loop, which
+      // the separate dispatching ORB does not run.
+      this->concurrency_ =
+        TAO_Notify_PROPERTIES::instance()->consumer_concurrency ();
+      if (this->concurrency_ != 0)
+        {
+          try
+            {
+              if (push_consumer->_is_a ("IDL:omg.org/CosNotifyComm/SequencePushConsumer:1.0"))
+                this->sequence_consumer_ =
+                  CosNotifyComm::SequencePushConsumer::_unchecked_narrow (push_consumer);
+            }
+          catch (const CORBA::Exception&)
+            {
+              // Push the events one at a time.
+            }
+          this->async_batches_ = !CORBA::is_nil (this->sequence_consumer_.in ());
+        }
     }
   else
     {
@@ -151,6 +171,31 @@ TAO_Notify_StructuredPushConsumer::push (const CosNotification::EventBatch& even
   // TODO exception?
 }
 
+void
+TAO_Notify_StructuredPushConsumer::push_async (Request_Queue * requests)
+{
+  last_ping_ = ACE_OS::gettimeofday ();
+
+  if (!CORBA::is_nil (this->sequence_consumer_.in ()))
+    {
+      TAO_Notify_Sequence_Reply_Handler* handler = 0;
+      ACE_NEW_THROW_EX (handler,
+                        TAO_Notify_Sequence_Reply_Handler (this),
+                        CORBA::NO_MEMORY ());
+      PortableServer::ServantBase_var owner (handler);
+      handler->push (this->sequence_consumer_.in (), requests);
+    }
+  else
+    {
+      TAO_Notify_Structured_Reply_Handler* handler = 0;
+      ACE_NEW_THROW_EX (handler,
+                        TAO_Notify_Structured_Reply_Handler (this),
+                        CORBA::NO_MEMORY ());
+      PortableServer::ServantBase_var owner (handler);
+      handler->push (this->push_consumer_.in (), requests);
+    }
+}
+
 void
 TAO_Notify_StructuredPushConsumer::reconnect_from_consumer (TAO_Notify_Consumer* old_consumer)
 {
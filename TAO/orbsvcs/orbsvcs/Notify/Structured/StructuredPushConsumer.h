@@ -64,9 +64,18 @@ protected:
 
   virtual CORBA::Object_ptr get_consumer (void);
 
+  /// Send the events with sendc_push_structured_event, or as one batch
+  /// with sendc_push_structured_events if the consumer is also a
+  /// SequencePushConsumer.
+  virtual void push_async (Request_Queue * requests);
+
   /// The Consumer
   CosNotifyComm::StructuredPushConsumer_var push_consumer_;
 
+  /// The Consumer, if it is also a SequencePushConsumer and the events
+  /// are pushed asynchronously.
+  CosNotifyComm::SequencePushConsumer_var sequence_consumer_;
+
 private:
   /// Release
   virtual void release (void);
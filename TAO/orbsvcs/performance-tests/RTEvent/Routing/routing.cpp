@@ -0,0 +1,254 @@
+#include "orbsvcs/Event_Utilities.h"
+#include "orbsvcs/Event_Service_Constants.h"
+#include "orbsvcs/RtecEventCommS.h"
+
+#include "orbsvcs/Event/EC_Event_Channel.h"
+#include "orbsvcs/Event/EC_Default_Factory.h"
+
+#include "tao/PortableServer/PortableServer.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Sample_History.h"
+#include "ace/Basic_Stats.h"
+#include "ace/Throughput_Stats.h"
+#include "ace/OS_NS_stdlib.h"
+
+/// Count the events it receives.
+class Consumer : public POA_RtecEventComm::PushConsumer
+{
+public:
+  Consumer ()
+    : event_count_ (0)
+  {
+  }
+
+  void push (const RtecEventComm::EventSet &events)
+  {
+    this->event_count_ += events.length ();
+  }
+
+  void disconnect_push_consumer ()
+  {
+  }
+
+  CORBA::ULong event_count_;
+};
+
+class Supplier : public POA_RtecEventComm::PushSupplier
+{
+public:
+  void disconnect_push_supplier ()
+  {
+  }
+};
+
+int consumer_count = 10000;
+int type_count = 0;
+int iterations = 100000;
+int dump_history = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("c:t:i:d"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'c':
+        consumer_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        type_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        dump_history = 1;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-c consumers "
+                           "-t event types (0 for one per consumer) "
+                           "-i iterations "
+                           "-d (dump history) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  TAO_EC_Default_Factory::init_svcs ();
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      if (type_count <= 0 || type_count > consumer_count)
+        type_count = consumer_count;
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      poa_manager->activate ();
+
+      TAO_EC_Event_Channel_Attributes attributes (root_poa.in (),
+                                                  root_poa.in ());
+
+      TAO_EC_Event_Channel ec_impl (attributes);
+      ec_impl.activate ();
+
+      RtecEventChannelAdmin::EventChannel_var event_channel =
+        ec_impl._this ();
+
+      const RtecEventComm::EventSourceID source = 1;
+
+      // Each consumer subscribes to a single type, so each event is
+      // only wanted by consumer_count / type_count consumers.
+      Consumer *consumers = 0;
+      ACE_NEW_RETURN (consumers,
+                      Consumer[consumer_count],
+                      1);
+
+      RtecEventChannelAdmin::ConsumerAdmin_var consumer_admin =
+        event_channel->for_consumers ();
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "Connecting %d consumers to %d event types\n",
+                  consumer_count, type_count));
+
+      for (int i = 0; i != consumer_count; ++i)
+        {
+          ACE_ConsumerQOS_Factory qos;
+          qos.start_disjunction_group (1);
+          qos.insert (source,
+                      ACE_ES_EVENT_UNDEFINED + i % type_count,
+                      0);
+
+          RtecEventChannelAdmin::ProxyPushSupplier_var proxy =
+            consumer_admin->obtain_push_supplier ();
+
+          RtecEventComm::PushConsumer_var consumer =
+            consumers[i]._this ();
+
+          proxy->connect_push_consumer (consumer.in (),
+                                        qos.get_ConsumerQOS ());
+        }
+
+      Supplier supplier_impl;
+
+      RtecEventChannelAdmin::SupplierAdmin_var supplier_admin =
+        event_channel->for_suppliers ();
+
+      RtecEventChannelAdmin::ProxyPushConsumer_var consumer_proxy =
+        supplier_admin->obtain_push_consumer ();
+
+      RtecEventComm::PushSupplier_var supplier =
+        supplier_impl._this ();
+
+      ACE_SupplierQOS_Factory publications;
+      publications.insert (source, ACE_ES_EVENT_ANY, 0, 1);
+
+      consumer_proxy->connect_push_supplier (supplier.in (),
+                                             publications);
+
+      ACE_DEBUG ((LM_DEBUG, "Calibrating high res timer ...."));
+      ACE_High_Res_Timer::calibrate ();
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG, "Done (%d)\n", gsf));
+
+      RtecEventComm::EventSet event (1);
+      event.length (1);
+      event[0].header.source = source;
+      event[0].header.ttl = 1;
+
+      ACE_Sample_History history (iterations);
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      for (int i = 0; i != iterations; ++i)
+        {
+          event[0].header.type = ACE_ES_EVENT_UNDEFINED + i % type_count;
+
+          ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+          consumer_proxy->push (event);
+
+          ACE_hrtime_t now = ACE_OS::gethrtime ();
+          history.sample (now - start);
+        }
+
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      // The events are dispatched in the pushing thread with the
+      // default configuration, so they were all delivered already.
+      CORBA::ULong received = 0;
+      CORBA::ULong expected = 0;
+      for (int i = 0; i != consumer_count; ++i)
+        {
+          received += consumers[i].event_count_;
+
+          int const type = i % type_count;
+          expected += iterations / type_count
+            + (type < iterations % type_count ? 1 : 0);
+        }
+
+      if (dump_history)
+        {
+          history.dump_samples (ACE_TEXT("HISTORY"), gsf);
+        }
+
+      ACE_Basic_Stats stats;
+      history.collect_basic_stats (stats);
+      stats.dump_results (ACE_TEXT("Push"), gsf);
+
+      ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"),
+                                             gsf,
+                                             test_end - test_start,
+                                             stats.samples_count ());
+
+      event_channel->destroy ();
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+
+      delete [] consumers;
+
+      if (received != expected)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "ERROR: received %u events, expected %u\n",
+                           received, expected),
+                          1);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
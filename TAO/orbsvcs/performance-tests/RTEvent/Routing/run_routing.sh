@@ -0,0 +1,15 @@
+#! /bin/sh
+#
+
+. parameters
+
+for c in $NCONSUMERS; do
+  for n in $NTYPES; do
+    for t in $FILTER_TYPES; do
+      date
+      echo $t $c $n
+
+      ./routing -ORBSvcConf ec.supplier_filter_${t}.conf -i $ITERATIONS -c $c -t $n > ec_routing.${t}.${c}.${n}.txt 2>&1
+    done
+  done
+done
@@ -0,0 +1,371 @@
+#include "Epoch_Copy_On_Write.h"
+
+#include "orbsvcs/ESF/ESF_Epoch_Copy_On_Write.h"
+#include "orbsvcs/ESF/ESF_Proxy_List.h"
+#include "orbsvcs/ESF/ESF_Proxy_RB_Tree.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Synch_Traits.h"
+#include "ace/OS_NS_unistd.h"
+
+typedef TAO_ESF_Proxy_List<EPC_Proxy> EPC_List;
+typedef TAO_ESF_Proxy_RB_Tree<EPC_Proxy> EPC_RB_Tree;
+
+typedef TAO_ESF_Epoch_Copy_On_Write<EPC_Proxy,
+                                    EPC_List,
+                                    EPC_List::Iterator,
+                                    ACE_SYNCH> EPC_Epoch_List;
+typedef TAO_ESF_Epoch_Copy_On_Write<EPC_Proxy,
+                                    EPC_RB_Tree,
+                                    EPC_RB_Tree::Iterator,
+                                    ACE_SYNCH> EPC_Epoch_RB_Tree;
+
+static int readers = 4;
+static int writers = 2;
+static int seconds = 3;
+
+/// The proxies connected for the whole run
+static int const fixed_proxies = 4;
+
+/// The proxies each writer connects and disconnects
+static int const writer_proxies = 4;
+
+static int parse_args (int argc, ACE_TCHAR *argv[]);
+static int run_test (const ACE_TCHAR *name, EPC_Collection *collection);
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  int status = 0;
+
+  EPC_Collection *collection = 0;
+  ACE_NEW_RETURN (collection, EPC_Epoch_List, 1);
+  if (run_test (ACE_TEXT ("list"), collection) != 0)
+    status = 1;
+
+  ACE_NEW_RETURN (collection, EPC_Epoch_RB_Tree, 1);
+  if (run_test (ACE_TEXT ("rb_tree"), collection) != 0)
+    status = 1;
+
+  return status;
+}
+
+// ****************************************************************
+
+int
+run_test (const ACE_TCHAR *name, EPC_Collection *collection)
+{
+  EPC_Driver driver (collection);
+
+  int const nproxies = fixed_proxies + writers * writer_proxies + readers;
+  EPC_Proxy *proxies = 0;
+  ACE_NEW_RETURN (proxies, EPC_Proxy[nproxies], -1);
+
+  for (int i = 0; i != fixed_proxies; ++i)
+    collection->connected (proxies + i);
+
+  EPC_Writer **writer_tasks = 0;
+  ACE_NEW_RETURN (writer_tasks, EPC_Writer*[writers], -1);
+  for (int i = 0; i != writers; ++i)
+    {
+      ACE_NEW_RETURN (writer_tasks[i],
+                      EPC_Writer (&driver,
+                                  proxies + fixed_proxies
+                                  + i * writer_proxies,
+                                  writer_proxies),
+                      -1);
+    }
+
+  EPC_Reader **reader_tasks = 0;
+  ACE_NEW_RETURN (reader_tasks, EPC_Reader*[readers], -1);
+  for (int i = 0; i != readers; ++i)
+    {
+      ACE_NEW_RETURN (reader_tasks[i],
+                      EPC_Reader (&driver,
+                                  proxies + fixed_proxies
+                                  + writers * writer_proxies + i),
+                      -1);
+    }
+
+  for (int i = 0; i != readers; ++i)
+    {
+      if (reader_tasks[i]->activate (THR_NEW_LWP | THR_JOINABLE, 1) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) Cannot activate the readers\n"),
+                          -1);
+    }
+  for (int i = 0; i != writers; ++i)
+    {
+      if (writer_tasks[i]->activate (THR_NEW_LWP | THR_JOINABLE, 1) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) Cannot activate the writers\n"),
+                          -1);
+    }
+
+  ACE_OS::sleep (seconds);
+  driver.done = true;
+
+  for (int i = 0; i != readers; ++i)
+    reader_tasks[i]->wait ();
+  for (int i = 0; i != writers; ++i)
+    writer_tasks[i]->wait ();
+
+  // Only the fixed proxies are still connected, the collection holds
+  // one reference to each.
+  for (int i = 0; i != nproxies; ++i)
+    {
+      long const expected = (i < fixed_proxies ? 2 : 1);
+      if (proxies[i].refcount () < expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) %s: proxy %d has %d references, "
+                      "expected at least %d\n",
+                      name, i,
+                      static_cast<int> (proxies[i].refcount ()),
+                      static_cast<int> (expected)));
+          ++driver.errors;
+        }
+    }
+
+  collection->shutdown ();
+  delete collection;
+
+  // The collection and all its copies are gone, so is every reference
+  // they held.
+  long hits = 0;
+  for (int i = 0; i != nproxies; ++i)
+    {
+      hits += proxies[i].hits ();
+      if (proxies[i].refcount () != 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) %s: proxy %d has %d references "
+                      "after the collection is destroyed\n",
+                      name, i,
+                      static_cast<int> (proxies[i].refcount ())));
+          ++driver.errors;
+        }
+    }
+
+  for (int i = 0; i != readers; ++i)
+    delete reader_tasks[i];
+  delete[] reader_tasks;
+  for (int i = 0; i != writers; ++i)
+    delete writer_tasks[i];
+  delete[] writer_tasks;
+  delete[] proxies;
+
+  if (hits == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) %s: the readers did not see any proxy\n",
+                  name));
+      ++driver.errors;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              "(%P|%t) %s: %d readers, %d writers, %Q proxies seen, "
+              "%d errors\n",
+              name, readers, writers,
+              static_cast<ACE_UINT64> (hits),
+              static_cast<int> (driver.errors.load ())));
+
+  return driver.errors != 0 ? -1 : 0;
+}
+
+// ****************************************************************
+
+EPC_Proxy::EPC_Proxy ()
+  :  refcount_ (1),
+     hits_ (0)
+{
+}
+
+CORBA::ULong
+EPC_Proxy::_incr_refcnt ()
+{
+  return static_cast<CORBA::ULong> (++this->refcount_);
+}
+
+CORBA::ULong
+EPC_Proxy::_decr_refcnt ()
+{
+  long const r = --this->refcount_;
+  if (r < 0)
+    ACE_ERROR ((LM_ERROR,
+                "(%P|%t) Proxy %@ released once too often\n",
+                this));
+  return static_cast<CORBA::ULong> (r);
+}
+
+long
+EPC_Proxy::refcount () const
+{
+  return this->refcount_.load ();
+}
+
+long
+EPC_Proxy::hits () const
+{
+  return this->hits_.load ();
+}
+
+void
+EPC_Proxy::hit ()
+{
+  ++this->hits_;
+}
+
+// ****************************************************************
+
+EPC_Driver::EPC_Driver (EPC_Collection *c)
+  :  collection (c),
+     done (false),
+     errors (0)
+{
+}
+
+// ****************************************************************
+
+EPC_Worker::EPC_Worker (EPC_Driver *driver, EPC_Proxy *own, int nest)
+  :  driver_ (driver),
+     own_ (own),
+     nest_ (nest)
+{
+}
+
+void
+EPC_Worker::work (EPC_Proxy *proxy)
+{
+  // The copy being iterated holds a reference, on top of the one of
+  // the test, until no thread can be iterating over it.
+  if (proxy->refcount () < 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) Proxy %@ seen with %d references\n",
+                  proxy, static_cast<int> (proxy->refcount ())));
+      ++this->driver_->errors;
+    }
+  proxy->hit ();
+
+  if (this->nest_ == 0)
+    return;
+
+  // Nest once per iteration, on its first proxy.
+  int const nest = this->nest_;
+  this->nest_ = 0;
+
+  if (nest == 2)
+    this->driver_->collection->connected (this->own_);
+
+  EPC_Worker worker (this->driver_, this->own_, 0);
+  this->driver_->collection->for_each (&worker);
+
+  if (nest == 2)
+    this->driver_->collection->disconnected (this->own_);
+
+  // The outer iteration goes on over the copy it started with.
+  if (proxy->refcount () < 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) Proxy %@ released during the iteration\n",
+                  proxy));
+      ++this->driver_->errors;
+    }
+}
+
+// ****************************************************************
+
+EPC_Reader::EPC_Reader (EPC_Driver *driver, EPC_Proxy *own)
+  :  driver_ (driver),
+     own_ (own)
+{
+}
+
+int
+EPC_Reader::svc ()
+{
+  for (unsigned long i = 1; !this->driver_->done; ++i)
+    {
+      int nest = 0;
+      if (i % 64 == 0)
+        nest = 2;
+      else if (i % 16 == 0)
+        nest = 1;
+
+      EPC_Worker worker (this->driver_, this->own_, nest);
+      this->driver_->collection->for_each (&worker);
+    }
+  return 0;
+}
+
+// ****************************************************************
+
+EPC_Writer::EPC_Writer (EPC_Driver *driver,
+                        EPC_Proxy *proxies,
+                        int count)
+  :  driver_ (driver),
+     proxies_ (proxies),
+     count_ (count)
+{
+}
+
+int
+EPC_Writer::svc ()
+{
+  for (int i = 0; !this->driver_->done; ++i)
+    {
+      EPC_Proxy *proxy = this->proxies_ + (i % this->count_);
+
+      this->driver_->collection->connected (proxy);
+      if (i % 2 == 0)
+        this->driver_->collection->reconnected (proxy);
+      this->driver_->collection->disconnected (proxy);
+    }
+  return 0;
+}
+
+// ****************************************************************
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("r:w:s:"));
+  int opt;
+
+  while ((opt = get_opt ()) != EOF)
+    {
+      switch (opt)
+        {
+        case 'r':
+          readers = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+        case 'w':
+          writers = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+        case 's':
+          seconds = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+        case '?':
+        default:
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "usage: %s "
+                             "-r <readers> "
+                             "-w <writers> "
+                             "-s <seconds>"
+                             "\n",
+                             argv[0]),
+                            -1);
+        }
+    }
+
+  if (readers < 1 || writers < 1 || seconds < 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "(%P|%t) Needs at least a reader, a writer "
+                       "and a second\n"),
+                      -1);
+  return 0;
+}
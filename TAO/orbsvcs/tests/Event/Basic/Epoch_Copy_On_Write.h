@@ -0,0 +1,118 @@
+/* -*- C++ -*- */
+//=============================================================================
+/**
+ *  @file   Epoch_Copy_On_Write.h
+ *
+ *  Stress test for TAO_ESF_Epoch_Copy_On_Write: some threads iterate
+ *  over the collection, with nested iterations that also change it,
+ *  while other threads connect and disconnect proxies.
+ */
+//=============================================================================
+
+
+#ifndef EC_EPOCH_COPY_ON_WRITE_H
+#define EC_EPOCH_COPY_ON_WRITE_H
+
+#include "orbsvcs/ESF/ESF_Proxy_Collection.h"
+#include "orbsvcs/ESF/ESF_Worker.h"
+#include "tao/Basic_Types.h"
+#include "ace/Task.h"
+
+#include <atomic>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+/**
+ * A reference counted proxy, the test owns one reference and each
+ * copy of the collection holding the proxy owns another one.
+ */
+class EPC_Proxy
+{
+public:
+  /// Constructor
+  EPC_Proxy ();
+
+  CORBA::ULong _incr_refcnt ();
+  CORBA::ULong _decr_refcnt ();
+
+  /// The current reference count
+  long refcount () const;
+
+  /// The number of times a worker saw this proxy
+  long hits () const;
+
+  /// Called by the workers
+  void hit ();
+
+private:
+  std::atomic<long> refcount_;
+  std::atomic<long> hits_;
+};
+
+typedef TAO_ESF_Proxy_Collection<EPC_Proxy> EPC_Collection;
+
+/// The state shared by all the threads of one run
+struct EPC_Driver
+{
+  EPC_Driver (EPC_Collection *collection);
+
+  EPC_Collection *collection;
+
+  /// Set when the threads must stop
+  std::atomic<bool> done;
+
+  /// The number of times a worker saw a proxy the collection did not
+  /// hold a reference to, or a reference count went negative
+  std::atomic<long> errors;
+};
+
+/// Check the reference count of each proxy, and sometimes iterate
+/// again, and change the collection, from inside the iteration.
+class EPC_Worker : public TAO_ESF_Worker<EPC_Proxy>
+{
+public:
+  EPC_Worker (EPC_Driver *driver, EPC_Proxy *own, int nest);
+
+  void work (EPC_Proxy *proxy);
+
+private:
+  EPC_Driver *driver_;
+
+  /// The proxy connected and disconnected by a nested iteration
+  EPC_Proxy *own_;
+
+  /// 0: plain iteration, 1: iterate again from the first proxy, 2:
+  /// also connect and disconnect <own_> from the nested iteration
+  int nest_;
+};
+
+/// Iterate over the collection until the driver is done
+class EPC_Reader : public ACE_Task_Base
+{
+public:
+  EPC_Reader (EPC_Driver *driver, EPC_Proxy *own);
+
+  int svc ();
+
+private:
+  EPC_Driver *driver_;
+  EPC_Proxy *own_;
+};
+
+/// Connect, reconnect and disconnect proxies until the driver is done
+class EPC_Writer : public ACE_Task_Base
+{
+public:
+  EPC_Writer (EPC_Driver *driver, EPC_Proxy *proxies, int count);
+
+  int svc ();
+
+private:
+  EPC_Driver *driver_;
+  EPC_Proxy *proxies_;
+  int count_;
+};
+
+#endif /* EC_EPOCH_COPY_ON_WRITE_H */
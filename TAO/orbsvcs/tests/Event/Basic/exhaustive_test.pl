@@ -18,11 +18,13 @@ $conf_file = PerlACE::LocalFile ("exhaustive$PerlACE::svcconf_ext");
                           "-ECDispatching mt -ECDispatchingThreads 4");
 @collection_strategies = ("copy_on_read",
                           "copy_on_write",
-                          "delayed");
+                          "delayed",
+                          "epoch");
 @collection_types      = ("list",
                           "rb_tree");
 @filtering_configs     = ("-ECFiltering prefix -ECSupplierFilter per-supplier",
-                          "-ECFiltering prefix -ECSupplierFilter null");
+                          "-ECFiltering prefix -ECSupplierFilter null",
+                          "-ECFiltering prefix -ECSupplierFilter indexed");
 
 foreach $d (@dispatching_configs) {
     foreach $f (@filtering_configs) {
@@ -98,6 +98,10 @@ RunTest ("Control test",
          "Control",
          "-ORBSvcConf $control_conf");
 
+RunTest ("Epoch copy on write collection, iterations racing changes",
+         "Epoch_Copy_On_Write",
+         "-r 4 -w 2 -s 3");
+
 RunTest ("Random test",
          "Random",
          "-ORBSvcConf $svc_conf -suppliers 4 -consumers 4 -max_recursion 1");
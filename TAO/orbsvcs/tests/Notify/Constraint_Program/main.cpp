@@ -0,0 +1,475 @@
+#include "TestC.h"
+
+#include "orbsvcs/Notify/Notify_Constraint_Interpreter.h"
+#include "orbsvcs/Notify/Notify_Constraint_Visitors.h"
+#include "orbsvcs/Notify/Notify_Constraint_Program.h"
+
+#include "tao/CDR.h"
+#include "tao/AnyTypeCode/Any.h"
+#include "tao/AnyTypeCode/Any_Impl.h"
+
+#include "ace/Vector_T.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Log_Msg.h"
+
+/// A constraint, and whether it compiles into a program.
+struct Constraint
+{
+  const char *expr_;
+  bool compiled_;
+};
+
+const Constraint constraints[] =
+{
+  // The fixed header and the literals.
+  { "TRUE", true },
+  { "FALSE or TRUE", true },
+  { "$type_name == 'Quote'", true },
+  { "$domain_name == 'Market' and 'IB' ~ $event_name", true },
+  { "$.header.fixed_header.event_name == 'IBM'", true },
+  { "$.header.fixed_header.event_type.type_name != 'Quote'", true },
+  { "$.remainder_of_body == 7", true },
+  { "$.remainder_of_body + 1 > 7", true },
+
+  // The filterable_data properties.
+  { "$l == 42", true },
+  { "$.l == 42", true },
+  { "$.filterable_data.l > 40", true },
+  { "$.variable_header.v == 3", true },
+  { "l == 42", true },
+  { "$l + 1 == 43", true },
+  { "$l * 2 >= $ul", true },
+  { "$l / 4 == 10", true },
+  { "$l / 4 == 10.5", true },
+  { "$ul - 100 < 0", true },
+  { "$s < 0", true },
+  { "$s == -7", true },
+  { "$d > 3.1", true },
+  { "$d * 2 == 6.5", true },
+  { "$d == $l", true },
+  { "$str == 'hello'", true },
+  { "'ell' ~ $str", true },
+  { "$str < 'world'", true },
+  { "$b", true },
+  { "$b == TRUE", true },
+  { "not $b", true },
+  { "$missing == 1", true },
+  { "$missing == 1 or $l == 42", true },
+  { "not ($missing == 1)", true },
+  { "$l == 42 and ($str == 'world' or $d < 1.0)", true },
+
+  // The enums.
+  { "$c == 1", true },
+  { "$c > 0 and $c < 2", true },
+  { "$c == $ul - 83", true },
+
+  // The type mismatches.
+  { "$l == 'abc'", true },
+  { "$str > 5", true },
+  { "$b + 1 == 2", true },
+  { "$c == 'GREEN'", true },
+  { "$p == 1", true },
+  { "$seq == 1", true },
+  { "$u != 1", true },
+  { "$str + 1 == 2", true },
+  { "'x' ~ $l", true },
+
+  // The constraints left to the interpreter.
+  { "exist $l", false },
+  { "exist $missing", false },
+  { "exist $l and $l == 42", false },
+  { "default $u", false },
+  { "$p.x == 1", false },
+  { "$p.y == 2", false },
+  { "$seq[1] == 20", false },
+  { "$seq._length == 3", false },
+  { "20 in $seq", false },
+  { "$u._d == 1", false },
+  { "$u.(1) == 5", false },
+  { "$u.(2) == 'circle'", false },
+  { "$u.() == 2.5", false },
+  { "$.filterable_data(l) == 42", false }
+};
+
+const size_t constraint_count = sizeof constraints / sizeof constraints[0];
+
+/// The events of make_events.
+const size_t event_count = 5;
+
+/// The threads matching the same event.
+const int thread_count = 8;
+
+void
+add_property (CosNotification::PropertySeq &properties,
+              const char *name,
+              const CORBA::Any &value)
+{
+  CORBA::ULong const length = properties.length ();
+  properties.length (length + 1);
+  properties[length].name = name;
+  properties[length].value = value;
+}
+
+/// Events with all the kinds of values, with their Anys holding the
+/// values themselves.
+void
+make_events (CosNotification::StructuredEvent events[event_count])
+{
+  CORBA::Any any;
+
+  CosNotification::StructuredEvent &quote = events[0];
+  quote.header.fixed_header.event_type.domain_name = "Market";
+  quote.header.fixed_header.event_type.type_name = "Quote";
+  quote.header.fixed_header.event_name = "IBM";
+  any <<= static_cast<CORBA::Long> (3);
+  add_property (quote.header.variable_header, "v", any);
+  any <<= static_cast<CORBA::Long> (42);
+  add_property (quote.filterable_data, "l", any);
+  any <<= static_cast<CORBA::ULong> (84);
+  add_property (quote.filterable_data, "ul", any);
+  any <<= static_cast<CORBA::Short> (-7);
+  add_property (quote.filterable_data, "s", any);
+  any <<= static_cast<CORBA::Double> (3.25);
+  add_property (quote.filterable_data, "d", any);
+  any <<= "hello";
+  add_property (quote.filterable_data, "str", any);
+  any <<= CORBA::Any::from_boolean (true);
+  add_property (quote.filterable_data, "b", any);
+  any <<= Test::GREEN;
+  add_property (quote.filterable_data, "c", any);
+  Test::Point point;
+  point.x = 1;
+  point.y = 2;
+  any <<= point;
+  add_property (quote.filterable_data, "p", any);
+  Test::LongSeq seq (3);
+  seq.length (3);
+  seq[0] = 10;
+  seq[1] = 20;
+  seq[2] = 30;
+  any <<= seq;
+  add_property (quote.filterable_data, "seq", any);
+  Test::Shape shape;
+  shape.radius (5);
+  any <<= shape;
+  add_property (quote.filterable_data, "u", any);
+  quote.remainder_of_body <<= static_cast<CORBA::Long> (7);
+
+  CosNotification::StructuredEvent &trade = events[1];
+  trade.header.fixed_header.event_type.domain_name = "Market";
+  trade.header.fixed_header.event_type.type_name = "Trade";
+  trade.header.fixed_header.event_name = "HP";
+  any <<= static_cast<CORBA::Long> (4);
+  add_property (trade.header.variable_header, "v", any);
+  any <<= static_cast<CORBA::Long> (5);
+  add_property (trade.filterable_data, "l", any);
+  any <<= static_cast<CORBA::ULong> (1);
+  add_property (trade.filterable_data, "ul", any);
+  any <<= static_cast<CORBA::Short> (3);
+  add_property (trade.filterable_data, "s", any);
+  any <<= static_cast<CORBA::Double> (0.5);
+  add_property (trade.filterable_data, "d", any);
+  any <<= "world";
+  add_property (trade.filterable_data, "str", any);
+  any <<= CORBA::Any::from_boolean (false);
+  add_property (trade.filterable_data, "b", any);
+  any <<= Test::BLUE;
+  add_property (trade.filterable_data, "c", any);
+  seq.length (0);
+  any <<= seq;
+  add_property (trade.filterable_data, "seq", any);
+  shape.label ("circle");
+  any <<= shape;
+  add_property (trade.filterable_data, "u", any);
+  point.x = 7;
+  point.y = 7;
+  trade.remainder_of_body <<= point;
+
+  // events[2] is left empty.
+
+  // The interpreter does not match events that give a property twice,
+  // in their filterable data or in their variable header.
+  CosNotification::StructuredEvent &twice = events[3];
+  twice = quote;
+  any <<= static_cast<CORBA::Long> (5);
+  add_property (twice.filterable_data, "l", any);
+
+  CosNotification::StructuredEvent &header_twice = events[4];
+  header_twice = quote;
+  any <<= static_cast<CORBA::Long> (4);
+  add_property (header_twice.header.variable_header, "v", any);
+}
+
+/// Copy @a event through CDR, so its Anys hold the encoded values
+/// like the Anys of an event received from a supplier.
+bool
+encode (const CosNotification::StructuredEvent &event,
+        CosNotification::StructuredEvent &encoded)
+{
+  TAO_OutputCDR out;
+  if (!(out << event))
+    return false;
+
+  TAO_InputCDR in (out);
+  return (in >> encoded);
+}
+
+/// Evaluate the constraint with the interpreter, and with its program
+/// if it compiles, and compare the results.
+int
+check (const Constraint &constraint,
+       const CosNotification::StructuredEvent &event,
+       const char *event_kind,
+       size_t event_index)
+{
+  CosNotifyFilter::ConstraintExp exp;
+  exp.constraint_expr = constraint.expr_;
+
+  TAO_Notify_Constraint_Interpreter interpreter;
+
+  try
+    {
+      interpreter.build_tree (exp);
+    }
+  catch (const CosNotifyFilter::InvalidConstraint &)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR: <%C> does not parse\n",
+                         constraint.expr_),
+                        1);
+    }
+
+  // Like TAO_Notify_ETCL_Filter, an event the interpreter cannot bind
+  // does not match.
+  TAO_Notify_Constraint_Visitor visitor;
+  CORBA::Boolean const interpreted =
+    visitor.bind_structured_event (event) == 0
+    && interpreter.evaluate (visitor);
+
+  TAO_Notify_Constraint_Program program;
+  TAO_Notify_Constraint_Program::Slot_Map slots;
+  bool const compiled = interpreter.compile (program, slots);
+
+  if (compiled != constraint.compiled_)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: <%C> %C compiled\n",
+                       constraint.expr_,
+                       compiled ? "was" : "was not"),
+                      1);
+
+  if (!compiled)
+    return 0;
+
+  ACE_Vector<const CORBA::Any *> slot_values;
+  slot_values.resize (slots.current_size () + 1, 0);
+
+  TAO_Notify_Constraint_Program::Event_Fields fields;
+  int result = 0;
+
+  if (TAO_Notify_Constraint_Program::bind_event (event,
+                                                 slots,
+                                                 &slot_values[0],
+                                                 fields))
+    result = program.evaluate (fields);
+
+  if (result != (interpreted ? 1 : 0))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: <%C> on %C event %d: "
+                       "interpreted %d, program %d\n",
+                       constraint.expr_,
+                       event_kind,
+                       static_cast<int> (event_index),
+                       interpreted,
+                       result),
+                      1);
+
+  return 0;
+}
+
+/// A compiled constraint, bound to the event it is matched against.
+struct Compiled_Constraint
+{
+  TAO_Notify_Constraint_Interpreter interpreter_;
+  TAO_Notify_Constraint_Program program_;
+  TAO_Notify_Constraint_Program::Slot_Map slots_;
+  ACE_Vector<const CORBA::Any *> slot_values_;
+  TAO_Notify_Constraint_Program::Event_Fields fields_;
+
+  /// The result of the interpreter.
+  int expected_;
+};
+
+/**
+ * Evaluate the programs on one event from several threads, like the
+ * filters of several proxies matching the same event.
+ */
+class Matcher : public ACE_Task_Base
+{
+public:
+  Matcher (const Compiled_Constraint *compiled, size_t count)
+    : compiled_ (compiled),
+      count_ (count),
+      errors_ (0)
+  {
+  }
+
+  int svc () override
+  {
+    for (int i = 0; i != iterations_; ++i)
+      {
+        for (size_t c = 0; c != this->count_; ++c)
+          {
+            const Compiled_Constraint &compiled = this->compiled_[c];
+
+            if (compiled.program_.evaluate (compiled.fields_)
+                  != compiled.expected_)
+              ++this->errors_;
+          }
+      }
+
+    return 0;
+  }
+
+  unsigned long errors () const
+  {
+    return this->errors_.value ();
+  }
+
+private:
+  static const int iterations_ = 2000;
+
+  const Compiled_Constraint *compiled_;
+  size_t const count_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> errors_;
+};
+
+/// Match the compiled constraints on @a event from several threads,
+/// and check that its Anys were not extracted from, which would
+/// replace their implementations under the other threads.
+int
+check_threads (const CosNotification::StructuredEvent &event)
+{
+  Compiled_Constraint compiled[constraint_count];
+  size_t count = 0;
+
+  for (size_t c = 0; c != constraint_count; ++c)
+    {
+      if (!constraints[c].compiled_)
+        continue;
+
+      Compiled_Constraint &constraint = compiled[count++];
+
+      CosNotifyFilter::ConstraintExp exp;
+      exp.constraint_expr = constraints[c].expr_;
+      constraint.interpreter_.build_tree (exp);
+      constraint.interpreter_.compile (constraint.program_,
+                                       constraint.slots_);
+
+      TAO_Notify_Constraint_Visitor visitor;
+      if (visitor.bind_structured_event (event) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "ERROR: cannot bind the shared event\n"),
+                          1);
+
+      constraint.expected_ =
+        constraint.interpreter_.evaluate (visitor) ? 1 : 0;
+
+      constraint.slot_values_.resize (constraint.slots_.current_size () + 1,
+                                      0);
+      TAO_Notify_Constraint_Program::bind_event (
+        event,
+        constraint.slots_,
+        &constraint.slot_values_[0],
+        constraint.fields_);
+    }
+
+  ACE_Vector<const TAO::Any_Impl *> impls;
+  for (CORBA::ULong i = 0; i < event.filterable_data.length (); ++i)
+    impls.push_back (event.filterable_data[i].value.impl ());
+  impls.push_back (event.remainder_of_body.impl ());
+
+  Matcher matcher (compiled, count);
+
+  if (matcher.activate (THR_NEW_LWP | THR_JOINABLE, thread_count) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: cannot activate the matching threads\n"),
+                      1);
+
+  matcher.wait ();
+
+  int status = 0;
+
+  if (matcher.errors () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: %u programs disagreed with the interpreter "
+                  "on the shared event\n",
+                  static_cast<unsigned int> (matcher.errors ())));
+      status = 1;
+    }
+
+  for (CORBA::ULong i = 0; i != impls.size (); ++i)
+    {
+      const CORBA::Any &any = i < event.filterable_data.length ()
+        ? event.filterable_data[i].value
+        : event.remainder_of_body;
+
+      if (any.impl () != impls[i] || !any.impl ()->encoded ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: value %d of the shared event "
+                      "was extracted from\n",
+                      static_cast<int> (i)));
+          status = 1;
+        }
+    }
+
+  return status;
+}
+
+int
+ACE_TMAIN(int, ACE_TCHAR *[])
+{
+  int status = 0;
+
+  try
+    {
+      CosNotification::StructuredEvent events[event_count];
+      CosNotification::StructuredEvent encoded[event_count];
+
+      make_events (events);
+
+      for (size_t e = 0; e != event_count; ++e)
+        {
+          if (!encode (events[e], encoded[e]))
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "ERROR: cannot encode event %d\n",
+                               static_cast<int> (e)),
+                              1);
+        }
+
+      for (size_t c = 0; c != constraint_count; ++c)
+        {
+          for (size_t e = 0; e != event_count; ++e)
+            {
+              status |= check (constraints[c], events[e], "inserted", e);
+              status |= check (constraints[c], encoded[e], "encoded", e);
+            }
+        }
+
+      for (size_t e = 0; e != 2; ++e)
+        status |= check_threads (encoded[e]);
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("Constraint program test");
+      return 1;
+    }
+
+  if (status == 0)
+    ACE_DEBUG ((LM_DEBUG,
+                "(%P|%t) Constraint program test passed\n"));
+
+  return status;
+}
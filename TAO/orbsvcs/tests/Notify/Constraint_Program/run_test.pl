@@ -0,0 +1,23 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$T = $test->CreateProcess ("main");
+
+$test_status = $T->SpawnWaitKill ($test->ProcessStartWaitInterval() + 15);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: test returned $test_status\n";
+    $status = 1;
+}
+
+exit $status;
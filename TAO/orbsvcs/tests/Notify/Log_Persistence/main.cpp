@@ -0,0 +1,403 @@
+#include "orbsvcs/Notify/Log_Event_Persistence.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Dirent.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+/// Count the completed persistence requests, like a routing slip
+/// waits for them.
+class Callback : public TAO_Notify::Persistent_Callback
+{
+public:
+  Callback ()
+    : complete_ (lock_)
+    , count_ (0)
+  {
+  }
+
+  void persist_complete ()
+  {
+    ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+    ++this->count_;
+    this->complete_.signal ();
+  }
+
+  /// Wait until @a count requests completed.
+  void wait (unsigned long count)
+  {
+    ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+    while (this->count_ < count)
+      this->complete_.wait ();
+  }
+
+  unsigned long count ()
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, 0);
+    return this->count_;
+  }
+
+private:
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex complete_;
+  unsigned long count_;
+};
+
+const ACE_TCHAR *path = ACE_TEXT ("log_persistence.db");
+int event_count = 100;
+
+/// One segment holds all the events, so the torn event is the last
+/// record of the log.
+const size_t large_segment_size = 1024 * 1024;
+/// Small segments, so that compaction removes some of them.
+const size_t small_segment_size = 4096;
+const size_t event_size = 100;
+const size_t torn_size = 256;
+const char torn_fill = 'T';
+
+/// Fill @a mb with the contents of event @a i.
+void
+make_event (ACE_Message_Block &mb, int i)
+{
+  mb.reset ();
+  ACE_OS::memset (mb.wr_ptr (), 'e', event_size);
+  ACE_OS::snprintf (mb.wr_ptr (), event_size, "event-%d-", i);
+  mb.wr_ptr (event_size);
+}
+
+/// Fill @a mb with routing slip @a version of event @a i.
+void
+make_routing_slip (ACE_Message_Block &mb, int i, int version)
+{
+  mb.reset ();
+  int const length =
+    ACE_OS::snprintf (mb.wr_ptr (), mb.space (), "slip-%d-%d", i, version);
+  mb.wr_ptr (length);
+}
+
+bool
+same (const ACE_Message_Block &a, const ACE_Message_Block &b)
+{
+  return a.length () == b.length ()
+    && ACE_OS::memcmp (a.rd_ptr (), b.rd_ptr (), a.length ()) == 0;
+}
+
+/// The path of the segment file written last.
+ACE_TString
+last_segment ()
+{
+  ACE_TString last;
+  ACE_Dirent dir;
+  if (dir.open (path) == -1)
+    return last;
+  for (ACE_DIRENT *entry = dir.read (); entry != 0; entry = dir.read ())
+    {
+      // The names have a fixed width, so they sort like the indexes.
+      ACE_TString const name (entry->d_name);
+      if (name.find (ACE_TEXT ("segment.")) == 0
+          && (last.length () == 0 || last < name))
+        last = name;
+    }
+  if (last.length () == 0)
+    return last;
+  ACE_TString result (path);
+  result += ACE_DIRECTORY_SEPARATOR_STR;
+  result += last;
+  return result;
+}
+
+/// Cut the last segment in the middle of the torn event.
+bool
+tear_last_record ()
+{
+  ACE_TString const segment = last_segment ();
+  ACE_HANDLE const handle = ACE_OS::open (segment.c_str (), O_RDONLY);
+  if (handle == ACE_INVALID_HANDLE)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: cannot open the last segment of %s\n",
+                       path),
+                      false);
+
+  size_t const size = static_cast<size_t> (ACE_OS::filesize (handle));
+  ACE_Message_Block contents (size);
+  ssize_t const n = ACE_OS::read_n (handle, contents.wr_ptr (), size);
+  ACE_OS::close (handle);
+  if (n != static_cast<ssize_t> (size))
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot read %s\n", segment.c_str ()),
+                      false);
+
+  const char *data = contents.rd_ptr ();
+  for (size_t offset = 0; offset + torn_size <= size; ++offset)
+    {
+      if (data[offset] == torn_fill
+          && ACE_OS::memcmp (data + offset, data + offset + 1, torn_size - 1) == 0)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "(%P|%t) Tearing %s at %d\n",
+                      segment.c_str (),
+                      static_cast<int> (offset + torn_size / 2)));
+          return ACE_OS::truncate (
+                   segment.c_str (),
+                   static_cast<ACE_OFF_T> (offset + torn_size / 2)) == 0;
+        }
+    }
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     "ERROR: the torn event is not in %s\n",
+                     segment.c_str ()),
+                    false);
+}
+
+/// Store the events, update them and remove half of them.  If
+/// @a compact the log is then filled with garbage until the first
+/// segment is compacted, otherwise the event torn afterwards is stored.
+int
+write_log (size_t segment_size, bool compact)
+{
+  Callback callback;
+  unsigned long requests = 0;
+
+  TAO_Notify::Log_Event_Persistence_Factory *factory = 0;
+  ACE_NEW_RETURN (factory, TAO_Notify::Log_Event_Persistence_Factory, 1);
+  if (!factory->open (path, segment_size))
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot open %s\n", path), 1);
+  if (factory->first_reload_manager () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: %s is not empty\n", path), 1);
+
+  TAO_Notify::Routing_Slip_Persistence_Manager **managers = 0;
+  ACE_NEW_RETURN (managers,
+                  TAO_Notify::Routing_Slip_Persistence_Manager *[event_count],
+                  1);
+
+  ACE_Message_Block event (event_size);
+  ACE_Message_Block routing_slip (64);
+  for (int i = 0; i != event_count; ++i)
+    {
+      managers[i] = factory->create_routing_slip_persistence_manager (&callback);
+      make_event (event, i);
+      make_routing_slip (routing_slip, i, 0);
+      managers[i]->store (event, routing_slip);
+      ++requests;
+    }
+  for (int i = 0; i != event_count; ++i)
+    {
+      make_routing_slip (routing_slip, i, 1);
+      managers[i]->update (routing_slip);
+      ++requests;
+    }
+  for (int i = 1; i < event_count; i += 2)
+    {
+      managers[i]->remove ();
+      ++requests;
+    }
+  callback.wait (requests);
+
+  ACE_TString const event_segment = last_segment ();
+
+  // Fill the log with garbage, so the old segments are compacted.
+  for (int i = 0; compact && i != 20 * event_count; ++i)
+    {
+      TAO_Notify::Routing_Slip_Persistence_Manager *rspm =
+        factory->create_routing_slip_persistence_manager (&callback);
+      make_event (event, -1);
+      make_routing_slip (routing_slip, -1, 0);
+      rspm->store (event, routing_slip);
+      rspm->remove ();
+      requests += 2;
+      callback.wait (requests);
+      delete rspm;
+    }
+
+  TAO_Notify::Routing_Slip_Persistence_Manager *torn_rspm = 0;
+  if (!compact)
+    {
+      ACE_Message_Block torn (torn_size);
+      ACE_OS::memset (torn.wr_ptr (), torn_fill, torn_size);
+      torn.wr_ptr (torn_size);
+      torn_rspm = factory->create_routing_slip_persistence_manager (&callback);
+      torn_rspm->store (torn, routing_slip);
+      callback.wait (++requests);
+    }
+
+  delete factory;
+
+  // The live events were copied out of the segments they were stored
+  // in.
+  if (compact && ACE_OS::access (event_segment.c_str (), F_OK) == 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: %s was not compacted\n",
+                       event_segment.c_str ()),
+                      1);
+
+  // The log is closed, a request must fail but still be called back.
+  make_routing_slip (routing_slip, 0, 2);
+  if (managers[0]->update (routing_slip))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: update succeeded after the log was closed\n"),
+                      1);
+  if (callback.count () != requests + 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: update was not called back after the log "
+                       "was closed\n"),
+                      1);
+
+  delete torn_rspm;
+  for (int i = 0; i != event_count; ++i)
+    delete managers[i];
+  delete [] managers;
+  return 0;
+}
+
+/// Check that the events that were not removed are reloaded, then
+/// remove them.
+int
+reload_log (size_t segment_size)
+{
+  Callback callback;
+  unsigned long requests = 0;
+  int status = 0;
+
+  TAO_Notify::Log_Event_Persistence_Factory *factory = 0;
+  ACE_NEW_RETURN (factory, TAO_Notify::Log_Event_Persistence_Factory, 1);
+  if (!factory->open (path, segment_size))
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot reopen %s\n", path), 1);
+
+  bool *reloaded = 0;
+  ACE_NEW_RETURN (reloaded, bool[event_count], 1);
+  for (int i = 0; i != event_count; ++i)
+    reloaded[i] = false;
+
+  ACE_Message_Block expected_event (event_size);
+  ACE_Message_Block expected_routing_slip (64);
+  TAO_Notify::Routing_Slip_Persistence_Manager *rspm =
+    factory->first_reload_manager ();
+  while (rspm != 0)
+    {
+      rspm->set_callback (&callback);
+      ACE_Message_Block *event = 0;
+      ACE_Message_Block *routing_slip = 0;
+      if (!rspm->reload (event, routing_slip))
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: cannot reload an event\n"));
+          status = 1;
+        }
+      else
+        {
+          int const i = event->length () == event_size
+            ? ACE_OS::atoi (event->rd_ptr () + 6)
+            : -1;
+          if (i < 0 || i >= event_count || i % 2 != 0 || reloaded[i])
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "ERROR: unexpected event of %B bytes reloaded\n",
+                          event->length ()));
+              status = 1;
+            }
+          else
+            {
+              reloaded[i] = true;
+              make_event (expected_event, i);
+              make_routing_slip (expected_routing_slip, i, 1);
+              if (!same (*event, expected_event)
+                  || !same (*routing_slip, expected_routing_slip))
+                {
+                  ACE_ERROR ((LM_ERROR,
+                              "ERROR: event %d was not reloaded intact\n",
+                              i));
+                  status = 1;
+                }
+            }
+        }
+      delete event;
+      delete routing_slip;
+
+      TAO_Notify::Routing_Slip_Persistence_Manager *next = rspm->load_next ();
+      rspm->remove ();
+      callback.wait (++requests);
+      delete rspm;
+      rspm = next;
+    }
+
+  for (int i = 0; i < event_count; i += 2)
+    {
+      if (!reloaded[i])
+        {
+          ACE_ERROR ((LM_ERROR, "ERROR: event %d was lost\n", i));
+          status = 1;
+        }
+    }
+  delete [] reloaded;
+  delete factory;
+  return status;
+}
+
+/// Check that the log is empty.
+int
+check_empty (size_t segment_size)
+{
+  TAO_Notify::Log_Event_Persistence_Factory factory;
+  if (!factory.open (path, segment_size))
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot reopen %s\n", path), 1);
+  if (factory.first_reload_manager () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "ERROR: removed events were reloaded\n"),
+                      1);
+  return 0;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("f:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'f':
+        path = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        event_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-f directory "
+                           "-n events "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  // A torn record ends the log.
+  if (write_log (large_segment_size, false) != 0
+      || !tear_last_record ()
+      || reload_log (large_segment_size) != 0
+      || check_empty (large_segment_size) != 0)
+    return 1;
+
+  // The live events survive compaction.
+  if (write_log (small_segment_size, true) != 0
+      || reload_log (small_segment_size) != 0
+      || check_empty (small_segment_size) != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG, "(%P|%t) Log persistence test passed\n"));
+  return 0;
+}
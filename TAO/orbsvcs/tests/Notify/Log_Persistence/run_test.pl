@@ -0,0 +1,35 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+use File::Path;
+
+$status = 0;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+my $db = "log_persistence.db";
+my $test_db = $test->LocalFile ($db);
+
+sub cleanup() {
+    rmtree ($test_db);
+}
+
+cleanup();
+
+$T = $test->CreateProcess ("main", "-f $test_db");
+
+$test_status = $T->SpawnWaitKill ($test->ProcessStartWaitInterval() + 45);
+
+if ($test_status != 0) {
+    print STDERR "ERROR: test returned $test_status\n";
+    $status = 1;
+}
+
+cleanup();
+
+exit $status;
@@ -45,7 +45,6 @@ my $sts_iorfile = $sts->LocalFile ($iorbase);
 my $stc_iorfile = $stc->LocalFile ($iorbase);
 my $sec_iorfile = $sec->LocalFile ($iorbase);
 my $ses_iorfile = $ses->LocalFile ($iorbase);
-my $nfs_nfsconffile = $nfs->LocalFile ($nfsconffile);
 $ns->DeleteFile ($nsiorfile);
 $nfs->DeleteFile ($nfsiorfile);
 $sts->DeleteFile ($iorbase);
@@ -57,13 +56,19 @@ foreach my $arg (@ARGV) {
     if ($arg eq "-d") {
         $deadline = 1;
     }
+    elsif ($arg eq "-c") {
+        $nfsconffile = "notify_concurrency$PerlACE::svcconf_ext";
+    }
     else {
-        print "Usage: $0 [-d]\n" .
-              "       -d specifies that deadline discarding be tested.\n";
+        print "Usage: $0 [-d] [-c]\n" .
+              "       -d specifies that deadline discarding be tested.\n" .
+              "       -c limits the pushes in progress for each consumer.\n";
         exit(0);
     }
 }
 
+my $nfs_nfsconffile = $nfs->LocalFile ($nfsconffile);
+
 $NS = $ns->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/Naming_Service/tao_cosnaming",
                           "-ORBEndpoint iiop://$host:$port -o $ns_nsiorfile");
 
@@ -0,0 +1,179 @@
+#include "orbsvcs/Notify/Standard_Event_Persistence.h"
+#include "orbsvcs/Notify/Log_Event_Persistence.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+/// Wait for the completion of each persistence request, like a
+/// routing slip does.
+class Callback : public TAO_Notify::Persistent_Callback
+{
+public:
+  Callback ()
+    : complete_ (lock_)
+    , count_ (0)
+  {
+  }
+
+  void persist_complete ()
+  {
+    ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+    ++this->count_;
+    this->complete_.signal ();
+  }
+
+  /// Wait until @a count requests completed.
+  void wait (unsigned long count)
+  {
+    ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+    while (this->count_ < count)
+      this->complete_.wait ();
+  }
+
+private:
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex complete_;
+  unsigned long count_;
+};
+
+const ACE_TCHAR *strategy = ACE_TEXT ("log");
+const ACE_TCHAR *path = ACE_TEXT ("event_persistence.db");
+int thread_count = 8;
+int iterations = 1000;
+int payload = 256;
+
+TAO_Notify::Event_Persistence_Factory *factory = 0;
+
+ACE_THR_FUNC_RETURN
+worker (void *)
+{
+  Callback callback;
+  unsigned long requests = 0;
+
+  ACE_Message_Block event (payload);
+  ACE_OS::memset (event.wr_ptr (), 'e', payload);
+  event.wr_ptr (payload);
+
+  ACE_Message_Block routing_slip (32);
+  ACE_OS::memset (routing_slip.wr_ptr (), 'r', 32);
+  routing_slip.wr_ptr (32);
+
+  // Each event is stored, its routing slip updated once it is delivered
+  // and then it is removed, waiting for each step to reach the disk.
+  for (int i = 0; i != iterations; ++i)
+    {
+      TAO_Notify::Routing_Slip_Persistence_Manager *rspm =
+        factory->create_routing_slip_persistence_manager (&callback);
+
+      rspm->store (event, routing_slip);
+      callback.wait (++requests);
+      rspm->update (routing_slip);
+      callback.wait (++requests);
+      rspm->remove ();
+      callback.wait (++requests);
+
+      delete rspm;
+    }
+  return 0;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("s:f:t:i:p:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 's':
+        strategy = get_opts.opt_arg ();
+        break;
+
+      case 'f':
+        path = get_opts.opt_arg ();
+        break;
+
+      case 't':
+        thread_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'p':
+        payload = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-s standard|log "
+                           "-f file or directory "
+                           "-t threads "
+                           "-i events per thread "
+                           "-p event size "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  if (ACE_OS::strcmp (strategy, ACE_TEXT ("standard")) == 0)
+    {
+      TAO_Notify::Standard_Event_Persistence_Factory *standard = 0;
+      ACE_NEW_RETURN (standard,
+                      TAO_Notify::Standard_Event_Persistence_Factory,
+                      1);
+      factory = standard;
+      if (!standard->open (path))
+        ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot open %s\n", path), 1);
+    }
+  else
+    {
+      TAO_Notify::Log_Event_Persistence_Factory *log = 0;
+      ACE_NEW_RETURN (log,
+                      TAO_Notify::Log_Event_Persistence_Factory,
+                      1);
+      factory = log;
+      if (!log->open (path, 4 * 1024 * 1024))
+        ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot open %s\n", path), 1);
+    }
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  ACE_Thread_Manager::instance ()->spawn_n (thread_count, worker);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  timer.stop ();
+
+  ACE_Time_Value elapsed;
+  timer.elapsed_time (elapsed);
+  double const seconds = elapsed.sec () + elapsed.usec () / 1.0e6;
+  double const events = static_cast<double> (thread_count) * iterations;
+
+  ACE_DEBUG ((LM_DEBUG,
+              "%s: %d threads, %d events of %d bytes per thread: "
+              "%.0f events/sec\n",
+              strategy, thread_count, iterations, payload,
+              events / seconds));
+
+  delete factory;
+  return 0;
+}
@@ -0,0 +1,141 @@
+#include "Client_Task.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Stats.h"
+#include "ace/Throughput_Stats.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_stdio.h"
+
+#include "tao/Strategies/advanced_resource.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+int niterations = 1000;
+int nthreads = 32;
+int do_shutdown = 1;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("xk:i:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'n':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <niterations> "
+                           "-n <nthreads> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nthreads < 1 || niterations < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: invalid arguments\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Roundtrip_var roundtrip =
+        Test::Roundtrip::_narrow (object.in ());
+
+      if (CORBA::is_nil (roundtrip.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Roundtrip reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      // All the threads share the connection, the replies are read by
+      // whichever thread leads, the others wait as followers.
+      Client_Task **tasks = 0;
+      ACE_NEW_RETURN (tasks, Client_Task *[nthreads], 1);
+      for (int i = 0; i != nthreads; ++i)
+        ACE_NEW_RETURN (tasks[i],
+                        Client_Task (roundtrip.in (), niterations),
+                        1);
+
+      ACE_DEBUG ((LM_DEBUG, "Starting %d threads\n", nthreads));
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      for (int i = 0; i != nthreads; ++i)
+        tasks[i]->activate (THR_NEW_LWP | THR_JOINABLE);
+
+      ACE_Thread_Manager::instance ()->wait ();
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_DEBUG ((LM_DEBUG, "Threads finished\n"));
+
+      ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+      ACE_Basic_Stats totals;
+      for (int i = 0; i != nthreads; ++i)
+        {
+          ACE_TCHAR msg[64];
+          ACE_OS::sprintf (msg, ACE_TEXT("Task[%d]"), i);
+          tasks[i]->accumulate_and_dump (totals, msg, gsf);
+          delete tasks[i];
+        }
+      delete [] tasks;
+
+      totals.dump_results (ACE_TEXT("Total"), gsf);
+
+      ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                             test_end - test_start,
+                                             totals.samples_count ());
+
+      if (do_shutdown)
+        {
+          roundtrip->shutdown ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
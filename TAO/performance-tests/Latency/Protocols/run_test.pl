@@ -0,0 +1,119 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+}
+
+$iteration = 100000;
+
+# The endpoint of the server for each protocol.
+%endpoints = ('iiop'    => '-ORBEndpoint iiop://127.0.0.1:',
+              'uiop'    => '-ORBEndpoint uiop://',
+              'shmiop'  => '-ORBEndpoint shmiop://',
+              'shmriop' => '-ORBEndpoint shmriop://');
+@protocols = ();
+
+for ($iter = 0; $iter <= $#ARGV; $iter++) {
+    if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
+        print "Run_Test Perl script for the Protocols Latency test\n\n";
+        print "run_test [-n num] [-p protocol] [-h] \n";
+        print "\n";
+        print "-n num              -- runs the client num times\n";
+        print "-p protocol         -- runs only over protocol, one of\n";
+        print "                       iiop, uiop, shmiop or shmriop,\n";
+        print "                       can be repeated\n";
+        print "-h                  -- prints this information\n";
+        exit 0;
+    }
+    elsif ($ARGV[$iter] eq "-n") {
+        $iteration = $ARGV[$iter + 1];
+        $iter++;
+    }
+    elsif ($ARGV[$iter] eq "-p") {
+        $protocol = $ARGV[$iter + 1];
+        if (!exists $endpoints{$protocol}) {
+            print STDERR "ERROR: unknown protocol <$protocol>\n";
+            exit 1;
+        }
+        push @protocols, $protocol;
+        $iter++;
+    }
+}
+
+if ($#protocols == -1) {
+    @protocols = ('iiop', 'uiop', 'shmiop', 'shmriop');
+}
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my $iorbase = "test.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+
+foreach $protocol (@protocols) {
+    print STDERR "================ $protocol Latency Test\n";
+
+    $server->DeleteFile($iorbase);
+    $client->DeleteFile($iorbase);
+
+    $SV = $server->CreateProcess ("server", "-ORBdebuglevel $debug_level $endpoints{$protocol} -o $server_iorfile");
+    $CL = $client->CreateProcess ("client", "-k file://$client_iorfile -i $iteration");
+
+    $server_status = $SV->Spawn ();
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        exit 1;
+    }
+
+    if ($server->WaitForFileTimed ($iorbase,
+                                   $server->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($server->GetFile ($iorbase) == -1) {
+        print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($client->PutFile ($iorbase) == -1) {
+        print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 105);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+
+    $server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        $status = 1;
+    }
+}
+
+$server->DeleteFile($iorbase);
+$client->DeleteFile($iorbase);
+
+exit $status;
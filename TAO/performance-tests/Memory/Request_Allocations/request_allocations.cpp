@@ -0,0 +1,293 @@
+#include "TestS.h"
+#include "tao/ORB_Core.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/ARGV.h"
+#include <cstdlib>
+#include <new>
+
+// The allocations are only counted for the client thread, while
+// counting_ is set.
+static thread_local bool counting_ = false;
+static thread_local unsigned long allocations_ = 0;
+
+static void *
+counted_malloc (std::size_t size)
+{
+  if (counting_)
+    ++allocations_;
+
+  return std::malloc (size == 0 ? 1 : size);
+}
+
+void *
+operator new (std::size_t size)
+{
+  void * const p = counted_malloc (size);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  void * const p = counted_malloc (size);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new (std::size_t size, const std::nothrow_t &) noexcept
+{
+  return counted_malloc (size);
+}
+
+void *
+operator new[] (std::size_t size, const std::nothrow_t &) noexcept
+{
+  return counted_malloc (size);
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, const std::nothrow_t &) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, const std::nothrow_t &) noexcept
+{
+  std::free (p);
+}
+
+class Sink : public virtual POA_Test::Sink
+{
+public:
+  void receive_data (const Test::Payload &)
+  {
+  }
+};
+
+class ORB_Task : public ACE_Task_Base
+{
+public:
+  ORB_Task (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  int svc ()
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception&){}
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+int iterations = 10000;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <iterations> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      // Each ORB gets its own copy of the arguments, ORB_init consumes
+      // the ones it knows.
+      ACE_ARGV server_args;
+      server_args.add (argv);
+      int server_argc = server_args.argc ();
+
+      CORBA::ORB_var server_orb =
+        CORBA::ORB_init (server_argc, server_args.argv (), "server");
+
+      // Collocation would bypass the marshaling of the requests.
+      ACE_ARGV client_args;
+      client_args.add (argv);
+      client_args.add (ACE_TEXT ("-ORBCollocation"));
+      client_args.add (ACE_TEXT ("no"));
+      int client_argc = client_args.argc ();
+
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (client_argc, client_args.argv (), "client");
+
+      if (parse_args (client_argc, client_args.argv ()) != 0)
+        return 1;
+
+      CORBA::Object_var poa_object =
+        server_orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil RootPOA\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      Sink *sink_impl = 0;
+      ACE_NEW_RETURN (sink_impl,
+                      Sink,
+                      1);
+      PortableServer::ServantBase_var owner_transfer(sink_impl);
+
+      PortableServer::ObjectId_var id =
+        root_poa->activate_object (sink_impl);
+
+      CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+      CORBA::String_var ior = server_orb->object_to_string (object.in ());
+
+      poa_manager->activate ();
+
+      ORB_Task task (server_orb.in ());
+      if (task.activate (THR_NEW_LWP | THR_JOINABLE, 1) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) Cannot activate server thread\n"),
+                          1);
+
+      // Go through the stringified reference, so the client ORB
+      // connects to the server ORB.
+      CORBA::Object_var tmp = orb->string_to_object (ior.in ());
+
+      Test::Sink_var sink = Test::Sink::_narrow (tmp.in ());
+
+      if (CORBA::is_nil (sink.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) Nil Test::Sink reference <%C>\n",
+                           ior.in ()),
+                          1);
+
+      size_t const cache_size =
+        orb->orb_core ()->orb_params ()->cdr_thread_cache_size ();
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "Per thread output CDR cache: %B bytes\n",
+                  cache_size));
+
+      CORBA::ULong const sizes[] = { 0, 256, 4096, 15000 };
+
+      // Allocations of the requests without payload, the ones that
+      // fit in the cache of the thread must not make more.
+      unsigned long empty_allocations = 0;
+      int status = 0;
+
+      for (size_t s = 0; s != sizeof sizes / sizeof sizes[0]; ++s)
+        {
+          Test::Payload payload (sizes[s]);
+          payload.length (sizes[s]);
+
+          for (CORBA::ULong i = 0; i != sizes[s]; ++i)
+            payload[i] = static_cast<CORBA::Long> (i);
+
+          // Let the first requests set up the connection and the
+          // buffers.
+          for (int i = 0; i != 10; ++i)
+            sink->receive_data (payload);
+
+          allocations_ = 0;
+          counting_ = true;
+
+          for (int i = 0; i != iterations; ++i)
+            sink->receive_data (payload);
+
+          counting_ = false;
+
+          ACE_DEBUG ((LM_DEBUG,
+                      "Payload of %6u longs: %.2f allocations per request\n",
+                      sizes[s],
+                      static_cast<double> (allocations_) / iterations));
+
+          if (sizes[s] == 0)
+            {
+              empty_allocations = allocations_;
+            }
+          else if (sizes[s] * sizeof (CORBA::Long) + 1024 <= cache_size
+                   && allocations_ > empty_allocations + iterations / 2)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "ERROR: the requests with %u longs still "
+                          "allocate to marshal them\n",
+                          sizes[s]));
+              status = 1;
+            }
+        }
+
+      server_orb->shutdown (false);
+
+      task.wait ();
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+
+      server_orb->destroy ();
+
+      return status;
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+}
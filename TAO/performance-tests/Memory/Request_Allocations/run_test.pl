@@ -0,0 +1,38 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+$iterations = 10000;
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+    elsif ($i eq '-quick') {
+        $iterations = 1000;
+    }
+}
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+foreach $cache ('', '-ORBCDRThreadCacheSize 0') {
+    $TE = $test->CreateProcess ("request_allocations",
+                                "-ORBdebuglevel $debug_level " .
+                                "$cache -n $iterations");
+
+    $test_status = $TE->SpawnWaitKill ($test->ProcessStartWaitInterval() + 285);
+
+    if ($test_status != 0) {
+        print STDERR "ERROR: request_allocations $cache returned $test_status\n";
+        $status = 1;
+    }
+}
+
+exit $status;
@@ -0,0 +1,206 @@
+//=============================================================================
+/**
+ *  @file    active_object_map.cpp
+ *
+ *  Measures activation, lookup and deactivation of a large number of
+ *  objects in POAs with the USER_ID and the SYSTEM_ID policies, to
+ *  compare the active object map implementations selected with
+ *  -ORBUseridPolicyDemuxStrategy and -ORBSystemidPolicyDemuxStrategy.
+ */
+//=============================================================================
+
+#include "testS.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+
+/**
+ * @class test_i
+ *
+ * @brief Oversimplified servant class
+ */
+class test_i : public POA_test
+{
+};
+
+u_long nobjects = 1000000;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nobjects = static_cast<u_long> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <nobjects> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+void
+report (const char *test_name, ACE_High_Res_Timer &timer)
+{
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+
+  // Varargs do not convert the integral microseconds to the doubles
+  // the format expects.
+  double const elapsed =
+    static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (usecs));
+
+  ACE_DEBUG ((LM_DEBUG,
+              "\t%-12C %10.3f s, %8.1f ns/object\n",
+              test_name,
+              elapsed / ACE_ONE_SECOND_IN_USECS,
+              nobjects == 0 ? 0.0 : elapsed * 1000 / nobjects));
+}
+
+/// Visit the objects in an order that jumps all over the map, so
+/// the lookups do not benefit from the order of the activations.
+u_long
+scatter (u_long i)
+{
+  return static_cast<u_long> ((static_cast<ACE_UINT64> (i) * 2654435761UL)
+                              % nobjects);
+}
+
+int
+map_test (PortableServer::POA_ptr root_poa,
+          const char *poa_name,
+          PortableServer::IdAssignmentPolicyValue id_assignment)
+{
+  // A single servant incarnates all the objects, so only the id map
+  // of the active object map is exercised.
+  CORBA::PolicyList policies (2);
+  policies.length (2);
+
+  policies[0] =
+    root_poa->create_id_assignment_policy (id_assignment);
+
+  policies[1] =
+    root_poa->create_id_uniqueness_policy (PortableServer::MULTIPLE_ID);
+
+  PortableServer::POA_var poa =
+    root_poa->create_POA (poa_name,
+                          PortableServer::POAManager::_nil (),
+                          policies);
+
+  for (CORBA::ULong i = 0; i != policies.length (); ++i)
+    policies[i]->destroy ();
+
+  test_i servant;
+
+  PortableServer::ObjectId_var *object_ids =
+    new PortableServer::ObjectId_var[nobjects];
+
+  // Create the user ids before starting the clock.
+  if (id_assignment == PortableServer::USER_ID)
+    {
+      for (u_long i = 0; i != nobjects; ++i)
+        {
+          char buf[32];
+          ACE_OS::sprintf (buf, "Object_%8.8lx", i);
+          object_ids[i] = PortableServer::string_to_ObjectId (buf);
+        }
+    }
+
+  ACE_DEBUG ((LM_DEBUG, "\n%C, %u objects\n", poa_name, nobjects));
+
+  int result = 0;
+  ACE_High_Res_Timer timer;
+
+  timer.start ();
+  if (id_assignment == PortableServer::USER_ID)
+    {
+      for (u_long i = 0; i != nobjects; ++i)
+        poa->activate_object_with_id (object_ids[i].in (), &servant);
+    }
+  else
+    {
+      for (u_long i = 0; i != nobjects; ++i)
+        object_ids[i] = poa->activate_object (&servant);
+    }
+  timer.stop ();
+  report ("activation", timer);
+
+  timer.start ();
+  for (u_long i = 0; i != nobjects; ++i)
+    {
+      PortableServer::ServantBase_var found =
+        poa->id_to_servant (object_ids[scatter (i)].in ());
+
+      if (found.in () != &servant)
+        result = 1;
+    }
+  timer.stop ();
+  report ("lookup", timer);
+
+  timer.start ();
+  for (u_long i = 0; i != nobjects; ++i)
+    poa->deactivate_object (object_ids[scatter (i)].in ());
+  timer.stop ();
+  report ("deactivation", timer);
+
+  if (result != 0)
+    ACE_ERROR ((LM_ERROR,
+                "ERROR: id_to_servant returned the wrong servant\n"));
+
+  poa->destroy (true, true);
+
+  delete[] object_ids;
+
+  return result;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int result = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (obj.in ());
+
+      result |= map_test (root_poa.in (),
+                          "USER_ID POA",
+                          PortableServer::USER_ID);
+
+      result |= map_test (root_poa.in (),
+                          "SYSTEM_ID POA",
+                          PortableServer::SYSTEM_ID);
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught");
+      return 1;
+    }
+
+  return result;
+}
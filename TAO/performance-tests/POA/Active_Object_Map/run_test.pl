@@ -0,0 +1,36 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$objects = 1000000;
+
+foreach $i (@ARGV) {
+    if ($i eq '-quick') {
+        $objects = 10000;
+    }
+}
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+foreach $strategy (['default', ''],
+                   ['open', "-ORBsvcconfdirective \"static Server_Strategy_Factory '-ORBUseridPolicyDemuxStrategy open -ORBSystemidPolicyDemuxStrategy open'\""]) {
+    print STDERR "\n================ Active object map with $strategy->[0] demux strategies\n";
+
+    $T = $test->CreateProcess ("active_object_map",
+                               "-n $objects $strategy->[1]");
+
+    $test_status = $T->SpawnWaitKill ($test->ProcessStartWaitInterval() + 300);
+
+    if ($test_status != 0) {
+        print STDERR "ERROR: active_object_map returned $test_status\n";
+        $status = 1;
+    }
+}
+
+exit $status;
@@ -0,0 +1,17 @@
+#include "ORB_Task.h"
+
+ORB_Task::ORB_Task (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+int
+ORB_Task::svc ()
+{
+  try
+    {
+      this->orb_->run ();
+    }
+  catch (const CORBA::Exception&){}
+  return 0;
+}
@@ -0,0 +1,25 @@
+
+#ifndef COALESCING_ORB_TASK_H
+#define COALESCING_ORB_TASK_H
+#include /**/ "ace/pre.h"
+
+#include "tao/ORB.h"
+#include "ace/Task.h"
+
+/// Run the ORB event loop, which writes the coalesced requests
+class ORB_Task : public ACE_Task_Base
+{
+public:
+  /// Constructor
+  ORB_Task (CORBA::ORB_ptr orb);
+
+  /// The thread entry point
+  virtual int svc ();
+
+private:
+  /// Keep a reference to the ORB
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* COALESCING_ORB_TASK_H */
@@ -0,0 +1,49 @@
+#include "Receiver.h"
+#include "ace/OS_NS_sys_time.h"
+
+Receiver::Receiver (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , message_count_ (0)
+  , total_latency_ (0)
+  , max_latency_ (0)
+{
+}
+
+void
+Receiver::receive_data (CORBA::ULongLong send_time,
+                        const Test::Payload &)
+{
+  ACE_Time_Value const now = ACE_OS::gettimeofday ();
+  ACE_UINT64 now_usecs = 0;
+  now.to_usec (now_usecs);
+
+  double const latency =
+    now_usecs > send_time ? static_cast<double> (now_usecs - send_time) : 0;
+
+  ++this->message_count_;
+  this->total_latency_ += latency;
+  if (latency > this->max_latency_)
+    this->max_latency_ = latency;
+}
+
+Test::Latency
+Receiver::done ()
+{
+  Test::Latency latency;
+  latency.message_count = this->message_count_;
+  latency.average =
+    this->message_count_ == 0 ? 0 : this->total_latency_ / this->message_count_;
+  latency.maximum = this->max_latency_;
+
+  this->message_count_ = 0;
+  this->total_latency_ = 0;
+  this->max_latency_ = 0;
+
+  return latency;
+}
+
+void
+Receiver::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
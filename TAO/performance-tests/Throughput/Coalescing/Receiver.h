@@ -0,0 +1,45 @@
+#ifndef COALESCING_RECEIVER_H
+#define COALESCING_RECEIVER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+#if defined (_MSC_VER)
+# pragma warning(push)
+# pragma warning (disable:4250)
+#endif /* _MSC_VER */
+
+/// Implement the Test::Receiver interface
+class Receiver
+  : public virtual POA_Test::Receiver
+{
+public:
+  /// Constructor
+  Receiver (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual void receive_data (CORBA::ULongLong send_time,
+                             const Test::Payload &the_payload);
+
+  virtual Test::Latency done ();
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The number of messages received
+  CORBA::ULong message_count_;
+
+  /// Sum and largest of their latencies, in microseconds
+  double total_latency_;
+  double max_latency_;
+};
+
+#if defined(_MSC_VER)
+# pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* COALESCING_RECEIVER_H */
@@ -0,0 +1,177 @@
+#include "TestC.h"
+#include "ORB_Task.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_sys_time.h"
+#include "tao/Strategies/advanced_resource.h"
+#include "tao/Messaging/Messaging.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+int message_size  = 16;
+int message_count = 100 * 1024;
+int test_runs   = 6;
+int do_shutdown = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:b:i:n:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'b':
+        message_size = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        message_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'n':
+        test_runs = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'x':
+        do_shutdown = 1;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-b <message_size> "
+                           "-i <message_count> "
+                           "-n <test_repetitions> "
+                           "-x "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp =
+        orb->string_to_object(ior);
+
+      Test::Receiver_var receiver =
+        Test::Receiver::_narrow(tmp.in ());
+
+      if (CORBA::is_nil (receiver.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_DEBUG,
+                             "Nil receiver reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      // SYNC_WITH_TRANSPORT flushes each request before returning, so
+      // the requests are only held back with delayed buffering
+      {
+        CORBA::Any scope_as_any;
+        scope_as_any <<= TAO::SYNC_DELAYED_BUFFERING;
+
+        CORBA::PolicyList policies (1);
+        policies.length (1);
+        policies[0] =
+          orb->create_policy (Messaging::SYNC_SCOPE_POLICY_TYPE,
+                              scope_as_any);
+
+        CORBA::Object_var obj =
+          orb->resolve_initial_references ("ORBPolicyManager");
+        CORBA::PolicyManager_var policy_manager =
+          CORBA::PolicyManager::_narrow (obj.in ());
+
+        policy_manager->set_policy_overrides (policies,
+                                              CORBA::ADD_OVERRIDE);
+
+        policies[0]->destroy ();
+      }
+
+      // Coalesced requests are written by the thread running the
+      // event loop
+      ORB_Task orb_task (orb.in ());
+      if (orb_task.activate (THR_NEW_LWP | THR_JOINABLE, 1, 1) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Cannot activate the ORB thread\n"),
+                            1);
+        }
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      Test::Payload payload;
+
+      for (int j = 0; j != test_runs; ++j)
+        {
+          payload.length (message_size);
+
+          ACE_hrtime_t start = ACE_OS::gethrtime ();
+          for (int i = 0; i != message_count; ++i)
+            {
+              ACE_UINT64 now = 0;
+              ACE_OS::gettimeofday ().to_usec (now);
+              receiver->receive_data (now, payload);
+            }
+
+          Test::Latency const latency = receiver->done ();
+          ACE_hrtime_t elapsed_time = ACE_OS::gethrtime () - start;
+
+          // convert to microseconds
+          double const usecs = static_cast<double> (elapsed_time / gsf);
+
+          if (latency.message_count != CORBA::ULong (message_count))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "ERROR: %d messages sent, %d received\n",
+                          message_count, latency.message_count));
+            }
+
+          ACE_DEBUG ((LM_DEBUG,
+                      "Coalescing[%d] %.0f (messages/sec), "
+                      "latency %.1f average %.1f max (usecs)\n",
+                      message_size,
+                      usecs == 0 ? 0 : 1000000.0 * message_count / usecs,
+                      latency.average,
+                      latency.maximum));
+
+          message_size *= 4;
+        }
+
+      if (do_shutdown)
+        {
+          receiver->shutdown ();
+        }
+
+      orb->shutdown (true);
+      orb_task.wait ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,338 @@
+#include "tao/Transport_Cache_Manager_T.h"
+#include "tao/ORB_Core.h"
+#include "tao/Client_Strategy_Factory.h"
+#include "tao/ORB.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Unbounded_Set.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <atomic>
+
+class mock_transport;
+class mock_tdi;
+class mock_ps;
+
+typedef TAO::Transport_Cache_Manager_T<mock_transport, mock_tdi, mock_ps> TCM;
+
+int nthreads = 4;
+int niterations = 100000;
+int nendpoints = 1024;
+int cache_maximum = 512;
+size_t busy_maximum = 2;
+size_t nshards = 1;
+
+/// An endpoint, only identified by its number.
+class mock_tdi
+{
+public:
+  explicit mock_tdi (u_long id = 0) : id_ (id) {}
+  u_long hash (void) {return this->id_ * 2654435761UL;}
+  mock_tdi *duplicate (void) {return new mock_tdi (this->id_);}
+  CORBA::Boolean is_equivalent (const mock_tdi *rhs)
+  {
+    return this->id_ == rhs->id_;
+  }
+private:
+  u_long id_;
+};
+
+/// Connections are used in LRU order, as with the default
+/// purging strategy.
+class mock_ps
+{
+public:
+  mock_ps (int max) : maximum_ (max), order_ (0) {}
+  void update_item (mock_transport &transport);
+  int cache_maximum () { return this->maximum_;}
+private:
+  int maximum_;
+  std::atomic<unsigned long> order_;
+};
+
+class mock_wait_strategy
+{
+public:
+  bool non_blocking (void) const {return true;}
+  void is_registered (bool) {}
+};
+
+/// A connection that only exists in the cache.
+class mock_transport
+{
+public:
+  mock_transport (TCM &cache, size_t id)
+    : cache_ (cache), id_ (id), entry_ (0), purging_order_ (0) {}
+  size_t id () const {return id_;}
+  unsigned long purging_order () const {return purging_order_;}
+  void purging_order (unsigned long purging_order) { this->purging_order_ = purging_order;}
+  bool is_connected () const {return true;}
+  ACE_Event_Handler::Reference_Count add_reference (void) {return 1;}
+  ACE_Event_Handler::Reference_Count remove_reference (void) {return 1;}
+  void cache_map_entry (TCM::HASH_MAP_ENTRY *entry) {this->entry_ = entry;}
+  TCM::HASH_MAP_ENTRY *cache_map_entry (void) {return this->entry_;}
+  int make_idle (void) {return this->cache_.make_idle (this->entry_);}
+  void close_connection (void) {this->cache_.purge_entry (this->entry_);}
+  bool can_be_purged (void) {return true;}
+  mock_wait_strategy *wait_strategy (void) {return &this->wait_strategy_;}
+  TAO_ORB_Core *orb_core (void) {return 0;}
+  ACE_Event_Handler *event_handler_i (void) {return 0;}
+private:
+  TCM &cache_;
+  size_t id_;
+  TCM::HASH_MAP_ENTRY *entry_;
+  unsigned long purging_order_;
+  mock_wait_strategy wait_strategy_;
+};
+
+void
+mock_ps::update_item (mock_transport &transport)
+{
+  transport.purging_order (++this->order_);
+}
+
+/// State shared by the client threads.
+struct Stress
+{
+  Stress (TCM &cache, mock_tdi *endpoints)
+    : cache_ (cache), endpoints_ (endpoints), seed_ (0),
+      hits_ (0), misses_ (0), failures_ (0), transports_ (0)
+  {
+  }
+
+  TCM &cache_;
+  mock_tdi *endpoints_;
+  std::atomic<unsigned int> seed_;
+  std::atomic<size_t> hits_;
+  std::atomic<size_t> misses_;
+  std::atomic<size_t> failures_;
+
+  /// All the transports created, deleted once the cache is gone.
+  TAO_SYNCH_MUTEX lock_;
+  ACE_Unbounded_Set<mock_transport *> created_;
+  std::atomic<size_t> transports_;
+};
+
+ACE_THR_FUNC_RETURN
+client (void *arg)
+{
+  Stress &stress = *static_cast<Stress *> (arg);
+  unsigned int seed = ++stress.seed_ * 7919;
+
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t failures = 0;
+
+  for (int i = 0; i != niterations; ++i)
+    {
+      // Random endpoint, with an LCG to keep libc out of the picture
+      seed = seed * 1103515245 + 12345;
+      mock_tdi *endpoint = &stress.endpoints_[(seed >> 8) % nendpoints];
+
+      mock_transport *transport = 0;
+      size_t busy_count = 0;
+      TCM::Find_Result const result =
+        stress.cache_.find_transport (endpoint, transport, busy_count);
+
+      if (result == TCM::CACHE_FOUND_AVAILABLE)
+        {
+          ++hits;
+          transport->make_idle ();
+          transport->remove_reference ();
+          continue;
+        }
+
+      if (transport != 0)
+        transport->remove_reference ();
+
+      if (busy_count >= busy_maximum)
+        continue;
+
+      // Open a new connection and cache it
+      ++misses;
+      ACE_NEW_RETURN (transport,
+                      mock_transport (stress.cache_, ++stress.transports_),
+                      0);
+      {
+        ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, stress.lock_, 0);
+        stress.created_.insert_tail (transport);
+      }
+
+      if (stress.cache_.cache_transport (endpoint,
+                                         transport,
+                                         TAO::ENTRY_BUSY) != 0)
+        {
+          stress.cache_.purge ();
+          if (stress.cache_.cache_transport (endpoint,
+                                             transport,
+                                             TAO::ENTRY_BUSY) != 0)
+            {
+              ++failures;
+              continue;
+            }
+        }
+
+      transport->make_idle ();
+    }
+
+  stress.hits_ += hits;
+  stress.misses_ += misses;
+  stress.failures_ += failures;
+
+  return 0;
+}
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:i:e:m:b:s:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 't':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'e':
+        nendpoints = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'm':
+        cache_maximum = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'b':
+        busy_maximum = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 's':
+        if (ACE_OS::strcmp (get_opts.opt_arg (), ACE_TEXT ("auto")) == 0)
+          {
+            long const processors = ACE_OS::num_processors_online ();
+            nshards = processors > 0 ? processors : 1;
+          }
+        else
+          nshards = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-t <threads> "
+                           "-i <iterations> "
+                           "-e <endpoints> "
+                           "-m <cache maximum> "
+                           "-b <busy connections per endpoint> "
+                           "-s <shards|auto> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nthreads < 1 || niterations < 1 || nendpoints < 1 ||
+      cache_maximum < 1 || nshards < 1)
+    ACE_ERROR_RETURN ((LM_ERROR, "ERROR: invalid arguments\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      mock_tdi *endpoints = 0;
+      ACE_NEW_RETURN (endpoints, mock_tdi[nendpoints], 1);
+      for (int i = 0; i != nendpoints; ++i)
+        endpoints[i] = mock_tdi (i);
+
+      // Owned by the cache
+      mock_ps *purging_strategy = 0;
+      ACE_NEW_RETURN (purging_strategy, mock_ps (cache_maximum), 1);
+
+      ACE_Unbounded_Set<mock_transport *> created;
+      size_t hits = 0;
+      size_t misses = 0;
+      size_t failures = 0;
+      size_t final_size = 0;
+      ACE_hrtime_t elapsed = 0;
+
+      {
+        TCM cache (20,
+                   purging_strategy,
+                   cache_maximum,
+                   true,
+                   0,
+                   nshards);
+
+        Stress stress (cache, endpoints);
+
+        ACE_DEBUG ((LM_DEBUG,
+                    "Transport cache with %B shard(s), %d threads, "
+                    "%d endpoints, maximum %d\n",
+                    cache.shards (), nthreads, nendpoints, cache_maximum));
+
+        ACE_hrtime_t const start = ACE_OS::gethrtime ();
+
+        if (ACE_Thread_Manager::instance ()->spawn_n (nthreads,
+                                                      client,
+                                                      &stress) == -1)
+          ACE_ERROR_RETURN ((LM_ERROR, "ERROR: cannot spawn threads\n"), 1);
+
+        ACE_Thread_Manager::instance ()->wait ();
+
+        elapsed = ACE_OS::gethrtime () - start;
+
+        hits = stress.hits_;
+        misses = stress.misses_;
+        failures = stress.failures_;
+        final_size = cache.current_size ();
+        created = stress.created_;
+      }
+
+      ACE_Unbounded_Set<mock_transport *>::iterator it (created);
+      for (mock_transport **t = 0; it.next (t) != 0; it.advance ())
+        delete *t;
+      delete [] endpoints;
+
+      ACE_High_Res_Timer::global_scale_factor_type const gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      double const usecs = static_cast<double> (elapsed) / gsf;
+      double const lookups =
+        static_cast<double> (nthreads) * niterations;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "%B hits, %B new connections, %B not cached, "
+                  "%B cached at the end\n",
+                  hits, misses, failures, final_size));
+      ACE_DEBUG ((LM_DEBUG,
+                  "Throughput: %.0f lookups/second, %.3f usecs/lookup\n",
+                  lookups * 1000000.0 / usecs,
+                  usecs / lookups));
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
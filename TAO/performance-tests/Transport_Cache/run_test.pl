@@ -0,0 +1,36 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$threads = 4;
+$iterations = 100000;
+
+foreach $i (@ARGV) {
+    if ($i eq '-quick') {
+        $iterations = 10000;
+    }
+}
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+foreach $shards ('1', 'auto') {
+    print STDERR "\n================ Transport cache with $shards shard(s)\n";
+
+    $T = $test->CreateProcess ("cache_stress",
+                               "-t $threads -i $iterations -s $shards");
+
+    $test_status = $T->SpawnWaitKill ($test->ProcessStartWaitInterval() + 100);
+
+    if ($test_status != 0) {
+        print STDERR "ERROR: cache_stress returned $test_status\n";
+        $status = 1;
+    }
+}
+
+exit $status;
@@ -223,7 +223,9 @@ TAO::CSD::FW_Server_Request_Wrapper::clone (TAO_ServerRequest*& request)
 
   // TYPE: TAO_Service_Context
   // ACTION: No copy/assignment operator, so adding/using a clone operation.
-  this->clone (request->request_service_context_, clone_obj->request_service_context_);
+  // The accessor demarshals the service contexts that are still in
+  // the incoming stream of the request.
+  this->clone (request->request_service_context (), clone_obj->request_service_context_);
 
   // TYPE: TAO_Service_Context
   // ACTION: No copy/assignment operator, so adding/using a clone operation.
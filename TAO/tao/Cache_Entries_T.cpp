@@ -14,6 +14,11 @@ namespace TAO
     : transport_ (transport)
     , recycle_state_ (ENTRY_UNKNOWN)
     , is_connected_ (false)
+    , next_ (0)
+    , prev_ (0)
+    , head_ (0)
+    , purging_order_ (0)
+    , shard_ (0)
   {
     this->is_connected_ = transport->is_connected();
     transport->add_reference ();
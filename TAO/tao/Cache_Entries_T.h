@@ -27,6 +27,9 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO
 {
+  template <typename TT, typename TRDT, typename PSTRAT>
+  class Transport_Cache_Manager_T;
+
   /// States of a recyclable object.
   /// @todo: see discussion in bugzilla 3024
   enum Cache_Entries_State
@@ -117,6 +120,9 @@ namespace TAO
     static const char *state_name (Cache_Entries_State st);
 
   private:
+    template <typename TT, typename TRDT, typename PSTRAT>
+    friend class Transport_Cache_Manager_T;
+
     /// The transport that needs to be cached.
     transport_type *transport_;
 
@@ -126,6 +132,21 @@ namespace TAO
     /// This is an analog for the transport::is_connected(), which is
     /// guarded by a mutex.
     bool is_connected_;
+
+    /// Neighbours in the list of the entries of the same endpoint, and
+    /// the head of that list, maintained by the transport cache and
+    /// never copied.
+    Cache_IntId_T *next_;
+    Cache_IntId_T *prev_;
+    Cache_IntId_T *head_;
+
+    /// Purging order under which the transport cache indexed the entry.
+    unsigned long purging_order_;
+
+    /// Shard of the transport cache holding the entry.  Unlike the
+    /// fields above it is copied, so the entry carries it from the
+    /// moment it is bound.
+    size_t shard_;
   };
 
 
@@ -10,7 +10,12 @@ namespace TAO
   Cache_IntId_T<TRANSPORT_TYPE>::Cache_IntId_T ()
     : transport_ (0),
       recycle_state_ (ENTRY_UNKNOWN),
-      is_connected_ (false)
+      is_connected_ (false),
+      next_ (0),
+      prev_ (0),
+      head_ (0),
+      purging_order_ (0),
+      shard_ (0)
   {
   }
 
@@ -18,7 +23,12 @@ namespace TAO
   Cache_IntId_T<TRANSPORT_TYPE>::Cache_IntId_T (const Cache_IntId_T &rhs)
     : transport_ (0),
       recycle_state_ (ENTRY_UNKNOWN),
-      is_connected_ (false)
+      is_connected_ (false),
+      next_ (0),
+      prev_ (0),
+      head_ (0),
+      purging_order_ (0),
+      shard_ (rhs.shard_)
   {
     *this = rhs;
   }
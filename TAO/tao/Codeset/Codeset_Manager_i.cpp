@@ -159,6 +159,13 @@ TAO_Codeset_Manager_i::set_tcs (TAO_Profile &theProfile,
 void
 TAO_Codeset_Manager_i::process_service_context (TAO_ServerRequest &request)
 {
+  // Once the codesets of the transport are set only a request that
+  // carries a codeset context can change them, check for one without
+  // demarshaling the service contexts of the request.
+  if (request.transport()->is_tcs_set() &&
+      !request.has_request_service_context (IOP::CodeSets))
+    return;
+
   // Get the service Context from an object of TAO_ServerRequest
   // and set the TCS values on the Transport
   TAO_Service_Context &service_cntx = request.request_service_context ();
@@ -32,6 +32,12 @@ TAO_GIOP_Message_Base::TAO_GIOP_Message_Base (TAO_ORB_Core *orb_core,
                  TAO_DEF_GIOP_MAJOR,
                  TAO_DEF_GIOP_MINOR)
 {
+  // Only requests are marshaled in this stream, their arguments stay
+  // alive until the request has been sent or queued.  Replies are not
+  // since the reply is sent after the servant arguments are gone.
+  this->out_stream_.reference_threshold (
+    orb_core->orb_params ()->cdr_reference_threshold ());
+
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
   const int nibbles = 2 * sizeof (size_t);
   char hex_string[nibbles + 1];
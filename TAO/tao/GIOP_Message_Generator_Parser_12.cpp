@@ -266,17 +266,41 @@ TAO_GIOP_Message_Generator_Parser_12::parse_request_header (
       hdr_status = input.skip_bytes (length);
     }
 
-  // Tear out the service context ... we currently ignore it, but it
-  // should probably be passed to each ORB service as appropriate
-  // (e.g. transactions, security).
+  // Skip over the service contexts without demarshaling them, most
+  // requests carry none and most of the others are never looked at.
+  // TAO_ServerRequest demarshals them from the incoming stream the
+  // first time they are asked for.  They are only demarshaled here
+  // if one of them has a handler in the registry.
   //
   // NOTE: As security support kicks in, this is a good place to
   // verify a digital signature, if that is required in this security
   // environment.  It may be required even when using IPSEC security
   // infrastructure.
-  IOP::ServiceContextList &req_service_info = request.request_service_info ();
+  TAO_Service_Context_Registry &registry =
+    request.orb_core ()->service_context_registry ();
 
-  if (!(input >> req_service_info))
+  const char *service_context_start = input.rd_ptr ();
+  CORBA::ULong service_context_count = 0;
+  bool service_context_handled = false;
+
+  hdr_status = hdr_status && input.read_ulong (service_context_count);
+
+  for (CORBA::ULong i = 0;
+       hdr_status && i != service_context_count;
+       ++i)
+    {
+      CORBA::ULong context_id = 0;
+      CORBA::ULong context_length = 0;
+
+      hdr_status = input.read_ulong (context_id)
+        && input.read_ulong (context_length)
+        && input.skip_bytes (context_length);
+
+      if (hdr_status && registry.has_handler (context_id))
+        service_context_handled = true;
+    }
+
+  if (!hdr_status)
     {
       if (TAO_debug_level)
         {
@@ -288,10 +312,16 @@ TAO_GIOP_Message_Generator_Parser_12::parse_request_header (
       return -1;
     }
 
-  if (req_service_info.length() > 0)
+  if (service_context_count > 0)
     {
-      request.orb_core ()->service_context_registry ().
-        process_service_contexts (req_service_info, *(request.transport ()), &request);
+      request.request_service_context_view (
+        service_context_start,
+        input.rd_ptr () - service_context_start);
+
+      if (service_context_handled)
+        registry.process_service_contexts (request.request_service_info (),
+                                           *(request.transport ()),
+                                           &request);
     }
 
   if (input.length () > 0)
@@ -31,6 +31,7 @@ TAO_IIOP_Acceptor::TAO_IIOP_Acceptor ()
     version_ (TAO_DEF_GIOP_MAJOR, TAO_DEF_GIOP_MINOR),
     orb_core_ (nullptr),
     reuse_addr_ (1),
+    reuse_port_ (0),
 #if defined (ACE_HAS_IPV6) && !defined (ACE_USES_IPV4_IPV6_MIGRATION)
     default_address_ (static_cast<unsigned short> (0), ACE_IPV6_ANY, AF_INET6),
 #else
@@ -446,6 +447,9 @@ TAO_IIOP_Acceptor::open_i (const ACE_INET_Addr& addr,
                   ACCEPT_STRATEGY (this->orb_core_),
                   -1);
 
+  // The accept strategy owns the socket the base acceptor opens.
+  this->accept_strategy_->acceptor ().reuse_port (this->reuse_port_ != 0);
+
   unsigned short const requested_port = addr.get_port_number ();
   if (requested_port == 0)
     {
@@ -1240,6 +1244,10 @@ TAO_IIOP_Acceptor::parse_options_i (int &argc,
         {
           this->reuse_addr_ = ACE_OS::atoi (value.c_str ());
         }
+      else if (name == "reuse_port")
+        {
+          this->reuse_port_ = ACE_OS::atoi (value.c_str ());
+        }
       else
         {
           // the name is not known, skip to the next option
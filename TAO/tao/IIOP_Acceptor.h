@@ -30,7 +30,7 @@
 #include "tao/Acceptor_Impl.h"
 #include "tao/GIOP_Message_Version.h"
 
-#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Reuseport_Acceptor.h"
 #include "ace/Acceptor.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -64,10 +64,10 @@ public:
   /// Set address for default endpoint
   void set_default_address (const ACE_INET_Addr& addr);
 
-  typedef TAO_Strategy_Acceptor<TAO_IIOP_Connection_Handler, ACE_SOCK_ACCEPTOR> BASE_ACCEPTOR;
+  typedef TAO_Strategy_Acceptor<TAO_IIOP_Connection_Handler, ACE_SOCK_Reuseport_Acceptor> BASE_ACCEPTOR;
   typedef TAO_Creation_Strategy<TAO_IIOP_Connection_Handler> CREATION_STRATEGY;
   typedef TAO_Concurrency_Strategy<TAO_IIOP_Connection_Handler> CONCURRENCY_STRATEGY;
-  typedef TAO_Accept_Strategy<TAO_IIOP_Connection_Handler, ACE_SOCK_ACCEPTOR> ACCEPT_STRATEGY;
+  typedef TAO_Accept_Strategy<TAO_IIOP_Connection_Handler, ACE_SOCK_Reuseport_Acceptor> ACCEPT_STRATEGY;
 
   /**
    * The TAO_Acceptor methods, check the documentation in
@@ -170,6 +170,9 @@ protected:
    *                for situations where you might normally use an ephemeral
    *                port but can't because you're behind a firewall and don't
    *                want to permit passage on all ephemeral ports)
+   *    reuse_port -- lets several acceptors, e.g. of ORBs each running
+   *                their own reactor, listen on the same port, the
+   *                kernel spreading the connections over them
    */
   int parse_options (const char *options);
 
@@ -245,6 +248,9 @@ protected:
   /// Enable socket option SO_REUSEADDR to be set
   int reuse_addr_;
 
+  /// Enable socket option SO_REUSEPORT to be set
+  int reuse_port_;
+
   /// Address for default endpoint
   ACE_INET_Addr default_address_;
 
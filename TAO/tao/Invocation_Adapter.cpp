@@ -261,26 +261,39 @@ namespace TAO
       {
         details.request_id (resolver.transport ()->tms ()->request_id ());
       }
+
+    Invocation_Status status = TAO_INVOKE_FAILURE;
     switch (this->type_)
       {
         case TAO_ONEWAY_INVOCATION:
           {
-            return this->invoke_oneway (details,
-                                        effective_target,
-                                        resolver,
-                                        max_wait_time);
+            status = this->invoke_oneway (details,
+                                          effective_target,
+                                          resolver,
+                                          max_wait_time);
+            break;
           }
         case TAO_TWOWAY_INVOCATION:
           {
-            return this->invoke_twoway (details,
-                                        effective_target,
-                                        resolver,
-                                        max_wait_time,
-                                        retry_state);
-
+            status = this->invoke_twoway (details,
+                                          effective_target,
+                                          resolver,
+                                          max_wait_time,
+                                          retry_state);
+            break;
           }
       }
-    return TAO_INVOKE_FAILURE;
+
+    // Let the next invocation on the stub try the same transport
+    // before selecting an endpoint again.
+    if (status == TAO_INVOKE_SUCCESS
+        && resolver.transport ()
+        && stub->orb_core ()->orb_params ()->stub_transport_affinity ())
+      {
+        stub->keep_transport (resolver.transport ());
+      }
+
+    return status;
   }
 
   Invocation_Status
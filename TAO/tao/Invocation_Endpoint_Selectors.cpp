@@ -14,6 +14,12 @@ TAO_Invocation_Endpoint_Selector::~TAO_Invocation_Endpoint_Selector ()
 {
 }
 
+bool
+TAO_Invocation_Endpoint_Selector::transport_affinity () const
+{
+  return false;
+}
+
 // ****************************************************************
 
 TAO_Default_Endpoint_Selector::~TAO_Default_Endpoint_Selector ()
@@ -77,4 +83,10 @@ TAO_Default_Endpoint_Selector::select_endpoint (TAO::Profile_Transport_Resolver
   // Synch_Oneway_Invocation::remote_oneway instead.
 }
 
+bool
+TAO_Default_Endpoint_Selector::transport_affinity () const
+{
+  return true;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -66,6 +66,12 @@ public:
   virtual void select_endpoint (TAO::Profile_Transport_Resolver *r,
                                 ACE_Time_Value *val) = 0;
 
+  /// Return true if select_endpoint() would pick the transport the
+  /// last invocation on the stub used, as long as the profile in use
+  /// has not changed and that transport is idle, so the resolver may
+  /// reuse it without calling select_endpoint().  The default is
+  /// false.
+  virtual bool transport_affinity () const;
 };
 
 // ****************************************************************
@@ -92,6 +98,8 @@ public:
 
   virtual void select_endpoint (TAO::Profile_Transport_Resolver *r,
                                 ACE_Time_Value *val);
+
+  virtual bool transport_affinity () const;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
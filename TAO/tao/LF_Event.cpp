@@ -23,16 +23,48 @@ TAO_LF_Event::~TAO_LF_Event ()
 void
 TAO_LF_Event::state_changed (LFS_STATE new_state, TAO_Leader_Follower &lf)
 {
-  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, lf.lock ());
-
-  if (!this->is_state_final ())
+  if (lf.lock_free_followers ())
     {
-      this->state_changed_i (new_state);
-
-      /// Sort of double-checked optimization..
-      if (this->follower_ != nullptr)
-        this->follower_->signal ();
+      int const changed = this->state_changed_lock_free (new_state);
+      if (changed != -1)
+        {
+          // Hand the event over to the follower waiting for it.  A
+          // leader waiting for its own event has no follower bound, it
+          // sees the new state once it is back from the reactor.
+          TAO_LF_Follower * const follower =
+            changed == 1 ? this->follower_.load () : nullptr;
+          if (follower != nullptr && follower->post ())
+            follower->wake ();
+          return;
+        }
     }
+
+  TAO_LF_Follower *follower = nullptr;
+
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, lf.lock ());
+
+    if (!this->is_state_final ())
+      {
+        this->state_changed_i (new_state);
+
+        /// Sort of double-checked optimization..
+        TAO_LF_Follower * const bound = this->follower_;
+        if (bound != nullptr && bound->post ())
+          follower = bound;
+      }
+  }
+
+  // With the lock free follower set the follower is only woken up
+  // once the lock is released, so it does not have to wait for it.
+  if (follower != nullptr)
+    follower->wake ();
+}
+
+int
+TAO_LF_Event::state_changed_lock_free (LFS_STATE)
+{
+  return -1;
 }
 
 bool
@@ -21,6 +21,8 @@
 
 #include /**/ "tao/Versioned_Namespace.h"
 
+#include <atomic>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_LF_Follower;
@@ -124,6 +126,17 @@ protected:
   /// Validate the state change
   virtual void state_changed_i (LFS_STATE new_state) = 0;
 
+  /// Validate and perform the state change without the lock of the
+  /// Leader/Followers set, with its lock free follower set.
+  /**
+   * The event must outlive the call even though its follower sees the
+   * new state as soon as it is set.
+   *
+   * @return -1 if the state can only be changed with the lock held,
+   * which is the default, 1 if the state changed, 0 otherwise.
+   */
+  virtual int state_changed_lock_free (LFS_STATE new_state);
+
   /// Check if we should keep waiting.
   bool keep_waiting_i () const;
 
@@ -145,10 +158,10 @@ private:
 
 protected:
   /// The current state
-  LFS_STATE state_;
+  std::atomic<LFS_STATE> state_;
 
   /// The bounded follower
-  TAO_LF_Follower *follower_;
+  std::atomic<TAO_LF_Follower *> follower_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
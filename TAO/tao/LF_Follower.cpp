@@ -1,5 +1,12 @@
 #include "tao/LF_Follower.h"
 #include "tao/Leader_Follower.h"
+#include "ace/OS_NS_errno.h"
+
+#if TAO_HAS_LF_FUTEX == 1
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif /* TAO_HAS_LF_FUTEX == 1 */
 
 #if !defined (__ACE_INLINE__)
 # include "tao/LF_Follower.inl"
@@ -10,6 +17,13 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 TAO_LF_Follower::TAO_LF_Follower (TAO_Leader_Follower &leader_follower)
   : leader_follower_ (leader_follower)
   , condition_ (leader_follower.lock ())
+  , wakeup_ (FW_IDLE)
+  , elected_ (false)
+  , stacked_ (false)
+  , stack_next_ (nullptr)
+#if TAO_HAS_LF_FUTEX == 0
+  , semaphore_ (0)
+#endif /* TAO_HAS_LF_FUTEX == 0 */
 {
 }
 
@@ -20,6 +34,13 @@ TAO_LF_Follower::~TAO_LF_Follower ()
 int
 TAO_LF_Follower::signal ()
 {
+  if (this->leader_follower_.lock_free_followers ())
+    {
+      if (this->post ())
+        this->wake ();
+      return 0;
+    }
+
   // We *must* remove ourselves from the list of followers, otherwise
   // we could get signaled twice: to wake up as a follower and as the
   // next leader.
@@ -32,4 +53,137 @@ TAO_LF_Follower::signal ()
   return this->condition_.signal ();
 }
 
+bool
+TAO_LF_Follower::post ()
+{
+  if (!this->leader_follower_.lock_free_followers ())
+    {
+      (void) this->signal ();
+      return false;
+    }
+
+  // Leaving the set is only a change of the futex word, the set drops
+  // the follower when it pops it off its stack.  A follower that is
+  // not in the set keeps the post, its next wait() then returns at
+  // once.
+  int state = this->wakeup_.load ();
+  do
+    {
+      // Already woken up, a new leader looks at its event first.
+      if (state == FW_POSTED || state == FW_ELECTED)
+        return false;
+    }
+  while (!this->wakeup_.compare_exchange_weak (state, FW_POSTED));
+
+  if (state != FW_IDLE)
+    --this->leader_follower_.followers_waiting_;
+
+  // Only a parked thread needs a system call to wake up.
+  return state == FW_PARKED;
+}
+
+int
+TAO_LF_Follower::elect ()
+{
+  int state = this->wakeup_.load ();
+  while (state == FW_WAITING || state == FW_PARKED)
+    {
+      if (this->wakeup_.compare_exchange_weak (state, FW_ELECTED))
+        {
+          --this->leader_follower_.followers_waiting_;
+          return state == FW_PARKED ? 1 : 0;
+        }
+    }
+
+  return -1;
+}
+
+void
+TAO_LF_Follower::wake ()
+{
+  // The thread may have been woken up, or timed out, and used this
+  // follower to wait again since post() or elect(), it then finds
+  // that it was not woken up and parks again.
+#if TAO_HAS_LF_FUTEX == 1
+  ::syscall (SYS_futex,
+             reinterpret_cast<int *> (&this->wakeup_),
+             FUTEX_WAKE_PRIVATE,
+             1,
+             nullptr,
+             nullptr,
+             0);
+#else
+  this->semaphore_.release ();
+#endif /* TAO_HAS_LF_FUTEX == 1 */
+}
+
+int
+TAO_LF_Follower::wait (ACE_Time_Value *tv)
+{
+  if (!this->leader_follower_.lock_free_followers ())
+    return this->condition_.wait (tv);
+
+  int result = 0;
+  int error = 0;
+  {
+    ACE_GUARD_RETURN (ACE_Reverse_Lock<TAO_SYNCH_MUTEX>, rev_mon,
+                      this->leader_follower_.reverse_lock (), -1);
+
+    result = this->park (tv);
+    error = errno;
+  }
+  errno = error;
+  return result;
+}
+
+int
+TAO_LF_Follower::park (ACE_Time_Value *tv)
+{
+  // The reply, or the election, often comes while the leader still
+  // runs, so look for it a few times before going to sleep.
+  for (int i = this->leader_follower_.follower_spin (); i != 0; --i)
+    {
+      if (this->wakeup_.load (std::memory_order_acquire) != FW_WAITING)
+        return 0;
+    }
+
+  int expected = FW_WAITING;
+  if (!this->wakeup_.compare_exchange_strong (expected, FW_PARKED))
+    return 0;
+
+  while (this->wakeup_.load (std::memory_order_acquire) == FW_PARKED)
+    {
+#if TAO_HAS_LF_FUTEX == 1
+      timespec_t deadline;
+      if (tv != nullptr)
+        deadline = *tv;
+
+      // The deadline is an absolute time of day, as for a condition
+      // variable.
+      if (::syscall (SYS_futex,
+                     reinterpret_cast<int *> (&this->wakeup_),
+                     FUTEX_WAIT_BITSET_PRIVATE | FUTEX_CLOCK_REALTIME,
+                     FW_PARKED,
+                     tv == nullptr ? nullptr : &deadline,
+                     nullptr,
+                     FUTEX_BITSET_MATCH_ANY) == -1
+          && errno == ETIMEDOUT)
+#else
+      if (this->semaphore_.acquire (tv) == -1 && errno == ETIME)
+#endif /* TAO_HAS_LF_FUTEX == 1 */
+        {
+          // Unless post() or elect() came first, leave the parked
+          // state so a late post() does not bother to wake us up.
+          expected = FW_PARKED;
+          if (this->wakeup_.compare_exchange_strong (expected, FW_WAITING))
+            {
+              errno = ETIME;
+              return -1;
+            }
+        }
+    }
+
+  return 0;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
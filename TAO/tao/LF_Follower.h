@@ -21,10 +21,17 @@
 
 #include /**/ "tao/Versioned_Namespace.h"
 
+#include "tao/orbconf.h"
 #include "ace/Condition_Thread_Mutex.h"
 #include "ace/Synch_Traits.h"
 #include "ace/Intrusive_List_Node.h"
 
+#if TAO_HAS_LF_FUTEX == 0
+# include "ace/Thread_Semaphore.h"
+#endif /* TAO_HAS_LF_FUTEX == 0 */
+
+#include <atomic>
+
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -36,6 +43,13 @@ class TAO_Leader_Follower;
  * @brief Represent a thread blocked, as a follower, in the
  *        Leader/Followers set.
  *
+ * With the lock free follower set of TAO_Leader_Follower the
+ * follower does not wait on a condition of the set lock.  It lets go
+ * of the lock, spins for a while and then parks on a futex of its own
+ * (a semaphore where there are no futexes).  The futex word also says
+ * whether the follower is in the set, so a reply can be handed to it
+ * without the lock of the set.
+ *
  * @todo Currently this class offers little abstraction, the follower
  * loop should be implemented by this class.
  */
@@ -58,12 +72,73 @@ public:
   /// Signal the underlying condition variable
   int signal (void);
 
+  /// Remove the follower from the set and signal it.  With the lock
+  /// free follower set this does not need the lock of the set, and
+  /// returns true if wake() must still be called, best once the lock
+  /// is released, to get the thread running again.
+  bool post (void);
+
+  /// Wake up the thread parked on a follower that was post()ed or
+  /// elected.
+  void wake (void);
+
 private:
+  friend class TAO_Leader_Follower;
+
+  /// Park the thread, without the lock of the set, until post() or
+  /// elect() is called or the absolute time @a tv passes.
+  int park (ACE_Time_Value *tv);
+
+  /// Make the follower the new leader, with the lock of the set held.
+  /// Returns -1 if it has already left the set, 1 if wake() must be
+  /// called and 0 otherwise.
+  int elect (void);
+
+  /// Values of wakeup_.
+  enum
+    {
+      /// Not in the set.
+      FW_IDLE,
+      /// In the set, the thread spins or runs.
+      FW_WAITING,
+      /// In the set, the thread is parked.
+      FW_PARKED,
+      /// post() was called.
+      FW_POSTED,
+      /// elect() was called.
+      FW_ELECTED
+    };
+
   /// The Leader/Follower set this Follower belongs to
   TAO_Leader_Follower &leader_follower_;
 
   /// Condition variable used to
   ACE_SYNCH_CONDITION condition_;
+
+  /** @name Lock free follower set
+   *
+   * The members below are only used with the lock free follower set,
+   * all but wakeup_ are protected by the lock of the set.
+   */
+  //@{
+  /// The futex word the thread parks on.
+  std::atomic<int> wakeup_;
+
+  /// The follower was elected when it last left the set.
+  bool elected_;
+
+  /// The follower is on the stack of the set, which only drops the
+  /// followers that left the set as it pops them.
+  bool stacked_;
+
+  /// Next follower on the stack.
+  TAO_LF_Follower *stack_next_;
+
+#if TAO_HAS_LF_FUTEX == 0
+  /// Parks the thread.
+  ACE_Thread_Semaphore semaphore_;
+#endif /* TAO_HAS_LF_FUTEX == 0 */
+  //@}
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -15,50 +15,64 @@ TAO_LF_Invocation_Event::~TAO_LF_Invocation_Event ()
 void
 TAO_LF_Invocation_Event::state_changed_i (LFS_STATE new_state)
 {
-  if (this->state_ == new_state)
-    return;
+  this->state_ = next_state (this->state_, new_state);
+}
+
+TAO_LF_Event::LFS_STATE
+TAO_LF_Invocation_Event::next_state (LFS_STATE state, LFS_STATE new_state)
+{
+  if (state == new_state)
+    return state;
 
   // Validate the state change
-  if (this->state_ == TAO_LF_Event::LFS_IDLE)
+  if (state == TAO_LF_Event::LFS_IDLE)
     {
       // From the LFS_IDLE state we can only become active.
       if (new_state == TAO_LF_Event::LFS_ACTIVE
           || new_state == TAO_LF_Event::LFS_CONNECTION_CLOSED)
-        this->state_ = new_state;
-      return;
+        return new_state;
     }
-  else if (this->state_ == TAO_LF_Event::LFS_ACTIVE)
+  else if (state == TAO_LF_Event::LFS_ACTIVE)
     {
       // From LFS_ACTIVE we can only move to a few states
       if (new_state != TAO_LF_Event::LFS_IDLE)
         {
           if (new_state == TAO_LF_Event::LFS_CONNECTION_CLOSED)
-            {
-              this->state_ = TAO_LF_Event::LFS_FAILURE;
-            }
-          else
-            {
-              this->state_ = new_state;
-            }
+            return TAO_LF_Event::LFS_FAILURE;
+
+          return new_state;
         }
-      return;
     }
-  else if (this->state_ == TAO_LF_Event::LFS_SUCCESS
-           || this->state_ == TAO_LF_Event::LFS_CONNECTION_CLOSED)
+  else if (state == TAO_LF_Event::LFS_SUCCESS
+           || state == TAO_LF_Event::LFS_CONNECTION_CLOSED)
     {
       // From the two states above we can go back to ACTIVE, as when a
       // request is restarted.
       if (new_state == TAO_LF_Event::LFS_ACTIVE)
-        {
-          this->state_ = new_state;
-        }
-      return;
+        return new_state;
     }
-  else/* if (this->state_ == TAO_LF_Event::LFS_TIMEOUT || FAILURE */
+  else/* if (state == TAO_LF_Event::LFS_TIMEOUT || FAILURE */
     {
       // Other states are final..
     }
 
+  return state;
+}
+
+int
+TAO_LF_Invocation_Event::state_changed_lock_free_i (LFS_STATE new_state)
+{
+  LFS_STATE state = this->state_;
+  LFS_STATE next;
+  do
+    {
+      next = next_state (state, new_state);
+      if (next == state)
+        return 0;
+    }
+  while (!this->state_.compare_exchange_weak (state, next));
+
+  return 1;
 }
 
 bool
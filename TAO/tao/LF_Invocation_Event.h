@@ -60,6 +60,15 @@ protected:
    */
   virtual void state_changed_i (LFS_STATE new_state);
 
+  /// The state that a change to @a new_state in @a state leads to,
+  /// following the rules above.
+  static LFS_STATE next_state (LFS_STATE state, LFS_STATE new_state);
+
+  /// Perform the state change of state_changed_i() with a compare and
+  /// swap, for the derived classes that support
+  /// state_changed_lock_free().
+  int state_changed_lock_free_i (LFS_STATE new_state);
+
   /// Return true if the condition was satisfied successfully, false if it
   /// has not
   virtual bool successful_i () const;
@@ -73,8 +73,35 @@ TAO_Leader_Follower::release_follower (TAO_LF_Follower *follower)
 }
 
 int
-TAO_Leader_Follower::elect_new_leader_i ()
+TAO_Leader_Follower::elect_new_leader_i (TAO_LF_Follower *&next_leader)
 {
+  if (this->lock_free_followers_)
+    {
+      // Skip the followers that were handed their event since they
+      // were pushed.
+      for (TAO_LF_Follower *follower = this->pop_follower ();
+           follower != nullptr;
+           follower = this->pop_follower ())
+        {
+#if defined (TAO_DEBUG_LEADER_FOLLOWER)
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - TAO_Leader_Follower::elect_new_leader_i - ")
+                      ACE_TEXT ("follower is %@\n"),
+                      follower));
+#endif /* TAO_DEBUG_LEADER_FOLLOWER */
+
+          int const result = follower->elect ();
+          if (result == 1)
+            next_leader = follower;
+          if (result != -1)
+            return 0;
+        }
+
+      // All of them were handed their event while we looked.
+      this->no_leaders_available ();
+      return 0;
+    }
+
   TAO_LF_Follower* const follower = this->follower_set_.head ();
 
 #if defined (TAO_DEBUG_LEADER_FOLLOWER)
@@ -87,6 +114,45 @@ TAO_Leader_Follower::elect_new_leader_i ()
   return follower->signal ();
 }
 
+void
+TAO_Leader_Follower::push_follower (TAO_LF_Follower *follower)
+{
+  // Still on the stack since it last left the set.
+  if (follower->stacked_)
+    return;
+
+  follower->stacked_ = true;
+  TAO_LF_Follower *head =
+    this->follower_stack_.load (std::memory_order_relaxed);
+  do
+    {
+      follower->stack_next_ = head;
+    }
+  while (!this->follower_stack_.compare_exchange_weak (head,
+                                                       follower,
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+}
+
+TAO_LF_Follower *
+TAO_Leader_Follower::pop_follower ()
+{
+  TAO_LF_Follower *head =
+    this->follower_stack_.load (std::memory_order_acquire);
+  while (head != nullptr
+         && !this->follower_stack_.compare_exchange_weak (head,
+                                                          head->stack_next_,
+                                                          std::memory_order_acquire,
+                                                          std::memory_order_acquire))
+    {
+    }
+
+  if (head != nullptr)
+    head->stacked_ = false;
+
+  return head;
+}
+
 int
 TAO_Leader_Follower::wait_for_client_leader_to_complete (ACE_Time_Value *max_wait_time)
 {
@@ -426,6 +492,12 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
         // Now somebody woke us up to become a leader or to handle our
         // input. We are already removed from the follower queue.
 
+        // With the lock free follower set our event may have completed,
+        // without the lock, after we were elected. Pass the leadership
+        // on, or nobody runs the event loop.
+        if (follower->elected_ && !event->keep_waiting_i ())
+          (void) this->elect_new_leader ();
+
         if (event->successful_i ())
           return 0;
 
@@ -579,26 +651,8 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
   // We should only get here when our event is complete or timed-out
   } // End Scope #1
 
-  // Wake up the next leader, we cannot do that in handle_input,
-  // because the woken up thread would try to get into handle_events,
-  // which is at the time in handle_input still occupied. But do it
-  // before checking the error in <result>, even if there is an error
-  // in our input we should continue running the loop in another
-  // thread.
-
-  if (this->elect_new_leader () == -1)
-    TAOLIB_ERROR_RETURN ((LM_ERROR,
-                       ACE_TEXT ("TAO (%P|%t) - Leader_Follower[%d]::wait_for_event,")
-                       ACE_TEXT (" failed to elect new leader\n"),
-                       t_id),
-                      -1);
-
-  if (result == -1 && !this->reactor_->reactor_event_loop_done ())
-    TAOLIB_ERROR_RETURN ((LM_ERROR,
-                       ACE_TEXT ("TAO (%P|%t) - Leader_Follower[%d]::wait_for_event,")
-                       ACE_TEXT (" handle_events failed\n"),
-                       t_id),
-                      -1);
+  bool const event_loop_failed =
+    result == -1 && !this->reactor_->reactor_event_loop_done ();
 
   // Return an error if there was a problem receiving the reply...
   if (max_wait_time != nullptr)
@@ -631,6 +685,37 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
         }
     }
 
+  // Wake up the next leader, we cannot do that in handle_input,
+  // because the woken up thread would try to get into handle_events,
+  // which is at the time in handle_input still occupied. Do it even
+  // if there is an error in <result>, we should continue running the
+  // loop in another thread.
+  // With the lock free follower set the leadership is handed over
+  // directly: the new leader only runs once we no longer hold the
+  // lock it needs.
+  TAO_LF_Follower *next_leader = nullptr;
+  int const elected = this->elect_new_leader (next_leader);
+
+  int const error = errno;
+  ace_mon.release ();
+  if (next_leader != nullptr)
+    next_leader->wake ();
+  errno = error;
+
+  if (elected == -1)
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("TAO (%P|%t) - Leader_Follower[%d]::wait_for_event,")
+                       ACE_TEXT (" failed to elect new leader\n"),
+                       t_id),
+                      -1);
+
+  if (event_loop_failed)
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("TAO (%P|%t) - Leader_Follower[%d]::wait_for_event,")
+                       ACE_TEXT (" handle_events failed\n"),
+                       t_id),
+                      -1);
+
   return result;
 }
 
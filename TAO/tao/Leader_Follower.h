@@ -27,6 +27,8 @@
 #include "ace/OS_NS_Thread.h"
 #include "ace/Event_Handler.h"
 
+#include <atomic>
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Reactor;
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -44,13 +46,25 @@ class TAO_ORB_Core_TSS_Resources;
  * @brief TAO_Leader_Follower
  *
  * TAO_Leader_Follower
+ *
+ * The followers are either kept in a list and wait on condition
+ * variables of the set lock, or, with the lock free follower set, on
+ * a stack from which a new leader is popped and that is woken up on a
+ * futex of its own.  With the latter a reply is handed to the
+ * follower waiting for it without the lock, a reply for the leader
+ * itself needs no wake up at all, and a leader whose own event
+ * completed hands over to the next leader after releasing the lock,
+ * so the new leader does not wake up only to block on it.
  */
 class TAO_Export TAO_Leader_Follower
 {
 public:
+  friend class TAO_LF_Follower;
+
   /// Constructor
   TAO_Leader_Follower (TAO_ORB_Core *orb_core,
-                       TAO_New_Leader_Generator *new_leader_generator = 0);
+                       TAO_New_Leader_Generator *new_leader_generator = 0,
+                       bool lock_free_followers = false);
 
   /// Destructor
   ~TAO_Leader_Follower (void);
@@ -121,6 +135,11 @@ public:
    */
   int elect_new_leader (void);
 
+  /// Same as above, but with the lock free follower set the new
+  /// leader is only returned in @a next_leader, the caller must call
+  /// TAO_LF_Follower::wake() on it after releasing the lock.
+  int elect_new_leader (TAO_LF_Follower *&next_leader);
+
   /** @name Follower creation/destruction
    *
    * The Leader/Followers set acts as a factory for the Follower
@@ -165,6 +184,13 @@ public:
    */
   bool follower_available () const;
 
+  /// Is the lock free follower set used?
+  bool lock_free_followers () const;
+
+  /// Number of times a follower looks for its wake up before it
+  /// parks, with the lock free follower set.
+  int follower_spin () const;
+
   //@}
 
   /// Get a reference to the underlying mutex
@@ -221,7 +247,13 @@ private:
    * that all the pre-conditions are satisfied the Follower set is
    * changed and the promoted Follower is signaled.
    */
-  int elect_new_leader_i (void);
+  int elect_new_leader_i (TAO_LF_Follower *&next_leader);
+
+  /// Push a follower on the lock free follower stack
+  void push_follower (TAO_LF_Follower *follower);
+
+  /// Pop the most recent follower off the lock free follower stack
+  TAO_LF_Follower *pop_follower (void);
 
   //@}
 
@@ -246,6 +278,24 @@ private:
   /// Use a free list to allocate and release Follower objects
   Follower_Set follower_free_list_;
 
+  /// Use the lock free follower stack instead of follower_set_.
+  bool const lock_free_followers_;
+
+  /**
+   * The lock free follower stack.  Followers are pushed and popped
+   * with the lock held, so pops are free of ABA problems, but they
+   * leave the set without it: TAO_LF_Follower::post() only changes the
+   * futex word of the follower, which stays on the stack until it is
+   * popped and skipped, or added again.
+   */
+  std::atomic<TAO_LF_Follower *> follower_stack_;
+
+  /// Number of followers in the lock free follower set.
+  std::atomic<int> followers_waiting_;
+
+  /// See follower_spin().
+  int const follower_spin_;
+
   /**
    * Count the number of active leaders.
    * There could be many leaders in the thread pool (i.e. calling
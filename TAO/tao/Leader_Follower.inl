@@ -3,14 +3,23 @@
 
 #include "tao/ORB_Core_TSS_Resources.h"
 #include "tao/ORB_Core.h"
+#include "ace/OS_NS_unistd.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 ACE_INLINE
 TAO_Leader_Follower::TAO_Leader_Follower (TAO_ORB_Core* orb_core,
-                                          TAO_New_Leader_Generator *new_leader_generator)
+                                          TAO_New_Leader_Generator *new_leader_generator,
+                                          bool lock_free_followers)
   : orb_core_ (orb_core),
     reverse_lock_ (lock_),
+    lock_free_followers_ (lock_free_followers),
+    follower_stack_ (nullptr),
+    followers_waiting_ (0),
+    // Spinning only helps if the leader runs at the same time.
+    follower_spin_ (lock_free_followers
+                    && ACE_OS::num_processors_online () > 1
+                    ? TAO_LF_FOLLOWER_SPIN : 0),
     leaders_ (0),
     clients_ (0),
     reactor_ (0),
@@ -37,9 +46,24 @@ TAO_Leader_Follower::set_avoid_client_leader (void)
 ACE_INLINE bool
 TAO_Leader_Follower::follower_available () const
 {
+  if (this->lock_free_followers_)
+    return this->followers_waiting_ > 0;
+
   return !this->follower_set_.is_empty ();
 }
 
+ACE_INLINE bool
+TAO_Leader_Follower::lock_free_followers () const
+{
+  return this->lock_free_followers_;
+}
+
+ACE_INLINE int
+TAO_Leader_Follower::follower_spin () const
+{
+  return this->follower_spin_;
+}
+
 ACE_INLINE bool
 TAO_Leader_Follower::no_leaders_available (void)
 {
@@ -50,6 +74,18 @@ TAO_Leader_Follower::no_leaders_available (void)
 
 ACE_INLINE int
 TAO_Leader_Follower::elect_new_leader (void)
+{
+  TAO_LF_Follower *next_leader = nullptr;
+  int const result = this->elect_new_leader (next_leader);
+
+  if (next_leader != nullptr)
+    next_leader->wake ();
+
+  return result;
+}
+
+ACE_INLINE int
+TAO_Leader_Follower::elect_new_leader (TAO_LF_Follower *&next_leader)
 {
   if (this->leaders_ == 0)
     {
@@ -59,7 +95,7 @@ TAO_Leader_Follower::elect_new_leader (void)
         }
       else if (this->follower_available ())
         {
-          return this->elect_new_leader_i ();
+          return this->elect_new_leader_i (next_leader);
         }
       else
         {
@@ -136,13 +172,14 @@ ACE_INLINE void
 TAO_Leader_Follower::set_upcall_thread (void)
 {
   TAO_ORB_Core_TSS_Resources *tss = this->get_tss_resources ();
+  TAO_LF_Follower *next_leader = nullptr;
 
   if (tss->event_loop_thread_ > 0)
     {
       ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock ());
       this->reset_event_loop_thread_i (tss);
 
-      this->elect_new_leader ();
+      this->elect_new_leader (next_leader);
     }
   else if (tss->client_leader_thread_ == 1)
     { // We are client leader thread going to handle upcall.
@@ -153,8 +190,12 @@ TAO_Leader_Follower::set_upcall_thread (void)
       ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock ());
       this->reset_client_leader_thread ();
 
-      this->elect_new_leader ();
+      this->elect_new_leader (next_leader);
     }
+
+  // Wake the new leader up once the lock is released.
+  if (next_leader != nullptr)
+    next_leader->wake ();
 }
 
 ACE_INLINE bool
@@ -197,13 +238,41 @@ TAO_Leader_Follower::is_client_leader_thread () const
 ACE_INLINE void
 TAO_Leader_Follower::add_follower (TAO_LF_Follower *follower)
 {
-  this->follower_set_.push_back (follower);
+  if (this->lock_free_followers_)
+    {
+      follower->elected_ = false;
+
+      // A post() that came before the follower was added is kept, so
+      // that it does not wait at all.
+      ++this->followers_waiting_;
+      int expected = TAO_LF_Follower::FW_IDLE;
+      if (follower->wakeup_.compare_exchange_strong (expected,
+                                                     TAO_LF_Follower::FW_WAITING))
+        this->push_follower (follower);
+      else
+        --this->followers_waiting_;
+    }
+  else
+    this->follower_set_.push_back (follower);
 }
 
 ACE_INLINE void
 TAO_Leader_Follower::remove_follower (TAO_LF_Follower *follower)
 {
-  this->follower_set_.remove (follower);
+  if (this->lock_free_followers_)
+    {
+      // The follower stays on the stack until it is popped, or added
+      // again.
+      int const state =
+        follower->wakeup_.exchange (TAO_LF_Follower::FW_IDLE);
+      if (state == TAO_LF_Follower::FW_WAITING
+          || state == TAO_LF_Follower::FW_PARKED)
+        --this->followers_waiting_;
+      else if (state == TAO_LF_Follower::FW_ELECTED)
+        follower->elected_ = true;
+    }
+  else
+    this->follower_set_.remove (follower);
 }
 
 ACE_INLINE ACE_Reverse_Lock<TAO_SYNCH_MUTEX> &
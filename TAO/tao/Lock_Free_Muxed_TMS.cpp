@@ -0,0 +1,396 @@
+#include "tao/Lock_Free_Muxed_TMS.h"
+#include "tao/Reply_Dispatcher.h"
+#include "tao/debug.h"
+#include "tao/Transport.h"
+#include "tao/ORB_Core.h"
+#include "tao/Client_Strategy_Factory.h"
+#include "ace/Intrusive_Auto_Ptr.h"
+#include "ace/Containers_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Lock_Free_Muxed_TMS::Slot::Slot ()
+  : tag_ (0),
+    dispatcher_ (nullptr)
+{
+}
+
+TAO_Lock_Free_Muxed_TMS::TAO_Lock_Free_Muxed_TMS (TAO_Transport *transport)
+  : TAO_Transport_Mux_Strategy (transport)
+    , lock_ (nullptr)
+    , request_id_generator_ (0)
+    , orb_core_ (transport->orb_core ())
+    , slots_ (nullptr)
+    , mask_ (0)
+    , shift_ (32)
+    , max_probe_ (0)
+    , size_ (0)
+    , overflow_table_ (TAO_RD_TABLE_SIZE)
+    , overflow_size_ (0)
+{
+  this->lock_ =
+    this->orb_core_->client_factory ()->create_transport_mux_strategy_lock ();
+
+  int const size =
+    this->orb_core_->client_factory ()->reply_dispatcher_table_size ();
+
+  CORBA::ULong capacity = 1;
+  while (capacity < static_cast<CORBA::ULong> (size) && capacity < 0x40000000U)
+    {
+      capacity *= 2;
+      --this->shift_;
+    }
+
+  ACE_NEW (this->slots_,
+           Slot[capacity]);
+
+  this->mask_ = capacity - 1;
+}
+
+TAO_Lock_Free_Muxed_TMS::~TAO_Lock_Free_Muxed_TMS ()
+{
+  for (CORBA::ULong i = 0; this->slots_ != nullptr && i <= this->mask_; ++i)
+    {
+      if (this->slots_[i].dispatcher_ != nullptr)
+        TAO_Reply_Dispatcher::intrusive_remove_ref (
+          this->slots_[i].dispatcher_);
+    }
+
+  delete [] this->slots_;
+  delete this->lock_;
+}
+
+ACE_UINT64
+TAO_Lock_Free_Muxed_TMS::tag (CORBA::ULong request_id, ACE_UINT64 state)
+{
+  return (state << 32) | request_id;
+}
+
+CORBA::ULong
+TAO_Lock_Free_Muxed_TMS::home (CORBA::ULong request_id) const
+{
+  // Fibonacci hashing, consecutive request ids, and the ids two apart
+  // used on bidirectional connections, land far from each other.
+  ACE_UINT32 const h = request_id * 2654435769U;
+  return static_cast<CORBA::ULong> (static_cast<ACE_UINT64> (h) >> this->shift_);
+}
+
+// Generate and return an unique request id for the current
+// invocation.
+CORBA::ULong
+TAO_Lock_Free_Muxed_TMS::request_id ()
+{
+  // if TAO_Transport::bidirectional_flag_
+  //  ==  1 --> originating side
+  //  ==  0 --> other side
+  //  == -1 --> no bi-directional connection was negotiated
+  // The originating side must have an even request ID, and the other
+  // side must have an odd request ID.  Make sure that is the case.
+  int const bidir_flag = this->transport_->bidirectional_flag ();
+
+  CORBA::ULong id = this->request_id_generator_.load (std::memory_order_relaxed);
+  CORBA::ULong next = 0;
+
+  do
+    {
+      next = id + 1;
+
+      if ((bidir_flag == 1 && ACE_ODD (next))
+          || (bidir_flag == 0 && ACE_EVEN (next)))
+        ++next;
+    }
+  while (!this->request_id_generator_.compare_exchange_weak (id, next));
+
+  if (TAO_debug_level > 4)
+    TAOLIB_DEBUG ((LM_DEBUG,
+                "TAO (%P|%t) - Lock_Free_Muxed_TMS[%d]::request_id, [%d]\n",
+                this->transport_->id (),
+                next));
+
+  return next;
+}
+
+/// Bind the dispatcher with the request id.
+int
+TAO_Lock_Free_Muxed_TMS::bind_dispatcher (
+  CORBA::ULong request_id,
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd)
+{
+  if (rd == nullptr)
+    {
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - TAO_Lock_Free_Muxed_TMS::bind_dispatcher, ")
+                      ACE_TEXT ("null reply dispatcher\n")));
+        }
+      return 0;
+    }
+
+  CORBA::ULong const start = this->home (request_id);
+  CORBA::ULong const probes =
+    ACE_MIN (TAO_Lock_Free_Muxed_TMS::probe_limit, this->mask_ + 1);
+
+  for (CORBA::ULong i = 0; i != probes; ++i)
+    {
+      Slot &slot = this->slots_[(start + i) & this->mask_];
+      ACE_UINT64 expected = 0;
+
+      if (slot.tag_.load (std::memory_order_relaxed) != 0
+          || !slot.tag_.compare_exchange_strong (
+               expected,
+               TAO_Lock_Free_Muxed_TMS::tag (request_id, SLOT_BINDING),
+               std::memory_order_acquire))
+        continue;
+
+      TAO_Reply_Dispatcher::intrusive_add_ref (rd.get ());
+      slot.dispatcher_ = rd.get ();
+
+      // Lookups must probe as far as this slot before they can see it
+      // bound.
+      CORBA::ULong max_probe = this->max_probe_.load ();
+      while (max_probe < i
+             && !this->max_probe_.compare_exchange_weak (max_probe, i))
+        {
+        }
+
+      ++this->size_;
+      slot.tag_.store (TAO_Lock_Free_Muxed_TMS::tag (request_id, SLOT_BOUND),
+                       std::memory_order_release);
+      return 0;
+    }
+
+  // The neighbourhood of the home slot is full.
+  ACE_GUARD_RETURN (ACE_Lock,
+                    ace_mon,
+                    *this->lock_,
+                    -1);
+
+  int const result = this->overflow_table_.bind (request_id, rd);
+
+  if (result != 0)
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_ERROR ((LM_ERROR,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Lock_Free_Muxed_TMS::bind_dispatcher, ")
+                    ACE_TEXT ("bind dispatcher failed: result = %d, request id [%d]\n"),
+                    result, request_id));
+
+      return -1;
+    }
+
+  ++this->overflow_size_;
+
+  return 0;
+}
+
+TAO_Reply_Dispatcher *
+TAO_Lock_Free_Muxed_TMS::clear (Slot &slot)
+{
+  TAO_Reply_Dispatcher * const rd = slot.dispatcher_;
+  slot.dispatcher_ = nullptr;
+  --this->size_;
+  slot.tag_.store (0, std::memory_order_release);
+  return rd;
+}
+
+TAO_Reply_Dispatcher *
+TAO_Lock_Free_Muxed_TMS::take (CORBA::ULong request_id)
+{
+  CORBA::ULong const start = this->home (request_id);
+  CORBA::ULong const probes = this->max_probe_.load () + 1;
+  ACE_UINT64 const bound =
+    TAO_Lock_Free_Muxed_TMS::tag (request_id, SLOT_BOUND);
+
+  for (CORBA::ULong i = 0; i != probes; ++i)
+    {
+      Slot &slot = this->slots_[(start + i) & this->mask_];
+      ACE_UINT64 expected = bound;
+
+      // Whoever moves the slot out of the bound state owns the
+      // dispatcher, a reply racing with its timeout cannot get it
+      // twice.
+      if (slot.tag_.load (std::memory_order_relaxed) == bound
+          && slot.tag_.compare_exchange_strong (
+               expected,
+               TAO_Lock_Free_Muxed_TMS::tag (request_id, SLOT_TAKING),
+               std::memory_order_acquire))
+        return this->clear (slot);
+    }
+
+  if (this->overflow_size_.load () == 0)
+    return nullptr;
+
+  ACE_GUARD_RETURN (ACE_Lock,
+                    ace_mon,
+                    *this->lock_,
+                    nullptr);
+
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+
+  if (this->overflow_table_.unbind (request_id, rd) != 0)
+    return nullptr;
+
+  --this->overflow_size_;
+
+  TAO_Reply_Dispatcher::intrusive_add_ref (rd.get ());
+  return rd.get ();
+}
+
+int
+TAO_Lock_Free_Muxed_TMS::unbind_dispatcher (CORBA::ULong request_id)
+{
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (this->take (request_id),
+                                                   false);
+
+  return rd == nullptr ? -1 : 0;
+}
+
+bool
+TAO_Lock_Free_Muxed_TMS::has_request ()
+{
+  return this->size_.load () > 0 || this->overflow_size_.load () > 0;
+}
+
+int
+TAO_Lock_Free_Muxed_TMS::dispatch_reply (TAO_Pluggable_Reply_Params &params)
+{
+  int result = 0;
+
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (
+    this->take (params.request_id_),
+    false);
+
+  if (rd != nullptr)
+    {
+      if (TAO_debug_level > 8)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Lock_Free_Muxed_TMS::dispatch_reply, ")
+                    ACE_TEXT ("id [%d]\n"),
+                    params.request_id_));
+
+      // Dispatch the reply.
+      // They return 1 on success, and -1 on failure.
+      result = rd->dispatch_reply (params);
+    }
+  else
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Lock_Free_Muxed_TMS::dispatch_reply, ")
+                    ACE_TEXT ("unbind dispatcher failed, id [%d]\n"),
+                    params.request_id_));
+
+      // There is no registered reply handler, either because the reply
+      // was not our reply - just forget about it - or it was ours, but
+      // the reply timed out - just forget about the reply.
+      result = 0;
+    }
+
+  return result;
+}
+
+int
+TAO_Lock_Free_Muxed_TMS::reply_timed_out (CORBA::ULong request_id)
+{
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (this->take (request_id),
+                                                   false);
+
+  if (rd != nullptr)
+    {
+      if (TAO_debug_level > 8)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - TAO_Lock_Free_Muxed_TMS::reply_timed_out, ")
+                      ACE_TEXT ("id [%d]\n"),
+                      request_id));
+        }
+
+      // The reference taken from the table keeps the dispatcher alive
+      // while the timeout is dispatched.
+      rd->reply_timed_out ();
+    }
+  else
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_Lock_Free_Muxed_TMS::reply_timed_out, ")
+                    ACE_TEXT ("unbind dispatcher failed, id [%d]\n"),
+                    request_id));
+    }
+
+  return 0;
+}
+
+bool
+TAO_Lock_Free_Muxed_TMS::idle_after_send ()
+{
+  // Irrespective of whether we are successful or not we need to
+  // return true. If *this* class is not successful in idling the
+  // transport no one can.
+  if (this->transport_ != nullptr)
+    (void) this->transport_->make_idle ();
+
+  return true;
+}
+
+bool
+TAO_Lock_Free_Muxed_TMS::idle_after_reply ()
+{
+  return false;
+}
+
+void
+TAO_Lock_Free_Muxed_TMS::connection_closed ()
+{
+  ACE_Unbounded_Stack <ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> > ubs;
+
+  for (CORBA::ULong i = 0; i <= this->mask_; ++i)
+    {
+      Slot &slot = this->slots_[i];
+      ACE_UINT64 expected = slot.tag_.load (std::memory_order_relaxed);
+
+      if ((expected >> 32) == SLOT_BOUND
+          && slot.tag_.compare_exchange_strong (
+               expected,
+               TAO_Lock_Free_Muxed_TMS::tag (
+                 static_cast<CORBA::ULong> (expected), SLOT_TAKING),
+               std::memory_order_acquire))
+        ubs.push (ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> (
+                    this->clear (slot), false));
+    }
+
+  {
+    ACE_GUARD (ACE_Lock,
+               ace_mon,
+               *this->lock_);
+
+    REQUEST_DISPATCHER_TABLE::ITERATOR const end =
+      this->overflow_table_.end ();
+
+    for (REQUEST_DISPATCHER_TABLE::ITERATOR i =
+           this->overflow_table_.begin ();
+         i != end;
+         ++i)
+      {
+        ubs.push ((*i).int_id_);
+      }
+
+    this->overflow_table_.unbind_all ();
+    this->overflow_size_ = 0;
+  }
+
+  size_t const sz = ubs.size ();
+
+  for (size_t k = 0 ; k != sz ; ++k)
+    {
+      ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd(nullptr);
+
+      if (ubs.pop (rd) == 0)
+        {
+          rd->connection_closed ();
+        }
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,172 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Lock_Free_Muxed_TMS.h
+ *
+ *  Muxed transport strategy that binds the reply dispatchers in a
+ *  lock free table, used with -ORBTransportMuxStrategy LOCK_FREE.
+ */
+//=============================================================================
+
+#ifndef TAO_LOCK_FREE_MUXED_TMS_H
+#define TAO_LOCK_FREE_MUXED_TMS_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Transport_Mux_Strategy.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+template <class X> class ACE_Intrusive_Auto_Ptr;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_ORB_Core;
+class TAO_Pluggable_Reply_Params;
+class TAO_Reply_Dispatcher;
+
+/**
+ * @class TAO_Lock_Free_Muxed_TMS
+ *
+ * @brief Multiplexes requests on a connection like TAO_Muxed_TMS,
+ * without locking the table of reply dispatchers.
+ *
+ * The reply dispatchers live in a fixed array of slots, sized with
+ * -ORBReplyDispatcherTableSize and probed linearly from a hash of the
+ * request id.  Each slot is claimed and released with compare and
+ * swap on a single word holding its request id and state, so binding
+ * a dispatcher, dispatching its reply and timing it out never wait
+ * for each other, and only one of a reply and a timeout gets the
+ * dispatcher of a request.  Request ids are generated with compare
+ * and swap too.
+ *
+ * A request that finds no free slot close to its home slot goes to
+ * an overflow map under the transport mux strategy lock, so the table
+ * never limits the number of outstanding requests.
+ */
+class TAO_Export TAO_Lock_Free_Muxed_TMS : public TAO_Transport_Mux_Strategy
+{
+public:
+  /// Constructor.
+  TAO_Lock_Free_Muxed_TMS (TAO_Transport *transport);
+
+  /// Destructor.
+  virtual ~TAO_Lock_Free_Muxed_TMS ();
+
+  /// Generate and return an unique request id for the current
+  /// invocation.
+  virtual CORBA::ULong request_id ();
+
+  // = Please read the documentation in the TAO_Transport_Mux_Strategy
+  //   class.
+  virtual int bind_dispatcher (CORBA::ULong request_id,
+                               ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd);
+  virtual int unbind_dispatcher (CORBA::ULong request_id);
+
+  virtual int dispatch_reply (TAO_Pluggable_Reply_Params &params);
+  virtual int reply_timed_out (CORBA::ULong request_id);
+
+  virtual bool idle_after_send ();
+  virtual bool idle_after_reply ();
+  virtual void connection_closed ();
+  virtual bool has_request ();
+
+  TAO_Lock_Free_Muxed_TMS (const TAO_Lock_Free_Muxed_TMS &) = delete;
+  TAO_Lock_Free_Muxed_TMS &operator= (const TAO_Lock_Free_Muxed_TMS &) = delete;
+
+private:
+  /// Number of slots, starting at the home slot of a request id, that
+  /// are tried before binding the request in the overflow map.
+  static const CORBA::ULong probe_limit = 16;
+
+  /// A slot of the table, its tag is zero when the slot is free, the
+  /// request id and the state of the slot otherwise.
+  struct Slot
+  {
+    Slot ();
+
+    std::atomic<ACE_UINT64> tag_;
+
+    /// Owns a reference, only accessed by the thread that moved the
+    /// slot to the binding or taking state.
+    TAO_Reply_Dispatcher *dispatcher_;
+  };
+
+  /// Slot states, kept above the request id in the tag.
+  enum
+  {
+    SLOT_BINDING = 1,
+    SLOT_BOUND = 2,
+    SLOT_TAKING = 3
+  };
+
+  static ACE_UINT64 tag (CORBA::ULong request_id, ACE_UINT64 state);
+
+  /// Index of the first slot probed for @a request_id.
+  CORBA::ULong home (CORBA::ULong request_id) const;
+
+  /// Remove the dispatcher bound to @a request_id from the table or
+  /// the overflow map and return it, with the reference the table
+  /// held.  Return zero if there is none, which is also the case when
+  /// another thread took it first.
+  TAO_Reply_Dispatcher *take (CORBA::ULong request_id);
+
+  /// Free @a slot, which the caller moved to the taking state, and
+  /// return its dispatcher.
+  TAO_Reply_Dispatcher *clear (Slot &slot);
+
+  /// Lock protecting the overflow map.
+  ACE_Lock *lock_;
+
+  /// Used to generate a different request_id on each call to
+  /// request_id().
+  std::atomic<CORBA::ULong> request_id_generator_;
+
+  /// Keep track of the orb core pointer.
+  TAO_ORB_Core * const orb_core_;
+
+  /// The slots, a power of two of them.
+  Slot *slots_;
+
+  /// Number of slots minus one.
+  CORBA::ULong mask_;
+
+  /// Shift applied to the hash of a request id to get its home slot.
+  int shift_;
+
+  /// Largest number of slots a bound request was probed past, lookups
+  /// do not look further.
+  std::atomic<CORBA::ULong> max_probe_;
+
+  /// Number of bound slots.
+  std::atomic<size_t> size_;
+
+  typedef ACE_Hash_Map_Manager_Ex <CORBA::ULong,
+                                   ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher>,
+                                   ACE_Hash <CORBA::ULong>,
+                                   ACE_Equal_To <CORBA::ULong>,
+                                   ACE_Null_Mutex>
+    REQUEST_DISPATCHER_TABLE;
+
+  /// Requests that did not find a free slot.
+  REQUEST_DISPATCHER_TABLE overflow_table_;
+
+  /// Number of entries in @c overflow_table_, read without the lock
+  /// to skip the overflow map while it is empty.
+  std::atomic<size_t> overflow_size_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_LOCK_FREE_MUXED_TMS_H */
@@ -143,6 +143,9 @@ const CORBA::ULong TAO_TAG_DIOP_PROFILE = 0x54414f04U;
 /// COIOP
 const CORBA::ULong TAO_TAG_COIOP_PROFILE = 0x54414f05U;
 
+/// Shared memory ring buffers
+const CORBA::ULong TAO_TAG_SHMRIOP_PROFILE = 0x54414f06U;
+
 /// SCIOP
 const CORBA::ULong TAO_TAG_SCIOP_PROFILE = 0x54414f0EU;
 
@@ -64,6 +64,8 @@
 
 #include "ace/OS_NS_strings.h"
 #include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_errno.h"
 #include "ace/Message_Block.h"
 #include <cstring>
 #include <memory>
@@ -91,6 +93,38 @@ ACE_FACTORY_DEFINE (TAO, TAO_ORB_Core_Static_Resources)
 
 // ****************************************************************
 
+namespace
+{
+  /// Parse the non-negative decimal @a value of the ORB option
+  /// @a name into @a result.  Anything else is logged and leaves
+  /// @a result untouched.
+  bool
+  parse_size_option (const ACE_TCHAR *name,
+                     const ACE_TCHAR *value,
+                     size_t &result)
+  {
+    ACE_TCHAR *end = nullptr;
+    errno = 0;
+    unsigned long const parsed = ACE_OS::strtoul (value, &end, 10);
+
+    // strtoul() would skip blanks and negate a leading '-'.
+    if (*value < ACE_TEXT ('0') || *value > ACE_TEXT ('9')
+        || *end != 0 || errno != 0)
+      {
+        TAOLIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("TAO (%P|%t) - ORB_Core::init, invalid ")
+                       ACE_TEXT ("value <%s> for <%s>, option ignored\n"),
+                       value, name));
+        return false;
+      }
+
+    result = parsed;
+    return true;
+  }
+}
+
+// ****************************************************************
+
 CORBA::Environment&
 TAO_default_environment ()
 {
@@ -412,6 +446,7 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
   int linger = TAO_SO_LINGER;
   time_t accept_error_delay = TAO_ACCEPT_ERROR_DELAY;
   bool use_parallel_connects = TAO_USE_PARALLEL_CONNECT;
+  bool stub_transport_affinity = TAO_STUB_TRANSPORT_AFFINITY;
 
   // Copy command line parameter not to use original.
   ACE_Argv_Type_Converter command_line (argc, argv);
@@ -737,6 +772,28 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
 
           arg_shifter.consume_arg ();
         }
+      else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBCDRReferenceThreshold"))))
+        {
+          size_t threshold = 0;
+          if (parse_size_option (ACE_TEXT ("-ORBCDRReferenceThreshold"),
+                                 current_arg,
+                                 threshold))
+            this->orb_params ()->cdr_reference_threshold (threshold);
+
+          arg_shifter.consume_arg ();
+        }
+      else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBCDRThreadCacheSize"))))
+        {
+          size_t cache_size = 0;
+          if (parse_size_option (ACE_TEXT ("-ORBCDRThreadCacheSize"),
+                                 current_arg,
+                                 cache_size))
+            this->orb_params ()->cdr_thread_cache_size (cache_size);
+
+          arg_shifter.consume_arg ();
+        }
 
       // A new <ObjectID>:<IOR> mapping has been specified. This will be
       // used by the resolve_initial_references ().
@@ -1063,6 +1120,12 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
              (ACE_OS::atoi (current_arg));
            arg_shifter.consume_arg ();
          }
+       else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                 (ACE_TEXT("-ORBStubTransportAffinity"))))
+         {
+           stub_transport_affinity = ACE_OS::atoi (current_arg);
+           arg_shifter.consume_arg ();
+         }
       else if (nullptr != (current_arg = arg_shifter.get_the_parameter
                 (ACE_TEXT("-ORBSingleReadOptimization"))))
         {
@@ -1412,6 +1475,9 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
   this->orb_params ()->use_parallel_connects
     (use_parallel_connects != 0);
 
+  this->orb_params ()->stub_transport_affinity
+    (stub_transport_affinity != 0);
+
   this->orb_params ()->linger (linger);
   this->orb_params ()->accept_error_delay (accept_error_delay);
   this->orb_params ()->nodelay (nodelay);
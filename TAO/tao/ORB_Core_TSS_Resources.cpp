@@ -1,5 +1,6 @@
 #include "tao/ORB_Core_TSS_Resources.h"
 #include "tao/ORB_Core.h"
+#include "ace/Message_Block.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -9,6 +10,7 @@ TAO_ORB_Core_TSS_Resources::TAO_ORB_Core_TSS_Resources ()
   , lane_ (nullptr)
   , ts_objects_ ()
   , upcalls_temporarily_suspended_on_this_thread_ (false)
+  , output_cdr_block_ (nullptr)
   , orb_core_ (nullptr)
 {
 }
@@ -26,6 +28,13 @@ TAO_ORB_Core_TSS_Resources::fini ()
       this->orb_core_->tss_cleanup (this->ts_objects_);
     }
   this->orb_core_ = nullptr;
+
+  // Allocated from the heap, so it can go after the ORB.
+  if (this->output_cdr_block_ != nullptr)
+    {
+      this->output_cdr_block_->release ();
+      this->output_cdr_block_ = nullptr;
+    }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
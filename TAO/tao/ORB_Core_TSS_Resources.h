@@ -23,6 +23,10 @@
 #include "tao/orbconf.h"
 #include "ace/Array_Base.h"
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Data_Block;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_ORB_Core;
@@ -80,6 +84,11 @@ public:
   // @CJC@  maybe we should use allocate_tss_slot_id() instead?
   bool upcalls_temporarily_suspended_on_this_thread_;
 
+  /// Buffer the synchronous invocations of this thread marshal their
+  /// requests in, sized after the largest request that fitted in
+  /// -ORBCDRThreadCacheSize.  See TAO::CDR_Thread_Cache_Guard.
+  ACE_Data_Block *output_cdr_block_;
+
   /// Pointer to the ORB core.  Needed to get access to the TSS
   /// cleanup functions for the TSS objects stored in the TSS object
   /// array in this class.
@@ -0,0 +1,56 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Operation_Hash.h
+ *
+ *  Hash function used for operation demultiplexing.  The same function
+ *  is used by the ORB when it looks up the operation of a request and
+ *  by the IDL compiler when it generates the operation tables of the skeletons,
+ *  so it must not depend on anything but the bytes of the operation
+ *  name.
+ */
+//=============================================================================
+
+#ifndef TAO_OPERATION_HASH_H
+#define TAO_OPERATION_HASH_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Basic_Types.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/orbconf.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * Compute the 64-bit FNV-1a hash of the first @a length characters
+   * of the operation name @a name.  Zero is never returned so callers
+   * can use it to mark a hash that has not been computed yet.
+   */
+  inline ACE_UINT64
+  operation_hash (const char *name, size_t length)
+  {
+    ACE_UINT64 hash = ACE_UINT64_LITERAL (14695981039346656037);
+
+    for (size_t i = 0; i < length; ++i)
+      {
+        hash ^= static_cast<unsigned char> (name[i]);
+        hash *= ACE_UINT64_LITERAL (1099511628211);
+      }
+
+    return hash == 0 ? 1 : hash;
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_OPERATION_HASH_H */
@@ -1,5 +1,6 @@
 #include "tao/PortableServer/Active_Object_Map.h"
 #include "tao/PortableServer/Active_Object_Map_Entry.h"
+#include "tao/PortableServer/ObjectId_Open_Hash_Map.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/PortableServer/Active_Object_Map.inl"
@@ -48,6 +49,12 @@ TAO_Active_Object_Map::set_system_id_size (
               break;
 #endif /* TAO_HAS_MINIMUM_POA_MAPS == 0 */
 
+            // The open map creates its keys with
+            // TAO_Incremental_Key_Generator, like the dynamic map.
+            case TAO_OPEN_HASH:
+              TAO_Active_Object_Map::system_id_size_ = sizeof (CORBA::ULong);
+              break;
+
             case TAO_DYNAMIC_HASH:
             default:
               TAO_Active_Object_Map::system_id_size_ = sizeof (CORBA::ULong);
@@ -56,7 +63,11 @@ TAO_Active_Object_Map::set_system_id_size (
 
           size_t hint_size = 0;
 
-          if (creation_parameters.use_active_hint_in_ids_)
+          // System id POAs keep the open map as their only map, see
+          // the constructor, so their ids carry no active hint.
+          if (creation_parameters.use_active_hint_in_ids_
+              && creation_parameters.object_lookup_strategy_for_system_id_policy_
+                   != TAO_OPEN_HASH)
             hint_size = ACE_Active_Map_Manager_Key::size ();
 
           TAO_Active_Object_Map::system_id_size_ += hint_size;
@@ -65,6 +76,12 @@ TAO_Active_Object_Map::set_system_id_size (
         {
           switch (creation_parameters.object_lookup_strategy_for_system_id_policy_)
             {
+            // The open map creates its keys with
+            // TAO_Incremental_Key_Generator, like the dynamic map.
+            case TAO_OPEN_HASH:
+              TAO_Active_Object_Map::system_id_size_ = sizeof (CORBA::ULong);
+              break;
+
 #if (TAO_HAS_MINIMUM_POA_MAPS == 0)
             case TAO_LINEAR:
               TAO_Active_Object_Map::system_id_size_ = sizeof (CORBA::ULong);
@@ -177,10 +194,20 @@ TAO_Active_Object_Map::TAO_Active_Object_Map (
   // Give ownership to the auto pointer.
   std::unique_ptr<TAO_Id_Assignment_Strategy> new_id_assignment_strategy (id_assignment_strategy);
 
+  // A system id POA using the open map looks its objects up in that
+  // map alone, even when system ids can be reactivated, instead of
+  // finding them through an active hint map and keeping a second map
+  // of user ids for the reactivated ones.
+  bool const open_system_ids =
+    !user_id_policy
+    && creation_parameters.object_lookup_strategy_for_system_id_policy_
+         == TAO_OPEN_HASH;
+
   TAO_Id_Hint_Strategy *id_hint_strategy = 0;
   if ((user_id_policy
        || creation_parameters.allow_reactivation_of_system_ids_)
-      && creation_parameters.use_active_hint_in_ids_)
+      && creation_parameters.use_active_hint_in_ids_
+      && !open_system_ids)
     {
       this->using_active_maps_ = true;
 
@@ -234,11 +261,19 @@ TAO_Active_Object_Map::TAO_Active_Object_Map (
   std::unique_ptr<servant_map> new_servant_map (sm);
 
   user_id_map *uim = 0;
-  if (user_id_policy
-      || creation_parameters.allow_reactivation_of_system_ids_)
+  if ((user_id_policy
+       || creation_parameters.allow_reactivation_of_system_ids_)
+      && !open_system_ids)
     {
       switch (creation_parameters.object_lookup_strategy_for_user_id_policy_)
         {
+        case TAO_OPEN_HASH:
+          ACE_NEW_THROW_EX (uim,
+                            TAO_ObjectId_Open_Hash_Map (
+                              creation_parameters.active_object_map_size_),
+                            CORBA::NO_MEMORY ());
+          break;
+
         case TAO_LINEAR:
 #if (TAO_HAS_MINIMUM_POA_MAPS == 0)
           ACE_NEW_THROW_EX (uim,
@@ -266,6 +301,13 @@ TAO_Active_Object_Map::TAO_Active_Object_Map (
     {
       switch (creation_parameters.object_lookup_strategy_for_system_id_policy_)
         {
+        case TAO_OPEN_HASH:
+          ACE_NEW_THROW_EX (uim,
+                            TAO_ObjectId_Open_Hash_Map (
+                              creation_parameters.active_object_map_size_),
+                            CORBA::NO_MEMORY ());
+          break;
+
 #if (TAO_HAS_MINIMUM_POA_MAPS == 0)
         case TAO_LINEAR:
           ACE_NEW_THROW_EX (uim,
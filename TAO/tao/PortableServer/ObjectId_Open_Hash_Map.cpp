@@ -0,0 +1,565 @@
+// -*- C++ -*-
+#include "tao/PortableServer/ObjectId_Open_Hash_Map.h"
+#include "tao/debug.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_Memory.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+CORBA::Octet *
+TAO_ObjectId_Open_Hash_Map::Slot::key_buffer ()
+{
+  return this->length_ <= TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY
+    ? this->key_.inline_
+    : this->key_.external_;
+}
+
+TAO_ObjectId_Open_Hash_Map::TAO_ObjectId_Open_Hash_Map (size_t size)
+  : slots_ (0),
+    capacity_ (0),
+    size_ (0)
+{
+  if (this->open (size) == -1)
+    TAOLIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("TAO_ObjectId_Open_Hash_Map\n")));
+}
+
+TAO_ObjectId_Open_Hash_Map::~TAO_ObjectId_Open_Hash_Map ()
+{
+  this->close ();
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::open (size_t length, ACE_Allocator *)
+{
+  this->close ();
+
+  // Keep the load factor under 3/4 without growing.
+  size_t capacity = 16;
+  while (capacity - capacity / 4 < length)
+    capacity *= 2;
+
+  return this->allocate (capacity);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::close ()
+{
+  if (this->slots_ != 0)
+    {
+      for (size_t i = 0; i != this->capacity_; ++i)
+        {
+          if (this->slots_[i].hash_ != 0
+              && this->slots_[i].length_ > TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY)
+            delete [] this->slots_[i].key_.external_;
+        }
+
+      delete [] this->slots_;
+      this->slots_ = 0;
+    }
+
+  this->capacity_ = 0;
+  this->size_ = 0;
+  return 0;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::allocate (size_t capacity)
+{
+  ACE_NEW_RETURN (this->slots_,
+                  Slot[capacity],
+                  -1);
+
+  ACE_OS::memset (this->slots_, 0, capacity * sizeof (Slot));
+  this->capacity_ = capacity;
+  this->size_ = 0;
+  return 0;
+}
+
+ACE_UINT32
+TAO_ObjectId_Open_Hash_Map::hash (const KEY &key)
+{
+  // FNV-1a, cheap for the short ids the POA generates and good
+  // enough for linear probing on the ones users pick.
+  CORBA::Octet const * const buffer = key.get_buffer ();
+  CORBA::ULong const length = key.length ();
+  ACE_UINT32 h = 2166136261U;
+
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      h ^= buffer[i];
+      h *= 16777619U;
+    }
+
+  return h == 0 ? 1 : h;
+}
+
+size_t
+TAO_ObjectId_Open_Hash_Map::lookup (const KEY &key, ACE_UINT32 hash) const
+{
+  size_t const mask = this->capacity_ - 1;
+  CORBA::ULong const length = key.length ();
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+      Slot &slot = this->slots_[i];
+
+      if (slot.hash_ == 0)
+        return i;
+
+      if (slot.hash_ == hash
+          && slot.length_ == length
+          && ACE_OS::memcmp (slot.key_buffer (),
+                             key.get_buffer (),
+                             length) == 0)
+        return i;
+    }
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::fill (size_t index,
+                                  const KEY &key,
+                                  ACE_UINT32 hash,
+                                  const VALUE &value)
+{
+  Slot &slot = this->slots_[index];
+  CORBA::ULong const length = key.length ();
+
+  if (length > TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY)
+    {
+      ACE_NEW_RETURN (slot.key_.external_,
+                      CORBA::Octet[length],
+                      -1);
+    }
+
+  slot.length_ = length;
+  ACE_OS::memcpy (slot.key_buffer (), key.get_buffer (), length);
+  slot.value_ = value;
+  slot.hash_ = hash;
+  ++this->size_;
+  return 0;
+}
+
+void
+TAO_ObjectId_Open_Hash_Map::erase (size_t index)
+{
+  size_t const mask = this->capacity_ - 1;
+
+  if (this->slots_[index].length_ > TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY)
+    delete [] this->slots_[index].key_.external_;
+
+  // Move back every entry of the cluster that would no longer be
+  // reachable from its home slot once @a index is empty.
+  size_t hole = index;
+  for (size_t i = (index + 1) & mask;
+       this->slots_[i].hash_ != 0;
+       i = (i + 1) & mask)
+    {
+      size_t const home = this->slots_[i].hash_ & mask;
+
+      if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+          this->slots_[hole] = this->slots_[i];
+          hole = i;
+        }
+    }
+
+  this->slots_[hole].hash_ = 0;
+  --this->size_;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::grow ()
+{
+  if (this->size_ + 1 <= this->capacity_ - this->capacity_ / 4)
+    return 0;
+
+  Slot * const old_slots = this->slots_;
+  size_t const old_capacity = this->capacity_;
+
+  if (this->allocate (old_capacity * 2) == -1)
+    {
+      this->slots_ = old_slots;
+      return -1;
+    }
+
+  size_t const mask = this->capacity_ - 1;
+
+  // The cached hashes and the keys move along with the slots, nothing
+  // is hashed or copied again.
+  for (size_t i = 0; i != old_capacity; ++i)
+    {
+      if (old_slots[i].hash_ == 0)
+        continue;
+
+      size_t j = old_slots[i].hash_ & mask;
+      while (this->slots_[j].hash_ != 0)
+        j = (j + 1) & mask;
+
+      this->slots_[j] = old_slots[i];
+      ++this->size_;
+    }
+
+  delete [] old_slots;
+  return 0;
+}
+
+size_t
+TAO_ObjectId_Open_Hash_Map::next_full (size_t index) const
+{
+  while (index < this->capacity_ && this->slots_[index].hash_ == 0)
+    ++index;
+
+  return index;
+}
+
+size_t
+TAO_ObjectId_Open_Hash_Map::previous_full (size_t index) const
+{
+  while (index > 0 && this->slots_[index - 1].hash_ == 0)
+    --index;
+
+  return index;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::bind (const KEY &key, const VALUE &value)
+{
+  if (this->grow () == -1)
+    return -1;
+
+  ACE_UINT32 const h = TAO_ObjectId_Open_Hash_Map::hash (key);
+  size_t const index = this->lookup (key, h);
+
+  if (this->slots_[index].hash_ != 0)
+    return 1;
+
+  return this->fill (index, key, h, value);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::bind_modify_key (const VALUE &value, KEY &key)
+{
+  return this->bind (key, value);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::create_key (KEY &key)
+{
+  return this->key_generator_ (key);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::bind_create_key (const VALUE &value, KEY &key)
+{
+  int result = this->key_generator_ (key);
+
+  if (result == 0)
+    result = this->bind (key, value);
+
+  return result;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::bind_create_key (const VALUE &value)
+{
+  KEY key;
+  return this->bind_create_key (value, key);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::recover_key (const KEY &modified_key,
+                                         KEY &original_key)
+{
+  original_key = modified_key;
+  return 0;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::rebind (const KEY &key, const VALUE &value)
+{
+  VALUE old_value;
+  return this->rebind (key, value, old_value);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::rebind (const KEY &key,
+                                    const VALUE &value,
+                                    VALUE &old_value)
+{
+  if (this->grow () == -1)
+    return -1;
+
+  ACE_UINT32 const h = TAO_ObjectId_Open_Hash_Map::hash (key);
+  size_t const index = this->lookup (key, h);
+  Slot &slot = this->slots_[index];
+
+  if (slot.hash_ != 0)
+    {
+      old_value = slot.value_;
+      slot.value_ = value;
+      return 1;
+    }
+
+  return this->fill (index, key, h, value);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::rebind (const KEY &key,
+                                    const VALUE &value,
+                                    KEY &old_key,
+                                    VALUE &old_value)
+{
+  int const result = this->rebind (key, value, old_value);
+
+  if (result == 1)
+    old_key = key;
+
+  return result;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::trybind (const KEY &key, VALUE &value)
+{
+  if (this->grow () == -1)
+    return -1;
+
+  ACE_UINT32 const h = TAO_ObjectId_Open_Hash_Map::hash (key);
+  size_t const index = this->lookup (key, h);
+
+  if (this->slots_[index].hash_ != 0)
+    {
+      value = this->slots_[index].value_;
+      return 1;
+    }
+
+  return this->fill (index, key, h, value);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::find (const KEY &key, VALUE &value)
+{
+  size_t const index =
+    this->lookup (key, TAO_ObjectId_Open_Hash_Map::hash (key));
+
+  if (this->slots_[index].hash_ == 0)
+    return -1;
+
+  value = this->slots_[index].value_;
+  return 0;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::find (const KEY &key)
+{
+  size_t const index =
+    this->lookup (key, TAO_ObjectId_Open_Hash_Map::hash (key));
+
+  return this->slots_[index].hash_ == 0 ? -1 : 0;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::unbind (const KEY &key)
+{
+  VALUE value;
+  return this->unbind (key, value);
+}
+
+int
+TAO_ObjectId_Open_Hash_Map::unbind (const KEY &key, VALUE &value)
+{
+  size_t const index =
+    this->lookup (key, TAO_ObjectId_Open_Hash_Map::hash (key));
+
+  if (this->slots_[index].hash_ == 0)
+    return -1;
+
+  value = this->slots_[index].value_;
+  this->erase (index);
+  return 0;
+}
+
+size_t
+TAO_ObjectId_Open_Hash_Map::current_size () const
+{
+  return this->size_;
+}
+
+size_t
+TAO_ObjectId_Open_Hash_Map::total_size () const
+{
+  return this->capacity_;
+}
+
+void
+TAO_ObjectId_Open_Hash_Map::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  TAOLIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("TAO_ObjectId_Open_Hash_Map: size = %B, ")
+                 ACE_TEXT ("capacity = %B\n"),
+                 this->size_,
+                 this->capacity_));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_Iterator_Impl<TAO_ObjectId_Open_Hash_Map::value_type> *
+TAO_ObjectId_Open_Hash_Map::begin_impl ()
+{
+  ACE_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_ObjectId_Open_Hash_Map_Iterator (*this,
+                                                       this->next_full (0)),
+                  0);
+  return temp;
+}
+
+ACE_Iterator_Impl<TAO_ObjectId_Open_Hash_Map::value_type> *
+TAO_ObjectId_Open_Hash_Map::end_impl ()
+{
+  ACE_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_ObjectId_Open_Hash_Map_Iterator (*this,
+                                                       this->capacity_),
+                  0);
+  return temp;
+}
+
+ACE_Reverse_Iterator_Impl<TAO_ObjectId_Open_Hash_Map::value_type> *
+TAO_ObjectId_Open_Hash_Map::rbegin_impl ()
+{
+  ACE_Reverse_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_ObjectId_Open_Hash_Map_Reverse_Iterator (
+                    *this,
+                    this->previous_full (this->capacity_)),
+                  0);
+  return temp;
+}
+
+ACE_Reverse_Iterator_Impl<TAO_ObjectId_Open_Hash_Map::value_type> *
+TAO_ObjectId_Open_Hash_Map::rend_impl ()
+{
+  ACE_Reverse_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_ObjectId_Open_Hash_Map_Reverse_Iterator (*this, 0),
+                  0);
+  return temp;
+}
+
+// ****************************************************************
+
+TAO_ObjectId_Open_Hash_Map_Iterator::TAO_ObjectId_Open_Hash_Map_Iterator (
+  TAO_ObjectId_Open_Hash_Map &map,
+  size_t index)
+  : map_ (map),
+    index_ (index)
+{
+}
+
+ACE_Iterator_Impl<TAO_ObjectId_Open_Hash_Map_Iterator::value_type> *
+TAO_ObjectId_Open_Hash_Map_Iterator::clone () const
+{
+  ACE_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_ObjectId_Open_Hash_Map_Iterator (this->map_,
+                                                       this->index_),
+                  0);
+  return temp;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map_Iterator::compare (
+  const ACE_Iterator_Impl<value_type> &rhs) const
+{
+  TAO_ObjectId_Open_Hash_Map_Iterator const &rhs_local =
+    dynamic_cast<TAO_ObjectId_Open_Hash_Map_Iterator const &> (rhs);
+
+  return &this->map_ == &rhs_local.map_ && this->index_ == rhs_local.index_;
+}
+
+TAO_ObjectId_Open_Hash_Map_Iterator::value_type
+TAO_ObjectId_Open_Hash_Map_Iterator::dereference () const
+{
+  TAO_ObjectId_Open_Hash_Map::Slot &slot = this->map_.slots_[this->index_];
+
+  this->key_.replace (slot.length_, slot.length_, slot.key_buffer (), false);
+
+  return value_type (this->key_, slot.value_);
+}
+
+void
+TAO_ObjectId_Open_Hash_Map_Iterator::plus_plus ()
+{
+  this->index_ = this->map_.next_full (this->index_ + 1);
+}
+
+void
+TAO_ObjectId_Open_Hash_Map_Iterator::minus_minus ()
+{
+  size_t const previous = this->map_.previous_full (this->index_);
+
+  if (previous > 0)
+    this->index_ = previous - 1;
+}
+
+// ****************************************************************
+
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::TAO_ObjectId_Open_Hash_Map_Reverse_Iterator (
+  TAO_ObjectId_Open_Hash_Map &map,
+  size_t index)
+  : map_ (map),
+    index_ (index)
+{
+}
+
+ACE_Reverse_Iterator_Impl<TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::value_type> *
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::clone () const
+{
+  ACE_Reverse_Iterator_Impl<value_type> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  TAO_ObjectId_Open_Hash_Map_Reverse_Iterator (this->map_,
+                                                               this->index_),
+                  0);
+  return temp;
+}
+
+int
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::compare (
+  const ACE_Reverse_Iterator_Impl<value_type> &rhs) const
+{
+  TAO_ObjectId_Open_Hash_Map_Reverse_Iterator const &rhs_local =
+    dynamic_cast<TAO_ObjectId_Open_Hash_Map_Reverse_Iterator const &> (rhs);
+
+  return &this->map_ == &rhs_local.map_ && this->index_ == rhs_local.index_;
+}
+
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::value_type
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::dereference () const
+{
+  TAO_ObjectId_Open_Hash_Map::Slot &slot =
+    this->map_.slots_[this->index_ - 1];
+
+  this->key_.replace (slot.length_, slot.length_, slot.key_buffer (), false);
+
+  return value_type (this->key_, slot.value_);
+}
+
+void
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::plus_plus ()
+{
+  if (this->index_ > 0)
+    this->index_ = this->map_.previous_full (this->index_ - 1);
+}
+
+void
+TAO_ObjectId_Open_Hash_Map_Reverse_Iterator::minus_minus ()
+{
+  size_t const next = this->map_.next_full (this->index_);
+
+  if (next < this->map_.capacity_)
+    this->index_ = next + 1;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,256 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    ObjectId_Open_Hash_Map.h
+ *
+ *  Open addressing map of object ids, used by the Active Object Map
+ *  when -ORBUseridPolicyDemuxStrategy or -ORBSystemidPolicyDemuxStrategy
+ *  is set to open.
+ */
+//=============================================================================
+
+#ifndef TAO_OBJECTID_OPEN_HASH_MAP_H
+#define TAO_OBJECTID_OPEN_HASH_MAP_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/PortableServer/Key_Adapters.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/PortableServer/PS_ForwardC.h"
+#include "ace/Map_T.h"
+
+/// Object ids up to this many octets are stored in the slots of the
+/// map, longer ones are allocated separately.
+#if !defined (TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY)
+# define TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY 16
+#endif /* TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+struct TAO_Active_Object_Map_Entry;
+class TAO_ObjectId_Open_Hash_Map_Iterator;
+class TAO_ObjectId_Open_Hash_Map_Reverse_Iterator;
+
+/**
+ * @class TAO_ObjectId_Open_Hash_Map
+ *
+ * @brief Map of object ids to active object map entries using open
+ * addressing.
+ *
+ * All the entries live in a single array of slots that is probed
+ * linearly.  Each slot caches the hash of its key and holds short
+ * keys inline, so a lookup usually touches a single cache line and
+ * binding an object does not allocate.  Removal shifts the following
+ * entries back instead of leaving tombstones, so lookups never modify
+ * the map.  The map is not synchronized: the POA serializes lookups
+ * with every other use of the active object map.
+ *
+ * Keys created by the map use TAO_Incremental_Key_Generator, as the
+ * dynamic hash map does.
+ */
+class TAO_ObjectId_Open_Hash_Map
+  : public ACE_Map<PortableServer::ObjectId, TAO_Active_Object_Map_Entry *>
+{
+public:
+  friend class TAO_ObjectId_Open_Hash_Map_Iterator;
+  friend class TAO_ObjectId_Open_Hash_Map_Reverse_Iterator;
+
+  typedef PortableServer::ObjectId KEY;
+  typedef TAO_Active_Object_Map_Entry *VALUE;
+
+  /// Initialize the map to hold @a size entries without growing.
+  TAO_ObjectId_Open_Hash_Map (size_t size = ACE_DEFAULT_MAP_SIZE);
+
+  /// Release the slots and the keys that do not fit in them.
+  virtual ~TAO_ObjectId_Open_Hash_Map ();
+
+  virtual int open (size_t length = ACE_DEFAULT_MAP_SIZE,
+                    ACE_Allocator *alloc = 0);
+
+  virtual int close ();
+
+  virtual int bind (const KEY &key, const VALUE &value);
+
+  virtual int bind_modify_key (const VALUE &value, KEY &key);
+
+  virtual int create_key (KEY &key);
+
+  virtual int bind_create_key (const VALUE &value, KEY &key);
+
+  virtual int bind_create_key (const VALUE &value);
+
+  virtual int recover_key (const KEY &modified_key, KEY &original_key);
+
+  virtual int rebind (const KEY &key, const VALUE &value);
+
+  virtual int rebind (const KEY &key, const VALUE &value, VALUE &old_value);
+
+  virtual int rebind (const KEY &key,
+                      const VALUE &value,
+                      KEY &old_key,
+                      VALUE &old_value);
+
+  virtual int trybind (const KEY &key, VALUE &value);
+
+  virtual int find (const KEY &key, VALUE &value);
+
+  virtual int find (const KEY &key);
+
+  virtual int unbind (const KEY &key);
+
+  virtual int unbind (const KEY &key, VALUE &value);
+
+  virtual size_t current_size () const;
+
+  virtual size_t total_size () const;
+
+  virtual void dump () const;
+
+private:
+  /// A slot of the map, empty when @c hash_ is zero.
+  struct Slot
+  {
+    ACE_UINT32 hash_;
+    CORBA::ULong length_;
+    union
+    {
+      CORBA::Octet inline_[TAO_OBJECTID_OPEN_HASH_MAP_INLINE_KEY];
+      CORBA::Octet *external_;
+    } key_;
+    VALUE value_;
+
+    /// Where the key of this slot is stored.
+    CORBA::Octet *key_buffer ();
+  };
+
+  virtual ACE_Iterator_Impl<value_type> *begin_impl ();
+  virtual ACE_Iterator_Impl<value_type> *end_impl ();
+
+  virtual ACE_Reverse_Iterator_Impl<value_type> *rbegin_impl ();
+  virtual ACE_Reverse_Iterator_Impl<value_type> *rend_impl ();
+
+  /// Hash of @a key, never zero.
+  static ACE_UINT32 hash (const KEY &key);
+
+  /// Index of the slot holding @a key, or of the empty slot where it
+  /// would be inserted.
+  size_t lookup (const KEY &key, ACE_UINT32 hash) const;
+
+  /// Store @a key in the empty slot @a index.
+  int fill (size_t index, const KEY &key, ACE_UINT32 hash, const VALUE &value);
+
+  /// Free the key of @a index and shift back the entries that follow
+  /// it in its probe sequence.
+  void erase (size_t index);
+
+  /// Double the number of slots if the map is too full to take
+  /// another entry.
+  int grow ();
+
+  /// Allocate @a capacity empty slots.
+  int allocate (size_t capacity);
+
+  /// Index of the first full slot at or after @a index, or
+  /// @c capacity_.
+  size_t next_full (size_t index) const;
+
+  /// One past the last full slot before @a index, or zero.
+  size_t previous_full (size_t index) const;
+
+  /// Slots, @c capacity_ of them.
+  Slot *slots_;
+
+  /// Number of slots, always a power of two.
+  size_t capacity_;
+
+  /// Number of full slots.
+  size_t size_;
+
+  /// Generates the keys for bind_create_key().
+  TAO_Incremental_Key_Generator key_generator_;
+};
+
+/**
+ * @class TAO_ObjectId_Open_Hash_Map_Iterator
+ *
+ * @brief Forward iterator over a TAO_ObjectId_Open_Hash_Map.
+ *
+ * The object id returned by dereference() refers to the slot and is
+ * valid until the iterator moves.
+ */
+class TAO_ObjectId_Open_Hash_Map_Iterator
+  : public ACE_Iterator_Impl<TAO_ObjectId_Open_Hash_Map::value_type>
+{
+public:
+  typedef TAO_ObjectId_Open_Hash_Map::value_type value_type;
+
+  TAO_ObjectId_Open_Hash_Map_Iterator (TAO_ObjectId_Open_Hash_Map &map,
+                                       size_t index);
+
+  virtual ACE_Iterator_Impl<value_type> *clone () const;
+
+  virtual int compare (const ACE_Iterator_Impl<value_type> &rhs) const;
+
+  virtual value_type dereference () const;
+
+  virtual void plus_plus ();
+
+  virtual void minus_minus ();
+
+private:
+  TAO_ObjectId_Open_Hash_Map &map_;
+
+  size_t index_;
+
+  /// Object id referring to the key of the current slot.
+  mutable PortableServer::ObjectId key_;
+};
+
+/**
+ * @class TAO_ObjectId_Open_Hash_Map_Reverse_Iterator
+ *
+ * @brief Reverse iterator over a TAO_ObjectId_Open_Hash_Map.
+ *
+ * The slot index is kept one past the current slot, so that rend()
+ * is index zero.
+ */
+class TAO_ObjectId_Open_Hash_Map_Reverse_Iterator
+  : public ACE_Reverse_Iterator_Impl<TAO_ObjectId_Open_Hash_Map::value_type>
+{
+public:
+  typedef TAO_ObjectId_Open_Hash_Map::value_type value_type;
+
+  TAO_ObjectId_Open_Hash_Map_Reverse_Iterator (
+    TAO_ObjectId_Open_Hash_Map &map,
+    size_t index);
+
+  virtual ACE_Reverse_Iterator_Impl<value_type> *clone () const;
+
+  virtual int compare (
+    const ACE_Reverse_Iterator_Impl<value_type> &rhs) const;
+
+  virtual value_type dereference () const;
+
+  virtual void plus_plus ();
+
+  virtual void minus_minus ();
+
+private:
+  TAO_ObjectId_Open_Hash_Map &map_;
+
+  size_t index_;
+
+  /// Object id referring to the key of the current slot.
+  mutable PortableServer::ObjectId key_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_OBJECTID_OPEN_HASH_MAP_H */
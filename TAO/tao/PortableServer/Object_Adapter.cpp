@@ -140,6 +140,7 @@ TAO_Object_Adapter::TAO_Object_Adapter (const TAO_Server_Strategy_Factory::Activ
     servant_dispatcher_ (0),
     persistent_poa_name_map_ (0),
     transient_poa_map_ (0),
+    object_key_cache_ (creation_parameters.object_key_cache_size_),
     orb_core_ (orb_core),
     thread_lock_ (),
     lock_ (TAO_Object_Adapter::create_lock (thread_lock_)),
@@ -492,6 +493,8 @@ TAO_Object_Adapter::unbind_poa (TAO_Root_POA *poa,
                                 const poa_name &folded_name,
                                 const poa_name &system_name)
 {
+  this->object_key_cache_.invalidate ();
+
   if (poa->persistent ())
     return this->unbind_persistent_poa (folded_name, system_name);
   else
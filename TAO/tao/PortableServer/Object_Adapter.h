@@ -25,6 +25,7 @@
 #include "tao/PortableServer/Default_Policy_Validator.h"
 #include "tao/PortableServer/POA_Policy_Set.h"
 #include "tao/PortableServer/POAManagerC.h"
+#include "tao/PortableServer/Object_Key_Cache.h"
 
 #include "tao/Adapter.h"
 #include "tao/Adapter_Factory.h"
@@ -131,6 +132,11 @@ public:
   /// Non-exception throwing version.
   void wait_for_non_servant_upcalls_to_complete_no_throw ();
 
+  /// Forget the servants cached for the object keys of recent
+  /// requests.  Must be called with the lock held whenever an object
+  /// is deactivated.
+  void invalidate_object_key_cache ();
+
   static CORBA::ULong transient_poa_name_size ();
 
   /// Return the validator.
@@ -365,6 +371,10 @@ protected:
   /// Transient POA map
   transient_poa_map *transient_poa_map_;
 
+  /// POA and servant of the objects called recently, see
+  /// -ORBObjectKeyCacheSize.
+  TAO_Object_Key_Cache object_key_cache_;
+
 protected:
 
   static CORBA::ULong transient_poa_name_size_;
@@ -34,6 +34,12 @@ TAO_Object_Adapter::reverse_lock (void)
   return this->reverse_lock_;
 }
 
+ACE_INLINE void
+TAO_Object_Adapter::invalidate_object_key_cache ()
+{
+  this->object_key_cache_.invalidate ();
+}
+
 /* static */
 ACE_INLINE CORBA::ULong
 TAO_Object_Adapter::transient_poa_name_size ()
@@ -0,0 +1,142 @@
+// -*- C++ -*-
+#include "tao/PortableServer/Object_Key_Cache.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Object_Key_Cache::Slot::Slot ()
+  : generation_ (0),
+    last_used_ (0),
+    hash_ (0),
+    poa_ (0),
+    entry_ (0),
+    system_id_offset_ (0)
+{
+}
+
+TAO_Object_Key_Cache::TAO_Object_Key_Cache (CORBA::ULong size)
+  : slots_ (0),
+    sets_ (0),
+    generation_ (1),
+    clock_ (0)
+{
+  if (size == 0)
+    return;
+
+  CORBA::ULong sets = 1;
+  while (sets * TAO_Object_Key_Cache::ways < size)
+    sets *= 2;
+
+  ACE_NEW (this->slots_,
+           Slot[sets * TAO_Object_Key_Cache::ways]);
+
+  this->sets_ = sets;
+}
+
+TAO_Object_Key_Cache::~TAO_Object_Key_Cache ()
+{
+  delete [] this->slots_;
+}
+
+ACE_UINT32
+TAO_Object_Key_Cache::hash (const TAO::ObjectKey &key)
+{
+  // FNV-1a, the sets are picked with the low bits of the hash so
+  // they must depend on every octet of the key.
+  CORBA::Octet const * const buffer = key.get_buffer ();
+  CORBA::ULong const length = key.length ();
+  ACE_UINT32 h = 2166136261U;
+
+  for (CORBA::ULong i = 0; i != length; ++i)
+    {
+      h ^= buffer[i];
+      h *= 16777619U;
+    }
+
+  return h;
+}
+
+TAO_Object_Key_Cache::Slot *
+TAO_Object_Key_Cache::set (ACE_UINT32 hash) const
+{
+  return this->slots_ + (hash & (this->sets_ - 1)) * TAO_Object_Key_Cache::ways;
+}
+
+bool
+TAO_Object_Key_Cache::find (const TAO::ObjectKey &key,
+                            TAO_Root_POA *&poa,
+                            TAO_Active_Object_Map_Entry *&entry,
+                            CORBA::ULong &system_id_offset)
+{
+  if (this->sets_ == 0)
+    return false;
+
+  ACE_UINT32 const h = TAO_Object_Key_Cache::hash (key);
+  Slot * const set = this->set (h);
+
+  for (CORBA::ULong i = 0; i != TAO_Object_Key_Cache::ways; ++i)
+    {
+      Slot &slot = set[i];
+
+      if (slot.generation_ == this->generation_
+          && slot.hash_ == h
+          && slot.key_.length () == key.length ()
+          && ACE_OS::memcmp (slot.key_.get_buffer (),
+                             key.get_buffer (),
+                             key.length ()) == 0)
+        {
+          slot.last_used_ = ++this->clock_;
+          poa = slot.poa_;
+          entry = slot.entry_;
+          system_id_offset = slot.system_id_offset_;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+void
+TAO_Object_Key_Cache::insert (const TAO::ObjectKey &key,
+                              TAO_Root_POA *poa,
+                              TAO_Active_Object_Map_Entry *entry,
+                              CORBA::ULong system_id_offset)
+{
+  if (this->sets_ == 0)
+    return;
+
+  ACE_UINT32 const h = TAO_Object_Key_Cache::hash (key);
+  Slot * const set = this->set (h);
+
+  // Use an empty slot if there is one, the least recently used one
+  // otherwise.
+  Slot *victim = set;
+  for (CORBA::ULong i = 0; i != TAO_Object_Key_Cache::ways; ++i)
+    {
+      if (set[i].generation_ != this->generation_)
+        {
+          victim = set + i;
+          break;
+        }
+
+      if (set[i].last_used_ < victim->last_used_)
+        victim = set + i;
+    }
+
+  victim->key_ = key;
+  victim->generation_ = this->generation_;
+  victim->last_used_ = ++this->clock_;
+  victim->hash_ = h;
+  victim->poa_ = poa;
+  victim->entry_ = entry;
+  victim->system_id_offset_ = system_id_offset;
+}
+
+void
+TAO_Object_Key_Cache::invalidate ()
+{
+  ++this->generation_;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,122 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Object_Key_Cache.h
+ *
+ *  Cache of the servants of recently called objects, indexed on
+ *  their object key.
+ */
+//=============================================================================
+
+#ifndef TAO_OBJECT_KEY_CACHE_H
+#define TAO_OBJECT_KEY_CACHE_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/PortableServer/portableserver_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Object_KeyC.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Root_POA;
+struct TAO_Active_Object_Map_Entry;
+
+/**
+ * @class TAO_Object_Key_Cache
+ *
+ * @brief Maps the object keys of recently called objects to their
+ * POA and active object map entry.
+ *
+ * A hit lets the object adapter skip parsing the key, the walk
+ * through the POA maps and the active object map lookup.  The cache
+ * is set associative, each object key can only be stored in one of
+ * a few slots, and the least recently used of those is replaced.
+ *
+ * Entries are never updated.  Instead the object adapter calls
+ * invalidate() whenever an object is deactivated or a POA destroyed,
+ * which drops every entry at once by bumping the generation of the
+ * cache.  The cache does no locking of its own, it is only used with
+ * the object adapter lock held.
+ */
+class TAO_PortableServer_Export TAO_Object_Key_Cache
+{
+public:
+  /// Cache up to @a size object keys, a @a size of zero disables the
+  /// cache.
+  explicit TAO_Object_Key_Cache (CORBA::ULong size);
+
+  ~TAO_Object_Key_Cache ();
+
+  TAO_Object_Key_Cache (const TAO_Object_Key_Cache &) = delete;
+  TAO_Object_Key_Cache &operator= (const TAO_Object_Key_Cache &) = delete;
+
+  /// Find the POA and active object map entry of @a key, and where
+  /// the system id starts in the key.  Return false if @a key is not
+  /// in the cache.
+  bool find (const TAO::ObjectKey &key,
+             TAO_Root_POA *&poa,
+             TAO_Active_Object_Map_Entry *&entry,
+             CORBA::ULong &system_id_offset);
+
+  /// Add @a key, replacing the least recently used key it competes
+  /// with for a slot.
+  void insert (const TAO::ObjectKey &key,
+               TAO_Root_POA *poa,
+               TAO_Active_Object_Map_Entry *entry,
+               CORBA::ULong system_id_offset);
+
+  /// Drop all the entries.
+  void invalidate ();
+
+private:
+  /// Number of slots an object key can be stored in.
+  static const CORBA::ULong ways = 4;
+
+  struct Slot
+  {
+    Slot ();
+
+    /// Generation of the cache when this slot was filled, zero for a
+    /// slot that was never used.
+    ACE_UINT64 generation_;
+
+    /// Value of @c clock_ when this slot was last hit.
+    ACE_UINT64 last_used_;
+
+    ACE_UINT32 hash_;
+    TAO::ObjectKey key_;
+    TAO_Root_POA *poa_;
+    TAO_Active_Object_Map_Entry *entry_;
+    CORBA::ULong system_id_offset_;
+  };
+
+  /// First slot of the set @a key is stored in.
+  Slot *set (ACE_UINT32 hash) const;
+
+  static ACE_UINT32 hash (const TAO::ObjectKey &key);
+
+  /// The slots, @c ways per set.
+  Slot *slots_;
+
+  /// Number of sets, a power of two, or zero if the cache is
+  /// disabled.
+  CORBA::ULong sets_;
+
+  /// Slots filled in an older generation are empty.
+  ACE_UINT64 generation_;
+
+  /// Incremented on every hit, for the LRU replacement.
+  ACE_UINT64 clock_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_OBJECT_KEY_CACHE_H */
@@ -8,6 +8,15 @@ TAO_Operation_Table::~TAO_Operation_Table ()
 {
 }
 
+int
+TAO_Operation_Table::find_by_hash (const char *opname,
+                                   const TAO_ServerRequest &,
+                                   TAO_Skeleton &skelfunc,
+                                   const unsigned int length)
+{
+  return this->find (opname, skelfunc, length);
+}
+
 /**************************************************************/
 TAO::Operation_Skeletons::Operation_Skeletons ()
   : skel_ptr (0)
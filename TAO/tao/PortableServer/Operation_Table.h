@@ -118,6 +118,17 @@ public:
                     TAO::Collocation_Strategy s,
                     const unsigned int length = 0) = 0;
 
+  /**
+   * Same as find() for @a opname, the operation of @a request.
+   * Strategies keyed on the hash of the operation name get it from
+   * TAO_ServerRequest::operation_hash(), which computes it on first
+   * use.  The others fall back to find() and never compute it.
+   */
+  virtual int find_by_hash (const char *opname,
+                            const TAO_ServerRequest &request,
+                            TAO_Skeleton &skelfunc,
+                            const unsigned int length = 0);
+
   /// Associate the skeleton @a skel_ptr with an operation named
   /// @a opname.  Returns -1 on failure, 0 on success, 1 on duplicate.
   virtual int bind (const char *opname,
@@ -0,0 +1,171 @@
+// -*- C++ -*-
+#include "tao/PortableServer/Operation_Table_Operation_Hash.h"
+#include "tao/Operation_Hash.h"
+#include "tao/TAO_Server_Request.h"
+#include "tao/Timeprobe.h"
+#include "ace/OS_NS_string.h"
+
+#if defined (ACE_ENABLE_TIMEPROBES)
+
+static const char *TAO_Operation_Table_Timeprobe_Description[] =
+  {
+    "TAO_Operation_Hash_OpTable::find - start",
+    "TAO_Operation_Hash_OpTable::find - end"
+  };
+
+enum
+  {
+    // Timeprobe description table start key
+    TAO_OPERATION_HASH_OPTABLE_FIND_START = 610,
+    TAO_OPERATION_HASH_OPTABLE_FIND_END
+  };
+
+// Setup Timeprobes
+ACE_TIMEPROBE_EVENT_DESCRIPTIONS (TAO_Operation_Table_Timeprobe_Description,
+                                  TAO_OPERATION_HASH_OPTABLE_FIND_START);
+
+#endif /* ACE_ENABLE_TIMEPROBES */
+
+namespace
+{
+  /// Tables up to this size are scanned linearly, a handful of
+  /// sequential compares beats the unpredictable branches of a
+  /// binary search.
+  CORBA::ULong const TAO_OPERATION_HASH_LINEAR_LIMIT = 8;
+}
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Operation_Hash_OpTable::TAO_Operation_Hash_OpTable (
+  TAO_operation_db_entry const * db,
+  TAO_operation_hash_entry const * hashes,
+  CORBA::ULong dbsize)
+  : db_ (db)
+  , hashes_ (hashes)
+  , dbsize_ (dbsize)
+{
+}
+
+TAO_Operation_Hash_OpTable::~TAO_Operation_Hash_OpTable ()
+{
+}
+
+const TAO_operation_db_entry *
+TAO_Operation_Hash_OpTable::lookup (const char *opname,
+                                    ACE_UINT64 hash) const
+{
+  CORBA::ULong i = 0;
+
+  if (this->dbsize_ <= TAO_OPERATION_HASH_LINEAR_LIMIT)
+    {
+      while (i < this->dbsize_ && this->hashes_[i].hash < hash)
+        ++i;
+    }
+  else
+    {
+      CORBA::ULong hi = this->dbsize_;
+
+      while (i < hi)
+        {
+          CORBA::ULong const mid = i + (hi - i) / 2;
+
+          if (this->hashes_[mid].hash < hash)
+            i = mid + 1;
+          else
+            hi = mid;
+        }
+    }
+
+  // The string compare rejects names that are not in the table but
+  // happen to hash to the same value as one that is.  The IDL
+  // compiler warns about collisions within an interface, should one
+  // ever occur all the colliding entries are tried.
+  for (; i < this->dbsize_ && this->hashes_[i].hash == hash; ++i)
+    {
+      TAO_operation_db_entry const * const entry =
+        &this->db_[this->hashes_[i].index];
+
+      if (ACE_OS::strcmp (entry->opname, opname) == 0)
+        return entry;
+    }
+
+  return 0;
+}
+
+int
+TAO_Operation_Hash_OpTable::find (const char *opname,
+                                  TAO_Skeleton &skelfunc,
+                                  const unsigned int length)
+{
+  ACE_FUNCTION_TIMEPROBE (TAO_OPERATION_HASH_OPTABLE_FIND_START);
+
+  TAO_operation_db_entry const * const entry =
+    this->lookup (opname,
+                  TAO::operation_hash (
+                    opname,
+                    length == 0 ? ACE_OS::strlen (opname) : length));
+
+  if (entry == 0)
+    return -1;
+
+  skelfunc = entry->skel_ptr;
+
+  return 0;
+}
+
+int
+TAO_Operation_Hash_OpTable::find (const char *opname,
+                                  TAO_Collocated_Skeleton &skelfunc,
+                                  TAO::Collocation_Strategy st,
+                                  const unsigned int length)
+{
+  ACE_FUNCTION_TIMEPROBE (TAO_OPERATION_HASH_OPTABLE_FIND_START);
+
+  TAO_operation_db_entry const * const entry =
+    this->lookup (opname,
+                  TAO::operation_hash (
+                    opname,
+                    length == 0 ? ACE_OS::strlen (opname) : length));
+
+  if (entry == 0)
+    return -1;
+
+  switch (st)
+    {
+    case TAO::TAO_CS_DIRECT_STRATEGY:
+      skelfunc = entry->direct_skel_ptr;
+      break;
+    default:
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+TAO_Operation_Hash_OpTable::find_by_hash (const char *opname,
+                                          const TAO_ServerRequest &request,
+                                          TAO_Skeleton &skelfunc,
+                                          const unsigned int)
+{
+  ACE_FUNCTION_TIMEPROBE (TAO_OPERATION_HASH_OPTABLE_FIND_START);
+
+  TAO_operation_db_entry const * const entry =
+    this->lookup (opname, request.operation_hash ());
+
+  if (entry == 0)
+    return -1;
+
+  skelfunc = entry->skel_ptr;
+
+  return 0;
+}
+
+int
+TAO_Operation_Hash_OpTable::bind (const char *,
+                                  const TAO::Operation_Skeletons)
+{
+  return 0;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,104 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Operation_Table_Operation_Hash.h
+ */
+//=============================================================================
+
+#ifndef TAO_OPERATION_TABLE_OPERATION_HASH_H
+#define TAO_OPERATION_TABLE_OPERATION_HASH_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/PortableServer/portableserver_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/PortableServer/Operation_Table.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @struct TAO_operation_hash_entry
+ *
+ * @brief Maps the hash of an operation name, as computed by
+ * TAO::operation_hash(), to its index in the TAO_operation_db_entry
+ * table.  The IDL compiler emits these sorted by hash.
+ */
+struct TAO_operation_hash_entry
+{
+  /// Hash of the operation name.
+  ACE_UINT64 hash;
+
+  /// Index of the operation in the database.
+  CORBA::ULong index;
+};
+
+/**
+ * @class TAO_Operation_Hash_OpTable
+ *
+ * @brief Operation lookup keyed on the 64-bit hash of the operation
+ * name.
+ *
+ * The hashes are computed by the IDL compiler, which also checks
+ * that they do not collide within an interface, so a lookup is a
+ * search through a sorted array of integers followed by a single
+ * string compare to confirm the match.  The hash of the incoming
+ * operation name is only computed for a lookup in this table, see
+ * TAO_ServerRequest::operation_hash().
+ */
+class TAO_PortableServer_Export TAO_Operation_Hash_OpTable
+  : public TAO_Operation_Table
+{
+public:
+  /// Initialize the table with the operation database @a db and the
+  /// @a hashes of its entries, sorted by hash, both of @a dbsize
+  /// elements.  Neither array is copied.
+  TAO_Operation_Hash_OpTable (const TAO_operation_db_entry *db,
+                              const TAO_operation_hash_entry *hashes,
+                              CORBA::ULong dbsize);
+
+  /// Do nothing destructor.
+  virtual ~TAO_Operation_Hash_OpTable ();
+
+  /// See the documentation in the base class for details.
+  virtual int find (const char *opname,
+                    TAO_Skeleton &skelfunc,
+                    const unsigned int length = 0);
+
+  virtual int find (const char *opname,
+                    TAO_Collocated_Skeleton &skelfunc,
+                    TAO::Collocation_Strategy s,
+                    const unsigned int length = 0);
+
+  virtual int find_by_hash (const char *opname,
+                            const TAO_ServerRequest &request,
+                            TAO_Skeleton &skelfunc,
+                            const unsigned int length = 0);
+
+  virtual int bind (const char *opname,
+                    const TAO::Operation_Skeletons skel_ptr);
+
+private:
+  /// Return the database entry for @a opname with hash @a hash, or 0
+  /// if there is none.
+  const TAO_operation_db_entry *lookup (const char *opname,
+                                        ACE_UINT64 hash) const;
+
+  /// The operation database.
+  const TAO_operation_db_entry * const db_;
+
+  /// The hashes of the operations, sorted.
+  const TAO_operation_hash_entry * const hashes_;
+
+  /// Number of operations in the database.
+  CORBA::ULong const dbsize_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_OPERATION_TABLE_OPERATION_HASH_H */
@@ -87,6 +87,10 @@ namespace TAO
     ServantRetentionStrategyRetain::deactivate_map_entry (
       TAO_Active_Object_Map_Entry *active_object_map_entry)
     {
+      // Requests must no longer find the servant through the cache
+      // of the object adapter.
+      this->poa_->object_adapter ().invalidate_object_key_cache ();
+
       // Decrement the reference count.
       CORBA::UShort const new_count = --active_object_map_entry->reference_count_;
 
@@ -126,6 +130,8 @@ namespace TAO
     ServantRetentionStrategyRetain::unbind_using_user_id (
       const PortableServer::ObjectId &user_id)
     {
+      this->poa_->object_adapter ().invalidate_object_key_cache ();
+
       return this->active_object_map_->unbind_using_user_id (user_id);
     }
 
@@ -492,6 +492,17 @@ TAO_ServantBase::_find (const char *opname,
                                static_cast<unsigned int> (length));
 }
 
+int
+TAO_ServantBase::_find_by_hash (const char *opname,
+                                const TAO_ServerRequest &request,
+                                TAO_Skeleton& skelfunc,
+                                const size_t length)
+{
+  ACE_FUNCTION_TIMEPROBE (TAO_SERVANT_BASE_FIND_START);
+  return this->optable_->find_by_hash (opname, request, skelfunc,
+                                       static_cast<unsigned int> (length));
+}
+
 TAO_Stub *
 TAO_ServantBase::_create_stub ()
 {
@@ -547,9 +558,10 @@ TAO_ServantBase::synchronous_upcall_dispatch (
   req.sync_after_dispatch ();
 
   // Fetch the skeleton for this operation
-  if (this->_find (opname,
-                   skel,
-                   static_cast <unsigned int> (req.operation_length())) == -1)
+  if (this->_find_by_hash (opname,
+                           req,
+                           skel,
+                           req.operation_length ()) == -1)
     {
       throw ::CORBA::BAD_OPERATION ();
     }
@@ -614,9 +626,10 @@ TAO_ServantBase::asynchronous_upcall_dispatch (
     }
 
   // Fetch the skeleton for this operation
-  if (this->_find (opname,
-                   skel,
-                   static_cast <unsigned int> (req.operation_length())) == -1)
+  if (this->_find_by_hash (opname,
+                           req,
+                           skel,
+                           req.operation_length ()) == -1)
     {
       throw ::CORBA::BAD_OPERATION ();
     }
@@ -150,6 +150,14 @@ public:
                      TAO::Collocation_Strategy st,
                      const size_t length = 0);
 
+  /// Same as _find() for @a opname, the operation of @a request,
+  /// but demultiplexes on the hash of its name when the operation
+  /// table is keyed on it.
+  virtual int _find_by_hash (const char *opname,
+                             const TAO_ServerRequest &request,
+                             TAO_Skeleton &skelfunc,
+                             const size_t length = 0);
+
   /// Get this interface's repository id (TAO specific).
   virtual const char *_interface_repository_id () const = 0;
 
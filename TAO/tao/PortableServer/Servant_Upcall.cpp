@@ -98,8 +98,29 @@ namespace TAO
       // course, the thread making the non-servant upcall is this thread.
       this->object_adapter_->wait_for_non_servant_upcalls_to_complete ();
 
-      // Locate the POA.
-      this->object_adapter_->locate_poa (key, this->system_id_, this->poa_);
+      // Objects called recently are found in the object key cache,
+      // which gives the POA and the active object map entry without
+      // parsing the key.
+      TAO_Active_Object_Map_Entry *cached_entry = 0;
+      CORBA::ULong system_id_offset = 0;
+
+      if (this->object_adapter_->object_key_cache_.find (key,
+                                                         this->poa_,
+                                                         cached_entry,
+                                                         system_id_offset))
+        {
+          // The system id is the end of the key.
+          CORBA::ULong const system_id_size = key.length () - system_id_offset;
+          this->system_id_.length (system_id_size);
+          ACE_OS::memcpy (this->system_id_.get_buffer (),
+                          key.get_buffer () + system_id_offset,
+                          system_id_size);
+        }
+      else
+        {
+          // Locate the POA.
+          this->object_adapter_->locate_poa (key, this->system_id_, this->poa_);
+        }
 
       // Check the state of the POA.
       this->poa_->check_state ();
@@ -118,16 +139,38 @@ namespace TAO
       try
         {
 #endif /* TAO_HAS_MINIMUM_CORBA */
-          // Lookup the servant.
-          this->servant_ =
-            this->poa_->locate_servant_i (operation,
-                                          this->system_id_,
-                                          *this,
-                                          this->current_context_,
-                                          wait_occurred_restart_call);
-
-          if (wait_occurred_restart_call)
-            return TAO_Adapter::DS_FAILED;
+          if (cached_entry != 0)
+            {
+              // Same as the lookup in the active object map below.
+              this->current_context_.object_id (cached_entry->user_id_);
+              this->user_id (&this->current_context_.object_id ());
+              this->active_object_map_entry (cached_entry);
+              this->increment_servant_refcount ();
+              this->servant_ = cached_entry->servant_;
+            }
+          else
+            {
+              // Lookup the servant.
+              this->servant_ =
+                this->poa_->locate_servant_i (operation,
+                                              this->system_id_,
+                                              *this,
+                                              this->current_context_,
+                                              wait_occurred_restart_call);
+
+              if (wait_occurred_restart_call)
+                return TAO_Adapter::DS_FAILED;
+
+              // Only servants from the active object map are cached,
+              // the ones from servant managers and default servants
+              // have to be located again for every request.
+              if (this->active_object_map_entry () != 0)
+                this->object_adapter_->object_key_cache_.insert (
+                  key,
+                  this->poa_,
+                  this->active_object_map_entry (),
+                  key.length () - this->system_id_.length ());
+            }
 #if (TAO_HAS_MINIMUM_CORBA == 0) && !defined (CORBA_E_COMPACT) && !defined (CORBA_E_MICRO)
         }
       catch (const ::PortableServer::ForwardRequest& forward_request)
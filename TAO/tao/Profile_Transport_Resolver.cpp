@@ -15,6 +15,9 @@
 #include "tao/Endpoint.h"
 #include "tao/SystemException.h"
 #include "tao/Client_Strategy_Factory.h"
+#include "tao/Base_Transport_Property.h"
+#include "tao/Connection_Handler.h"
+#include "tao/debug.h"
 
 #include "tao/ORB_Time_Policy.h"
 #include "ace/CORBA_macros.h"
@@ -79,8 +82,10 @@ namespace TAO
     TAO_Invocation_Endpoint_Selector *es =
       this->stub_->orb_core ()->endpoint_selector_factory ()->get_selector ();
 
-    // Select the endpoint
-    es->select_endpoint (this, max_time_val);
+    // Select the endpoint, unless the transport of the last
+    // invocation can be used again
+    if (!this->reuse_transport (es))
+      es->select_endpoint (this, max_time_val);
 
     if (this->transport_.get () == nullptr)
       {
@@ -104,6 +109,64 @@ namespace TAO
       }
   }
 
+  bool
+  Profile_Transport_Resolver::reuse_transport (
+      TAO_Invocation_Endpoint_Selector *es)
+  {
+    TAO_ORB_Core * const orb_core = this->stub_->orb_core ();
+
+    if (!orb_core->orb_params ()->stub_transport_affinity ()
+        || !es->transport_affinity ()
+        || orb_core->client_factory ()->use_cleanup_options ())
+      return false;
+
+    TAO_Transport * const transport = this->stub_->take_transport ();
+    if (transport == nullptr)
+      return false;
+
+    TAO_Profile * const profile = this->stub_->profile_in_use ();
+
+    // Same check as the default endpoint selector
+    if (this->blocked_ || profile->supports_non_blocking_oneways ())
+      {
+        for (TAO_Endpoint *ep = profile->first_filtered_endpoint ();
+             ep != nullptr;
+             ep = profile->next_filtered_endpoint (ep))
+          {
+            TAO_Base_Transport_Property desc (ep);
+
+            if (!transport->reserve (&desc))
+              continue;
+
+            // Same last check as the connector does before using a
+            // cached connection, let it purge a broken one.
+            TAO_Connection_Handler * const ch =
+              transport->connection_handler ();
+            if (ch->error_detected (orb_core->leader_follower ())
+                || ch->is_closed ())
+              {
+                transport->make_idle ();
+                break;
+              }
+
+            if (TAO_debug_level > 6)
+              {
+                TAOLIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("TAO (%P|%t) - Profile_Transport_Resolver::")
+                  ACE_TEXT ("reuse_transport, reusing Transport[%d]\n"),
+                  transport->id ()));
+              }
+
+            this->profile (profile);
+            this->transport_.set (transport);
+            return true;
+          }
+      }
+
+    transport->remove_reference ();
+    return false;
+  }
+
   bool
   Profile_Transport_Resolver::try_connect (
       TAO_Transport_Descriptor_Interface *desc,
@@ -31,6 +31,7 @@ class TAO_Profile;
 class TAO_Transport;
 class TAO_Endpoint;
 class TAO_Transport_Descriptor_Interface;
+class TAO_Invocation_Endpoint_Selector;
 
 namespace CORBA
 {
@@ -162,6 +163,12 @@ namespace TAO
                         ACE_Time_Value *val,
                         bool parallel);
 
+    /// Reserve the transport the stub kept from its last invocation
+    /// if it is still idle and connected to an endpoint of the profile
+    /// in use, without going through the endpoint selector @a es.
+    /// Return false if the endpoint has to be selected.
+    bool reuse_transport (TAO_Invocation_Endpoint_Selector *es);
+
     /// Target object
     mutable CORBA::Object *obj_;
 
@@ -36,7 +36,6 @@ TAO_RT_Servant_Dispatcher::pre_invoke_remote_request (
   TAO::Portable_Server::Servant_Upcall::Pre_Invoke_State &pre_invoke_state
   )
 {
-  TAO_Service_Context &request_service_context = req.request_service_context ();
   TAO_Service_Context &reply_service_context = req.reply_service_context ();
 
   TAO_Thread_Pool *thread_pool =
@@ -98,6 +97,8 @@ TAO_RT_Servant_Dispatcher::pre_invoke_remote_request (
 
           // Attempt to extract client-propagated priority from the
           // ServiceContextList of the request.
+          TAO_Service_Context &request_service_context =
+            req.request_service_context ();
           const IOP::ServiceContext *context = 0;
 
           if (request_service_context.get_context (IOP::RTCorbaPriority,
@@ -8,6 +8,8 @@
 #include "tao/Network_Priority_Protocols_Hooks.h"
 #include "tao/debug.h"
 #include "tao/SystemException.h"
+#include "tao/ORB_Core_TSS_Resources.h"
+#include "ace/Malloc_Base.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/Remote_Invocation.inl"
@@ -200,6 +202,94 @@ namespace TAO
     this->resolver_.stub ()->set_valid_profile ();
     return TAO_INVOKE_SUCCESS;
   }
+
+  CDR_Thread_Cache_Guard::CDR_Thread_Cache_Guard (TAO_OutputCDR &cdr,
+                                                  TAO_ORB_Core *orb_core)
+    : cdr_ (nullptr)
+    , tss_ (nullptr)
+    , stream_block_ (nullptr)
+    , max_size_ (orb_core->orb_params ()->cdr_thread_cache_size ())
+  {
+    if (this->max_size_ == 0)
+      return;
+
+    this->cdr_ = &cdr;
+    this->tss_ = orb_core->get_tss_resources ();
+
+    if (this->tss_->output_cdr_block_ != nullptr)
+      {
+        this->stream_block_ =
+          cdr.replace_data_block (this->tss_->output_cdr_block_);
+        this->tss_->output_cdr_block_ = nullptr;
+      }
+  }
+
+  CDR_Thread_Cache_Guard::~CDR_Thread_Cache_Guard ()
+  {
+    this->reset ();
+  }
+
+  void
+  CDR_Thread_Cache_Guard::reset ()
+  {
+    if (this->cdr_ == nullptr)
+      return;
+
+    TAO_OutputCDR &cdr = *this->cdr_;
+    this->cdr_ = nullptr;
+
+    // What the stream wrote of the request in its own blocks.  Sending
+    // it moved the read pointers to the end already, so count from the
+    // start of each block; fragments sent while it was marshaled are
+    // gone, and the application buffers the stream refers to (see
+    // -ORBCDRReferenceThreshold) are not copied.
+    size_t length = 0;
+    for (ACE_Message_Block const *i = cdr.begin (); i != nullptr; i = i->cont ())
+      {
+        if (!ACE_BIT_ENABLED (i->flags (), ACE_Message_Block::DONT_DELETE))
+          length += i->wr_ptr () - i->base ();
+      }
+    size_t const capacity = cdr.begin ()->size ();
+
+    ACE_Data_Block *block = nullptr;
+    if (this->stream_block_ != nullptr)
+      {
+        block = cdr.replace_data_block (this->stream_block_);
+        this->stream_block_ = nullptr;
+      }
+
+    if (length + ACE_CDR::MAX_ALIGNMENT > capacity
+        && length <= this->max_size_)
+      {
+        // Keep a buffer the request fits in.  It comes from the heap
+        // as the thread may outlive the allocators of the ORB.
+        ACE_Allocator * const heap = ACE_Allocator::instance ();
+        ACE_Data_Block *larger = nullptr;
+        ACE_NEW_MALLOC_NORETURN (
+          larger,
+          static_cast<ACE_Data_Block *> (heap->malloc (sizeof (ACE_Data_Block))),
+          ACE_Data_Block (ACE_CDR::next_size (length + ACE_CDR::MAX_ALIGNMENT),
+                          ACE_Message_Block::MB_DATA,
+                          nullptr,
+                          heap,
+                          nullptr,
+                          0,
+                          heap));
+
+        if (larger != nullptr && larger->base () != nullptr)
+          {
+            if (block != nullptr)
+              block->release ();
+            block = larger;
+          }
+        else if (larger != nullptr)
+          {
+            larger->release ();
+          }
+      }
+
+    this->tss_->output_cdr_block_ = block;
+  }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
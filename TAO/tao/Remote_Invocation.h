@@ -27,6 +27,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 class TAO_Operation_Details;
 class TAO_Target_Specification;
 class TAO_OutputCDR;
+class TAO_ORB_Core;
+class TAO_ORB_Core_TSS_Resources;
 
 namespace TAO
 {
@@ -109,6 +111,43 @@ namespace TAO
     CDR_Byte_Order_Guard (TAO_OutputCDR&, int);
     ~CDR_Byte_Order_Guard ();
   };
+
+  /**
+   * @class CDR_Thread_Cache_Guard
+   *
+   * @brief Lends the buffer the calling thread keeps in its ORB core
+   * TSS resources to the output CDR stream of a transport, for the
+   * time a synchronous invocation marshals and sends its request.
+   *
+   * reset() gives the stream its own buffer back.  If the request did
+   * not fit in the buffer of the thread, and is not larger than
+   * -ORBCDRThreadCacheSize, the thread keeps a buffer large enough
+   * for it instead, so the next requests of the same size do not
+   * allocate blocks to grow the stream.  The stream must be guarded
+   * by the output CDR lock of the transport until reset().
+   */
+  class TAO_Export CDR_Thread_Cache_Guard
+  {
+  public:
+    CDR_Thread_Cache_Guard (TAO_OutputCDR &cdr, TAO_ORB_Core *orb_core);
+    ~CDR_Thread_Cache_Guard ();
+
+    void reset ();
+
+    CDR_Thread_Cache_Guard (const CDR_Thread_Cache_Guard &) = delete;
+    CDR_Thread_Cache_Guard &operator= (const CDR_Thread_Cache_Guard &) = delete;
+
+  private:
+    /// The stream, nil when the cache is disabled or once reset.
+    TAO_OutputCDR *cdr_;
+
+    TAO_ORB_Core_TSS_Resources *tss_;
+
+    /// Buffer of the stream while it writes in the one of the thread.
+    ACE_Data_Block *stream_block_;
+
+    size_t max_size_;
+  };
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -194,6 +194,30 @@ TAO_Resource_Factory::locked_transport_cache ()
   return 0;
 }
 
+int
+TAO_Resource_Factory::transport_cache_shards () const
+{
+  return 1;
+}
+
+size_t
+TAO_Resource_Factory::transport_coalescing_bytes () const
+{
+  return 0;
+}
+
+int
+TAO_Resource_Factory::transport_coalescing_window () const
+{
+  return TAO_TRANSPORT_COALESCING_WINDOW;
+}
+
+bool
+TAO_Resource_Factory::lock_free_follower_set () const
+{
+  return false;
+}
+
 int
 TAO_Resource_Factory::load_default_protocols ()
 {
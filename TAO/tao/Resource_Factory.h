@@ -223,10 +223,22 @@ public:
   /// transport cache needs to be locked  else return 0
   virtual int locked_transport_cache ();
 
+  /// Number of shards of the transport cache, each with its own
+  /// lock.
+  virtual int transport_cache_shards () const;
+
   /// Creates the flushing strategy.  The new instance is owned by the
   /// caller.
   virtual TAO_Flushing_Strategy *create_flushing_strategy () = 0;
 
+  /// Number of bytes of oneway and AMI requests a transport may hold
+  /// back to write them together, 0 if they are not coalesced.
+  virtual size_t transport_coalescing_bytes () const;
+
+  /// Requests sent less than this many microseconds after the previous
+  /// one on the same transport are coalesced.
+  virtual int transport_coalescing_window () const;
+
   /// Creates the connection purging strategy.
   virtual TAO_Connection_Purging_Strategy *create_purging_strategy () = 0;
 
@@ -234,6 +246,11 @@ public:
   /// caller.
   virtual TAO_LF_Strategy *create_lf_strategy () = 0;
 
+  /// Should the Leader/Followers sets keep their followers on a lock
+  /// free stack, waking them up on futexes, instead of a list of
+  /// condition variables?
+  virtual bool lock_free_follower_set () const;
+
   /// Outgoing fragment creation strategy.
   virtual TAO_GIOP_Fragmentation_Strategy*
     create_fragmentation_strategy (TAO_Transport * transport,
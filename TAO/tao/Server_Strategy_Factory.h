@@ -31,7 +31,8 @@ enum TAO_Demux_Strategy
   TAO_LINEAR,
   TAO_DYNAMIC_HASH,
   TAO_ACTIVE_DEMUX,
-  TAO_USER_DEFINED
+  TAO_USER_DEFINED,
+  TAO_OPEN_HASH
 };
 
 /**
@@ -82,6 +83,10 @@ public:
     TAO_Demux_Strategy poa_lookup_strategy_for_persistent_id_policy_;
 
     int use_active_hint_in_poa_names_;
+
+    /// Number of object keys whose POA and servant are cached by the
+    /// object adapter, zero disables the cache.
+    CORBA::ULong object_key_cache_size_;
   };
 
   /// Constructor.
@@ -78,4 +78,10 @@ TAO_Service_Context_Registry::operator[] (IOP::ServiceId id)
   return registry_[id];
 }
 
+bool
+TAO_Service_Context_Registry::has_handler (IOP::ServiceId id) const
+{
+  return this->registry_.find (id) != this->registry_.end ();
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
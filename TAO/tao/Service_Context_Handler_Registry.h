@@ -47,6 +47,12 @@ class TAO_Export TAO_Service_Context_Registry
      */
     TAO_Service_Context_Handler* operator[] (IOP::ServiceId id);
 
+    /**
+     * Is there a handler for @a id?  Unlike operator[] this does not
+     * add an entry for @a id.
+     */
+    bool has_handler (IOP::ServiceId id) const;
+
     int process_service_contexts (
       IOP::ServiceContextList &sc,
       TAO_Transport &transport,
@@ -40,6 +40,12 @@ TAO_Optimized_Connection_Endpoint_Selector::
 {
 }
 
+bool
+TAO_Optimized_Connection_Endpoint_Selector::transport_affinity () const
+{
+  return false;
+}
+
 
 void
 TAO_Optimized_Connection_Endpoint_Selector::hook (TAO_ORB_Core *,
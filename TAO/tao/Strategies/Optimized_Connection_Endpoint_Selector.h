@@ -59,6 +59,10 @@ public:
 
   virtual void select_endpoint (TAO::Profile_Transport_Resolver *,
                                 ACE_Time_Value *max_wait_time);
+
+  /// Any profile of the stub may be picked, always go through
+  /// select_endpoint().
+  virtual bool transport_affinity () const;
 private:
 
   int check_profile (TAO_Profile *,
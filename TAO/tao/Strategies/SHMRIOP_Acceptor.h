@@ -0,0 +1,139 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    SHMRIOP_Acceptor.h
+ *
+ *  SHMRIOP specific acceptor processing
+ *
+ */
+//=============================================================================
+
+
+#ifndef TAO_SHMRIOP_ACCEPTOR_H
+#define TAO_SHMRIOP_ACCEPTOR_H
+
+#include /**/ "ace/pre.h"
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+# if TAO_HAS_SHMRIOP == 1
+#include "tao/Strategies/SHMRIOP_Connection_Handler.h"
+
+#include "tao/Transport_Acceptor.h"
+#include "tao/Acceptor_Impl.h"
+#include "tao/GIOP_Message_Version.h"
+
+#include "ace/Acceptor.h"
+#include "ace/LSOCK_Acceptor.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_SHMRIOP_Acceptor
+ *
+ * @brief The SHMRIOP-specific bridge class for the concrete acceptor.
+ */
+class TAO_Strategies_Export TAO_SHMRIOP_Acceptor : public TAO_Acceptor
+{
+public:
+  // TAO_SHMRIOP_Acceptor (ACE_UNIX_Addr &addr);
+  // Create Acceptor object using addr.
+
+  /// Create Acceptor object using addr.
+  TAO_SHMRIOP_Acceptor (void);
+
+  /// Destructor
+  virtual ~TAO_SHMRIOP_Acceptor (void);
+
+  typedef TAO_Strategy_Acceptor<TAO_SHMRIOP_Connection_Handler, ACE_LSOCK_ACCEPTOR> TAO_SHMRIOP_BASE_ACCEPTOR;
+  typedef TAO_Creation_Strategy<TAO_SHMRIOP_Connection_Handler> TAO_SHMRIOP_CREATION_STRATEGY;
+  typedef TAO_Concurrency_Strategy<TAO_SHMRIOP_Connection_Handler> TAO_SHMRIOP_CONCURRENCY_STRATEGY;
+  typedef TAO_Accept_Strategy<TAO_SHMRIOP_Connection_Handler, ACE_LSOCK_ACCEPTOR> TAO_SHMRIOP_ACCEPT_STRATEGY;
+
+  /**
+   * @name The TAO_Acceptor Methods
+   *
+   * Please check the documentation in Transport_Acceptor.h for details.
+   */
+  //@{
+  virtual int open (TAO_ORB_Core *orb_core,
+                    ACE_Reactor *reactor,
+                    int version_major,
+                    int version_minor,
+                    const char *address,
+                    const char *options = 0);
+  virtual int open_default (TAO_ORB_Core *orb_core,
+                            ACE_Reactor *reactor,
+                            int version_major,
+                            int version_minor,
+                            const char *options = 0);
+  virtual int close (void);
+  virtual int create_profile (const TAO::ObjectKey &object_key,
+                              TAO_MProfile &mprofile,
+                              CORBA::Short priority);
+
+  virtual int is_collocated (const TAO_Endpoint* endpoint);
+  virtual CORBA::ULong endpoint_count (void);
+
+  virtual int object_key (IOP::TaggedProfile &profile,
+                          TAO::ObjectKey &key);
+  //@}
+
+private:
+  /// Implement the common part of the open*() methods
+  int open_i (const char *rendezvous,
+              ACE_Reactor *reactor);
+
+  /// Set the rendezvous point and verify that it is
+  /// valid (e.g. wasn't truncated because it was too long).
+  void rendezvous_point (ACE_UNIX_Addr &, const char *rendezvous);
+
+  /// Parse protocol specific options.
+  int parse_options (const char *options);
+
+  /// Obtains shmriop properties that must be used by this acceptor, i.e.,
+  /// initializes <shmriop_properties_>.
+  int init_shmriop_properties (void);
+
+  /// Create a SHMRIOP profile representing this acceptor.
+  int create_new_profile (const TAO::ObjectKey &object_key,
+                          TAO_MProfile &mprofile,
+                          CORBA::Short priority);
+
+  /// Add the endpoints on this acceptor to a shared profile.
+  int create_shared_profile (const TAO::ObjectKey &object_key,
+                             TAO_MProfile &mprofile,
+                             CORBA::Short priority);
+
+private:
+  /// The concrete acceptor, as a pointer to its base class.
+  TAO_SHMRIOP_BASE_ACCEPTOR base_acceptor_;
+
+  // Acceptor strategies.
+  TAO_SHMRIOP_CREATION_STRATEGY *creation_strategy_;
+  TAO_SHMRIOP_CONCURRENCY_STRATEGY *concurrency_strategy_;
+  TAO_SHMRIOP_ACCEPT_STRATEGY *accept_strategy_;
+
+  /// The GIOP version for this endpoint
+  TAO_GIOP_Message_Version version_;
+
+  /// ORB Core.
+  TAO_ORB_Core *orb_core_;
+
+  /// Flag that determines whether or not the rendezvous point should
+  /// be unlinked on close.  This is really only used when an error
+  /// occurs.
+  bool unlink_on_close_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+# endif /* TAO_HAS_SHMRIOP == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif  /* TAO_SHMRIOP_ACCEPTOR_H */
@@ -0,0 +1,255 @@
+#include "tao/Strategies/SHMRIOP_Connection_Handler.h"
+
+#if TAO_HAS_SHMRIOP == 1
+
+#include "tao/Strategies/SHMRIOP_Transport.h"
+#include "tao/Strategies/SHMRIOP_Endpoint.h"
+#include "tao/debug.h"
+#include "tao/ORB_Core.h"
+#include "tao/ORB.h"
+#include "tao/CDR.h"
+#include "tao/Timeprobe.h"
+#include "tao/Server_Strategy_Factory.h"
+#include "tao/Base_Transport_Property.h"
+#include "tao/Transport_Cache_Manager.h"
+#include "tao/Resume_Handle.h"
+#include "tao/Thread_Lane_Resources.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_SHMRIOP_Connection_Handler::TAO_SHMRIOP_Connection_Handler (ACE_Thread_Manager *t)
+  : TAO_SHMRIOP_SVC_HANDLER (t, 0 , 0),
+    TAO_Connection_Handler (0)
+{
+  // This constructor should *never* get called, it is just here to
+  // make the compiler happy: the default implementation of the
+  // Creation_Strategy requires a constructor with that signature, we
+  // don't use that implementation, but some (most?) compilers
+  // instantiate it anyway.
+  ACE_ASSERT (0);
+}
+
+
+TAO_SHMRIOP_Connection_Handler::TAO_SHMRIOP_Connection_Handler (TAO_ORB_Core *orb_core)
+  : TAO_SHMRIOP_SVC_HANDLER (orb_core->thr_mgr (), 0, 0),
+    TAO_Connection_Handler (orb_core)
+{
+  TAO_SHMRIOP_Transport* specific_transport = 0;
+  ACE_NEW (specific_transport,
+           TAO_SHMRIOP_Transport (this, orb_core));
+
+  // store this pointer (indirectly increment ref count)
+  this->transport (specific_transport);
+}
+
+
+TAO_SHMRIOP_Connection_Handler::~TAO_SHMRIOP_Connection_Handler (void)
+{
+  delete this->transport ();
+  int const result =
+    this->release_os_resources ();
+
+  if (result == -1 && TAO_debug_level)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                  ACE_TEXT("TAO (%P|%t) - SHMRIOP_Connection_Handler::")
+                  ACE_TEXT("~SHMRIOP_Connection_Handler, ")
+                  ACE_TEXT("release_os_resources() failed %m\n")));
+    }
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::open_handler (void *v)
+{
+  return this->open (v);
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::open (void*)
+{
+  if (this->shared_open() == -1)
+    return -1;
+
+  // The descriptors of the segment are exchanged before anything
+  // else, with the socket in blocking mode.
+  if (this->peer ().disable (ACE_NONBLOCK) == -1)
+    return -1;
+
+  int result = 0;
+  if (this->transport ()->opened_as () == TAO::TAO_CLIENT_ROLE)
+    result = this->segment_.attach (this->peer ());
+  else
+    result = this->segment_.create (this->peer (),
+                                    TAO_SHMRIOP_RING_SIZE);
+
+  if (result == -1)
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("TAO (%P|%t) - SHMRIOP_Connection_Handler::")
+                       ACE_TEXT ("open, cannot set up the shared memory ")
+                       ACE_TEXT ("segment %m\n")));
+      return -1;
+    }
+
+  // Called by the <Strategy_Acceptor> when the handler is completely
+  // connected.
+  ACE_UNIX_Addr addr;
+
+  if (this->peer ().get_remote_addr (addr) == -1)
+    return -1;
+
+  if (TAO_debug_level > 0)
+    TAOLIB_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("TAO (%P|%t) - SHMRIOP_Connection_Handler::open, connection to server ")
+                ACE_TEXT ("<%C> on %d\n"),
+                addr.get_path_name (), this->peer ().get_handle ()));
+
+  // Set that the transport is now connected, if fails we return -1
+  // Use C-style cast b/c otherwise we get warnings on lots of
+  // compilers
+  if (!this->transport ()->post_open ((size_t) this->get_handle ()))
+    return -1;
+
+  this->state_changed (TAO_LF_Event::LFS_SUCCESS,
+                       this->orb_core ()->leader_follower ());
+
+  return 0;
+}
+
+ACE_HANDLE
+TAO_SHMRIOP_Connection_Handler::get_handle (void) const
+{
+  // The socket is only waited on by itself while the connection is
+  // set up.
+  ACE_HANDLE const handle = this->segment_.handle ();
+
+  return handle == ACE_INVALID_HANDLE ? this->peer ().get_handle () : handle;
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::resume_handler (void)
+{
+  return ACE_Event_Handler::ACE_APPLICATION_RESUMES_HANDLER;
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::close_connection (void)
+{
+  return this->close_connection_eh (this);
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::handle_input (ACE_HANDLE h)
+{
+  // The handle never becomes writable, the peer making room for
+  // queued output shows up as input.
+  if (this->segment_.space_signaled ())
+    {
+      TAO::Transport::Drain_Constraints dc;
+      if (this->transport ()->handle_output (dc) == TAO_Transport::DR_ERROR)
+        {
+          this->close_connection ();
+          return 0;
+        }
+    }
+
+  return this->handle_input_eh (h, this);
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::handle_output (ACE_HANDLE handle)
+{
+  int const result = this->handle_output_eh (handle, this);
+
+  if (result == -1)
+    {
+      this->close_connection ();
+      return 0;
+    }
+
+  return result;
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::handle_timeout (const ACE_Time_Value &,
+                                             const void *)
+{
+  // Using this to ensure this instance will be deleted (if necessary)
+  // only after reset_state(). Without this, when this refcount==1 -
+  // the call to close() will cause a call to remove_reference() which
+  // will delete this. At that point this->reset_state() is in no
+  // man's territory and that causes SEGV on some platforms (Windows!)
+
+  TAO_Auto_Reference<TAO_SHMRIOP_Connection_Handler> safeguard (*this);
+
+  // NOTE: Perhaps not the best solution, as it feels like the upper
+  // layers should be responsible for this?
+
+  // We don't use this upcall for I/O.  This is only used by the
+  // Connector to indicate that the connection timedout.  Therefore,
+  // we should call close().
+  int const ret = this->close ();
+  this->reset_state (TAO_LF_Event::LFS_TIMEOUT);
+  return ret;
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::handle_close (ACE_HANDLE, ACE_Reactor_Mask)
+{
+  ACE_ASSERT (0);
+  return 0;
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::close (u_long flags)
+{
+  return this->close_handler (flags);
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::release_os_resources (void)
+{
+  // The segment itself is only unmapped by the destructor, another
+  // thread may still be using it.
+  this->segment_.shutdown ();
+  return this->peer().close ();
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::add_transport_to_cache (void)
+{
+  ACE_UNIX_Addr addr;
+
+  // Get the peername.
+  if (this->peer ().get_remote_addr (addr) == -1)
+    return -1;
+
+  // Construct an  SHMRIOP_Endpoint object
+  TAO_SHMRIOP_Endpoint endpoint (addr);
+
+  // Construct a property object
+  TAO_Base_Transport_Property prop (&endpoint);
+
+  TAO::Transport_Cache_Manager &cache =
+    this->orb_core ()->lane_resources ().transport_cache ();
+
+  // Add the handler to Cache
+  return cache.cache_transport (&prop, this->transport ());
+}
+
+TAO_SHMRIOP_Segment &
+TAO_SHMRIOP_Connection_Handler::segment (void)
+{
+  return this->segment_;
+}
+
+int
+TAO_SHMRIOP_Connection_Handler::handle_write_ready (const ACE_Time_Value *t)
+{
+  return this->segment_.wait_for_space (t);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /*TAO_HAS_SHMRIOP == 1*/
@@ -0,0 +1,109 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   SHMRIOP_Connection_Handler.h
+ *
+ *  Connection handler of the shared memory ring buffer protocol.
+ */
+// ===================================================================
+#ifndef TAO_SHMRIOP_CONNECTION_HANDLER_H
+#define TAO_SHMRIOP_CONNECTION_HANDLER_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if TAO_HAS_SHMRIOP == 1
+
+#include "tao/Strategies/SHMRIOP_Transport.h"
+#include "tao/Strategies/SHMRIOP_Segment.h"
+#include "tao/Connection_Handler.h"
+#include "tao/Wait_Strategy.h"
+#include "ace/Acceptor.h"
+#include "ace/Reactor.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// ****************************************************************
+
+/**
+ * @class TAO_SHMRIOP_Connection_Handler
+ *
+ * @brief  Handles requests on a single connection.
+ *
+ * The Connection handler which is common for the Acceptor and
+ * the Connector.  Once the connection is open the messages go
+ * through the shared memory segment, the reactor waits on the epoll
+ * descriptor of the segment, which also watches the socket.
+ */
+class TAO_Strategies_Export TAO_SHMRIOP_Connection_Handler : public TAO_SHMRIOP_SVC_HANDLER,
+                                                          public TAO_Connection_Handler
+{
+
+public:
+
+  TAO_SHMRIOP_Connection_Handler (ACE_Thread_Manager* t = 0);
+
+  /// Constructor.
+  TAO_SHMRIOP_Connection_Handler (TAO_ORB_Core *orb_core);
+
+  /// Destructor.
+  ~TAO_SHMRIOP_Connection_Handler (void);
+
+  //@{
+  /**
+   * Connection_Handler overloads
+   */
+  virtual int open_handler (void *);
+  //@}
+
+  /// Close called by the Acceptor or Connector when connection
+  /// establishment fails.
+  int close (u_long = 0);
+
+  //@{
+  /** @name Event Handler overloads
+   */
+  virtual int open (void *);
+  virtual ACE_HANDLE get_handle (void) const;
+  virtual int resume_handler (void);
+  virtual int close_connection (void);
+  virtual int handle_input (ACE_HANDLE);
+  virtual int handle_output (ACE_HANDLE);
+  virtual int handle_close (ACE_HANDLE, ACE_Reactor_Mask);
+  virtual int handle_timeout (const ACE_Time_Value &current_time,
+                              const void *act = 0);
+  //@}
+
+  /// Add ourselves to Cache.
+  int add_transport_to_cache (void);
+
+  /// The shared memory segment of the connection.
+  TAO_SHMRIOP_Segment &segment (void);
+
+protected:
+
+  //@{
+  /**
+   * @name TAO_Connection Handler overloads
+   */
+  virtual int release_os_resources (void);
+  virtual int handle_write_ready (const ACE_Time_Value *timeout);
+  //@}
+
+private:
+  TAO_SHMRIOP_Segment segment_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_SHMRIOP == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_SHMRIOP_CONNECTION_HANDLER_H */
@@ -0,0 +1,20 @@
+// -*- C++ -*-
+# if TAO_HAS_SHMRIOP == 1
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE const ACE_UNIX_Addr &
+TAO_SHMRIOP_Endpoint::object_addr () const
+{
+  return this->object_addr_;
+}
+
+ACE_INLINE const char *
+TAO_SHMRIOP_Endpoint::rendezvous_point () const
+{
+  return this->object_addr_.get_path_name ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* TAO_HAS_SHMRIOP == 1 */
@@ -0,0 +1,663 @@
+#include "tao/Strategies/SHMRIOP_Segment.h"
+
+#if TAO_HAS_SHMRIOP == 1
+
+#include "tao/debug.h"
+#include "ace/OS_NS_poll.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_errno.h"
+
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+
+namespace
+{
+  /// "SHMR", written last by the server.
+  const ACE_UINT32 segment_magic = 0x53484d52U;
+
+  /// Bounds of the adaptive spinning.
+  const unsigned int min_spin = 64;
+  const unsigned int initial_spin = 1024;
+  const unsigned int max_spin = 16384;
+
+  /// Makes the names of the segments unique within the process, they
+  /// are unlinked as soon as they are created.
+  std::atomic<unsigned long> segment_count (0);
+}
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_SHMRIOP_Segment::TAO_SHMRIOP_Segment (void)
+  : header_ (0),
+    size_ (0),
+    mask_ (0),
+    in_ (0),
+    out_ (0),
+    in_data_ (0),
+    out_data_ (0),
+    in_data_handle_ (ACE_INVALID_HANDLE),
+    in_space_handle_ (ACE_INVALID_HANDLE),
+    out_data_handle_ (ACE_INVALID_HANDLE),
+    out_space_handle_ (ACE_INVALID_HANDLE),
+    peer_ (ACE_INVALID_HANDLE),
+    poll_handle_ (ACE_INVALID_HANDLE),
+    send_spin_ (0),
+    recv_spin_ (0),
+    max_spin_ (0)
+{
+  // Spinning only helps if the peer runs at the same time.
+  if (ACE_OS::num_processors_online () > 1)
+    {
+      this->max_spin_ = max_spin;
+      this->send_spin_ = initial_spin;
+      this->recv_spin_ = initial_spin;
+    }
+}
+
+TAO_SHMRIOP_Segment::~TAO_SHMRIOP_Segment (void)
+{
+  this->release ();
+}
+
+int
+TAO_SHMRIOP_Segment::create (const ACE_LSOCK_Stream &peer,
+                             size_t ring_size)
+{
+  if (ring_size == 0
+      || (ring_size & (ring_size - 1)) != 0
+      || ring_size > 0x80000000U)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  size_t const size = sizeof (Header) + 2 * ring_size;
+
+  ACE_HANDLE shm = ACE_INVALID_HANDLE;
+  for (int i = 0; i < 16 && shm == ACE_INVALID_HANDLE; ++i)
+    {
+      ACE_TCHAR name[64];
+      ACE_OS::snprintf (name,
+                        sizeof name / sizeof name[0],
+                        ACE_TEXT ("/tao_shmriop_%d_%lu"),
+                        static_cast<int> (ACE_OS::getpid ()),
+                        ++segment_count);
+
+      shm = ACE_OS::shm_open (name, O_RDWR | O_CREAT | O_EXCL, 0600);
+      if (shm != ACE_INVALID_HANDLE)
+        ACE_OS::shm_unlink (name);
+      else if (errno != EEXIST)
+        break;
+    }
+
+  if (shm == ACE_INVALID_HANDLE)
+    return -1;
+
+  ACE_HANDLE handles[HANDLE_COUNT] = { shm };
+  for (int i = 1; i < HANDLE_COUNT; ++i)
+    handles[i] = ::eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  this->peer_ = peer.get_handle ();
+
+  // The server sends on ring 1, see attach().
+  this->in_data_handle_ = handles[1];
+  this->in_space_handle_ = handles[2];
+  this->out_data_handle_ = handles[3];
+  this->out_space_handle_ = handles[4];
+
+  if (this->in_data_handle_ == ACE_INVALID_HANDLE
+      || this->in_space_handle_ == ACE_INVALID_HANDLE
+      || this->out_data_handle_ == ACE_INVALID_HANDLE
+      || this->out_space_handle_ == ACE_INVALID_HANDLE
+      || ACE_OS::ftruncate (shm, static_cast<ACE_OFF_T> (size)) == -1
+      || this->map (shm, size, 1) == -1
+      || this->open_poll_handle () == -1)
+    {
+      ACE_OS::close (shm);
+      this->release ();
+      return -1;
+    }
+
+  // Both readers start out waiting, so the first message of each side
+  // is signaled whether the peer reads from its reactor or not.
+  for (int i = 0; i < 2; ++i)
+    this->header_->rings_[i].reader_waiting_.store (1);
+
+  this->header_->ring_size_ = static_cast<ACE_UINT32> (ring_size);
+  this->header_->magic_ = segment_magic;
+
+  int result = 0;
+  for (int i = 0; i < HANDLE_COUNT && result != -1; ++i)
+    if (peer.send_handle (handles[i]) == -1)
+      result = -1;
+
+  // The mapping stays valid without the descriptor.
+  ACE_OS::close (shm);
+
+  if (result == -1)
+    this->release ();
+
+  return result;
+}
+
+int
+TAO_SHMRIOP_Segment::attach (const ACE_LSOCK_Stream &peer)
+{
+  ACE_HANDLE handles[HANDLE_COUNT];
+  int count = 0;
+
+  for (; count < HANDLE_COUNT; ++count)
+    if (peer.recv_handle (handles[count]) != 1)
+      break;
+
+  if (count == HANDLE_COUNT)
+    {
+      this->peer_ = peer.get_handle ();
+      this->out_data_handle_ = handles[1];
+      this->out_space_handle_ = handles[2];
+      this->in_data_handle_ = handles[3];
+      this->in_space_handle_ = handles[4];
+
+      ACE_stat buf;
+      if (ACE_OS::fstat (handles[0], &buf) == 0
+          && static_cast<size_t> (buf.st_size) > sizeof (Header)
+          && this->map (handles[0],
+                        static_cast<size_t> (buf.st_size),
+                        0) == 0
+          && this->header_->magic_ == segment_magic
+          && sizeof (Header) + 2 * size_t (this->header_->ring_size_)
+               == this->size_
+          && this->open_poll_handle () == 0)
+        {
+          ACE_OS::close (handles[0]);
+          return 0;
+        }
+
+      if (TAO_debug_level > 0)
+        TAOLIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("TAO (%P|%t) - SHMRIOP_Segment::attach, ")
+                       ACE_TEXT ("invalid segment received\n")));
+      errno = EINVAL;
+    }
+
+  // Once stored, the eventfds are closed by release().
+  for (int i = 0; i < count; ++i)
+    if (i == 0 || count < HANDLE_COUNT)
+      ACE_OS::close (handles[i]);
+
+  this->release ();
+  return -1;
+}
+
+int
+TAO_SHMRIOP_Segment::map (ACE_HANDLE shm, size_t size, int out)
+{
+  void *const addr = ACE_OS::mmap (0,
+                                   size,
+                                   PROT_RDWR,
+                                   MAP_SHARED,
+                                   shm,
+                                   0);
+  if (addr == MAP_FAILED)
+    return -1;
+
+  this->header_ = static_cast<Header *> (addr);
+  this->size_ = size;
+
+  size_t const ring_size = (size - sizeof (Header)) / 2;
+  this->mask_ = static_cast<ACE_UINT32> (ring_size - 1);
+
+  char *const data = static_cast<char *> (addr) + sizeof (Header);
+  this->out_ = &this->header_->rings_[out];
+  this->in_ = &this->header_->rings_[1 - out];
+  this->out_data_ = data + out * ring_size;
+  this->in_data_ = data + (1 - out) * ring_size;
+
+  return 0;
+}
+
+int
+TAO_SHMRIOP_Segment::open_poll_handle (void)
+{
+  this->poll_handle_ = ::epoll_create1 (EPOLL_CLOEXEC);
+  if (this->poll_handle_ == ACE_INVALID_HANDLE)
+    return -1;
+
+  // Nothing is sent on the socket once the segment is set up, it only
+  // becomes readable when the peer goes away.
+  ACE_HANDLE const handles[] = { this->in_data_handle_,
+                                 this->out_space_handle_,
+                                 this->peer_ };
+
+  for (size_t i = 0; i < sizeof handles / sizeof handles[0]; ++i)
+    {
+      struct epoll_event event;
+      ACE_OS::memset (&event, 0, sizeof event);
+      event.events = EPOLLIN;
+      event.data.fd = handles[i];
+
+      if (::epoll_ctl (this->poll_handle_,
+                       EPOLL_CTL_ADD,
+                       handles[i],
+                       &event) == -1)
+        return -1;
+    }
+
+  return 0;
+}
+
+void
+TAO_SHMRIOP_Segment::release (void)
+{
+  if (this->header_ != 0)
+    {
+      ACE_OS::munmap (this->header_, this->size_);
+      this->header_ = 0;
+      this->in_ = 0;
+      this->out_ = 0;
+    }
+
+  ACE_HANDLE *const handles[] = { &this->in_data_handle_,
+                                  &this->in_space_handle_,
+                                  &this->out_data_handle_,
+                                  &this->out_space_handle_,
+                                  &this->poll_handle_ };
+
+  for (size_t i = 0; i < sizeof handles / sizeof handles[0]; ++i)
+    if (*handles[i] != ACE_INVALID_HANDLE)
+      {
+        ACE_OS::close (*handles[i]);
+        *handles[i] = ACE_INVALID_HANDLE;
+      }
+
+  this->peer_ = ACE_INVALID_HANDLE;
+}
+
+ACE_HANDLE
+TAO_SHMRIOP_Segment::handle (void) const
+{
+  return this->poll_handle_;
+}
+
+void
+TAO_SHMRIOP_Segment::signal (ACE_HANDLE handle)
+{
+  ACE_UINT64 const one = 1;
+  (void) ACE_OS::write (handle, &one, sizeof one);
+}
+
+void
+TAO_SHMRIOP_Segment::clear (ACE_HANDLE handle)
+{
+  ACE_UINT64 count;
+  (void) ACE_OS::read (handle, &count, sizeof count);
+}
+
+template <typename Predicate>
+bool
+TAO_SHMRIOP_Segment::spin (unsigned int &limit, Predicate done)
+{
+  for (unsigned int i = 0; i < limit; ++i)
+    if (done ())
+      {
+        if (limit < this->max_spin_)
+          limit *= 2;
+        return true;
+      }
+
+  if (limit > min_spin)
+    limit /= 2;
+  return false;
+}
+
+int
+TAO_SHMRIOP_Segment::wait (ACE_HANDLE handle,
+                           const ACE_Time_Value *deadline)
+{
+  ACE_Time_Value timeout;
+  if (deadline != 0)
+    {
+      timeout = *deadline - ACE_OS::gettimeofday ();
+      if (timeout <= ACE_Time_Value::zero)
+        {
+          errno = ETIME;
+          return -1;
+        }
+    }
+
+  struct pollfd fds[2];
+  fds[0].fd = handle;
+  fds[0].events = POLLIN;
+  fds[0].revents = 0;
+  fds[1].fd = this->peer_;
+  fds[1].events = POLLIN;
+  fds[1].revents = 0;
+
+  int const result = ACE_OS::poll (fds, 2, deadline == 0 ? 0 : &timeout);
+  if (result == -1)
+    return errno == EINTR ? 0 : -1;
+
+  if (result == 0)
+    {
+      errno = ETIME;
+      return -1;
+    }
+
+  // Nothing is sent on the socket once the segment is set up.
+  if (fds[1].revents != 0)
+    {
+      errno = ECONNRESET;
+      return -1;
+    }
+
+  return 0;
+}
+
+bool
+TAO_SHMRIOP_Segment::peer_closed (void) const
+{
+  struct pollfd fd;
+  fd.fd = this->peer_;
+  fd.events = POLLIN;
+  fd.revents = 0;
+
+  ACE_Time_Value const no_wait;
+  return ACE_OS::poll (&fd, 1, &no_wait) > 0;
+}
+
+ssize_t
+TAO_SHMRIOP_Segment::send (const iovec *iov,
+                           int iovcnt,
+                           const ACE_Time_Value *timeout,
+                           bool reactive)
+{
+  if (this->out_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  Ring &ring = *this->out_;
+
+  if (ring.closed_.load () != 0)
+    {
+      errno = EPIPE;
+      return -1;
+    }
+
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  ACE_UINT32 const ring_size = this->mask_ + 1;
+  ACE_UINT32 tail = ring.tail_.load (std::memory_order_relaxed);
+  ssize_t sent = 0;
+
+  auto has_space = [&] ()
+    {
+      return tail - ring.head_.load (std::memory_order_acquire) != ring_size
+        || ring.closed_.load (std::memory_order_relaxed) != 0;
+    };
+
+  for (int i = 0; i < iovcnt; ++i)
+    {
+      const char *src = static_cast<const char *> (iov[i].iov_base);
+      size_t left = iov[i].iov_len;
+
+      while (left > 0)
+        {
+          ACE_UINT32 const space =
+            ring_size - (tail - ring.head_.load (std::memory_order_acquire));
+
+          if (space == 0)
+            {
+              if (ring.closed_.load () != 0)
+                {
+                  errno = EPIPE;
+                  return -1;
+                }
+
+              // Let the reader drain what is already there.
+              ring.tail_.store (tail);
+              if (ring.reader_waiting_.load () != 0
+                  && ring.reader_waiting_.exchange (0) != 0)
+                this->signal (this->out_data_handle_);
+
+              if (this->spin (this->send_spin_, has_space))
+                continue;
+
+              ring.writer_waiting_.store (1);
+              if (!has_space ())
+                {
+                  if (reactive)
+                    {
+                      // Blocking here could deadlock with a peer
+                      // that is sending to us as well.  The reader
+                      // signals the space eventfd, watched by
+                      // handle(), once it has made room.
+                      if (sent > 0)
+                        return sent;
+
+                      errno = EWOULDBLOCK;
+                      return -1;
+                    }
+
+                  if (this->wait (this->out_space_handle_,
+                                  timeout == 0 ? 0 : &deadline) == -1)
+                    {
+                      ring.writer_waiting_.store (0);
+                      return sent > 0 ? sent : -1;
+                    }
+                  this->clear (this->out_space_handle_);
+                }
+              ring.writer_waiting_.store (0);
+              continue;
+            }
+
+          size_t const n = left < space ? left : space;
+          size_t const offset = tail & this->mask_;
+          size_t const first =
+            n < ring_size - offset ? n : ring_size - offset;
+
+          ACE_OS::memcpy (this->out_data_ + offset, src, first);
+          if (first < n)
+            ACE_OS::memcpy (this->out_data_, src + first, n - first);
+
+          tail += static_cast<ACE_UINT32> (n);
+          ring.tail_.store (tail, std::memory_order_release);
+          src += n;
+          left -= n;
+          sent += n;
+        }
+    }
+
+  // Publish before looking at the flag of the reader, which sets it
+  // before looking at the tail.
+  ring.tail_.store (tail);
+  if (ring.reader_waiting_.load () != 0
+      && ring.reader_waiting_.exchange (0) != 0)
+    this->signal (this->out_data_handle_);
+
+  return sent;
+}
+
+int
+TAO_SHMRIOP_Segment::wait_for_space (const ACE_Time_Value *timeout)
+{
+  if (this->out_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  Ring &ring = *this->out_;
+
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  ACE_UINT32 const ring_size = this->mask_ + 1;
+  ACE_UINT32 const tail = ring.tail_.load (std::memory_order_relaxed);
+
+  for (;;)
+    {
+      if (ring.closed_.load () != 0)
+        {
+          errno = EPIPE;
+          return -1;
+        }
+
+      ring.writer_waiting_.store (1);
+      if (tail - ring.head_.load () != ring_size)
+        break;
+
+      if (this->wait (this->out_space_handle_,
+                      timeout == 0 ? 0 : &deadline) == -1)
+        {
+          ring.writer_waiting_.store (0);
+          return -1;
+        }
+      this->clear (this->out_space_handle_);
+    }
+
+  ring.writer_waiting_.store (0);
+  return 1;
+}
+
+bool
+TAO_SHMRIOP_Segment::space_signaled (void)
+{
+  if (this->out_space_handle_ == ACE_INVALID_HANDLE)
+    return false;
+
+  // The eventfd is non-blocking, reading it fails if it is not
+  // signaled.
+  ACE_UINT64 count = 0;
+  return ACE_OS::read (this->out_space_handle_, &count, sizeof count)
+    == static_cast<ssize_t> (sizeof count);
+}
+
+ssize_t
+TAO_SHMRIOP_Segment::recv (char *buf,
+                           size_t len,
+                           const ACE_Time_Value *timeout,
+                           bool reactive)
+{
+  if (this->in_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  Ring &ring = *this->in_;
+
+  // The reactor only calls when the eventfd is signaled, it is set
+  // again below if data is left.
+  if (reactive)
+    this->clear (this->in_data_handle_);
+
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  ACE_UINT32 head = ring.head_.load (std::memory_order_relaxed);
+
+  auto has_data = [&] ()
+    {
+      return ring.tail_.load (std::memory_order_acquire) != head
+        || ring.closed_.load (std::memory_order_relaxed) != 0;
+    };
+
+  for (;;)
+    {
+      ACE_UINT32 const available =
+        ring.tail_.load (std::memory_order_acquire) - head;
+
+      if (available > 0)
+        {
+          size_t const n = len < available ? len : available;
+          size_t const offset = head & this->mask_;
+          size_t const ring_size = this->mask_ + 1;
+          size_t const first =
+            n < ring_size - offset ? n : ring_size - offset;
+
+          ACE_OS::memcpy (buf, this->in_data_ + offset, first);
+          if (first < n)
+            ACE_OS::memcpy (buf + first, this->in_data_, n - first);
+
+          head += static_cast<ACE_UINT32> (n);
+          ring.head_.store (head);
+
+          if (ring.writer_waiting_.load () != 0
+              && ring.writer_waiting_.exchange (0) != 0)
+            this->signal (this->in_space_handle_);
+
+          if (reactive)
+            {
+              // Have the writer signal the next message, and signal
+              // what is left ourselves.
+              ring.reader_waiting_.store (1);
+              if (ring.tail_.load () != head)
+                this->signal (this->in_data_handle_);
+            }
+
+          return static_cast<ssize_t> (n);
+        }
+
+      if (ring.closed_.load () != 0)
+        return 0;
+
+      if (reactive && timeout == 0)
+        {
+          ring.reader_waiting_.store (1);
+          if (ring.tail_.load () != head)
+            continue;
+
+          // The reactor also wakes us up when the peer died without
+          // closing the connection.
+          if (this->peer_closed ())
+            return 0;
+
+          errno = EWOULDBLOCK;
+          return -1;
+        }
+
+      if (this->spin (this->recv_spin_, has_data))
+        continue;
+
+      ring.reader_waiting_.store (1);
+      if (!has_data ())
+        {
+          if (this->wait (this->in_data_handle_,
+                          timeout == 0 ? 0 : &deadline) == -1)
+            return -1;
+          this->clear (this->in_data_handle_);
+        }
+
+      if (!reactive)
+        ring.reader_waiting_.store (0);
+    }
+}
+
+void
+TAO_SHMRIOP_Segment::shutdown (void)
+{
+  if (this->header_ == 0)
+    return;
+
+  this->in_->closed_.store (1);
+  this->out_->closed_.store (1);
+
+  // Wake the peer up whether it reads or waits for space.
+  this->signal (this->out_data_handle_);
+  this->signal (this->in_space_handle_);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_SHMRIOP == 1 */
@@ -0,0 +1,229 @@
+// -*- C++ -*-
+
+// ===================================================================
+/**
+ *  @file   SHMRIOP_Segment.h
+ *
+ *  Shared memory ring buffers of a SHMRIOP connection.
+ */
+// ===================================================================
+
+#ifndef TAO_SHMRIOP_SEGMENT_H
+#define TAO_SHMRIOP_SEGMENT_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if TAO_HAS_SHMRIOP == 1
+
+#include "tao/Strategies/strategies_export.h"
+#include "tao/Versioned_Namespace.h"
+#include "ace/os_include/sys/os_uio.h"
+#include "ace/Time_Value.h"
+#include "ace/LSOCK_Stream.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_SHMRIOP_Segment
+ *
+ * @brief The shared memory segment of a SHMRIOP connection.
+ *
+ * The segment holds one single producer, single consumer ring buffer
+ * in each direction.  The positions of a ring are only written by one
+ * side, so sending or receiving a message only copies it in or out of
+ * the ring, without any lock or system call as long as the peer is
+ * running.
+ *
+ * A message is marshaled into the blocks of its CDR stream as for the
+ * other protocols and send() copies it into the ring, the copy a
+ * socket makes into the kernel.  Marshaling straight into the ring
+ * would save it, but TAO_Transport queues, fragments and resends the
+ * blocks of a message, and the ring could only take their place if
+ * it had room for the whole message before it is marshaled.
+ *
+ * A reader that finds its ring empty spins for a while, then flags
+ * itself as waiting and parks on an eventfd that the writer signals
+ * only when it sees that flag.  A writer that finds the ring full does
+ * the same with a second eventfd.  The amount of spinning adapts to
+ * how often it was enough and there is none on single processor
+ * machines.
+ *
+ * The server side creates the segment and the four eventfds and
+ * passes them to the client over the UNIX domain socket of the
+ * connection, which is not used afterwards except to notice that the
+ * peer went away.  handle() is an epoll descriptor watching the data
+ * eventfd, the space eventfd of the outgoing ring and that socket, so
+ * the reactor wakes up for new data, for room to flush queued output
+ * and when the peer dies.
+ */
+class TAO_Strategies_Export TAO_SHMRIOP_Segment
+{
+public:
+  TAO_SHMRIOP_Segment (void);
+
+  /// Unmap the segment and close the eventfds.
+  ~TAO_SHMRIOP_Segment (void);
+
+  /// Server side: create a segment with two rings of @a ring_size
+  /// bytes and send its descriptors over @a peer.
+  int create (const ACE_LSOCK_Stream &peer, size_t ring_size);
+
+  /// Client side: receive the descriptors of the segment from @a peer
+  /// and map it.
+  int attach (const ACE_LSOCK_Stream &peer);
+
+  /**
+   * Copy @a iov into the ring.  If the ring is full and @a reactive
+   * is set this returns what was copied so far, or -1 with @c errno
+   * set to @c EWOULDBLOCK, so the transport queues the rest and
+   * flushes it once handle() reports room.  Otherwise it waits as long
+   * as @a timeout allows.  Returns the number of bytes sent or -1.
+   */
+  ssize_t send (const iovec *iov,
+                int iovcnt,
+                const ACE_Time_Value *timeout,
+                bool reactive);
+
+  /// Wait until there is room in the outgoing ring, the peer goes
+  /// away or @a timeout expires.  Returns 1 or -1, as
+  /// ACE::handle_write_ready() does.
+  int wait_for_space (const ACE_Time_Value *timeout);
+
+  /// Has the peer made room in the outgoing ring since send() last
+  /// returned @c EWOULDBLOCK?  Clears the space eventfd.
+  bool space_signaled (void);
+
+  /**
+   * Copy up to @a len bytes out of the ring.  Returns 0 once the peer
+   * has closed the connection and -1 with @c errno set to
+   * @c EWOULDBLOCK if the ring is empty, @a reactive is set and
+   * @a timeout is 0.
+   *
+   * In the @a reactive mode handle() is kept signaled as long as the
+   * ring is not empty, so the data is read from the reactor.
+   */
+  ssize_t recv (char *buf,
+                size_t len,
+                const ACE_Time_Value *timeout,
+                bool reactive);
+
+  /// Flag the connection as closed and wake the peer up.
+  void shutdown (void);
+
+  /// The epoll descriptor that is readable when there is data to
+  /// read, room to write after a full ring or the peer went away, or
+  /// ACE_INVALID_HANDLE before create() or attach().
+  ACE_HANDLE handle (void) const;
+
+private:
+  /// The positions and flags of a ring, each written by one side
+  /// only on a cache line of its own.
+  struct Ring
+  {
+    /// Bytes read so far, written by the reader.
+    std::atomic<ACE_UINT32> head_;
+    char pad0_[60];
+
+    /// Bytes written so far, written by the writer.
+    std::atomic<ACE_UINT32> tail_;
+    char pad1_[60];
+
+    /// Set while the reader, or the writer, is about to park.
+    std::atomic<ACE_UINT32> reader_waiting_;
+    char pad2_[60];
+    std::atomic<ACE_UINT32> writer_waiting_;
+    char pad3_[60];
+
+    /// Set by the side that closes the connection.
+    std::atomic<ACE_UINT32> closed_;
+    char pad4_[60];
+  };
+
+  /// The start of the segment, followed by the data of both rings.
+  struct Header
+  {
+    ACE_UINT32 magic_;
+    ACE_UINT32 ring_size_;
+    char pad_[56];
+
+    /// Ring 0 carries the messages of the client, ring 1 those of the
+    /// server.
+    Ring rings_[2];
+  };
+
+  enum
+    {
+      /// Number of descriptors passed to the client: the segment and
+      /// the data and space eventfds of each ring.
+      HANDLE_COUNT = 5
+    };
+
+  /// Map the segment and set up the side that uses ring @a out to
+  /// send.
+  int map (ACE_HANDLE shm, size_t size, int out);
+
+  /// Create the epoll descriptor returned by handle().
+  int open_poll_handle (void);
+
+  /// Wait until @a handle is signaled, the peer goes away or
+  /// @a deadline passes.
+  int wait (ACE_HANDLE handle, const ACE_Time_Value *deadline);
+
+  /// Has the peer closed its end of the socket, or died?
+  bool peer_closed (void) const;
+
+  /// Signal or clear an eventfd.
+  static void signal (ACE_HANDLE handle);
+  static void clear (ACE_HANDLE handle);
+
+  /// Spin until @a done returns true, at most @a limit times, and
+  /// adapt @a limit to the outcome.
+  template <typename Predicate>
+  bool spin (unsigned int &limit, Predicate done);
+
+  void release (void);
+
+  Header *header_;
+  size_t size_;
+  ACE_UINT32 mask_;
+
+  Ring *in_;
+  Ring *out_;
+  char *in_data_;
+  char *out_data_;
+
+  /// Data and space eventfds of the ring read from and of the ring
+  /// written to.
+  ACE_HANDLE in_data_handle_;
+  ACE_HANDLE in_space_handle_;
+  ACE_HANDLE out_data_handle_;
+  ACE_HANDLE out_space_handle_;
+
+  /// The socket of the connection, not owned.
+  ACE_HANDLE peer_;
+
+  /// See handle().
+  ACE_HANDLE poll_handle_;
+
+  /// Number of spins before parking in send() and recv(), and the
+  /// largest one.
+  unsigned int send_spin_;
+  unsigned int recv_spin_;
+  unsigned int max_spin_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_SHMRIOP == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_SHMRIOP_SEGMENT_H */
@@ -3,6 +3,7 @@
 
 #include "tao/Strategies/UIOP_Factory.h"
 #include "tao/Strategies/SHMIOP_Factory.h"
+#include "tao/Strategies/SHMRIOP_Factory.h"
 #include "tao/Strategies/DIOP_Factory.h"
 #include "tao/Strategies/SCIOP_Factory.h"
 #include "tao/Strategies/COIOP_Factory.h"
@@ -55,6 +56,10 @@ TAO_Resource_Factory_Changer::TAO_Resource_Factory_Changer (void)
   ACE_Service_Config::process_directive (ace_svc_desc_TAO_SHMIOP_Protocol_Factory);
 #endif /* TAO_HAS_SHMIOP == 1 */
 
+#if TAO_HAS_SHMRIOP == 1
+  ACE_Service_Config::process_directive (ace_svc_desc_TAO_SHMRIOP_Protocol_Factory);
+#endif /* TAO_HAS_SHMRIOP == 1 */
+
 #if TAO_HAS_DIOP == 1
   ACE_Service_Config::process_directive (ace_svc_desc_TAO_DIOP_Protocol_Factory);
 #endif /* TAO_HAS_DIOP == 1 */
@@ -218,6 +223,15 @@ TAO_Advanced_Resource_Factory::init (int argc, ACE_TCHAR** argv)
               this->cdr_allocator_type_ = TAO_ALLOCATOR_THREAD_LOCK;
               this->use_locked_data_blocks_ = 1;
             }
+          else if (ACE_OS::strcasecmp (current_arg,
+                                       ACE_TEXT("slab")) == 0)
+            {
+              // The slab allocators are created by the default
+              // factory, they can be used by any thread.
+              this->cdr_allocator_type_ = TAO_ALLOCATOR_THREAD_LOCK;
+              this->use_locked_data_blocks_ = 1;
+              this->input_cdr_slab_allocator_ = true;
+            }
           else
             {
               this->report_option_value_error (ACE_TEXT("-ORBInputCDRAllocator"), current_arg);
@@ -358,6 +372,12 @@ TAO_Advanced_Resource_Factory::init_protocol_factories (void)
         return -1;
 #endif /* TAO_HAS_SHMIOP && TAO_HAS_SHMIOP != 0 */
 
+#if defined (TAO_HAS_SHMRIOP) && (TAO_HAS_SHMRIOP != 0)
+      if (TAO::details::load_protocol_factory <TAO_SHMRIOP_Protocol_Factory> (
+          this->protocol_factories_, "SHMRIOP_Factory") == -1)
+        return -1;
+#endif /* TAO_HAS_SHMRIOP && TAO_HAS_SHMRIOP != 0 */
+
 #if defined (TAO_HAS_DIOP) && (TAO_HAS_DIOP != 0)
       if (TAO::details::load_protocol_factory <TAO_DIOP_Protocol_Factory> (
           this->protocol_factories_, "DIOP_Factory") == -1)
@@ -17,6 +17,7 @@
 #include "tao/Policy_Set.h"
 #include "tao/SystemException.h"
 #include "tao/CDR.h"
+#include "tao/Transport.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/Stub.inl"
@@ -41,6 +42,7 @@ TAO_Stub::TAO_Stub (const char *repository_id,
   , forward_profiles_ (nullptr)
   , forward_profiles_perm_ (nullptr)
   , profile_in_use_ (nullptr)
+  , transport_ (nullptr)
   , profile_success_ (false)
   , refcount_ (1)
 #if (TAO_HAS_CORBA_MESSAGING == 1)
@@ -96,6 +98,10 @@ TAO_Stub::~TAO_Stub ()
       this->profile_in_use_ = nullptr;
     }
 
+  TAO_Transport * const transport = this->transport_.exchange (nullptr);
+  if (transport != nullptr)
+    transport->remove_reference ();
+
 #if (TAO_HAS_CORBA_MESSAGING == 1)
   delete this->policies_;
 #endif
@@ -355,9 +361,36 @@ TAO_Stub::set_profile_in_use_i (TAO_Profile *pfile)
   if (old)
     old->_decr_refcnt ();
 
+  // The kept transport was connected to the old profile.
+  TAO_Transport * const transport = this->transport_.exchange (nullptr);
+  if (transport != nullptr)
+    transport->remove_reference ();
+
   return this->profile_in_use_;
 }
 
+TAO_Transport *
+TAO_Stub::take_transport ()
+{
+  if (this->transport_.load (std::memory_order_relaxed) == nullptr)
+    return nullptr;
+
+  return this->transport_.exchange (nullptr);
+}
+
+void
+TAO_Stub::keep_transport (TAO_Transport *transport)
+{
+  if (this->transport_.load (std::memory_order_relaxed) != nullptr)
+    return;
+
+  transport->add_reference ();
+
+  TAO_Transport *expected = nullptr;
+  if (!this->transport_.compare_exchange_strong (expected, transport))
+    transport->remove_reference ();
+}
+
 void
 TAO_Stub::forward_back_one ()
 {
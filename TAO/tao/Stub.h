@@ -36,6 +36,7 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 class TAO_Abstract_ServantBase;
 class TAO_Policy_Set;
 class TAO_Profile;
+class TAO_Transport;
 
 namespace TAO
 {
@@ -125,6 +126,17 @@ public:
   /// Return the ObjectKey
   const TAO::ObjectKey &object_key () const;
 
+  /// Take the transport kept by keep_transport(), with the reference
+  /// the stub held on it, or return nullptr if there is none.  Lock
+  /// free.
+  TAO_Transport *take_transport ();
+
+  /// Keep a reference to @a transport, which an invocation with the
+  /// profile in use just completed on, so the next invocation can try
+  /// it first.  Does nothing if a transport is kept already.  Lock
+  /// free.
+  void keep_transport (TAO_Transport *transport);
+
   /**
    * Copy of the profile list, user must free memory when done.
    * although the user can call make_profiles() then reorder
@@ -373,6 +385,11 @@ protected:
   /// This is the profile that we are currently sending/receiving with.
   TAO_Profile *profile_in_use_;
 
+  /// Transport of the last invocation, used with
+  /// -ORBStubTransportAffinity, dropped whenever the profile in use
+  /// changes.  The stub holds a reference on it.
+  std::atomic<TAO_Transport *> transport_;
+
   /// Mutex to protect access to the forwarding profile.
   TAO_SYNCH_MUTEX profile_lock_;
 
@@ -148,6 +148,8 @@ namespace TAO
 
         TAO_OutputCDR &cdr = transport->out_stream ();
 
+        CDR_Thread_Cache_Guard cache_guard (cdr, this->stub ()->orb_core ());
+
         CDR_Byte_Order_Guard cdr_guard (cdr, this->_tao_byte_order ());
 
         cdr.message_attributes (this->details_.request_id (),
@@ -183,6 +185,8 @@ namespace TAO
 
         cdr_guard.reset (); // CDR_Byte_Order_Guard
 
+        cache_guard.reset (); // CDR_Thread_Cache_Guard
+
         ace_mon.release();
 
 #if TAO_HAS_INTERCEPTORS == 1
@@ -813,6 +817,9 @@ namespace TAO
             TAO_OutputCDR &cdr = transport->out_stream ();
 
             {
+              CDR_Thread_Cache_Guard cache_guard (cdr,
+                                                  this->stub ()->orb_core ());
+
               CDR_Byte_Order_Guard cdr_guard (cdr, this->_tao_byte_order ());
 
               cdr.message_attributes (this->details_.request_id (),
@@ -879,7 +886,7 @@ namespace TAO
                       s = TAO_INVOKE_FAILURE;
                     }
                 }
-            } // CDR_Byte_Order_Guard
+            } // CDR_Byte_Order_Guard, CDR_Thread_Cache_Guard
           }
 
 #if TAO_HAS_INTERCEPTORS == 1
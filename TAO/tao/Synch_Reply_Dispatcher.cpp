@@ -122,4 +122,10 @@ TAO_Synch_Reply_Dispatcher::connection_closed ()
                        this->orb_core_->leader_follower ());
 }
 
+int
+TAO_Synch_Reply_Dispatcher::state_changed_lock_free (LFS_STATE new_state)
+{
+  return this->state_changed_lock_free_i (new_state);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -61,6 +61,11 @@ public:
   virtual void reply_timed_out (void);
 
 protected:
+  /// The transport holds a reference to the dispatcher while it
+  /// dispatches the reply or reports the closed connection, so the
+  /// state can change without the lock of the Leader/Followers set.
+  virtual int state_changed_lock_free (LFS_STATE new_state);
+
   /// The service context list
   IOP::ServiceContextList &reply_service_info_;
 
@@ -53,6 +53,7 @@ TAO_ServerRequest::TAO_ServerRequest (TAO_GIOP_Message_Base *mesg_base,
     operation_ (nullptr),
     operation_len_ (0),
     release_operation_ (false),
+    operation_hash_ (0),
     is_forwarded_ (false),
     incoming_ (&input),
     outgoing_ (&output),
@@ -64,6 +65,8 @@ TAO_ServerRequest::TAO_ServerRequest (TAO_GIOP_Message_Base *mesg_base,
     // @@ We shouldn't be using GIOP specific types here. Need to be revisited.
     reply_status_ (GIOP::NO_EXCEPTION),
     orb_core_ (orb_core),
+    service_context_buffer_ (nullptr),
+    service_context_length_ (0),
     request_id_ (0),
     profile_ (orb_core),
     requesting_principal_ (nullptr),
@@ -97,6 +100,7 @@ TAO_ServerRequest::TAO_ServerRequest (TAO_GIOP_Message_Base *mesg_base,
     operation_ (CORBA::string_dup (operation)),
     operation_len_ (operation == nullptr ? 0 : std::strlen (operation)),
     release_operation_ (true),
+    operation_hash_ (0),
     is_forwarded_ (false),
     incoming_ (nullptr),
     outgoing_ (&output),
@@ -107,6 +111,8 @@ TAO_ServerRequest::TAO_ServerRequest (TAO_GIOP_Message_Base *mesg_base,
     is_dsi_ (false),
     reply_status_ (GIOP::NO_EXCEPTION),
     orb_core_ (orb_core),
+    service_context_buffer_ (nullptr),
+    service_context_length_ (0),
     request_id_ (request_id),
     profile_ (orb_core),
     requesting_principal_ (nullptr),
@@ -133,6 +139,7 @@ TAO_ServerRequest::TAO_ServerRequest (TAO_ORB_Core * orb_core,
     operation_ (details.opname ()),
     operation_len_ (details.opname_len ()),
     release_operation_ (false),
+    operation_hash_ (0),
     is_forwarded_ (false),
     incoming_ (nullptr),
     outgoing_ (nullptr),
@@ -145,6 +152,8 @@ TAO_ServerRequest::TAO_ServerRequest (TAO_ORB_Core * orb_core,
     is_dsi_ (false),
     reply_status_ (GIOP::NO_EXCEPTION),
     orb_core_ (orb_core),
+    service_context_buffer_ (nullptr),
+    service_context_length_ (0),
     request_id_ (0),
     profile_ (orb_core),
     requesting_principal_ (nullptr),
@@ -220,6 +229,87 @@ TAO_ServerRequest::reply_service_context ()
     }
 }
 
+void
+TAO_ServerRequest::demarshal_request_service_context ()
+{
+  // The view points into the incoming stream, which was aligned on
+  // the same boundaries, so a stream over the view decodes the same
+  // way.  A data block on the stack avoids allocating one; it is
+  // marked DONT_DELETE so the context data is copied out of it.
+  ACE_Data_Block db (this->service_context_length_,
+                     ACE_Message_Block::MB_DATA,
+                     const_cast<char *> (this->service_context_buffer_),
+                     nullptr,
+                     nullptr,
+                     ACE_Message_Block::DONT_DELETE,
+                     nullptr);
+
+  ACE_CDR::Octet major = 0;
+  ACE_CDR::Octet minor = 0;
+  this->incoming_->get_version (major, minor);
+
+  TAO_InputCDR cdr (&db,
+                    ACE_Message_Block::DONT_DELETE,
+                    0,
+                    this->service_context_length_,
+                    this->incoming_->byte_order (),
+                    major,
+                    minor,
+                    this->orb_core_);
+
+  this->service_context_buffer_ = nullptr;
+
+  if (!(cdr >> this->request_service_context_.service_info ()))
+    {
+      throw ::CORBA::MARSHAL (0, CORBA::COMPLETED_NO);
+    }
+}
+
+bool
+TAO_ServerRequest::has_request_service_context (IOP::ServiceId id)
+{
+  if (this->service_context_buffer_ == nullptr)
+    {
+      const IOP::ServiceContext *context = nullptr;
+      return this->request_service_context_.get_context (id, &context) == 1;
+    }
+
+  ACE_Data_Block db (this->service_context_length_,
+                     ACE_Message_Block::MB_DATA,
+                     const_cast<char *> (this->service_context_buffer_),
+                     nullptr,
+                     nullptr,
+                     ACE_Message_Block::DONT_DELETE,
+                     nullptr);
+
+  TAO_InputCDR cdr (&db,
+                    ACE_Message_Block::DONT_DELETE,
+                    static_cast<size_t> (0),
+                    this->service_context_length_,
+                    this->incoming_->byte_order ());
+
+  CORBA::ULong count = 0;
+  if (!cdr.read_ulong (count))
+    return false;
+
+  for (CORBA::ULong i = 0; i != count; ++i)
+    {
+      CORBA::ULong context_id = 0;
+      CORBA::ULong length = 0;
+
+      if (!cdr.read_ulong (context_id) || !cdr.read_ulong (length))
+        return false;
+
+      if (context_id == id)
+        return true;
+
+      if (!cdr.skip_bytes (length))
+        return false;
+    }
+
+  return false;
+}
+
 
 void
 TAO_ServerRequest::init_reply ()
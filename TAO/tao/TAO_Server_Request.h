@@ -139,6 +139,9 @@ public:
 
   /// Return the length of the operation.
   size_t operation_length () const;
+
+  /// Return the hash of the operation name, computing it on first use.
+  ACE_UINT64 operation_hash () const;
   //@}
 
   /// Return the underlying ORB.
@@ -189,9 +192,21 @@ public:
 
   TAO::ObjectKey &object_key ();
 
-  /// Return the request TAO_Service_Context
+  /// Return the request TAO_Service_Context, demarshaling it first
+  /// if the request was parsed with request_service_context_view().
   TAO_Service_Context &request_service_context ();
 
+  /// Let request_service_context() demarshal the request service
+  /// contexts from the @a length octets at @a buffer when first
+  /// asked for.  @a buffer is part of the incoming stream and has
+  /// to stay valid for the lifetime of the request.
+  void request_service_context_view (const char *buffer, size_t length);
+
+  /// Does the request carry a service context with the id @a id?
+  /// Unlike request_service_context() this does not demarshal the
+  /// service contexts.
+  bool has_request_service_context (IOP::ServiceId id);
+
   /// Return the reply TAO_Service_Context
   TAO_Service_Context &reply_service_context ();
 
@@ -299,6 +314,10 @@ private:
   /// to be the target of a clone operation.
   TAO_ServerRequest ();
 
+  /// Demarshal the request service contexts left in the incoming
+  /// stream by request_service_context_view().
+  void demarshal_request_service_context ();
+
   TAO_GIOP_Message_Base *mesg_base_;
 
   /// Operation name.
@@ -310,6 +329,9 @@ private:
   /// Do we own the memory associated with operation_?
   bool release_operation_;
 
+  /// Hash of the operation name, zero until it has been computed.
+  mutable ACE_UINT64 operation_hash_;
+
   CORBA::Object_var forward_location_;
 
   bool is_forwarded_;
@@ -354,6 +376,13 @@ private:
   TAO_Service_Context request_service_context_;
   TAO_Service_Context reply_service_context_;
 
+  /// Marshaled request service contexts not demarshaled into
+  /// @c request_service_context_ yet, zero when there are none.
+  const char *service_context_buffer_;
+
+  /// Length of @c service_context_buffer_.
+  size_t service_context_length_;
+
   /// Unique identifier for a request.
   CORBA::ULong request_id_;
 
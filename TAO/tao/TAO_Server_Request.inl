@@ -1,5 +1,6 @@
 // -*- C++ -*-
 #include "tao/GIOP_Utils.h"
+#include "tao/Operation_Hash.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -10,6 +11,7 @@ TAO_ServerRequest::TAO_ServerRequest (void)
     operation_ (0),
     operation_len_ (0),
     release_operation_ (false),
+    operation_hash_ (0),
     is_forwarded_ (false),
     incoming_ (0),
     outgoing_ (0),
@@ -20,6 +22,8 @@ TAO_ServerRequest::TAO_ServerRequest (void)
     is_dsi_ (false),
     reply_status_ (GIOP::NO_EXCEPTION),
     orb_core_ (0),
+    service_context_buffer_ (0),
+    service_context_length_ (0),
     request_id_ (0),
     profile_ (0),
     requesting_principal_ (0),
@@ -71,6 +75,7 @@ TAO_ServerRequest::operation (const char *operation,
   this->operation_len_ = (length == 0 ? std::strlen (operation) : length);
   this->release_operation_ = release;
   this->operation_ = operation;
+  this->operation_hash_ = 0;
 }
 
 ACE_INLINE size_t
@@ -79,6 +84,16 @@ TAO_ServerRequest::operation_length () const
   return this->operation_len_;
 }
 
+ACE_INLINE ACE_UINT64
+TAO_ServerRequest::operation_hash () const
+{
+  if (this->operation_hash_ == 0)
+    this->operation_hash_ =
+      TAO::operation_hash (this->operation (), this->operation_len_);
+
+  return this->operation_hash_;
+}
+
 ACE_INLINE CORBA::Boolean
 TAO_ServerRequest::response_expected () const
 {
@@ -152,9 +167,20 @@ TAO_ServerRequest::object_key (void)
 ACE_INLINE TAO_Service_Context &
 TAO_ServerRequest::request_service_context (void)
 {
+  if (this->service_context_buffer_ != 0)
+    this->demarshal_request_service_context ();
+
   return this->request_service_context_;
 }
 
+ACE_INLINE void
+TAO_ServerRequest::request_service_context_view (const char *buffer,
+                                                 size_t length)
+{
+  this->service_context_buffer_ = buffer;
+  this->service_context_length_ = length;
+}
+
 ACE_INLINE IOP::ServiceContextList &
 TAO_ServerRequest::reply_service_info (void)
 {
@@ -40,7 +40,8 @@ TAO_Thread_Lane_Resources::TAO_Thread_Lane_Resources (
             orb_core.resource_factory ()->create_purging_strategy (),
             orb_core.resource_factory ()->cache_maximum (),
             orb_core.resource_factory ()->locked_transport_cache (),
-            orb_core.orbid ()));
+            orb_core.orbid (),
+            orb_core.resource_factory ()->transport_cache_shards ()));
 }
 
 TAO_Thread_Lane_Resources::~TAO_Thread_Lane_Resources ()
@@ -161,7 +162,8 @@ TAO_Thread_Lane_Resources::leader_follower ()
           // Create a new Leader Follower object.
           ACE_NEW_RETURN (this->leader_follower_,
                           TAO_Leader_Follower (&this->orb_core_,
-                                               this->new_leader_generator_),
+                                               this->new_leader_generator_,
+                                               this->orb_core_.resource_factory ()->lock_free_follower_set ()),
                           *this->leader_follower_);
         }
     }
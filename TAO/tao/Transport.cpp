@@ -156,6 +156,11 @@ TAO_Transport::TAO_Transport (CORBA::ULong tag,
   , stats_ (nullptr)
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
   , flush_in_post_open_ (false)
+  , coalesce_bytes_ (orb_core->resource_factory ()->transport_coalescing_bytes ())
+  , coalesce_window_ (0, orb_core->resource_factory ()->transport_coalescing_window ())
+  , last_async_send_ (ACE_Time_Value::zero)
+  , coalescing_ (false)
+  , coalesced_bytes_ (0)
 {
   ACE_NEW (this->messaging_object_,
             TAO_GIOP_Message_Base (orb_core,
@@ -550,6 +555,12 @@ TAO_Transport::make_idle ()
   return this->transport_cache_manager ().make_idle (this->cache_map_entry_);
 }
 
+bool
+TAO_Transport::reserve (TAO_Transport_Descriptor_Interface *desc)
+{
+  return this->transport_cache_manager ().reserve (this->cache_map_entry_, desc);
+}
+
 int
 TAO_Transport::update_transport ()
 {
@@ -1083,6 +1094,10 @@ TAO_Transport::drain_queue_i (TAO::Transport::Drain_Constraints const & dc)
   // call.
   this->sent_byte_count_ = 0;
 
+  // The messages held back so far are written now, the next ones
+  // start a new batch.
+  this->coalesced_bytes_ = 0;
+
   // Avoid calling this expensive function each time through the loop. Instead
   // we'll assume that the time is unlikely to change much during the loop.
   // If we are forced to send in the loop then we'll recompute the time.
@@ -1169,6 +1184,8 @@ TAO_Transport::drain_queue_i (TAO::Transport::Drain_Constraints const & dc)
           this->reset_flush_timer ();
         }
 
+      this->coalescing_ = false;
+
       return DR_QUEUE_EMPTY;
     }
 
@@ -1209,6 +1226,9 @@ TAO_Transport::cleanup_queue_i ()
       i->destroy ();
     }
 
+  this->coalescing_ = false;
+  this->coalesced_bytes_ = 0;
+
   if (TAO_debug_level > 4)
     {
       TAOLIB_DEBUG ((LM_DEBUG,
@@ -1421,6 +1441,11 @@ TAO_Transport::send_asynchronous_message_i (TAO_Stub *stub,
         }
     }
 
+  if ((try_sending_first || this->coalescing_) && this->coalesce_i ())
+    {
+      return this->coalesce_message_i (stub, message_block, max_wait_time);
+    }
+
   bool partially_sent = false;
   bool timeout_encountered = false;
 
@@ -1646,6 +1671,147 @@ TAO_Transport::send_asynchronous_message_i (TAO_Stub *stub,
   return 0;
 }
 
+bool
+TAO_Transport::coalesce_i ()
+{
+  // Coalescing is off, do not even read the clock.
+  if (this->coalesce_bytes_ == 0)
+    {
+      return false;
+    }
+
+  ACE_Time_Value const now = ACE_High_Res_Timer::gettimeofday_hr ();
+  bool const back_to_back = now - this->last_async_send_ < this->coalesce_window_;
+  this->last_async_send_ = now;
+
+  if (this->coalescing_)
+    {
+      return true;
+    }
+
+  // Hold the message back only if it follows the previous one closely
+  // and a thread will write it when the reactor reports the socket
+  // writable, otherwise send it right away.
+  return back_to_back
+    && this->is_connected_
+    && this->ws_->is_registered ()
+    && this->orb_core_->leader_follower ().leader_available ();
+}
+
+int
+TAO_Transport::coalesce_message_i (TAO_Stub *stub,
+                                   const ACE_Message_Block *message_block,
+                                   ACE_Time_Value *max_wait_time)
+{
+  if (this->queue_message_i (message_block, max_wait_time) == -1)
+    {
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - Transport[%d]::")
+                      ACE_TEXT ("coalesce_message_i, ")
+                      ACE_TEXT ("cannot queue message - %m\n"),
+                      this->id ()));
+        }
+      return -1;
+    }
+
+  this->coalesced_bytes_ += message_block->total_length ();
+
+  // The buffering constraints of the request are checked like for any
+  // queued message, a sync scope that wants the request flushed before
+  // returning, such as SYNC_WITH_TRANSPORT, ends the batch.
+  bool must_flush = false;
+  this->check_buffering_constraints_i (stub, must_flush);
+
+  TAO_Flushing_Strategy *flushing_strategy =
+    this->orb_core ()->flushing_strategy ();
+
+  // Keep holding the messages back while a thread runs the event loop
+  if (!must_flush
+      && this->coalesced_bytes_ < this->coalesce_bytes_
+      && this->orb_core_->leader_follower ().leader_available ())
+    {
+      if (this->coalescing_)
+        {
+          return 0;
+        }
+
+      if (flushing_strategy->schedule_output (this) == 0)
+        {
+          if (TAO_debug_level > 6)
+            {
+              TAOLIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("TAO (%P|%t) - Transport[%d]::coalesce_message_i, ")
+                 ACE_TEXT ("holding messages back until the reactor ")
+                 ACE_TEXT ("flushes them\n"),
+                 this->id ()));
+            }
+
+          this->coalescing_ = true;
+          return 0;
+        }
+    }
+
+  // The batch is large enough, the request must be flushed or the
+  // reactor cannot write it, so write it now with a single gather
+  // write.
+  bool const output_scheduled = this->coalescing_;
+
+  if (TAO_debug_level > 6)
+    {
+      TAOLIB_DEBUG ((LM_DEBUG,
+         ACE_TEXT ("TAO (%P|%t) - Transport[%d]::coalesce_message_i, ")
+         ACE_TEXT ("writing %B coalesced bytes\n"),
+         this->id (), this->coalesced_bytes_));
+    }
+
+  TAO::Transport::Drain_Constraints dc (
+      max_wait_time, this->using_blocking_io_for_asynch_messages ());
+
+  Drain_Result const retval = this->drain_queue_i (dc);
+
+  if (retval == DR_ERROR)
+    {
+      return -1;
+    }
+
+  if (retval == DR_QUEUE_EMPTY)
+    {
+      if (output_scheduled)
+        {
+          flushing_strategy->cancel_output (this);
+        }
+      return 0;
+    }
+
+  // ... what could not be written waits for the socket to become
+  // writable again ...
+  if (!this->coalescing_)
+    {
+      int const result = flushing_strategy->schedule_output (this);
+      if (result == TAO_Flushing_Strategy::MUST_FLUSH)
+        {
+          must_flush = true;
+        }
+      else if (result == 0)
+        {
+          this->coalescing_ = true;
+        }
+    }
+
+  // ... unless the request has to be flushed before returning.
+  if (must_flush)
+    {
+      typedef ACE_Reverse_Lock<ACE_Lock> TAO_REVERSE_LOCK;
+      TAO_REVERSE_LOCK reverse (*this->handler_lock_);
+      ACE_GUARD_RETURN (TAO_REVERSE_LOCK, ace_mon, reverse, -1);
+      return flushing_strategy->flush_transport (this, max_wait_time);
+    }
+
+  return 0;
+}
+
 int
 TAO_Transport::queue_message_i (const ACE_Message_Block *message_block,
                                 ACE_Time_Value *max_wait_time, bool back)
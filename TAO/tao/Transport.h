@@ -833,6 +833,10 @@ public:
   /// Cache management
   int make_idle ();
 
+  /// Cache management, mark the transport busy if it is idle and
+  /// cached for a descriptor equivalent to @a desc.
+  bool reserve (TAO_Transport_Descriptor_Interface *desc);
+
   /// Cache management
   int update_transport ();
 
@@ -972,6 +976,26 @@ private:
                                    const ACE_Message_Block *message_block,
                                    ACE_Time_Value *max_wait_time);
 
+  /// Return true if an asynchronous message should be held back to be
+  /// written together with the ones that follow it, see
+  /// coalesce_message_i().  Always false, without reading the clock,
+  /// when coalescing is off.
+  bool coalesce_i ();
+
+  /**
+   * Queue @a message_block behind the messages held back so far and
+   * have the reactor write them all once the socket is writable, or
+   * write them right away when they reach -ORBTransportCoalescing
+   * bytes.  Messages are only held back when they follow each other
+   * within -ORBTransportCoalescingWindow and a thread runs the event
+   * loop, so a lone message is not delayed.  The buffering
+   * constraints of @a stub are checked as for any queued message, and
+   * the batch is flushed at once if they require it.
+   */
+  int coalesce_message_i (TAO_Stub *stub,
+                          const ACE_Message_Block *message_block,
+                          ACE_Time_Value *max_wait_time);
+
   /// A helper method used by send_synchronous_message_i() and
   /// send_reply_message_i(). Reusable code that could be used by both
   /// the methods.
@@ -1219,6 +1243,23 @@ private:
   /// Indicate that flushing needs to be done in post_open()
   bool flush_in_post_open_;
 
+  /// Bytes of asynchronous messages that may be held back to be
+  /// written together, 0 if they are not coalesced.
+  size_t const coalesce_bytes_;
+
+  /// Largest interval between two asynchronous messages for the second
+  /// one to be held back.
+  ACE_Time_Value const coalesce_window_;
+
+  /// When the last asynchronous message was sent.
+  ACE_Time_Value last_async_send_;
+
+  /// Set while held back messages wait for the reactor to report the
+  /// socket writable, with the number of bytes held back since the
+  /// queue was last drained.
+  bool coalescing_;
+  size_t coalesced_bytes_;
+
   /// lock for synchronizing Transport OutputCDR access
   mutable TAO_SYNCH_MUTEX output_cdr_mutex_;
 };
@@ -7,6 +7,7 @@
 #include "ace/ACE.h"
 #include "ace/Reactor.h"
 #include "ace/Lock_Adapter_T.h"
+#include "ace/Unbounded_Set.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/Transport_Cache_Manager_T.inl"
@@ -22,32 +23,129 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO
 {
+  template <typename TT, typename TRDT, typename PSTRAT>
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Entry_Allocator::Entry_Allocator ()
+    : free_list_ (0)
+  {
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Entry_Allocator::~Entry_Allocator ()
+  {
+    while (this->free_list_ != 0)
+      {
+        void *ptr = this->free_list_;
+        this->free_list_ = *static_cast<void **> (ptr);
+        this->ACE_New_Allocator::free (ptr);
+      }
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  void *
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Entry_Allocator::malloc (size_t nbytes)
+  {
+    // The map only allocates entries from us.
+    if (nbytes <= sizeof (HASH_MAP_ENTRY) && this->free_list_ != 0)
+      {
+        void *ptr = this->free_list_;
+        this->free_list_ = *static_cast<void **> (ptr);
+        return ptr;
+      }
+
+    return this->ACE_New_Allocator::malloc (
+      nbytes < sizeof (HASH_MAP_ENTRY) ? sizeof (HASH_MAP_ENTRY) : nbytes);
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  void
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Entry_Allocator::free (void *ptr)
+  {
+    // Only the first word of the entry, part of its key, is
+    // overwritten, the shard in its Cache_IntId stays readable.
+    *static_cast<void **> (ptr) = this->free_list_;
+    this->free_list_ = ptr;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard::Shard ()
+    : lock_ (0)
+  {
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard::~Shard ()
+  {
+    typename ENDPOINT_MAP::iterator const end_iter = this->endpoints_.end ();
+
+    for (typename ENDPOINT_MAP::iterator iter = this->endpoints_.begin ();
+         iter != end_iter;
+         ++iter)
+      {
+        delete (*iter).int_id_;
+      }
+
+    delete this->lock_;
+    this->lock_ = 0;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  int
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard::open (size_t size,
+                                                           bool locked)
+  {
+    if (this->map_.open (size, 0, &this->allocator_) != 0
+        || this->endpoints_.open (size) != 0)
+      return -1;
+
+    if (locked)
+      {
+        ACE_NEW_RETURN (this->lock_,
+                        ACE_Lock_Adapter <TAO_SYNCH_MUTEX> (this->mutex_),
+                        -1);
+      }
+    else
+      {
+        ACE_NEW_RETURN (this->lock_,
+                        ACE_Lock_Adapter<ACE_SYNCH_NULL_MUTEX>,
+                        -1);
+      }
+
+    return 0;
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Transport_Cache_Manager_T (
     int percent,
     purging_strategy* purging_strategy,
     size_t cache_maximum,
     bool locked,
-    const char *orbid)
+    const char *orbid,
+    size_t shards)
     : percent_ (percent)
     , purging_strategy_ (purging_strategy)
-    , cache_map_ (cache_maximum)
-    , cache_lock_ (0)
+    , shards_ (0)
+    , shard_count_ (shards == 0 ? 1 : shards)
+    , current_size_ (0)
+    , next_purge_ (0)
     , cache_maximum_ (cache_maximum)
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
     , purge_monitor_ (0)
     , size_monitor_ (0)
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
   {
-    if (locked)
-      {
-        ACE_NEW (this->cache_lock_,
-                 ACE_Lock_Adapter <TAO_SYNCH_MUTEX> (this->cache_map_mutex_));
-      }
-    else
+    ACE_NEW (this->shards_,
+             Shard[this->shard_count_]);
+
+    for (size_t i = 0; i < this->shard_count_; ++i)
       {
-        ACE_NEW (this->cache_lock_,
-                 ACE_Lock_Adapter<ACE_SYNCH_NULL_MUTEX>);
+        if (this->shards_[i].open (cache_maximum / this->shard_count_ + 1,
+                                   locked) != 0)
+          {
+            delete [] this->shards_;
+            this->shards_ = 0;
+            this->shard_count_ = 0;
+            return;
+          }
       }
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
@@ -75,8 +173,8 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::~Transport_Cache_Manager_T ()
   {
-    delete this->cache_lock_;
-    this->cache_lock_ = 0;
+    delete [] this->shards_;
+    this->shards_ = 0;
 
     delete this->purging_strategy_;
     this->purging_strategy_ = 0;
@@ -89,25 +187,53 @@ namespace TAO
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
   }
 
+  template <typename TT, typename TRDT, typename PSTRAT>
+  typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard *
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::lock_entry (HASH_MAP_ENTRY *&entry)
+  {
+    // The entry may be purged, and even bound again, before we get
+    // the lock, so check that it is still ours once we hold it.
+    for (HASH_MAP_ENTRY *cached_entry = entry;
+         cached_entry != 0;
+         cached_entry = entry)
+      {
+        Shard &shard = this->shards_[cached_entry->item ().shard_];
+
+        if (shard.lock_->acquire () == -1)
+          return 0;
+
+        if (entry == cached_entry)
+          return &shard;
+
+        shard.lock_->release ();
+      }
+
+    return 0;
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   void
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::set_entry_state (HASH_MAP_ENTRY *&entry,
                                             TAO::Cache_Entries_State state)
   {
-    ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->cache_lock_));
-    if (entry != 0)
+    Shard * const shard = this->lock_entry (entry);
+    if (shard != 0)
       {
+        ACE_Guard<ACE_Lock> guard (*shard->lock_, false, 1);
+
         entry->item ().recycle_state (state);
         if (state != ENTRY_UNKNOWN && state != ENTRY_CONNECTING
             && entry->item ().transport ())
           entry->item ().is_connected (
             entry->item ().transport ()->is_connected ());
+        this->requeue_i (entry->item ());
       }
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::bind_i (
+    Shard &shard,
     Cache_ExtId &ext_id,
     Cache_IntId &int_id)
   {
@@ -124,6 +250,9 @@ namespace TAO
     // Get the entry too
     HASH_MAP_ENTRY *entry = 0;
 
+    // Bind the entry with its shard already set, see lock_entry ().
+    int_id.shard_ = &shard - this->shards_;
+
     // Update the purging strategy information while we
     // are holding our lock
     this->purging_strategy_->update_item (*(int_id.transport ()));
@@ -131,7 +260,7 @@ namespace TAO
     bool more_to_do = true;
     while (more_to_do)
       {
-        if (this->cache_map_.current_size () >= cache_maximum_)
+        if (this->current_size () >= cache_maximum_)
           {
             retval = -1;
             if (TAO_debug_level > 0)
@@ -144,12 +273,27 @@ namespace TAO
           }
         else
           {
-            retval = this->cache_map_.bind (ext_id, int_id, entry);
+            retval = shard.map_.bind (ext_id, int_id, entry);
             if (retval == 0)
               {
-                // The entry has been added to cache successfully
-                // Add the cache_map_entry to the transport
-                int_id.transport ()->cache_map_entry (entry);
+                if (this->link_i (shard, ext_id.property (), entry->item ()) != 0)
+                  {
+                    shard.map_.unbind (entry);
+                    retval = -1;
+                    if (TAO_debug_level > 0)
+                      {
+                        TAOLIB_ERROR ((LM_ERROR,
+                          ACE_TEXT("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i, ")
+                          ACE_TEXT("ERROR: unable to index transport\n")));
+                      }
+                  }
+                else
+                  {
+                    // The entry has been added to cache successfully
+                    // Add the cache_map_entry to the transport
+                    int_id.transport ()->cache_map_entry (entry);
+                    ++this->current_size_;
+                  }
                 more_to_do = false;
               }
             else if (retval == 1)
@@ -168,6 +312,7 @@ namespace TAO
                                   (int_id.is_connected () ? "true" : "false")));
 
                     entry->item ().is_connected (int_id.is_connected ());
+                    this->requeue_i (entry->item ());
                     retval = 0;
                     more_to_do = false;
                   }
@@ -271,60 +416,55 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Find_Result
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::find_i (
+    Shard &shard,
     transport_descriptor_type *prop,
     transport_type *&transport,
     size_t &busy_count)
   {
-    // Get the entry from the Hash Map
     Find_Result found = CACHE_FOUND_NONE;
 
     // Make a temporary object. It does not do a copy.
     Cache_ExtId key (prop);
-    HASH_MAP_ENTRY *entry = 0;
+    Endpoint *endpoint = 0;
     busy_count = 0;
-    int cache_status = 0;
-    HASH_MAP_ENTRY *found_entry = 0;
+    Cache_IntId *found_item = 0;
 
-    // loop until we find a usable transport, or until we've checked
-    // all cached entries for this endpoint
-    while (found != CACHE_FOUND_AVAILABLE && cache_status == 0)
+    if (shard.endpoints_.find (key, endpoint) == 0)
       {
-        entry = 0;
-        cache_status = this->cache_map_.find (key, entry);
-        if (cache_status == 0 && entry)
+        // The available entries come first, so this loops once when
+        // there is one and otherwise checks all cached entries for
+        // this endpoint
+        for (Cache_IntId *item = endpoint->next_;
+             item != endpoint && found != CACHE_FOUND_AVAILABLE;
+             item = item->next_)
           {
-            if (this->is_entry_available_i (*entry))
+            if (this->is_entry_available_i (*item))
               {
                 // Successfully found a transport_type.
                 found = CACHE_FOUND_AVAILABLE;
-                found_entry = entry;
-                entry->item ().recycle_state (ENTRY_BUSY);
+                found_item = item;
 
                 if (TAO_debug_level > 6)
                   {
                     TAOLIB_DEBUG ((LM_DEBUG,
                       ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::find_i, ")
-                      ACE_TEXT ("found available Transport[%d] @hash:index {%d:%d}\n"),
-                      entry->item ().transport ()->id (),
-                      entry->ext_id_.hash (),
-                      entry->ext_id_.index ()));
+                      ACE_TEXT ("found available Transport[%d]\n"),
+                      item->transport ()->id ()));
                   }
               }
-            else if (this->is_entry_connecting_i (*entry))
+            else if (this->is_entry_connecting_i (*item))
               {
                 if (TAO_debug_level > 6)
                   {
                     TAOLIB_DEBUG ((LM_DEBUG,
                       ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::find_i, ")
-                      ACE_TEXT ("found connecting Transport[%d] @hash:index {%d:%d}\n"),
-                      entry->item ().transport ()->id (),
-                      entry->ext_id_.hash (),
-                      entry->ext_id_.index ()));
+                      ACE_TEXT ("found connecting Transport[%d]\n"),
+                      item->transport ()->id ()));
                   }
                 // if this is the first interesting entry
                 if (found != CACHE_FOUND_CONNECTING)
                   {
-                    found_entry = entry;
+                    found_item = item;
                     found = CACHE_FOUND_CONNECTING;
                   }
               }
@@ -333,7 +473,7 @@ namespace TAO
                 // if this is the first busy entry
                 if (found == CACHE_FOUND_NONE && busy_count == 0)
                   {
-                    found_entry = entry;
+                    found_item = item;
                     found = CACHE_FOUND_BUSY;
                   }
                 ++busy_count;
@@ -341,24 +481,22 @@ namespace TAO
                   {
                     TAOLIB_DEBUG ((LM_DEBUG,
                       ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::find_i, ")
-                      ACE_TEXT ("found busy Transport[%d] @hash:index {%d:%d}\n"),
-                      entry->item ().transport ()->id (),
-                      entry->ext_id_.hash (),
-                      entry->ext_id_.index ()
-                      ));
+                      ACE_TEXT ("found busy Transport[%d]\n"),
+                      item->transport ()->id ()));
                   }
               }
           }
-
-        // Bump the index up
-        key.incr_index ();
       }
-    if (found_entry != 0)
+
+    if (found_item != 0)
     {
-      transport = found_entry->item ().transport ();
+      transport = found_item->transport ();
       transport->add_reference ();
       if (found == CACHE_FOUND_AVAILABLE)
         {
+          found_item->recycle_state (ENTRY_BUSY);
+          this->requeue_i (*found_item);
+
           // Update the purging strategy information while we
           // are holding our lock
           this->purging_strategy_->update_item (*transport);
@@ -372,21 +510,49 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::make_idle_i (HASH_MAP_ENTRY *entry)
   {
     entry->item ().recycle_state (ENTRY_IDLE_AND_PURGABLE);
+    this->requeue_i (entry->item ());
 
     return 0;
   }
 
+  template <typename TT, typename TRDT, typename PSTRAT>
+  bool
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::reserve (
+    HASH_MAP_ENTRY *&entry,
+    transport_descriptor_type *prop)
+  {
+    Shard * const shard = this->lock_entry (entry);
+    if (shard == 0)
+      return false;
+
+    ACE_Guard<ACE_Lock> guard (*shard->lock_, false, 1);
+
+    Cache_IntId &int_id = entry->item ();
+
+    if (!this->is_entry_available_i (int_id)
+        || !entry->key ().property ()->is_equivalent (prop))
+      return false;
+
+    int_id.recycle_state (ENTRY_BUSY);
+    this->requeue_i (int_id);
+
+    // Update the purging strategy information while we are holding
+    // our lock
+    this->purging_strategy_->update_item (*int_id.transport ());
+
+    return true;
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::update_entry (HASH_MAP_ENTRY *&entry)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_, -1));
-
-    if (entry == 0)
+    Shard * const shard = this->lock_entry (entry);
+    if (shard == 0)
       return -1;
 
+    ACE_Guard<ACE_Lock> guard (*shard->lock_, false, 1);
+
     purging_strategy *st = this->purging_strategy_;
     (void) st->update_item (*(entry->item ().transport ()));
 
@@ -395,11 +561,13 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::close_i (Connection_Handler_Set &handlers)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::close_i (
+    Shard &shard,
+    Connection_Handler_Set &handlers)
   {
-    HASH_MAP_ITER end_iter = this->cache_map_.end ();
+    HASH_MAP_ITER end_iter = shard.map_.end ();
 
-    for (HASH_MAP_ITER iter = this->cache_map_.begin ();
+    for (HASH_MAP_ITER iter = shard.map_.begin ();
          iter != end_iter;
          ++iter)
       {
@@ -413,8 +581,22 @@ namespace TAO
         (*iter).int_id_.transport ()->cache_map_entry (0);
       }
 
+    typename ENDPOINT_MAP::iterator const endpoints_end =
+      shard.endpoints_.end ();
+
+    for (typename ENDPOINT_MAP::iterator iter = shard.endpoints_.begin ();
+         iter != endpoints_end;
+         ++iter)
+      {
+        delete (*iter).int_id_;
+      }
+
+    this->current_size_ -= shard.map_.current_size ();
+
     // Unbind all the entries in the map
-    this->cache_map_.unbind_all ();
+    shard.endpoints_.unbind_all ();
+    shard.purging_index_.clear ();
+    shard.map_.unbind_all ();
 
     return 0;
   }
@@ -422,11 +604,12 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   bool
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::blockable_client_transports_i (
+    Shard &shard,
     Connection_Handler_Set &h)
   {
-    HASH_MAP_ITER end_iter = this->cache_map_.end ();
+    HASH_MAP_ITER end_iter = shard.map_.end ();
 
-    for (HASH_MAP_ITER iter = this->cache_map_.begin ();
+    for (HASH_MAP_ITER iter = shard.map_.begin ();
          iter != end_iter;
          ++iter)
       {
@@ -438,7 +621,10 @@ namespace TAO
         // Do not mark the entry as closed if we don't have a
         // blockable handler added
         if (retval)
-          (*iter).int_id_.recycle_state (ENTRY_CLOSED);
+          {
+            (*iter).int_id_.recycle_state (ENTRY_CLOSED);
+            this->requeue_i ((*iter).int_id_);
+          }
       }
 
     return true;
@@ -446,10 +632,17 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry_i (HASH_MAP_ENTRY *entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry_i (
+    Shard &shard,
+    HASH_MAP_ENTRY *entry)
   {
+    this->unlink_i (shard, entry->item ());
+
     // Remove the entry from the Map
-    int const retval = this->cache_map_.unbind (entry);
+    int const retval = shard.map_.unbind (entry);
+
+    if (retval == 0)
+      --this->current_size_;
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
     this->size_monitor_->receive (this->current_size ());
@@ -458,17 +651,109 @@ namespace TAO
     return retval;
   }
 
+  template <typename TT, typename TRDT, typename PSTRAT>
+  int
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::link_i (
+    Shard &shard,
+    transport_descriptor_type *prop,
+    Cache_IntId &int_id)
+  {
+    Cache_ExtId key (prop);
+    Endpoint *endpoint = 0;
+
+    if (shard.endpoints_.find (key, endpoint) != 0)
+      {
+        ACE_NEW_RETURN (endpoint, Endpoint, -1);
+        endpoint->next_ = endpoint;
+        endpoint->prev_ = endpoint;
+
+        // The map keeps a deep copy of the key.
+        if (shard.endpoints_.bind (key, endpoint, endpoint->entry_) != 0)
+          {
+            delete endpoint;
+            return -1;
+          }
+      }
+
+    int_id.head_ = endpoint;
+    int_id.next_ = endpoint;
+    int_id.prev_ = endpoint->prev_;
+    int_id.prev_->next_ = &int_id;
+    endpoint->prev_ = &int_id;
+    this->requeue_i (int_id);
+
+    int_id.purging_order_ = int_id.transport ()->purging_order ();
+    shard.purging_index_.insert (
+      std::make_pair (int_id.purging_order_, &int_id));
+
+    return 0;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  void
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::unlink_i (
+    Shard &shard,
+    Cache_IntId &int_id)
+  {
+    if (int_id.head_ == 0)
+      return;
+
+    shard.purging_index_.erase (
+      std::make_pair (int_id.purging_order_, &int_id));
+
+    int_id.prev_->next_ = int_id.next_;
+    int_id.next_->prev_ = int_id.prev_;
+
+    Endpoint * const endpoint = static_cast<Endpoint *> (int_id.head_);
+    int_id.head_ = 0;
+    int_id.next_ = 0;
+    int_id.prev_ = 0;
+
+    // Forget the endpoint with its last entry.
+    if (endpoint->next_ == endpoint)
+      {
+        shard.endpoints_.unbind (endpoint->entry_);
+        delete endpoint;
+      }
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  void
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::requeue_i (Cache_IntId &int_id)
+  {
+    Cache_IntId * const head = int_id.head_;
+    if (head == 0)
+      return;
+
+    int_id.prev_->next_ = int_id.next_;
+    int_id.next_->prev_ = int_id.prev_;
+
+    if (this->is_entry_available_i (int_id))
+      {
+        int_id.prev_ = head;
+        int_id.next_ = head->next_;
+      }
+    else
+      {
+        int_id.prev_ = head->prev_;
+        int_id.next_ = head;
+      }
+
+    int_id.prev_->next_ = &int_id;
+    int_id.next_->prev_ = &int_id;
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   bool
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::is_entry_available_i (const HASH_MAP_ENTRY &entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::is_entry_available_i (const Cache_IntId &int_id)
   {
-    Cache_Entries_State entry_state = entry.int_id_.recycle_state ();
+    Cache_Entries_State entry_state = int_id.recycle_state ();
     bool result = (entry_state == ENTRY_IDLE_AND_PURGABLE);
 
-    if (result && entry.int_id_.transport () != 0)
+    if (result && int_id.transport () != 0)
     {
       // if it's not connected, it's not available
-      result = entry.int_id_.is_connected ();
+      result = int_id.is_connected ();
     }
 
     if (TAO_debug_level > 8)
@@ -476,7 +761,7 @@ namespace TAO
         TAOLIB_DEBUG ((LM_DEBUG,
                     ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::")
                     ACE_TEXT ("is_entry_available_i[%d], %C, state is %C\n"),
-                    entry.int_id_.transport () ? entry.int_id_.transport ()->id () : 0,
+                    int_id.transport () ? int_id.transport ()->id () : 0,
                     (result ? "true" : "false"),
                     Cache_IntId::state_name (entry_state)));
       }
@@ -486,10 +771,10 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   bool
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::is_entry_purgable_i (HASH_MAP_ENTRY &entry)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::is_entry_purgable_i (Cache_IntId &int_id)
   {
-    Cache_Entries_State const entry_state = entry.int_id_.recycle_state ();
-    transport_type* transport = entry.int_id_.transport ();
+    Cache_Entries_State const entry_state = int_id.recycle_state ();
+    transport_type* transport = int_id.transport ();
     bool const result = (entry_state == ENTRY_IDLE_AND_PURGABLE ||
                          entry_state == ENTRY_PURGABLE_BUT_NOT_IDLE)
                          && transport->can_be_purged ();
@@ -499,7 +784,7 @@ namespace TAO
         TAOLIB_DEBUG ((LM_DEBUG,
                     ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::")
                     ACE_TEXT ("is_entry_purgable_i[%d], %C, state is %C\n"),
-                    entry.int_id_.transport ()->id (),
+                    int_id.transport ()->id (),
                     (result ? "true" : "false"),
                     Cache_IntId::state_name (entry_state)));
       }
@@ -510,16 +795,16 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   bool
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
-    is_entry_connecting_i (const HASH_MAP_ENTRY &entry)
+    is_entry_connecting_i (const Cache_IntId &int_id)
   {
-    Cache_Entries_State entry_state = entry.int_id_.recycle_state ();
+    Cache_Entries_State entry_state = int_id.recycle_state ();
     bool result = (entry_state == ENTRY_CONNECTING);
 
-    if (!result && entry.int_id_.transport () != 0)
+    if (!result && int_id.transport () != 0)
       {
         // if we're not connected, that counts, too.
         // Can this happen?  Not sure <wilsond@ociweb.com>
-        result = !entry.int_id_.is_connected ();
+        result = !int_id.is_connected ();
       }
 
     if (TAO_debug_level > 8)
@@ -527,7 +812,7 @@ namespace TAO
         TAOLIB_DEBUG ((LM_DEBUG,
                     ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::")
                     ACE_TEXT ("is_entry_connecting_i[%d], %C, state is %C\n"),
-                    entry.int_id_.transport () ? entry.int_id_.transport ()->id () : 0,
+                    int_id.transport () ? int_id.transport ()->id () : 0,
                     (result ? "true" : "false"),
                     Cache_IntId::state_name (entry_state)));
       }
@@ -535,109 +820,71 @@ namespace TAO
     return result;
   }
 
-#if !defined (ACE_LACKS_QSORT)
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
-    cpscmp(const void* a, const void* b)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge ()
   {
-    const HASH_MAP_ENTRY** left  = (const HASH_MAP_ENTRY**)a;
-    const HASH_MAP_ENTRY** right = (const HASH_MAP_ENTRY**)b;
-
-    if ((*left)->int_id_.transport ()->purging_order () <
-        (*right)->int_id_.transport ()->purging_order ())
-      return -1;
+    TRANSPORT_SET transports_to_be_closed;
 
-    if ((*left)->int_id_.transport ()->purging_order () >
-        (*right)->int_id_.transport ()->purging_order ())
-      return 1;
+    int const cache_maximum = this->purging_strategy_->cache_maximum ();
 
-    return 0;
-  }
-#endif /* ACE_LACKS_QSORT */
+    // Do we need to worry about cache purging?
+    if (cache_maximum >= 0 && this->shard_count_ > 0)
+      {
+        int const current_size = static_cast<int> (this->current_size ());
 
-  template <typename TT, typename TRDT, typename PSTRAT>
-  int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge ()
-  {
-    typedef ACE_Unbounded_Set<transport_type*> transport_set_type;
-    transport_set_type transports_to_be_closed;
+        if (TAO_debug_level > 6)
+          {
+            TAOLIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
+              ACE_TEXT ("current_size [%d], cache_maximum [%d]\n"),
+              current_size, cache_maximum));
+          }
 
-    {
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock, ace_mon, *this->cache_lock_, 0));
+        if (current_size >= cache_maximum)
+          {
+            // Calculate the number of entries to purge, when we have
+            // to purge try to at least to purge minimal of 1 entry
+            // from each shard we visit which is needed if we have a
+            // very small cache maximum
+            int amount = (current_size * this->percent_) / 100;
 
-      DESCRIPTOR_SET sorted_set = 0;
-      int const sorted_size = this->fill_set_i (sorted_set);
+            if (TAO_debug_level > 4)
+              {
+                TAOLIB_DEBUG ((LM_INFO,
+                  ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
+                  ACE_TEXT ("Trying to purge %d of %d cache entries\n"),
+                  amount,
+                  current_size));
+              }
 
-      // Only call close_entries () if sorted_set != 0.  It takes
-      // control of sorted_set and cleans up any allocated memory.  If
-      // sorted_set == 0, then there is nothing to de-allocate.
-      if (sorted_set != 0)
-        {
-          // BEGIN FORMER close_entries
-          // Calculate the number of entries to purge, when we have
-          // to purge try to at least to purge minimal of 1 entry
-          // which is needed if we have a very small cache maximum
-          int const amount = (sorted_size * this->percent_) / 100;
-
-          if (TAO_debug_level > 4)
-            {
-              TAOLIB_DEBUG ((LM_INFO,
-                ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
-                ACE_TEXT ("Trying to purge %d of %d cache entries\n"),
-                amount,
-                sorted_size));
-            }
-
-          int count = 0;
-
-          for (int i = 0; count < amount && i < sorted_size; ++i)
-            {
-              if (this->is_entry_purgable_i (*sorted_set[i]))
-                {
-                  transport_type* transport =
-                    sorted_set[i]->int_id_.transport ();
-                  sorted_set[i]->int_id_.recycle_state (ENTRY_BUSY);
-                  transport->add_reference ();
+            // Take the share of each shard in turn, starting with a
+            // different shard each time.
+            size_t const start = this->next_purge_++;
 
-                  if (TAO_debug_level > 4)
-                    {
-                      TAOLIB_DEBUG ((LM_INFO,
-                        ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
-                        ACE_TEXT ("Purgable Transport[%d] found in ")
-                        ACE_TEXT ("cache\n"),
-                        transport->id ()));
-                    }
+            for (size_t i = 0; amount > 0 && i < this->shard_count_; ++i)
+              {
+                Shard &shard =
+                  this->shards_[(start + i) % this->shard_count_];
 
-                  if (transports_to_be_closed.insert_tail (transport) != 0)
-                    {
-                      if (TAO_debug_level > 0)
-                        {
-                          TAOLIB_ERROR ((LM_ERROR,
-                            ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T")
-                            ACE_TEXT ("::purge, Unable to add transport[%d] ")
-                            ACE_TEXT ("on the to-be-closed set, so ")
-                            ACE_TEXT ("it will not be purged\n"),
-                            transport->id ()));
-                        }
-                      transport->remove_reference ();
-                    }
+                ACE_MT (ACE_GUARD_RETURN (ACE_Lock, ace_mon, *shard.lock_, 0));
 
-                  // Count this as a successful purged entry
-                  ++count;
-                }
-            }
+                int share =
+                  static_cast<int> (shard.map_.current_size ()) * this->percent_ / 100;
+                if (share < 1)
+                  share = 1;
+                if (share > amount)
+                  share = amount;
 
-          delete [] sorted_set;
-          sorted_set = 0;
-          // END FORMER close_entries
-        }
-    }
+                amount -= this->purge_i (shard, share, transports_to_be_closed);
+              }
+          }
+      }
 
     // Now, without the lock held, lets go through and close all the transports.
     if (! transports_to_be_closed.is_empty ())
       {
-        typename transport_set_type::iterator it (transports_to_be_closed);
+        typename TRANSPORT_SET::iterator it (transports_to_be_closed);
         while (! it.done ())
           {
             transport_type *transport = *it;
@@ -671,77 +918,71 @@ namespace TAO
     return 0;
   }
 
-  template <typename TT, typename TRDT, typename PSTRAT>
-  void
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
-    sort_set (DESCRIPTOR_SET& entries, int current_size)
-  {
-#if defined (ACE_LACKS_QSORT)
-    // Use insertion sort if we don't have qsort
-    for(int i = 1; i < current_size; ++i)
-      {
-        if (entries[i]->int_id_.transport ()->purging_order () <
-            entries[i - 1]->int_id_.transport ()->purging_order ())
-          {
-            HASH_MAP_ENTRY* entry = entries[i];
-
-            for(int j = i; j > 0 &&
-                  entries[j - 1]->int_id_.transport ()->purging_order () >
-                  entry->item ().transport ()->purging_order (); --j)
-              {
-                HASH_MAP_ENTRY* holder = entries[j];
-                entries[j] = entries[j - 1];
-                entries[j - 1] = holder;
-              }
-          }
-      }
-#else
-    ACE_OS::qsort (entries, current_size,
-                   sizeof (HASH_MAP_ENTRY*), (ACE_COMPARE_FUNC)cpscmp);
-#endif /* ACE_LACKS_QSORT */
-  }
-
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
-    fill_set_i (DESCRIPTOR_SET& sorted_set)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_i (
+    Shard &shard,
+    int amount,
+    TRANSPORT_SET &transports)
   {
-    int current_size = 0;
-    int const cache_maximum = this->purging_strategy_->cache_maximum ();
+    int count = 0;
 
-    // set sorted_set to 0.  This signifies nothing to purge.
-    sorted_set = 0;
+    typename PURGING_INDEX::iterator i = shard.purging_index_.begin ();
 
-    // Do we need to worry about cache purging?
-    if (cache_maximum >= 0)
+    while (count < amount && i != shard.purging_index_.end ())
       {
-        current_size = static_cast<int> (this->current_size ());
+        Cache_IntId * const int_id = i->second;
+        unsigned long const order = int_id->transport ()->purging_order ();
 
-        if (TAO_debug_level > 6)
+        if (order != i->first)
           {
-            TAOLIB_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::fill_set_i, ")
-              ACE_TEXT ("current_size [%d], cache_maximum [%d]\n"),
-              current_size, cache_maximum));
+            // The purging strategy moved the entry on since it was
+            // indexed.  Purging orders only grow, so file it again
+            // further on; the entries before it are still in order.
+            i = shard.purging_index_.erase (i);
+            int_id->purging_order_ = order;
+            shard.purging_index_.insert (std::make_pair (order, int_id));
+            continue;
           }
 
-        if (current_size >= cache_maximum)
+        ++i;
+
+        if (this->is_entry_purgable_i (*int_id))
           {
-            ACE_NEW_RETURN (sorted_set, HASH_MAP_ENTRY*[current_size], 0);
+            transport_type* transport = int_id->transport ();
+            int_id->recycle_state (ENTRY_BUSY);
+            this->requeue_i (*int_id);
+            transport->add_reference ();
 
-            HASH_MAP_ITER iter = this->cache_map_.begin ();
+            if (TAO_debug_level > 4)
+              {
+                TAOLIB_DEBUG ((LM_INFO,
+                  ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
+                  ACE_TEXT ("Purgable Transport[%d] found in ")
+                  ACE_TEXT ("cache\n"),
+                  transport->id ()));
+              }
 
-            for (int i = 0; i < current_size; ++i)
+            if (transports.insert_tail (transport) != 0)
               {
-                sorted_set[i] = &(*iter);
-                ++iter;
+                if (TAO_debug_level > 0)
+                  {
+                    TAOLIB_ERROR ((LM_ERROR,
+                      ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T")
+                      ACE_TEXT ("::purge, Unable to add transport[%d] ")
+                      ACE_TEXT ("on the to-be-closed set, so ")
+                      ACE_TEXT ("it will not be purged\n"),
+                      transport->id ()));
+                  }
+                transport->remove_reference ();
               }
 
-            this->sort_set (sorted_set, current_size);
+            // Count this as a successful purged entry
+            ++count;
           }
       }
 
-    return current_size;
+    return count;
   }
 }
 
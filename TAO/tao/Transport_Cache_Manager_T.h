@@ -20,6 +20,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "ace/Hash_Map_Manager_T.h"
+#include "ace/Malloc_Allocator.h"
 
 #include "tao/Cache_Entries_T.h"
 #include "tao/orbconf.h"
@@ -28,6 +29,10 @@
 #include "ace/Monitor_Size.h"
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
 
+#include <atomic>
+#include <set>
+#include <utility>
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Handle_Set;
 template <class T> class ACE_Unbounded_Set;
@@ -54,6 +59,14 @@ namespace TAO
    * map is updated only by holding the lock. The more compeling reason
    * to have the lock in this class and not in the Hash_Map is that, we
    * do quite a bit of work in this class for which we need a lock.
+   *
+   * The cache is split in shards selected by the hash of the
+   * endpoint, each with its own map and lock, so threads talking to
+   * different servers do not contend.  Within a shard the entries of
+   * an endpoint are kept in a list with the idle ones first, which
+   * makes finding an idle transport a constant time operation, and
+   * in an index ordered by their purging order, which purge() walks
+   * from the start instead of sorting the whole cache.
    */
   template <typename TT, typename TRDT, typename PSTRAT>
   class Transport_Cache_Manager_T
@@ -98,7 +111,8 @@ namespace TAO
       purging_strategy* purging_strategy,
       size_t cache_maximum,
       bool locked,
-      const char *orbid);
+      const char *orbid,
+      size_t shards = 1);
 
     /// Destructor
     ~Transport_Cache_Manager_T ();
@@ -133,6 +147,11 @@ namespace TAO
     /// Make the entry idle and ready for use.
     int make_idle (HASH_MAP_ENTRY *&entry);
 
+    /// Mark the entry busy, as find_transport() does, if it is
+    /// available and was cached for a descriptor equivalent to
+    /// @a prop.  Return false otherwise, or if the entry was purged.
+    bool reserve (HASH_MAP_ENTRY *&entry, transport_descriptor_type *prop);
+
     /// Modify the state setting on the provided entry.
     void set_entry_state (HASH_MAP_ENTRY *&entry,
                           TAO::Cache_Entries_State state);
@@ -163,10 +182,96 @@ namespace TAO
     /// Return the total size of the cache.
     size_t total_size () const;
 
-    /// Return the underlying cache map
-    HASH_MAP &map ();
+    /// Return the number of shards of the cache.
+    size_t shards () const;
+
+    /// Return the cache map of @a shard.
+    HASH_MAP &map (size_t shard = 0);
 
   private:
+    struct Endpoint;
+
+    typedef ACE_Hash_Map_Manager_Ex <Cache_ExtId,
+                                     Endpoint *,
+                                     ACE_Hash<Cache_ExtId>,
+                                     ACE_Equal_To<Cache_ExtId>,
+                                     ACE_Null_Mutex>
+    ENDPOINT_MAP;
+
+    typedef ACE_Hash_Map_Entry <Cache_ExtId,
+                                Endpoint *>
+    ENDPOINT_MAP_ENTRY;
+
+    /// The head of the list of the entries of an endpoint, the idle
+    /// ones first.
+    struct Endpoint : public Cache_IntId
+    {
+      /// Our entry in the endpoint map of the shard.
+      ENDPOINT_MAP_ENTRY *entry_;
+    };
+
+    /// The entries of a shard ordered by purging order.
+    typedef std::set<std::pair<unsigned long, Cache_IntId *> > PURGING_INDEX;
+
+    /**
+     * @class Entry_Allocator
+     *
+     * @brief Allocator of the entries of the cache map of a shard.
+     *
+     * Freed entries are kept for the next bind in the same shard
+     * instead of going back to the heap, so a transport can read the
+     * shard of its entry before taking the lock of the shard, even if
+     * another thread purges the entry at the same time.
+     */
+    class Entry_Allocator : public ACE_New_Allocator
+    {
+    public:
+      Entry_Allocator ();
+      virtual ~Entry_Allocator ();
+
+      virtual void *malloc (size_t nbytes);
+      virtual void free (void *ptr);
+
+    private:
+      /// The freed entries, linked through their first word.
+      void *free_list_;
+    };
+
+    /// A part of the cache, with its own map and lock.
+    struct Shard
+    {
+      Shard ();
+      ~Shard ();
+
+      /// Set up the maps with @a size buckets and the lock.
+      int open (size_t size, bool locked);
+
+      /// Must outlive map_.
+      Entry_Allocator allocator_;
+
+      /// The hash map that has the connections
+      HASH_MAP map_;
+
+      /// The endpoints that have entries in map_.
+      ENDPOINT_MAP endpoints_;
+
+      PURGING_INDEX purging_index_;
+
+      TAO_SYNCH_MUTEX mutex_;
+
+      /// The lock that is used by the shard
+      ACE_Lock *lock_;
+    };
+
+    typedef ACE_Unbounded_Set<transport_type*> TRANSPORT_SET;
+
+    /// Return the shard of the endpoint @a prop.
+    Shard &shard (transport_descriptor_type *prop);
+
+    /// Lock the shard of @a entry, which is also what keeps @a entry
+    /// from changing, and return it, or return 0 if @a entry is 0.
+    Shard *lock_entry (HASH_MAP_ENTRY *&entry);
+
     /// Lookup entry<key,value> in the cache. Grabs the lock and calls the
     /// implementation function find_i.
     Find_Result find (
@@ -176,19 +281,19 @@ namespace TAO
 
     /**
      * Non-Locking version and actual implementation of bind ()
-     * call. Calls bind on the Hash_Map_Manager that it holds. If the
+     * call. Calls bind on the Hash_Map_Manager of @a shard. If the
      * bind succeeds, it adds the Hash_Map_Entry in to the
      * Transport for its reference.
      */
-    int bind_i (Cache_ExtId &ext_id, Cache_IntId &int_id);
+    int bind_i (Shard &shard, Cache_ExtId &ext_id, Cache_IntId &int_id);
 
     /**
      * Non-locking version and actual implementation of find ()
-     * call. This calls the find () on the underlying
-     * Hash_Map_Manager. If the find succeeds, it calls the
-     * get_idle_transport ().
+     * call. This looks up the list of entries of the endpoint, the
+     * first of which is idle if any is.
      */
     Find_Result find_i (
+      Shard &shard,
       transport_descriptor_type *prop,
       transport_type *&transport,
       size_t & busy_count);
@@ -197,43 +302,49 @@ namespace TAO
     int make_idle_i (HASH_MAP_ENTRY *entry);
 
     /// Non-locking version and actual implementation of close ()
-    int close_i (Connection_Handler_Set &handlers);
+    int close_i (Shard &shard, Connection_Handler_Set &handlers);
 
     /// Purge the entry from the Cache Map
-    int purge_entry_i (HASH_MAP_ENTRY *entry);
+    int purge_entry_i (Shard &shard, HASH_MAP_ENTRY *entry);
+
+    /// Mark up to @a amount entries of @a shard, in purging order, to
+    /// be closed and add their transports to @a transports.  Returns
+    /// the number of entries marked.
+    int purge_i (Shard &shard, int amount, TRANSPORT_SET &transports);
+
+    /// Add a newly bound entry of the endpoint @a prop to the list of
+    /// the endpoint and to the purging index.
+    int link_i (Shard &shard,
+                transport_descriptor_type *prop,
+                Cache_IntId &int_id);
+
+    /// Remove an entry from the list of its endpoint and from the
+    /// purging index.
+    void unlink_i (Shard &shard, Cache_IntId &int_id);
+
+    /// Move an entry to the front of the list of its endpoint if it
+    /// became available, to the back otherwise.
+    void requeue_i (Cache_IntId &int_id);
 
   private:
     /**
-     * Tries to find if the @c int_id_ in @a entry is available for use.
+     * Tries to find if @a int_id is available for use.
      */
-    bool is_entry_available_i (const HASH_MAP_ENTRY &entry);
+    bool is_entry_available_i (const Cache_IntId &int_id);
 
     /**
-     * Tries to find if the @c int_id_ in @a entry is connect pending
+     * Tries to find if @a int_id is connect pending
      */
-    bool is_entry_connecting_i (const HASH_MAP_ENTRY &entry);
+    bool is_entry_connecting_i (const Cache_IntId &int_id);
 
     /**
-     * Tries to find if the @c int_id_ in @a entry is purgable
+     * Tries to find if @a int_id is purgable
      */
-    bool is_entry_purgable_i (HASH_MAP_ENTRY &entry);
-
-#if !defined(ACE_LACKS_QSORT)
-    /// Used by qsort
-    static int cpscmp(const void* a, const void* b);
-#endif
-
-    typedef HASH_MAP_ENTRY** DESCRIPTOR_SET;
-
-    /// Sort the list of entries
-    void sort_set (DESCRIPTOR_SET& entries, int size);
-
-    /// Fill sorted_set in with the transport_descriptor_type's in
-    /// a sorted order.
-    int fill_set_i (DESCRIPTOR_SET& sorted_set);
+    bool is_entry_purgable_i (Cache_IntId &int_id);
 
     /// Non-locking version of blockable_client_transports ().
-    bool blockable_client_transports_i (Connection_Handler_Set &handlers);
+    bool blockable_client_transports_i (Shard &shard,
+                                        Connection_Handler_Set &handlers);
 
   private:
     /// The percentage of the cache to purge at one time
@@ -242,13 +353,16 @@ namespace TAO
     /// The underlying connection purging strategy
     purging_strategy *purging_strategy_;
 
-    /// The hash map that has the connections
-    HASH_MAP cache_map_;
+    /// The shards of the cache
+    Shard *shards_;
+    size_t shard_count_;
 
-    TAO_SYNCH_MUTEX cache_map_mutex_;
+    /// Number of entries in all the shards
+    std::atomic<size_t> current_size_;
 
-    /// The lock that is used by the cache map
-    ACE_Lock *cache_lock_;
+    /// Shard purge() starts with, so successive purges spread over
+    /// the shards.
+    std::atomic<size_t> next_purge_;
 
     /// Maximum size of the cache
     size_t cache_maximum_;
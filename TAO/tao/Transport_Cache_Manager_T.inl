@@ -13,11 +13,12 @@ namespace TAO
   {
     // Compose the ExternId & Intid
     Cache_ExtId ext_id (prop);
+    Shard &shard = this->shard (prop);
     int retval = 0;
     {
       ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
                                 guard,
-                                *this->cache_lock_,
+                                *shard.lock_,
                                 -1));
       Cache_IntId int_id (transport);
 
@@ -27,7 +28,23 @@ namespace TAO
       else
         int_id.recycle_state (state);
 
-      retval = this->bind_i (ext_id, int_id);
+      retval = this->bind_i (shard, ext_id, int_id);
+
+      // Without a lock shared by all the shards, post_open () does not
+      // wait for us and finds no entry to make idle when the connection
+      // completes while we bind it, see lock_entry ().  It sees the
+      // entry once is_connected () has synchronized with it, so either
+      // it makes the entry idle or we do here.
+      HASH_MAP_ENTRY *entry = transport->cache_map_entry ();
+      if (retval == 0
+          && entry != 0
+          && entry->item ().recycle_state () == ENTRY_CONNECTING
+          && transport->is_connected ())
+        {
+          entry->item ().is_connected (true);
+          entry->item ().recycle_state (ENTRY_IDLE_AND_PURGABLE);
+          this->requeue_i (entry->item ());
+        }
     }
 
     return retval;
@@ -41,19 +58,21 @@ namespace TAO
 
     if (entry != 0)
     {
-      HASH_MAP_ENTRY* cached_entry = 0;
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock, guard, *this->cache_lock_, -1));
-      if (entry != 0) // in case someone beat us to it (entry is reference to transport member)
+      // in case someone beat us to it (entry is reference to transport member)
+      Shard * const shard = this->lock_entry (entry);
+      if (shard != 0)
       {
+        ACE_Guard<ACE_Lock> guard (*shard->lock_, false, 1);
+
         // Store the entry in a temporary and zero out the reference.
         // If there is only one reference count for the transport, we will end up causing
         // it's destruction.  And the transport can not be holding a cache map entry if
         // that happens.
-        cached_entry = entry;
+        HASH_MAP_ENTRY* cached_entry = entry;
         entry = 0;
 
         // now it's save to really purge the entry
-        retval = this->purge_entry_i (cached_entry);
+        retval = this->purge_entry_i (*shard, cached_entry);
       }
     }
 
@@ -64,26 +83,31 @@ namespace TAO
   ACE_INLINE void
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::mark_connected (HASH_MAP_ENTRY *&entry, bool state)
   {
-    ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->cache_lock_));
-    if (entry == 0)
+    Shard * const shard = this->lock_entry (entry);
+    if (shard == 0)
       return;
 
+    ACE_Guard<ACE_Lock> guard (*shard->lock_, false, 1);
+
     if (TAO_debug_level > 9 && state != entry->item ().is_connected ())
       TAOLIB_DEBUG ((LM_DEBUG, ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T")
                   ACE_TEXT ("::mark_connected, %s Transport[%d]\n"),
                   (state ? ACE_TEXT("true") : ACE_TEXT("false")),
                   entry->item ().transport ()->id ()));
     entry->item().is_connected (state);
+    this->requeue_i (entry->item ());
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::make_idle (HASH_MAP_ENTRY *&entry)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock, guard, *this->cache_lock_, -1));
-    if (entry == 0) // in case someone beat us to it (entry is reference to transport member)
+    Shard * const shard = this->lock_entry (entry);
+    if (shard == 0) // in case someone beat us to it (entry is reference to transport member)
       return -1;
 
+    ACE_Guard<ACE_Lock> guard (*shard->lock_, false, 1);
+
     return this->make_idle_i (entry);
   }
 
@@ -93,12 +117,14 @@ namespace TAO
                                  transport_type *&transport,
                                  size_t &busy_count)
   {
+    Shard &shard = this->shard (prop);
+
     ACE_MT (ACE_GUARD_RETURN  (ACE_Lock,
                                guard,
-                               *this->cache_lock_,
+                               *shard.lock_,
                                CACHE_FOUND_NONE));
 
-    return this->find_i (prop, transport, busy_count);
+    return this->find_i (shard, prop, transport, busy_count);
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
@@ -106,19 +132,24 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
     close (Connection_Handler_Set &handlers)
   {
-    // The cache lock pointer should only be zero if
-    // Transport_Cache_Manager_T::open() was never called.  Note that
-    // only one thread opens the Transport_Cache_Manager_T at any given
-    // time, so it is safe to check for a non-zero lock pointer.
-    if (this->cache_lock_ == 0)
+    // The shards should only be zero if the constructor failed to
+    // allocate them.
+    if (this->shards_ == 0)
       return -1;
 
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_,
-                              -1));
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      {
+        Shard &shard = this->shards_[i];
+
+        ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
+                                  guard,
+                                  *shard.lock_,
+                                  -1));
 
-    return this->close_i (handlers);
+        this->close_i (shard, handlers);
+      }
+
+    return 0;
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
@@ -126,33 +157,57 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::blockable_client_transports (
     Connection_Handler_Set &handlers)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_,
-                              false));
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      {
+        Shard &shard = this->shards_[i];
 
-    return this->blockable_client_transports_i (handlers);
+        ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
+                                  guard,
+                                  *shard.lock_,
+                                  false));
+
+        this->blockable_client_transports_i (shard, handlers);
+      }
+
+    return true;
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE size_t
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::current_size () const
   {
-    return this->cache_map_.current_size ();
+    return this->current_size_.load ();
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE size_t
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::total_size () const
   {
-    return this->cache_map_.total_size ();
+    size_t size = 0;
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      size += this->shards_[i].map_.total_size ();
+    return size;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE size_t
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shards () const
+  {
+    return this->shard_count_;
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::HASH_MAP &
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::map ()
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::map (size_t shard)
+  {
+    return this->shards_[shard].map_;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard &
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shard (transport_descriptor_type *prop)
   {
-    return this->cache_map_;
+    return this->shards_[prop->hash () % this->shard_count_];
   }
 }
 
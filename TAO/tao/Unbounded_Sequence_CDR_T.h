@@ -17,6 +17,50 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO {
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+  namespace details {
+    /// Let @a target refer to the @a length elements at the read
+    /// pointer of @a strm instead of copying them.  Returns false,
+    /// leaving the stream to the copying code, when the elements need
+    /// swapping, are misaligned in memory, do not sit in the current
+    /// message block or when that block cannot be shared.
+    template <typename stream, typename value_t>
+    bool demarshal_sequence_in_place(stream & strm,
+                                     ::CORBA::ULong length,
+                                     size_t alignment,
+                                     TAO::unbounded_value_sequence <value_t> & target) {
+      if (length == 0 || strm.do_byte_swap ()) {
+        return false;
+      }
+      const ACE_Message_Block * const mb = strm.start ();
+      if (ACE_BIT_ENABLED (mb->flags (), ACE_Message_Block::DONT_DELETE)) {
+        return false;
+      }
+      // The data block is released by whichever thread drops the
+      // last sequence, so its allocator must be locked.
+      if (strm.orb_core () == 0 || strm.orb_core ()->resource_factory ()->
+        input_cdr_allocator_type_locked () != 1) {
+        return false;
+      }
+      if (strm.align_read_ptr (alignment) != 0) {
+        return false;
+      }
+      size_t const bytes = length * sizeof (value_t);
+      char * const start = strm.rd_ptr ();
+      if (strm.length () < bytes
+          || ACE_ptr_align_binary (start, alignof (value_t)) != start) {
+        return false;
+      }
+      TAO::unbounded_value_sequence <value_t> tmp (length, mb);
+      if (!strm.skip_bytes (bytes)) {
+        return false;
+      }
+      tmp.swap(target);
+      return true;
+    }
+  }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
+
   template <typename stream>
   bool demarshal_sequence(stream & strm, unbounded_value_sequence <CORBA::Short> & target) {
     typedef TAO::unbounded_value_sequence <CORBA::Short> sequence;
@@ -27,6 +71,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::SHORT_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -47,6 +96,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::LONG_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -67,6 +121,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::LONG_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -87,6 +146,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::SHORT_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -204,6 +268,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::LONG_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -224,6 +293,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::LONGLONG_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -244,6 +318,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::LONGLONG_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -264,6 +343,11 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (details::demarshal_sequence_in_place (strm, new_length, ACE_CDR::LONGLONG_ALIGN, target)) {
+      return true;
+    }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
@@ -9,10 +9,15 @@
  * @author Carlos O'Ryan
  */
 
+#include "tao/orbconf.h"
 #include "tao/Unbounded_Value_Allocation_Traits_T.h"
 #include "tao/Value_Traits_T.h"
 #include "tao/Generic_Sequence_T.h"
 
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+#include "ace/Message_Block.h"
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO
@@ -33,6 +38,52 @@ public:
   typedef details::value_traits<value_type,true> element_traits;
   typedef details::generic_sequence<value_type, allocation_traits, element_traits> implementation_type;
 
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+  inline unbounded_value_sequence()
+    : impl_()
+    , mb_(0)
+  {}
+  inline explicit unbounded_value_sequence(CORBA::ULong maximum)
+    : impl_(maximum)
+    , mb_(0)
+  {}
+  inline unbounded_value_sequence(
+      CORBA::ULong maximum,
+      CORBA::ULong length,
+      value_type * data,
+      CORBA::Boolean release = false)
+    : impl_(maximum, length, data, release)
+    , mb_(0)
+  {}
+  /// Refer to the @a length elements at the read pointer of @a mb,
+  /// ignoring any chaining in the message block.  A duplicate of
+  /// @a mb keeps the data alive, so its data block must not be
+  /// DONT_DELETE.  The elements must be suitably aligned and in
+  /// native byte order.
+  inline unbounded_value_sequence(
+      CORBA::ULong length,
+      const ACE_Message_Block * mb)
+    : impl_(length,
+            length,
+            reinterpret_cast<value_type *>(mb->rd_ptr()),
+            false)
+    , mb_(ACE_Message_Block::duplicate(mb))
+  {}
+  /// The copy never refers to the message block of @a rhs.
+  inline unbounded_value_sequence(unbounded_value_sequence const & rhs)
+    : impl_(rhs.impl_)
+    , mb_(0)
+  {}
+  inline unbounded_value_sequence & operator=(
+      unbounded_value_sequence const & rhs) {
+    unbounded_value_sequence tmp(rhs);
+    swap(tmp);
+    return * this;
+  }
+  inline ~unbounded_value_sequence() {
+    ACE_Message_Block::release(mb_);
+  }
+#else
   inline unbounded_value_sequence()
     : impl_()
   {}
@@ -47,6 +98,7 @@ public:
     : impl_(maximum, length, data, release)
   {}
   /* Use default ctor, operator= and dtor */
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
   inline CORBA::ULong maximum() const {
     return impl_.maximum();
   }
@@ -57,6 +109,16 @@ public:
     return impl_.length();
   }
   inline void length(CORBA::ULong length) {
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (mb_ != 0 && length > impl_.maximum())
+      {
+        // Growing moves the elements to a buffer of our own.
+        unbounded_value_sequence tmp(*this);
+        tmp.impl_.length(length);
+        swap(tmp);
+        return;
+      }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     impl_.length(length);
   }
   inline value_type const & operator[](CORBA::ULong i) const {
@@ -70,16 +132,34 @@ public:
       CORBA::ULong length,
       value_type * data,
       CORBA::Boolean release = false) {
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    unbounded_value_sequence tmp(maximum, length, data, release);
+    swap(tmp);
+#else
     impl_.replace(maximum, length, data, release);
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
   }
   inline value_type const * get_buffer() const {
     return impl_.get_buffer();
   }
   inline value_type * get_buffer(CORBA::Boolean orphan = false) {
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    if (orphan && mb_ != 0)
+      {
+        // The caller takes ownership, so hand out a copy and let go
+        // of the message block.
+        unbounded_value_sequence tmp(*this);
+        unbounded_value_sequence().swap(*this);
+        return tmp.impl_.get_buffer(true);
+      }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
     return impl_.get_buffer(orphan);
   }
   inline void swap(unbounded_value_sequence & rhs) throw() {
     impl_.swap(rhs.impl_);
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+    std::swap(mb_, rhs.mb_);
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
   }
   static value_type * allocbuf(CORBA::ULong maximum) {
     return implementation_type::allocbuf(maximum);
@@ -88,8 +168,30 @@ public:
     implementation_type::freebuf(buffer);
   }
 
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+  /// Returns the message block holding the elements, 0 if the
+  /// sequence owns its buffer.  The caller must *not* release it.
+  inline ACE_Message_Block * mb() const {
+    return mb_;
+  }
+
+  /// Replaces the current buffer with the @a length elements at the
+  /// read pointer of @a mb.  It takes a duplicate of @a mb so the user
+  /// still owns it.
+  inline void replace(CORBA::ULong length, const ACE_Message_Block * mb) {
+    unbounded_value_sequence tmp(length, mb);
+    swap(tmp);
+  }
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
+
 private:
   implementation_type impl_;
+
+#if (TAO_NO_COPY_VALUE_SEQUENCES == 1)
+  /// Message block holding the elements when they were demarshaled
+  /// in place.
+  ACE_Message_Block * mb_;
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES == 1 */
 };
 
 } // namespace TAO
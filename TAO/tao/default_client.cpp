@@ -6,6 +6,7 @@
 #include "tao/Wait_On_LF_No_Upcall.h"
 #include "tao/Exclusive_TMS.h"
 #include "tao/Muxed_TMS.h"
+#include "tao/Lock_Free_Muxed_TMS.h"
 #include "tao/Blocked_Connect_Strategy.h"
 #include "tao/Reactive_Connect_Strategy.h"
 #include "tao/LF_Connect_Strategy.h"
@@ -119,6 +120,9 @@ TAO_Default_Client_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
               else if (ACE_OS::strcasecmp (name,
                                            ACE_TEXT("EXCLUSIVE")) == 0)
                 this->transport_mux_strategy_ = TAO_EXCLUSIVE_TMS;
+              else if (ACE_OS::strcasecmp (name,
+                                           ACE_TEXT("LOCK_FREE")) == 0)
+                this->transport_mux_strategy_ = TAO_LOCK_FREE_MUXED_TMS;
               else
                 this->report_option_value_error (
                   ACE_TEXT("-ORBTransportMuxStrategy"), name);
@@ -386,6 +390,13 @@ TAO_Default_Client_Strategy_Factory::create_transport_mux_strategy (
                         nullptr);
         break;
       }
+      case TAO_LOCK_FREE_MUXED_TMS:
+      {
+        ACE_NEW_RETURN (tms,
+                        TAO_Lock_Free_Muxed_TMS (transport),
+                        nullptr);
+        break;
+      }
     }
 
   return tms;
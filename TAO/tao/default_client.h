@@ -76,7 +76,8 @@ private:
   enum Transport_Mux_Strategy
   {
     TAO_MUXED_TMS,
-    TAO_EXCLUSIVE_TMS
+    TAO_EXCLUSIVE_TMS,
+    TAO_LOCK_FREE_MUXED_TMS
   };
 
   /// The client Request Mux Strategy.
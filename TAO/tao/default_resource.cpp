@@ -24,8 +24,10 @@
 #include "ace/Reactor.h"
 #include "ace/Malloc_T.h"
 #include "ace/Local_Memory_Pool.h"
+#include "ace/TLS_Slab_Allocator.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_unistd.h"
 
 #include <memory>
 
@@ -110,6 +112,10 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory ()
   , cache_maximum_ (TAO_CONNECTION_CACHE_MAXIMUM)
   , purge_percentage_ (TAO_PURGE_PERCENT)
   , max_muxed_connections_ (0)
+  , transport_cache_shards_ (1)
+  , transport_coalescing_bytes_ (0)
+  , transport_coalescing_window_ (TAO_TRANSPORT_COALESCING_WINDOW)
+  , lock_free_follower_set_ (false)
   , reactor_mask_signals_ (1)
   , dynamically_allocated_reactor_ (false)
   , options_processed_ (0)
@@ -119,6 +125,7 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory ()
 #else
   , output_cdr_allocator_type_ (DEFAULT)
 #endif
+  , input_cdr_slab_allocator_ (false)
 #if TAO_USE_LOCAL_MEMORY_POOL == 1
   , use_local_memory_pool_ (true)
 #else
@@ -323,6 +330,23 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
           this->report_option_value_error (ACE_TEXT("-ORBConnectionCacheMax"), argv[curarg]);
       }
 
+   else if (ACE_OS::strcasecmp (argv[curarg],
+                                ACE_TEXT("-ORBConnectionCacheShards")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+            ACE_TCHAR* name = argv[curarg];
+
+            if (ACE_OS::strcasecmp (name, ACE_TEXT("auto")) == 0)
+              this->transport_cache_shards_ = -1;
+            else if (ACE_OS::atoi (name) > 0)
+              this->transport_cache_shards_ = ACE_OS::atoi (name);
+            else
+              this->report_option_value_error (ACE_TEXT("-ORBConnectionCacheShards"), name);
+          }
+      }
+
    else if (ACE_OS::strcasecmp (argv[curarg],
                                 ACE_TEXT("-ORBConnectionCachePurgePercentage")) == 0)
       {
@@ -409,6 +433,42 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               this->report_option_value_error (ACE_TEXT("-ORBFlushingStrategy"), name);
           }
       }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBTransportCoalescing")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc && ACE_OS::atoi (argv[curarg]) >= 0)
+          this->transport_coalescing_bytes_ = ACE_OS::atoi (argv[curarg]);
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBTransportCoalescing"),
+                                           argv[curarg]);
+      }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBTransportCoalescingWindow")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc && ACE_OS::atoi (argv[curarg]) >= 0)
+          this->transport_coalescing_window_ = ACE_OS::atoi (argv[curarg]);
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBTransportCoalescingWindow"),
+                                           argv[curarg]);
+      }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBLeaderFollowerSet")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+            ACE_TCHAR* name = argv[curarg];
+
+            if (ACE_OS::strcasecmp (name, ACE_TEXT("list")) == 0)
+              this->lock_free_follower_set_ = false;
+            else if (ACE_OS::strcasecmp (name, ACE_TEXT("lock_free")) == 0)
+              this->lock_free_follower_set_ = true;
+            else
+              this->report_option_value_error (ACE_TEXT("-ORBLeaderFollowerSet"), name);
+          }
+      }
     else if (ACE_OS::strcasecmp (argv[curarg],
                                  ACE_TEXT ("-ORBMuxedConnectionMax")) == 0)
       {
@@ -462,6 +522,11 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               {
                 this->output_cdr_allocator_type_ = LOCAL_MEMORY_POOL;
               }
+            else if (ACE_OS::strcasecmp (current_arg,
+                                         ACE_TEXT("slab")) == 0)
+              {
+                this->output_cdr_allocator_type_ = SLAB_ALLOCATOR;
+              }
             else if (ACE_OS::strcasecmp (current_arg,
                                          ACE_TEXT("default")) == 0)
               {
@@ -474,6 +539,32 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               }
           }
       }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBInputCDRAllocator")))
+      {
+        ++curarg;
+
+        if (curarg < argc)
+          {
+            ACE_TCHAR const * const current_arg = argv[curarg];
+
+            if (ACE_OS::strcasecmp (current_arg,
+                                    ACE_TEXT("slab")) == 0)
+              {
+                this->input_cdr_slab_allocator_ = true;
+              }
+            else if (ACE_OS::strcasecmp (current_arg,
+                                         ACE_TEXT("default")) == 0)
+              {
+                this->input_cdr_slab_allocator_ = false;
+              }
+            else
+              {
+                this->report_option_value_error (
+                  ACE_TEXT("-ORBInputCDRAllocator"), current_arg);
+              }
+          }
+      }
     else if (0 == ACE_OS::strcasecmp (argv[curarg],
                                       ACE_TEXT("-ORBZeroCopyWrite")))
       {
@@ -826,7 +917,13 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_dblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->input_cdr_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    ACE_TLS_Slab_Allocator,
+                    nullptr);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -846,7 +943,13 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_buffer_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->input_cdr_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    ACE_TLS_Slab_Allocator,
+                    nullptr);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -866,7 +969,13 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_msgblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->input_cdr_slab_allocator_)
+  {
+    ACE_NEW_RETURN (allocator,
+                    ACE_TLS_Slab_Allocator,
+                    nullptr);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -892,7 +1001,13 @@ ACE_Allocator*
 TAO_Default_Resource_Factory::output_cdr_dblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->output_cdr_allocator_type_ == SLAB_ALLOCATOR)
+  {
+    ACE_NEW_RETURN (allocator,
+                    ACE_TLS_Slab_Allocator,
+                    nullptr);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -931,6 +1046,13 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator ()
       break;
 #endif  /* TAO_HAS_SENDFILE==1 */
 
+    case SLAB_ALLOCATOR:
+      ACE_NEW_RETURN (allocator,
+                      ACE_TLS_Slab_Allocator,
+                      nullptr);
+
+      break;
+
     case DEFAULT:
     default:
       ACE_NEW_RETURN (allocator,
@@ -947,7 +1069,13 @@ ACE_Allocator*
 TAO_Default_Resource_Factory::output_cdr_msgblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->output_cdr_allocator_type_ == SLAB_ALLOCATOR)
+  {
+    ACE_NEW_RETURN (allocator,
+                    ACE_TLS_Slab_Allocator,
+                    nullptr);
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -1048,6 +1176,18 @@ TAO_Default_Resource_Factory::locked_transport_cache ()
   return 1;
 }
 
+int
+TAO_Default_Resource_Factory::transport_cache_shards () const
+{
+  if (this->transport_cache_shards_ < 0)
+    {
+      long const processors = ACE_OS::num_processors_online ();
+      return processors > 0 ? static_cast<int> (processors) : 1;
+    }
+
+  return this->transport_cache_shards_;
+}
+
 TAO_Flushing_Strategy *
 TAO_Default_Resource_Factory::create_flushing_strategy ()
 {
@@ -1067,6 +1207,18 @@ TAO_Default_Resource_Factory::create_flushing_strategy ()
   return strategy;
 }
 
+size_t
+TAO_Default_Resource_Factory::transport_coalescing_bytes () const
+{
+  return this->transport_coalescing_bytes_;
+}
+
+int
+TAO_Default_Resource_Factory::transport_coalescing_window () const
+{
+  return this->transport_coalescing_window_;
+}
+
 TAO_Connection_Purging_Strategy *
 TAO_Default_Resource_Factory::create_purging_strategy ()
 {
@@ -1102,6 +1254,12 @@ TAO_Default_Resource_Factory::create_lf_strategy ()
   return strategy;
 }
 
+bool
+TAO_Default_Resource_Factory::lock_free_follower_set () const
+{
+  return this->lock_free_follower_set_;
+}
+
 TAO_GIOP_Fragmentation_Strategy*
 TAO_Default_Resource_Factory::create_fragmentation_strategy (
   TAO_Transport * transport,
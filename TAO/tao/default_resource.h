@@ -176,10 +176,14 @@ public:
   virtual int max_muxed_connections () const;
   virtual ACE_Lock *create_cached_connection_lock ();
   virtual int locked_transport_cache ();
+  virtual int transport_cache_shards () const;
   virtual TAO_Flushing_Strategy *create_flushing_strategy ();
+  virtual size_t transport_coalescing_bytes () const;
+  virtual int transport_coalescing_window () const;
   virtual TAO_Connection_Purging_Strategy *create_purging_strategy ();
   TAO_Resource_Factory::Resource_Usage resource_usage_strategy () const;
   virtual TAO_LF_Strategy *create_lf_strategy ();
+  virtual bool lock_free_follower_set () const;
   virtual TAO_GIOP_Fragmentation_Strategy*
     create_fragmentation_strategy (TAO_Transport * transport,
                                    CORBA::ULong max_message_size) const;
@@ -240,6 +244,18 @@ protected:
   /// limit
   int max_muxed_connections_;
 
+  /// Number of shards of the transport cache, set through
+  /// -ORBConnectionCacheShards; -1 means one per online processor.
+  int transport_cache_shards_;
+
+  /// Set through -ORBTransportCoalescing and
+  /// -ORBTransportCoalescingWindow.
+  size_t transport_coalescing_bytes_;
+  int transport_coalescing_window_;
+
+  /// Set through -ORBLeaderFollowerSet.
+  bool lock_free_follower_set_;
+
   /// If 0 then we create reactors with signal handling disabled.
   int reactor_mask_signals_;
 
@@ -274,12 +290,17 @@ protected:
 #if TAO_HAS_SENDFILE == 1
       MMAP_ALLOCATOR,
 #endif  /* TAO_HAS_SENDFILE == 1*/
+      SLAB_ALLOCATOR,
       DEFAULT
     };
 
   /// Type of allocator to use for output CDR buffers.
   Output_CDR_Allocator_Type output_cdr_allocator_type_;
 
+  /// This flag is used to determine whether the input CDR allocators
+  /// should be ACE_TLS_Slab_Allocator instances.
+  bool input_cdr_slab_allocator_;
+
   /// This flag is used to determine whether the CDR allocators
   /// should use the local memory pool or not.
   bool use_local_memory_pool_;
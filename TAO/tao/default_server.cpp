@@ -148,6 +148,16 @@ TAO_Default_Server_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
                              nullptr,
                              10);
       }
+    else if (ACE_OS::strcasecmp (argv[curarg],
+                                 ACE_TEXT("-ORBObjectKeyCacheSize")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc)
+          this->active_object_map_creation_parameters_.object_key_cache_size_ =
+            ACE_OS::strtoul (argv[curarg],
+                             nullptr,
+                             10);
+      }
     else if (ACE_OS::strcasecmp (argv[curarg],
                                  ACE_TEXT("-ORBPOAMapSize")) == 0)
       {
@@ -211,6 +221,10 @@ TAO_Default_Server_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
                                          ACE_TEXT("linear")) == 0)
               this->active_object_map_creation_parameters_.object_lookup_strategy_for_user_id_policy_ =
                 TAO_LINEAR;
+            else if (ACE_OS::strcasecmp (name,
+                                         ACE_TEXT("open")) == 0)
+              this->active_object_map_creation_parameters_.object_lookup_strategy_for_user_id_policy_ =
+                TAO_OPEN_HASH;
             else
               this->report_option_value_error (ACE_TEXT("-ORBUseridPolicyDemuxStrategy"), name);
           }
@@ -235,6 +249,10 @@ TAO_Default_Server_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
                                          ACE_TEXT("active")) == 0)
               this->active_object_map_creation_parameters_.object_lookup_strategy_for_system_id_policy_ =
                 TAO_ACTIVE_DEMUX;
+            else if (ACE_OS::strcasecmp (name,
+                                         ACE_TEXT("open")) == 0)
+              this->active_object_map_creation_parameters_.object_lookup_strategy_for_system_id_policy_ =
+                TAO_OPEN_HASH;
             else
               this->report_option_value_error (ACE_TEXT("-ORBSystemidPolicyDemuxStrategy"), name);
           }
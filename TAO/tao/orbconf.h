@@ -117,6 +117,11 @@ const size_t TAO_DEFAULT_POLICY_FACTORY_REGISTRY_SIZE = 64;
 const bool TAO_USE_PARALLEL_CONNECT = false;
 #endif /* !TAO_USE_PARALLEL_CONNECT */
 
+// Should stubs reuse the transport of their last invocation
+#if !defined (TAO_STUB_TRANSPORT_AFFINITY)
+const bool TAO_STUB_TRANSPORT_AFFINITY = false;
+#endif /* !TAO_STUB_TRANSPORT_AFFINITY */
+
 #if !defined (TAO_ACCEPT_ERROR_DELAY)
 const time_t TAO_ACCEPT_ERROR_DELAY = 5;
 #endif /* TAO_ACCEPT_ERROR_DELAY */
@@ -151,6 +156,12 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 #  define TAO_DEFAULT_SERVER_POA_MAP_SIZE 24
 #endif /* ! TAO_DEFAULT_SERVER_POA_MAP_SIZE */
 
+// The default number of object keys cached by the object adapter,
+// zero disables the cache.
+#if !defined (TAO_DEFAULT_SERVER_OBJECT_KEY_CACHE_SIZE)
+#  define TAO_DEFAULT_SERVER_OBJECT_KEY_CACHE_SIZE 0
+#endif /* ! TAO_DEFAULT_SERVER_OBJECT_KEY_CACHE_SIZE */
+
 // The default timeout receiving the location request to the TAO
 // Naming, Trading and other servicesService.
 #if !defined (TAO_DEFAULT_SERVICE_RESOLUTION_TIMEOUT)
@@ -186,10 +197,49 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 # define TAO_CONNECTION_CACHE_MAXIMUM (ACE::max_handles () / 2)
 #endif /* TAO_CONNECTION_CACHE_MAXIMUM */
 
+// Microseconds between two oneway or AMI requests on a transport below
+// which they are coalesced, when -ORBTransportCoalescing is set.
+#if !defined (TAO_TRANSPORT_COALESCING_WINDOW)
+# define TAO_TRANSPORT_COALESCING_WINDOW 100
+#endif /* TAO_TRANSPORT_COALESCING_WINDOW */
+
+// The followers of the lock free Leader/Followers set park on a futex
+// where the platform has them, on a semaphore otherwise.
+#if !defined (TAO_HAS_LF_FUTEX)
+# if defined (ACE_LINUX)
+#   define TAO_HAS_LF_FUTEX 1
+# else
+#   define TAO_HAS_LF_FUTEX 0
+# endif /* ACE_LINUX */
+#endif /* TAO_HAS_LF_FUTEX */
+
+// Number of times a follower of the lock free Leader/Followers set
+// checks whether it was woken up before it parks, on multiprocessors.
+#if !defined (TAO_LF_FOLLOWER_SPIN)
+# define TAO_LF_FOLLOWER_SPIN 1024
+#endif /* TAO_LF_FOLLOWER_SPIN */
+
+// Largest buffer, in bytes, each thread keeps to marshal the requests
+// of its synchronous invocations in, see -ORBCDRThreadCacheSize.
+#if !defined (TAO_CDR_THREAD_CACHE_SIZE)
+# define TAO_CDR_THREAD_CACHE_SIZE 65536
+#endif /* TAO_CDR_THREAD_CACHE_SIZE */
+
 #if !defined(TAO_NO_COPY_OCTET_SEQUENCES)
 # define TAO_NO_COPY_OCTET_SEQUENCES 1
 #endif /* TAO_NO_COPY_OCTET_SEQUENCES */
 
+// Define TAO_NO_COPY_VALUE_SEQUENCES to 1 to let unbounded sequences of
+// the fixed size primitive types (short, long, long long, float,
+// double and their unsigned variants) demarshal without copying: when
+// the data is in native byte order and suitably aligned the sequence
+// refers to the incoming CDR buffer and keeps its data block alive.
+// Such a sequence pins the whole incoming message until it is
+// destroyed or resized.
+#if !defined(TAO_NO_COPY_VALUE_SEQUENCES)
+# define TAO_NO_COPY_VALUE_SEQUENCES 0
+#endif /* TAO_NO_COPY_VALUE_SEQUENCES */
+
 // Define if your processor does not store words with the most significant
 // byte first.
 
@@ -317,6 +367,25 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 # define TAO_HAS_SHMIOP 0
 #endif /* ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1 */
 
+// SHMRIOP, the shared memory ring buffer protocol, needs eventfd(2)
+// and the UNIX domain sockets it exchanges the descriptors over.  It
+// is enabled by default on the platforms that have both.
+// To explicitly disable SHMRIOP support uncomment the following
+// #define TAO_HAS_SHMRIOP 0
+#if !defined (TAO_HAS_SHMRIOP)
+#  if defined (ACE_HAS_EVENTFD) && (TAO_HAS_UIOP == 1)
+#    define TAO_HAS_SHMRIOP 1
+#  else
+#    define TAO_HAS_SHMRIOP 0
+#  endif  /* ACE_HAS_EVENTFD && TAO_HAS_UIOP == 1 */
+#endif  /* !TAO_HAS_SHMRIOP */
+
+// Size in bytes of each of the two SHMRIOP ring buffers of a
+// connection, a power of 2.
+#if !defined (TAO_SHMRIOP_RING_SIZE)
+#  define TAO_SHMRIOP_RING_SIZE 262144
+#endif  /* !TAO_SHMRIOP_RING_SIZE */
+
 // NAMED_RT_MUTEX support is disabled by default.
 // To explicitly enable NAMED_RT_MUTEX support uncomment the following
 // #define TAO_HAS_NAMED_RT_MUTEXES 1
@@ -30,6 +30,8 @@ TAO_ORB_Parameters::TAO_ORB_Parameters ()
   , iiop_client_port_base_ (0)
   , iiop_client_port_span_ (0)
   , cdr_memcpy_tradeoff_ (ACE_DEFAULT_CDR_MEMCPY_TRADEOFF)
+  , cdr_reference_threshold_ (0)
+  , cdr_thread_cache_size_ (TAO_CDR_THREAD_CACHE_SIZE)
   , max_message_size_ (0) // Disable outgoing GIOP fragments by default
   , use_dotted_decimal_addresses_ (0)
   , cache_incoming_by_dotted_decimal_address_ (0)
@@ -43,6 +45,7 @@ TAO_ORB_Parameters::TAO_ORB_Parameters ()
   , shared_profile_ (0)
   , use_parallel_connects_ (false)
   , parallel_connect_delay_ (0)
+  , stub_transport_affinity_ (false)
   , pref_network_ ()
   , disable_rt_collocation_resolver_ (false)
   , enforce_preferred_interfaces_ (false)
@@ -116,6 +116,23 @@ public:
   int cdr_memcpy_tradeoff () const;
   void cdr_memcpy_tradeoff (int);
 
+  /**
+   * Arrays of basic types at least this large are not copied into
+   * the CDR stream of outgoing requests, the stream refers to the
+   * application memory instead and the transport sends it with a
+   * gather write.  Zero, the default, always copies.
+   */
+  size_t cdr_reference_threshold () const;
+  void cdr_reference_threshold (size_t);
+
+  /**
+   * Largest buffer each thread keeps to marshal the requests of its
+   * synchronous invocations in, instead of growing the CDR stream of
+   * the transport for each large request.  Zero disables the cache.
+   */
+  size_t cdr_thread_cache_size () const;
+  void cdr_thread_cache_size (size_t);
+
   /**
    * Maximum size of a GIOP message before outgoing fragmentation
    * kicks in.
@@ -208,6 +225,11 @@ public:
   unsigned long parallel_connect_delay () const;
   void parallel_connect_delay (unsigned long x);
 
+  /// Want stubs to reuse the transport of their last invocation
+  /// without going through the endpoint selector.
+  bool stub_transport_affinity () const;
+  void stub_transport_affinity (bool x);
+
   /// Mutators and accessors for rt_collocation_resolver
   bool disable_rt_collocation_resolver () const;
   void disable_rt_collocation_resolver (bool);
@@ -342,6 +364,13 @@ private:
   /// CDR streams.
   int cdr_memcpy_tradeoff_;
 
+  /// Size from which arrays are referenced instead of copied in the
+  /// CDR stream of outgoing requests.
+  size_t cdr_reference_threshold_;
+
+  /// Largest buffer kept by a thread for the requests it marshals.
+  size_t cdr_thread_cache_size_;
+
   /// Maximum GIOP message size to be sent over a given transport.
   /**
    * Setting a maximum message size will cause outgoing GIOP
@@ -409,6 +438,10 @@ private:
   /// a good connection is discovered. Time is expressed in milliseconds.
   unsigned long parallel_connect_delay_;
 
+  /// Let a stub keep the transport its last invocation used and try
+  /// it first on the next one.
+  bool stub_transport_affinity_;
+
   /// Preferred network interfaces as a string
   ACE_CString pref_network_;
 
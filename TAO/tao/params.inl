@@ -37,6 +37,30 @@ TAO_ORB_Parameters::cdr_memcpy_tradeoff (int x)
   this->cdr_memcpy_tradeoff_ = x;
 }
 
+ACE_INLINE size_t
+TAO_ORB_Parameters::cdr_reference_threshold () const
+{
+  return this->cdr_reference_threshold_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::cdr_reference_threshold (size_t x)
+{
+  this->cdr_reference_threshold_ = x;
+}
+
+ACE_INLINE size_t
+TAO_ORB_Parameters::cdr_thread_cache_size () const
+{
+  return this->cdr_thread_cache_size_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::cdr_thread_cache_size (size_t x)
+{
+  this->cdr_thread_cache_size_ = x;
+}
+
 ACE_INLINE ACE_CDR::ULong
 TAO_ORB_Parameters::max_message_size () const
 {
@@ -313,6 +337,18 @@ TAO_ORB_Parameters::parallel_connect_delay (unsigned long x)
   this->parallel_connect_delay_ = x;
 }
 
+ACE_INLINE bool
+TAO_ORB_Parameters::stub_transport_affinity () const
+{
+  return this->stub_transport_affinity_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::stub_transport_affinity (bool x)
+{
+  this->stub_transport_affinity_ = x;
+}
+
 ACE_INLINE int
 TAO_ORB_Parameters::shared_profile () const
 {
@@ -14,6 +14,7 @@ my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 fail
 $server_debug_level = '0';
 $client_debug_level = '0';
 $iterations = '1';
+$client_threads = '0';
 
 $conf_file = "muxed$PerlACE::svcconf_ext";
 
@@ -28,6 +29,13 @@ foreach $i (@ARGV) {
     elsif ($i eq '-exclusive') {
         $conf_file = "exclusive$PerlACE::svcconf_ext";
     }
+    elsif ($i eq '-lock_free') {
+        $conf_file = "lock_free$PerlACE::svcconf_ext";
+    }
+    elsif ($i eq '-lock_free_mt') {
+        $conf_file = "lock_free_mt$PerlACE::svcconf_ext";
+        $client_threads = '8';
+    }
 }
 
 $client_conf = $client->LocalFile ($conf_file);
@@ -83,6 +91,22 @@ if ($client_status != 0) {
     $status = 1;
 }
 
+# Several threads sending requests at once on the same connection.
+if ($client_threads > 0) {
+    $CL3 = $client->CreateProcess ("client",
+                                   "-ORBsvcconf $client_conf"
+                                   . " -ORBCollocation no"
+                                   . " -ORBdebuglevel $client_debug_level"
+                                   . " -k file://$client_iorfile "
+                                   . " -n $client_threads -i 100");
+
+    $client_status = $CL3->SpawnWaitKill ($client->ProcessStartWaitInterval() + 45);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+}
 
 $CL2 = $client->CreateProcess ("simple_client",
                                "-ORBsvcconf $client_conf"
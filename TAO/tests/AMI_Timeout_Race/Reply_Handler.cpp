@@ -0,0 +1,148 @@
+#include "Reply_Handler.h"
+
+Outcomes::Outcomes (CORBA::ULong requests)
+  : replies_ (requests, CORBA::ULong ())
+  , timeouts_ (requests, CORBA::ULong ())
+  , errors_ (requests, CORBA::ULong ())
+  , corrupted_ (0)
+  , completed_ (0)
+{
+}
+
+void
+Outcomes::count (CORBA::Long id, ACE_Array_Base<CORBA::ULong> &counts)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->mutex_);
+
+  if (id < 0 || static_cast<size_t> (id) >= counts.size ())
+    {
+      ++this->corrupted_;
+      return;
+    }
+
+  if (this->replies_[id] + this->timeouts_[id] + this->errors_[id] == 0)
+    ++this->completed_;
+
+  ++counts[id];
+}
+
+void
+Outcomes::reply (CORBA::Long id, CORBA::Long value)
+{
+  if (value != id)
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->mutex_);
+      ++this->corrupted_;
+    }
+
+  this->count (id, this->replies_);
+}
+
+void
+Outcomes::timeout (CORBA::Long id)
+{
+  this->count (id, this->timeouts_);
+}
+
+void
+Outcomes::error (CORBA::Long id)
+{
+  this->count (id, this->errors_);
+}
+
+CORBA::ULong
+Outcomes::completed (void)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, 0);
+  return this->completed_;
+}
+
+int
+Outcomes::check (void)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->mutex_, 1);
+
+  CORBA::ULong replies = 0;
+  CORBA::ULong timeouts = 0;
+  CORBA::ULong errors = 0;
+  CORBA::ULong missing = 0;
+  CORBA::ULong duplicated = 0;
+
+  for (size_t i = 0; i != this->replies_.size (); ++i)
+    {
+      replies += this->replies_[i];
+      timeouts += this->timeouts_[i];
+      errors += this->errors_[i];
+
+      CORBA::ULong const callbacks =
+        this->replies_[i] + this->timeouts_[i] + this->errors_[i];
+
+      if (callbacks == 0)
+        ++missing;
+      else if (callbacks > 1)
+        {
+          ++duplicated;
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: request %d got %d replies and %d timeouts\n",
+                      static_cast<int> (i),
+                      this->replies_[i],
+                      this->timeouts_[i]));
+        }
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              "(%P|%t) client - %d replies, %d timeouts, %d errors, "
+              "%d missing, %d with more than one callback\n",
+              replies, timeouts, errors, missing, duplicated));
+
+  int status = 0;
+
+  if (missing != 0 || duplicated != 0 || errors != 0 || this->corrupted_ != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: each request must get exactly one reply or "
+                  "timeout, %d replies were corrupted\n",
+                  this->corrupted_));
+      status = 1;
+    }
+
+  if (replies == 0 || timeouts == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: the replies did not race with the timeouts\n"));
+      status = 1;
+    }
+
+  return status;
+}
+
+Reply_Handler::Reply_Handler (CORBA::Long id, Outcomes &outcomes)
+  : id_ (id)
+  , outcomes_ (outcomes)
+{
+}
+
+void
+Reply_Handler::delayed_echo (CORBA::Long ami_return_val)
+{
+  this->outcomes_.reply (this->id_, ami_return_val);
+}
+
+void
+Reply_Handler::delayed_echo_excep (
+  ::Messaging::ExceptionHolder *excep_holder)
+{
+  try
+    {
+      excep_holder->raise_exception ();
+    }
+  catch (const CORBA::TIMEOUT &)
+    {
+      this->outcomes_.timeout (this->id_);
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      ex._tao_print_exception ("delayed_echo_excep:");
+      this->outcomes_.error (this->id_);
+    }
+}
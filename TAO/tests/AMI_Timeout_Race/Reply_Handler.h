@@ -0,0 +1,76 @@
+#ifndef REPLY_HANDLER_H
+#define REPLY_HANDLER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+#include "ace/Containers_T.h"
+
+/**
+ * @class Outcomes
+ *
+ * @brief Count the callbacks each request gets.
+ *
+ * Whether the reply or the timeout of a request wins, it must get
+ * exactly one of them.
+ */
+class Outcomes
+{
+public:
+  /// Constructor, for @a requests requests
+  Outcomes (CORBA::ULong requests);
+
+  /// The reply of request @a id was dispatched, returning @a value
+  void reply (CORBA::Long id, CORBA::Long value);
+
+  /// Request @a id timed out
+  void timeout (CORBA::Long id);
+
+  /// Request @a id failed with another exception
+  void error (CORBA::Long id);
+
+  /// Number of requests that got at least one callback
+  CORBA::ULong completed (void);
+
+  /// Report the outcomes, return 0 if each request got exactly one
+  /// callback and both replies and timeouts happened
+  int check (void);
+
+private:
+  /// Count a callback for @a id in @a counts
+  void count (CORBA::Long id, ACE_Array_Base<CORBA::ULong> &counts);
+
+  TAO_SYNCH_MUTEX mutex_;
+
+  ACE_Array_Base<CORBA::ULong> replies_;
+  ACE_Array_Base<CORBA::ULong> timeouts_;
+  ACE_Array_Base<CORBA::ULong> errors_;
+
+  /// Replies that did not return the id of their request
+  CORBA::ULong corrupted_;
+
+  CORBA::ULong completed_;
+};
+
+/// Implement the Test::AMI_SleeperHandler interface for one request
+class Reply_Handler
+  : public virtual POA_Test::AMI_SleeperHandler
+{
+public:
+  /// Constructor
+  Reply_Handler (CORBA::Long id, Outcomes &outcomes);
+
+  // = The skeleton methods
+  virtual void delayed_echo (CORBA::Long ami_return_val);
+
+  virtual void delayed_echo_excep (
+    ::Messaging::ExceptionHolder *excep_holder);
+
+private:
+  /// The request this handler gets the callback of
+  CORBA::Long const id_;
+
+  Outcomes &outcomes_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* REPLY_HANDLER_H */
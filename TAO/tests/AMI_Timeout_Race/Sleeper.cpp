@@ -0,0 +1,22 @@
+#include "Sleeper.h"
+#include "ace/OS_NS_unistd.h"
+
+Sleeper::Sleeper (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::Long
+Sleeper::delayed_echo (CORBA::Long id,
+                       CORBA::Long usecs)
+{
+  ACE_Time_Value const delay (0, usecs);
+  ACE_OS::sleep (delay);
+  return id;
+}
+
+void
+Sleeper::shutdown (void)
+{
+  this->orb_->shutdown (false);
+}
@@ -0,0 +1,27 @@
+#ifndef SLEEPER_H
+#define SLEEPER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Sleeper interface
+class Sleeper
+  : public virtual POA_Test::Sleeper
+{
+public:
+  /// Constructor
+  Sleeper (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::Long delayed_echo (CORBA::Long id,
+                                    CORBA::Long usecs);
+
+  virtual void shutdown (void);
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* SLEEPER_H */
@@ -0,0 +1,304 @@
+#include "Reply_Handler.h"
+#include "tao/Messaging/Messaging.h"
+#include "tao/AnyTypeCode/Any.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+const ACE_TCHAR *ior = ACE_TEXT ("file://test.ior");
+int requests = 2000;
+int senders = 4;
+int event_loop_threads = 4;
+int delay = 2000;
+int jitter = 1500;
+
+/// Timeouts spread from @c delay - @c jitter to @c delay + @c jitter,
+/// around the time the replies take.
+const int timeout_steps = 8;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:i:s:n:d:j:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        requests = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 's':
+        senders = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'n':
+        event_loop_threads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        delay = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'j':
+        jitter = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <requests> "
+                           "-s <sender threads> "
+                           "-n <event loop threads> "
+                           "-d <servant delay in usecs> "
+                           "-j <timeout jitter in usecs> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (requests <= 0 || senders <= 0 || event_loop_threads <= 0
+      || jitter < 0 || delay <= jitter)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "The counts must be positive and the jitter "
+                       "smaller than the delay\n"),
+                      -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Dispatch the replies and the timeouts in several threads, so they
+/// race each other.
+class Event_Loop : public ACE_Task_Base
+{
+public:
+  Event_Loop (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  virtual int svc (void)
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception &ex)
+      {
+        ex._tao_print_exception ("Event_Loop::svc:");
+        return 1;
+      }
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+/// Send the requests from several threads over the one muxed
+/// connection.
+class Sender : public ACE_Task_Base
+{
+public:
+  Sender (Test::Sleeper_var *sleepers,
+          ACE_Array_Base<Test::AMI_SleeperHandler_var> &handlers,
+          Outcomes &outcomes)
+    : sleepers_ (sleepers)
+    , handlers_ (handlers)
+    , outcomes_ (outcomes)
+    , next_ (0)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    ACE_Time_Value const pause (0, delay);
+
+    for (;;)
+      {
+        CORBA::Long const id = this->next_++;
+        if (id >= requests)
+          break;
+
+        try
+          {
+            this->sleepers_[id % (timeout_steps + 1)]->sendc_delayed_echo (
+              this->handlers_[id].in (),
+              id,
+              delay);
+          }
+        catch (const CORBA::TIMEOUT &)
+          {
+            // Timed out while sending, no callback is coming.
+            this->outcomes_.timeout (id);
+          }
+        catch (const CORBA::Exception &ex)
+          {
+            ex._tao_print_exception ("Sender::svc:");
+            this->outcomes_.error (id);
+          }
+
+        // Keep the servant threads busy without building a backlog
+        // that times all the requests out.
+        ACE_OS::sleep (pause);
+      }
+    return 0;
+  }
+
+private:
+  Test::Sleeper_var *sleepers_;
+  ACE_Array_Base<Test::AMI_SleeperHandler_var> &handlers_;
+  Outcomes &outcomes_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, CORBA::Long> next_;
+};
+
+/// Return @a sleeper with a relative roundtrip timeout of @a usecs
+/// microseconds.
+Test::Sleeper_ptr
+with_timeout (CORBA::ORB_ptr orb, Test::Sleeper_ptr sleeper, long usecs)
+{
+  TimeBase::TimeT const timeout = 10 * static_cast<TimeBase::TimeT> (usecs);
+  CORBA::Any any;
+  any <<= timeout;
+
+  CORBA::PolicyList policy_list (1);
+  policy_list.length (1);
+  policy_list[0] =
+    orb->create_policy (Messaging::RELATIVE_RT_TIMEOUT_POLICY_TYPE, any);
+
+  CORBA::Object_var object =
+    sleeper->_set_policy_overrides (policy_list, CORBA::SET_OVERRIDE);
+
+  policy_list[0]->destroy ();
+
+  return Test::Sleeper::_narrow (object.in ());
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil RootPOA\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      poa_manager->activate ();
+
+      CORBA::Object_var tmp = orb->string_to_object (ior);
+
+      Test::Sleeper_var sleeper = Test::Sleeper::_narrow (tmp.in ());
+
+      if (CORBA::is_nil (sleeper.in ()))
+        ACE_ERROR_RETURN ((LM_DEBUG,
+                           "ERROR: Nil reference <%s>\n",
+                           ior),
+                          1);
+
+      // Open the connection before the timeouts apply.
+      (void) sleeper->delayed_echo (0, 0);
+
+      // The last reference has a timeout long enough for its replies
+      // to arrive.
+      Test::Sleeper_var sleepers[timeout_steps + 1];
+      for (int i = 0; i != timeout_steps; ++i)
+        sleepers[i] =
+          with_timeout (orb.in (),
+                        sleeper.in (),
+                        delay - jitter + 2 * jitter * i / (timeout_steps - 1));
+      sleepers[timeout_steps] =
+        with_timeout (orb.in (), sleeper.in (), 100L * delay);
+
+      // A handler per request, the exception callback does not tell
+      // which request timed out.
+      Outcomes outcomes (requests);
+      ACE_Array_Base<Test::AMI_SleeperHandler_var> handlers (requests);
+
+      for (int i = 0; i != requests; ++i)
+        {
+          Reply_Handler *handler_impl = 0;
+          ACE_NEW_RETURN (handler_impl,
+                          Reply_Handler (i, outcomes),
+                          1);
+          PortableServer::ServantBase_var owner_transfer (handler_impl);
+
+          PortableServer::ObjectId_var id =
+            root_poa->activate_object (handler_impl);
+
+          CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+          handlers[i] = Test::AMI_SleeperHandler::_narrow (object.in ());
+        }
+
+      Event_Loop event_loop (orb.in ());
+      if (event_loop.activate (THR_NEW_LWP | THR_JOINABLE,
+                               event_loop_threads) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot activate the event loop threads\n"),
+                          1);
+
+      Sender sender (sleepers, handlers, outcomes);
+      if (sender.activate (THR_NEW_LWP | THR_JOINABLE, senders) == -1)
+        ACE_ERROR ((LM_ERROR,
+                    "Cannot activate the sender threads\n"));
+      else
+        sender.wait ();
+
+      // Wait for the callbacks, then long enough for a reply or
+      // timeout that was dispatched twice to show up.
+      ACE_Time_Value const deadline =
+        ACE_OS::gettimeofday () + ACE_Time_Value (60);
+      while (outcomes.completed () != static_cast<CORBA::ULong> (requests)
+             && ACE_OS::gettimeofday () < deadline)
+        ACE_OS::sleep (ACE_Time_Value (0, 10000));
+
+      ACE_OS::sleep (ACE_Time_Value (0, 200L * delay + 500000));
+
+      status = outcomes.check ();
+
+      sleeper->shutdown ();
+
+      orb->shutdown (false);
+
+      event_loop.wait ();
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return status;
+}
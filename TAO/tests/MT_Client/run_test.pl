@@ -19,12 +19,18 @@ $server_conf = "server" . $conf;
 
 $threads = '4';
 $iterations = '1000';
+$client_svcconf = '';
 
 foreach $i (@ARGV) {
     if ($i eq '-debug') {
         $debug_level = '10';
     } elsif ($i eq '-creation') {
         $client_process = 'orb_creation';
+    } elsif ($i eq '-lock_free') {
+        # The client threads share a muxed connection and wait as
+        # followers in the lock free follower set.
+        $client_svcconf = "client_lock_free" . $conf;
+        $threads = '16';
     }
 }
 
@@ -50,8 +56,19 @@ $SV = $server->CreateProcess ("server",
                               "-ORBsvcconf $server_conf1 " .
                               "-o $server_iorfile");
 
+my $client_conf_arg = '';
+if ($client_svcconf ne '') {
+    my $client_svcconf1 = $client->LocalFile ($client_svcconf);
+    if ($client->PutFile ($client_svcconf) == -1) {
+        print STDERR "ERROR: cannot set file <$client_svcconf1>\n";
+        exit 1;
+    }
+    $client_conf_arg = "-ORBsvcconf $client_svcconf1 ";
+}
+
 $CL = $client->CreateProcess ($client_process,
                               "-ORBdebuglevel $debug_level " .
+                              $client_conf_arg .
                               "-k file://$client_iorfile " .
                               "-n $threads " .
                               "-i $iterations " .
@@ -0,0 +1,12 @@
+#include "Shard.h"
+#include "ace/OS_NS_unistd.h"
+
+Shard::Shard ()
+{
+}
+
+CORBA::Long
+Shard::pid ()
+{
+  return static_cast<CORBA::Long> (ACE_OS::getpid ());
+}
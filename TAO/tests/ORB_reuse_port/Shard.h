@@ -0,0 +1,19 @@
+#ifndef ORB_REUSE_PORT_SHARD_H
+#define ORB_REUSE_PORT_SHARD_H
+
+#include "TestS.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+/// Implement the Test::Shard interface
+class Shard : public virtual POA_Test::Shard
+{
+public:
+  Shard ();
+
+  CORBA::Long pid () override;
+};
+
+#endif /* ORB_REUSE_PORT_SHARD_H */
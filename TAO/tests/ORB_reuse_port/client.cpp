@@ -0,0 +1,100 @@
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include <set>
+
+const ACE_TCHAR *ior = ACE_TEXT ("corbaloc:iiop:127.0.0.1:12345/Shard");
+int connections = 20;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        connections = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-n <connections>"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      orb->destroy ();
+
+      std::set<CORBA::Long> servers;
+
+      for (int i = 0; i != connections; ++i)
+        {
+          // A new ORB does not find the connection of the previous
+          // one in its transport cache, so each call connects anew.
+          char orb_id[32];
+          ACE_OS::snprintf (orb_id, sizeof orb_id, "client_%d", i);
+
+          CORBA::ORB_var client_orb = CORBA::ORB_init (argc, argv, orb_id);
+
+          CORBA::Object_var tmp = client_orb->string_to_object (ior);
+
+          Test::Shard_var shard = Test::Shard::_narrow (tmp.in ());
+
+          if (CORBA::is_nil (shard.in ()))
+            {
+              ACE_ERROR_RETURN ((LM_DEBUG,
+                                 "ERROR: Nil shard reference <%s>\n",
+                                 ior),
+                                1);
+            }
+
+          servers.insert (shard->pid ());
+
+          client_orb->destroy ();
+        }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "(%P|%t) - %d connections reached %B servers\n",
+                  connections,
+                  servers.size ()));
+
+      if (servers.size () < 2)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: The connections all reached "
+                             "the same server\n"),
+                            1);
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+$port = $server->RandomPort ();
+$host = $server->HostName ();
+$endpoint = "iiop://$host:$port";
+
+print STDOUT "Creating two servers with endpoint $endpoint/reuse_port=1...\n";
+
+$SV1 = $server->CreateProcess ("server", "-ORBEndpoint $endpoint/reuse_port=1");
+$SV2 = $server->CreateProcess ("server", "-ORBEndpoint $endpoint/reuse_port=1");
+$SV3 = $server->CreateProcess ("server", "-ORBEndpoint $endpoint");
+$CL = $client->CreateProcess ("client", "-k corbaloc:iiop:$host:$port/Shard -n 20");
+
+print STDOUT "Starting server 1\n";
+$server_status = $SV1->Spawn ();
+if ($server_status != 0) {
+    print STDERR "ERROR: server failed to start: $server_status\n";
+    exit 1;
+}
+$server_status = $SV1->Wait (1);
+if ($server_status != -1) {
+    print STDERR "ERROR: server exited prematurely: $server_status\n";
+    exit 1;
+}
+print STDOUT "Started server 1\n";
+
+print STDOUT "Starting server 2\n";
+$server_status = $SV2->Spawn ();
+if ($server_status != 0) {
+    print STDERR "ERROR: server failed to start: $server_status\n";
+    $SV1->Kill ();
+    exit 1;
+}
+$server_status = $SV2->Wait (1);
+if ($server_status != -1) {
+    print STDERR "ERROR: server exited prematurely: $server_status\n";
+    $SV1->Kill ();
+    exit 1;
+}
+print STDOUT "Started server 2\n";
+
+print STDOUT "Starting server 3 without reuse_port\n";
+$server_status = $SV3->Spawn ();
+if ($server_status == 0) {
+    $server_status = $SV3->Wait (1);
+    if ($server_status == -1) {
+        print STDERR "ERROR: Server 3 didn't fail, still running!\n";
+        $SV1->Kill ();
+        $SV2->Kill ();
+        $SV3->Kill ();
+        exit 1;
+    }
+}
+print STDOUT "Success: server 3 failed to start\n";
+
+$client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval ());
+if ($client_status != 0) {
+    print STDERR "ERROR: client returned $client_status\n";
+    $status = 1;
+}
+
+$SV1->Kill ();
+$SV2->Kill ();
+$SV3->Kill ();
+
+exit $status;
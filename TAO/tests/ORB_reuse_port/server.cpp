@@ -0,0 +1,52 @@
+#include "Shard.h"
+#include "tao/IORTable/IORTable.h"
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+
+      PortableServer::POA_var poa = PortableServer::POA::_narrow (obj.in ());
+
+      PortableServer::POAManager_var man = poa->the_POAManager ();
+
+      Shard *shard_impl = 0;
+      ACE_NEW_RETURN (shard_impl,
+                      Shard,
+                      1);
+      PortableServer::ServantBase_var owner_transfer (shard_impl);
+
+      PortableServer::ObjectId_var id = poa->activate_object (shard_impl);
+
+      obj = poa->id_to_reference (id.in ());
+
+      CORBA::String_var ior = orb->object_to_string (obj.in ());
+
+      // Every server binds the same name, so the client finds the
+      // object whichever server accepted its connection.
+      CORBA::Object_var table_object =
+        orb->resolve_initial_references ("IORTable");
+
+      IORTable::Table_var table =
+        IORTable::Table::_narrow (table_object.in ());
+
+      table->bind ("Shard", ior.in ());
+
+      man->activate ();
+
+      orb->run ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception&)
+    {
+      ACE_DEBUG ((LM_DEBUG, "server failed to start\n"));
+      return 1;
+    }
+
+  return 0;
+}
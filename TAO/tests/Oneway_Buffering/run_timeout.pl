@@ -9,11 +9,16 @@ use PerlACE::TestTarget;
 
 $status = 0;
 $debug_level = '0';
+$coalescing = '';
 
 foreach $i (@ARGV) {
     if ($i eq '-debug') {
         $debug_level = '10';
     }
+    elsif ($i eq '-coalescing') {
+        $coalescing = "-ORBSvcConfDirective \"static Resource_Factory " .
+                      "'-ORBTransportCoalescing 16384'\" ";
+    }
 }
 
 my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
@@ -49,6 +54,7 @@ $SV = $server->CreateProcess ("server",
                               "-k file://$server_iorfile_admin");
 
 $CL = $client->CreateProcess ("client",
+                              $coalescing .
                               "-k file://$client_iorfile " .
                               "-a file://$client_iorfile_admin " .
                               "-t");
@@ -29,7 +29,15 @@ $client->DeleteFile ($iorbase3);
 $SV1 = $server->CreateProcess ("server", "-o $server1_iorfile");
 $SV2 = $server->CreateProcess ("server", "-o $server2_iorfile -f file://$server1_iorfile");
 $SV3 = $server->CreateProcess ("server", "-o $server3_iorfile -f file://$server2_iorfile");
-$CL  = $client->CreateProcess ("client",  "-s 3 -k file://$client_iorfile");
+$client_args = "-s 3 -k file://$client_iorfile";
+
+foreach $i (@ARGV) {
+    if ($i eq '-affinity') {
+        $client_args .= " -ORBStubTransportAffinity 1";
+    }
+}
+
+$CL  = $client->CreateProcess ("client",  $client_args);
 
 $status = 0;
 
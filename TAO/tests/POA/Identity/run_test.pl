@@ -9,7 +9,30 @@ use PerlACE::TestTarget;
 
 my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
 
-$SV = $server->CreateProcess ("Identity", "-ORBobjrefstyle url");
+$svc_conf = "svc";
+
+foreach $i (@ARGV) {
+    if ($i eq '-open') {
+        # The open active object map, with reactivation of system ids
+        # and active hints, which the system id POAs do without.
+        $svc_conf = "svc_open";
+    } elsif ($i eq '-open_system') {
+        # The open active object map for the system ids themselves.
+        $svc_conf = "svc_open_system";
+    }
+}
+
+$svc_conf .= $PerlACE::svcconf_ext;
+my $server_svc_conf = $server->LocalFile ($svc_conf);
+
+if ($server->PutFile ($svc_conf) == -1) {
+    print STDERR "ERROR: cannot set file <$server_svc_conf>\n";
+    exit 1;
+}
+
+$SV = $server->CreateProcess ("Identity",
+                              "-ORBobjrefstyle url " .
+                              "-ORBSvcConf $server_svc_conf");
 
 $test = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval());
 
@@ -18,4 +18,15 @@ if ($test != 0) {
     exit 1;
 }
 
+# Deactivations must also be seen by requests that find the servant
+# in the object key cache.
+$SV->Arguments ("-ORBsvcconfdirective \"static Server_Strategy_Factory '-ORBObjectKeyCacheSize 16'\"");
+
+$test = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval());
+
+if ($test != 0) {
+    print STDERR "ERROR: test with object key cache returned $test\n";
+    exit 1;
+}
+
 exit 0;
@@ -19,6 +19,7 @@ $client->DeleteFile($iorbase);
 $invocation = "sii";
 $num = 5;
 $debug = "";
+$server_exe = "server";
 $status = 0;
 
 # Parse the arguments
@@ -40,13 +41,14 @@ $status = 0;
 for ($i = 0; $i <= $#ARGV; $i++) {
     if ($ARGV[$i] eq "-h" || $ARGV[$i] eq "-?") {
       print "Run_Test Perl script for TAO Param Test\n\n";
-      print "run_test [-n num] [-d] [-h] [-t type] [-i (dii|sii)]\n";
+      print "run_test [-n num] [-d] [-h] [-t type] [-i (dii|sii)] [-operation_hash]\n";
       print "\n";
       print "-n num              -- runs the client num times\n";
       print "-d                  -- runs each in debug mode\n";
       print "-h                  -- prints this information\n";
       print "-t type             -- runs only one type of param test\n";
       print "-i (dii|sii)        -- Changes the type of invocation\n";
+      print "-operation_hash     -- runs the server built with -H operation_hash\n";
       exit 0;
     }
     elsif ($ARGV[$i] eq "-n") {
@@ -64,9 +66,12 @@ for ($i = 0; $i <= $#ARGV; $i++) {
       $invocation = $ARGV[$i + 1];
       $i++;
     }
+    elsif ($ARGV[$i] eq "-operation_hash") {
+      $server_exe = "server_operation_hash";
+    }
 }
 
-$SV = $server->CreateProcess ("server", "$debug -o $server_iorfile");
+$SV = $server->CreateProcess ($server_exe, "$debug -o $server_iorfile");
 $CL = $client->CreateProcess ("client");
 
 foreach $type (@types) {
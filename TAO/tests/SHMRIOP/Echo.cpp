@@ -0,0 +1,30 @@
+#include "Echo.h"
+#include "ace/OS_NS_unistd.h"
+
+Echo::Echo (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+Test::Payload *
+Echo::echo_payload (const Test::Payload &the_payload)
+{
+  Test::Payload *result = 0;
+  ACE_NEW_THROW_EX (result,
+                    Test::Payload (the_payload),
+                    CORBA::NO_MEMORY ());
+  return result;
+}
+
+void
+Echo::block (void)
+{
+  // Long enough for the test to kill the server first.
+  ACE_OS::sleep (120);
+}
+
+void
+Echo::shutdown (void)
+{
+  this->orb_->shutdown (false);
+}
@@ -0,0 +1,206 @@
+#include "TestC.h"
+#include "tao/Strategies/advanced_resource.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+const ACE_TCHAR *ior = ACE_TEXT ("file://test.ior");
+int nthreads = 4;
+int niterations = 20;
+CORBA::ULong payload_size = 1024 * 1024;
+bool expect_failure = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:n:i:b:f"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'b':
+        payload_size = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'f':
+        expect_failure = true;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-n <threads> "
+                           "-i <iterations> "
+                           "-b <payload size> "
+                           "-f "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Each thread sends payloads larger than the rings of the connection
+/// while the replies to the other threads come back on it.
+class Worker : public ACE_Task_Base
+{
+public:
+  Worker (Test::Echo_ptr echo)
+    : echo_ (Test::Echo::_duplicate (echo)),
+      next_id_ (0),
+      errors_ (0)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    try
+      {
+        // Each thread sends its own payloads, so replies handed to
+        // the wrong thread are caught.
+        int const id = this->next_id_++;
+
+        Test::Payload payload (payload_size);
+        payload.length (payload_size);
+
+        for (int i = 0; i != niterations; ++i)
+          {
+            CORBA::Octet const seed =
+              static_cast<CORBA::Octet> (id * niterations + i);
+            for (CORBA::ULong j = 0; j != payload_size; ++j)
+              payload[j] = static_cast<CORBA::Octet> (seed + j);
+
+            Test::Payload_var reply = this->echo_->echo_payload (payload);
+
+            if (reply->length () != payload_size
+                || ACE_OS::memcmp (reply->get_buffer (),
+                                   payload.get_buffer (),
+                                   payload_size) != 0)
+              {
+                ACE_ERROR ((LM_ERROR,
+                            "(%P|%t) ERROR: reply %d does not match "
+                            "the payload\n",
+                            i));
+                ++this->errors_;
+              }
+          }
+      }
+    catch (const CORBA::Exception& ex)
+      {
+        ex._tao_print_exception ("Exception caught in thread:");
+        ++this->errors_;
+      }
+
+    return 0;
+  }
+
+  /// Number of errors seen by all the threads.
+  int errors (void) const
+  {
+    return this->errors_.value ();
+  }
+
+private:
+  Test::Echo_var echo_;
+
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> next_id_;
+
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> errors_;
+};
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp = orb->string_to_object(ior);
+
+      Test::Echo_var echo = Test::Echo::_narrow(tmp.in ());
+
+      if (CORBA::is_nil (echo.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_DEBUG,
+                             "Nil Test::Echo reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      if (expect_failure)
+        {
+          // The server is killed while this thread waits for the
+          // reply, the death of the peer must close the connection.
+          try
+            {
+              echo->block ();
+
+              ACE_ERROR_RETURN ((LM_ERROR,
+                                 "(%P|%t) ERROR: block() returned\n"),
+                                1);
+            }
+          catch (const CORBA::COMM_FAILURE&)
+            {
+              ACE_DEBUG ((LM_DEBUG,
+                          "(%P|%t) - COMM_FAILURE after the server "
+                          "died, as expected\n"));
+            }
+          catch (const CORBA::TRANSIENT&)
+            {
+              ACE_DEBUG ((LM_DEBUG,
+                          "(%P|%t) - TRANSIENT after the server "
+                          "died, as expected\n"));
+            }
+
+          orb->destroy ();
+          return 0;
+        }
+
+      Worker worker (echo.in ());
+
+      if (worker.activate (THR_NEW_LWP | THR_JOINABLE, nthreads) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) Cannot activate worker threads\n"),
+                          1);
+
+      worker.thr_mgr ()->wait ();
+
+      echo->shutdown ();
+
+      orb->destroy ();
+
+      if (worker.errors () != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) ERROR: %d errors\n",
+                           worker.errors ()),
+                          1);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
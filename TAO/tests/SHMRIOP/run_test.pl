@@ -0,0 +1,134 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+$kill_server = 0;
+$wait_on_read = '';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    } elsif ($i eq '-kill') {
+        # Kill the server while the client waits for a reply.
+        $kill_server = 1;
+    } elsif ($i eq '-rw') {
+        # Block in recv() instead of waiting in the reactor, the
+        # requests of the server are still read from its reactor.
+        $wait_on_read = "-ORBSvcConfDirective \"static Client_Strategy_Factory " .
+                        "'-ORBClientConnectionHandler RW " .
+                        "-ORBTransportMuxStrategy EXCLUSIVE'\" ";
+    }
+}
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my $iorbase = "server.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+$server->DeleteFile($iorbase);
+$client->DeleteFile($iorbase);
+
+my $svc_conf = "svc" . $PerlACE::svcconf_ext;
+my $server_svc_conf = $server->LocalFile ($svc_conf);
+my $client_svc_conf = $client->LocalFile ($svc_conf);
+
+if ($server->PutFile ($svc_conf) == -1) {
+    print STDERR "ERROR: cannot set file <$server_svc_conf>\n";
+    exit 1;
+}
+if ($client->PutFile ($svc_conf) == -1) {
+    print STDERR "ERROR: cannot set file <$client_svc_conf>\n";
+    exit 1;
+}
+
+my $client_args = $kill_server ? "-f" : "-n 4 -i 20 -b 1048576";
+
+$SV = $server->CreateProcess ("server",
+                              "-ORBdebuglevel $debug_level " .
+                              "-ORBSvcConf $server_svc_conf " .
+                              $wait_on_read .
+                              "-ORBListenEndpoints shmriop:// " .
+                              "-o $server_iorfile");
+$CL = $client->CreateProcess ("client",
+                              "-ORBdebuglevel $debug_level " .
+                              "-ORBSvcConf $client_svc_conf " .
+                              $wait_on_read .
+                              "-k file://$client_iorfile " .
+                              $client_args);
+
+$server_status = $SV->Spawn ();
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    exit 1;
+}
+
+if ($server->WaitForFileTimed ($iorbase,
+                               $server->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+if ($server->GetFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+if ($client->PutFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+if ($kill_server) {
+    $client_status = $CL->Spawn ();
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    # Let the client connect and send its request.
+    sleep (5);
+
+    $SV->Kill (); $SV->TimedWait (1);
+
+    # Without noticing the death of the server the client would wait
+    # for its reply forever.
+    $client_status = $CL->WaitKill ($client->ProcessStopWaitInterval() + 15);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+}
+else {
+    $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 120);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+
+    $server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        $status = 1;
+    }
+}
+
+$server->DeleteFile($iorbase);
+$client->DeleteFile($iorbase);
+
+exit $status;
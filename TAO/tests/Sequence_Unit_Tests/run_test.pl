@@ -11,6 +11,7 @@ use strict;
 my $final_result = 0;
 
 my @testsToRun = qw(unbounded_value_sequence_ut
+               unbounded_value_sequence_nocopy_ut
                bounded_value_sequence_ut
                string_sequence_element_ut
                unbounded_string_sequence_ut
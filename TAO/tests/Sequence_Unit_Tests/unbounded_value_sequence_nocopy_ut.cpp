@@ -0,0 +1,539 @@
+/**
+ * @file
+ *
+ * @brief Unit test for unbounded sequences of value types referring to
+ * a message block, as done by the demarshaling code when
+ * TAO_NO_COPY_VALUE_SEQUENCES is enabled, and for that demarshaling
+ * code and the cases it falls back to copying.
+ */
+#define TAO_NO_COPY_VALUE_SEQUENCES 1
+
+#include "testing_allocation_traits.hpp"
+#include "testing_range_checking.hpp"
+
+#include "tao/Unbounded_Value_Sequence_T.h"
+#include "tao/Unbounded_Octet_Sequence_T.h"
+#include "tao/Unbounded_Object_Reference_Sequence_T.h"
+#include "tao/Unbounded_Basic_String_Sequence_T.h"
+#include "tao/Unbounded_BD_String_Sequence_T.h"
+#include "tao/Unbounded_Sequence_CDR_T.h"
+#include "tao/ORB_Core.h"
+#include "tao/CDR.h"
+
+#include "value_sequence_tester.hpp"
+
+#include "test_macros.h"
+
+#include "ace/Message_Block.h"
+#include "ace/CDR_Base.h"
+
+using namespace TAO_VERSIONED_NAMESPACE_NAME::TAO;
+
+typedef unbounded_value_sequence<double> tested_sequence;
+typedef tested_sequence::element_traits tested_element_traits;
+typedef tested_sequence::allocation_traits tested_allocation_traits;
+typedef details::range_checking<double,true> range;
+
+struct Tester
+{
+  typedef tested_sequence::value_type value_type;
+
+  Tester()
+    : mb_(8 * sizeof(value_type) + ACE_CDR::MAX_ALIGNMENT)
+  {
+    ACE_CDR::mb_align(&mb_);
+    value_type * const data = this->data();
+    for (int i = 0; i != 8; ++i)
+      {
+        data[i] = i;
+      }
+    mb_.wr_ptr(8 * sizeof(value_type));
+  }
+
+  value_type * data()
+  {
+    return reinterpret_cast<value_type *>(mb_.rd_ptr());
+  }
+
+  int test_message_block_constructor()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x(8, &mb_);
+      CHECK_EQUAL(CORBA::ULong(8), x.maximum());
+      CHECK_EQUAL(CORBA::ULong(8), x.length());
+      CHECK_EQUAL(false, x.release());
+      CHECK_EQUAL(data(), x.get_buffer());
+      CHECK_EQUAL(value_type(5), x[5]);
+      CHECK(x.mb() != 0);
+      CHECK_EQUAL(2, mb_.reference_count());
+    }
+    CHECK_EQUAL(1, mb_.reference_count());
+    FAIL_RETURN_IF_NOT(a.expect(0), a);
+    FAIL_RETURN_IF_NOT(f.expect(0), f);
+    return 0;
+  }
+
+  int test_copy_constructor()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x(8, &mb_);
+      tested_sequence y(x);
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(y.mb() == 0);
+      CHECK_EQUAL(true, y.release());
+      CHECK_EQUAL(CORBA::ULong(8), y.length());
+      CHECK(y.get_buffer() != data());
+      CHECK_EQUAL(value_type(7), y[7]);
+      CHECK_EQUAL(2, mb_.reference_count());
+    }
+    FAIL_RETURN_IF_NOT(f.expect(1), f);
+    CHECK_EQUAL(1, mb_.reference_count());
+    return 0;
+  }
+
+  int test_assignment()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence y;
+      y = tested_sequence(8, &mb_);
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(y.mb() == 0);
+      CHECK_EQUAL(value_type(3), y[3]);
+      CHECK_EQUAL(1, mb_.reference_count());
+    }
+    FAIL_RETURN_IF_NOT(f.expect(1), f);
+    return 0;
+  }
+
+  int test_set_length_less_than_maximum()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    {
+      tested_sequence x(8, &mb_);
+      x.length(4);
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      CHECK_EQUAL(CORBA::ULong(4), x.length());
+      CHECK_EQUAL(data(), x.get_buffer());
+      CHECK(x.mb() != 0);
+    }
+    CHECK_EQUAL(1, mb_.reference_count());
+    return 0;
+  }
+
+  int test_set_length_more_than_maximum()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x(8, &mb_);
+      x.length(16);
+      CHECK_EQUAL(CORBA::ULong(16), x.length());
+      CHECK_EQUAL(true, x.release());
+      CHECK(x.mb() == 0);
+      CHECK(x.get_buffer() != data());
+      CHECK_EQUAL(value_type(6), x[6]);
+      CHECK_EQUAL(1, mb_.reference_count());
+    }
+    FAIL_RETURN_IF_NOT(f.expect(2), f);
+    return 0;
+  }
+
+  int test_get_buffer_orphan()
+  {
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x(8, &mb_);
+      value_type * buffer = x.get_buffer(true);
+      CHECK(buffer != 0);
+      CHECK(buffer != data());
+      CHECK_EQUAL(value_type(2), buffer[2]);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+      CHECK_EQUAL(1, mb_.reference_count());
+      tested_sequence::freebuf(buffer);
+    }
+    return 0;
+  }
+
+  int test_replace()
+  {
+    {
+      tested_sequence x;
+      x.replace(8, &mb_);
+      CHECK_EQUAL(data(), x.get_buffer());
+      CHECK_EQUAL(2, mb_.reference_count());
+
+      value_type buffer[4] = { 0, 1, 2, 3 };
+      x.replace(4, 4, buffer);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(buffer, x.get_buffer());
+      CHECK_EQUAL(1, mb_.reference_count());
+    }
+    return 0;
+  }
+
+  int test_all()
+  {
+    int status = 0;
+    status += this->test_message_block_constructor();
+    status += this->test_copy_constructor();
+    status += this->test_assignment();
+    status += this->test_set_length_less_than_maximum();
+    status += this->test_set_length_more_than_maximum();
+    status += this->test_get_buffer_orphan();
+    status += this->test_replace();
+    return status;
+  }
+
+  ACE_Message_Block mb_;
+};
+
+/// Stands for the resource factory of the ORB core, only says whether
+/// the allocator of the input CDR streams is locked.
+struct mock_resource_factory
+{
+  int input_cdr_allocator_type_locked()
+  {
+    return locked_;
+  }
+
+  int locked_;
+};
+
+struct mock_orb_core
+{
+  explicit mock_orb_core(int locked)
+  {
+    factory_.locked_ = locked;
+  }
+
+  mock_resource_factory * resource_factory()
+  {
+    return &factory_;
+  }
+
+  mock_resource_factory factory_;
+};
+
+/**
+ * An input CDR stream with a mock ORB core, which can also leave its
+ * read pointer unaligned, as on the platforms without CDR alignment.
+ */
+class mock_cdr : public TAO_InputCDR
+{
+public:
+  mock_cdr(const ACE_Message_Block * data, int byte_order,
+           mock_orb_core * orb_core, bool align = true)
+    : TAO_InputCDR(data, byte_order)
+    , orb_core_(orb_core)
+    , align_(align)
+  {
+  }
+
+  mock_cdr(const char * buf, size_t size, mock_orb_core * orb_core)
+    : TAO_InputCDR(buf, size)
+    , orb_core_(orb_core)
+    , align_(true)
+  {
+  }
+
+  mock_orb_core * orb_core() const
+  {
+    return orb_core_;
+  }
+
+  int align_read_ptr(size_t alignment)
+  {
+    return align_ ? TAO_InputCDR::align_read_ptr(alignment) : 0;
+  }
+
+private:
+  mock_orb_core * orb_core_;
+  bool align_;
+};
+
+/**
+ * Demarshal sequences through demarshal_sequence(), which lets them
+ * refer to the stream when it can and copies them otherwise.
+ */
+struct CDR_Tester
+{
+  typedef unbounded_value_sequence<CORBA::Long> long_sequence;
+  typedef long_sequence::allocation_traits long_traits;
+  typedef unbounded_value_sequence<CORBA::Double> double_sequence;
+  typedef double_sequence::allocation_traits double_traits;
+
+  /// Marked after the sequences, to check where they left the stream.
+  static CORBA::Long const trailer = 42;
+
+  CDR_Tester()
+    : locked_(1)
+    , unlocked_(0)
+  {
+  }
+
+  static CORBA::ULong swapped(CORBA::ULong x)
+  {
+    CORBA::ULong y = 0;
+    ACE_CDR::swap_4(reinterpret_cast<char const *>(&x),
+                    reinterpret_cast<char *>(&y));
+    return y;
+  }
+
+  /// Marshal 1, 2, ... @a length and the trailer, swapped if asked.
+  static void marshal_longs(TAO_OutputCDR & cdr, CORBA::ULong length,
+                            bool swap = false)
+  {
+    cdr.write_ulong(swap ? swapped(length) : length);
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        CORBA::ULong const value = i + 1;
+        cdr.write_ulong(swap ? swapped(value) : value);
+      }
+    CORBA::ULong const t = trailer;
+    cdr.write_ulong(swap ? swapped(t) : t);
+  }
+
+  static int check_longs(long_sequence const & x, CORBA::ULong length)
+  {
+    CHECK_EQUAL(length, x.length());
+    for (CORBA::ULong i = 0; i != length; ++i)
+      {
+        CHECK_EQUAL(CORBA::Long(i + 1), x[i]);
+      }
+    return 0;
+  }
+
+  template<typename stream>
+  static int check_trailer(stream & cdr)
+  {
+    CORBA::Long t = 0;
+    CHECK(cdr.read_long(t));
+    CHECK_EQUAL(trailer, t);
+    return 0;
+  }
+
+  int test_in_place()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    long_sequence x;
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16);
+      mock_cdr cdr(out.begin(), ACE_CDR_BYTE_ORDER, &locked_);
+
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      CHECK(x.mb() != 0);
+      CHECK(x.get_buffer() >= reinterpret_cast<CORBA::Long *>(cdr.start()->base()));
+      CHECK(x.get_buffer() < reinterpret_cast<CORBA::Long *>(cdr.rd_ptr()));
+      CHECK_EQUAL(2, cdr.start()->data_block()->reference_count());
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    // The sequence keeps the buffer of the stream alive.
+    CHECK_EQUAL(0, check_longs(x, 16));
+    CHECK_EQUAL(1, x.mb()->data_block()->reference_count());
+    return 0;
+  }
+
+  int test_byte_swap()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16, true);
+      mock_cdr cdr(out.begin(), !ACE_CDR_BYTE_ORDER, &locked_);
+
+      long_sequence x;
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(0, check_longs(x, 16));
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    return 0;
+  }
+
+  int test_misaligned()
+  {
+    expected_calls a(double_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      out.write_ulong(4);
+      for (int i = 0; i != 4; ++i)
+        {
+          out.write_double(i + 0.5);
+        }
+      out.write_long(trailer);
+
+      // The length leaves the read pointer 4 bytes past an 8 byte
+      // boundary, the doubles cannot be used where they are.
+      mock_cdr cdr(out.begin(), ACE_CDR_BYTE_ORDER, &locked_, false);
+
+      double_sequence x;
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(CORBA::ULong(4), x.length());
+      CHECK_EQUAL(CORBA::Double(3.5), x[3]);
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    return 0;
+  }
+
+  int test_dont_delete()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16);
+      // The stream does not own the memory it reads.
+      mock_cdr cdr(out.begin()->rd_ptr(), out.total_length(), &locked_);
+
+      long_sequence x;
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(0, check_longs(x, 16));
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    return 0;
+  }
+
+  int test_unlocked_allocator()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16);
+      mock_cdr cdr(out.begin(), ACE_CDR_BYTE_ORDER, &unlocked_);
+
+      long_sequence x;
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(1, cdr.start()->data_block()->reference_count());
+      CHECK_EQUAL(0, check_longs(x, 16));
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    return 0;
+  }
+
+  int test_no_orb_core()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16);
+      TAO_InputCDR cdr(out.begin());
+
+      long_sequence x;
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+      CHECK(x.mb() == 0);
+      CHECK_EQUAL(0, check_longs(x, 16));
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    return 0;
+  }
+
+  int test_spanning_blocks()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16);
+
+      // Split the data in the middle of the 6th element, the stream
+      // joins the blocks into one it can share.
+      ACE_Message_Block const * const data = out.begin();
+      size_t const split = sizeof(CORBA::ULong) + 5 * sizeof(CORBA::Long) + 2;
+      ACE_Message_Block head(split + ACE_CDR::MAX_ALIGNMENT);
+      ACE_CDR::mb_align(&head);
+      head.copy(data->rd_ptr(), split);
+      ACE_Message_Block tail(data->length() - split);
+      tail.copy(data->rd_ptr() + split, data->length() - split);
+      head.cont(&tail);
+
+      mock_cdr cdr(&head, ACE_CDR_BYTE_ORDER, &locked_);
+      head.cont(0);
+
+      long_sequence x;
+      CHECK(TAO::demarshal_sequence(cdr, x));
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      CHECK(x.mb() != 0);
+      CHECK_EQUAL(0, check_longs(x, 16));
+      CHECK_EQUAL(0, check_trailer(cdr));
+    }
+    return 0;
+  }
+
+  int test_truncated()
+  {
+    expected_calls a(long_traits::allocbuf_calls);
+    {
+      TAO_OutputCDR out;
+      marshal_longs(out, 16);
+
+      // Only the first 4 elements made it into the stream.
+      ACE_Message_Block truncated(out.begin()->rd_ptr(),
+                                  sizeof(CORBA::ULong) + 4 * sizeof(CORBA::Long));
+      truncated.wr_ptr(truncated.size());
+      mock_cdr cdr(&truncated, ACE_CDR_BYTE_ORDER, &locked_);
+
+      long_sequence x;
+      CHECK(!TAO::demarshal_sequence(cdr, x));
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+      CHECK(x.mb() == 0);
+    }
+    FAIL_RETURN_IF_NOT(a.expect(1), a);
+    return 0;
+  }
+
+  int test_all()
+  {
+    int status = 0;
+    status += this->test_in_place();
+    status += this->test_byte_swap();
+    status += this->test_misaligned();
+    status += this->test_dont_delete();
+    status += this->test_unlocked_allocator();
+    status += this->test_no_orb_core();
+    status += this->test_spanning_blocks();
+    status += this->test_truncated();
+    return status;
+  }
+
+  mock_orb_core locked_;
+  mock_orb_core unlocked_;
+};
+
+int ACE_TMAIN(int,ACE_TCHAR*[])
+{
+  int status = 0;
+  try
+    {
+      Tester tester;
+      status += tester.test_all ();
+
+      typedef value_sequence_tester<tested_sequence,tested_allocation_traits> common;
+      common tester2;
+      status += tester2.test_all ();
+
+      CDR_Tester tester3;
+      status += tester3.test_all ();
+    }
+  catch (const ::CORBA::Exception &ex)
+    {
+      ex._tao_print_exception("ERROR : unexpected CORBA exception caugth :");
+      ++status;
+    }
+
+  return status;
+}